@@ -0,0 +1,95 @@
+/**
+ * @file bench_config_loader.cpp
+ * @brief Benchmarks for scenario parsing and template expansion
+ *
+ * Parses a YAML scenario listing state.range(0) nodes, and expands one
+ * template of state.range(0) nodes with a small firmware configuration,
+ * on one thread and on four.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "simulator/config_loader.hpp"
+
+#include <memory>
+#include <string>
+
+using namespace simulator;
+
+namespace {
+
+ScenarioConfig makeScenario(uint32_t nodes, uint32_t threads) {
+  ScenarioConfig config;
+  config.simulation.threads = threads;
+
+  NodeTemplate tmpl;
+  tmpl.template_name = "sensor";
+  tmpl.id_prefix = "sensor-";
+  tmpl.count = nodes;
+  tmpl.base_config.firmware = "simple_broadcast";
+  tmpl.base_config.mesh_prefix = "BenchmarkMesh";
+  tmpl.base_config.firmwareConfig = std::make_shared<const FirmwareConfigMap>(
+    FirmwareConfigMap{{"broadcast_interval", "5000"}, {"broadcast_message", "Hello"}});
+  config.templates.push_back(tmpl);
+  return config;
+}
+
+void BM_ExpandTemplates(benchmark::State& state, uint32_t threads) {
+  const auto nodes = static_cast<uint32_t>(state.range(0));
+  const ScenarioConfig scenario = makeScenario(nodes, threads);
+  ConfigLoader loader;
+
+  for (auto _ : state) {
+    ScenarioConfig config = scenario;
+    benchmark::DoNotOptimize(loader.expandTemplates(config));
+  }
+  state.SetItemsProcessed(state.iterations() * nodes);
+}
+
+// A scenario listing every node explicitly, as large generated scenarios do
+std::string makeYaml(uint32_t nodes) {
+  std::string yaml =
+    "simulation:\n"
+    "  name: \"Benchmark\"\n"
+    "  duration: 60\n"
+    "  max_nodes: " + std::to_string(nodes) + "\n"
+    "nodes:\n";
+  for (uint32_t i = 0; i < nodes; ++i) {
+    yaml += "  - id: \"sensor-" + std::to_string(i) + "\"\n"
+            "    firmware: \"simple_broadcast\"\n"
+            "    config:\n"
+            "      mesh_prefix: \"BenchmarkMesh\"\n"
+            "      mesh_password: \"password\"\n"
+            "      broadcast_interval: \"5000\"\n";
+  }
+  yaml += "topology:\n  type: \"random\"\n";
+  return yaml;
+}
+
+void BM_LoadFromString(benchmark::State& state) {
+  const auto nodes = static_cast<uint32_t>(state.range(0));
+  const std::string yaml = makeYaml(nodes);
+  ConfigLoader loader;
+
+  for (auto _ : state) {
+    auto config = loader.loadFromString(yaml);
+    if (!config) {
+      state.SkipWithError(loader.getLastError().c_str());
+      break;
+    }
+    benchmark::DoNotOptimize(config);
+  }
+  state.SetItemsProcessed(state.iterations() * nodes);
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(yaml.size()));
+}
+
+} // anonymous namespace
+
+BENCHMARK_CAPTURE(BM_ExpandTemplates, serial, 1)
+  ->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ExpandTemplates, threads4, 4)
+  ->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LoadFromString)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
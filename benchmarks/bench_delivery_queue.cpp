@@ -0,0 +1,67 @@
+/**
+ * @file bench_delivery_queue.cpp
+ * @brief Benchmarks comparing delivery queue backends
+ *
+ * Models a broadcast storm: a steady number of messages in flight, each
+ * millisecond draining the due messages and pushing the same number of
+ * new ones with latencies drawn from a LatencyConfig-like range.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "simulator/delivery_queue.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace simulator;
+
+namespace {
+
+constexpr uint32_t MIN_LATENCY_MS = 10;
+constexpr uint32_t MAX_LATENCY_MS = 500;
+
+DelayedMessage makeMessage(uint64_t deliveryTime) {
+  DelayedMessage message;
+  message.from = 1;
+  message.to = 2;
+  message.message = std::string(96, 'x');  // Typical JSON payload size
+  message.deliveryTime = deliveryTime;
+  return message;
+}
+
+void BM_SteadyState(benchmark::State& state, QueueBackend backend) {
+  const size_t in_flight = static_cast<size_t>(state.range(0));
+  auto queue = makeDeliveryQueue(backend);
+  std::mt19937 rng(12345);
+  std::uniform_int_distribution<uint32_t> latency(MIN_LATENCY_MS, MAX_LATENCY_MS);
+
+  uint64_t now = 0;
+  for (size_t i = 0; i < in_flight; ++i) {
+    queue->push(makeMessage(now + latency(rng)));
+  }
+
+  std::vector<DelayedMessage> ready;
+  size_t processed = 0;
+  for (auto _ : state) {
+    now++;
+    ready.clear();
+    queue->drainReady(now, ready);
+    for (auto& message : ready) {
+      message.deliveryTime = now + latency(rng);
+      queue->push(std::move(message));
+    }
+    processed += ready.size();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(processed));
+}
+
+} // anonymous namespace
+
+BENCHMARK_CAPTURE(BM_SteadyState, heap, QueueBackend::HEAP)
+    ->Arg(1000)->Arg(10000)->Arg(50000);
+BENCHMARK_CAPTURE(BM_SteadyState, timing_wheel, QueueBackend::TIMING_WHEEL)
+    ->Arg(1000)->Arg(10000)->Arg(50000);
@@ -0,0 +1,104 @@
+/**
+ * @file bench_event_scheduler.cpp
+ * @brief Benchmarks for scheduling and dispatching scenario events
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <benchmark/benchmark.h>
+
+// IMPORTANT: Include platform_compat.hpp FIRST on Windows
+#include "simulator/platform_compat.hpp"
+
+#include "simulator/event_scheduler.hpp"
+#include "simulator/network_simulator.hpp"
+#include "simulator/node_manager.hpp"
+
+#include <boost/asio.hpp>
+#include <memory>
+
+using namespace simulator;
+
+namespace {
+
+// An event that does no work, so the benchmark measures the scheduler
+class NoopEvent : public Event {
+public:
+  void execute(NodeManager&, NetworkSimulator&) override {}
+  std::string getDescription() const override { return "noop"; }
+};
+
+// Schedule a churn scenario in shuffled time order, compile it and run it
+// to completion one millisecond tick at a time
+void BM_ChurnTimeline(benchmark::State& state) {
+  boost::asio::io_context io;
+  NodeManager manager(io);
+  NetworkSimulator network(12345);
+  const auto events = static_cast<uint64_t>(state.range(0));
+  const uint64_t per_batch = 10;
+  const uint64_t batches = events / per_batch;
+
+  for (auto _ : state) {
+    EventScheduler scheduler;
+    scheduler.setLogStream(nullptr);
+    for (uint64_t i = 0; i < events; ++i) {
+      const uint64_t batch = (i * 7919) % batches;  // Scattered insertion order
+      scheduler.scheduleEventUs(std::unique_ptr<Event>(new NoopEvent()), batch * 1000);
+    }
+    scheduler.compile();
+
+    for (uint64_t now_us = 0; scheduler.hasPendingEvents(); now_us += 1000) {
+      scheduler.processEventsUs(now_us, manager, network);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * events);
+}
+
+// Schedule events over 100 seconds and run them through processEvents(),
+// the seconds entry point, one second at a time
+void BM_ProcessEvents(benchmark::State& state) {
+  boost::asio::io_context io;
+  NodeManager manager(io);
+  NetworkSimulator network(12345);
+  const auto events = static_cast<uint32_t>(state.range(0));
+  const uint32_t seconds = 100;
+
+  for (auto _ : state) {
+    EventScheduler scheduler;
+    scheduler.setLogStream(nullptr);
+    for (uint32_t i = 0; i < events; ++i) {
+      scheduler.scheduleEvent(std::unique_ptr<Event>(new NoopEvent()), (i * 7919) % seconds);
+    }
+    for (uint32_t now = 0; now < seconds; ++now) {
+      benchmark::DoNotOptimize(scheduler.processEvents(now, manager, network));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * events);
+}
+
+// Per-tick cost of processEventsUs() while every pending event is far ahead
+void BM_ProcessEventsIdle(benchmark::State& state) {
+  boost::asio::io_context io;
+  NodeManager manager(io);
+  NetworkSimulator network(12345);
+  EventScheduler scheduler;
+  scheduler.setLogStream(nullptr);
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    scheduler.scheduleEventUs(std::unique_ptr<Event>(new NoopEvent()), 3600000000ULL + i);
+  }
+  scheduler.compile();
+
+  uint64_t now_us = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(scheduler.processEventsUs(now_us, manager, network));
+    now_us += 1000;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+} // anonymous namespace
+
+BENCHMARK(BM_ChurnTimeline)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ProcessEvents)->Arg(1000)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ProcessEventsIdle)->Arg(10000);
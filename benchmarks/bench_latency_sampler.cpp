@@ -0,0 +1,64 @@
+/**
+ * @file bench_latency_sampler.cpp
+ * @brief Benchmarks for latency sampling
+ *
+ * Compares the alias-table path against direct sampling of the std
+ * distributions (the path used for ranges too wide to tabulate).
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "simulator/latency_sampler.hpp"
+
+#include <vector>
+
+using namespace simulator;
+
+namespace {
+
+LatencyConfig makeConfig(uint32_t max_ms, DistributionType distribution) {
+  LatencyConfig config;
+  config.min_ms = 10;
+  config.max_ms = max_ms;
+  config.distribution = distribution;
+  return config;
+}
+
+void BM_Sample(benchmark::State& state, DistributionType distribution, uint32_t max_ms) {
+  LatencySampler sampler(makeConfig(max_ms, distribution));
+  uint64_t key = CounterRng::makeKey(12345, 1, 2, 0);
+  uint64_t sequence = 0;
+  for (auto _ : state) {
+    CounterRng rng(key, sequence++);
+    benchmark::DoNotOptimize(sampler.sample(rng));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_SampleBatch(benchmark::State& state) {
+  LatencySampler sampler(makeConfig(500, DistributionType::NORMAL));
+  std::vector<uint64_t> random(256);
+  std::vector<uint32_t> out(random.size());
+  CounterRng rng(7, 0);
+  for (auto& word : random) {
+    word = rng() | (static_cast<uint64_t>(rng()) << 32);
+  }
+
+  for (auto _ : state) {
+    sampler.sampleBatch(random.data(), out.data(), random.size());
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * random.size());
+}
+
+} // anonymous namespace
+
+// max_ms above MAX_TABLE_SIZE forces the direct path
+BENCHMARK_CAPTURE(BM_Sample, normal_table, DistributionType::NORMAL, 500);
+BENCHMARK_CAPTURE(BM_Sample, normal_direct, DistributionType::NORMAL, 1000000);
+BENCHMARK_CAPTURE(BM_Sample, exponential_table, DistributionType::EXPONENTIAL, 500);
+BENCHMARK_CAPTURE(BM_Sample, exponential_direct, DistributionType::EXPONENTIAL, 1000000);
+BENCHMARK(BM_SampleBatch);
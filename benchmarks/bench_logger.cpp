@@ -0,0 +1,70 @@
+/**
+ * @file bench_logger.cpp
+ * @brief Benchmarks for log statements on the simulation thread
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "simulator/logger.hpp"
+
+#include <ostream>
+#include <string>
+
+using namespace simulator;
+
+namespace {
+
+// A statement below the runtime level: one load and branch
+void BM_LogDisabled(benchmark::State& state) {
+  Logger& logger = Logger::instance();
+  const LogLevel saved = logger.getLevel();
+  logger.setLevel(LogLevel::INFO);
+  uint32_t node = 0;
+
+  for (auto _ : state) {
+    SIM_LOG_DEBUG("[DEBUG] Node {} woke", node++);
+  }
+  benchmark::DoNotOptimize(node);
+  logger.setLevel(saved);
+}
+
+// An enabled statement with the writer thread running: capture and push
+// only; formatting and output happen on the writer
+void BM_LogAsync(benchmark::State& state) {
+  Logger logger;
+  std::ostream sink(nullptr);  // Discards output
+  logger.setOutput(&sink, &sink);
+  logger.start(8192);
+  const std::string firmware = "simple_broadcast";
+  uint32_t node = 0;
+
+  for (auto _ : state) {
+    logger.log(LogLevel::INFO, "[INFO] Node {} started with firmware: {}", node++, firmware);
+  }
+  logger.stop();
+  state.SetItemsProcessed(state.iterations());
+}
+
+// The same statement formatted and flushed on the calling thread, as a
+// std::endl-terminated stream write does
+void BM_LogSynchronous(benchmark::State& state) {
+  Logger logger;
+  std::ostream sink(nullptr);
+  logger.setOutput(&sink, &sink);
+  const std::string firmware = "simple_broadcast";
+  uint32_t node = 0;
+
+  for (auto _ : state) {
+    logger.log(LogLevel::INFO, "[INFO] Node {} started with firmware: {}", node++, firmware);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+} // anonymous namespace
+
+BENCHMARK(BM_LogDisabled);
+BENCHMARK(BM_LogAsync);
+BENCHMARK(BM_LogSynchronous);
@@ -0,0 +1,76 @@
+/**
+ * @file bench_mesh_transport.cpp
+ * @brief Benchmarks for MeshTransport broadcast flooding
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "simulator/mesh_transport.hpp"
+#include "simulator/network_simulator.hpp"
+#include "simulator/topology.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace simulator;
+
+namespace {
+
+// Every node of a random mesh (spanning tree plus ~2.5 extra links per
+// node) broadcasts once per round, like firmware_broadcast.yaml scaled
+// up; a round ends when every copy has been delivered
+void BM_BroadcastFlood(benchmark::State& state) {
+  const auto nodes = static_cast<size_t>(state.range(0));
+  std::vector<uint32_t> ids(nodes);
+  for (size_t i = 0; i < nodes; ++i) {
+    ids[i] = static_cast<uint32_t>(1000 + i);
+  }
+
+  NetworkSimulator network(12345);
+  network.setQueueBackend(QueueBackend::TIMING_WHEEL);
+  MeshTransport transport(network);
+  uint64_t delivered = 0;
+  for (uint32_t id : ids) {
+    MeshTransport::Endpoint endpoint;
+    endpoint.onReceive = [&delivered](uint32_t, const Payload& msg) {
+      delivered += msg.size();
+    };
+    transport.attach(id, endpoint);
+  }
+  transport.addLinks(Topology::random(nodes, 5.0f / static_cast<float>(nodes), 42).getLinks(ids));
+
+  const std::string message(64, 'x');
+  const bool prepared = state.range(1) != 0;
+  std::vector<Payload> frames;
+  for (uint32_t id : ids) {
+    frames.push_back(MeshTransport::encodeBroadcast(id, message));
+  }
+
+  uint64_t now = 0;
+  auto round = [&]() {
+    for (size_t i = 0; i < nodes; ++i) {
+      if (prepared) {
+        transport.sendBroadcastFrame(ids[i], frames[i], now);
+      } else {
+        transport.sendBroadcast(ids[i], message, now);
+      }
+    }
+    while (network.getPendingMessageCount() > 0) {
+      transport.update(++now);
+    }
+  };
+
+  round();  // Fill the route caches
+  for (auto _ : state) {
+    round();
+  }
+  benchmark::DoNotOptimize(delivered);
+  state.SetItemsProcessed(state.iterations() * nodes * (nodes - 1));
+}
+
+} // anonymous namespace
+
+BENCHMARK(BM_BroadcastFlood)->Args({1000, 0})->Args({1000, 1})->Unit(benchmark::kMillisecond);
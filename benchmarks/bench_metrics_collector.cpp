@@ -0,0 +1,68 @@
+/**
+ * @file bench_metrics_collector.cpp
+ * @brief Benchmarks for metrics sampling on the simulation thread
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <benchmark/benchmark.h>
+
+// IMPORTANT: Include platform_compat.hpp FIRST on Windows
+#include "simulator/platform_compat.hpp"
+
+#include "simulator/metrics_collector.hpp"
+#include "simulator/mesh_transport.hpp"
+#include "simulator/network_simulator.hpp"
+#include "simulator/node_manager.hpp"
+
+#include <boost/asio.hpp>
+#include <cstdio>
+#include <vector>
+
+using namespace simulator;
+
+namespace {
+
+// One sample of every column: the time sample() holds the simulation
+// thread, including any wait for the writer to finish the previous one
+void BM_MetricsSample(benchmark::State& state) {
+  const auto nodes = static_cast<uint32_t>(state.range(0));
+  std::vector<NodeConfig> configs;
+  for (uint32_t i = 0; i < nodes; ++i) {
+    NodeConfig config{1000 + i, "BenchMesh", "password"};
+    config.lazy = true;
+    configs.push_back(config);
+  }
+  boost::asio::io_context io;
+  NetworkSimulator network(12345);
+  MeshTransport transport(network);
+  NodeManager manager(io);
+  manager.setMaxNodes(nodes);
+  manager.setTransport(&transport);
+  manager.createNodes(configs);
+
+  MetricsConfig config;
+  config.output = "bench_metrics";
+  config.interval = 1;
+  config.export_formats = {state.range(1) ? "binary" : "csv"};
+  MetricsCollector collector(config);
+  collector.open();
+
+  uint64_t time_us = 0;
+  for (auto _ : state) {
+    collector.sample(time_us, manager, network, &transport);
+    time_us += collector.getIntervalUs();
+  }
+  collector.close();
+  state.SetItemsProcessed(state.iterations() * nodes);
+  state.counters["stalls"] = static_cast<double>(collector.getStallCount());
+
+  for (const auto& file : collector.getFiles()) {
+    std::remove(file.c_str());
+  }
+}
+
+} // anonymous namespace
+
+BENCHMARK(BM_MetricsSample)->Args({10000, 0})->Args({10000, 1})->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,277 @@
+/**
+ * @file bench_network_simulator.cpp
+ * @brief Benchmarks for NetworkSimulator enqueue, delivery and link checks
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "simulator/gilbert_elliott.hpp"
+#include "simulator/network_simulator.hpp"
+
+#include <vector>
+
+using namespace simulator;
+
+namespace {
+
+std::vector<uint32_t> makeNeighbours(size_t count) {
+  std::vector<uint32_t> neighbours;
+  for (size_t i = 0; i < count; ++i) {
+    neighbours.push_back(static_cast<uint32_t>(i + 2));
+  }
+  return neighbours;
+}
+
+void BM_BroadcastPerDestination(benchmark::State& state) {
+  NetworkSimulator sim(12345);
+  sim.setQueueBackend(QueueBackend::TIMING_WHEEL);
+  auto neighbours = makeNeighbours(static_cast<size_t>(state.range(0)));
+  Payload payload(std::string(1024, 'x'));
+
+  uint64_t now = 0;
+  for (auto _ : state) {
+    for (uint32_t to : neighbours) {
+      sim.enqueueMessage(1, to, payload, now);
+    }
+    sim.drainReady(now, [](DelayedMessage&) {});
+    now++;
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_BroadcastMulticast(benchmark::State& state) {
+  NetworkSimulator sim(12345);
+  sim.setQueueBackend(QueueBackend::TIMING_WHEEL);
+  auto neighbours = makeNeighbours(static_cast<size_t>(state.range(0)));
+  Payload payload(std::string(1024, 'x'));
+
+  uint64_t now = 0;
+  for (auto _ : state) {
+    sim.enqueueMulticast(1, neighbours, payload, now);
+    sim.drainReady(now, [](DelayedMessage&) {});
+    now++;
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_GilbertElliottMulticast(benchmark::State& state) {
+  NetworkSimulator sim(12345);
+  sim.setQueueBackend(QueueBackend::TIMING_WHEEL);
+  PacketLossConfig loss;
+  loss.gilbert_elliott = true;
+  loss.good_to_bad = 0.02f;
+  loss.bad_to_good = 0.25f;
+  sim.setDefaultPacketLoss(loss);
+  auto neighbours = makeNeighbours(static_cast<size_t>(state.range(0)));
+  Payload payload(std::string(1024, 'x'));
+
+  uint64_t now = 0;
+  for (auto _ : state) {
+    sim.enqueueMulticast(1, neighbours, payload, now);
+    sim.drainReady(now, [](DelayedMessage&) {});
+    now++;
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_GilbertElliottStepBatch(benchmark::State& state) {
+  GilbertElliott chain(0.02f, 0.25f, 0.0f, 1.0f);
+  const size_t links = static_cast<size_t>(state.range(0));
+  std::vector<uint8_t> states(links, GilbertElliott::GOOD);
+  std::vector<uint64_t> random(links);
+  std::vector<uint8_t> lost(links);
+  uint64_t x = 88172645463325252ULL;
+  for (auto& r : random) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    r = x;
+  }
+
+  for (auto _ : state) {
+    chain.stepBatch(states.data(), random.data(), lost.data(), links);
+    benchmark::DoNotOptimize(lost.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Steady state of state.range(0) messages in flight: each millisecond the
+// due messages are taken with getReadyMessages() and sent on again
+void BM_EnqueueReady(benchmark::State& state, QueueBackend backend) {
+  NetworkSimulator sim(12345);
+  sim.setQueueBackend(backend);
+  LatencyConfig latency;
+  latency.min_ms = 10;
+  latency.max_ms = 500;
+  latency.distribution = DistributionType::UNIFORM;
+  sim.setDefaultLatency(latency);
+  Payload payload(std::string(96, 'x'));
+
+  const auto in_flight = static_cast<uint32_t>(state.range(0));
+  uint64_t now = 0;
+  for (uint32_t i = 0; i < in_flight; ++i) {
+    sim.enqueueMessage(1, 2 + i % 64, payload, now);
+  }
+
+  std::vector<DelayedMessage> ready;
+  size_t processed = 0;
+  for (auto _ : state) {
+    now++;
+    ready.clear();
+    sim.getReadyMessages(now, ready);
+    for (const auto& message : ready) {
+      sim.enqueueMessage(message.to, message.from, message.message, now);
+    }
+    processed += ready.size();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(processed));
+}
+
+// Loss decision over 64 links with 5 % independent loss
+void BM_ShouldDropPacket(benchmark::State& state) {
+  NetworkSimulator sim(12345);
+  PacketLossConfig loss;
+  loss.probability = 0.05f;
+  sim.setDefaultPacketLoss(loss);
+
+  uint32_t to = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sim.shouldDropPacket(1, 2 + to));
+    to = (to + 1) & 63;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Token bucket check over 64 links, advancing time every 64 checks
+void BM_CanSendMessage(benchmark::State& state) {
+  NetworkSimulator sim(12345);
+  BandwidthConfig bandwidth;
+  bandwidth.max_bytes_per_sec = 125000;
+  bandwidth.max_messages_per_sec = 100;
+  sim.setDefaultBandwidth(bandwidth);
+
+  uint64_t now = 0;
+  uint32_t to = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sim.canSendMessage(1, 2 + to, 256, now));
+    to = (to + 1) & 63;
+    now += to == 0 ? 1 : 0;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+/// Simulator with one message on each of @p links links among 1000 nodes
+NetworkSimulator makeLinkedSimulator(size_t links) {
+  NetworkSimulator sim(12345);
+  for (size_t i = 0; i < links; ++i) {
+    sim.enqueueMessage(static_cast<uint32_t>(1 + i % 1000), static_cast<uint32_t>(1001 + i / 1000),
+                       Payload("x"), 0);
+  }
+  return sim;
+}
+
+// Link statistics export, one getStats() call per link
+void BM_StatsPerLink(benchmark::State& state) {
+  const size_t links = static_cast<size_t>(state.range(0));
+  NetworkSimulator sim = makeLinkedSimulator(links);
+  for (auto _ : state) {
+    uint64_t delivered = 0;
+    for (size_t i = 0; i < links; ++i) {
+      delivered += sim.getStats(static_cast<uint32_t>(1 + i % 1000),
+                                static_cast<uint32_t>(1001 + i / 1000)).delivered_count;
+    }
+    benchmark::DoNotOptimize(delivered);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Link statistics export into reused columns, with deltas
+void BM_SnapshotStats(benchmark::State& state) {
+  NetworkSimulator sim = makeLinkedSimulator(static_cast<size_t>(state.range(0)));
+  NetworkSimulator::LinkStatsColumns current;
+  NetworkSimulator::LinkStatsColumns delta;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sim.snapshotStats(current, &delta));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// One broadcast-heavy tick: every node relays a frame to its neighbours,
+// with the default 10% loss, one send at a time or as one batch
+void BM_TickSends(benchmark::State& state, bool batched) {
+  NetworkSimulator sim(12345);
+  sim.setQueueBackend(QueueBackend::TIMING_WHEEL);
+  PacketLossConfig loss;
+  loss.probability = 0.1f;
+  sim.setDefaultPacketLoss(loss);
+  const uint32_t nodes = static_cast<uint32_t>(state.range(0));
+  const uint32_t fanout = 8;
+  Payload payload(std::string(200, 'x'));
+
+  uint64_t now = 0;
+  for (auto _ : state) {
+    if (batched) {
+      sim.beginBatch();
+    }
+    for (uint32_t node = 0; node < nodes; ++node) {
+      for (uint32_t k = 1; k <= fanout; ++k) {
+        sim.enqueueMessage(node, (node + k) % nodes, payload, now);
+      }
+    }
+    if (batched) {
+      sim.flushBatch();
+    }
+    sim.drainReady(now + 1000, [](DelayedMessage&) {});
+    now += 1000;
+  }
+  state.SetItemsProcessed(state.iterations() * nodes * fanout);
+}
+
+// Bursts of frames on the same links, due in the same millisecond, with
+// and without per-link coalescing
+void BM_LinkBursts(benchmark::State& state, bool coalesce) {
+  NetworkSimulator sim(12345);
+  sim.setQueueBackend(QueueBackend::HEAP);
+  LatencyConfig latency;
+  latency.min_ms = 20;
+  latency.max_ms = 20;
+  sim.setDefaultLatency(latency);
+  sim.setCoalescing(coalesce);
+  const uint32_t links = 256;
+  const uint32_t burst = static_cast<uint32_t>(state.range(0));
+  Payload payload(std::string(200, 'x'));
+
+  uint64_t now = 0;
+  for (auto _ : state) {
+    for (uint32_t link = 0; link < links; ++link) {
+      for (uint32_t k = 0; k < burst; ++k) {
+        sim.enqueueMessage(link, link + 1, payload, now);
+      }
+    }
+    sim.drainReady(now, [](DelayedMessage&) {});
+    now++;
+  }
+  state.SetItemsProcessed(state.iterations() * links * burst);
+}
+
+} // anonymous namespace
+
+BENCHMARK_CAPTURE(BM_EnqueueReady, heap, QueueBackend::HEAP)
+  ->Arg(100)->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK_CAPTURE(BM_EnqueueReady, timing_wheel, QueueBackend::TIMING_WHEEL)
+  ->Arg(100)->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK(BM_ShouldDropPacket);
+BENCHMARK(BM_CanSendMessage);
+BENCHMARK(BM_BroadcastPerDestination)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK(BM_BroadcastMulticast)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK(BM_GilbertElliottMulticast)->Arg(16)->Arg(64);
+BENCHMARK(BM_GilbertElliottStepBatch)->Arg(1024)->Arg(65536);
+BENCHMARK(BM_StatsPerLink)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_SnapshotStats)->Arg(1000)->Arg(100000);
+BENCHMARK_CAPTURE(BM_TickSends, single, false)->Arg(100)->Arg(1000);
+BENCHMARK_CAPTURE(BM_TickSends, batched, true)->Arg(100)->Arg(1000);
+BENCHMARK_CAPTURE(BM_LinkBursts, single, false)->Arg(1)->Arg(8)->Arg(32);
+BENCHMARK_CAPTURE(BM_LinkBursts, coalesced, true)->Arg(1)->Arg(8)->Arg(32);
@@ -0,0 +1,167 @@
+/**
+ * @file bench_node_manager.cpp
+ * @brief Benchmarks for node creation and per-tick node update overhead
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <benchmark/benchmark.h>
+
+// IMPORTANT: Include platform_compat.hpp FIRST on Windows
+#include "simulator/platform_compat.hpp"
+
+#include "simulator/mesh_transport.hpp"
+#include "simulator/network_simulator.hpp"
+#include "simulator/node_manager.hpp"
+#include "simulator/topology.hpp"
+
+#include <boost/asio.hpp>
+#include <memory>
+#include <vector>
+
+using namespace simulator;
+
+namespace {
+
+/**
+ * @brief An IO context with the pending accept every node's server keeps
+ *
+ * Outstanding work makes every poll() enter the reactor, as it does in a
+ * running simulation.
+ */
+struct ListeningContext {
+  ListeningContext() : acceptor(io), socket(io) {
+    boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::address_v4::loopback(), 0);
+    acceptor.open(endpoint.protocol());
+    acceptor.bind(endpoint);
+    acceptor.listen();
+    acceptor.async_accept(socket, [](const boost::system::error_code&) {});
+  }
+
+  boost::asio::io_context io;
+  boost::asio::ip::tcp::acceptor acceptor;
+  boost::asio::ip::tcp::socket socket;
+};
+
+// One tick as VirtualNode::update() used to do it: a poll per node
+void BM_IdlePollPerNode(benchmark::State& state) {
+  ListeningContext context;
+  const auto nodes = state.range(0);
+
+  for (auto _ : state) {
+    for (int64_t i = 0; i < nodes; ++i) {
+      context.io.poll();
+    }
+    context.io.poll();  // NodeManager::updateAll()
+  }
+  state.SetItemsProcessed(state.iterations() * nodes);
+}
+
+// One tick with a single poll for all nodes
+void BM_IdlePollPerTick(benchmark::State& state) {
+  ListeningContext context;
+
+  for (auto _ : state) {
+    context.io.poll();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// A full idle tick of the single-threaded NodeManager
+void BM_UpdateAllIdle(benchmark::State& state) {
+  boost::asio::io_context io;
+  NetworkSimulator network(12345);
+  MeshTransport transport(network);
+  std::unique_ptr<NodeManager> manager(new NodeManager(io));
+  manager->setTransport(&transport);
+
+  const auto nodes = static_cast<uint32_t>(state.range(0));
+  for (uint32_t i = 0; i < nodes; ++i) {
+    NodeConfig config{1000 + i, "BenchMesh", "password", static_cast<uint16_t>(30000 + i)};
+    manager->createNode(config);
+  }
+  manager->startAll();
+
+  uint64_t now = 0;
+  for (auto _ : state) {
+    transport.update(now);
+    manager->updateAll();
+    now += 10;
+  }
+  state.SetItemsProcessed(state.iterations() * nodes);
+
+  manager->stopAll();
+}
+
+// Creating and starting nodes one createNode() call at a time
+void BM_CreateNodeLoop(benchmark::State& state) {
+  const auto nodes = static_cast<uint32_t>(state.range(0));
+
+  for (auto _ : state) {
+    boost::asio::io_context io;
+    NetworkSimulator network(12345);
+    MeshTransport transport(network);
+    NodeManager manager(io);
+    manager.setShardCount(static_cast<size_t>(state.range(1)));
+    manager.setMaxNodes(nodes);
+    manager.setTransport(&transport);
+    for (uint32_t i = 0; i < nodes; ++i) {
+      manager.createNode(NodeConfig{1000 + i, "BenchMesh", "password"});
+    }
+    manager.startAll();
+    manager.stopAll();
+  }
+  state.SetItemsProcessed(state.iterations() * nodes);
+}
+
+// Creating the same nodes in one createNodes() batch
+void BM_CreateNodesBatch(benchmark::State& state) {
+  const auto nodes = static_cast<uint32_t>(state.range(0));
+  std::vector<NodeConfig> configs;
+  for (uint32_t i = 0; i < nodes; ++i) {
+    configs.push_back(NodeConfig{1000 + i, "BenchMesh", "password"});
+  }
+
+  for (auto _ : state) {
+    boost::asio::io_context io;
+    NetworkSimulator network(12345);
+    MeshTransport transport(network);
+    NodeManager manager(io);
+    manager.setShardCount(static_cast<size_t>(state.range(1)));
+    manager.setMaxNodes(nodes);
+    manager.setTransport(&transport);
+    manager.createNodes(configs);
+    manager.startAll();
+    manager.stopAll();
+  }
+  state.SetItemsProcessed(state.iterations() * nodes);
+}
+
+// Building a random mesh (spanning tree plus ~2.5 extra links per node)
+// and linking it into a transport
+void BM_RandomTopology(benchmark::State& state) {
+  const auto nodes = static_cast<size_t>(state.range(0));
+  const float density = 5.0f / static_cast<float>(nodes);
+  std::vector<uint32_t> ids(nodes);
+  for (size_t i = 0; i < nodes; ++i) {
+    ids[i] = static_cast<uint32_t>(1000 + i);
+  }
+
+  for (auto _ : state) {
+    NetworkSimulator network(12345);
+    MeshTransport transport(network);
+    transport.addLinks(Topology::random(nodes, density, 42).getLinks(ids));
+    benchmark::DoNotOptimize(transport.getLinkCount());
+  }
+  state.SetItemsProcessed(state.iterations() * nodes);
+}
+
+} // anonymous namespace
+
+BENCHMARK(BM_IdlePollPerNode)->Arg(100)->Arg(500)->Arg(1000);
+BENCHMARK(BM_IdlePollPerTick)->Arg(100)->Arg(500)->Arg(1000);
+BENCHMARK(BM_UpdateAllIdle)->Arg(10)->Arg(100)->Arg(500)->Arg(1000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_CreateNodeLoop)->Args({1000, 1})->Args({1000, 4})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CreateNodesBatch)->Args({1000, 1})->Args({1000, 4})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RandomTopology)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
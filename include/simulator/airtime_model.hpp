@@ -0,0 +1,248 @@
+/**
+ * @file airtime_model.hpp
+ * @brief Shared-medium airtime contention between neighbouring nodes
+ *
+ * This file contains the AirtimeConfig type and the AirtimeModel class
+ * which makes nodes within radio range of each other share one medium:
+ * each frame occupies it for its airtime, and a node finding it busy
+ * waits and backs off before sending.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_AIRTIME_MODEL_HPP
+#define SIMULATOR_AIRTIME_MODEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace simulator {
+
+class CheckpointReader;
+class CheckpointWriter;
+
+/**
+ * @brief Shared-medium parameters
+ *
+ * A frame of n bytes occupies the medium for
+ * frame_overhead_us + n * 8 * 1e6 / bitrate_bps microseconds. The
+ * overhead and slot defaults describe 802.11n: preamble, MAC header, ACK
+ * and inter-frame spaces of one exchange, and 9 us slots. At the 6.5
+ * Mbit/s base rate a 100-byte frame then takes about 270 us, or some
+ * 360 KB/s of goodput per medium.
+ */
+struct AirtimeConfig {
+  uint32_t bitrate_bps = 0;             ///< PHY rate of the medium (0 = no contention)
+  uint32_t frame_overhead_us = 150;     ///< Fixed airtime of every frame
+  uint32_t slot_us = 9;                 ///< Backoff slot
+  uint32_t contention_window = 16;      ///< Backoff drawn from [0, contention_window) slots
+  uint32_t max_wait_ms = 100;           ///< Frames that would wait longer are dropped
+
+  /**
+   * @brief Checks whether the medium is modelled at all
+   */
+  bool isEnabled() const { return bitrate_bps > 0; }
+
+  /**
+   * @brief Validates the configuration
+   * @return true if valid, false otherwise
+   */
+  bool isValid() const { return contention_window > 0; }
+
+  /**
+   * @brief Gets the airtime of a frame
+   *
+   * @param bytes Frame size
+   * @return Time on the medium in microseconds
+   */
+  uint64_t airtimeUs(size_t bytes) const;
+};
+
+/**
+ * @brief Outcome of a frame's access to the medium
+ */
+struct MediumAccess {
+  bool sent = false;      ///< false if the medium stayed busy beyond max_wait_ms
+  uint32_t delay_ms = 0;  ///< Time from the send until the frame left the air
+};
+
+/**
+ * @brief Medium usage counters
+ */
+struct AirtimeStats {
+  uint64_t frames = 0;        ///< Frames sent over the air
+  uint64_t dropped = 0;       ///< Frames dropped waiting for the medium
+  uint64_t airtime_us = 0;    ///< Total airtime of the sent frames
+  uint64_t wait_us = 0;       ///< Total time frames waited for the medium
+  size_t domains = 0;         ///< Collision domains
+};
+
+/**
+ * @brief Collision domains of neighbouring nodes sharing one medium each
+ *
+ * painlessMesh runs a whole mesh on one WiFi channel, so every node's
+ * neighbours compete for the airtime around it. Nodes are grouped into
+ * collision domains from the neighbour sets: in ascending ID order, each
+ * node not yet in a domain opens one and pulls in its neighbours that
+ * are not yet in one either, approximating one radio range per domain.
+ *
+ * A domain's medium is a busy-until time in microseconds. Idle
+ * time refills it lazily: a send compares its time with the busy-until
+ * time and never walks the nodes, so a frame costs one hash lookup and a
+ * few integer operations. A frame finding the medium busy waits for it
+ * and backs off a random number of slots (one CounterRng sample from the
+ * sender's stream); if the wait would exceed max_wait_ms the frame is
+ * dropped, as a full transmit queue would drop it.
+ *
+ * Sends need not come in time order: a lookahead window admits the
+ * relays of all its ticks before it replays the nodes' own, earlier
+ * stamped sends. Each domain remembers the frames of the last
+ * REPLAY_HORIZON_MS by send time, and a send contends only with frames
+ * sent at or before its own time, never queueing behind later ones.
+ *
+ * Example usage:
+ * @code
+ * AirtimeModel medium;
+ * medium.configure(config, seed);
+ * medium.setNeighbours(links);
+ * MediumAccess access = medium.transmit(from, frame.size(), now_ms);
+ * if (access.sent) {
+ *   deliveryTime = now_ms + access.delay_ms + latency;
+ * }
+ * @endcode
+ *
+ * @note Frames only contend in the sender's domain; a receiver on the
+ *       border of two domains is not modelled as a hidden terminal.
+ */
+class AirtimeModel {
+public:
+  /**
+   * @brief Sets the medium parameters
+   *
+   * Keeps the domains and their busy times.
+   *
+   * @param config Medium parameters
+   * @param seed Simulation seed of the backoff streams
+   *
+   * @throws std::invalid_argument if config is invalid
+   */
+  void configure(const AirtimeConfig& config, uint32_t seed);
+
+  /**
+   * @brief Gets the medium parameters
+   */
+  const AirtimeConfig& getConfig() const { return config_; }
+
+  /**
+   * @brief Checks whether frames contend for airtime
+   */
+  bool isEnabled() const { return config_.isEnabled(); }
+
+  /**
+   * @brief Rebuilds the collision domains from the neighbour sets
+   *
+   * A new domain stays busy until the latest busy time of its members'
+   * old domains, for sends of any time. Nodes missing from @p neighbours get a domain of their
+   * own, when they first send if they are new.
+   *
+   * @param neighbours Neighbours of every node (symmetric)
+   */
+  void setNeighbours(const std::map<uint32_t, std::set<uint32_t>>& neighbours);
+
+  /**
+   * @brief Sends a frame over the sender's medium
+   *
+   * @param node Sender
+   * @param bytes Frame size
+   * @param now_ms Send time in milliseconds
+   * @return Whether the frame was sent, and its delay
+   */
+  MediumAccess transmit(uint32_t node, size_t bytes, uint64_t now_ms);
+
+  /**
+   * @brief Gets the collision domain of a node
+   *
+   * @return Domain index, or NO_DOMAIN if the node has not sent or been
+   *         given neighbours
+   */
+  uint32_t getDomainOf(uint32_t node) const;
+
+  /**
+   * @brief Gets the usage counters
+   */
+  AirtimeStats getStats() const;
+
+  /**
+   * @brief Writes the domains, busy times and backoff streams
+   *
+   * @param out Checkpoint being written
+   */
+  void saveState(CheckpointWriter& out) const;
+
+  /**
+   * @brief Restores the state written by saveState()
+   *
+   * @param in Checkpoint being read
+   *
+   * @throws std::runtime_error if the checkpoint is malformed
+   */
+  void loadState(CheckpointReader& in);
+
+  /// Domain of a node that has none
+  static constexpr uint32_t NO_DOMAIN = UINT32_MAX;
+
+  /// How far a send may lag its domain's latest send and still skip the
+  /// frames sent after it (a lookahead window spans at most 100 10ms ticks)
+  static constexpr uint64_t REPLAY_HORIZON_MS = 1000;
+
+private:
+  struct Medium {
+    uint32_t domain{NO_DOMAIN};     ///< Collision domain
+    uint64_t backoff_sequence{0};   ///< Backoff samples drawn
+  };
+
+  struct Frame {
+    uint64_t send_us;               ///< Send time
+    uint64_t end_us;                ///< Time the frame left the air
+    uint64_t prefix_end_us;         ///< Latest end_us of this and earlier sent frames
+  };
+
+  struct Domain {
+    uint64_t busy_until_us{0};      ///< End of the latest frame
+    uint64_t settled_us{0};         ///< End of the latest frame dropped from recent
+    std::deque<Frame> recent;       ///< Frames within the replay horizon, by send time
+  };
+
+  /**
+   * @brief Gets the record of a node, opening a domain for it if needed
+   */
+  Medium& mediumOf(uint32_t node);
+
+  /**
+   * @brief Gets the time a domain's medium is busy until for a send
+   *
+   * Counts only frames sent at or before @p now_us.
+   */
+  static uint64_t busyUntil(const Domain& domain, uint64_t now_us);
+
+  /**
+   * @brief Records a frame on a domain's medium
+   */
+  static void occupy(Domain& domain, uint64_t send_us, uint64_t end_us);
+
+  AirtimeConfig config_;                            ///< Medium parameters
+  uint32_t seed_{0};                                ///< Seed of the backoff streams
+  std::unordered_map<uint32_t, Medium> nodes_;      ///< Per-node domain and backoff stream
+  std::vector<Domain> domains_;                     ///< Busy times of each domain
+  AirtimeStats stats_;                              ///< Usage counters
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_AIRTIME_MODEL_HPP
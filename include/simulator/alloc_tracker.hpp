@@ -0,0 +1,179 @@
+/**
+ * @file alloc_tracker.hpp
+ * @brief Heap allocations counted by simulator subsystem
+ *
+ * This file contains the AllocTracker, which counts the allocations made
+ * through the global operator new under the subsystem tag of the calling
+ * thread, and the SIM_ALLOC_SCOPE macro that sets that tag for the rest of
+ * a scope.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_ALLOC_TRACKER_HPP
+#define SIMULATOR_ALLOC_TRACKER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/**
+ * @brief Whether operator new is replaced to count allocations (0 or 1)
+ *
+ * Set with the ENABLE_ALLOC_TRACKING CMake option. When 0, SIM_ALLOC_SCOPE
+ * expands to nothing and allocations go straight to the C++ runtime.
+ */
+#ifndef SIMULATOR_ENABLE_ALLOC_TRACKING
+#define SIMULATOR_ENABLE_ALLOC_TRACKING 0
+#endif
+
+namespace simulator {
+
+/**
+ * @brief Subsystem an allocation is counted against
+ */
+enum class AllocTag : uint8_t {
+  OTHER,     ///< Anything outside a tagged scope (setup, metrics, logging)
+  MESH,      ///< painlessMesh instances, their updates and connections
+  NETWORK,   ///< NetworkSimulator queues and maps, MeshTransport links and routes
+  EVENTS,    ///< Scenario event queue and event actions
+  FIRMWARE,  ///< Firmware instances, setup(), loop(), tasks and callbacks
+  ASIO       ///< io_context handlers and their buffers
+};
+
+/// Number of AllocTag values
+constexpr size_t ALLOC_TAG_COUNT = 6;
+
+/**
+ * @brief Gets the report name of a tag, e.g. "network"
+ */
+const char* allocTagName(AllocTag tag);
+
+/**
+ * @brief Allocation counters of one tag
+ */
+struct AllocStats {
+  uint64_t allocations = 0;   ///< Blocks allocated
+  uint64_t frees = 0;         ///< Blocks freed
+  uint64_t allocated_bytes = 0;  ///< Bytes allocated over the run
+  int64_t live_bytes = 0;     ///< Bytes allocated and not yet freed
+  int64_t peak_bytes = 0;     ///< Highest live_bytes so far
+
+  /**
+   * @brief Gets the number of blocks not yet freed
+   */
+  int64_t liveBlocks() const {
+    return static_cast<int64_t>(allocations) - static_cast<int64_t>(frees);
+  }
+};
+
+/// Counters of every tag, indexed by AllocTag
+using AllocSnapshot = std::array<AllocStats, ALLOC_TAG_COUNT>;
+
+/**
+ * @brief Counts heap allocations per subsystem
+ *
+ * With ENABLE_ALLOC_TRACKING, the global operator new and delete are
+ * replaced. Every block carries a small header holding its size and the
+ * tag that was current on the allocating thread, so a block freed under
+ * another tag, or on another thread, is still subtracted from its own
+ * tag. Counters are relaxed atomics; a block costs a few atomic adds and
+ * 16 bytes of header.
+ *
+ * The tag of a thread is OTHER until an AllocScope (SIM_ALLOC_SCOPE) sets
+ * it; scopes nest, so firmware called from inside a mesh update counts
+ * as firmware. Live bytes of a tag can go negative when a block is freed
+ * after being handed to another tag's container; the sum over all tags
+ * is always exact.
+ *
+ * Without ENABLE_ALLOC_TRACKING every counter stays 0.
+ *
+ * Example usage:
+ * @code
+ * {
+ *   SIM_ALLOC_SCOPE(AllocTag::FIRMWARE);
+ *   firmware->loop();
+ * }
+ * AllocTracker::print(AllocTracker::snapshot(), manager.getNodeCount(), std::cout);
+ * @endcode
+ */
+class AllocTracker {
+public:
+  /**
+   * @brief Checks whether allocations are counted in this build
+   */
+  static constexpr bool isEnabled() { return SIMULATOR_ENABLE_ALLOC_TRACKING != 0; }
+
+  /**
+   * @brief Gets the tag of the calling thread
+   */
+  static AllocTag getTag();
+
+  /**
+   * @brief Sets the tag of the calling thread
+   *
+   * @param tag New tag
+   * @return Previous tag
+   */
+  static AllocTag setTag(AllocTag tag);
+
+  /**
+   * @brief Reads the counters of every tag
+   */
+  static AllocSnapshot snapshot();
+
+  /**
+   * @brief Gets the counters summed over all tags
+   */
+  static AllocStats total(const AllocSnapshot& snapshot);
+
+  /**
+   * @brief Prints live bytes, peak and blocks per tag
+   *
+   * @param snapshot Counters to print
+   * @param nodes Nodes of the run, for per-node averages (0 to omit)
+   * @param out Stream to print to
+   */
+  static void print(const AllocSnapshot& snapshot, size_t nodes, std::ostream& out);
+
+  /**
+   * @brief Formats live bytes per tag as one line, e.g. for progress logs
+   *
+   * @param snapshot Counters to format
+   * @return "mesh=12 MiB network=3 MiB ..." (tags with live bytes only)
+   */
+  static std::string summary(const AllocSnapshot& snapshot);
+};
+
+/**
+ * @brief Sets the allocation tag of the calling thread for a scope
+ */
+class AllocScope {
+public:
+  explicit AllocScope(AllocTag tag) : previous_(AllocTracker::setTag(tag)) {}
+  ~AllocScope() { AllocTracker::setTag(previous_); }
+
+  AllocScope(const AllocScope&) = delete;
+  AllocScope& operator=(const AllocScope&) = delete;
+
+private:
+  AllocTag previous_;
+};
+
+} // namespace simulator
+
+#define SIM_ALLOC_CONCAT_INNER(a, b) a##b
+#define SIM_ALLOC_CONCAT(a, b) SIM_ALLOC_CONCAT_INNER(a, b)
+
+#if SIMULATOR_ENABLE_ALLOC_TRACKING
+/// Counts the allocations of the rest of the enclosing scope against @p tag
+#define SIM_ALLOC_SCOPE(tag) \
+  ::simulator::AllocScope SIM_ALLOC_CONCAT(sim_alloc_scope_, __LINE__)(tag)
+#else
+#define SIM_ALLOC_SCOPE(tag) do {} while (0)
+#endif
+
+#endif // SIMULATOR_ALLOC_TRACKER_HPP
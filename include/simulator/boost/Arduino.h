@@ -0,0 +1,70 @@
+/**
+ * @file Arduino.h
+ * @brief Arduino compatibility header with simulator-controlled time
+ *
+ * This directory comes first on the include path, so every
+ * #include "Arduino.h" of the simulator, painlessMesh, TaskScheduler and
+ * firmware lands here. The header pulls in painlessMesh's test shim and
+ * replaces its millis(), micros() and delay() with versions backed by
+ * simulator::VirtualTime. painlessMesh's getNodeTime() is micros() plus
+ * the time sync offset, so it follows the same clock, including each
+ * node's configured offset and drift.
+ *
+ * The shim is located by CMake (SIMULATOR_ARDUINO_SHIM); without that
+ * definition, the next Arduino.h on the include path is used.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_BOOST_ARDUINO_H
+#define SIMULATOR_BOOST_ARDUINO_H
+
+#include "simulator/platform_compat.hpp"
+#include "simulator/virtual_time.hpp"
+
+// Headers the shim includes, so they are parsed before the renaming below
+#include <cstdint>
+#include <string>
+#include <sys/time.h>
+#include <unistd.h>
+
+// Keep the shim's wall-clock functions out of the way under other names
+#define millis simulator_shim_wall_millis
+#define micros simulator_shim_wall_micros
+#define delay simulator_shim_wall_delay
+
+#if defined(SIMULATOR_ARDUINO_SHIM)
+#include SIMULATOR_ARDUINO_SHIM
+#elif defined(__GNUC__) || defined(__clang__)
+#include_next <Arduino.h>
+#else
+#error "SIMULATOR_ARDUINO_SHIM must name painlessMesh's Arduino.h on this compiler"
+#endif
+
+#undef millis
+#undef micros
+#undef delay
+
+/**
+ * @brief Milliseconds of the running node's clock
+ */
+inline unsigned long millis() {
+  return static_cast<unsigned long>(simulator::VirtualTime::millis());
+}
+
+/**
+ * @brief Microseconds of the running node's clock
+ */
+inline unsigned long micros() {
+  return static_cast<unsigned long>(simulator::VirtualTime::micros());
+}
+
+/**
+ * @brief Waits; returns at once when the simulation drives time
+ */
+inline void delay(unsigned long ms) {
+  simulator::VirtualTime::delay(static_cast<uint32_t>(ms));
+}
+
+#endif // SIMULATOR_BOOST_ARDUINO_H
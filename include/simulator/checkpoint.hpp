@@ -0,0 +1,225 @@
+/**
+ * @file checkpoint.hpp
+ * @brief Binary simulation checkpoints
+ *
+ * This file contains the CheckpointWriter and CheckpointReader classes
+ * which components use to serialize their state, and the Checkpoint
+ * container which stores that state with its virtual timestamp on disk.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_CHECKPOINT_HPP
+#define SIMULATOR_CHECKPOINT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace simulator {
+
+/**
+ * @brief Section tags marking each component's state in a checkpoint
+ *
+ * Readers check the tag before reading a section, so a checkpoint
+ * restored into a differently built simulation fails loudly instead of
+ * misreading bytes.
+ */
+enum CheckpointSection : uint32_t {
+  CHECKPOINT_NETWORK = 0x5754454E,    ///< "NETW": NetworkSimulator
+  CHECKPOINT_TRANSPORT = 0x534E5254,  ///< "TRNS": MeshTransport
+  CHECKPOINT_NODES = 0x53444F4E,      ///< "NODS": NodeManager and firmware
+  CHECKPOINT_END = 0x21444E45         ///< "END!": last section
+};
+
+/**
+ * @brief Appends component state to a checkpoint buffer
+ *
+ * Values are stored in host byte order without padding, like LinkTrace
+ * files; checkpoints are meant to be restored on the same kind of host.
+ *
+ * Example usage:
+ * @code
+ * CheckpointWriter out;
+ * out.beginSection(CHECKPOINT_NETWORK);
+ * out.write<uint32_t>(link_count);
+ * out.writeString(payload);
+ * @endcode
+ */
+class CheckpointWriter {
+public:
+  /**
+   * @brief Appends an arithmetic or enum value
+   */
+  template <typename T>
+  void write(T value) {
+    static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value,
+                  "Only arithmetic and enum values can be written directly");
+    writeBytes(&value, sizeof(value));
+  }
+
+  /**
+   * @brief Appends a length-prefixed string
+   */
+  void writeString(const std::string& value) {
+    write<uint32_t>(static_cast<uint32_t>(value.size()));
+    writeBytes(value.data(), value.size());
+  }
+
+  /**
+   * @brief Appends raw bytes
+   */
+  void writeBytes(const void* data, size_t size) {
+    const size_t offset = buffer_.size();
+    buffer_.resize(offset + size);
+    if (size > 0) {
+      std::memcpy(buffer_.data() + offset, data, size);
+    }
+  }
+
+  /**
+   * @brief Marks the start of a component's state
+   */
+  void beginSection(CheckpointSection section) { write<uint32_t>(section); }
+
+  /**
+   * @brief Gets the bytes written so far
+   */
+  const std::vector<uint8_t>& data() const { return buffer_; }
+
+  /**
+   * @brief Takes the bytes written, leaving the writer empty
+   */
+  std::vector<uint8_t> release() { return std::move(buffer_); }
+
+private:
+  std::vector<uint8_t> buffer_;
+};
+
+/**
+ * @brief Reads component state back from a checkpoint buffer
+ *
+ * Every read is bounds-checked.
+ */
+class CheckpointReader {
+public:
+  /**
+   * @brief Construct a reader over a buffer
+   *
+   * @param data First byte (the buffer must outlive the reader)
+   * @param size Number of bytes
+   */
+  CheckpointReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+  /**
+   * @brief Construct a reader over a byte vector
+   */
+  explicit CheckpointReader(const std::vector<uint8_t>& data)
+    : CheckpointReader(data.data(), data.size()) {}
+
+  /**
+   * @brief Reads an arithmetic or enum value
+   *
+   * @throws std::runtime_error if the buffer ends first
+   */
+  template <typename T>
+  T read() {
+    static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value,
+                  "Only arithmetic and enum values can be read directly");
+    T value;
+    readBytes(&value, sizeof(value));
+    return value;
+  }
+
+  /**
+   * @brief Reads a length-prefixed string
+   *
+   * @throws std::runtime_error if the buffer ends first
+   */
+  std::string readString();
+
+  /**
+   * @brief Reads raw bytes
+   *
+   * @throws std::runtime_error if the buffer ends first
+   */
+  void readBytes(void* out, size_t size);
+
+  /**
+   * @brief Checks the tag of the next section
+   *
+   * @throws std::runtime_error if the next section is a different one
+   */
+  void expectSection(CheckpointSection section);
+
+  /**
+   * @brief Gets the number of unread bytes
+   */
+  size_t remaining() const { return size_ - offset_; }
+
+private:
+  const uint8_t* data_;
+  size_t size_;
+  size_t offset_ = 0;
+};
+
+/**
+ * @brief Simulation state at one virtual timestamp
+ *
+ * A checkpoint is taken at the start of a tick, before the events due at
+ * that time run. Restoring one rebuilds the scenario as usual and then
+ * overwrites the state of each component, so a single warm-up can be
+ * forked into many what-if runs that differ only in later events.
+ *
+ * File layout: magic "PMCKPT01", format version, seed, virtual time in
+ * microseconds, state size, then the sections written by the components.
+ *
+ * Example usage:
+ * @code
+ * CheckpointWriter out;
+ * network.saveState(out);
+ * Checkpoint checkpoint{clock.nowUs(), seed, out.release()};
+ * checkpoint.save("warmup.ckpt");
+ *
+ * Checkpoint restored = Checkpoint::load("warmup.ckpt");
+ * CheckpointReader in(restored.state);
+ * network.loadState(in);
+ * @endcode
+ */
+struct Checkpoint {
+  /// Current file format version
+  static constexpr uint32_t VERSION = 2;
+
+  uint64_t time_us = 0;           ///< Virtual time of the checkpoint
+  uint32_t seed = 0;              ///< Simulation seed of the run
+  std::vector<uint8_t> state;     ///< Component sections
+
+  /**
+   * @brief Writes the checkpoint to a file
+   *
+   * @param path Output file
+   *
+   * @throws std::runtime_error if the file cannot be written
+   */
+  void save(const std::string& path) const;
+
+  /**
+   * @brief Reads a checkpoint from a file
+   *
+   * @param path Checkpoint file
+   * @return Checkpoint
+   *
+   * @throws std::runtime_error if the file cannot be read or is not a
+   *         checkpoint of this version
+   */
+  static Checkpoint load(const std::string& path);
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_CHECKPOINT_HPP
@@ -0,0 +1,143 @@
+/**
+ * @file churn_generator.hpp
+ * @brief Lazy stochastic node and link churn
+ * 
+ * This file contains the ChurnGenerator event source, which produces node
+ * crashes and restarts or link drops and restores from failure and repair
+ * time distributions as virtual time advances.
+ * 
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_CHURN_GENERATOR_HPP
+#define SIMULATOR_CHURN_GENERATOR_HPP
+
+#include "simulator/event_source.hpp"
+#include "simulator/counter_rng.hpp"
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace simulator {
+
+/**
+ * @brief Distribution of failure or repair durations
+ */
+struct ChurnDuration {
+  enum Type {
+    EXPONENTIAL,  ///< Memoryless; constant failure rate
+    WEIBULL,      ///< Shape < 1 models infant mortality, > 1 wear-out
+    FIXED         ///< Always exactly the mean
+  };
+  
+  Type type = EXPONENTIAL;
+  double mean_s = 1.0;    ///< Mean duration in seconds
+  double shape = 1.0;     ///< Weibull shape parameter (k)
+  
+  /**
+   * @brief Draw one duration
+   * 
+   * @param rng Random stream
+   * @return Duration in microseconds (at least 1)
+   */
+  uint64_t sampleUs(CounterRng& rng) const;
+};
+
+/**
+ * @brief Event source alternating targets between failed and repaired
+ * 
+ * Every target (a node, or an undirected link) is an independent
+ * alternating renewal process: up for a `failure` duration, then down for
+ * a `repair` duration. Only each target's next transition is stored, in a
+ * min-heap, so memory is O(targets) no matter how long the run is.
+ * 
+ * Node churn produces NodeCrashEvent and NodeRestartEvent; link churn
+ * produces ConnectionDropEvent and ConnectionRestoreEvent.
+ * 
+ * Durations come from CounterRng streams keyed by (seed, target), so a
+ * seed replays the same churn and adding a target never shifts another.
+ * 
+ * Example usage:
+ * @code
+ * ChurnDuration mtbf{ChurnDuration::WEIBULL, 3600.0, 1.5};
+ * ChurnDuration mttr{ChurnDuration::EXPONENTIAL, 120.0, 1.0};
+ * scheduler.addSource(ChurnGenerator::forNodes({1001, 1002}, mtbf, mttr, seed));
+ * @endcode
+ */
+class ChurnGenerator : public EventSource {
+public:
+  /**
+   * @brief Create crash/restart churn for nodes
+   * 
+   * @param nodes Node IDs
+   * @param failure Time to failure
+   * @param repair Time to repair
+   * @param seed Simulation seed
+   * @param start_us No failure happens before this virtual time
+   * @param salt Separates the random streams of several generators
+   * @return Generator
+   */
+  static std::unique_ptr<ChurnGenerator> forNodes(const std::vector<uint32_t>& nodes,
+                                                  const ChurnDuration& failure,
+                                                  const ChurnDuration& repair,
+                                                  uint32_t seed, uint64_t start_us = 0,
+                                                  uint32_t salt = 0);
+  
+  /**
+   * @brief Create drop/restore churn for links
+   * 
+   * @param links Undirected links as (from, to) node ID pairs
+   * @param failure Time to failure
+   * @param repair Time to repair
+   * @param seed Simulation seed
+   * @param start_us No failure happens before this virtual time
+   * @param salt Separates the random streams of several generators
+   * @return Generator
+   */
+  static std::unique_ptr<ChurnGenerator> forLinks(
+      const std::vector<std::pair<uint32_t, uint32_t>>& links,
+      const ChurnDuration& failure, const ChurnDuration& repair,
+      uint32_t seed, uint64_t start_us = 0, uint32_t salt = 0);
+  
+  uint64_t getNextTimeUs() const override;
+  std::unique_ptr<Event> next() override;
+  
+  /**
+   * @brief Get the number of churning targets
+   */
+  size_t getTargetCount() const { return targets_.size(); }
+
+private:
+  /**
+   * @brief One churning node or link
+   */
+  struct Target {
+    uint32_t from;          ///< Node ID (or link endpoint)
+    uint32_t to;            ///< Other link endpoint (unused for nodes)
+    bool up;                ///< Currently up (next transition is a failure)
+    uint64_t next_us;       ///< Time of the next transition
+    uint64_t key;           ///< Random stream key
+    uint64_t draws;         ///< Durations drawn so far
+  };
+  
+  ChurnGenerator(bool links, const ChurnDuration& failure, const ChurnDuration& repair,
+                 uint32_t seed, uint32_t salt);
+  
+  void addTarget(uint32_t from, uint32_t to, uint64_t start_us);
+  uint64_t draw(Target& target, const ChurnDuration& duration);
+  bool later(uint32_t a, uint32_t b) const;
+  
+  bool links_;
+  ChurnDuration failure_;
+  ChurnDuration repair_;
+  uint32_t seed_;
+  uint32_t salt_;
+  std::vector<Target> targets_;
+  std::vector<uint32_t> heap_;  ///< Min-heap of target indices by next_us
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_CHURN_GENERATOR_HPP
@@ -13,6 +13,8 @@
 #define SIMULATOR_CLI_OPTIONS_HPP
 
 #include <string>
+#include <utility>
+#include <vector>
 #include <boost/optional.hpp>
 
 namespace simulator {
@@ -33,6 +35,34 @@ struct CLIOptions {
   bool help = false;                          ///< Show help message
   bool version = false;                       ///< Show version information
   boost::optional<float> time_scale;          ///< Override time scale multiplier
+  bool unbounded = false;                     ///< Run virtual clock as fast as possible
+  boost::optional<uint32_t> threads;          ///< Override worker thread count
+  boost::optional<uint32_t> max_nodes;        ///< Override node cap
+  boost::optional<uint32_t> seed;             ///< Override random seed
+  boost::optional<uint16_t> coordinator_port; ///< Run as distributed coordinator on this port
+  boost::optional<uint32_t> workers;          ///< Worker processes the coordinator waits for
+  std::string worker_host;                    ///< Coordinator host (worker mode)
+  boost::optional<uint16_t> worker_port;      ///< Coordinator port (worker mode)
+  boost::optional<uint32_t> rank;             ///< This worker's rank (worker mode)
+  std::string checkpoint_file;                ///< Write a checkpoint to this file
+  boost::optional<float> checkpoint_at;       ///< Virtual time of the checkpoint (seconds)
+  std::string restore_file;                   ///< Resume from this checkpoint file
+  bool scenario_cache = true;                 ///< Use and write compiled scenarios (<config>.pmsc)
+  std::string capture_file;                   ///< Write a packet capture to this file
+  std::vector<std::string> capture_nodes;     ///< Capture only traffic from or to these nodes
+  std::vector<std::pair<std::string, std::string>> capture_links;  ///< Capture only these links
+  uint32_t capture_payload = 0;               ///< Payload bytes kept per captured message
+  boost::optional<uint16_t> metrics_port;     ///< Serve live Prometheus metrics on this port
+  uint32_t profile_top = 0;                   ///< Report firmware call times of this many nodes (0 = off)
+  std::string trace_file;                     ///< Write a Chrome trace of the run loop to this file
+  uint32_t update_budget_us = 0;              ///< Flag node updates longer than this (0 = off)
+  bool memory_report = false;                 ///< Report heap allocations per subsystem
+  uint32_t dump_window_ms = 1000;             ///< Wall time a state dump measures node costs for
+  bool dump_profile = false;                  ///< Sample the simulation thread during state dumps
+  std::string sweep_file;                     ///< Run the scenario over this parameter sweep
+  boost::optional<uint32_t> jobs;             ///< Concurrent batch runs (0 = hardware threads)
+  uint32_t ensemble_runs = 0;                 ///< Run the scenario with this many seeds (0 = off)
+  boost::optional<double> ci_width;           ///< Stop an ensemble once the delivery ratio CI is narrower
 };
 
 /**
@@ -17,8 +17,11 @@
 #include <cstdint>
 #include <memory>
 #include <map>
+#include <utility>
+#include <iosfwd>
 #include <boost/optional.hpp>
 #include "simulator/network_simulator.hpp"
+#include "simulator/radio_model.hpp"
 
 namespace YAML {
   class Node;
@@ -34,7 +37,8 @@ enum class TopologyType {
   STAR,      ///< Star topology with central hub
   RING,      ///< Ring topology with bidirectional links
   MESH,      ///< Full mesh (all nodes connected)
-  CUSTOM     ///< Custom connections defined explicitly
+  CUSTOM,    ///< Custom connections defined explicitly
+  RADIO      ///< Nodes in radio range of each other (needs positions)
 };
 
 /**
@@ -74,8 +78,13 @@ struct NetworkConfig {
   std::vector<ConnectionPacketLossConfig> specific_packet_losses; ///< Per-connection packet loss overrides
   BandwidthConfig default_bandwidth;                       ///< Default bandwidth settings
   std::vector<ConnectionBandwidthConfig> specific_bandwidths; ///< Per-connection bandwidth overrides
+  AirtimeConfig airtime;                                   ///< Shared-medium contention (off by default)
   float packet_loss = 0.0f;                                ///< Legacy packet loss rate (0.0-1.0)
   uint64_t bandwidth = 1000000;                            ///< Legacy bandwidth in bits per second
+  std::string transport = "tcp";                           ///< Mesh transport ("tcp" or "in_process")
+  std::string delivery_queue = "heap";                     ///< Delivery queue ("heap" or "timing_wheel")
+  bool coalesce = false;                                   ///< One queue entry per link and delivery ms
+  std::string trace;                                       ///< Link trace file to play back (empty = none)
 };
 
 /**
@@ -85,10 +94,21 @@ struct SimulationConfig {
   std::string name;                      ///< Simulation name
   std::string description;               ///< Optional description
   uint32_t duration = 0;                 ///< Duration in seconds (0 = infinite)
-  float time_scale = 1.0f;               ///< Time scale multiplier (1.0 = real-time)
+  float time_scale = 1.0f;               ///< Time scale multiplier (1.0 = real-time, 0 = unbounded)
   uint32_t seed = 0;                     ///< Random seed (0 = random)
+  uint32_t threads = 1;                  ///< Worker threads updating nodes (1 = single-threaded)
+  std::string sync = "tick";             ///< Shard synchronization ("tick" or "lookahead")
+  std::string partition = "block";       ///< Distributed node split ("block" or "locality")
+  bool lazy_nodes = false;               ///< Build mesh objects on first start, release them on stop
+  std::string node_engine = "mesh";      ///< Node engine ("mesh" = painlessMesh, "fluid" = transport routing only)
+  std::string firmware_clock = "wall";   ///< Time base of firmware millis()/micros() ("wall" or "virtual")
+  uint32_t max_tick_ms = 10;             ///< Longest idle clock advance in ms (10 = fixed ticks)
+  uint32_t max_nodes = 1000;             ///< Node cap (NodeManager::setMaxNodes())
 };
 
+/// Firmware-specific key/value configuration
+using FirmwareConfigMap = std::map<std::string, std::string>;
+
 /**
  * @brief Node configuration (extends NodeConfig from virtual_node.hpp)
  */
@@ -97,13 +117,15 @@ struct NodeConfigExtended {
   uint32_t nodeId = 0;                   ///< Numeric node ID
   std::string type;                      ///< Node type (sensor, bridge, etc.)
   std::string firmware;                  ///< Firmware path
-  std::vector<int> position;             ///< Position [x, y] for visualization
+  std::vector<int> position;             ///< Position [x, y] in meters (radio topology, visualization)
   
   // Core mesh configuration
   std::string mesh_prefix;               ///< Mesh network SSID prefix
   std::string mesh_password;             ///< Mesh network password
   uint16_t mesh_port = 5555;             ///< Mesh network port
-  std::map<std::string, std::string> firmwareConfig;  ///< Firmware-specific configuration
+  std::shared_ptr<const FirmwareConfigMap> firmwareConfig;  ///< Firmware-specific configuration (shared by template nodes, may be null)
+  int32_t clock_offset_ms = 0;           ///< Local clock offset from simulation time
+  double clock_drift_ppm = 0.0;          ///< Local clock rate error (+ = runs fast)
   
   // Extended configuration (firmware-specific)
   boost::optional<uint32_t> sensor_interval;      ///< Sensor reading interval (ms)
@@ -131,6 +153,7 @@ struct TopologyConfig {
   float density = 0.3f;                      ///< Connection density (for random)
   bool bidirectional = true;                 ///< Bidirectional links (for ring)
   std::vector<std::pair<std::string, std::string>> connections;  ///< Custom connections
+  RadioConfig radio;                         ///< Propagation parameters (for radio)
 };
 
 /**
@@ -159,6 +182,7 @@ enum class EventAction {
  */
 struct EventConfig {
   uint32_t time = 0;                     ///< Event time in seconds
+  uint64_t time_ms = 0;                  ///< Event time in milliseconds (overrides time when non-zero)
   EventAction action;                    ///< Event action type
   std::string target;                    ///< Target node ID
   std::vector<std::string> targets;      ///< Multiple target node IDs
@@ -179,6 +203,48 @@ struct EventConfig {
   float packet_loss = 0.30f;             ///< Packet loss 0.0-1.0 (for connection_degrade)
 };
 
+/**
+ * @brief Random duration used by churn processes
+ */
+struct DurationConfig {
+  std::string distribution = "exponential";  ///< exponential, weibull or fixed
+  double mean = 0.0;                     ///< Mean duration in seconds
+  double shape = 1.0;                    ///< Weibull shape parameter (k)
+};
+
+/**
+ * @brief Stochastic churn source configuration
+ * 
+ * Each target alternates between up and down: it fails after a `failure`
+ * duration (MTBF) and recovers after a `repair` duration (MTTR).
+ */
+struct ChurnConfig {
+  std::string type = "node";             ///< node (crash/restart) or link (drop/restore)
+  std::vector<std::string> targets;      ///< Nodes that churn (empty = all nodes)
+  std::vector<std::pair<std::string, std::string>> links;  ///< Links that flap (type link)
+  DurationConfig failure;                ///< Time to failure
+  DurationConfig repair;                 ///< Time to repair
+  uint32_t start = 0;                    ///< Churn starts after this many seconds
+};
+
+/**
+ * @brief Synthetic traffic stream configuration
+ *
+ * Each source sends `rate` messages of `size` bytes per second, to the
+ * sink (all_to_sink) or as broadcasts (all_to_all).
+ */
+struct TrafficConfig {
+  std::string pattern = "all_to_sink";   ///< all_to_sink or all_to_all
+  std::string arrival = "constant";      ///< constant, poisson or bursty
+  std::vector<std::string> sources;      ///< Sending nodes (empty = all nodes but the sink)
+  std::string sink;                      ///< Destination of all_to_sink
+  double rate = 1.0;                     ///< Mean messages per second per source
+  uint32_t burst = 10;                   ///< Messages per burst (bursty)
+  uint32_t size = 64;                    ///< Message size in bytes
+  uint32_t start = 0;                    ///< Traffic starts after this many seconds
+  uint32_t stop = 0;                     ///< Traffic stops after this many seconds (0 = never)
+};
+
 /**
  * @brief Metrics collection configuration
  */
@@ -189,6 +255,20 @@ struct MetricsConfig {
   std::vector<std::string> export_formats;  ///< Export formats (csv, json, graphviz)
 };
 
+/**
+ * @brief UDP gateway between bridge nodes and a real backend
+ */
+struct GatewayConfig {
+  std::string listen;                    ///< Local "host:port" the backend sends to (empty = no gateway)
+  std::string backend;                   ///< "host:port" the bridges' traffic is sent to
+  std::vector<std::string> nodes;        ///< Exposed nodes (empty = all nodes of type bridge)
+  uint32_t max_datagram = 1400;          ///< Largest datagram sent, in bytes
+  bool broadcasts = false;               ///< Also forward broadcasts the bridges receive
+
+  /// Whether a gateway is configured
+  bool isEnabled() const { return !listen.empty(); }
+};
+
 /**
  * @brief Complete scenario configuration
  */
@@ -199,7 +279,10 @@ struct ScenarioConfig {
   std::vector<NodeTemplate> templates;   ///< Node templates
   TopologyConfig topology;               ///< Topology configuration
   std::vector<EventConfig> events;       ///< Scheduled events
+  std::vector<ChurnConfig> churn;        ///< Stochastic churn sources
+  std::vector<TrafficConfig> traffic;    ///< Synthetic traffic streams
   MetricsConfig metrics;                 ///< Metrics configuration
+  GatewayConfig gateway;                 ///< Backend gateway (optional)
 };
 
 /**
@@ -278,11 +361,23 @@ public:
    * @brief Expands node templates into concrete nodes
    * 
    * @param config Configuration with templates to expand
+   * @return Number of nodes generated
+   * 
+   * This modifies the config in-place, appending the nodes of each
+   * template after the explicit nodes. Nodes of a template share its
+   * firmware configuration. Large expansions are split across
+   * simulation.threads threads. A generated node whose numeric ID is
+   * already taken is rehashed deterministically until it is unique;
+   * duplicate string IDs are reported by getValidationErrors().
+   */
+  size_t expandTemplates(ScenarioConfig& config);
+  
+  /**
+   * @brief Sets the stream receiving template expansion details
    * 
-   * This modifies the config in-place, expanding all templates
-   * into individual node configurations.
+   * @param out Log stream, or nullptr (the default) for quiet expansion
    */
-  void expandTemplates(ScenarioConfig& config);
+  void setLogStream(std::ostream* out) { log_ = out; }
   
   /**
    * @brief Gets the last error message
@@ -294,13 +389,22 @@ public:
   /**
    * @brief Generates unique node ID from string
    * 
+   * Uses 32-bit FNV-1a, so the same string maps to the same ID on every
+   * platform. expandTemplates() rehashes generated nodes whose ID is
+   * already taken with increasing attempt numbers.
+   * 
    * @param id_str String identifier
-   * @return uint32_t node ID
+   * @param attempt Rehash attempt (0 for the plain hash)
+   * @return uint32_t node ID (non-zero, 31 bits)
    */
-  uint32_t generateNodeId(const std::string& id_str);
+  static uint32_t generateNodeId(const std::string& id_str, uint32_t attempt = 0);
+
+  /// Fewest generated nodes worth a thread of their own
+  static constexpr size_t EXPAND_NODES_PER_THREAD = 4096;
 
 private:
   std::string last_error_;               ///< Last error message
+  std::ostream* log_{nullptr};           ///< Expansion log stream (nullptr = quiet)
   
   /**
    * @brief Parses simulation configuration
@@ -350,6 +454,30 @@ private:
    */
   EventConfig parseEvent(const YAML::Node& node);
   
+  /**
+   * @brief Parses stochastic churn configuration
+   * 
+   * @param node YAML node
+   * @return ChurnConfig
+   */
+  ChurnConfig parseChurn(const YAML::Node& node);
+  
+  /**
+   * @brief Parses a churn duration distribution
+   * 
+   * @param node YAML node
+   * @return DurationConfig
+   */
+  DurationConfig parseDuration(const YAML::Node& node);
+  
+  /**
+   * @brief Parses a synthetic traffic stream
+   * 
+   * @param node YAML node
+   * @return TrafficConfig
+   */
+  TrafficConfig parseTraffic(const YAML::Node& node);
+  
   /**
    * @brief Parses metrics configuration
    * 
@@ -358,6 +486,14 @@ private:
    */
   MetricsConfig parseMetrics(const YAML::Node& node);
   
+  /**
+   * @brief Parses gateway configuration
+   * 
+   * @param node YAML node
+   * @return GatewayConfig
+   */
+  GatewayConfig parseGateway(const YAML::Node& node);
+  
   /**
    * @brief Validates simulation configuration
    * 
@@ -409,6 +545,44 @@ private:
                     const std::vector<NodeConfigExtended>& all_nodes,
                     std::vector<ValidationError>& errors);
   
+  /**
+   * @brief Validates churn configuration
+   * 
+   * @param config Churn config
+   * @param all_nodes All node configurations
+   * @param errors Vector to append errors to
+   */
+  void validateChurn(const ChurnConfig& config,
+                    const std::vector<NodeConfigExtended>& all_nodes,
+                    std::vector<ValidationError>& errors);
+  
+  /**
+   * @brief Validates the synthetic traffic streams
+   * 
+   * @param config Scenario config
+   * @param errors Vector to append errors to
+   */
+  void validateTraffic(const ScenarioConfig& config,
+                      std::vector<ValidationError>& errors);
+  
+  /**
+   * @brief Validates metrics configuration
+   * 
+   * @param config Metrics config
+   * @param errors Vector to append errors to
+   */
+  void validateMetrics(const MetricsConfig& config,
+                       std::vector<ValidationError>& errors);
+  
+  /**
+   * @brief Validates gateway configuration
+   * 
+   * @param config Complete scenario (the gateway needs its transport and nodes)
+   * @param errors Vector to append errors to
+   */
+  void validateGateway(const ScenarioConfig& config,
+                       std::vector<ValidationError>& errors);
+  
   /**
    * @brief Converts string to TopologyType
    * 
@@ -0,0 +1,181 @@
+/**
+ * @file connectivity_tracker.hpp
+ * @brief Incremental count of the connected components of the mesh
+ *
+ * This file contains the ConnectivityTracker class which follows link,
+ * connection, partition and node changes to keep the connected
+ * components of the mesh current without a graph search per query.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_CONNECTIVITY_TRACKER_HPP
+#define SIMULATOR_CONNECTIVITY_TRACKER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "simulator/topology_listener.hpp"
+
+namespace simulator {
+
+class MeshTransport;
+class NetworkSimulator;
+class NodeManager;
+
+/**
+ * @brief Tracks the connected components of running nodes
+ *
+ * Two running nodes are connected when the in-process transport links
+ * them and the network model carries traffic both ways (neither
+ * direction dropped, no partition between them). Components are kept in
+ * a union-find structure (union by size, path halving), fed as a
+ * TopologyListener:
+ * - changes that can only join components (a link added, a connection
+ *   restored, a node started) merge them in place, in near-constant time
+ *   per link;
+ * - changes that can split a component (a link removed or dropped, a
+ *   node stopped) only mark the structure stale when their nodes share a
+ *   component, and the next query rebuilds it in O(nodes + links);
+ * - a relabelled node marks it stale if it shares a component, and
+ *   otherwise joins the neighbours it can now reach. Clearing partitions
+ *   marks it stale. A partition event or heal relabelling many nodes thus
+ *   costs one rebuild, not one per node.
+ *
+ * Each component is named by its smallest node ID, so component IDs do
+ * not depend on the order of changes. Queries may rebuild and compress
+ * paths, so they are not const. Used from the simulation thread only.
+ *
+ * Example usage:
+ * @code
+ * ConnectivityTracker connectivity(network, transport);
+ * connectivity.reset(manager);
+ * transport.setTopologyListener(&connectivity);
+ * network.setTopologyListener(&connectivity);
+ * manager.setTopologyListener(&connectivity);
+ * ...
+ * size_t components = connectivity.getComponentCount();
+ * @endcode
+ */
+class ConnectivityTracker : public TopologyListener {
+public:
+  /**
+   * @brief Construct a tracker over a network and transport
+   *
+   * @param network Network model deciding which connections carry traffic
+   * @param transport In-process transport holding the links
+   *
+   * Both must outlive the tracker. Call reset() before the first query.
+   */
+  ConnectivityTracker(const NetworkSimulator& network, const MeshTransport& transport);
+
+  ConnectivityTracker(const ConnectivityTracker&) = delete;
+  ConnectivityTracker& operator=(const ConnectivityTracker&) = delete;
+
+  /**
+   * @brief Takes the running nodes from a manager and starts over
+   *
+   * Links, drops and partitions are read from the network and transport
+   * on the next query.
+   *
+   * @param manager Nodes and their running state
+   */
+  void reset(const NodeManager& manager);
+
+  /**
+   * @brief Passes every change on to another listener after tracking it
+   *
+   * @param next Listener (e.g. a TopologyRecorder), or nullptr
+   */
+  void setNext(TopologyListener* next) { next_ = next; }
+
+  /**
+   * @brief Gets the number of connected components of running nodes
+   */
+  size_t getComponentCount();
+
+  /**
+   * @brief Gets the component of a node
+   *
+   * @param node Node ID
+   * @return Smallest node ID in the node's component, or 0 if the node is
+   *         not running
+   */
+  uint32_t getComponent(uint32_t node);
+
+  /**
+   * @brief Gets the number of full rebuilds so far
+   */
+  uint64_t getRebuildCount() const { return rebuilds_; }
+
+  void linkChanged(uint32_t a, uint32_t b, bool up) override;
+  void connectionChanged(uint32_t from, uint32_t to, bool active) override;
+  void partitionChanged(uint32_t node, uint32_t label) override;
+  void partitionsCleared() override;
+  void nodeChanged(uint32_t node, NodeTransition transition) override;
+
+private:
+  /// Slot of a node not seen yet
+  static constexpr uint32_t NO_SLOT = UINT32_MAX;
+
+  /**
+   * @brief Gets the slot of a node, adding a stopped one if unknown
+   */
+  uint32_t slotOf(uint32_t node);
+
+  /**
+   * @brief Gets the slot of a node, or NO_SLOT if unknown
+   */
+  uint32_t findSlot(uint32_t node) const;
+
+  /**
+   * @brief Gets the root slot of a slot's component
+   */
+  uint32_t find(uint32_t slot);
+
+  /**
+   * @brief Merges the components of two slots
+   */
+  void unite(uint32_t a, uint32_t b);
+
+  /**
+   * @brief Checks if a link carries traffic both ways between running nodes
+   */
+  bool isUp(uint32_t a, uint32_t b) const;
+
+  /**
+   * @brief Merges a node's component with those of its up links
+   */
+  void joinNeighbours(uint32_t node);
+
+  /**
+   * @brief Marks the components stale if two running nodes share one
+   */
+  void splitIfJoined(uint32_t a, uint32_t b);
+
+  /**
+   * @brief Recomputes every component from the links
+   */
+  void rebuild();
+
+  const NetworkSimulator& network_;              ///< Connection drops and partitions
+  const MeshTransport& transport_;               ///< Links
+  TopologyListener* next_{nullptr};              ///< Also told about changes (optional)
+
+  std::unordered_map<uint32_t, uint32_t> slots_; ///< Node ID -> slot
+  std::vector<uint32_t> ids_;                    ///< Node ID of each slot
+  std::vector<uint32_t> parent_;                 ///< Union-find parent of each slot
+  std::vector<uint32_t> size_;                   ///< Component size (at roots)
+  std::vector<uint32_t> min_id_;                 ///< Smallest node ID (at roots)
+  std::vector<uint8_t> running_;                 ///< Node of each slot is running
+  size_t components_{0};                         ///< Components of running nodes
+  bool stale_{true};                             ///< A split may have happened
+  uint64_t rebuilds_{0};                         ///< Full rebuilds
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_CONNECTIVITY_TRACKER_HPP
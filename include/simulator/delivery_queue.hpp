@@ -0,0 +1,263 @@
+/**
+ * @file delivery_queue.hpp
+ * @brief Delivery queues for delayed messages in the network simulator
+ *
+ * This file contains the DelayedMessage type and the DeliveryQueue
+ * interface with two backends: a binary heap and a timing wheel.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_DELIVERY_QUEUE_HPP
+#define SIMULATOR_DELIVERY_QUEUE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "simulator/payload.hpp"
+
+namespace simulator {
+
+/**
+ * @brief A delayed message in the network simulator
+ */
+struct DelayedMessage {
+  uint32_t from;                        ///< Source node ID
+  uint32_t to;                          ///< Destination node ID
+  Payload message;                      ///< Message content (shared, never copied)
+  uint64_t deliveryTime;                ///< Delivery time in milliseconds
+  uint32_t batch = 0;                   ///< Coalesced batch slot + 1 (0 = a single message)
+
+  /**
+   * @brief Comparison operator for priority queue (earlier delivery first)
+   */
+  bool operator>(const DelayedMessage& other) const {
+    return deliveryTime > other.deliveryTime;
+  }
+};
+
+/**
+ * @brief Available delivery queue implementations
+ */
+enum class QueueBackend {
+  HEAP,          ///< Binary heap, O(log n) push and pop
+  TIMING_WHEEL   ///< Millisecond timing wheel, O(1) push and pop
+};
+
+/**
+ * @brief Queue of messages ordered by delivery time
+ *
+ * Implementations must hand out messages in non-decreasing delivery time
+ * order. Messages with equal delivery times may be returned in any order.
+ */
+class DeliveryQueue {
+public:
+  virtual ~DeliveryQueue() = default;
+
+  /**
+   * @brief Adds a message to the queue
+   *
+   * @param message Message to add (moved into the queue)
+   */
+  virtual void push(DelayedMessage message) = 0;
+
+  /**
+   * @brief Adds several messages to the queue
+   *
+   * @param messages Messages to add (moved from; the vector is left
+   *                 with moved-from elements)
+   */
+  virtual void pushBatch(std::vector<DelayedMessage>& messages);
+
+  /**
+   * @brief Moves all messages due at or before a time into a buffer
+   *
+   * Messages are appended to @p out in delivery order; existing contents
+   * of @p out are kept.
+   *
+   * @param currentTime Current simulation time in milliseconds
+   * @param out Buffer receiving the ready messages
+   * @return Number of messages appended
+   */
+  virtual size_t drainReady(uint64_t currentTime, std::vector<DelayedMessage>& out) = 0;
+
+  /**
+   * @brief Gets the number of queued messages
+   *
+   * @return Number of messages not yet drained
+   */
+  virtual size_t size() const = 0;
+
+  /**
+   * @brief Gets a lower bound on the earliest delivery time
+   *
+   * drainReady() with a time below this bound returns nothing, so callers
+   * can skip idle ticks with a single comparison.
+   *
+   * @return Earliest possible delivery time, or UINT64_MAX if empty
+   */
+  virtual uint64_t nextDeliveryBound() const = 0;
+
+  /**
+   * @brief Removes all queued messages
+   */
+  virtual void clear() = 0;
+
+  /**
+   * @brief Copies all queued messages without removing them
+   *
+   * Used to checkpoint the queue; payloads are shared, not copied. The
+   * messages come in internal order: pushed in that order into an empty
+   * queue of the same backend set to the same drain time, they rebuild
+   * this queue exactly, including the order of equal delivery times.
+   *
+   * @return Queued messages
+   */
+  virtual std::vector<DelayedMessage> snapshot() const = 0;
+
+  /**
+   * @brief Gets the time up to which the queue has been drained
+   *
+   * @return Drain position in milliseconds (0 for backends without one)
+   */
+  virtual uint64_t getDrainTime() const { return 0; }
+
+  /**
+   * @brief Moves the drain position of an empty queue
+   *
+   * Restores getDrainTime() before a snapshot() is pushed back.
+   *
+   * @param time Drain position in milliseconds
+   *
+   * @throws std::logic_error if the queue is not empty
+   */
+  virtual void setDrainTime(uint64_t time) { (void)time; }
+
+  /**
+   * @brief Gets the backend type
+   *
+   * @return Backend implemented by this queue
+   */
+  virtual QueueBackend backend() const = 0;
+};
+
+/**
+ * @brief Delivery queue backed by a binary heap
+ */
+class HeapDeliveryQueue : public DeliveryQueue {
+public:
+  void push(DelayedMessage message) override;
+  void pushBatch(std::vector<DelayedMessage>& messages) override;
+  size_t drainReady(uint64_t currentTime, std::vector<DelayedMessage>& out) override;
+  size_t size() const override { return heap_.size(); }
+  uint64_t nextDeliveryBound() const override;
+  void clear() override;
+  std::vector<DelayedMessage> snapshot() const override;
+  QueueBackend backend() const override { return QueueBackend::HEAP; }
+
+private:
+  std::priority_queue<DelayedMessage,
+                      std::vector<DelayedMessage>,
+                      std::greater<DelayedMessage>> heap_;  ///< Min-heap by delivery time
+};
+
+/**
+ * @brief Delivery queue backed by a single-level timing wheel
+ *
+ * The wheel has one slot per millisecond and covers a window of
+ * @c slot_count milliseconds starting at the drain cursor. Since the
+ * window is exactly as wide as the wheel, every slot holds messages of a
+ * single delivery time, so push and drain are O(1) per message and
+ * messages with equal delivery times keep their push order.
+ *
+ * Messages due beyond the window (latencies longer than the wheel) wait
+ * in an overflow heap and are moved into the wheel as the cursor
+ * advances. Messages pushed with a delivery time already behind the
+ * cursor are delivered on the next drain.
+ *
+ * Drained slots keep their capacity, so a steady-state simulation does
+ * not allocate in the queue. When the wheel is empty the cursor jumps
+ * straight to the drain time, so idle stretches cost nothing.
+ */
+class TimingWheelDeliveryQueue : public DeliveryQueue {
+public:
+  /// Default wheel size in milliseconds (covers LatencyConfig up to ~4s)
+  static constexpr size_t DEFAULT_SLOT_COUNT = 4096;
+
+  /**
+   * @brief Construct a timing wheel
+   *
+   * @param slot_count Number of 1ms slots (rounded up to a power of two)
+   *
+   * @throws std::invalid_argument if slot_count is 0
+   */
+  explicit TimingWheelDeliveryQueue(size_t slot_count = DEFAULT_SLOT_COUNT);
+
+  void push(DelayedMessage message) override;
+  void pushBatch(std::vector<DelayedMessage>& messages) override;
+  size_t drainReady(uint64_t currentTime, std::vector<DelayedMessage>& out) override;
+  size_t size() const override { return late_.size() + wheel_count_ + overflow_.size(); }
+  uint64_t nextDeliveryBound() const override;
+  void clear() override;
+  std::vector<DelayedMessage> snapshot() const override;
+  uint64_t getDrainTime() const override { return cursor_; }
+  void setDrainTime(uint64_t time) override;
+  QueueBackend backend() const override { return QueueBackend::TIMING_WHEEL; }
+
+  /**
+   * @brief Gets the number of slots in the wheel
+   *
+   * @return Wheel size in milliseconds
+   */
+  size_t getSlotCount() const { return slots_.size(); }
+
+private:
+  std::vector<std::vector<DelayedMessage>> slots_;  ///< Per-millisecond buckets
+  uint64_t mask_;                                   ///< slots_.size() - 1
+  uint64_t cursor_{0};                              ///< Earliest undrained time
+  size_t wheel_count_{0};                           ///< Messages in slots_
+  std::vector<DelayedMessage> late_;                ///< Pushed behind the cursor
+  std::priority_queue<DelayedMessage,
+                      std::vector<DelayedMessage>,
+                      std::greater<DelayedMessage>> overflow_;  ///< Beyond the window
+
+  /**
+   * @brief Moves overflow messages that now fall inside the window
+   */
+  void pullOverflow();
+};
+
+/**
+ * @brief Creates a delivery queue for a backend
+ *
+ * @param backend Backend type
+ * @return New, empty queue
+ */
+std::unique_ptr<DeliveryQueue> makeDeliveryQueue(QueueBackend backend);
+
+/**
+ * @brief Converts a queue backend to string
+ *
+ * @param backend Backend type
+ * @return "heap" or "timing_wheel"
+ */
+std::string queueBackendToString(QueueBackend backend);
+
+/**
+ * @brief Converts string to queue backend
+ *
+ * @param str String representation ("heap" or "timing_wheel")
+ * @return Backend type
+ * @throws std::invalid_argument if string is not recognized
+ */
+QueueBackend stringToQueueBackend(const std::string& str);
+
+} // namespace simulator
+
+#endif // SIMULATOR_DELIVERY_QUEUE_HPP
@@ -0,0 +1,206 @@
+/**
+ * @file distributed.hpp
+ * @brief Coordinator and worker sides of a distributed simulation
+ *
+ * This file contains the Coordinator and Worker classes which split one
+ * simulation across several processes, possibly on several hosts.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_DISTRIBUTED_HPP
+#define SIMULATOR_DISTRIBUTED_HPP
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <boost/asio.hpp>
+
+#include "simulator/delivery_queue.hpp"
+#include "simulator/frame_channel.hpp"
+
+namespace simulator {
+
+/**
+ * @brief Counters a worker reports at the end of a run
+ */
+struct WorkerReport {
+  uint32_t rank{0};                ///< Reporting worker
+  uint64_t frames_shipped{0};      ///< Frames sent to other ranks
+  uint64_t frames_injected{0};     ///< Frames received from other ranks
+  uint64_t frames_delivered{0};    ///< Frames delivered to local nodes
+};
+
+/**
+ * @brief Drives the virtual clock of a distributed simulation
+ *
+ * The coordinator owns no nodes. Workers connect and announce their rank
+ * and nodes; each runWindow() then lets every worker run the same window
+ * of ticks and routes the frames they sent to other ranks. A window must
+ * fit in the smallest lookahead of all workers, so every frame shipped at
+ * the end of a window is due in a later window and reaches its worker
+ * before that window starts. This is the same conservative barrier that
+ * keeps the shards of one process in step (see NodeManager::advanceWindow()),
+ * stretched across processes.
+ *
+ * Frames are routed in rank order and each worker queues them in that
+ * order, so a run is reproducible for a given scenario, seed and worker
+ * count.
+ *
+ * Example usage:
+ * @code
+ * boost::asio::io_context io;
+ * Coordinator coordinator(io, 7700, 4);
+ * coordinator.acceptWorkers();
+ * uint32_t window = std::min(coordinator.getLookaheadTicks(), max_ticks);
+ * for (uint64_t t = 0; t < end; t += window * tick_ms) {
+ *   coordinator.runWindow(t, tick_ms, window);
+ * }
+ * auto reports = coordinator.stop();
+ * @endcode
+ */
+class Coordinator {
+public:
+  /**
+   * @brief Construct a coordinator listening for workers
+   *
+   * @param io IO context for the listening socket
+   * @param port TCP port to listen on (0 picks a free port)
+   * @param workers Number of workers to expect
+   *
+   * @throws std::invalid_argument if workers is 0
+   * @throws boost::system::system_error if the port cannot be bound
+   */
+  Coordinator(boost::asio::io_context& io, uint16_t port, uint32_t workers);
+
+  /**
+   * @brief Gets the port the coordinator listens on
+   *
+   * @return Bound TCP port
+   */
+  uint16_t getPort() const;
+
+  /**
+   * @brief Blocks until every worker has connected and is ready
+   *
+   * @throws std::runtime_error if a worker sends an invalid or duplicate
+   *         rank, or claims a node another worker already hosts
+   */
+  void acceptWorkers();
+
+  /**
+   * @brief Gets the longest window every worker can run safely
+   *
+   * @return Smallest lookahead announced by the workers, in ticks
+   */
+  uint32_t getLookaheadTicks() const { return lookahead_ticks_; }
+
+  /**
+   * @brief Runs one window on every worker
+   *
+   * Hands each worker the frames routed to it after the previous window,
+   * waits until every worker has finished the window, then routes the
+   * frames they shipped to the ranks hosting their destinations.
+   *
+   * @param start_ms Simulated time of the first tick
+   * @param tick_ms Tick length in milliseconds
+   * @param ticks Number of ticks in the window
+   * @return Number of frames routed after the window
+   */
+  size_t runWindow(uint64_t start_ms, uint32_t tick_ms, uint32_t ticks);
+
+  /**
+   * @brief Gets the number of frames for nodes no worker hosts
+   *
+   * @return Dropped frame count
+   */
+  uint64_t getDroppedFrames() const { return dropped_; }
+
+  /**
+   * @brief Ends the run and collects the worker counters
+   *
+   * @return One report per worker, in rank order
+   */
+  std::vector<WorkerReport> stop();
+
+private:
+  boost::asio::ip::tcp::acceptor acceptor_;                ///< Listening socket
+  uint32_t worker_count_;                                   ///< Expected workers
+  std::vector<std::unique_ptr<FrameChannel>> channels_;    ///< Channel per rank
+  std::map<uint32_t, uint32_t> node_ranks_;                 ///< Node ID -> hosting rank
+  std::vector<std::vector<DelayedMessage>> pending_;        ///< Frames due to each rank
+  uint32_t lookahead_ticks_{0};                             ///< Smallest worker lookahead
+  uint64_t dropped_{0};                                     ///< Frames with unknown destination
+};
+
+/**
+ * @brief Runs one rank's share of a distributed simulation
+ *
+ * Example usage:
+ * @code
+ * Worker worker(io, "127.0.0.1", 7700, rank);
+ * worker.join();
+ * worker.ready(lookahead, local_nodes);
+ * worker.serve(runWindow, report);
+ * @endcode
+ */
+class Worker {
+public:
+  /// Runs a window: (start_ms, tick_ms, ticks, inbound, outbound)
+  using WindowHandler = std::function<void(uint64_t start_ms, uint32_t tick_ms, uint32_t ticks,
+                                           std::vector<DelayedMessage>& inbound,
+                                           std::vector<DelayedMessage>& outbound)>;
+
+  /// Produces the counters sent when the run ends
+  using Reporter = std::function<WorkerReport()>;
+
+  /// Connection attempts before giving up (the coordinator may start later)
+  static constexpr int CONNECT_ATTEMPTS = 50;
+
+  /**
+   * @brief Construct a worker and connect to the coordinator
+   *
+   * @param io IO context for the socket
+   * @param host Coordinator host name or address
+   * @param port Coordinator port
+   * @param rank This worker's rank
+   *
+   * @throws std::runtime_error if the coordinator cannot be reached
+   */
+  Worker(boost::asio::io_context& io, const std::string& host, uint16_t port, uint32_t rank);
+
+  /**
+   * @brief Announces the rank and waits for the coordinator's welcome
+   *
+   * @return Number of workers in the run
+   */
+  uint32_t join();
+
+  /**
+   * @brief Announces the hosted nodes
+   *
+   * @param lookahead_ticks Longest window this worker can run safely
+   * @param nodes IDs of the nodes this worker hosts
+   */
+  void ready(uint32_t lookahead_ticks, const std::vector<uint32_t>& nodes);
+
+  /**
+   * @brief Runs windows until the coordinator stops the run
+   *
+   * @param handler Runs each window
+   * @param reporter Produces the final counters
+   */
+  void serve(const WindowHandler& handler, const Reporter& reporter);
+
+private:
+  std::unique_ptr<FrameChannel> channel_;  ///< Channel to the coordinator
+  uint32_t rank_;                          ///< This worker's rank
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_DISTRIBUTED_HPP
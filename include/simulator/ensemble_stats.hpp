@@ -0,0 +1,175 @@
+/**
+ * @file ensemble_stats.hpp
+ * @brief Streaming statistics over a Monte Carlo ensemble of runs
+ *
+ * This file contains RunningStats, a mergeable mean and variance, and
+ * EnsembleStats, which folds the results of runs of one scenario with
+ * different seeds into aggregates as they finish.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_ENSEMBLE_STATS_HPP
+#define SIMULATOR_ENSEMBLE_STATS_HPP
+
+#include <cstdint>
+#include <iosfwd>
+#include "simulator/latency_histogram.hpp"
+#include "simulator/parameter_sweep.hpp"
+
+namespace simulator {
+
+/**
+ * @brief Mean and variance of a stream of values (Welford's method)
+ *
+ * Numerically stable in one pass and constant memory. Two instances
+ * merge exactly (Chan et al.), so partial results of several threads can
+ * be combined in any order.
+ */
+class RunningStats {
+public:
+  /**
+   * @brief Adds one value
+   */
+  void add(double value);
+
+  /**
+   * @brief Adds all values of another instance
+   */
+  void merge(const RunningStats& other);
+
+  /**
+   * @brief Gets the number of values
+   */
+  uint64_t getCount() const { return count_; }
+
+  /**
+   * @brief Gets the mean (0 without values)
+   */
+  double getMean() const { return mean_; }
+
+  /**
+   * @brief Gets the sample variance (0 with fewer than two values)
+   */
+  double getVariance() const;
+
+  /**
+   * @brief Gets the sample standard deviation
+   */
+  double getStdDev() const;
+
+  /**
+   * @brief Gets the half-width of the 95% confidence interval of the mean
+   *
+   * Uses Student's t distribution, so small ensembles get honest wide
+   * intervals.
+   *
+   * @return Half-width, or infinity with fewer than two values
+   */
+  double getConfidenceHalfWidth() const;
+
+private:
+  uint64_t count_{0};      ///< Values added
+  double mean_{0.0};       ///< Running mean
+  double m2_{0.0};         ///< Sum of squared deviations from the mean
+};
+
+/**
+ * @brief Aggregates of an ensemble of runs, merged as runs finish
+ *
+ * Holds summed counters, the merged link latency histogram of all runs,
+ * and the per-run mean and variance of the delivery ratio and latency
+ * percentiles. Nothing is kept per run, so memory does not grow with the
+ * ensemble.
+ *
+ * Example usage:
+ * @code
+ * EnsembleStats stats;
+ * for (each finished run) {
+ *   stats.addRun(result, latency);
+ *   if (stats.isConverged(0.01)) break;
+ * }
+ * stats.print(std::cout);
+ * @endcode
+ *
+ * @note Not thread-safe; callers merge finished runs under a lock.
+ */
+class EnsembleStats {
+public:
+  /// Runs before the confidence interval may end an ensemble
+  static constexpr uint64_t MIN_RUNS = 5;
+
+  /**
+   * @brief Folds in a completed run
+   *
+   * @param run Counters of the run
+   * @param latency Link latencies of the run
+   */
+  void addRun(const SweepResult& run, const LatencyHistogram& latency);
+
+  /**
+   * @brief Counts a run that failed
+   */
+  void addFailure() { failures_++; }
+
+  /**
+   * @brief Gets the number of completed runs
+   */
+  uint64_t getRuns() const { return runs_; }
+
+  /**
+   * @brief Gets the number of failed runs
+   */
+  uint64_t getFailures() const { return failures_; }
+
+  /**
+   * @brief Gets the per-run delivery ratio statistics
+   */
+  const RunningStats& getDeliveryRatio() const { return delivery_ratio_; }
+
+  /**
+   * @brief Gets the per-run 99th percentile link latency statistics
+   */
+  const RunningStats& getLatencyP99() const { return latency_p99_; }
+
+  /**
+   * @brief Gets the per-run received message statistics
+   */
+  const RunningStats& getMessagesReceived() const { return messages_received_; }
+
+  /**
+   * @brief Gets the link latencies of all runs
+   */
+  const LatencyHistogram& getLatency() const { return latency_; }
+
+  /**
+   * @brief Checks whether the delivery ratio is known precisely enough
+   *
+   * @param max_width Largest full width of its 95% confidence interval
+   * @return true once at least MIN_RUNS runs narrowed it below max_width
+   */
+  bool isConverged(double max_width) const;
+
+  /**
+   * @brief Prints the aggregates
+   *
+   * @param out Stream to write to
+   */
+  void print(std::ostream& out) const;
+
+private:
+  uint64_t runs_{0};                    ///< Completed runs
+  uint64_t failures_{0};                ///< Failed runs
+  uint64_t messages_sent_{0};           ///< Firmware messages sent, all runs
+  uint64_t link_delivered_{0};          ///< Link messages delivered, all runs
+  uint64_t link_lost_{0};               ///< Link messages lost, all runs
+  RunningStats delivery_ratio_;         ///< Per-run delivery ratio
+  RunningStats latency_p99_;            ///< Per-run p99 link latency
+  RunningStats messages_received_;      ///< Per-run firmware messages received
+  LatencyHistogram latency_;            ///< Link latencies of all runs
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_ENSEMBLE_STATS_HPP
@@ -88,19 +88,37 @@ public:
   /**
    * @brief Get the scheduled execution time
    * 
-   * @return Scheduled time in seconds since simulation start
+   * @return Scheduled time in whole seconds since simulation start
    */
-  uint32_t getScheduledTime() const { return scheduledTime_; }
+  uint32_t getScheduledTime() const {
+    return static_cast<uint32_t>(scheduledTimeUs_ / 1000000);
+  }
   
   /**
    * @brief Set the scheduled execution time
    * 
    * @param time Time in seconds since simulation start
    */
-  void setScheduledTime(uint32_t time) { scheduledTime_ = time; }
+  void setScheduledTime(uint32_t time) {
+    scheduledTimeUs_ = static_cast<uint64_t>(time) * 1000000;
+  }
+  
+  /**
+   * @brief Get the scheduled execution time at full resolution
+   * 
+   * @return Scheduled time in microseconds of virtual time
+   */
+  uint64_t getScheduledTimeUs() const { return scheduledTimeUs_; }
+  
+  /**
+   * @brief Set the scheduled execution time at full resolution
+   * 
+   * @param time_us Time in microseconds of virtual time
+   */
+  void setScheduledTimeUs(uint64_t time_us) { scheduledTimeUs_ = time_us; }
 
 protected:
-  uint32_t scheduledTime_ = 0;  ///< Scheduled execution time in seconds
+  uint64_t scheduledTimeUs_ = 0;  ///< Scheduled execution time in microseconds
 };
 
 } // namespace simulator
@@ -0,0 +1,147 @@
+/**
+ * @file event_factory.hpp
+ * @brief Factory for turning scenario event configuration into events
+ * 
+ * This file contains the EventFactory class which builds Event instances
+ * from the parsed ScenarioConfig::events list and schedules them, builds
+ * the lazy churn sources of ScenarioConfig::churn, and resolves the
+ * synthetic traffic streams of ScenarioConfig::traffic.
+ * 
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_EVENT_FACTORY_HPP
+#define SIMULATOR_EVENT_FACTORY_HPP
+
+#include "simulator/config_loader.hpp"
+#include "simulator/event.hpp"
+#include "simulator/event_source.hpp"
+#include "simulator/traffic_generator.hpp"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace simulator {
+
+class EventScheduler;
+
+/**
+ * @brief Builds simulation events from scenario configuration
+ * 
+ * Scenario files refer to nodes by their string ID; the factory resolves
+ * those to numeric node IDs using the scenario's node list. One config
+ * entry may yield several events (a node action with both `target` and
+ * `targets` produces one event per node).
+ * 
+ * Example usage:
+ * @code
+ * EventFactory factory(config.nodes);
+ * EventScheduler scheduler;
+ * factory.scheduleAll(config.events, scheduler);
+ * @endcode
+ * 
+ * @note Actions without an Event implementation (remove_node, add_nodes,
+ *       inject_message, set_network_quality) are skipped with a warning.
+ */
+class EventFactory {
+public:
+  /**
+   * @brief Construct a factory for a scenario's nodes
+   * 
+   * @param nodes Node configurations (templates already expanded)
+   */
+  explicit EventFactory(const std::vector<NodeConfigExtended>& nodes);
+  
+  /**
+   * @brief Create the events described by one config entry
+   * 
+   * Each returned event already carries its scheduled time.
+   * 
+   * @param config Event configuration
+   * @return Created events; empty if the action is unsupported or
+   *         references unknown nodes
+   */
+  std::vector<std::unique_ptr<Event>> create(const EventConfig& config) const;
+  
+  /**
+   * @brief Create and schedule every event in a scenario
+   * 
+   * @param events Event configurations
+   * @param scheduler Scheduler receiving the events
+   * @return Number of events scheduled
+   */
+  size_t scheduleAll(const std::vector<EventConfig>& events, EventScheduler& scheduler) const;
+  
+  /**
+   * @brief Create a lazy churn source
+   * 
+   * @param config Churn configuration
+   * @param seed Simulation seed
+   * @param salt Distinguishes several churn sources of one scenario
+   * @return Event source, or nullptr if no target resolves
+   * 
+   * @throws std::invalid_argument if a distribution name is unknown
+   */
+  std::unique_ptr<EventSource> createChurn(const ChurnConfig& config, uint32_t seed,
+                                           uint32_t salt) const;
+  
+  /**
+   * @brief Create every churn source of a scenario and add it to a scheduler
+   * 
+   * @param churn Churn configurations
+   * @param seed Simulation seed
+   * @param scheduler Scheduler receiving the sources
+   * @return Number of sources added
+   */
+  size_t addChurnSources(const std::vector<ChurnConfig>& churn, uint32_t seed,
+                         EventScheduler& scheduler) const;
+  
+  /**
+   * @brief Resolve a synthetic traffic stream
+   * 
+   * Without sources, every node but the sink sends.
+   * 
+   * @param config Traffic configuration
+   * @return Stream for TrafficGenerator::addStream(); its sources are
+   *         empty if none resolves, and its sink is 0 if the sink does not
+   * 
+   * @throws std::invalid_argument if the pattern or arrival name is unknown
+   */
+  TrafficSpec createTraffic(const TrafficConfig& config) const;
+  
+  /**
+   * @brief Resolve every traffic stream of a scenario and add it to a generator
+   * 
+   * @param traffic Traffic configurations
+   * @param generator Generator receiving the streams
+   * @return Number of streams added
+   */
+  size_t addTrafficStreams(const std::vector<TrafficConfig>& traffic,
+                           TrafficGenerator& generator) const;
+  
+  /**
+   * @brief Scheduled time of an event config in microseconds
+   * 
+   * Uses `time_ms` when set, otherwise `time` in seconds.
+   * 
+   * @param config Event configuration
+   * @return Virtual time in microseconds
+   */
+  static uint64_t getEventTimeUs(const EventConfig& config);
+
+private:
+  /**
+   * @brief Resolve a string node ID, warning if it is unknown
+   */
+  bool resolve(const std::string& id, uint32_t& nodeId) const;
+  
+  std::map<std::string, uint32_t> ids_;  ///< String ID -> numeric node ID
+  std::vector<uint32_t> node_ids_;       ///< Numeric node IDs in scenario order
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_EVENT_FACTORY_HPP
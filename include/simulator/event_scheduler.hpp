@@ -3,7 +3,8 @@
  * @brief Event scheduler for managing time-based simulation events
  * 
  * This file contains the EventScheduler class which manages scheduling
- * and execution of events during a simulation run using a priority queue.
+ * and execution of events during a simulation run using a compiled,
+ * time-sorted timeline.
  * 
  * @copyright Copyright (c) 2025 Alteriom
  * @license MIT License
@@ -13,19 +14,27 @@
 #define SIMULATOR_EVENT_SCHEDULER_HPP
 
 #include "simulator/event.hpp"
+#include "simulator/event_source.hpp"
+#include <cstddef>
 #include <memory>
-#include <queue>
+#include <ostream>
 #include <vector>
-#include <functional>
 
 namespace simulator {
 
 /**
  * @brief Manages scheduling and execution of simulation events
  * 
- * The EventScheduler class provides a priority queue-based event
- * scheduling system. Events are scheduled at specific simulation times
- * and executed in chronological order.
+ * Events are scheduled at specific simulation times and executed in
+ * chronological order. Newly scheduled events are appended to a staging
+ * list; compile() sorts them once into a contiguous timeline, which
+ * processEvents() then walks with a cursor. All events sharing a timestamp
+ * run as one batch and produce one log record. Scheduling after compile()
+ * is allowed and merges on the next call to processEvents().
+ * 
+ * Event sources (addSource()) generate events lazily: only an event that
+ * is already due is pulled from a source, so long stochastic scenarios
+ * never materialize their full timeline.
  * 
  * Example usage:
  * @code
@@ -37,11 +46,11 @@ namespace simulator {
  * 
  * auto event2 = std::make_unique<ConnectionDropEvent>(1001, 1002);
  * scheduler.scheduleEvent(std::move(event2), 45);
+ * scheduler.compile();
  * 
  * // In simulation loop
  * while (running) {
- *   uint32_t currentTime = getSimulationTime();
- *   scheduler.processEvents(currentTime, manager, network);
+ *   scheduler.processEventsUs(clock.nowUs(), manager, network);
  *   // ... rest of simulation update
  * }
  * @endcode
@@ -54,8 +63,11 @@ class EventScheduler {
 public:
   /**
    * @brief Default constructor
+   * 
+   * Batches are logged through the Logger at INFO level until
+   * setLogStream() says otherwise.
    */
-  EventScheduler() = default;
+  EventScheduler();
   
   /**
    * @brief Destructor
@@ -83,6 +95,19 @@ public:
    */
   void scheduleEvent(std::unique_ptr<Event> event, uint32_t time);
   
+  /**
+   * @brief Schedule an event at microsecond resolution
+   * 
+   * Same as scheduleEvent() but takes the time in microseconds of
+   * virtual time, matching VirtualClock::nowUs().
+   * 
+   * @param event Unique pointer to event (ownership transferred)
+   * @param time_us Scheduled time in microseconds since simulation start
+   * 
+   * @throws std::invalid_argument if event is nullptr
+   */
+  void scheduleEventUs(std::unique_ptr<Event> event, uint64_t time_us);
+  
   /**
    * @brief Process all events scheduled at or before current time
    * 
@@ -102,16 +127,79 @@ public:
    */
   uint32_t processEvents(uint32_t currentTime, NodeManager& manager, NetworkSimulator& network);
   
+  /**
+   * @brief Process all events scheduled at or before a microsecond time
+   * 
+   * This is the entry point used by the virtual-clock loop; processEvents()
+   * forwards here with the time converted from seconds.
+   * 
+   * @param now_us Current virtual time in microseconds
+   * @param manager Node manager for event execution
+   * @param network Network simulator for event execution
+   * 
+   * @return Number of events executed
+   */
+  uint32_t processEventsUs(uint64_t now_us, NodeManager& manager, NetworkSimulator& network);
+  
+  /**
+   * @brief Discard every event scheduled before a microsecond time
+   * 
+   * Used when resuming from a checkpoint taken at time_us: the effects of
+   * earlier events are part of the restored state, so they must not run
+   * again. Sources are advanced past their earlier events, leaving them
+   * where the checkpointed run had them. Events at time_us itself are
+   * kept.
+   * 
+   * @param time_us Virtual time in microseconds
+   * @return Number of events discarded
+   */
+  size_t skipUntilUs(uint64_t time_us);
+  
+  /**
+   * @brief Add a lazy event source
+   * 
+   * Events are pulled from the source once virtual time reaches them and
+   * then run like scheduled events. Ties with scheduled events at the same
+   * time run after them.
+   * 
+   * @param source Event source (ownership transferred)
+   * 
+   * @throws std::invalid_argument if source is nullptr
+   */
+  void addSource(std::unique_ptr<EventSource> source);
+  
+  /**
+   * @brief Sort staged events into the timeline
+   * 
+   * Called once after loading a scenario so dispatch never sorts. Calling
+   * it is optional: processEvents() compiles pending additions itself.
+   */
+  void compile();
+  
+  /**
+   * @brief Set the stream receiving one record per dispatched batch
+   * 
+   * @param out Log stream used instead of the Logger, or nullptr to
+   *            disable event logging
+   */
+  void setLogStream(std::ostream* out) {
+    log_ = out;
+    use_logger_ = false;
+  }
+  
   /**
    * @brief Check if there are pending events
    * 
-   * @return true if events are queued, false if queue is empty
+   * @return true if events are queued or a source has more to produce,
+   *         false otherwise
    */
   bool hasPendingEvents() const;
   
   /**
    * @brief Get the number of pending events
    * 
+   * Events a source has not produced yet are not counted.
+   * 
    * @return Count of events in the queue
    */
   size_t getPendingEventCount() const;
@@ -123,31 +211,48 @@ public:
    */
   uint32_t getNextEventTime() const;
   
+  /**
+   * @brief Get the time of the next scheduled event in microseconds
+   * 
+   * The simulation loop uses this as a wake source so idle stretches
+   * between events can be skipped in one step.
+   * 
+   * @return Time in microseconds of next event, or UINT64_MAX if no events
+   */
+  uint64_t getNextEventTimeUs() const;
+  
   /**
    * @brief Clear all pending events
    * 
-   * Removes all events from the queue without executing them.
+   * Removes all events from the queue without executing them, and drops
+   * all event sources.
    */
   void clear();
 
 private:
   /**
-   * @brief Comparator for event priority queue
+   * @brief Timeline entry pairing an event with its sort key
    * 
-   * Orders events by scheduled time (earliest first).
-   * For events with the same time, maintains insertion order (FIFO).
+   * The time is cached so sorting and dispatch never touch the event.
    */
-  struct EventComparator {
-    bool operator()(const std::unique_ptr<Event>& a, const std::unique_ptr<Event>& b) const {
-      // Return true if a should come after b (min-heap)
-      return a->getScheduledTime() > b->getScheduledTime();
-    }
+  struct TimelineEntry {
+    uint64_t time_us;               ///< Scheduled time in microseconds
+    uint64_t sequence;              ///< Insertion counter used to break time ties
+    std::unique_ptr<Event> event;
   };
   
-  // Priority queue of events (min-heap based on scheduled time)
-  std::priority_queue<std::unique_ptr<Event>, 
-                      std::vector<std::unique_ptr<Event>>, 
-                      EventComparator> eventQueue_;
+  /**
+   * @brief Log one dispatched batch
+   */
+  void logBatch(uint64_t time_us, size_t begin, size_t end) const;
+  
+  std::vector<TimelineEntry> timeline_;   ///< Compiled events sorted by (time, sequence)
+  size_t cursor_ = 0;                     ///< First timeline entry not yet run
+  std::vector<TimelineEntry> staged_;     ///< Scheduled since the last compile()
+  std::vector<std::unique_ptr<EventSource>> sources_;  ///< Lazy event generators
+  uint64_t nextSequence_ = 0;
+  std::ostream* log_ = nullptr;           ///< Batch log stream (nullptr = silent)
+  bool use_logger_ = true;                ///< Log batches through the Logger instead
 };
 
 } // namespace simulator
@@ -0,0 +1,63 @@
+/**
+ * @file event_source.hpp
+ * @brief Interface for lazily generated simulation events
+ * 
+ * This file contains the EventSource interface, which lets the
+ * EventScheduler pull events from a generator as virtual time advances
+ * instead of holding every event up front.
+ * 
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_EVENT_SOURCE_HPP
+#define SIMULATOR_EVENT_SOURCE_HPP
+
+#include "simulator/event.hpp"
+#include <cstdint>
+#include <memory>
+
+namespace simulator {
+
+/**
+ * @brief Produces events one at a time, in time order
+ * 
+ * The scheduler asks for the next event only once virtual time reaches
+ * it, so a source may describe an unbounded stream while holding only
+ * its own state.
+ * 
+ * Example usage:
+ * @code
+ * EventScheduler scheduler;
+ * scheduler.addSource(std::unique_ptr<EventSource>(new MySource()));
+ * @endcode
+ */
+class EventSource {
+public:
+  /**
+   * @brief Virtual destructor
+   */
+  virtual ~EventSource() = default;
+  
+  /**
+   * @brief Get the time of the next event
+   * 
+   * @return Time in microseconds of virtual time, or UINT64_MAX when the
+   *         source is exhausted
+   */
+  virtual uint64_t getNextTimeUs() const = 0;
+  
+  /**
+   * @brief Produce the next event and advance the source
+   * 
+   * Only called when getNextTimeUs() is not UINT64_MAX. The returned
+   * event is scheduled at the time getNextTimeUs() reported.
+   * 
+   * @return The event due at getNextTimeUs()
+   */
+  virtual std::unique_ptr<Event> next() = 0;
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_EVENT_SOURCE_HPP
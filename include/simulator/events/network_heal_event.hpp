@@ -20,9 +20,9 @@ namespace simulator {
 /**
  * @brief Event that heals network partitions
  * 
- * This event restores all connections that were dropped during network
- * partition events, effectively rejoining all isolated groups into a
- * single unified mesh network.
+ * This event clears the partition labels set by network partition events
+ * and restores explicitly dropped connections, effectively rejoining all
+ * isolated groups into a single unified mesh network.
  * 
  * This is used in conjunction with NetworkPartitionEvent to test:
  * - Network recovery scenarios
@@ -56,8 +56,8 @@ public:
   /**
    * @brief Execute the network heal
    * 
-   * Restores all previously dropped connections and resets partition
-   * IDs to 0 (single partition).
+   * Clears partition labels, restores all previously dropped connections
+   * and resets partition IDs to 0 (single partition).
    * 
    * @param manager Node manager for accessing nodes
    * @param network Network simulator for connection management
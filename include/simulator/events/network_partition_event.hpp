@@ -23,7 +23,7 @@ namespace simulator {
  * @brief Event that partitions the network into isolated groups
  * 
  * This event simulates a network partition (split-brain scenario) by
- * dropping connections between different groups of nodes. Each group
+ * labelling nodes so traffic between different groups is dropped. Each group
  * becomes an isolated partition that can operate independently.
  * 
  * This is critical for testing:
@@ -60,8 +60,9 @@ public:
   /**
    * @brief Execute the network partition
    * 
-   * Drops connections between different partition groups and assigns
-   * partition IDs to nodes for tracking.
+   * Labels each node with its partition in the network simulator, which
+   * then drops traffic between groups, and assigns partition IDs to nodes
+   * for tracking. Labels from an earlier partition are replaced.
    * 
    * @param manager Node manager for accessing nodes
    * @param network Network simulator for connection management
@@ -93,17 +94,6 @@ public:
 
 private:
   std::vector<std::vector<uint32_t>> partition_groups_;  ///< Node groups per partition
-  
-  /**
-   * @brief Drops connections between two groups
-   * 
-   * @param network Network simulator
-   * @param group1 First group of node IDs
-   * @param group2 Second group of node IDs
-   */
-  void dropConnectionsBetweenGroups(NetworkSimulator& network,
-                                     const std::vector<uint32_t>& group1,
-                                     const std::vector<uint32_t>& group2);
 };
 
 } // namespace simulator
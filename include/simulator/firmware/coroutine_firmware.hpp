@@ -0,0 +1,310 @@
+/**
+ * @file coroutine_firmware.hpp
+ * @brief Base class for firmware written as a C++20 coroutine
+ *
+ * This file contains the CoroutineFirmware class, which lets firmware wait
+ * for time and messages with co_await instead of polling from loop().
+ * It is only available in builds configured with ENABLE_COROUTINES
+ * (C++20); firmware deriving from FirmwareBase works in every build.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_COROUTINE_FIRMWARE_HPP
+#define SIMULATOR_COROUTINE_FIRMWARE_HPP
+
+#ifndef SIMULATOR_ENABLE_COROUTINES
+#define SIMULATOR_ENABLE_COROUTINES 0
+#endif
+
+#if SIMULATOR_ENABLE_COROUTINES
+
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <string>
+#include <utility>
+
+#include <boost/optional.hpp>
+
+#include "firmware_base.hpp"
+
+namespace simulator {
+namespace firmware {
+
+/**
+ * @brief Coroutine returned by CoroutineFirmware::run()
+ *
+ * Owns the coroutine frame. The coroutine starts suspended; its firmware
+ * resumes it. An exception escaping the coroutine is rethrown from the
+ * resume that raised it, as it would be from loop().
+ */
+class FirmwareRoutine {
+public:
+  struct promise_type {
+    std::exception_ptr error;  ///< Exception that ended the coroutine
+
+    FirmwareRoutine get_return_object() {
+      return FirmwareRoutine(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { error = std::current_exception(); }
+  };
+
+  FirmwareRoutine() = default;
+
+  FirmwareRoutine(FirmwareRoutine&& other) noexcept
+    : handle_(std::exchange(other.handle_, nullptr)) {}
+
+  FirmwareRoutine& operator=(FirmwareRoutine&& other) noexcept {
+    if (this != &other) {
+      reset();
+      handle_ = std::exchange(other.handle_, nullptr);
+    }
+    return *this;
+  }
+
+  FirmwareRoutine(const FirmwareRoutine&) = delete;
+  FirmwareRoutine& operator=(const FirmwareRoutine&) = delete;
+
+  /**
+   * @brief Destructor; destroys the coroutine frame wherever it is suspended
+   */
+  ~FirmwareRoutine() { reset(); }
+
+  /**
+   * @brief Gets the coroutine handle, or a null handle if there is none
+   */
+  std::coroutine_handle<> handle() const { return handle_; }
+
+  /**
+   * @brief Check if the coroutine has returned (or never existed)
+   */
+  bool done() const { return !handle_ || handle_.done(); }
+
+  /**
+   * @brief Rethrow the exception that ended the coroutine, if any
+   */
+  void rethrowError() {
+    if (handle_ && handle_.promise().error) {
+      std::rethrow_exception(std::exchange(handle_.promise().error, nullptr));
+    }
+  }
+
+private:
+  explicit FirmwareRoutine(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+  void reset() {
+    if (handle_) {
+      handle_.destroy();
+      handle_ = nullptr;
+    }
+  }
+
+  std::coroutine_handle<promise_type> handle_;
+};
+
+/**
+ * @brief Base class for firmware written as one coroutine
+ *
+ * A loop()-based firmware is called on every update it does not sleep
+ * through, and has to keep its own state machine to know what it was
+ * waiting for. A CoroutineFirmware implements run() instead, which
+ * awaits what it needs:
+ *
+ * - `co_await sleepFor(ms)` resumes after @p ms milliseconds of millis()
+ *   time (0 resumes on the next update)
+ * - `co_await receive()` resumes with the next message
+ * - `co_await receiveFor(ms)` resumes with the next message, or with none
+ *   after @p ms
+ *
+ * While the coroutine waits, its node sleeps (see
+ * FirmwareBase::sleepFor()): it is skipped until the deadline passes or
+ * a message arrives, so a waiting node costs nothing per update. The
+ * coroutine is resumed from loop(), on the node's own thread, only once
+ * what it awaits is ready. Messages arriving while it does something
+ * else are queued for the next receive().
+ *
+ * run() starts in setup() and runs to its first co_await there, so the
+ * code before it is the firmware's setup. Sends, runEvery() tasks and
+ * the other callbacks work as in any firmware. The coroutine's local
+ * variables are not checkpointed; keep what a restore needs in members
+ * written by saveState().
+ *
+ * Example implementation:
+ * @code
+ * class PingFirmware : public CoroutineFirmware {
+ * public:
+ *   PingFirmware() : CoroutineFirmware("Ping") {}
+ *
+ * protected:
+ *   FirmwareRoutine run() override {
+ *     for (;;) {
+ *       sendBroadcast("ping");
+ *       while (auto reply = co_await receiveFor(1000)) {
+ *         handleReply(reply->from, reply->msg);
+ *       }
+ *     }
+ *   }
+ * };
+ * @endcode
+ */
+class CoroutineFirmware : public FirmwareBase {
+public:
+  /**
+   * @brief A received message
+   */
+  struct Message {
+    uint32_t from;  ///< Source node ID
+    String msg;     ///< Message content
+  };
+
+  /**
+   * @brief Awaiter of sleepFor()
+   */
+  struct SleepAwaiter {
+    CoroutineFirmware* firmware;
+    uint32_t ms;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) { firmware->suspend(handle, ms, false); }
+    void await_resume() const noexcept {}
+  };
+
+  /**
+   * @brief Awaiter of receive()
+   */
+  struct ReceiveAwaiter {
+    CoroutineFirmware* firmware;
+
+    bool await_ready() const noexcept { return !firmware->inbox_.empty(); }
+    void await_suspend(std::coroutine_handle<> handle) {
+      firmware->suspend(handle, SLEEP_UNTIL_WOKEN, true);
+    }
+    Message await_resume() { return firmware->takeMessage(); }
+  };
+
+  /**
+   * @brief Awaiter of receiveFor()
+   */
+  struct TimedReceiveAwaiter {
+    CoroutineFirmware* firmware;
+    uint32_t ms;
+
+    bool await_ready() const noexcept { return !firmware->inbox_.empty(); }
+    void await_suspend(std::coroutine_handle<> handle) { firmware->suspend(handle, ms, true); }
+    boost::optional<Message> await_resume() {
+      if (firmware->inbox_.empty()) {
+        return boost::none;
+      }
+      return firmware->takeMessage();
+    }
+  };
+
+  /**
+   * @brief Constructor
+   *
+   * @param name Firmware name/identifier
+   */
+  explicit CoroutineFirmware(const std::string& name) : FirmwareBase(name) {
+    useReceiveView();
+  }
+
+  /**
+   * @brief Starts run() and runs it to its first co_await
+   */
+  void setup() final;
+
+  /**
+   * @brief Resumes run() if what it awaits is ready, then sleeps until it can be
+   */
+  void loop() final;
+
+  /**
+   * @brief Queues the message for receive()
+   */
+  void onReceiveView(uint32_t from, StringView msg) final;
+
+  /**
+   * @brief Check if run() has returned
+   */
+  bool isFinished() const { return routine_.done(); }
+
+  /**
+   * @brief Gets the number of times run() was resumed
+   *
+   * Compare with the node's update count to see how many calls the
+   * coroutine saved.
+   */
+  uint64_t getResumeCount() const { return resume_count_; }
+
+  /**
+   * @brief Gets the number of messages waiting for receive()
+   */
+  size_t getQueuedMessages() const { return inbox_.size(); }
+
+  size_t getMemoryUsage() const override;
+
+protected:
+  /**
+   * @brief The firmware's behaviour, as one coroutine
+   *
+   * @return The coroutine; returning from it ends the firmware's activity
+   *         (callbacks and tasks keep running)
+   */
+  virtual FirmwareRoutine run() = 0;
+
+  /**
+   * @brief Wait for some time
+   *
+   * Hides FirmwareBase::sleepFor(): here it suspends the coroutine rather
+   * than requesting the node's sleep, which loop() does on its behalf.
+   *
+   * @param ms Milliseconds of millis() time; 0 waits for the next update
+   * @return Awaiter to co_await
+   */
+  SleepAwaiter sleepFor(uint32_t ms) { return SleepAwaiter{this, ms}; }
+
+  /**
+   * @brief Wait for the next message
+   *
+   * @return Awaiter to co_await, which gives the Message
+   */
+  ReceiveAwaiter receive() { return ReceiveAwaiter{this}; }
+
+  /**
+   * @brief Wait for the next message, at most for some time
+   *
+   * @param ms Milliseconds of millis() time
+   * @return Awaiter to co_await, which gives the Message or boost::none
+   *         on timeout
+   */
+  TimedReceiveAwaiter receiveFor(uint32_t ms) { return TimedReceiveAwaiter{this, ms}; }
+
+private:
+  /// Deadline of a wait without one
+  static constexpr uint64_t NEVER = UINT64_MAX;
+
+  FirmwareRoutine routine_;                      ///< run()
+  std::coroutine_handle<> waiting_;              ///< Suspended coroutine, if waiting
+  uint64_t wake_at_ms_{NEVER};                   ///< Deadline of the wait (millis())
+  bool wants_message_{false};                    ///< A message also ends the wait
+  std::deque<Message> inbox_;                    ///< Messages not yet received
+  uint64_t resume_count_{0};                     ///< Resumes of run()
+
+  void suspend(std::coroutine_handle<> handle, uint32_t ms, bool wants_message);
+  bool isReady(uint64_t now_ms) const;
+  void resume();
+  Message takeMessage();
+};
+
+} // namespace firmware
+} // namespace simulator
+
+#endif // SIMULATOR_ENABLE_COROUTINES
+
+#endif // SIMULATOR_COROUTINE_FIRMWARE_HPP
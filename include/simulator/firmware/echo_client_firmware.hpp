@@ -75,7 +75,8 @@ public:
    * @brief Main loop
    */
   void loop() override {
-    // Loop processes responses - no additional work needed
+    // Responses are handled in onReceive(), requests by a task
+    sleepFor(SLEEP_UNTIL_WOKEN);
   }
   
   /**
@@ -101,6 +102,16 @@ public:
    * @brief Gets number of responses received
    */
   uint32_t getResponsesReceived() const { return responses_received_; }
+  
+  void saveState(CheckpointWriter& out) const override {
+    out.write<uint32_t>(requests_sent_);
+    out.write<uint32_t>(responses_received_);
+  }
+  
+  void loadState(CheckpointReader& in) override {
+    requests_sent_ = in.read<uint32_t>();
+    responses_received_ = in.read<uint32_t>();
+  }
 
 private:
   /**
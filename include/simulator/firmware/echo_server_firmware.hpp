@@ -35,7 +35,9 @@ public:
   /**
    * @brief Constructor
    */
-  EchoServerFirmware() : FirmwareBase("EchoServer") {}
+  EchoServerFirmware() : FirmwareBase("EchoServer") {
+    useReceiveView();
+  }
   
   /**
    * @brief Setup firmware
@@ -50,22 +52,25 @@ public:
    */
   void loop() override {
     // Server waits for requests - no periodic tasks needed
+    sleepFor(SLEEP_UNTIL_WOKEN);
   }
   
   /**
    * @brief Handle received messages - echo them back
    */
-  void onReceive(uint32_t from, String& msg) override {
+  void onReceiveView(uint32_t from, StringView msg) override {
     // Create echo response
-    String response = "ECHO: " + msg;
+    String response;
+    response.reserve(6 + msg.size());
+    response.append("ECHO: ").append(msg.data(), msg.size());
     
-    // Send response back to sender
+    // Send response back to sender; it is not needed afterwards
     if (mesh_) {
-      mesh_->sendSingle(from, response);
-      echo_count_++;
-      
       std::cout << "[INFO] Node " << node_id_ << " echoed to " << from 
                 << ": " << response << std::endl;
+      
+      sendSingle(from, std::move(response));
+      echo_count_++;
     }
   }
   
@@ -87,6 +92,16 @@ public:
    * @brief Gets number of connections
    */
   uint32_t getConnectionCount() const { return connection_count_; }
+  
+  void saveState(CheckpointWriter& out) const override {
+    out.write<uint32_t>(echo_count_);
+    out.write<uint32_t>(connection_count_);
+  }
+  
+  void loadState(CheckpointReader& in) override {
+    echo_count_ = in.read<uint32_t>();
+    connection_count_ = in.read<uint32_t>();
+  }
 
 private:
   uint32_t echo_count_{0};        ///< Number of messages echoed
@@ -12,11 +12,20 @@
 #ifndef SIMULATOR_FIRMWARE_BASE_HPP
 #define SIMULATOR_FIRMWARE_BASE_HPP
 
+#include <cstddef>
 #include <string>
 #include <map>
 #include <list>
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <utility>
+
+#include <boost/utility/string_view.hpp>
+
+#include "simulator/checkpoint.hpp"
+#include "simulator/payload.hpp"
+#include "simulator/task_queue.hpp"
 
 // Forward declarations
 class Scheduler;
@@ -30,9 +39,19 @@ class Connection;
 // Use std::string as String (compatible with PAINLESSMESH_ENABLE_STD_STRING)
 using String = std::string;
 
+// Read-only view of a received message, valid for the duration of the callback
+using StringView = boost::string_view;
+
 namespace simulator {
+
+class MeshTransport;
+class Outbox;
+
 namespace firmware {
 
+/// Firmware configuration: mesh credentials plus YAML firmware_config
+using FirmwareConfig = std::map<String, String>;
+
 /**
  * @brief Abstract base class for custom firmware implementations
  * 
@@ -58,7 +77,8 @@ namespace firmware {
  *   }
  *   
  *   void onReceive(uint32_t from, String& msg) override {
- *     // Handle received messages
+ *     // Handle received messages (or call useReceiveView() and
+ *     // override onReceiveView() to skip the String copy)
  *   }
  * };
  * @endcode
@@ -91,14 +111,95 @@ public:
   void initialize(painlessmesh::Mesh<painlessmesh::Connection>* mesh,
                   Scheduler* scheduler,
                   uint32_t nodeId,
-                  const std::map<String, String>& config) {
+                  const FirmwareConfig& config) {
+    initialize(mesh, scheduler, nodeId, std::make_shared<const FirmwareConfig>(config));
+  }
+  
+  /**
+   * @brief Initialize firmware with a shared configuration
+   * 
+   * Nodes with the same configuration share one immutable map instead of
+   * each holding a copy.
+   * 
+   * @param mesh Pointer to mesh instance
+   * @param scheduler Pointer to task scheduler
+   * @param nodeId Node ID assigned to this firmware
+   * @param config Configuration map, or nullptr for none
+   */
+  void initialize(painlessmesh::Mesh<painlessmesh::Connection>* mesh,
+                  Scheduler* scheduler,
+                  uint32_t nodeId,
+                  std::shared_ptr<const FirmwareConfig> config) {
     mesh_ = mesh;
     scheduler_ = scheduler;
     node_id_ = nodeId;
-    config_ = config;
+    config_ = std::move(config);
     initialized_ = true;
   }
   
+  /**
+   * @brief Route firmware traffic through an in-process transport
+   * 
+   * When set, sendBroadcast(), sendSingle() and getNodeList() use the
+   * transport instead of the painlessMesh instance.
+   * 
+   * @param transport Transport to use, or nullptr for the mesh
+   */
+  void setTransport(MeshTransport* transport) { transport_ = transport; }
+  
+  /**
+   * @brief Post firmware sends to a shard outbox
+   * 
+   * Used when the node runs on a NodeManager worker thread. Sends are
+   * queued and replayed into the transport by the coordinating thread,
+   * so they take effect after the current update.
+   * 
+   * @param outbox Outbox to post to, or nullptr to send directly
+   */
+  void setOutbox(Outbox* outbox) { outbox_ = outbox; }
+  
+  /**
+   * @brief Run runEvery() / runAfter() tasks from a node's task queue
+   * 
+   * @param tasks Queue the node runs, or nullptr (tasks are then refused)
+   */
+  void setTaskQueue(TaskQueue* tasks) { tasks_ = tasks; }
+  
+  /**
+   * @brief Set the hook wake() calls to wake the node
+   * 
+   * @param handler Hook to call, or an empty function
+   */
+  void setWakeHandler(std::function<void()> handler) { wake_handler_ = std::move(handler); }
+  
+  /**
+   * @brief Set the seed of randomBetween()
+   * 
+   * Restarts the stream, so firmware given the same seed and node ID
+   * draws the same numbers.
+   * 
+   * @param seed Simulation seed
+   */
+  void setRandomSeed(uint32_t seed) {
+    random_seed_ = seed;
+    random_sequence_ = 0;
+  }
+  
+  /**
+   * @brief Take the sleep requested by the last loop(), if any
+   * 
+   * @param ms Receives the requested sleep in milliseconds
+   * @return true if sleepFor() was called since the last call
+   */
+  bool takeSleepRequest(uint32_t& ms) {
+    if (!sleep_requested_) {
+      return false;
+    }
+    sleep_requested_ = false;
+    ms = sleep_ms_;
+    return true;
+  }
+  
   /**
    * @brief Check if firmware has been initialized
    * 
@@ -128,7 +229,7 @@ public:
    * - Update state
    * 
    * Keep this method fast as it's called frequently.
-   * Use scheduler for time-based tasks instead of delays.
+   * Use runEvery() / runAfter() for time-based tasks instead of delays.
    */
   virtual void loop() = 0;
   
@@ -142,8 +243,29 @@ public:
    * Default implementation does nothing.
    */
   virtual void onReceive(uint32_t from, String& msg) {
-    (void)from;
-    (void)msg;
+    if (receive_view_) {
+      onReceiveView(from, StringView(msg.data(), msg.size()));
+    }
+  }
+  
+  /**
+   * @brief Callback for received messages, without a String copy
+   * 
+   * @param from Source node ID
+   * @param msg Message content, valid until the callback returns
+   * 
+   * Firmware that calls useReceiveView() from its constructor overrides
+   * this instead of onReceive(), so messages from the in-process
+   * transport reach it straight from the shared payload. onReceive() then
+   * forwards here, so direct callers keep working. Without
+   * useReceiveView(), the default copies the message into a String and
+   * calls onReceive().
+   */
+  virtual void onReceiveView(uint32_t from, StringView msg) {
+    if (!receive_view_) {
+      String copy(msg.data(), msg.size());
+      onReceive(from, copy);
+    }
   }
   
   /**
@@ -194,6 +316,56 @@ public:
    */
   virtual String getVersion() const { return "1.0.0"; }
   
+  /**
+   * @brief Estimates the memory held by this firmware
+   * 
+   * The default counts the base class; the configuration is shared
+   * between nodes and not included. Override this method in firmware
+   * that keeps sizable state of its own.
+   * 
+   * @return Estimated bytes
+   */
+  virtual size_t getMemoryUsage() const;
+  
+  /**
+   * @brief Writes firmware state to a checkpoint
+   * 
+   * Override to save counters and other state the firmware needs after a
+   * restore. Scheduler tasks are not saved; setup() re-creates them.
+   * Default implementation saves nothing.
+   * 
+   * @param out Checkpoint writer
+   */
+  virtual void saveState(CheckpointWriter& out) const {
+    (void)out;
+  }
+  
+  /**
+   * @brief Reads firmware state written by saveState()
+   * 
+   * @param in Checkpoint reader
+   */
+  virtual void loadState(CheckpointReader& in) {
+    (void)in;
+  }
+  
+  /**
+   * @brief Writes the base class and firmware state to a checkpoint
+   * 
+   * Saves the position of the randomBetween() stream, then calls
+   * saveState().
+   * 
+   * @param out Checkpoint writer
+   */
+  void saveCheckpoint(CheckpointWriter& out) const;
+  
+  /**
+   * @brief Reads state written by saveCheckpoint()
+   * 
+   * @param in Checkpoint reader
+   */
+  void loadCheckpoint(CheckpointReader& in);
+  
   /**
    * @brief Gets the node ID
    * 
@@ -209,9 +381,11 @@ public:
    * @return Configuration value or default
    */
   String getConfig(const String& key, const String& defaultValue) const {
-    auto it = config_.find(key);
-    if (it != config_.end()) {
-      return it->second;
+    if (config_) {
+      auto it = config_->find(key);
+      if (it != config_->end()) {
+        return it->second;
+      }
     }
     return defaultValue;
   }
@@ -223,7 +397,7 @@ public:
    * @return true if key exists, false otherwise
    */
   bool hasConfig(const String& key) const {
-    return config_.find(key) != config_.end();
+    return config_ && config_->find(key) != config_->end();
   }
 
 protected:
@@ -231,27 +405,113 @@ protected:
    * @brief Send a broadcast message to all nodes in the mesh
    * 
    * Helper method that wraps mesh_->sendBroadcast() with null check.
+   * Uses the in-process transport instead if one is set, via the
+   * shard outbox if one is set.
    * 
    * @param msg Message to broadcast
    */
   void sendBroadcast(const String& msg);
   
+  /**
+   * @brief Send a temporary message to all nodes in the mesh
+   * 
+   * Like sendBroadcast(const String&), but hands the message on instead
+   * of copying it.
+   * 
+   * @param msg Message to broadcast (moved from)
+   */
+  void sendBroadcast(String&& msg);
+  
+  /**
+   * @brief Encode a broadcast once for repeated sendPreparedBroadcast() calls
+   * 
+   * Firmware that broadcasts the same message periodically prepares it
+   * once (from setup() on, when the node ID is known) and keeps the
+   * result. Each send then shares the encoded buffer instead of copying
+   * the message and building a new frame.
+   * 
+   * @param msg Message to broadcast
+   * @return Encoded broadcast of this node
+   */
+  Payload prepareBroadcast(const String& msg) const;
+  
+  /**
+   * @brief Send a broadcast encoded by prepareBroadcast()
+   * 
+   * Only the painlessMesh path, which modifies the message, still copies.
+   * 
+   * @param prepared Result of prepareBroadcast() on this firmware
+   */
+  void sendPreparedBroadcast(const Payload& prepared);
+  
   /**
    * @brief Send a message to a specific node
    * 
    * Helper method that wraps mesh_->sendSingle() with null check.
+   * Uses the in-process transport instead if one is set, via the
+   * shard outbox if one is set.
    * 
    * @param dest Destination node ID
    * @param msg Message to send
    */
   void sendSingle(uint32_t dest, const String& msg);
   
+  /**
+   * @brief Send a temporary message to a specific node
+   * 
+   * Like sendSingle(uint32_t, const String&), but hands the message on
+   * instead of copying it.
+   * 
+   * @param dest Destination node ID
+   * @param msg Message to send (moved from)
+   */
+  void sendSingle(uint32_t dest, String&& msg);
+  
+  /**
+   * @brief Run a callback periodically
+   * 
+   * The task goes into the node's own queue, ordered by run time, so the
+   * node pays only for tasks that are due and may sleep (see sleepFor())
+   * until the next one. Prefer it to a TaskScheduler Task, which every
+   * execute() of the scheduler visits whether due or not.
+   * 
+   * @param interval_ms Time between runs (millis()); the first run is one
+   *                    interval from now
+   * @param callback Code to run
+   * @param iterations Number of runs (TaskQueue::FOREVER for no limit)
+   * @return Handle for cancelTask(), or an invalid handle if the firmware
+   *         is not running on a node
+   */
+  TaskId runEvery(uint32_t interval_ms, std::function<void()> callback,
+                  int32_t iterations = TaskQueue::FOREVER);
+  
+  /**
+   * @brief Run a callback once after a delay
+   * 
+   * @param delay_ms Delay in milliseconds (millis())
+   * @param callback Code to run
+   * @return Handle for cancelTask(), or an invalid handle if the firmware
+   *         is not running on a node
+   */
+  TaskId runAfter(uint32_t delay_ms, std::function<void()> callback);
+  
+  /**
+   * @brief Cancel a task of runEvery() or runAfter()
+   * 
+   * @param id Task handle
+   * @return true if the task was still scheduled
+   */
+  bool cancelTask(TaskId id);
+  
   /**
    * @brief Get the current mesh time
    * 
    * Helper method that wraps mesh_->getNodeTime() with null check.
+   * Without a mesh on the in-process transport (fluid nodes) it is the
+   * simulation time, as every node of a fully synchronised mesh reports.
    * 
-   * @return Current mesh time in microseconds, or 0 if mesh not initialized
+   * @return Current mesh time in microseconds, or 0 if there is neither
+   *         a mesh nor a transport
    */
   uint32_t getNodeTime() const;
   
@@ -263,13 +523,73 @@ protected:
    * @return List of node IDs currently connected in the mesh, or empty list if mesh not initialized
    */
   std::list<uint32_t> getNodeList() const;
+  
+  /**
+   * @brief Draw a reproducible random number, like Arduino random(min, max)
+   * 
+   * Use this instead of rand() or random(): the numbers come from the
+   * node's own stream of the simulation seed (RNG_STREAM_FIRMWARE), so a
+   * run replays exactly and nodes do not disturb each other's draws.
+   * 
+   * @param min Smallest value
+   * @param max One past the largest value
+   * @return Value in [min, max), or min if max <= min
+   */
+  uint32_t randomBetween(uint32_t min, uint32_t max);
+  
+  /**
+   * @brief Opt in to receiving messages through onReceiveView()
+   * 
+   * Call from the constructor of firmware that overrides onReceiveView().
+   */
+  void useReceiveView() { receive_view_ = true; }
+  
+  /// Sleep length meaning "until a callback or wake()"
+  static constexpr uint32_t SLEEP_UNTIL_WOKEN = UINT32_MAX;
+  
+  /**
+   * @brief Let the simulator skip this node while loop() is idle
+   * 
+   * Called from loop(). The node's loop() and mesh update are skipped
+   * until @p ms have passed, a message or connection callback arrives, a
+   * runEvery() / runAfter() task is due, or wake() is called. Scheduler
+   * tasks keep running while the node sleeps.
+   * Firmware that never calls this is updated every cycle.
+   * 
+   * @param ms Milliseconds of wall-clock (millis()) time to sleep
+   */
+  void sleepFor(uint32_t ms) {
+    sleep_ms_ = ms;
+    sleep_requested_ = true;
+  }
+  
+  /**
+   * @brief Cancel a sleep, e.g. from a task callback that left work for loop()
+   */
+  void wake() {
+    sleep_requested_ = false;
+    if (wake_handler_) {
+      wake_handler_();
+    }
+  }
 
   std::string name_;                                      ///< Firmware name
   painlessmesh::Mesh<painlessmesh::Connection>* mesh_{nullptr};  ///< Mesh instance
+  MeshTransport* transport_{nullptr};                     ///< In-process transport (optional)
+  Outbox* outbox_{nullptr};                               ///< Shard outbox (optional)
+  TaskQueue* tasks_{nullptr};                             ///< Node task queue (optional)
   Scheduler* scheduler_{nullptr};                         ///< Task scheduler
   uint32_t node_id_{0};                                   ///< Node ID
-  std::map<String, String> config_;                       ///< Configuration map
+  std::shared_ptr<const FirmwareConfig> config_;          ///< Configuration map (shared, may be null)
   bool initialized_{false};                               ///< Initialization flag
+  bool receive_view_{false};                              ///< Overrides onReceiveView()
+  
+private:
+  std::function<void()> wake_handler_;                    ///< Hook behind wake()
+  uint32_t sleep_ms_{0};                                  ///< Requested sleep
+  bool sleep_requested_{false};                           ///< sleepFor() called since last take
+  uint32_t random_seed_{0};                               ///< Seed of randomBetween()
+  uint64_t random_sequence_{0};                           ///< Next sample of randomBetween()
 };
 
 } // namespace firmware
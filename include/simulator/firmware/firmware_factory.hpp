@@ -13,33 +13,50 @@
 #define SIMULATOR_FIRMWARE_FACTORY_HPP
 
 #include "firmware_base.hpp"
+#include <cstdint>
+#include <deque>
 #include <string>
 #include <map>
 #include <memory>
 #include <functional>
 #include <iostream>
+#include <vector>
 
 namespace simulator {
 namespace firmware {
 
+/// Index of a registered firmware type (see FirmwareFactory::findId())
+using FirmwareId = uint32_t;
+
 /**
  * @brief Factory class for creating firmware instances
  * 
  * FirmwareFactory uses the singleton pattern to provide a centralized
- * registry for firmware types. Firmware implementations can register
- * themselves with the factory, and nodes can create instances by name.
+ * registry for firmware types. Firmware implementations register
+ * themselves with REGISTER_FIRMWARE during static initialization, and
+ * nodes can create instances by name.
+ * 
+ * Each registered type also gets a FirmwareId, its index in the
+ * registry. Callers creating many nodes resolve names once with findId()
+ * and then create instances with create(FirmwareId), an array access
+ * and a plain function call.
  * 
  * Example usage:
  * @code
- * // Register firmware (typically in firmware implementation file)
- * FirmwareFactory::instance().registerFirmware("SensorNode", 
- *   []() { return std::make_unique<SensorFirmware>(); });
+ * // Register firmware (in the firmware implementation file)
+ * REGISTER_FIRMWARE(SensorNode, SensorFirmware)
  * 
  * // Create firmware instance by name
  * auto firmware = FirmwareFactory::instance().create("SensorNode");
  * if (firmware) {
  *   // Use firmware
  * }
+ * 
+ * // Or resolve the name once for many nodes
+ * FirmwareId id = FirmwareFactory::instance().findId("SensorNode");
+ * for (auto& node : nodes) {
+ *   node->loadFirmware(FirmwareFactory::instance().create(id));
+ * }
  * @endcode
  */
 class FirmwareFactory {
@@ -47,6 +64,9 @@ public:
   /// Firmware creator function type
   using Creator = std::function<std::unique_ptr<FirmwareBase>()>;
   
+  /// ID returned by findId() for unknown names
+  static constexpr FirmwareId INVALID_ID = UINT32_MAX;
+  
   /**
    * @brief Gets the singleton instance
    * 
@@ -71,16 +91,32 @@ public:
    * @endcode
    */
   bool registerFirmware(const std::string& name, Creator creator) {
-    if (creators_.find(name) != creators_.end()) {
+    if (ids_.find(name) != ids_.end()) {
       std::cerr << "[WARNING] Firmware '" << name 
                 << "' is already registered" << std::endl;
       return false;
     }
-    creators_[name] = creator;
+    ids_[name] = static_cast<FirmwareId>(entries_.size());
+    entries_.push_back(Entry{name, std::move(creator)});
     std::cout << "[INFO] Registered firmware: " << name << std::endl;
     return true;
   }
   
+  /**
+   * @brief Registers a default-constructible firmware type
+   * 
+   * The creator is a plain function instantiated for T, so creating an
+   * instance costs one allocation of T and nothing else.
+   * 
+   * @tparam T FirmwareBase subclass
+   * @param name Firmware name/identifier
+   * @return true if registered successfully, false if name already exists
+   */
+  template <typename T>
+  bool registerFirmware(const std::string& name) {
+    return registerFirmware(name, Creator(&createInstance<T>));
+  }
+  
   /**
    * @brief Creates a firmware instance by name
    * 
@@ -96,12 +132,12 @@ public:
    * @endcode
    */
   std::unique_ptr<FirmwareBase> create(const std::string& name) {
-    auto it = creators_.find(name);
-    if (it == creators_.end()) {
+    auto it = ids_.find(name);
+    if (it == ids_.end()) {
       std::cerr << "[ERROR] Unknown firmware: " << name << std::endl;
       std::cerr << "[INFO] Available firmware: ";
       bool first = true;
-      for (const auto& pair : creators_) {
+      for (const auto& pair : ids_) {
         if (!first) std::cerr << ", ";
         std::cerr << pair.first;
         first = false;
@@ -109,7 +145,52 @@ public:
       std::cerr << std::endl;
       return nullptr;
     }
-    return it->second();
+    return entries_[it->second].creator();
+  }
+  
+  /**
+   * @brief Creates a firmware instance by ID
+   * 
+   * Safe to call from several threads as long as no type is registered
+   * or unregistered at the same time.
+   * 
+   * @param id ID from findId()
+   * @return Unique pointer to firmware instance, or nullptr if the ID is
+   *         invalid or its type was unregistered
+   */
+  std::unique_ptr<FirmwareBase> create(FirmwareId id) const {
+    if (id >= entries_.size() || !entries_[id].creator) {
+      return nullptr;
+    }
+    return entries_[id].creator();
+  }
+  
+  /**
+   * @brief Resolves a firmware name to its ID
+   * 
+   * An ID stays valid until its type is unregistered or the factory is
+   * cleared, and is not handed to another type before clear().
+   * 
+   * @param name Firmware name/identifier
+   * @return ID, or INVALID_ID if the name is not registered
+   */
+  FirmwareId findId(const std::string& name) const {
+    auto it = ids_.find(name);
+    return it == ids_.end() ? INVALID_ID : it->second;
+  }
+  
+  /**
+   * @brief Looks up the creator of a firmware type
+   * 
+   * Lets callers creating many instances skip the name lookup for each.
+   * The creator stays valid until the type is unregistered.
+   * 
+   * @param name Firmware name/identifier
+   * @return Creator, or nullptr if the name is not registered
+   */
+  const Creator* findCreator(const std::string& name) const {
+    auto it = ids_.find(name);
+    return it == ids_.end() ? nullptr : &entries_[it->second].creator;
   }
   
   /**
@@ -119,7 +200,7 @@ public:
    * @return true if registered, false otherwise
    */
   bool isRegistered(const std::string& name) const {
-    return creators_.find(name) != creators_.end();
+    return ids_.find(name) != ids_.end();
   }
   
   /**
@@ -129,8 +210,8 @@ public:
    */
   std::vector<std::string> getRegisteredNames() const {
     std::vector<std::string> names;
-    names.reserve(creators_.size());
-    for (const auto& pair : creators_) {
+    names.reserve(ids_.size());
+    for (const auto& pair : ids_) {
       names.push_back(pair.first);
     }
     return names;
@@ -145,7 +226,13 @@ public:
    * This is mainly useful for testing.
    */
   bool unregisterFirmware(const std::string& name) {
-    return creators_.erase(name) > 0;
+    auto it = ids_.find(name);
+    if (it == ids_.end()) {
+      return false;
+    }
+    entries_[it->second].creator = nullptr;
+    ids_.erase(it);
+    return true;
   }
   
   /**
@@ -154,7 +241,8 @@ public:
    * This is mainly useful for testing.
    */
   void clear() {
-    creators_.clear();
+    ids_.clear();
+    entries_.clear();
   }
   
   /**
@@ -177,22 +265,62 @@ public:
   }
 
 private:
+  /// Registered type
+  struct Entry {
+    std::string name;   ///< Firmware name
+    Creator creator;    ///< Creator, empty once unregistered
+  };
+  
   /// Private constructor (singleton pattern)
-  FirmwareFactory() = default;
+  FirmwareFactory() { linkBuiltinFirmware(); }
   
   /// Prevent copying
   FirmwareFactory(const FirmwareFactory&) = delete;
   FirmwareFactory& operator=(const FirmwareFactory&) = delete;
   
-  /// Registry of firmware creators
-  std::map<std::string, Creator> creators_;
+  template <typename T>
+  static std::unique_ptr<FirmwareBase> createInstance() {
+    return std::make_unique<T>();
+  }
+  
+  /**
+   * @brief References every built-in firmware
+   * 
+   * Does nothing at run time; the references make the linker keep the
+   * built-in firmware object files of the simulator library, and with
+   * them their REGISTER_FIRMWARE registrations.
+   */
+  static void linkBuiltinFirmware();
+  
+  std::deque<Entry> entries_;                ///< Registered types by ID (stable addresses)
+  std::map<std::string, FirmwareId> ids_;    ///< IDs by name
+};
+
+/**
+ * @brief Registers a firmware type with the factory when constructed
+ * 
+ * Used by REGISTER_FIRMWARE for static registration.
+ * 
+ * @tparam T FirmwareBase subclass
+ */
+template <typename T>
+struct FirmwareRegistrar {
+  explicit FirmwareRegistrar(const char* name) {
+    FirmwareFactory::instance().registerFirmware<T>(name);
+  }
 };
 
 /**
  * @brief Helper macro for registering firmware
  * 
  * Use this macro in your firmware implementation file to automatically
- * register the firmware with the factory.
+ * register the firmware with the factory during static initialization.
+ * The name must be a valid identifier.
+ * 
+ * The macro also defines the function simulator_link_firmware_<name>().
+ * A firmware linked from a static library is only registered if its
+ * object file is linked in; calling that function from code the program
+ * uses guarantees it (see FirmwareFactory::linkBuiltinFirmware()).
  * 
  * Example:
  * @code
@@ -201,14 +329,9 @@ private:
  * @endcode
  */
 #define REGISTER_FIRMWARE(name, type) \
+  extern "C" void simulator_link_firmware_##name() {} \
   namespace { \
-    struct type##Registrar { \
-      type##Registrar() { \
-        simulator::firmware::FirmwareFactory::instance().registerFirmware( \
-          #name, []() { return std::make_unique<type>(); }); \
-      } \
-    }; \
-    static type##Registrar type##_registrar_instance; \
+    const ::simulator::firmware::FirmwareRegistrar<type> name##_firmware_registrar(#name); \
   }
 
 } // namespace firmware
@@ -0,0 +1,121 @@
+/**
+ * @file routing_bench_firmware.hpp
+ * @brief Firmware timing painlessMesh routing and layout calls
+ *
+ * This firmware measures what the painlessMesh routing-tree code costs on
+ * one node as the mesh around it grows: listing the nodes, building the
+ * sub-connection JSON, finding a route and sending to a single node.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_ROUTING_BENCH_FIRMWARE_HPP
+#define SIMULATOR_ROUTING_BENCH_FIRMWARE_HPP
+
+#include "firmware_base.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace simulator {
+namespace firmware {
+
+/**
+ * @brief Routing and layout operations timed by RoutingBenchFirmware
+ */
+enum class RoutingOp {
+  NODE_LIST,            ///< getNodeList(): walks the layout tree
+  SUB_CONNECTION_JSON,  ///< Mesh::subConnectionJson(): serializes the tree (mesh only)
+  FIND_ROUTE,           ///< Mesh::isConnected(): router::findRoute() (mesh only)
+  SEND_SINGLE           ///< sendSingle() to a known node, routing included
+};
+
+/**
+ * @brief Gets the report name of an operation, e.g. "node_list"
+ */
+const char* routingOpName(RoutingOp op);
+
+/**
+ * @brief Cost of one operation in one measurement round
+ */
+struct RoutingSample {
+  uint32_t round = 0;        ///< Measurement round, from 1
+  uint32_t time_ms = 0;      ///< millis() at the round
+  size_t known_nodes = 0;    ///< Nodes in getNodeList(), this node included
+  RoutingOp op = RoutingOp::NODE_LIST;
+  uint32_t calls = 0;        ///< Calls timed
+  double ns_per_call = 0.0;  ///< Mean wall time per call
+};
+
+/**
+ * @brief Firmware that times painlessMesh routing-tree calls
+ *
+ * Nodes with role "probe" wait for the mesh to form, then time each
+ * RoutingOp every interval: the same call repeated `calls` times, with
+ * route and send targets drawn from the current node list. Each round is
+ * printed and, with `output`, appended to a CSV file. Nodes with role
+ * "member" (the default) only make up the mesh and sleep.
+ *
+ * On the painlessMesh engine all four operations run the library's own
+ * code. On the in-process transport getNodeList() and sendSingle() use
+ * the transport's shortest-path trees instead, and the two mesh-only
+ * operations are skipped.
+ *
+ * scripts/routing_bench.py runs a probe in meshes of growing size and
+ * reports the cost per call against the node count.
+ *
+ * Configuration options:
+ * - role: "probe" | "member" (default: "member")
+ * - warmup: Seconds before the first round (default: 20)
+ * - interval: Seconds between rounds (default: 10)
+ * - calls: Calls timed per operation and round (default: 20)
+ * - output: CSV file the probe appends its rounds to (default: none)
+ */
+class RoutingBenchFirmware : public FirmwareBase {
+public:
+  RoutingBenchFirmware();
+
+  void setup() override;
+  void loop() override;
+
+  /**
+   * @brief Times every operation once
+   *
+   * Called by the round task on probes; public for tests.
+   */
+  void runRound();
+
+  /**
+   * @brief Checks whether this node measures
+   */
+  bool isProbe() const { return probe_; }
+
+  /**
+   * @brief Gets the samples of every round so far
+   */
+  const std::vector<RoutingSample>& getSamples() const { return samples_; }
+
+private:
+  /// Times @p calls runs of @p call and records the mean
+  template <typename Call>
+  void measure(RoutingOp op, size_t known_nodes, Call&& call);
+
+  /// Appends the samples of the last round to the output file
+  void writeRound(size_t first) const;
+
+  bool probe_{false};
+  uint32_t warmup_s_{20};
+  uint32_t interval_s_{10};
+  uint32_t calls_{20};
+  String output_;
+  uint32_t round_{0};
+  std::vector<RoutingSample> samples_;
+  size_t sink_{0};  ///< Summed call results, so the timed calls are kept
+};
+
+} // namespace firmware
+} // namespace simulator
+
+#endif // SIMULATOR_ROUTING_BENCH_FIRMWARE_HPP
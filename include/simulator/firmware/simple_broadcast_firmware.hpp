@@ -40,6 +40,7 @@ public:
     : FirmwareBase("SimpleBroadcast"),
       broadcast_task_(TASK_SECOND * 5, TASK_FOREVER, 
                      std::bind(&SimpleBroadcastFirmware::broadcastMessage, this)) {
+    useReceiveView();
   }
   
   /**
@@ -52,6 +53,10 @@ public:
     
     broadcast_message_ = getConfig("broadcast_message", "Hello from node");
     
+    // The message never changes, so it is encoded once for all broadcasts
+    broadcast_text_ = broadcast_message_ + " " + std::to_string(node_id_);
+    broadcast_frame_ = prepareBroadcast(broadcast_text_);
+    
     // Configure broadcast task
     broadcast_task_.setInterval(broadcast_interval_);
     
@@ -71,12 +76,13 @@ public:
    */
   void loop() override {
     // Nothing to do here - task scheduler handles broadcasts
+    sleepFor(SLEEP_UNTIL_WOKEN);
   }
   
   /**
    * @brief Handle received messages
    */
-  void onReceive(uint32_t from, String& msg) override {
+  void onReceiveView(uint32_t from, StringView msg) override {
     messages_received_++;
     std::cout << "[INFO] Node " << node_id_ << " received message from " 
               << from << ": " << msg << std::endl;
@@ -107,6 +113,16 @@ public:
    * @brief Gets number of messages received
    */
   uint32_t getMessagesReceived() const { return messages_received_; }
+  
+  void saveState(CheckpointWriter& out) const override {
+    out.write<uint32_t>(messages_sent_);
+    out.write<uint32_t>(messages_received_);
+  }
+  
+  void loadState(CheckpointReader& in) override {
+    messages_sent_ = in.read<uint32_t>();
+    messages_received_ = in.read<uint32_t>();
+  }
 
 private:
   /**
@@ -117,20 +133,19 @@ private:
       return;
     }
     
-    // Create message
-    String msg = broadcast_message_ + " " + std::to_string(node_id_);
-    
     // Broadcast to all nodes
-    mesh_->sendBroadcast(msg);
+    sendPreparedBroadcast(broadcast_frame_);
     messages_sent_++;
     
     std::cout << "[INFO] Node " << node_id_ << " broadcasting: " 
-              << msg << std::endl;
+              << broadcast_text_ << std::endl;
   }
   
   Task broadcast_task_;                    ///< Task for periodic broadcasts
   uint32_t broadcast_interval_{5000};      ///< Broadcast interval in ms
   String broadcast_message_;               ///< Message to broadcast
+  String broadcast_text_;                  ///< Message with the node ID
+  Payload broadcast_frame_;                ///< Encoded broadcast_text_
   uint32_t messages_sent_{0};              ///< Number of messages sent
   uint32_t messages_received_{0};          ///< Number of messages received
 };
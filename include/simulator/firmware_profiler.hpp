@@ -0,0 +1,300 @@
+/**
+ * @file firmware_profiler.hpp
+ * @brief CPU time attribution to firmware callbacks and nodes
+ *
+ * This file contains the per-node CallProfile filled by VirtualNode around
+ * every mesh update and firmware callback, and the FirmwareProfiler that
+ * aggregates those profiles per firmware type and ranks the costliest
+ * nodes at the end of a run.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_FIRMWARE_PROFILER_HPP
+#define SIMULATOR_FIRMWARE_PROFILER_HPP
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define SIMULATOR_HAS_TSC 1
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define SIMULATOR_HAS_TSC 1
+#endif
+
+namespace simulator {
+
+class NodeManager;
+
+/**
+ * @brief Reads a cheap, monotonic cycle counter
+ *
+ * The time-stamp counter on x86 (a few nanoseconds per read, no system
+ * call), steady_clock nanoseconds elsewhere. Ticks are converted to time
+ * by FirmwareProfiler, which calibrates them against steady_clock.
+ *
+ * @return Counter value in ticks
+ */
+inline uint64_t readCycleCounter() {
+#ifdef SIMULATOR_HAS_TSC
+  return __rdtsc();
+#else
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/**
+ * @brief Node code timed by a CallProfile
+ */
+enum class ProfiledCall : uint8_t {
+  MESH_UPDATE,          ///< painlessMesh update() of the node
+  SETUP,                ///< FirmwareBase::setup()
+  LOOP,                 ///< FirmwareBase::loop()
+  RECEIVE,              ///< FirmwareBase::onReceive() / onReceiveView()
+  NEW_CONNECTION,       ///< FirmwareBase::onNewConnection()
+  CHANGED_CONNECTIONS,  ///< FirmwareBase::onChangedConnections()
+  TASKS                 ///< Due FirmwareBase::runEvery() / runAfter() tasks
+};
+
+/// Number of ProfiledCall values
+constexpr size_t PROFILED_CALL_COUNT = 7;
+
+/**
+ * @brief Gets the report name of a profiled call, e.g. "loop"
+ */
+const char* profiledCallName(ProfiledCall call);
+
+/**
+ * @brief Duration statistics of one kind of call
+ *
+ * Besides count, sum and maximum, durations are counted in power-of-two
+ * buckets (bucket b holds durations of 2^(b-1) to 2^b - 1 ticks), which
+ * is coarse but small enough to keep for every node and merges by
+ * addition.
+ */
+struct CallStats {
+  /// Number of duration buckets (one per bit of a tick count)
+  static constexpr size_t BUCKET_COUNT = 65;
+
+  uint64_t calls = 0;                              ///< Calls timed
+  uint64_t ticks = 0;                              ///< Sum of durations
+  uint64_t max_ticks = 0;                          ///< Longest call
+  std::array<uint32_t, BUCKET_COUNT> buckets{};    ///< Calls per power-of-two duration
+
+  /**
+   * @brief Records one call
+   *
+   * @param duration Duration in ticks
+   */
+  void record(uint64_t duration);
+
+  /**
+   * @brief Adds the calls of another CallStats
+   */
+  void merge(const CallStats& other);
+
+  /**
+   * @brief Gets an upper bound of the duration at a percentile
+   *
+   * @param percentile Percentile in [0, 100]
+   * @return Upper end of the bucket holding that rank, clamped to
+   *         max_ticks (0 if empty)
+   */
+  uint64_t getPercentileTicks(double percentile) const;
+};
+
+/**
+ * @brief Time spent in each kind of call of one node
+ *
+ * Written only by the thread running the node, so recording needs no
+ * synchronization; read after the run.
+ */
+class CallProfile {
+public:
+  /**
+   * @brief Records one call
+   *
+   * @param call Kind of call
+   * @param duration Duration in ticks
+   */
+  void record(ProfiledCall call, uint64_t duration) {
+    stats_[static_cast<size_t>(call)].record(duration);
+  }
+
+  /**
+   * @brief Gets the statistics of one kind of call
+   */
+  const CallStats& get(ProfiledCall call) const { return stats_[static_cast<size_t>(call)]; }
+
+  /**
+   * @brief Adds the calls of another profile
+   */
+  void merge(const CallProfile& other);
+
+  /**
+   * @brief Gets the sum of all call durations in ticks
+   */
+  uint64_t getTotalTicks() const;
+
+private:
+  friend class ProfileScope;
+
+  std::array<CallStats, PROFILED_CALL_COUNT> stats_;
+  uint64_t nested_ticks_ = 0;   ///< Time of inner scopes of the open scope
+};
+
+/**
+ * @brief Times one call into a profile for the lifetime of the scope
+ *
+ * Does nothing, not even reading the counter, if the profile is null, so
+ * unprofiled nodes pay one branch per call. Scopes nest: a firmware
+ * callback fired from inside the painlessMesh update is recorded as its
+ * own call and left out of the update, so every tick is counted once.
+ *
+ * Example usage:
+ * @code
+ * {
+ *   ProfileScope scope(profile_.get(), ProfiledCall::LOOP);
+ *   firmware_->loop();
+ * }
+ * @endcode
+ */
+class ProfileScope {
+public:
+  ProfileScope(CallProfile* profile, ProfiledCall call)
+    : profile_(profile), call_(call) {
+    if (profile_) {
+      outer_nested_ = profile_->nested_ticks_;
+      profile_->nested_ticks_ = 0;
+      start_ = readCycleCounter();
+    }
+  }
+
+  ~ProfileScope() {
+    if (profile_) {
+      const uint64_t elapsed = readCycleCounter() - start_;
+      const uint64_t inner = std::min(profile_->nested_ticks_, elapsed);
+      profile_->record(call_, elapsed - inner);
+      profile_->nested_ticks_ = outer_nested_ + elapsed;
+    }
+  }
+
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+  CallProfile* profile_;
+  ProfiledCall call_;
+  uint64_t start_ = 0;
+  uint64_t outer_nested_ = 0;
+};
+
+/**
+ * @brief Profile of a node or of all nodes of one firmware type
+ */
+struct ProfileEntry {
+  std::string firmware;      ///< Firmware name ("(none)" for nodes without firmware)
+  uint32_t node_id = 0;      ///< Node ID (0 for a firmware total)
+  uint32_t nodes = 0;        ///< Nodes included
+  CallProfile profile;       ///< Merged call statistics
+  uint64_t ticks = 0;        ///< profile.getTotalTicks()
+};
+
+/**
+ * @brief Aggregated result of FirmwareProfiler::report()
+ */
+struct ProfileReport {
+  double ns_per_tick = 1.0;                ///< Calibrated tick length
+  uint64_t total_ticks = 0;                ///< Time in all profiled calls
+  uint32_t nodes = 0;                      ///< Nodes profiled
+  std::vector<ProfileEntry> firmwares;     ///< Per firmware type, costliest first
+  std::vector<ProfileEntry> top_nodes;     ///< Costliest nodes first
+
+  /**
+   * @brief Converts ticks to milliseconds
+   */
+  double toMs(uint64_t ticks) const { return static_cast<double>(ticks) * ns_per_tick / 1e6; }
+};
+
+/**
+ * @brief Attributes simulation CPU time to firmware types and nodes
+ *
+ * NodeManager::setProfiling() gives every node a CallProfile, which
+ * VirtualNode fills around mesh updates and firmware callbacks with
+ * ProfileScope. At the end of the run, add() or collect() hands the
+ * profiles to the profiler, and report() merges them per firmware type
+ * and picks the nodes that spent the most time.
+ *
+ * Ticks are converted to time with a rate measured between construction
+ * and report(), so the profiler should be created when profiling starts.
+ *
+ * Example usage:
+ * @code
+ * FirmwareProfiler profiler;
+ * manager.setProfiling(true);
+ * ... run ...
+ * profiler.collect(manager);
+ * FirmwareProfiler::print(profiler.report(10), wall_ms, std::cout);
+ * @endcode
+ */
+class FirmwareProfiler {
+public:
+  /**
+   * @brief Starts the tick rate calibration
+   */
+  FirmwareProfiler();
+
+  /**
+   * @brief Adds the profile of one node
+   *
+   * @param node_id Node ID
+   * @param firmware Firmware name
+   * @param profile Calls of the node
+   */
+  void add(uint32_t node_id, const std::string& firmware, const CallProfile& profile);
+
+  /**
+   * @brief Adds the profiles of all profiled nodes of a manager
+   *
+   * @param manager Nodes after the run (not updating concurrently)
+   */
+  void collect(const NodeManager& manager);
+
+  /**
+   * @brief Aggregates the added profiles
+   *
+   * @param top_nodes Number of costliest nodes to include
+   * @return Report with the tick rate calibrated up to now
+   */
+  ProfileReport report(size_t top_nodes) const;
+
+  /**
+   * @brief Prints a report as text
+   *
+   * @param report Report to print
+   * @param wall_ms Wall time of the run, for shares of the run (0 to omit)
+   * @param out Stream to print to
+   */
+  static void print(const ProfileReport& report, double wall_ms, std::ostream& out);
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  Clock::time_point start_time_;                  ///< Calibration start (steady_clock)
+  uint64_t start_ticks_;                          ///< Calibration start (ticks)
+  std::vector<ProfileEntry> nodes_;               ///< Added node profiles
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_FIRMWARE_PROFILER_HPP
@@ -0,0 +1,171 @@
+/**
+ * @file frame_batch.hpp
+ * @brief Wire encoding of timestamped frame batches
+ *
+ * This file contains the WireWriter and WireReader helpers and the batch
+ * codec used to ship in-flight mesh frames between the processes of a
+ * distributed simulation.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_FRAME_BATCH_HPP
+#define SIMULATOR_FRAME_BATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "simulator/delivery_queue.hpp"
+
+namespace simulator {
+
+/**
+ * @brief Appends little-endian integers and byte strings to a buffer
+ *
+ * The byte order is fixed so that hosts of different architectures can
+ * exchange batches.
+ */
+class WireWriter {
+public:
+  /**
+   * @brief Appends an unsigned 8-bit value
+   *
+   * @param value Value to append
+   */
+  void putU8(uint8_t value) { buffer_.push_back(static_cast<char>(value)); }
+
+  /**
+   * @brief Appends an unsigned 32-bit value
+   *
+   * @param value Value to append
+   */
+  void putU32(uint32_t value);
+
+  /**
+   * @brief Appends an unsigned 64-bit value
+   *
+   * @param value Value to append
+   */
+  void putU64(uint64_t value);
+
+  /**
+   * @brief Appends a length-prefixed byte string
+   *
+   * @param data Bytes to append
+   * @param size Number of bytes
+   */
+  void putBytes(const char* data, size_t size);
+
+  /**
+   * @brief Gets the encoded bytes
+   *
+   * @return Buffer written so far
+   */
+  const std::string& data() const { return buffer_; }
+
+  /**
+   * @brief Takes the encoded bytes, leaving the writer empty
+   *
+   * @return Buffer written so far
+   */
+  std::string release();
+
+private:
+  std::string buffer_;  ///< Encoded bytes
+};
+
+/**
+ * @brief Reads values written by WireWriter, checking every bound
+ */
+class WireReader {
+public:
+  /**
+   * @brief Construct a reader over a buffer
+   *
+   * @param data Encoded bytes (must outlive the reader)
+   */
+  explicit WireReader(const std::string& data) : data_(data) {}
+
+  /**
+   * @brief Reads an unsigned 8-bit value
+   *
+   * @return Value read
+   *
+   * @throws std::runtime_error if the buffer is exhausted
+   */
+  uint8_t getU8();
+
+  /**
+   * @brief Reads an unsigned 32-bit value
+   *
+   * @return Value read
+   *
+   * @throws std::runtime_error if the buffer is exhausted
+   */
+  uint32_t getU32();
+
+  /**
+   * @brief Reads an unsigned 64-bit value
+   *
+   * @return Value read
+   *
+   * @throws std::runtime_error if the buffer is exhausted
+   */
+  uint64_t getU64();
+
+  /**
+   * @brief Reads a length-prefixed byte string
+   *
+   * @return Bytes read
+   *
+   * @throws std::runtime_error if the buffer is exhausted
+   */
+  std::string getBytes();
+
+  /**
+   * @brief Checks if every byte has been read
+   *
+   * @return true at the end of the buffer
+   */
+  bool atEnd() const { return offset_ == data_.size(); }
+
+private:
+  const std::string& data_;  ///< Encoded bytes
+  size_t offset_{0};         ///< Read position
+
+  /**
+   * @brief Ensures @p size more bytes are available
+   *
+   * @throws std::runtime_error if they are not
+   */
+  void require(size_t size) const;
+};
+
+/**
+ * @brief Appends a batch of in-flight frames
+ *
+ * Each frame keeps its endpoints, delivery time and payload, so the
+ * receiving simulator can queue it exactly as the sender sampled it.
+ *
+ * @param writer Writer to append to
+ * @param frames Frames to encode, in order
+ */
+void encodeFrameBatch(WireWriter& writer, const std::vector<DelayedMessage>& frames);
+
+/**
+ * @brief Reads a batch written by encodeFrameBatch()
+ *
+ * @param reader Reader positioned at the batch
+ * @param frames Receives the frames, appended in order
+ * @return Number of frames read
+ *
+ * @throws std::runtime_error if the batch is truncated
+ */
+size_t decodeFrameBatch(WireReader& reader, std::vector<DelayedMessage>& frames);
+
+} // namespace simulator
+
+#endif // SIMULATOR_FRAME_BATCH_HPP
@@ -0,0 +1,92 @@
+/**
+ * @file frame_channel.hpp
+ * @brief Message channel between the processes of a distributed simulation
+ *
+ * This file contains the FrameChannel class which exchanges typed,
+ * length-prefixed messages over a TCP socket.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_FRAME_CHANNEL_HPP
+#define SIMULATOR_FRAME_CHANNEL_HPP
+
+#include <cstdint>
+#include <string>
+#include <boost/asio.hpp>
+
+namespace simulator {
+
+/**
+ * @brief Message types of the coordinator/worker protocol
+ */
+enum class ChannelMessage : uint8_t {
+  HELLO = 1,   ///< Worker -> coordinator: rank
+  WELCOME,     ///< Coordinator -> worker: worker count
+  READY,       ///< Worker -> coordinator: lookahead and hosted node IDs
+  WINDOW,      ///< Coordinator -> worker: window to run and inbound frames
+  DONE,        ///< Worker -> coordinator: frames bound for other ranks
+  STOP,        ///< Coordinator -> worker: end of the run
+  REPORT       ///< Worker -> coordinator: final counters
+};
+
+/**
+ * @brief Blocking channel of typed messages over a connected socket
+ *
+ * Each message is a little-endian u32 body length, a type byte and the
+ * body. The protocol is lock-step, so blocking reads and writes are all
+ * that is needed; Nagle's algorithm is disabled because every message is
+ * answered before the next one is sent.
+ */
+class FrameChannel {
+public:
+  /// Largest accepted message body in bytes
+  static constexpr uint32_t MAX_MESSAGE_SIZE = 256u * 1024u * 1024u;
+
+  /**
+   * @brief Construct a channel over a connected socket
+   *
+   * @param socket Connected socket (moved into the channel)
+   */
+  explicit FrameChannel(boost::asio::ip::tcp::socket socket);
+
+  /**
+   * @brief Sends a message
+   *
+   * @param type Message type
+   * @param body Message body
+   *
+   * @throws std::invalid_argument if the body exceeds MAX_MESSAGE_SIZE
+   * @throws boost::system::system_error on socket errors
+   */
+  void send(ChannelMessage type, const std::string& body);
+
+  /**
+   * @brief Receives the next message
+   *
+   * @param body Receives the message body
+   * @return Message type
+   *
+   * @throws std::runtime_error if the peer announces an oversized body
+   * @throws boost::system::system_error on socket errors or a closed peer
+   */
+  ChannelMessage receive(std::string& body);
+
+  /**
+   * @brief Receives the next message, which must be of a given type
+   *
+   * @param type Expected message type
+   * @param body Receives the message body
+   *
+   * @throws std::runtime_error if another type arrives
+   */
+  void expect(ChannelMessage type, std::string& body);
+
+private:
+  boost::asio::ip::tcp::socket socket_;  ///< Connected socket
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_FRAME_CHANNEL_HPP
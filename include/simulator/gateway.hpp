@@ -0,0 +1,215 @@
+/**
+ * @file gateway.hpp
+ * @brief UDP gateway between bridge nodes and external backend services
+ *
+ * This file contains the Gateway class which exposes chosen bridge nodes
+ * of an in-process mesh to a real backend over one UDP socket, batching
+ * the traffic of all bridges into shared datagrams.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_GATEWAY_HPP
+#define SIMULATOR_GATEWAY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/asio.hpp>
+
+#include "simulator/payload.hpp"
+
+namespace simulator {
+
+class MeshTransport;
+
+/**
+ * @brief Gateway counters
+ */
+struct GatewayStats {
+  uint64_t datagrams_sent = 0;       ///< Uplink datagrams sent to the backend
+  uint64_t records_sent = 0;         ///< Uplink records in those datagrams
+  uint64_t records_dropped = 0;      ///< Uplink records too large or refused by the socket
+  uint64_t datagrams_received = 0;   ///< Downlink datagrams from the backend
+  uint64_t records_received = 0;     ///< Downlink records sent into the mesh
+  uint64_t records_rejected = 0;     ///< Downlink records malformed, for unknown bridges or unroutable
+};
+
+/**
+ * @brief Connects bridge nodes to an external backend over UDP
+ *
+ * Every frame delivered to an exposed bridge node (see MeshTransport's
+ * frame taps) is queued as an uplink record and sent to the backend by
+ * flush(), packed with the records of all other bridges into datagrams
+ * of at most max_datagram bytes. The datagrams are gathered straight from
+ * the frame buffers, so no payload is copied. poll() reads the datagrams
+ * the backend sent to the listen endpoint and has each bridge send their
+ * records into the mesh, as if they came in over the bridge's uplink.
+ *
+ * A datagram is a sequence of records, each little-endian:
+ * `u32 bridge | u32 peer | u32 length | length bytes`. Uplink, `peer` is
+ * the mesh node that sent the frame; downlink, it is the destination, or
+ * 0 to broadcast. The bytes are the payload the node's mesh stack sent
+ * or will receive. One socket serves any number of bridges, so a backend
+ * can be loaded with the traffic of thousands of nodes.
+ *
+ * The socket never blocks: a full send buffer drops the records it
+ * refuses, like a congested uplink would. Call poll() and flush() on the
+ * simulation thread, between ticks.
+ *
+ * Example usage:
+ * @code
+ * Gateway gateway(transport, "0.0.0.0:7000", "127.0.0.1:7001", 1400);
+ * gateway.expose(bridge_id);
+ * while (running) {
+ *   gateway.poll(clock.nowMs());
+ *   ... tick ...
+ *   gateway.flush();
+ * }
+ * @endcode
+ */
+class Gateway {
+public:
+  /// Bytes in front of every record's payload
+  static constexpr size_t RECORD_HEADER_SIZE = 12;
+
+  /// Largest UDP payload over IPv4
+  static constexpr size_t MAX_DATAGRAM = 65507;
+
+  /// Peer of a downlink record that is broadcast
+  static constexpr uint32_t BROADCAST = 0;
+
+  /// Datagrams read per poll() at most, so a flood cannot stall a tick
+  static constexpr size_t MAX_DATAGRAMS_PER_POLL = 4096;
+
+  /**
+   * @brief Construct a gateway and bind its socket
+   *
+   * @param transport In-process transport of the bridges (must outlive
+   *                  the gateway)
+   * @param listen Local "host:port" the backend sends to (port 0 picks a
+   *               free one)
+   * @param backend "host:port" uplink records are sent to
+   * @param max_datagram Largest datagram sent, in bytes
+   *
+   * @throws std::invalid_argument if an endpoint is malformed or
+   *         max_datagram cannot hold a record header
+   * @throws boost::system::system_error if the socket cannot be bound
+   */
+  Gateway(MeshTransport& transport, const std::string& listen, const std::string& backend,
+          size_t max_datagram);
+
+  /**
+   * @brief Destructor; removes the frame taps
+   */
+  ~Gateway();
+
+  Gateway(const Gateway&) = delete;
+  Gateway& operator=(const Gateway&) = delete;
+
+  /**
+   * @brief Parses a "host:port" endpoint
+   *
+   * @param text Numeric IPv4 or IPv6 address (IPv6 in brackets), or
+   *             "localhost", then a colon and a port
+   * @return UDP endpoint
+   *
+   * @throws std::invalid_argument if the text is malformed
+   */
+  static boost::asio::ip::udp::endpoint parseEndpoint(const std::string& text);
+
+  /**
+   * @brief Exposes a node to the backend
+   *
+   * @param nodeId Bridge node identifier
+   */
+  void expose(uint32_t nodeId);
+
+  /**
+   * @brief Checks whether a node is exposed
+   */
+  bool isExposed(uint32_t nodeId) const { return exposed_.count(nodeId) > 0; }
+
+  /**
+   * @brief Gets the number of exposed nodes
+   */
+  size_t getExposedCount() const { return exposed_.size(); }
+
+  /**
+   * @brief Also forwards broadcasts the bridges receive
+   *
+   * Off by default: a mesh-wide broadcast reaches every bridge, and the
+   * backend usually wants only the traffic addressed to them.
+   */
+  void setForwardBroadcasts(bool forward) { forward_broadcasts_ = forward; }
+
+  /**
+   * @brief Gets the bound listen endpoint
+   */
+  boost::asio::ip::udp::endpoint getLocalEndpoint() const { return socket_.local_endpoint(); }
+
+  /**
+   * @brief Sends the records the backend sent since the last poll into the mesh
+   *
+   * @param now_ms Simulated send time of the injected frames
+   * @return Number of records sent into the mesh
+   */
+  size_t poll(uint64_t now_ms);
+
+  /**
+   * @brief Sends the queued uplink records to the backend
+   *
+   * @return Number of datagrams sent
+   */
+  size_t flush();
+
+  /**
+   * @brief Gets the number of queued uplink records
+   */
+  size_t getQueuedCount() const { return uplink_.size(); }
+
+  /**
+   * @brief Gets the gateway counters
+   */
+  const GatewayStats& getStats() const { return stats_; }
+
+private:
+  /// Frame queued for the backend
+  struct Record {
+    uint32_t bridge;
+    uint32_t peer;
+    Payload message;
+  };
+
+  MeshTransport& transport_;
+  boost::asio::io_context io_;
+  boost::asio::ip::udp::socket socket_;
+  boost::asio::ip::udp::endpoint backend_;
+  size_t max_datagram_;
+  bool forward_broadcasts_{false};
+  std::set<uint32_t> exposed_;
+  std::vector<Record> uplink_;                          ///< Records awaiting flush()
+  std::string headers_;                                 ///< Encoded record headers of a flush
+  std::vector<boost::asio::const_buffer> buffers_;      ///< Gather list of one datagram
+  std::string receive_buffer_;                          ///< One downlink datagram
+  GatewayStats stats_;
+
+  /**
+   * @brief Sends the gathered datagram of records [first, last)
+   */
+  void sendDatagram(size_t first, size_t last);
+
+  /**
+   * @brief Sends the records of one downlink datagram into the mesh
+   */
+  void injectDatagram(const char* data, size_t size, uint64_t now_ms);
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_GATEWAY_HPP
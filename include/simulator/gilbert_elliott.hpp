@@ -0,0 +1,107 @@
+/**
+ * @file gilbert_elliott.hpp
+ * @brief Two-state Markov (Gilbert-Elliott) packet loss model
+ *
+ * This file contains the GilbertElliott class which turns the parameters
+ * of a Gilbert-Elliott chain into integer thresholds, so each packet's
+ * state transition and loss decision is two comparisons on random words.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_GILBERT_ELLIOTT_HPP
+#define SIMULATOR_GILBERT_ELLIOTT_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace simulator {
+
+/**
+ * @brief Gilbert-Elliott burst loss chain
+ *
+ * A link is either GOOD or BAD. Before every packet it leaves its state
+ * with probability good_to_bad (from GOOD) or bad_to_good (from BAD), then
+ * the packet is lost with the loss probability of the new state. With
+ * loss_good = 0 and loss_bad = 1 this is the simple Gilbert model, where
+ * loss bursts last 1 / bad_to_good packets on average.
+ *
+ * The whole per-link state is one byte (0 = GOOD, 1 = BAD). step() picks
+ * thresholds by indexing with that byte instead of branching, and
+ * stepBatch() runs the same code over arrays of links so the compiler can
+ * vectorize it.
+ *
+ * Example usage:
+ * @code
+ * GilbertElliott chain(0.01f, 0.3f, 0.0f, 1.0f);
+ * uint8_t state = GilbertElliott::GOOD;
+ * bool lost = chain.step(state, random64);
+ * @endcode
+ */
+class GilbertElliott {
+public:
+  static constexpr uint8_t GOOD = 0;  ///< State with loss probability loss_good
+  static constexpr uint8_t BAD = 1;   ///< State with loss probability loss_bad
+
+  /**
+   * @brief Construct a chain
+   *
+   * Probabilities outside 0.0-1.0 are clamped.
+   *
+   * @param good_to_bad Probability of entering BAD per packet
+   * @param bad_to_good Probability of leaving BAD per packet
+   * @param loss_good Loss probability in GOOD
+   * @param loss_bad Loss probability in BAD
+   */
+  GilbertElliott(float good_to_bad, float bad_to_good, float loss_good, float loss_bad);
+
+  /**
+   * @brief Advances one link by one packet
+   *
+   * @param state Link state (GOOD or BAD), updated in place
+   * @param random 64 random bits; the low half drives the transition and
+   *               the high half the loss decision
+   * @return true if the packet is lost
+   */
+  bool step(uint8_t& state, uint64_t random) const {
+    const uint32_t transition = static_cast<uint32_t>(random);
+    const uint32_t loss = static_cast<uint32_t>(random >> 32);
+    state = static_cast<uint8_t>(state ^ (transition < leave_[state]));
+    return loss < loss_[state];
+  }
+
+  /**
+   * @brief Advances several links by one packet each
+   *
+   * Same result as calling step() for every index in order.
+   *
+   * @param states Link states, updated in place
+   * @param random 64 random bits per link
+   * @param lost Receives 1 for each lost packet, 0 otherwise
+   * @param count Number of links
+   */
+  void stepBatch(uint8_t* states, const uint64_t* random, uint8_t* lost, size_t count) const;
+
+  /**
+   * @brief Gets the long-run fraction of lost packets
+   *
+   * @return Stationary loss probability of the chain
+   */
+  double getMeanLoss() const;
+
+  /**
+   * @brief Gets the mean length of a stay in BAD, in packets
+   *
+   * @return Expected BAD run length (infinite if BAD is never left)
+   */
+  double getMeanBadRun() const;
+
+private:
+  uint64_t leave_[2];   ///< Transition thresholds per state (probability * 2^32)
+  uint64_t loss_[2];    ///< Loss thresholds per state (probability * 2^32)
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_GILBERT_ELLIOTT_HPP
@@ -0,0 +1,143 @@
+/**
+ * @file latency_histogram.hpp
+ * @brief Fixed-size log-bucketed latency histogram
+ *
+ * This file contains the LatencyHistogram class used for latency
+ * percentiles. The bucket layout follows HdrHistogram: exact buckets for
+ * small values, then 32 linear sub-buckets per power of two.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_LATENCY_HISTOGRAM_HPP
+#define SIMULATOR_LATENCY_HISTOGRAM_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace simulator {
+
+class CheckpointReader;
+class CheckpointWriter;
+
+/**
+ * @brief Histogram of latencies in milliseconds with bounded relative error
+ *
+ * Values below 64ms are counted exactly. Above that every bucket covers
+ * at most 1/32 of its value, so a reported percentile is within ~3% of
+ * the true one. Values above MAX_TRACKABLE_MS are counted in the top
+ * bucket (the exact maximum is still tracked).
+ *
+ * Memory is fixed (BUCKET_COUNT counters), record() is O(1), and two
+ * histograms merge by adding counters, so histograms filled by separate
+ * links or shards can be combined without losing precision.
+ *
+ * Example usage:
+ * @code
+ * LatencyHistogram histogram;
+ * histogram.record(latency_ms);
+ *
+ * uint32_t p99 = histogram.getPercentile(99.0);
+ * total.merge(histogram);
+ * @endcode
+ */
+class LatencyHistogram {
+public:
+  /// log2 of the number of sub-buckets per power of two
+  static constexpr uint32_t SUB_BUCKET_BITS = 5;
+  /// Largest value with its own bucket (about 4.6 hours)
+  static constexpr uint32_t MAX_TRACKABLE_MS = (1u << 24) - 1;
+  /// Number of counters
+  static constexpr size_t BUCKET_COUNT = 640;
+
+  /**
+   * @brief Records one latency
+   *
+   * @param latency_ms Latency in milliseconds
+   */
+  void record(uint32_t latency_ms);
+
+  /**
+   * @brief Adds all values recorded in another histogram
+   *
+   * @param other Histogram to merge into this one
+   */
+  void merge(const LatencyHistogram& other);
+
+  /**
+   * @brief Removes all recorded values
+   */
+  void clear();
+
+  /**
+   * @brief Writes the counters to a checkpoint (non-empty buckets only)
+   */
+  void saveState(CheckpointWriter& out) const;
+
+  /**
+   * @brief Replaces the counters with those of a checkpoint
+   *
+   * @throws std::runtime_error if the checkpoint is malformed
+   */
+  void loadState(CheckpointReader& in);
+
+  /**
+   * @brief Gets the number of recorded values
+   */
+  uint64_t getCount() const { return count_; }
+
+  /**
+   * @brief Gets the smallest recorded value (0 if empty)
+   */
+  uint32_t getMin() const { return count_ > 0 ? min_ : 0; }
+
+  /**
+   * @brief Gets the largest recorded value (0 if empty)
+   */
+  uint32_t getMax() const { return max_; }
+
+  /**
+   * @brief Gets the mean of the recorded values (0 if empty)
+   */
+  double getMean() const;
+
+  /**
+   * @brief Gets the value at a percentile
+   *
+   * Returns the upper end of the bucket holding the value at that rank,
+   * clamped to the recorded minimum and maximum.
+   *
+   * @param percentile Percentile in [0, 100], e.g. 99.9
+   * @return Latency in milliseconds (0 if empty)
+   */
+  uint32_t getPercentile(double percentile) const;
+
+  /**
+   * @brief Counts the values at or below each of a set of bounds
+   *
+   * One pass over the buckets serves every bound, as needed for
+   * cumulative (Prometheus-style) histogram buckets. Values sharing a
+   * bucket with a bound count as at or below it.
+   *
+   * @param bounds Bounds in milliseconds, ascending
+   * @param bound_count Number of bounds
+   * @param counts Receives bound_count cumulative counts
+   */
+  void getCumulativeCounts(const uint32_t* bounds, size_t bound_count, uint64_t* counts) const;
+
+private:
+  std::array<uint64_t, BUCKET_COUNT> counts_{};  ///< Values per bucket
+  uint64_t count_{0};                            ///< Total values
+  uint64_t sum_{0};                              ///< Sum of values (for the mean)
+  uint32_t min_{UINT32_MAX};                     ///< Smallest value
+  uint32_t max_{0};                              ///< Largest value
+
+  static size_t bucketFor(uint32_t value);
+  static uint32_t bucketUpperBound(size_t bucket);
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_LATENCY_HISTOGRAM_HPP
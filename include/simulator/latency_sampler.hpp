@@ -0,0 +1,166 @@
+/**
+ * @file latency_sampler.hpp
+ * @brief Latency configuration and precomputed latency samplers
+ *
+ * This file contains the LatencyConfig type and the LatencySampler class
+ * which turns a LatencyConfig into an alias table over its integer
+ * millisecond range, so drawing a latency is a table lookup.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_LATENCY_SAMPLER_HPP
+#define SIMULATOR_LATENCY_SAMPLER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "simulator/counter_rng.hpp"
+
+namespace simulator {
+
+/**
+ * @brief Distribution types for latency simulation
+ */
+enum class DistributionType {
+  UNIFORM,      ///< Uniform distribution (equal probability)
+  NORMAL,       ///< Normal (Gaussian) distribution
+  EXPONENTIAL   ///< Exponential distribution
+};
+
+/**
+ * @brief Latency configuration for network connections
+ */
+struct LatencyConfig {
+  uint32_t min_ms = 0;                  ///< Minimum latency in milliseconds
+  uint32_t max_ms = 100;                ///< Maximum latency in milliseconds
+  DistributionType distribution = DistributionType::UNIFORM;  ///< Distribution type
+  
+  /**
+   * @brief Validates the configuration
+   * @return true if valid, false otherwise
+   */
+  bool isValid() const {
+    return min_ms <= max_ms;
+  }
+  
+  bool operator==(const LatencyConfig& other) const {
+    return min_ms == other.min_ms && max_ms == other.max_ms &&
+           distribution == other.distribution;
+  }
+  
+  bool operator!=(const LatencyConfig& other) const {
+    return !(*this == other);
+  }
+};
+
+/**
+ * @brief Precomputed sampler for one LatencyConfig
+ *
+ * The sampler computes the probability of every integer latency in
+ * [min_ms, max_ms] once, with the same shape the simulator has always
+ * used (normal: mean at the centre, stddev = range / 6; exponential:
+ * rate 3 / range; both clamped to the range and rounded), and stores it
+ * as a Walker/Vose alias table. A sample then takes one 64-bit random
+ * word, one table entry and one comparison, with no floating point.
+ *
+ * Ranges wider than MAX_TABLE_SIZE are not tabulated and fall back to
+ * sampling the std distributions directly.
+ *
+ * Example usage:
+ * @code
+ * LatencySampler sampler(config);
+ * CounterRng rng(key, sequence);
+ * uint32_t latency_ms = sampler.sample(rng);
+ * @endcode
+ */
+class LatencySampler {
+public:
+  /// Largest number of distinct latencies kept in a table
+  static constexpr size_t MAX_TABLE_SIZE = 65536;
+
+  /**
+   * @brief Build a sampler
+   *
+   * @param config Latency configuration
+   * @throws std::invalid_argument if config is invalid
+   */
+  explicit LatencySampler(const LatencyConfig& config);
+
+  /**
+   * @brief Gets the configuration the sampler was built from
+   */
+  const LatencyConfig& getConfig() const { return config_; }
+
+  /**
+   * @brief Checks whether sampling uses the alias table
+   *
+   * @return false if the range exceeds MAX_TABLE_SIZE
+   */
+  bool isTabulated() const { return !table_.empty(); }
+
+  /**
+   * @brief Draws one latency
+   *
+   * @param rng Generator for this sample
+   * @return Latency in milliseconds within [min_ms, max_ms]
+   */
+  uint32_t sample(CounterRng& rng) const;
+
+  /**
+   * @brief Maps one uniformly distributed 64-bit word to a latency
+   *
+   * @param random Uniform random bits
+   * @return Latency in milliseconds within [min_ms, max_ms]
+   */
+  uint32_t sample(uint64_t random) const;
+
+  /**
+   * @brief Maps a batch of random words to latencies
+   *
+   * Equivalent to calling sample(random[i]) for each element. For
+   * tabulated samplers the loop is branch-free (multiply, gather,
+   * compare, select) so the compiler can vectorize it.
+   *
+   * @param random Uniform random bits, one word per sample
+   * @param out Receives @p count latencies in milliseconds
+   * @param count Number of samples
+   */
+  void sampleBatch(const uint64_t* random, uint32_t* out, size_t count) const;
+
+  /**
+   * @brief Gets the probability of one latency value
+   *
+   * @param latency_ms Latency in milliseconds
+   * @return Probability mass of that value (0 outside the range)
+   */
+  double probability(uint32_t latency_ms) const;
+
+private:
+  struct Entry {
+    uint32_t threshold;     ///< Keep this bucket if high word < threshold
+    uint32_t alias;         ///< Bucket offset used otherwise
+  };
+
+  LatencyConfig config_;              ///< Source configuration
+  std::vector<Entry> table_;          ///< Alias table (empty if not tabulated)
+  std::vector<double> probability_;   ///< Probability per latency value
+
+  uint32_t lookup(uint64_t random) const {
+    uint32_t bucket = static_cast<uint32_t>(
+        (static_cast<uint64_t>(static_cast<uint32_t>(random)) * table_.size()) >> 32);
+    const Entry& entry = table_[bucket];
+    return config_.min_ms +
+           (static_cast<uint32_t>(random >> 32) < entry.threshold ? bucket : entry.alias);
+  }
+
+  void buildTable();
+
+  uint32_t sampleDirect(CounterRng& rng) const;
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_LATENCY_SAMPLER_HPP
@@ -0,0 +1,126 @@
+/**
+ * @file link_table.hpp
+ * @brief Open-addressing index from directed links to dense slots
+ *
+ * This file contains the LinkTable class which maps a (from, to) node pair
+ * to a dense, stable index. Callers keep their per-link records in a plain
+ * vector addressed by that index.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_LINK_TABLE_HPP
+#define SIMULATOR_LINK_TABLE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace simulator {
+
+/**
+ * @brief Hash index for directed links
+ *
+ * Both 32-bit node IDs are packed into one 64-bit key and looked up in a
+ * linear-probing table with a power-of-two capacity, kept at most half
+ * full. A lookup is a single hash and, in the common case, a single probe
+ * into contiguous memory, independent of the number of links.
+ *
+ * Indices are assigned in insertion order (0, 1, 2, ...) and never change,
+ * so they can address a parallel std::vector of link records. Links are
+ * never removed individually; clear() drops all of them.
+ *
+ * Example usage:
+ * @code
+ * LinkTable index;
+ * std::vector<LinkRecord> records;
+ *
+ * uint32_t slot = index.insert(from, to);
+ * if (slot == records.size()) {
+ *   records.emplace_back();  // New link
+ * }
+ * records[slot].packets++;
+ * @endcode
+ */
+class LinkTable {
+public:
+  /// Index returned by find() when a link is not present
+  static constexpr uint32_t NPOS = UINT32_MAX;
+
+  /**
+   * @brief Construct an empty table
+   */
+  LinkTable();
+
+  /**
+   * @brief Finds the index of a link
+   *
+   * @param from Source node ID
+   * @param to Destination node ID
+   * @return Dense index of the link, or NPOS if not present
+   */
+  uint32_t find(uint32_t from, uint32_t to) const;
+
+  /**
+   * @brief Finds or inserts a link
+   *
+   * @param from Source node ID
+   * @param to Destination node ID
+   * @return Dense index of the link; equals size() - 1 if newly inserted
+   */
+  uint32_t insert(uint32_t from, uint32_t to);
+
+  /**
+   * @brief Gets the number of links
+   *
+   * @return Count of links inserted since the last clear()
+   */
+  size_t size() const { return size_; }
+
+  /**
+   * @brief Gets one link by index
+   *
+   * @param index Dense index below size()
+   * @return (from, to) of the link
+   */
+  std::pair<uint32_t, uint32_t> getLink(uint32_t index) const {
+    return {static_cast<uint32_t>(keys_[index] >> 32), static_cast<uint32_t>(keys_[index])};
+  }
+
+  /**
+   * @brief Gets every link by index
+   *
+   * @return (from, to) of link i at position i
+   */
+  std::vector<std::pair<uint32_t, uint32_t>> getLinks() const;
+
+  /**
+   * @brief Removes all links
+   */
+  void clear();
+
+private:
+  struct Slot {
+    uint64_t key;        ///< Packed (from, to) pair
+    uint32_t index;      ///< Dense index, or NPOS if empty
+  };
+
+  std::vector<Slot> slots_;    ///< Open-addressing slots (power-of-two size)
+  std::vector<uint64_t> keys_; ///< Key of each dense index, for reverse lookups
+  size_t mask_;                ///< slots_.size() - 1
+  size_t size_{0};             ///< Number of occupied slots
+
+  static uint64_t makeKey(uint32_t from, uint32_t to) {
+    return (static_cast<uint64_t>(from) << 32) | to;
+  }
+
+  size_t slotFor(uint64_t key) const;
+
+  void grow();
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_LINK_TABLE_HPP
@@ -0,0 +1,206 @@
+/**
+ * @file link_trace.hpp
+ * @brief Memory-mapped per-link latency and loss traces
+ *
+ * This file contains the LinkTrace class which maps a binary trace file of
+ * recorded link conditions into memory, and the TraceCursor class which
+ * plays one link's series back as simulation time advances.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_LINK_TRACE_HPP
+#define SIMULATOR_LINK_TRACE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace simulator {
+
+class MappedFile;
+
+/**
+ * @brief One recorded link condition
+ *
+ * Stored as-is in the trace file (16 bytes, little-endian).
+ */
+struct TraceSample {
+  uint64_t time_ms;      ///< Simulation time the sample takes effect
+  uint32_t latency_ms;   ///< One-way latency
+  float loss;            ///< Packet loss probability (0.0 to 1.0)
+};
+
+static_assert(sizeof(TraceSample) == 16, "TraceSample must match the file layout");
+
+/**
+ * @brief Playback position in one link's trace series
+ *
+ * Points straight into the mapped file: a cursor is 16 bytes no matter how
+ * long the series is. Seeking forward by one tick steps past the samples
+ * that took effect since the last call, so playing a trace with
+ * non-decreasing times costs O(1) per packet. Seeking backwards (sends
+ * replayed after a lookahead window) steps back the same way.
+ *
+ * Before the first sample the first one applies; after the last sample
+ * the last one stays in effect.
+ */
+class TraceCursor {
+public:
+  TraceCursor() = default;
+
+  /**
+   * @brief Construct a cursor over a series
+   *
+   * @param samples First sample (sorted by time_ms)
+   * @param count Number of samples (at least 1)
+   */
+  TraceCursor(const TraceSample* samples, uint32_t count)
+    : samples_(samples), count_(count) {}
+
+  /**
+   * @brief Checks whether the cursor plays a series
+   */
+  explicit operator bool() const { return samples_ != nullptr; }
+
+  /**
+   * @brief Moves to the sample in effect at a time
+   *
+   * @param time_ms Simulation time in milliseconds
+   * @return Sample in effect
+   */
+  const TraceSample& seek(uint64_t time_ms) {
+    while (pos_ + 1 < count_ && samples_[pos_ + 1].time_ms <= time_ms) {
+      ++pos_;
+    }
+    while (pos_ > 0 && samples_[pos_].time_ms > time_ms) {
+      --pos_;
+    }
+    return samples_[pos_];
+  }
+
+  /**
+   * @brief Gets the sample found by the last seek()
+   */
+  const TraceSample& current() const { return samples_[pos_]; }
+
+private:
+  const TraceSample* samples_ = nullptr;
+  uint32_t count_ = 0;
+  uint32_t pos_ = 0;
+};
+
+/**
+ * @brief Read-only trace file of recorded link conditions
+ *
+ * The file holds one time series of TraceSample per directed link. It is
+ * mapped into memory rather than read, so a multi-gigabyte trace costs no
+ * heap and only the pages of the samples actually played are loaded.
+ *
+ * File layout (little-endian, offsets from the start of the file):
+ * @code
+ * header     char magic[8] = "PMTRACE1", uint32 version = 1, uint32 links
+ * directory  links x { uint32 from, uint32 to, uint64 offset, uint64 count }
+ * samples    TraceSample[count] at each offset (8-byte aligned)
+ * @endcode
+ *
+ * Sample times must be non-decreasing within a series.
+ *
+ * Example usage:
+ * @code
+ * auto trace = LinkTrace::open("field_trace.bin");
+ * network.setLinkTrace(trace);
+ * @endcode
+ */
+class LinkTrace {
+public:
+  /**
+   * @brief Directory entry of one link's series
+   */
+  struct Link {
+    uint32_t from;       ///< Source node ID
+    uint32_t to;         ///< Destination node ID
+    uint64_t offset;     ///< Byte offset of the first sample
+    uint64_t count;      ///< Number of samples
+  };
+
+  /**
+   * @brief Series to store with write()
+   */
+  struct Series {
+    uint32_t from;                        ///< Source node ID
+    uint32_t to;                          ///< Destination node ID
+    std::vector<TraceSample> samples;     ///< Samples sorted by time_ms
+  };
+
+  /**
+   * @brief Maps a trace file
+   *
+   * @param path Trace file path
+   * @return Mapped trace
+   * @throws std::runtime_error if the file cannot be mapped or is malformed
+   */
+  static std::shared_ptr<const LinkTrace> open(const std::string& path);
+
+  /**
+   * @brief Writes a trace file
+   *
+   * @param path Trace file path
+   * @param series One series per directed link
+   * @throws std::runtime_error if the file cannot be written
+   * @throws std::invalid_argument if a series is empty
+   */
+  static void write(const std::string& path, const std::vector<Series>& series);
+
+  ~LinkTrace();
+
+  LinkTrace(const LinkTrace&) = delete;
+  LinkTrace& operator=(const LinkTrace&) = delete;
+
+  /**
+   * @brief Gets the number of traced links
+   */
+  size_t getLinkCount() const { return link_count_; }
+
+  /**
+   * @brief Gets the directory entry of a link
+   *
+   * @param index Link index (0 to getLinkCount() - 1)
+   * @return Directory entry (points into the mapping)
+   */
+  const Link& getLink(size_t index) const { return links_[index]; }
+
+  /**
+   * @brief Creates a playback cursor for a link
+   *
+   * @param index Link index (0 to getLinkCount() - 1)
+   * @return Cursor over the link's samples
+   */
+  TraceCursor cursor(size_t index) const;
+
+  /**
+   * @brief Gets the lowest latency of a link's series
+   *
+   * Scans every sample of the series.
+   *
+   * @param index Link index (0 to getLinkCount() - 1)
+   * @return Lowest latency_ms in the series
+   */
+  uint32_t getMinLatency(size_t index) const;
+
+private:
+  LinkTrace() = default;
+
+  std::unique_ptr<MappedFile> file_;     ///< Trace file mapping
+  const unsigned char* data_ = nullptr;  ///< Start of the mapping
+  size_t size_ = 0;                      ///< Mapped bytes
+  const Link* links_ = nullptr;          ///< Directory inside the mapping
+  size_t link_count_ = 0;
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_LINK_TRACE_HPP
@@ -0,0 +1,343 @@
+/**
+ * @file logger.hpp
+ * @brief Asynchronous structured logging
+ *
+ * This file contains the Logger class and the SIM_LOG macros. Log
+ * statements capture their arguments into fixed-size binary records; a
+ * background writer thread formats and writes them, so logging never
+ * blocks a simulation thread on stream I/O.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_LOGGER_HPP
+#define SIMULATOR_LOGGER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// wingdi.h defines ERROR as a macro
+#ifdef ERROR
+#undef ERROR
+#endif
+
+/**
+ * @brief Lowest level compiled into the binary (0 = DEBUG ... 4 = OFF)
+ *
+ * Statements below it are removed by the compiler. Set with the CMake
+ * cache variable of the same name.
+ */
+#ifndef SIMULATOR_LOG_MIN_LEVEL
+#define SIMULATOR_LOG_MIN_LEVEL 0
+#endif
+
+namespace simulator {
+
+/**
+ * @brief Log severity, in increasing order
+ */
+enum class LogLevel : uint8_t {
+  DEBUG = 0,   ///< Per-node and per-item details
+  INFO = 1,    ///< Progress of the run
+  WARN = 2,    ///< Recoverable problems
+  ERROR = 3,   ///< Failures
+  OFF = 4      ///< Nothing is logged
+};
+
+/**
+ * @brief Checks whether statements of a level are compiled in
+ *
+ * @param level Statement level
+ * @return true if level is at or above SIMULATOR_LOG_MIN_LEVEL
+ */
+constexpr bool levelCompiledIn(LogLevel level) {
+#if SIMULATOR_LOG_MIN_LEVEL > 0
+  return static_cast<int>(level) >= SIMULATOR_LOG_MIN_LEVEL;
+#else
+  // Every level is; comparing against 0 would warn under -Wtype-limits
+  return static_cast<void>(level), true;
+#endif
+}
+
+/**
+ * @brief One captured argument of a log record
+ */
+struct LogArg {
+  /// Argument kind
+  enum class Type : uint8_t {
+    INT,      ///< Signed integer (i)
+    UINT,     ///< Unsigned integer (u)
+    DOUBLE,   ///< Floating point (d)
+    TEXT,     ///< Characters [offset, offset + length) of the record text
+    SPILLED   ///< Characters [offset, offset + length) of the record spill
+  };
+
+  Type type{Type::INT};
+  uint32_t offset{0};
+  uint32_t length{0};
+  union {
+    int64_t i;
+    uint64_t u;
+    double d;
+  };
+
+  LogArg() : i(0) {}
+};
+
+/**
+ * @brief Binary log record with deferred formatting
+ *
+ * Holds a pointer to the format string (which must have static storage
+ * duration, such as a string literal) and up to MAX_ARGS typed arguments.
+ * String arguments are copied into the inline text area; the rare ones
+ * that do not fit go to the spill string instead of being truncated.
+ */
+struct LogRecord {
+  static constexpr size_t MAX_ARGS = 6;     ///< Arguments per record
+  static constexpr size_t TEXT_SIZE = 128;  ///< Inline string storage
+
+  uint64_t sequence{0};                ///< Submission order across threads
+  const char* format{""};              ///< Format string, "{}" per argument
+  LogLevel level{LogLevel::INFO};      ///< Severity
+  uint8_t count{0};                    ///< Captured arguments
+  uint32_t text_used{0};               ///< Bytes of text in use
+  LogArg args[MAX_ARGS];               ///< Captured arguments
+  char text[TEXT_SIZE];                ///< Inline string storage
+  std::string spill;                   ///< Strings that did not fit in text
+};
+
+/**
+ * @brief Leveled logger with per-thread ring buffers and a writer thread
+ *
+ * A log statement whose level is below the compile-time minimum
+ * (SIMULATOR_LOG_MIN_LEVEL) compiles to nothing; one below the runtime
+ * level costs a single relaxed load and branch. Enabled statements fill a
+ * LogRecord without formatting anything.
+ *
+ * While the writer runs (start() to stop()), each thread pushes its
+ * records into its own lock-free SpscQueue, registered on the thread's
+ * first record. The writer drains all queues, orders the records by
+ * sequence number, formats them and writes them with one flush per pass.
+ * A thread whose queue is full wakes the writer and yields until there is
+ * room, so records are never dropped. Before start() and after stop(),
+ * records are formatted and written at once on the calling thread.
+ *
+ * WARN and ERROR records go to the error stream, the others to the output
+ * stream. Each record is one line; the format string carries any prefix
+ * such as "[INFO]".
+ *
+ * start(), stop() and setOutput() must not race with logging threads.
+ *
+ * Example usage:
+ * @code
+ * Logger::instance().setLevel(LogLevel::INFO);
+ * Logger::instance().start();
+ * SIM_LOG_INFO("[INFO] Node {} started with firmware: {}", node_id, name);
+ * Logger::instance().stop();  // drains every queued record
+ * @endcode
+ */
+class Logger {
+public:
+  /// Default capacity of each thread's ring buffer in records
+  static constexpr size_t DEFAULT_BUFFER_RECORDS = 1024;
+
+  /**
+   * @brief Construct a stopped logger writing to std::cout and std::cerr
+   *        at INFO level
+   */
+  Logger();
+
+  /**
+   * @brief Destructor; stops the writer after draining its queues
+   */
+  ~Logger();
+
+  Logger(const Logger&) = delete;
+  Logger& operator=(const Logger&) = delete;
+
+  /**
+   * @brief Gets the process-wide logger used by the SIM_LOG macros
+   */
+  static Logger& instance();
+
+  /**
+   * @brief Parses a level name
+   *
+   * @param name "DEBUG", "INFO", "WARN", "ERROR" or "OFF"
+   * @return Level
+   *
+   * @throws std::invalid_argument if name is not a level
+   */
+  static LogLevel parseLevel(const std::string& name);
+
+  /**
+   * @brief Sets the lowest level that is logged
+   */
+  void setLevel(LogLevel level) {
+    level_.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Gets the lowest level that is logged
+   */
+  LogLevel getLevel() const {
+    return static_cast<LogLevel>(level_.load(std::memory_order_relaxed));
+  }
+
+  /**
+   * @brief Checks if records of a level are logged
+   */
+  bool enabled(LogLevel level) const {
+    return static_cast<uint8_t>(level) >= level_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Sets the streams records are written to
+   *
+   * @param out Stream for DEBUG and INFO records
+   * @param err Stream for WARN and ERROR records
+   */
+  void setOutput(std::ostream* out, std::ostream* err);
+
+  /**
+   * @brief Starts the writer thread (no-op if running)
+   *
+   * @param buffer_records Ring buffer capacity per logging thread
+   */
+  void start(size_t buffer_records = DEFAULT_BUFFER_RECORDS);
+
+  /**
+   * @brief Writes every queued record and stops the writer thread
+   */
+  void stop();
+
+  /**
+   * @brief Waits until every record submitted so far has been written
+   */
+  void flush();
+
+  /**
+   * @brief Checks if the writer thread runs
+   */
+  bool isRunning() const { return running_.load(std::memory_order_acquire); }
+
+  /**
+   * @brief Captures and submits a record
+   *
+   * Does not check the level; the SIM_LOG macros do that first.
+   *
+   * @param level Severity
+   * @param format Format string with static storage duration; each "{}"
+   *               is replaced by the next argument
+   * @param args Integers, floating-point numbers, characters or strings
+   *             (at most LogRecord::MAX_ARGS)
+   */
+  template <typename... Args>
+  void log(LogLevel level, const char* format, const Args&... args) {
+    static_assert(sizeof...(Args) <= LogRecord::MAX_ARGS, "Too many log arguments");
+    LogRecord record;
+    record.level = level;
+    record.format = format;
+    int expand[] = {0, (capture(record, args), 0)...};
+    (void)expand;
+    submit(record);
+  }
+
+  /**
+   * @brief Formats a record as one line, without the newline
+   */
+  static std::string format(const LogRecord& record);
+
+private:
+  struct ThreadBuffer;
+
+  template <typename T>
+  static typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value &&
+                                 !std::is_same<T, char>::value>::type
+  capture(LogRecord& record, const T& value) {
+    LogArg& arg = record.args[record.count++];
+    arg.type = LogArg::Type::INT;
+    arg.i = static_cast<int64_t>(value);
+  }
+
+  template <typename T>
+  static typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type
+  capture(LogRecord& record, const T& value) {
+    LogArg& arg = record.args[record.count++];
+    arg.type = LogArg::Type::UINT;
+    arg.u = static_cast<uint64_t>(value);
+  }
+
+  template <typename T>
+  static typename std::enable_if<std::is_floating_point<T>::value>::type
+  capture(LogRecord& record, const T& value) {
+    LogArg& arg = record.args[record.count++];
+    arg.type = LogArg::Type::DOUBLE;
+    arg.d = static_cast<double>(value);
+  }
+
+  static void capture(LogRecord& record, const char& value) { captureText(record, &value, 1); }
+  static void capture(LogRecord& record, const char* value) {
+    captureText(record, value, std::strlen(value));
+  }
+  static void capture(LogRecord& record, const std::string& value) {
+    captureText(record, value.data(), value.size());
+  }
+
+  static void captureText(LogRecord& record, const char* text, size_t length);
+
+  void submit(LogRecord& record);
+  void write(const std::vector<LogRecord>& records, std::string& line);
+  void writerLoop();
+  ThreadBuffer* threadBuffer();
+
+  std::atomic<uint8_t> level_;            ///< Lowest logged level
+  std::atomic<bool> running_{false};      ///< Writer thread runs
+  std::atomic<uint64_t> sequence_{0};     ///< Next record sequence number
+  std::ostream* out_;                     ///< DEBUG and INFO stream
+  std::ostream* err_;                     ///< WARN and ERROR stream
+
+  std::mutex mutex_;                      ///< Guards the fields below and the streams
+  std::condition_variable wake_cv_;       ///< Wakes the writer
+  std::condition_variable done_cv_;       ///< Signals written records to flush()
+  bool wake_{false};                      ///< Writer has work to check
+  bool stopping_{false};                  ///< stop() was called
+  uint64_t written_{0};                   ///< Records the writer has written
+  uint64_t session_{0};                   ///< Identifies the buffers of this start()
+  size_t buffer_records_{DEFAULT_BUFFER_RECORDS};
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+  std::thread writer_;
+};
+
+} // namespace simulator
+
+/**
+ * @brief Logs a record if its level is compiled in and enabled
+ *
+ * The arguments are not evaluated when the level is disabled.
+ */
+#define SIM_LOG(level, ...)                                                         \
+  do {                                                                              \
+    if (::simulator::levelCompiledIn(level) &&                                      \
+        ::simulator::Logger::instance().enabled(level)) {                           \
+      ::simulator::Logger::instance().log(level, __VA_ARGS__);                      \
+    }                                                                               \
+  } while (0)
+
+#define SIM_LOG_DEBUG(...) SIM_LOG(::simulator::LogLevel::DEBUG, __VA_ARGS__)
+#define SIM_LOG_INFO(...) SIM_LOG(::simulator::LogLevel::INFO, __VA_ARGS__)
+#define SIM_LOG_WARN(...) SIM_LOG(::simulator::LogLevel::WARN, __VA_ARGS__)
+#define SIM_LOG_ERROR(...) SIM_LOG(::simulator::LogLevel::ERROR, __VA_ARGS__)
+
+#endif // SIMULATOR_LOGGER_HPP
@@ -0,0 +1,259 @@
+/**
+ * @file loop_monitor.hpp
+ * @brief Tick and node update durations with a slow-node watchdog
+ *
+ * This file contains the UpdateTiming filled by VirtualNode::update(), and
+ * the LoopMonitor that keeps histograms of tick and node update durations
+ * and flags nodes whose update runs over a budget.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_LOOP_MONITOR_HPP
+#define SIMULATOR_LOOP_MONITOR_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "simulator/firmware_profiler.hpp"
+#include "simulator/latency_histogram.hpp"
+
+namespace simulator {
+
+namespace firmware {
+  class FirmwareBase;
+}
+
+/**
+ * @brief Wall time of the phases of one VirtualNode::update()
+ */
+struct UpdateTiming {
+  uint64_t mesh_ns{0};    ///< painlessMesh update, with the callbacks it fires
+  uint64_t tasks_ns{0};   ///< Due firmware tasks
+  uint64_t loop_ns{0};    ///< Firmware loop()
+
+  /**
+   * @brief Gets the length of the whole update
+   */
+  uint64_t totalNs() const { return mesh_ns + tasks_ns + loop_ns; }
+
+  /**
+   * @brief Gets the phase that took the longest
+   *
+   * @return ProfiledCall::MESH_UPDATE, TASKS or LOOP
+   */
+  ProfiledCall slowestPhase() const;
+
+  /**
+   * @brief Reads the clock phases are timed with
+   *
+   * @return Steady clock time in nanoseconds
+   */
+  static uint64_t nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count());
+  }
+};
+
+/**
+ * @brief Times one update phase into a field for the lifetime of the scope
+ *
+ * Does nothing, not even reading the clock, if the field is null, so
+ * untimed nodes pay one branch per phase.
+ */
+class UpdatePhaseScope {
+public:
+  explicit UpdatePhaseScope(uint64_t* field)
+    : field_(field), start_(field ? UpdateTiming::nowNs() : 0) {}
+
+  ~UpdatePhaseScope() {
+    if (field_) {
+      *field_ = UpdateTiming::nowNs() - start_;
+    }
+  }
+
+  UpdatePhaseScope(const UpdatePhaseScope&) = delete;
+  UpdatePhaseScope& operator=(const UpdatePhaseScope&) = delete;
+
+private:
+  uint64_t* field_;
+  uint64_t start_;
+};
+
+/**
+ * @brief A node whose update ran over the budget
+ */
+struct SlowNode {
+  uint32_t node_id = 0;                                 ///< Node ID
+  std::string firmware;                                 ///< Firmware name ("(none)" if none)
+  uint64_t slow_updates = 0;                            ///< Updates over the budget
+  uint64_t worst_us = 0;                                ///< Longest update
+  ProfiledCall worst_phase = ProfiledCall::MESH_UPDATE; ///< Slowest phase of the longest update
+};
+
+/**
+ * @brief Update cost of one node over a measurement window
+ */
+struct NodeCost {
+  uint32_t node_id = 0;   ///< Node ID
+  std::string firmware;   ///< Firmware name ("(none)" if none)
+  uint64_t updates = 0;   ///< Updates timed
+  uint64_t total_ns = 0;  ///< Wall time of all of them
+  uint64_t worst_ns = 0;  ///< Longest update
+};
+
+/**
+ * @brief Histograms of tick and node update durations, with a watchdog
+ *
+ * The simulation thread records the wall time of each tick with
+ * recordTick(). When a NodeManager is given the monitor, every node times
+ * the phases of its update() and the thread that ran it hands the timing
+ * to recordUpdate(). Each worker thread owns one slot, so recording takes
+ * no lock; slots are merged when read, which must only happen while no
+ * node updates.
+ *
+ * An update longer than the budget is counted against its node. The first
+ * slow update of each node is logged as a warning with the node ID,
+ * firmware and slowest phase, so one misbehaving firmware stalling the
+ * loop shows up at once without flooding the log; print() lists the
+ * slowest nodes at the end.
+ *
+ * Durations are in microseconds (the histograms' value unit).
+ *
+ * Example usage:
+ * @code
+ * LoopMonitor monitor(5000);     // Flag updates over 5 ms
+ * manager.setLoopMonitor(&monitor);
+ * ... each tick: monitor.recordTick(tick_us) ...
+ * monitor.print(std::cout, 10);
+ * @endcode
+ */
+class LoopMonitor {
+public:
+  /**
+   * @brief Construct a monitor
+   *
+   * @param update_budget_us Longest node update not flagged (0 = no watchdog)
+   */
+  explicit LoopMonitor(uint32_t update_budget_us = 0);
+
+  LoopMonitor(const LoopMonitor&) = delete;
+  LoopMonitor& operator=(const LoopMonitor&) = delete;
+
+  /**
+   * @brief Sets the number of threads recording updates
+   *
+   * Called by NodeManager with one slot per shard. Discards the update
+   * histograms and slow nodes recorded so far.
+   *
+   * @param workers Worker slots (at least 1)
+   */
+  void setWorkerCount(size_t workers);
+
+  /**
+   * @brief Records the wall time of one tick (simulation thread only)
+   *
+   * @param duration_us Tick length in microseconds
+   */
+  void recordTick(uint64_t duration_us) { ticks_.record(clampUs(duration_us)); }
+
+  /**
+   * @brief Records one node update
+   *
+   * @param worker Slot of the calling thread (below the worker count)
+   * @param node_id Node that updated
+   * @param timing Phases of the update
+   * @param firmware Firmware of the node, or nullptr; only read when the
+   *                 update was over the budget
+   */
+  void recordUpdate(size_t worker, uint32_t node_id, const UpdateTiming& timing,
+                    const firmware::FirmwareBase* firmware);
+
+  /**
+   * @brief Gets the longest node update not flagged (0 = no watchdog)
+   */
+  uint32_t getUpdateBudgetUs() const { return budget_us_; }
+
+  /**
+   * @brief Gets the tick durations
+   */
+  const LatencyHistogram& getTickHistogram() const { return ticks_; }
+
+  /**
+   * @brief Gets the node update durations of all workers
+   */
+  LatencyHistogram getUpdateHistogram() const;
+
+  /**
+   * @brief Gets the number of updates over the budget
+   */
+  uint64_t getSlowUpdateCount() const;
+
+  /**
+   * @brief Gets the nodes with updates over the budget
+   *
+   * @return Nodes by longest update, slowest first
+   */
+  std::vector<SlowNode> getSlowNodes() const;
+
+  /**
+   * @brief Starts or stops adding up the update cost of every node
+   *
+   * Discards the costs recorded so far. Call only while no node updates.
+   *
+   * @param enabled Whether recordUpdate() keeps per-node costs
+   */
+  void setNodeCosts(bool enabled);
+
+  /**
+   * @brief Checks whether per-node costs are kept
+   */
+  bool hasNodeCosts() const { return node_costs_; }
+
+  /**
+   * @brief Gets the update costs kept since setNodeCosts(true)
+   *
+   * @return Nodes by total update time, costliest first
+   */
+  std::vector<NodeCost> getNodeCosts() const;
+
+  /**
+   * @brief Prints the tick and update percentiles and the slowest nodes
+   *
+   * @param out Stream to print to
+   * @param top_nodes Slow nodes listed at most
+   */
+  void print(std::ostream& out, size_t top_nodes) const;
+
+private:
+  /**
+   * @brief Updates recorded by one thread
+   */
+  struct Worker {
+    LatencyHistogram updates;                        ///< Update durations
+    std::unordered_map<uint32_t, SlowNode> slow;     ///< Nodes over the budget
+    uint64_t slow_updates = 0;                       ///< Updates over the budget
+    std::unordered_map<uint32_t, NodeCost> costs;    ///< Per-node costs (setNodeCosts())
+  };
+
+  /// Clamps a duration to the histogram's value range
+  static uint32_t clampUs(uint64_t us) {
+    return us > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(us);
+  }
+
+  uint32_t budget_us_;                                ///< Watchdog budget (0 = off)
+  bool node_costs_{false};                            ///< Keep per-node costs
+  LatencyHistogram ticks_;                            ///< Tick durations
+  std::vector<std::unique_ptr<Worker>> workers_;      ///< One per worker thread
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_LOOP_MONITOR_HPP
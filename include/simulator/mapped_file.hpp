@@ -0,0 +1,66 @@
+/**
+ * @file mapped_file.hpp
+ * @brief Read-only memory-mapped files
+ *
+ * This file contains the MappedFile class which maps a whole file into
+ * memory for reading. Link traces and compiled scenarios use it so that
+ * pages are only loaded once they are touched.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_MAPPED_FILE_HPP
+#define SIMULATOR_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace simulator {
+
+/**
+ * @brief Read-only mapping of a whole file
+ *
+ * Example usage:
+ * @code
+ * MappedFile file("field_trace.bin");
+ * parse(file.data(), file.size());
+ * @endcode
+ */
+class MappedFile {
+public:
+  /**
+   * @brief Maps a file
+   *
+   * @param path File path
+   * @throws std::runtime_error if the file cannot be opened or mapped
+   */
+  explicit MappedFile(const std::string& path);
+
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /**
+   * @brief Gets the first mapped byte (nullptr for an empty file)
+   */
+  const unsigned char* data() const { return data_; }
+
+  /**
+   * @brief Gets the number of mapped bytes
+   */
+  size_t size() const { return size_; }
+
+private:
+  const unsigned char* data_ = nullptr;  ///< Start of the mapping
+  size_t size_ = 0;                      ///< Mapped bytes
+#ifdef _WIN32
+  void* file_ = nullptr;                 ///< File handle
+  void* mapping_ = nullptr;              ///< File mapping handle
+#endif
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_MAPPED_FILE_HPP
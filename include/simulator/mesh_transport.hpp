@@ -0,0 +1,648 @@
+/**
+ * @file mesh_transport.hpp
+ * @brief In-process mesh transport routed through the NetworkSimulator
+ *
+ * This file contains the MeshTransport class which carries mesh traffic
+ * between VirtualNodes in memory instead of over loopback TCP sockets.
+ * Every hop is passed through NetworkSimulator so configured latency,
+ * packet loss, bandwidth limits and dropped connections apply to it.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_MESH_TRANSPORT_HPP
+#define SIMULATOR_MESH_TRANSPORT_HPP
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "simulator/network_simulator.hpp"
+#include "simulator/payload.hpp"
+
+namespace simulator {
+
+class TopologyListener;
+
+/**
+ * @brief Transport-level frame types
+ */
+enum class FrameType : uint8_t {
+  SINGLE = 1,      ///< Unicast frame routed hop-by-hop to one destination
+  BROADCAST = 2    ///< Broadcast frame flooded along a spanning tree
+};
+
+/**
+ * @brief Transport statistics
+ */
+struct TransportStats {
+  uint64_t frames_sent = 0;           ///< Frames originated by nodes
+  uint64_t frames_forwarded = 0;      ///< Frames relayed by intermediate nodes
+  uint64_t frames_delivered = 0;      ///< Frames handed to a receiving node
+  uint64_t frames_dropped = 0;        ///< Frames with no route or no receiver
+};
+
+/**
+ * @brief In-process mesh transport between virtual nodes
+ *
+ * MeshTransport replaces the loopback TCP connections between nodes with
+ * an in-memory link graph. Nodes attach an Endpoint (their receive and
+ * connection callbacks); links are added in place of TCP connects.
+ *
+ * Each hop is enqueued on the NetworkSimulator with enqueueMessage() and
+ * picked up again in update() via drainReady(), so mesh traffic is
+ * subject to the simulated link conditions. Unicast frames follow the
+ * shortest path to their destination; broadcasts follow the shortest-path
+ * tree rooted at the originating node, so every node receives a broadcast
+ * exactly once even if the link graph has cycles.
+ *
+ * The trees play the part of painlessMesh's routing tables. Each is built
+ * by breadth-first search on first use and cached; a link or attachment
+ * change drops only the cached trees whose search it would change (e.g.
+ * a link outside a tree, or between two nodes at the same depth, changes
+ * nothing), so churn in one corner of a large mesh does not rebuild the
+ * routes of the rest.
+ *
+ * Example usage:
+ * @code
+ * NetworkSimulator network;
+ * MeshTransport transport(network);
+ *
+ * MeshTransport::Endpoint endpoint;
+ * endpoint.onReceive = [](uint32_t from, const Payload& msg) { ... };
+ * transport.attach(1001, endpoint);
+ * transport.attach(1002, endpoint);
+ * transport.addLink(1001, 1002);
+ *
+ * transport.sendSingle(1001, 1002, "Hello");
+ * transport.update(clock.nowMs());
+ * @endcode
+ *
+ * @note MeshTransport is not thread-safe. All operations should be called
+ *       from the simulation thread, except concurrent getReachableNodes()
+ *       calls while nothing else runs.
+ */
+class MeshTransport {
+public:
+  /// Callback for messages delivered to a node; the payload shares the
+  /// frame buffer with every other receiver of the same message
+  using ReceiveCallback = std::function<void(uint32_t from, const Payload& msg)>;
+  /// Callback for a new direct link to a node
+  using NewConnectionCallback = std::function<void(uint32_t nodeId)>;
+  /// Callback for topology changes seen by a node
+  using ChangedConnectionsCallback = std::function<void()>;
+  /// Callback seeing every frame delivered to a node, before the node does
+  using FrameTap = std::function<void(uint32_t from, bool broadcast, const Payload& msg)>;
+  /// Callback seeing every frame delivered to any node; true keeps it from the node
+  using FrameFilter = std::function<bool(uint32_t node, uint32_t from, const Payload& msg)>;
+
+  /**
+   * @brief Callbacks a node registers with the transport
+   */
+  struct Endpoint {
+    ReceiveCallback onReceive;                        ///< Message delivery
+    NewConnectionCallback onNewConnection;            ///< New direct link
+    ChangedConnectionsCallback onChangedConnections;  ///< Topology change
+    bool remote{false};                               ///< Hosted by another process
+  };
+
+  /**
+   * @brief Size of the frame header prepended to every payload
+   *
+   * The header carries the frame type, originating node and final
+   * destination. It counts against simulated bandwidth like the JSON
+   * envelope of a real painlessMesh package would.
+   */
+  static constexpr size_t FRAME_HEADER_SIZE = 9;
+
+  /**
+   * @brief Construct a transport on top of a network simulator
+   *
+   * @param network Network simulator carrying every hop
+   *
+   * The network simulator must outlive the transport.
+   */
+  explicit MeshTransport(NetworkSimulator& network);
+
+  // Prevent copying
+  MeshTransport(const MeshTransport&) = delete;
+  MeshTransport& operator=(const MeshTransport&) = delete;
+
+  // Endpoints
+
+  /**
+   * @brief Attaches a node to the transport
+   *
+   * Attached nodes can send, receive and relay frames. Re-attaching a
+   * node replaces its callbacks.
+   *
+   * @param nodeId Node identifier (must be non-zero)
+   * @param endpoint Node callbacks
+   *
+   * @throws std::invalid_argument if nodeId is 0
+   */
+  void attach(uint32_t nodeId, const Endpoint& endpoint);
+
+  /**
+   * @brief Detaches a node from the transport
+   *
+   * The node's links are kept, but it no longer receives or relays
+   * frames until attached again (e.g. after a restart). Frames in flight
+   * towards it are dropped on arrival.
+   *
+   * @param nodeId Node identifier
+   */
+  void detach(uint32_t nodeId);
+
+  /**
+   * @brief Checks whether a node is attached
+   *
+   * @param nodeId Node identifier
+   * @return true if the node is attached
+   */
+  bool isAttached(uint32_t nodeId) const;
+
+  /**
+   * @brief Gets the number of attached nodes, remote ones included
+   */
+  size_t getAttachedCount() const { return endpoints_.size(); }
+
+  /**
+   * @brief Attaches a node hosted by another process
+   *
+   * Remote nodes take part in routing like attached ones, so frames can
+   * be addressed to and relayed through them, but they have no callbacks
+   * here. Frames towards them must be claimed by the network simulator's
+   * egress filter; any that reach this transport are dropped.
+   *
+   * @param nodeId Node identifier (must be non-zero)
+   *
+   * @throws std::invalid_argument if nodeId is 0
+   */
+  void attachRemote(uint32_t nodeId);
+
+  /**
+   * @brief Checks whether a node is attached as a remote node
+   *
+   * @param nodeId Node identifier
+   * @return true if attachRemote() was called for the node
+   */
+  bool isRemote(uint32_t nodeId) const;
+
+  /**
+   * @brief Removes a node and all of its links
+   *
+   * @param nodeId Node identifier
+   */
+  void removeNode(uint32_t nodeId);
+
+  // Links
+
+  /**
+   * @brief Adds a bidirectional link between two nodes
+   *
+   * Fires onNewConnection and onChangedConnections on both endpoints if
+   * they are attached. Adding an existing link is a no-op.
+   *
+   * @param a First node
+   * @param b Second node
+   *
+   * @throws std::invalid_argument if a == b or either ID is 0
+   */
+  void addLink(uint32_t a, uint32_t b);
+
+  /**
+   * @brief Adds many bidirectional links at once
+   *
+   * Like addLink() for each pair, but cached routes are dropped once and
+   * each attached endpoint gets a single onChangedConnections after all
+   * links are in (onNewConnection still fires once per new link). Use
+   * this to build a whole topology.
+   *
+   * @param links Node pairs to link; existing links are skipped
+   * @return Number of links added
+   *
+   * @throws std::invalid_argument if a pair links a node to itself or
+   *         either ID is 0 (no link is added then)
+   */
+  size_t addLinks(const std::vector<std::pair<uint32_t, uint32_t>>& links);
+
+  /**
+   * @brief Removes the link between two nodes
+   *
+   * @param a First node
+   * @param b Second node
+   * @return true if the link existed
+   */
+  bool removeLink(uint32_t a, uint32_t b);
+
+  /**
+   * @brief Checks whether two nodes are directly linked
+   *
+   * @param a First node
+   * @param b Second node
+   * @return true if a link exists
+   */
+  bool hasLink(uint32_t a, uint32_t b) const;
+
+  /**
+   * @brief Gets the direct neighbours of a node
+   *
+   * @param nodeId Node identifier
+   * @return Neighbour IDs in ascending order
+   */
+  std::vector<uint32_t> getNeighbours(uint32_t nodeId) const;
+
+  /**
+   * @brief Gets every link
+   *
+   * @return (a, b) pairs with a < b, in ascending order
+   */
+  std::vector<std::pair<uint32_t, uint32_t>> getLinks() const;
+
+  /**
+   * @brief Gets the number of links
+   *
+   * @return Count of bidirectional links
+   */
+  size_t getLinkCount() const { return link_count_; }
+
+  /**
+   * @brief Gets all nodes reachable from a node through attached nodes
+   *
+   * Mirrors painlessMesh::getNodeList(): the node itself is excluded.
+   * Safe to call from several threads at once while no other method runs,
+   * which is how sharded NodeManager workers use it.
+   *
+   * @param nodeId Node identifier
+   * @return Reachable node IDs in ascending order
+   */
+  std::list<uint32_t> getReachableNodes(uint32_t nodeId) const;
+
+  /**
+   * @brief Gets the next hop of a frame on its way to a node
+   *
+   * @param from Node holding the frame
+   * @param dest Final destination
+   * @return Neighbour of @p from on the shortest path to @p dest, or 0 if
+   *         there is no route (or from == dest)
+   */
+  uint32_t getNextHop(uint32_t from, uint32_t dest) const;
+
+  /**
+   * @brief Gets the number of cached shortest-path trees
+   *
+   * @return Trees built since they were last dropped by a topology change
+   */
+  size_t getCachedRouteCount() const { return route_cache_.size(); }
+
+  /**
+   * @brief Gets the smallest minimum latency over all links
+   *
+   * Any frame a node sends now reaches its first hop no earlier than this
+   * many milliseconds later, which makes it the lookahead of a
+   * conservative parallel schedule.
+   *
+   * @return Minimum of NetworkSimulator::getMinLatency() over both
+   *         directions of every link (traced links count their lowest
+   *         sample), or UINT32_MAX if there are no links
+   */
+  uint32_t getMinLinkLatency() const;
+
+  /**
+   * @brief Attaches a listener for link changes
+   *
+   * Every link added or removed afterwards is reported, including links
+   * dropped by removeNode().
+   *
+   * @param listener Listener (e.g. an open TopologyRecorder), or nullptr
+   *                 to stop reporting
+   */
+  void setTopologyListener(TopologyListener* listener) { listener_ = listener; }
+
+  /**
+   * @brief Shows every frame delivered to a node to a tap as well
+   *
+   * The tap sees the sender, the frame type and the payload of each frame
+   * handed to the node, just before its receive callback. Taps survive
+   * detach() and re-attachment, so a restarted node stays tapped.
+   *
+   * @param nodeId Node identifier
+   * @param tap Tap to install, or an empty function to remove it
+   */
+  void setFrameTap(uint32_t nodeId, FrameTap tap);
+
+  /**
+   * @brief Installs a filter seeing the frames delivered to every node
+   *
+   * The filter runs before the node's tap and receive callback, after a
+   * broadcast has been relayed on. Returning true consumes the frame: it
+   * counts as delivered, but the node never sees it. Used to carry
+   * synthetic traffic that no firmware should handle.
+   *
+   * @param filter Filter to install, or an empty function to remove it
+   */
+  void setFrameFilter(FrameFilter filter) { filter_ = std::move(filter); }
+
+  // Traffic
+
+  /**
+   * @brief Sends a message to a single node
+   *
+   * @param from Sending node (must be attached)
+   * @param dest Destination node
+   * @param msg Message payload
+   * @return true if a route exists and the first hop was enqueued
+   */
+  bool sendSingle(uint32_t from, uint32_t dest, const std::string& msg);
+
+  /**
+   * @brief Sends a message to a single node as of a given time
+   *
+   * Used to replay sends collected during a lookahead window. The time
+   * may be earlier than the last update() as long as the frame cannot
+   * arrive before that update.
+   *
+   * @param from Sending node (must be attached)
+   * @param dest Destination node
+   * @param msg Message payload
+   * @param sendTime Simulated send time in milliseconds
+   * @return true if a route exists and the first hop was enqueued
+   */
+  bool sendSingle(uint32_t from, uint32_t dest, const std::string& msg, uint64_t sendTime);
+
+  /**
+   * @brief Encodes a message once for repeated sendSingleFrame() calls
+   *
+   * @param from Sending node
+   * @param dest Destination node
+   * @param msg Message payload
+   * @return Frame to pass to sendSingleFrame()
+   */
+  static Payload encodeSingle(uint32_t from, uint32_t dest, const std::string& msg);
+
+  /**
+   * @brief Sends a frame from encodeSingle() as of a given time
+   *
+   * @param from Sending node (must be attached)
+   * @param frame Frame encoded for @p from; shared, not copied
+   * @param sendTime Simulated send time in milliseconds (see sendSingle())
+   * @return true if a route exists and the first hop was enqueued
+   * @throws std::invalid_argument if @p frame is not a unicast frame of @p from
+   */
+  bool sendSingleFrame(uint32_t from, const Payload& frame, uint64_t sendTime);
+
+  /**
+   * @brief Broadcasts a message to every reachable node
+   *
+   * @param from Sending node (must be attached)
+   * @param msg Message payload
+   * @return true if the sender is attached
+   */
+  bool sendBroadcast(uint32_t from, const std::string& msg);
+
+  /**
+   * @brief Broadcasts a message as of a given time
+   *
+   * @param from Sending node (must be attached)
+   * @param msg Message payload
+   * @param sendTime Simulated send time in milliseconds (see sendSingle())
+   * @return true if the sender is attached
+   */
+  bool sendBroadcast(uint32_t from, const std::string& msg, uint64_t sendTime);
+
+  /**
+   * @brief Encodes a broadcast once for repeated sendBroadcastFrame() calls
+   *
+   * The frame holds the header and the message, so sending it again
+   * neither copies the message nor rebuilds the header.
+   *
+   * @param from Sending node
+   * @param msg Message payload
+   * @return Frame to pass to sendBroadcastFrame()
+   */
+  static Payload encodeBroadcast(uint32_t from, const std::string& msg);
+
+  /**
+   * @brief Broadcasts a frame from encodeBroadcast()
+   *
+   * @param from Sending node (must be attached)
+   * @param frame Frame encoded for @p from; shared, not copied
+   * @return true if the sender is attached
+   * @throws std::invalid_argument if @p frame is not a broadcast frame of @p from
+   */
+  bool sendBroadcastFrame(uint32_t from, const Payload& frame);
+
+  /**
+   * @brief Broadcasts a frame from encodeBroadcast() as of a given time
+   *
+   * @param from Sending node (must be attached)
+   * @param frame Frame encoded for @p from; shared, not copied
+   * @param sendTime Simulated send time in milliseconds (see sendSingle())
+   * @return true if the sender is attached
+   * @throws std::invalid_argument if @p frame is not a broadcast frame of @p from
+   */
+  bool sendBroadcastFrame(uint32_t from, const Payload& frame, uint64_t sendTime);
+
+  /**
+   * @brief Collects the following sends into one batch of the network
+   *
+   * See NetworkSimulator::beginBatch(); pair with flushBatch().
+   */
+  void beginBatch() { network_.beginBatch(); }
+
+  /**
+   * @brief Evaluates the sends collected since beginBatch()
+   *
+   * @return Number of frames queued
+   */
+  size_t flushBatch() { return network_.flushBatch(); }
+
+  /**
+   * @brief Delivers and relays all frames due at the given time
+   *
+   * Should be called once per simulation tick with the simulated time.
+   * Frames sent between updates are stamped with the time of the last
+   * update. The relays and replies of all frames due are evaluated as
+   * one batch.
+   *
+   * @param currentTime Current simulated time in milliseconds
+   * @return Number of frames processed
+   */
+  size_t update(uint64_t currentTime);
+
+  /**
+   * @brief Gets the time of the last update
+   *
+   * @return Simulated time in milliseconds
+   */
+  uint64_t getCurrentTime() const { return current_time_; }
+
+  /**
+   * @brief Gets transport statistics
+   *
+   * @return Transport counters
+   */
+  const TransportStats& getStats() const { return stats_; }
+
+  /**
+   * @brief Gets the underlying network simulator
+   *
+   * @return Reference to the network simulator
+   */
+  NetworkSimulator& getNetwork() { return network_; }
+
+  // Checkpoints
+
+  /**
+   * @brief Writes the links, time and counters to a checkpoint
+   *
+   * Frames in flight live in the network simulator's queue and are saved
+   * with it. Endpoints belong to the nodes and are not saved.
+   *
+   * @param out Checkpoint being written
+   */
+  void saveState(CheckpointWriter& out) const;
+
+  /**
+   * @brief Restores the state written by saveState()
+   *
+   * Replaces all links without firing connection callbacks: the restored
+   * firmware state already reflects them.
+   *
+   * @param in Checkpoint being read
+   *
+   * @throws std::runtime_error if the checkpoint is malformed
+   */
+  void loadState(CheckpointReader& in);
+
+private:
+  /// Parent of each node on its shortest path towards a root node
+  using ParentMap = std::map<uint32_t, uint32_t>;
+  /// Children of each relaying node in the broadcast tree of a root node
+  using ChildMap = std::map<uint32_t, std::vector<uint32_t>>;
+
+  NetworkSimulator& network_;                                   ///< Simulated link layer
+  std::map<uint32_t, std::shared_ptr<Endpoint>> endpoints_;     ///< Attached nodes
+  std::map<uint32_t, std::set<uint32_t>> links_;                ///< Adjacency sets
+  size_t link_count_{0};                                        ///< Number of links
+  mutable std::map<uint32_t, ParentMap> route_cache_;           ///< Shortest-path trees by root
+  mutable std::mutex route_mutex_;                              ///< Guards concurrent tree lookups
+  mutable std::map<uint32_t, ChildMap> fanout_cache_;           ///< Broadcast relay lists by origin
+  uint64_t current_time_{0};                                    ///< Time of last update (ms)
+  TransportStats stats_;                                        ///< Transport counters
+  TopologyListener* listener_{nullptr};                         ///< Told about link changes (optional)
+  std::unordered_map<uint32_t, FrameTap> taps_;                 ///< Frame taps by node
+  FrameFilter filter_;                                          ///< Sees every delivery (optional)
+  bool domains_dirty_{true};                                    ///< Links changed since the last syncDomains()
+
+  /**
+   * @brief Gets the shortest-path tree rooted at a node
+   *
+   * Computed by breadth-first search over attached nodes and cached until
+   * the topology or the set of attached nodes changes.
+   *
+   * @param root Root node
+   * @return Parent of every reachable node (root maps to itself)
+   */
+  const ParentMap& getTree(uint32_t root) const;
+
+  /**
+   * @brief Gets the relay lists of the broadcast tree rooted at a node
+   *
+   * Derived from getTree() and cached with it, so relaying a broadcast
+   * is one lookup instead of a check of every neighbour.
+   *
+   * @param origin Originating node of the broadcasts
+   * @return Children of every node with children, in ascending order
+   */
+  const ChildMap& getBroadcastChildren(uint32_t origin) const;
+
+  /**
+   * @brief Invalidates all cached shortest-path trees
+   */
+  void invalidateRoutes() {
+    route_cache_.clear();
+    fanout_cache_.clear();
+    domains_dirty_ = true;
+  }
+
+  /**
+   * @brief Drops the cached trees a link change alters
+   *
+   * Called after the link is added to or removed from links_.
+   *
+   * @param a First node
+   * @param b Second node
+   * @param added true if the link was added, false if removed
+   */
+  void updateRoutesForLink(uint32_t a, uint32_t b, bool added);
+
+  /**
+   * @brief Drops or patches the cached trees an attachment change alters
+   *
+   * Called after the node is added to or erased from endpoints_. A
+   * detached leaf is cut out of the trees in place.
+   *
+   * @param node Node attached or detached
+   * @param attached true if the node was attached, false if detached
+   */
+  void updateRoutesForNode(uint32_t node, bool attached);
+
+  /**
+   * @brief Drops every cached tree (and its relay lists) a predicate selects
+   *
+   * @param changed Called as changed(root, tree); returns true to drop
+   */
+  template <typename Changed>
+  void dropRoutesIf(Changed changed);
+
+  /**
+   * @brief Passes changed links on as the collision domains of the medium
+   *
+   * Rebuilds the domains at most once per topology change, and only when
+   * the network models airtime.
+   */
+  void syncDomains() {
+    if (domains_dirty_ && network_.getAirtime().isEnabled()) {
+      network_.setNeighbours(links_);
+      domains_dirty_ = false;
+    }
+  }
+
+  /**
+   * @brief Builds a frame from header fields and payload
+   */
+  static Payload encodeFrame(FrameType type, uint32_t origin, uint32_t dest,
+                             const std::string& payload);
+
+  /**
+   * @brief Relays a broadcast frame to the children of a node
+   *
+   * @param node Node relaying the frame
+   * @param origin Originating node of the broadcast
+   * @param frame Encoded frame
+   * @param now Simulated time of the relay in milliseconds
+   * @return Number of hops enqueued
+   */
+  size_t forwardBroadcast(uint32_t node, uint32_t origin, const Payload& frame,
+                          uint64_t now);
+
+  /**
+   * @brief Handles one frame arriving at a node
+   */
+  void handleFrame(const DelayedMessage& hop);
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_MESH_TRANSPORT_HPP
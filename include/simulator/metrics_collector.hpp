@@ -0,0 +1,311 @@
+/**
+ * @file metrics_collector.hpp
+ * @brief Periodic metrics snapshots streamed to CSV, JSON and binary files
+ *
+ * This file contains the MetricsCollector class which samples node and
+ * network counters at each metrics interval of virtual time and hands the
+ * snapshots to a background writer thread.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_METRICS_COLLECTOR_HPP
+#define SIMULATOR_METRICS_COLLECTOR_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "simulator/config_loader.hpp"
+#include "simulator/network_simulator.hpp"
+
+namespace simulator {
+
+class NodeManager;
+class MeshTransport;
+class ConnectivityTracker;
+
+/**
+ * @brief One sample of every collected column
+ *
+ * Node values are stored column by column: column c of the node at index i
+ * is node_values[c * node_ids.size() + i].
+ */
+struct MetricsSnapshot {
+  uint64_t time_us = 0;                  ///< Virtual time of the sample
+  std::vector<uint32_t> node_ids;        ///< Sampled nodes in storage order
+  std::vector<uint64_t> node_values;     ///< Per-node values, column-major
+  std::vector<double> network_values;    ///< One value per network column
+};
+
+/**
+ * @brief Samples metrics at fixed virtual-time intervals and streams them
+ *
+ * MetricsConfig::collect selects the columns by group or by column name
+ * (all columns when the list is empty):
+ *
+ * | Group | Node columns | Network columns |
+ * |-------|--------------|-----------------|
+ * | message_count | messages_sent, messages_received | messages_sent, messages_received |
+ * | packet_stats | bytes_sent, bytes_received | frames_sent, frames_forwarded, frames_delivered, frames_dropped, pending_messages |
+ * | delivery_rate | | delivery_rate |
+ * | latency_stats | | latency_samples, latency_min_ms, latency_p50_ms, latency_p95_ms, latency_p99_ms, latency_max_ms |
+ * | node_uptime | running, uptime_ms, crash_count | nodes_running |
+ * | connectivity | component | components |
+ * | link_stats | | link_messages, link_delivered, link_dropped, link_throttled, link_bytes, link_latency_avg_ms, active_links |
+ *
+ * Network message counts are totals over all nodes; delivery_rate is the
+ * share of transport frames that reached a receiver. Connectivity comes
+ * from the ConnectivityTracker set with setConnectivityTracker():
+ * component is the smallest node ID in the node's connected component (0
+ * while stopped) and components the number of components; both are 0
+ * without a tracker. Link columns count the NetworkSimulator's link
+ * statistics since the previous sample, from the deltas of
+ * NetworkSimulator::snapshotStats(); active_links is the number of links
+ * that carried or lost a message in the interval.
+ *
+ * Each export format streams to its own file next to the output base
+ * path (MetricsConfig::output without a .csv, .json or .pmm extension):
+ * - csv: base.csv (one row per node and sample) and base_network.csv
+ *   (one row per sample)
+ * - json: base.json, one JSON object per sample and line, with node
+ *   values as columns
+ * - binary: base.pmm, a columnar file of raw little-endian arrays (see
+ *   MetricsCollector::BINARY_MAGIC)
+ * - topology and graphviz: written by TopologyRecorder, not here
+ *
+ * sample() fills one of two snapshot buffers on the simulation thread and
+ * swaps it with the other, which the writer thread formats and writes. The
+ * buffers keep their capacity, so steady-state sampling does not allocate,
+ * and the simulation thread only waits when the writer is still busy with
+ * the previous interval's snapshot.
+ *
+ * Example usage:
+ * @code
+ * MetricsCollector metrics(config.metrics);
+ * metrics.open();
+ * while (running) {
+ *   if (clock.nowUs() >= metrics.getNextSampleUs()) {
+ *     metrics.sample(clock.nowUs(), manager, network, &transport);
+ *   }
+ *   ...
+ * }
+ * metrics.close();
+ * @endcode
+ */
+class MetricsCollector {
+public:
+  /// Magic at the start of a binary metrics file
+  static constexpr char BINARY_MAGIC[8] = {'P', 'M', 'M', 'E', 'T', 'R', '0', '1'};
+
+  /// Binary metrics format version
+  static constexpr uint32_t BINARY_VERSION = 1;
+
+  /**
+   * @brief Checks if a name is an export format accepted in export
+   */
+  static bool isKnownFormat(const std::string& name) {
+    return name == "csv" || name == "json" || name == "binary" || name == "topology" ||
+           name == "graphviz";
+  }
+
+  /**
+   * @brief Gets the output base path for an output setting
+   *
+   * @param output MetricsConfig::output
+   * @return output without a trailing .csv, .json or .pmm
+   */
+  static std::string basePath(const std::string& output);
+
+  /**
+   * @brief Creates every missing directory on the path to a file
+   *
+   * @param file File path; its last component is not created
+   *
+   * @throws std::runtime_error if a directory cannot be created
+   */
+  static void makeParentDirectories(const std::string& file);
+
+  /**
+   * @brief Construct a collector
+   *
+   * @param config Metrics configuration
+   *
+   * Names in MetricsConfig::collect that are neither a group nor a column
+   * are ignored with a warning.
+   *
+   * @throws std::invalid_argument if the output is empty, the interval is
+   *         zero, or an export format is unknown
+   */
+  explicit MetricsCollector(const MetricsConfig& config);
+
+  /**
+   * @brief Destructor; closes the files
+   */
+  ~MetricsCollector();
+
+  MetricsCollector(const MetricsCollector&) = delete;
+  MetricsCollector& operator=(const MetricsCollector&) = delete;
+
+  /**
+   * @brief Creates the output files, writes their headers and starts the
+   *        writer thread
+   *
+   * Missing parent directories of the output path are created.
+   *
+   * @throws std::runtime_error if a file cannot be created
+   */
+  void open();
+
+  /**
+   * @brief Takes a snapshot and hands it to the writer
+   *
+   * @param time_us Virtual time of the sample
+   * @param manager Nodes to sample
+   * @param network Network simulator to sample
+   * @param transport In-process transport, or nullptr (frame columns are 0)
+   */
+  void sample(uint64_t time_us, const NodeManager& manager, const NetworkSimulator& network,
+              const MeshTransport* transport);
+
+  /**
+   * @brief Sets the source of the connectivity columns
+   *
+   * @param tracker Tracker fed with the run's topology changes, or nullptr
+   *                (the columns are 0)
+   */
+  void setConnectivityTracker(ConnectivityTracker* tracker) { connectivity_ = tracker; }
+
+  /**
+   * @brief Hands a snapshot taken elsewhere to the writer
+   *
+   * @param snapshot Snapshot with the collector's columns; receives the
+   *                 buffer of an earlier snapshot in exchange
+   */
+  void submit(MetricsSnapshot& snapshot);
+
+  /**
+   * @brief Writes pending snapshots, finishes the files and stops the
+   *        writer thread (no-op if not open)
+   */
+  void close();
+
+  /**
+   * @brief Gets the virtual time of the next due sample
+   */
+  uint64_t getNextSampleUs() const { return next_sample_us_; }
+
+  /**
+   * @brief Gets the sampling interval
+   */
+  uint64_t getIntervalUs() const { return interval_us_; }
+
+  /**
+   * @brief Gets the per-node column names
+   */
+  const std::vector<std::string>& getNodeColumns() const { return node_column_names_; }
+
+  /**
+   * @brief Gets the network column names
+   */
+  const std::vector<std::string>& getNetworkColumns() const { return network_column_names_; }
+
+  /**
+   * @brief Gets the paths of the files being written
+   */
+  const std::vector<std::string>& getFiles() const { return files_; }
+
+  /**
+   * @brief Gets the number of snapshots taken
+   */
+  uint64_t getSampleCount() const { return samples_; }
+
+  /**
+   * @brief Gets how often sample() had to wait for the writer
+   */
+  uint64_t getStallCount() const { return stalls_; }
+
+private:
+  /// Source of a per-node column
+  enum class NodeColumn : uint8_t {
+    MESSAGES_SENT, MESSAGES_RECEIVED, BYTES_SENT, BYTES_RECEIVED,
+    RUNNING, UPTIME_MS, CRASH_COUNT, COMPONENT
+  };
+
+  /// Source of a network column
+  enum class NetworkColumn : uint8_t {
+    MESSAGES_SENT, MESSAGES_RECEIVED, FRAMES_SENT, FRAMES_FORWARDED, FRAMES_DELIVERED,
+    FRAMES_DROPPED, PENDING_MESSAGES, DELIVERY_RATE, LATENCY_SAMPLES, LATENCY_MIN_MS,
+    LATENCY_P50_MS, LATENCY_P95_MS, LATENCY_P99_MS, LATENCY_MAX_MS, NODES_RUNNING,
+    COMPONENTS, LINK_MESSAGES, LINK_DELIVERED, LINK_DROPPED, LINK_THROTTLED, LINK_BYTES,
+    LINK_LATENCY_AVG_MS, ACTIVE_LINKS
+  };
+
+  /// One column and its name
+  template <typename Column>
+  struct ColumnName {
+    Column column;
+    const char* name;
+  };
+
+  /// A metric group and its columns
+  struct MetricGroup {
+    const char* name;
+    std::vector<ColumnName<NodeColumn>> node_columns;
+    std::vector<ColumnName<NetworkColumn>> network_columns;
+  };
+
+  static const MetricGroup METRIC_GROUPS[];
+
+  std::ofstream openFile(const std::string& path);
+  void writerLoop();
+  void write(const MetricsSnapshot& snapshot);
+  void writeCsv(const MetricsSnapshot& snapshot);
+  void writeJson(const MetricsSnapshot& snapshot);
+  void writeBinary(const MetricsSnapshot& snapshot);
+
+  std::string base_;                                 ///< Output path without extension
+  uint64_t interval_us_;                             ///< Sampling interval
+  uint64_t next_sample_us_{0};                       ///< Next due sample
+  bool csv_{false};                                  ///< Write base.csv and base_network.csv
+  bool json_{false};                                 ///< Write base.json
+  bool binary_{false};                               ///< Write base.pmm
+  std::vector<NodeColumn> node_columns_;
+  std::vector<std::string> node_column_names_;
+  std::vector<NetworkColumn> network_columns_;
+  std::vector<std::string> network_column_names_;
+  std::vector<std::string> files_;                   ///< Paths of open files
+  uint64_t samples_{0};                              ///< Snapshots taken
+  uint64_t stalls_{0};                               ///< Waits for the writer
+  ConnectivityTracker* connectivity_{nullptr};       ///< Source of connectivity columns
+  bool link_columns_{false};                         ///< A link_stats column is collected
+  NetworkSimulator::LinkStatsColumns links_;         ///< Link counters at the last sample
+  NetworkSimulator::LinkStatsColumns link_delta_;    ///< Change since the sample before
+
+  std::ofstream csv_nodes_;
+  std::ofstream csv_network_;
+  std::ofstream json_out_;
+  std::ofstream binary_out_;
+  std::string line_;                                 ///< Writer formatting buffer
+
+  MetricsSnapshot front_;                            ///< Filled by sample()
+  MetricsSnapshot back_;                             ///< Written by the writer thread
+  std::mutex mutex_;                                 ///< Guards the handoff fields below
+  std::condition_variable cv_;                       ///< Signals handoffs both ways
+  bool back_ready_{false};                           ///< back_ holds an unwritten snapshot
+  bool stopping_{false};                             ///< close() was called
+  bool open_{false};                                 ///< open() succeeded
+  std::exception_ptr error_;                         ///< Writer failure, rethrown by close()
+  std::thread writer_;
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_METRICS_COLLECTOR_HPP
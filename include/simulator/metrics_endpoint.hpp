@@ -0,0 +1,221 @@
+/**
+ * @file metrics_endpoint.hpp
+ * @brief Live Prometheus metrics of a running simulation over HTTP
+ *
+ * This file contains the MetricsEndpoint class which publishes snapshots
+ * of simulation progress from the simulation thread and serves the latest
+ * one in the Prometheus text format from a background HTTP server.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_METRICS_ENDPOINT_HPP
+#define SIMULATOR_METRICS_ENDPOINT_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/asio.hpp>
+
+#include "simulator/mesh_transport.hpp"
+#include "simulator/network_simulator.hpp"
+#include "simulator/triple_buffer.hpp"
+
+namespace simulator {
+
+class NodeManager;
+class EventScheduler;
+
+/**
+ * @brief One published view of simulation progress
+ */
+struct LiveSnapshot {
+  double wall_seconds = 0.0;             ///< Wall time since the endpoint was created
+  uint64_t virtual_us = 0;               ///< Virtual time
+  uint64_t updates = 0;                  ///< Node update ticks performed
+  double tick_rate = 0.0;                ///< Ticks per wall second since the previous snapshot
+  double time_ratio = 0.0;               ///< Virtual seconds per wall second, same period
+  uint64_t nodes = 0;                    ///< Nodes created
+  uint64_t nodes_running = 0;            ///< Nodes running
+  uint64_t nodes_sleeping = 0;           ///< Running nodes skipped until their wake time
+  uint64_t pending_messages = 0;         ///< Messages in the network delivery queue
+  uint64_t pending_events = 0;           ///< Scenario events not yet run
+  TransportStats frames;                 ///< In-process transport counters
+  std::vector<NetworkSimulator::LinkCounters> links;  ///< Links with statistics
+  std::vector<uint64_t> link_latency;    ///< Cumulative latency counts, LATENCY_BOUND_COUNT per link
+};
+
+/**
+ * @brief Serves live simulation metrics in the Prometheus text format
+ *
+ * The simulation thread calls publish() whenever isDue() says a publish
+ * interval of wall time has passed. publish() fills a snapshot slot of a
+ * TripleBuffer and releases it with one atomic exchange, so it never waits
+ * for a scrape. The HTTP server thread takes the latest snapshot the same
+ * way and formats it, so scrapes cost the simulation nothing beyond the
+ * periodic snapshot.
+ *
+ * GET /metrics returns:
+ *
+ * | Metric | Type | Description |
+ * |--------|------|-------------|
+ * | painlessmesh_sim_wall_seconds | gauge | Wall time since start |
+ * | painlessmesh_sim_virtual_seconds | gauge | Virtual time |
+ * | painlessmesh_sim_updates_total | counter | Node update ticks |
+ * | painlessmesh_sim_tick_rate | gauge | Ticks per wall second |
+ * | painlessmesh_sim_time_ratio | gauge | Virtual seconds per wall second |
+ * | painlessmesh_sim_nodes{state} | gauge | Nodes (total, running, sleeping) |
+ * | painlessmesh_sim_queue_depth{queue} | gauge | Pending messages and events |
+ * | painlessmesh_sim_frames_total{kind} | counter | Transport frames (sent, forwarded, delivered, dropped) |
+ * | painlessmesh_sim_link_messages_total{from,to} | counter | Messages with a sampled latency |
+ * | painlessmesh_sim_link_delivered_total{from,to} | counter | Messages past packet loss |
+ * | painlessmesh_sim_link_dropped_total{from,to} | counter | Messages lost to packet loss |
+ * | painlessmesh_sim_link_throttled_total{from,to} | counter | Messages over the bandwidth limit |
+ * | painlessmesh_sim_link_bytes_total{from,to} | counter | Bytes admitted |
+ * | painlessmesh_sim_link_latency_ms{from,to} | histogram | Link latency |
+ * | painlessmesh_sim_latency_ms | histogram | Latency over all links |
+ *
+ * Tick rate and time ratio cover the period since the previous snapshot.
+ * Histogram buckets are LATENCY_BOUNDS_MS; values sharing a
+ * LatencyHistogram bucket with a bound count as at or below it.
+ *
+ * Example usage:
+ * @code
+ * MetricsEndpoint endpoint(9100);
+ * endpoint.start();
+ * while (running) {
+ *   ...
+ *   if (endpoint.isDue()) {
+ *     endpoint.publish(clock.nowUs(), updates, manager, network, &scheduler, &transport);
+ *   }
+ * }
+ * endpoint.stop();
+ * @endcode
+ */
+class MetricsEndpoint {
+public:
+  /// Number of latency histogram buckets (plus +Inf)
+  static constexpr size_t LATENCY_BOUND_COUNT = 13;
+
+  /// Upper bounds of the latency histogram buckets in milliseconds
+  static const uint32_t LATENCY_BOUNDS_MS[LATENCY_BOUND_COUNT];
+
+  /// Default wall time between snapshots
+  static constexpr uint32_t DEFAULT_PUBLISH_MS = 1000;
+
+  /**
+   * @brief Construct an endpoint listening on a port
+   *
+   * @param port TCP port on all IPv4 interfaces (0 picks a free port)
+   * @param publish_ms Wall time between snapshots in milliseconds
+   *
+   * @throws boost::system::system_error if the port cannot be bound
+   */
+  explicit MetricsEndpoint(uint16_t port, uint32_t publish_ms = DEFAULT_PUBLISH_MS);
+
+  /**
+   * @brief Destructor; stops the server
+   */
+  ~MetricsEndpoint();
+
+  MetricsEndpoint(const MetricsEndpoint&) = delete;
+  MetricsEndpoint& operator=(const MetricsEndpoint&) = delete;
+
+  /**
+   * @brief Gets the port the endpoint listens on
+   */
+  uint16_t getPort() const;
+
+  /**
+   * @brief Starts the HTTP server thread
+   */
+  void start();
+
+  /**
+   * @brief Stops the HTTP server thread (no-op if not started)
+   */
+  void stop();
+
+  /**
+   * @brief Checks if a publish interval has passed since the last snapshot
+   */
+  bool isDue() const { return std::chrono::steady_clock::now() >= next_publish_; }
+
+  /**
+   * @brief Takes a snapshot of the simulation and publishes it
+   *
+   * @param virtual_us Current virtual time
+   * @param updates Node update ticks performed so far
+   * @param manager Nodes to count
+   * @param network Network simulator to read
+   * @param scheduler Scenario events, or nullptr
+   * @param transport In-process transport, or nullptr (frame counters are 0)
+   */
+  void publish(uint64_t virtual_us, uint64_t updates, const NodeManager& manager,
+               const NetworkSimulator& network, const EventScheduler* scheduler,
+               const MeshTransport* transport);
+
+  /**
+   * @brief Gets the snapshot slot to fill for publishSnapshot()
+   *
+   * Holds an older snapshot; every field must be overwritten.
+   */
+  LiveSnapshot& nextSnapshot() { return snapshots_.back(); }
+
+  /**
+   * @brief Publishes the slot filled through nextSnapshot()
+   */
+  void publishSnapshot();
+
+  /**
+   * @brief Formats the latest published snapshot (HTTP server side)
+   *
+   * Must not be called concurrently with the running server.
+   *
+   * @return Prometheus text exposition
+   */
+  std::string scrape();
+
+  /**
+   * @brief Gets the number of snapshots published
+   */
+  uint64_t getPublishCount() const { return published_; }
+
+  /**
+   * @brief Formats a snapshot in the Prometheus text format
+   *
+   * @param snapshot Snapshot to format
+   * @param out Receives the exposition (cleared first)
+   */
+  static void render(const LiveSnapshot& snapshot, std::string& out);
+
+private:
+  class Session;
+
+  void accept();
+
+  using Clock = std::chrono::steady_clock;
+
+  std::chrono::milliseconds publish_interval_;   ///< Wall time between snapshots
+  Clock::time_point created_;                    ///< Wall time origin
+  Clock::time_point next_publish_;               ///< Next due snapshot
+  Clock::time_point last_wall_;                  ///< Wall time of the previous snapshot
+  uint64_t last_virtual_us_{0};                  ///< Virtual time of the previous snapshot
+  uint64_t last_updates_{0};                     ///< Ticks at the previous snapshot
+  uint64_t published_{0};                        ///< Snapshots published
+
+  TripleBuffer<LiveSnapshot> snapshots_;         ///< Simulation thread -> server thread
+  std::string body_;                             ///< Last formatted exposition (server thread)
+
+  boost::asio::io_context io_;
+  boost::asio::ip::tcp::acceptor acceptor_;
+  std::thread server_;
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_METRICS_ENDPOINT_HPP
@@ -14,41 +14,25 @@
 
 #include <cstdint>
 #include <string>
-#include <map>
-#include <set>
-#include <queue>
+#include <memory>
 #include <vector>
 #include <random>
 #include <functional>
+#include <utility>
+#include <unordered_map>
 #include <chrono>
 
-namespace simulator {
-
-/**
- * @brief Distribution types for latency simulation
- */
-enum class DistributionType {
-  UNIFORM,      ///< Uniform distribution (equal probability)
-  NORMAL,       ///< Normal (Gaussian) distribution
-  EXPONENTIAL   ///< Exponential distribution
-};
+#include "simulator/airtime_model.hpp"
+#include "simulator/checkpoint.hpp"
+#include "simulator/counter_rng.hpp"
+#include "simulator/delivery_queue.hpp"
+#include "simulator/gilbert_elliott.hpp"
+#include "simulator/latency_histogram.hpp"
+#include "simulator/latency_sampler.hpp"
+#include "simulator/link_table.hpp"
+#include "simulator/link_trace.hpp"
 
-/**
- * @brief Latency configuration for network connections
- */
-struct LatencyConfig {
-  uint32_t min_ms = 0;                  ///< Minimum latency in milliseconds
-  uint32_t max_ms = 100;                ///< Maximum latency in milliseconds
-  DistributionType distribution = DistributionType::UNIFORM;  ///< Distribution type
-  
-  /**
-   * @brief Validates the configuration
-   * @return true if valid, false otherwise
-   */
-  bool isValid() const {
-    return min_ms <= max_ms;
-  }
-};
+namespace simulator {
 
 /**
  * @brief Packet loss configuration for network connections
@@ -57,14 +41,20 @@ struct PacketLossConfig {
   float probability = 0.0f;             ///< Packet loss probability (0.0 to 1.0)
   bool burst_mode = false;              ///< Drop packets in bursts
   uint32_t burst_length = 3;            ///< Number of packets per burst
+  bool gilbert_elliott = false;         ///< Two-state Markov loss (replaces probability and bursts)
+  float good_to_bad = 0.0f;             ///< Gilbert-Elliott: P(GOOD -> BAD) per packet
+  float bad_to_good = 1.0f;             ///< Gilbert-Elliott: P(BAD -> GOOD) per packet
+  float loss_good = 0.0f;               ///< Gilbert-Elliott: loss probability in GOOD
+  float loss_bad = 1.0f;                ///< Gilbert-Elliott: loss probability in BAD
   
   /**
    * @brief Validates the configuration
    * @return true if valid, false otherwise
    */
   bool isValid() const {
-    return probability >= 0.0f && probability <= 1.0f &&
-           burst_length > 0;
+    auto unit = [](float p) { return p >= 0.0f && p <= 1.0f; };
+    return unit(probability) && burst_length > 0 &&
+           unit(good_to_bad) && unit(bad_to_good) && unit(loss_good) && unit(loss_bad);
   }
 };
 
@@ -85,22 +75,8 @@ struct BandwidthConfig {
   }
 };
 
-/**
- * @brief A delayed message in the network simulator
- */
-struct DelayedMessage {
-  uint32_t from;                        ///< Source node ID
-  uint32_t to;                          ///< Destination node ID
-  std::string message;                  ///< Message content
-  uint64_t deliveryTime;                ///< Delivery time in milliseconds
-  
-  /**
-   * @brief Comparison operator for priority queue (earlier delivery first)
-   */
-  bool operator>(const DelayedMessage& other) const {
-    return deliveryTime > other.deliveryTime;
-  }
-};
+class PacketCapture;
+class TopologyListener;
 
 /**
  * @brief Network simulator for realistic mesh network conditions
@@ -145,10 +121,22 @@ public:
   /**
    * @brief Constructor with seed for deterministic testing
    * 
+   * Every link draws its latency and loss samples from its own
+   * counter-based stream keyed by (seed, from, to, sample number), so a
+   * link's samples do not depend on traffic or configuration of any
+   * other link.
+   * 
    * @param seed Random seed for reproducible simulations
    */
   explicit NetworkSimulator(uint32_t seed);
   
+  /**
+   * @brief Gets the seed of the per-link random streams
+   * 
+   * @return Seed passed to the constructor, or the one drawn at random
+   */
+  uint32_t getSeed() const { return seed_; }
+  
   /**
    * @brief Sets the default latency configuration
    * 
@@ -176,15 +164,148 @@ public:
    */
   LatencyConfig getLatency(uint32_t fromNode, uint32_t toNode) const;
   
+  /**
+   * @brief Gets the lowest latency a message on a connection can get
+   * 
+   * Traced connections report the lowest latency of their trace series,
+   * the others the min_ms of their latency configuration.
+   * 
+   * @param fromNode Source node ID
+   * @param toNode Destination node ID
+   * @return Lowest latency in milliseconds
+   */
+  uint32_t getMinLatency(uint32_t fromNode, uint32_t toNode) const;
+  
   /**
    * @brief Enqueues a message with simulated latency
    * 
    * @param from Source node ID
    * @param to Destination node ID
+   * Strings convert to a Payload implicitly. Passing the same Payload to
+   * several calls (e.g. one broadcast frame to every neighbour) shares a
+   * single buffer between all queued copies.
+   * 
    * @param message Message content
    * @param currentTime Current simulation time in milliseconds
    */
-  void enqueueMessage(uint32_t from, uint32_t to, const std::string& message, uint64_t currentTime);
+  void enqueueMessage(uint32_t from, uint32_t to, Payload message, uint64_t currentTime);
+  
+  /**
+   * @brief Enqueues one message from a node to several destinations
+   * 
+   * Equivalent to calling enqueueMessage() for each destination in order
+   * (the same loss decisions, latencies and statistics), but evaluates
+   * the destinations as one batch (see beginBatch()) and pushes every
+   * delivery into the queue at once. All queued copies share the payload
+   * buffer.
+   * 
+   * @param from Source node ID
+   * @param to Destination node IDs
+   * @param count Number of destinations
+   * @param message Message content
+   * @param currentTime Current simulation time in milliseconds
+   * @return Number of deliveries queued (dropped ones excluded); 0 while
+   *         an outer batch is open, which decides their fate on flush
+   */
+  size_t enqueueMulticast(uint32_t from, const uint32_t* to, size_t count,
+                          const Payload& message, uint64_t currentTime);
+  
+  /**
+   * @brief Enqueues one message from a node to several destinations
+   * 
+   * @param from Source node ID
+   * @param to Destination node IDs
+   * @param message Message content
+   * @param currentTime Current simulation time in milliseconds
+   * @return Number of deliveries queued (dropped ones excluded); 0 while
+   *         an outer batch is open
+   */
+  size_t enqueueMulticast(uint32_t from, const std::vector<uint32_t>& to,
+                          const Payload& message, uint64_t currentTime);
+  
+  /**
+   * @brief Starts collecting sends instead of evaluating each at once
+   * 
+   * Until the matching flushBatch(), enqueueMessage() and
+   * enqueueMulticast() only record the send. flushBatch() then decides
+   * every fate in passes over arrays: links are resolved, liveness is
+   * checked, all Bernoulli loss words and all tabulated latency words are
+   * drawn in one branch-free loop each, token buckets and airtime are
+   * charged in send order, and the survivors are pushed into the queue at
+   * once. Every link stream, bucket and medium sees its sends in the same
+   * order as before, so the outcome equals sequential enqueueMessage()
+   * calls exactly; with a capture attached the sends are evaluated one by
+   * one so the records keep their order.
+   * 
+   * Batches nest; only the outermost flush evaluates. Collected sends are
+   * not yet pending, so flush before changing links or reading the queue.
+   */
+  void beginBatch() { ++batch_depth_; }
+  
+  /**
+   * @brief Ends a batch, evaluating the collected sends if it is the outermost
+   * 
+   * @return Number of deliveries queued (0 for an inner batch)
+   */
+  size_t flushBatch();
+  
+  /**
+   * @brief Checks whether sends are being collected
+   */
+  bool isBatching() const { return batch_depth_ > 0; }
+  
+  /// Claims a sampled message instead of queueing it; returns true to take it
+  using EgressFilter = std::function<bool(DelayedMessage& message)>;
+  
+  /**
+   * @brief Hands messages bound for elsewhere to the caller
+   * 
+   * Every message that passes loss and bandwidth checks and has its
+   * latency sampled is offered to the filter before it is queued. A
+   * filter returning true takes the message (it may move from it) and the
+   * message is not queued here; statistics are still recorded. Used in
+   * distributed runs, where the simulator of the sending node's process
+   * samples each link and ships frames for remote nodes to their process.
+   * 
+   * @param filter Filter to use, or an empty function to queue everything
+   */
+  void setEgressFilter(EgressFilter filter) { egress_ = std::move(filter); }
+  
+  /**
+   * @brief Records the delivery path of every message
+   * 
+   * The capture receives enqueued, dropped, disconnected, throttled and
+   * delivered messages until it is detached. The simulator does not own it.
+   * 
+   * @param capture Open capture, or nullptr to stop capturing
+   */
+  void setCapture(PacketCapture* capture) { capture_ = capture; }
+  
+  /**
+   * @brief Gets the attached capture, or nullptr
+   */
+  PacketCapture* getCapture() const { return capture_; }
+  
+  /**
+   * @brief Reports connection drops, restores and partition changes
+   * 
+   * Only actual state changes are reported, after they are applied. The
+   * simulator does not own the listener.
+   * 
+   * @param listener Listener (e.g. an open TopologyRecorder), or nullptr
+   *                 to stop reporting
+   */
+  void setTopologyListener(TopologyListener* listener) { listener_ = listener; }
+  
+  /**
+   * @brief Queues a message sampled by another simulator
+   * 
+   * The message keeps its delivery time; no loss, bandwidth or latency
+   * sampling is done and no statistics are recorded.
+   * 
+   * @param message Message to queue
+   */
+  void injectMessage(DelayedMessage message);
   
   /**
    * @brief Gets all messages ready for delivery at current time
@@ -194,6 +315,36 @@ public:
    */
   std::vector<DelayedMessage> getReadyMessages(uint64_t currentTime);
   
+  /**
+   * @brief Moves all messages ready for delivery into a caller buffer
+   * 
+   * Messages are appended to @p out; reusing the same buffer across ticks
+   * avoids allocating once its capacity has grown.
+   * 
+   * @param currentTime Current simulation time in milliseconds
+   * @param out Buffer receiving the ready messages
+   * @return Number of messages appended
+   */
+  size_t getReadyMessages(uint64_t currentTime, std::vector<DelayedMessage>& out);
+  
+  /// Visitor invoked for each delivered message by drainReady()
+  using DeliveryVisitor = std::function<void(DelayedMessage& message)>;
+  
+  /**
+   * @brief Removes all messages ready for delivery and visits each one
+   * 
+   * Messages are visited in delivery order. A tick with nothing due
+   * returns after one comparison, and delivery uses an internal buffer
+   * whose capacity is kept between calls, so steady-state delivery does
+   * not allocate. The visitor may enqueue new messages; those are visited
+   * on a later call once they become due.
+   * 
+   * @param currentTime Current simulation time in milliseconds
+   * @param visitor Called once per ready message (may move from it)
+   * @return Number of messages visited
+   */
+  size_t drainReady(uint64_t currentTime, const DeliveryVisitor& visitor);
+  
   /**
    * @brief Gets the number of messages currently in the queue
    * 
@@ -201,6 +352,64 @@ public:
    */
   size_t getPendingMessageCount() const;
   
+  /**
+   * @brief Gets the earliest time a queued message may be delivered
+   * 
+   * A lower bound: drainReady() before this time delivers nothing, so the
+   * simulation loop may skip straight to it.
+   * 
+   * @return Delivery time in milliseconds, or UINT64_MAX if the queue is empty
+   */
+  uint64_t getNextDeliveryTime() const;
+  
+  /**
+   * @brief Selects the delivery queue implementation
+   * 
+   * Pending messages are moved into the new queue, so the backend can be
+   * switched at any time.
+   * 
+   * @param backend Queue backend (HEAP or TIMING_WHEEL)
+   */
+  void setQueueBackend(QueueBackend backend);
+  
+  /**
+   * @brief Gets the delivery queue implementation in use
+   * 
+   * @return Queue backend
+   */
+  QueueBackend getQueueBackend() const { return message_queue_->backend(); }
+  
+  /**
+   * @brief Enables per-link coalescing of queued messages
+   * 
+   * When enabled, a message whose link already has a queued message due
+   * in the same millisecond joins that entry instead of taking its own
+   * queue slot; the drain expands the entry again, in send order. Each
+   * message still draws its own latency and loss, so which messages
+   * arrive, their times and statistics are unchanged; bursts of frames
+   * on one link cost one queue push and pop. Off by default.
+   * 
+   * Messages of one link keep their send order, but equal-time messages
+   * of different links may be reordered: a coalesced message is drained
+   * with its entry, ahead of other links' messages sent between them
+   * (sends A1, B1, A2 drain as A1, A2, B1).
+   * 
+   * @param enabled true to coalesce
+   */
+  void setCoalescing(bool enabled) { coalesce_ = enabled; }
+  
+  /**
+   * @brief Check if per-link coalescing is enabled
+   */
+  bool isCoalescing() const { return coalesce_; }
+  
+  /**
+   * @brief Gets the number of messages that joined another's queue entry
+   * 
+   * @return Messages coalesced since construction
+   */
+  uint64_t getCoalescedCount() const { return coalesced_count_; }
+  
   /**
    * @brief Clears all pending messages
    */
@@ -217,6 +426,10 @@ public:
     uint32_t min_latency_ms = 0;       ///< Minimum observed latency
     uint32_t max_latency_ms = 0;       ///< Maximum observed latency
     uint32_t avg_latency_ms = 0;       ///< Average latency
+    uint32_t p50_latency_ms = 0;       ///< Median latency
+    uint32_t p95_latency_ms = 0;       ///< 95th percentile latency
+    uint32_t p99_latency_ms = 0;       ///< 99th percentile latency
+    uint32_t p999_latency_ms = 0;      ///< 99.9th percentile latency
     uint64_t message_count = 0;        ///< Number of messages
     uint64_t dropped_count = 0;        ///< Number of dropped packets
     uint64_t delivered_count = 0;      ///< Number of delivered packets
@@ -235,6 +448,104 @@ public:
    */
   LatencyStats getStats(uint32_t fromNode, uint32_t toNode) const;
   
+  /**
+   * @brief Gets the latency histogram of a connection
+   * 
+   * @param fromNode Source node ID
+   * @param toNode Destination node ID
+   * @return Copy of the histogram (empty if nothing was delivered)
+   */
+  LatencyHistogram getLatencyHistogram(uint32_t fromNode, uint32_t toNode) const;
+  
+  /**
+   * @brief Gets the latency histogram over all connections
+   * 
+   * Merges the per-link histograms, so the cost is proportional to the
+   * number of links with traffic. Intended for reports, not per tick.
+   * 
+   * @return Histogram of every recorded latency
+   */
+  LatencyHistogram getGlobalLatencyHistogram() const;
+  
+  /**
+   * @brief Raw counters of one link, for live reporting
+   */
+  struct LinkCounters {
+    uint32_t from = 0;                 ///< Source node ID
+    uint32_t to = 0;                   ///< Destination node ID
+    uint64_t message_count = 0;        ///< Messages with a sampled latency
+    uint64_t delivered_count = 0;      ///< Messages past packet loss
+    uint64_t dropped_count = 0;        ///< Messages lost to packet loss
+    uint64_t bandwidth_throttled = 0;  ///< Messages over the bandwidth limit
+    uint64_t bytes_sent = 0;           ///< Bytes admitted
+    uint64_t total_latency_ms = 0;     ///< Sum of sampled latencies
+  };
+  
+  /**
+   * @brief Visitor for forEachLinkStats(); the histogram is nullptr until
+   *        the link has a latency
+   */
+  using LinkStatsVisitor = std::function<void(const LinkCounters& counters,
+                                              const LatencyHistogram* histogram)>;
+  
+  /**
+   * @brief Visits every link with statistics
+   * 
+   * Unlike getStats() nothing is derived, so the cost is one copy of the
+   * counters per link.
+   * 
+   * @param visitor Called once per link with statistics
+   * @return Number of links visited
+   */
+  size_t forEachLinkStats(const LinkStatsVisitor& visitor) const;
+  
+  /**
+   * @brief Counters of every link as columns, filled by snapshotStats()
+   * 
+   * Row i holds the link with dense index i. Links are never removed, so
+   * a row keeps its link across snapshots of the same simulator and a
+   * later snapshot only appends rows; rows of links without statistics
+   * are zero. Owned by the caller and reused, so a snapshot allocates
+   * only when links were added.
+   */
+  struct LinkStatsColumns {
+    std::vector<uint32_t> from;                 ///< Source node ID
+    std::vector<uint32_t> to;                   ///< Destination node ID
+    std::vector<uint64_t> message_count;        ///< Messages with a sampled latency
+    std::vector<uint64_t> delivered_count;      ///< Messages past packet loss
+    std::vector<uint64_t> dropped_count;        ///< Messages lost to packet loss
+    std::vector<uint64_t> bandwidth_throttled;  ///< Messages over the bandwidth limit
+    std::vector<uint64_t> bytes_sent;           ///< Bytes admitted
+    std::vector<uint64_t> total_latency_ms;     ///< Sum of sampled latencies
+    uint64_t stats_epoch = 0;                   ///< resetStats() generation of the counters
+    
+    /**
+     * @brief Gets the number of rows
+     */
+    size_t size() const { return from.size(); }
+    
+    /**
+     * @brief Resizes every column; new rows are zero
+     */
+    void resize(size_t rows);
+  };
+  
+  /**
+   * @brief Copies the counters of every link into columns
+   * 
+   * One linear pass over the dense link records, without map lookups or
+   * derived values (see getStats() for percentiles and utilization).
+   * With @p delta, each row of @p delta is set to the change since the
+   * snapshot @p out held before the call, which makes per-interval
+   * counts one subtraction per cell; after resetStats(), or on the first
+   * snapshot into @p out, the change is the full count.
+   * 
+   * @param out Columns to fill; pass the same buffer every time
+   * @param delta Columns to receive the change, or nullptr
+   * @return Number of links with statistics
+   */
+  size_t snapshotStats(LinkStatsColumns& out, LinkStatsColumns* delta = nullptr) const;
+  
   /**
    * @brief Resets all statistics
    */
@@ -258,6 +569,31 @@ public:
    */
   void setPacketLoss(uint32_t fromNode, uint32_t toNode, const PacketLossConfig& config);
   
+  /**
+   * @brief Plays recorded link conditions back from a trace
+   * 
+   * Every directed link in the trace takes its latency and loss
+   * probability from the trace sample in effect at send time instead of
+   * its latency and packet loss configuration. Each link keeps a cursor
+   * into the mapped file, so playback allocates nothing per sample and
+   * advancing costs O(1). Dropped connections, partitions and bandwidth
+   * limits still apply. The simulator keeps the trace mapped until it is
+   * replaced.
+   * 
+   * @param trace Trace to play, or nullptr to return every link to its
+   *              configuration
+   */
+  void setLinkTrace(std::shared_ptr<const LinkTrace> trace);
+  
+  /**
+   * @brief Checks whether a connection plays a trace
+   * 
+   * @param fromNode Source node ID
+   * @param toNode Destination node ID
+   * @return true if latency and loss come from the link trace
+   */
+  bool isTraced(uint32_t fromNode, uint32_t toNode) const;
+  
   /**
    * @brief Gets packet loss configuration for a connection
    * 
@@ -324,6 +660,36 @@ public:
    */
   void consumeBandwidth(uint32_t from, uint32_t to, size_t messageSize, uint64_t currentTime);
   
+  /**
+   * @brief Sets the shared-medium model
+   * 
+   * With a non-zero bitrate every admitted frame also needs airtime on its
+   * sender's collision domain (see AirtimeModel): it is delayed while the
+   * medium is busy and throttled if the wait exceeds max_wait_ms.
+   * 
+   * @param config Medium parameters (bitrate 0 turns contention off)
+   * 
+   * @throws std::invalid_argument if config is invalid
+   */
+  void setAirtime(const AirtimeConfig& config);
+  
+  /**
+   * @brief Gets the shared-medium parameters
+   */
+  const AirtimeConfig& getAirtime() const { return airtime_.getConfig(); }
+  
+  /**
+   * @brief Rebuilds the collision domains from the mesh neighbours
+   * 
+   * @param neighbours Neighbours of every node, e.g. the transport's links
+   */
+  void setNeighbours(const std::map<uint32_t, std::set<uint32_t>>& neighbours);
+  
+  /**
+   * @brief Gets the shared-medium usage counters
+   */
+  AirtimeStats getAirtimeStats() const { return airtime_.getStats(); }
+  
   /**
    * @brief Drops a connection between two nodes
    * 
@@ -349,43 +715,106 @@ public:
    * @brief Restores all previously dropped connections
    * 
    * Re-enables message delivery on all connections that were
-   * previously dropped. Useful for healing network partitions.
+   * previously dropped. Useful for healing network partitions. Costs
+   * O(1) without a topology recorder: the drop epoch advances, which
+   * leaves every drop mark stale at once.
    */
   void restoreAllConnections();
   
   /**
    * @brief Checks if a connection is active (not dropped)
    * 
+   * A connection is inactive if it was dropped explicitly or if its
+   * endpoints sit in different partitions.
+   * 
    * @param from Source node ID
    * @param to Destination node ID
    * @return true if connection is active, false if dropped
    */
   bool isConnectionActive(uint32_t from, uint32_t to) const;
-
-private:
-  using ConnectionKey = std::pair<uint32_t, uint32_t>;
   
-  LatencyConfig default_latency_;                           ///< Default latency configuration
-  std::map<ConnectionKey, LatencyConfig> latency_map_;      ///< Per-connection latency config
-  std::priority_queue<DelayedMessage, 
-                      std::vector<DelayedMessage>,
-                      std::greater<DelayedMessage>> message_queue_;  ///< Message delay queue
+  /**
+   * @brief Assigns a node to a network partition
+   * 
+   * Traffic between two labelled nodes with different labels is dropped.
+   * Label 0 removes the node from partitioning, so it reaches everyone.
+   * Partitioning costs one entry per node rather than one dropped link
+   * per cross-partition pair, and explicit drops still apply on top.
+   * 
+   * @param nodeId Node ID
+   * @param partition Partition label (0 = unpartitioned)
+   */
+  void setPartition(uint32_t nodeId, uint32_t partition);
   
-  PacketLossConfig default_packet_loss_;                    ///< Default packet loss configuration
-  std::map<ConnectionKey, PacketLossConfig> packet_loss_map_;  ///< Per-connection packet loss config
+  /**
+   * @brief Gets a node's partition label
+   * 
+   * @param nodeId Node ID
+   * @return Partition label, or 0 if the node is not partitioned
+   */
+  uint32_t getPartition(uint32_t nodeId) const;
   
-  BandwidthConfig default_bandwidth_;                       ///< Default bandwidth configuration
-  std::map<ConnectionKey, BandwidthConfig> bandwidth_map_;  ///< Per-connection bandwidth config
+  /**
+   * @brief Removes every partition label
+   * 
+   * Explicitly dropped connections stay dropped.
+   */
+  void clearPartitions();
   
-  // Token bucket for bandwidth limiting
+  /**
+   * @brief Gets every explicitly dropped connection
+   * 
+   * @return (from, to) of each dropped directed link
+   */
+  std::vector<std::pair<uint32_t, uint32_t>> getDroppedConnections() const;
+  
+  /**
+   * @brief Gets every partition label
+   * 
+   * @return (node, label) pairs in ascending node order
+   */
+  std::vector<std::pair<uint32_t, uint32_t>> getPartitions() const;
+  
+  // Checkpoints
+  
+  /**
+   * @brief Writes the mutable network state to a checkpoint
+   * 
+   * Covers the default and per-link conditions, link state (drops, token
+   * buckets, loss chains, random stream positions, statistics),
+   * partitions and every queued message. Payloads shared by several
+   * queued messages (broadcast fan-out) are written once. The seed, queue
+   * backend, trace and egress filter belong to the scenario and are not
+   * included.
+   * 
+   * @param out Checkpoint being written
+   */
+  void saveState(CheckpointWriter& out) const;
+  
+  /**
+   * @brief Restores the state written by saveState()
+   * 
+   * Replaces the queue and partitions and overwrites every saved link;
+   * links only this simulator knows keep their state. Restored into a
+   * simulator with the same seed and trace, later samples continue
+   * exactly where the checkpointed run left off.
+   * 
+   * @param in Checkpoint being read
+   * 
+   * @throws std::runtime_error if the checkpoint is malformed
+   */
+  void loadState(CheckpointReader& in);
+
+private:
+  // Token bucket for bandwidth limiting, in thousandths of a token so a
+  // refill of rate * elapsed_ms is exact however short the step
   struct TokenBucket {
-    uint32_t bytes_tokens;                  ///< Available byte tokens
-    uint32_t messages_tokens;               ///< Available message tokens
-    uint64_t last_refill_time;              ///< Last refill time in milliseconds
-    uint64_t bytes_consumed;                ///< Total bytes consumed
-    uint64_t messages_consumed;             ///< Total messages consumed
+    uint64_t bytes_milli = 0;               ///< Available byte tokens (x1000)
+    uint64_t messages_milli = 0;            ///< Available message tokens (x1000)
+    uint64_t last_refill_time = 0;          ///< Last refill time in milliseconds
+    uint64_t bytes_consumed = 0;            ///< Total bytes consumed
+    uint64_t messages_consumed = 0;         ///< Total messages consumed
   };
-  std::map<ConnectionKey, TokenBucket> bandwidth_buckets_;  ///< Token buckets per connection
   
   // Statistics tracking
   struct ConnectionStats {
@@ -397,83 +826,308 @@ private:
     uint64_t delivered_count = 0;
     uint64_t bytes_sent = 0;                ///< Total bytes sent
     uint64_t bandwidth_throttled = 0;       ///< Messages throttled due to bandwidth
+    std::unique_ptr<LatencyHistogram> histogram;  ///< Allocated on first latency
   };
-  std::map<ConnectionKey, ConnectionStats> stats_map_;      ///< Connection statistics
   
   // Burst mode state tracking
   struct BurstState {
     bool in_burst = false;
     uint32_t remaining = 0;
   };
-  std::map<ConnectionKey, BurstState> burst_state_map_;     ///< Burst state per connection
   
-  // Connection state tracking
-  std::set<ConnectionKey> dropped_connections_;             ///< Set of dropped connections
+  /**
+   * @brief Complete state of one directed link
+   * 
+   * Per-link overrides, token bucket, burst and Gilbert-Elliott state, the
+   * drop mark and statistics live together so a packet touches one
+   * record.
+   */
+  struct LinkState {
+    bool has_latency = false;               ///< latency overrides the default
+    bool has_packet_loss = false;           ///< packet_loss overrides the default
+    bool has_bandwidth = false;             ///< bandwidth overrides the default
+    bool bucket_initialized = false;        ///< Token bucket has been filled
+    bool has_stats = false;                 ///< Statistics have been recorded
+    uint8_t loss_state = GilbertElliott::GOOD;  ///< Gilbert-Elliott chain state
+    uint32_t drop_epoch = 0;                ///< Dropped while equal to drop_epoch_ (0 = never)
+    LatencyConfig latency;                  ///< Latency override
+    const LatencySampler* latency_sampler = nullptr;  ///< Sampler for the override
+    PacketLossConfig packet_loss;           ///< Packet loss override
+    const GilbertElliott* loss_chain = nullptr;  ///< Chain for the override (Gilbert-Elliott only)
+    BandwidthConfig bandwidth;              ///< Bandwidth override
+    TokenBucket bucket;                     ///< Bandwidth token bucket
+    BurstState burst;                       ///< Burst loss state
+    ConnectionStats stats;                  ///< Connection statistics
+    uint64_t latency_key = 0;               ///< Latency random stream key
+    uint64_t loss_key = 0;                  ///< Packet loss random stream key
+    uint64_t latency_sequence = 0;          ///< Latency samples drawn
+    uint64_t loss_sequence = 0;             ///< Packet loss samples drawn
+    TraceCursor trace;                      ///< Trace playback (empty = untraced)
+    uint32_t trace_min_latency = 0;         ///< Lowest latency of the trace series
+    uint32_t coalesce_slot = 0;             ///< Open coalesced batch slot + 1 (0 = none)
+  };
+  
+  /**
+   * @brief Messages riding on one queue entry
+   * 
+   * The queued head carries the first message; extras hold the payloads
+   * of the later ones, which share its link and delivery time.
+   */
+  struct CoalescedBatch {
+    uint32_t link = 0;                      ///< Index into links_
+    uint64_t time = 0;                      ///< Delivery time of the batch
+    std::vector<Payload> extras;            ///< Payloads after the head's, in send order
+  };
+  
+  LatencyConfig default_latency_;                           ///< Default latency configuration
+  const LatencySampler* default_sampler_ = nullptr;         ///< Sampler for default_latency_
+  std::vector<std::unique_ptr<LatencySampler>> samplers_;   ///< One per distinct LatencyConfig
+  PacketLossConfig default_packet_loss_;                    ///< Default packet loss configuration
+  const GilbertElliott* default_chain_ = nullptr;          ///< Chain for default_packet_loss_
+  std::vector<std::unique_ptr<GilbertElliott>> chains_;    ///< One per distinct Gilbert-Elliott config
+  std::vector<PacketLossConfig> chain_configs_;             ///< Configuration of each chain
+  BandwidthConfig default_bandwidth_;                       ///< Default bandwidth configuration
+  AirtimeModel airtime_;                                    ///< Shared-medium contention
+  
+  LinkTable link_index_;                                    ///< (from, to) -> index into links_
+  std::vector<LinkState> links_;                            ///< Dense per-link state records
+  size_t dropped_link_count_{0};                            ///< Number of dropped links
+  uint64_t stats_epoch_{1};                                 ///< Bumped by resetStats()
+  uint32_t drop_epoch_{1};                                  ///< Current drop epoch (never 0)
+  std::unordered_map<uint32_t, uint32_t> partitions_;       ///< Node ID -> partition label
+  std::shared_ptr<const LinkTrace> trace_;                  ///< Mapped trace the link cursors point into
+  
+  std::unique_ptr<DeliveryQueue> message_queue_;            ///< Message delay queue
+  std::vector<DelayedMessage> ready_buffer_;                ///< Reused by drainReady()
+  bool coalesce_{false};                                    ///< Per-link coalescing enabled
+  std::vector<CoalescedBatch> coalesced_;                   ///< Batches by slot
+  std::vector<uint32_t> free_slots_;                        ///< Unused slots of coalesced_
+  size_t coalesced_pending_{0};                             ///< Queued extras in all batches
+  uint64_t coalesced_count_{0};                             ///< Messages coalesced so far
+  EgressFilter egress_;                                     ///< Claims messages for elsewhere (optional)
+  PacketCapture* capture_{nullptr};                         ///< Records the delivery path (optional)
+  TopologyListener* listener_{nullptr};                     ///< Told about topology changes (optional)
+  
+  // Sends collected between beginBatch() and flushBatch(), one column
+  // per field, plus the scratch columns of the evaluation passes
+  struct SendBatch {
+    std::vector<uint32_t> from;             ///< Source per send
+    std::vector<uint32_t> to;               ///< Destination per send
+    std::vector<uint64_t> time;             ///< Send time per send
+    std::vector<Payload> message;           ///< Payload per send
+    std::vector<uint32_t> links;            ///< Link index per send
+    std::vector<uint8_t> fate;              ///< SendFate per send
+    std::vector<uint32_t> latency;          ///< Sampled latency per send
+    std::vector<uint32_t> medium_delay;     ///< Airtime delay per send
+    std::vector<uint32_t> draws;            ///< Send index per random draw
+    std::vector<uint64_t> keys;             ///< Stream key per draw
+    std::vector<uint64_t> sequences;        ///< Stream position per draw
+    std::vector<uint64_t> random;           ///< Random word per draw
+    std::vector<float> threshold;           ///< Loss probability per draw
+    std::vector<uint32_t> sampled;          ///< Latency per draw
+    std::vector<DelayedMessage> deliveries; ///< Survivors to push
+  };
+  SendBatch batch_;
+  unsigned batch_depth_{0};                 ///< Open beginBatch() calls
   
   // Random number generation
-  std::mt19937 rng_;                                        ///< Random number generator
+  uint32_t seed_;                                           ///< Seed of the per-link streams
   
   /**
-   * @brief Calculates latency for a message based on configuration
-   * 
-   * @param config Latency configuration
-   * @return Calculated latency in milliseconds
+   * @brief Checks whether a link is explicitly dropped
    */
-  uint32_t calculateLatency(const LatencyConfig& config);
+  bool isDropped(const LinkState& link) const { return link.drop_epoch == drop_epoch_; }
   
   /**
-   * @brief Generates a random value using uniform distribution
-   * 
-   * @param min Minimum value
-   * @param max Maximum value
-   * @return Random value in range [min, max]
+   * @brief Marks a link dropped or not in the current epoch
    */
-  uint32_t uniformDistribution(uint32_t min, uint32_t max);
+  void setDropped(LinkState& link, bool dropped) { link.drop_epoch = dropped ? drop_epoch_ : 0; }
   
   /**
-   * @brief Generates a random value using normal distribution
+   * @brief Finds the state record of a link
    * 
-   * @param min Minimum value
-   * @param max Maximum value
-   * @return Random value, clamped to [min, max]
+   * @param from Source node ID
+   * @param to Destination node ID
+   * @return Pointer to the record, or nullptr if the link was never touched
    */
-  uint32_t normalDistribution(uint32_t min, uint32_t max);
+  const LinkState* findLink(uint32_t from, uint32_t to) const;
   
   /**
-   * @brief Generates a random value using exponential distribution
+   * @brief Finds or creates the state record of a link
    * 
-   * @param min Minimum value
-   * @param max Maximum value
-   * @return Random value, clamped to [min, max]
+   * @param from Source node ID
+   * @param to Destination node ID
+   * @return Reference to the record (invalidated by the next insertion)
    */
-  uint32_t exponentialDistribution(uint32_t min, uint32_t max);
+  LinkState& getOrCreateLink(uint32_t from, uint32_t to);
   
   /**
-   * @brief Records latency statistics for a connection
+   * @brief Finds or creates the state record of a link
    * 
    * @param from Source node ID
    * @param to Destination node ID
+   * @return Index of the record in links_ (stable)
+   */
+  uint32_t getOrCreateLinkIndex(uint32_t from, uint32_t to);
+  
+  /**
+   * @brief Applies dropped-connection, partition, loss, bandwidth and airtime checks to a message
+   * 
+   * Records the outcome in the link statistics and consumes bandwidth
+   * tokens and airtime when the message is admitted.
+   * 
+   * @param medium_delay_ms Set to the time the message waits for and
+   *                        occupies the medium
+   * @return true if the message should be delivered
+   */
+  bool admitMessage(uint32_t from, uint32_t to, LinkState& link,
+                    const Payload& message, uint64_t currentTime, uint32_t& medium_delay_ms);
+  
+  /**
+   * @brief Admits, samples and queues one message at once
+   * 
+   * @return true if the message was queued or claimed by the egress filter
+   */
+  bool enqueueNow(uint32_t from, uint32_t to, Payload message, uint64_t currentTime);
+  
+  /**
+   * @brief Records one send in the open batch
+   */
+  void addToBatch(uint32_t from, uint32_t to, Payload message, uint64_t currentTime);
+  
+  /**
+   * @brief Decides the fate of every collected send and queues the survivors
+   * 
+   * @return Number of deliveries queued
+   */
+  size_t evaluateBatch();
+  
+  /**
+   * @brief Records delivered messages in the capture, if one is attached
+   */
+  void captureDelivered(const DelayedMessage* messages, size_t count, uint64_t currentTime);
+  
+  /**
+   * @brief Adds a message to its link's open batch, or opens one for it
+   * 
+   * @param link_index Index of the message's link
+   * @param delayed Message about to be queued
+   * @return true if the message joined a batch and must not be queued
+   */
+  bool coalesce(uint32_t link_index, DelayedMessage& delayed);
+  
+  /**
+   * @brief Replaces drained batch heads by their messages
+   * 
+   * @param out Drained messages
+   * @param first Index of the first message of this drain in @p out
+   * @return Number of messages added
+   */
+  size_t expandCoalesced(std::vector<DelayedMessage>& out, size_t first);
+  
+  /**
+   * @brief Frees a batch slot and closes it on its link
+   */
+  void releaseSlot(uint32_t slot);
+  
+  /**
+   * @brief Drops all batches
+   */
+  void resetCoalescing();
+  
+  /**
+   * @brief Checks whether two nodes sit in different partitions
+   */
+  bool isPartitioned(uint32_t from, uint32_t to) const;
+  
+  const LatencyConfig& latencyOf(const LinkState& link) const {
+    return link.has_latency ? link.latency : default_latency_;
+  }
+  
+  const PacketLossConfig& packetLossOf(const LinkState& link) const {
+    return link.has_packet_loss ? link.packet_loss : default_packet_loss_;
+  }
+  
+  const BandwidthConfig& bandwidthOf(const LinkState& link) const {
+    return link.has_bandwidth ? link.bandwidth : default_bandwidth_;
+  }
+  
+  /**
+   * @brief Decides whether a packet on a link is lost
+   */
+  bool shouldDropPacket(LinkState& link);
+  
+  /**
+   * @brief Checks the token bucket of a link, refilling it first
+   */
+  bool canSendMessage(LinkState& link, size_t messageSize, uint64_t currentTime);
+  
+  /**
+   * @brief Takes tokens for a message from the bucket of a link
+   */
+  void consumeBandwidth(LinkState& link, size_t messageSize);
+  
+  /**
+   * @brief Decides whether a packet on a traced link is lost
+   * 
+   * @param link Link state record with a trace cursor
+   * @param currentTime Current simulation time in milliseconds
+   */
+  bool shouldDropTraced(LinkState& link, uint64_t currentTime);
+  
+  /**
+   * @brief Calculates latency for the next message on a link
+   * 
+   * Traced links return the latency of the sample admitMessage() found.
+   * 
+   * @param link Link state record (its latency stream advances)
+   * @return Calculated latency in milliseconds
+   */
+  uint32_t calculateLatency(LinkState& link);
+  
+  /**
+   * @brief Gets the cached sampler for a latency configuration
+   * 
+   * @param config Latency configuration
+   * @return Sampler shared by all links with an equal configuration
+   */
+  const LatencySampler* samplerFor(const LatencyConfig& config);
+  
+  /**
+   * @brief Gets the cached chain for a Gilbert-Elliott loss configuration
+   * 
+   * @param config Packet loss configuration
+   * @return Chain shared by all links with equal parameters, or nullptr if
+   *         the configuration is not Gilbert-Elliott
+   */
+  const GilbertElliott* chainFor(const PacketLossConfig& config);
+  
+  /**
+   * @brief Records latency statistics for a link
+   * 
+   * @param link Link state record
    * @param latency_ms Latency in milliseconds
    */
-  void recordStats(uint32_t from, uint32_t to, uint32_t latency_ms);
+  static void recordStats(LinkState& link, uint32_t latency_ms);
   
   /**
-   * @brief Records packet drop statistics for a connection
+   * @brief Records packet drop statistics for a link
    * 
-   * @param from Source node ID
-   * @param to Destination node ID
+   * @param link Link state record
    * @param dropped Whether the packet was dropped
    */
-  void recordPacketStats(uint32_t from, uint32_t to, bool dropped);
+  static void recordPacketStats(LinkState& link, bool dropped);
   
   /**
-   * @brief Refills token bucket for a connection
+   * @brief Refills the token bucket of a link
    * 
-   * @param from Source node ID
-   * @param to Destination node ID
+   * Called only when a message checks the bucket; adds the exact tokens
+   * earned since the last refill.
+   * 
+   * @param link Link state record
    * @param currentTime Current simulation time in milliseconds
    */
-  void refillTokenBucket(uint32_t from, uint32_t to, uint64_t currentTime);
+  void refillTokenBucket(LinkState& link, uint64_t currentTime);
 };
 
 /**
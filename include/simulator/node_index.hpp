@@ -0,0 +1,88 @@
+/**
+ * @file node_index.hpp
+ * @brief Open-addressing index from node IDs to slot handles
+ *
+ * This file contains the NodeIndex class which NodeManager uses to find a
+ * node's storage slot by ID.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_NODE_INDEX_HPP
+#define SIMULATOR_NODE_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "simulator/slot_map.hpp"
+
+namespace simulator {
+
+/**
+ * @brief Hash index for node IDs
+ *
+ * A linear-probing table with a power-of-two capacity, kept at most half
+ * full, like LinkTable. Unlike links, nodes come and go, so entries can be
+ * erased; erase() shifts the rest of the probe run back instead of leaving
+ * tombstones, so lookups never slow down after churn. Node IDs are
+ * non-zero, which leaves 0 to mark empty slots.
+ */
+class NodeIndex {
+public:
+  /**
+   * @brief Construct an empty index
+   */
+  NodeIndex();
+
+  /**
+   * @brief Finds the handle of a node
+   *
+   * @param nodeId Node identifier
+   * @return Handle, or an invalid handle if the node is not indexed
+   */
+  SlotHandle find(uint32_t nodeId) const;
+
+  /**
+   * @brief Adds a node
+   *
+   * @param nodeId Node identifier (must be non-zero)
+   * @param handle Handle to store
+   * @return false if the node is already indexed (nothing is changed)
+   */
+  bool insert(uint32_t nodeId, SlotHandle handle);
+
+  /**
+   * @brief Removes a node
+   *
+   * @param nodeId Node identifier
+   * @return false if the node was not indexed
+   */
+  bool erase(uint32_t nodeId);
+
+  /**
+   * @brief Gets the number of indexed nodes
+   *
+   * @return Node count
+   */
+  size_t size() const { return size_; }
+
+private:
+  struct Slot {
+    uint32_t id;          ///< Node ID, or 0 if empty
+    SlotHandle handle;    ///< Storage handle of the node
+  };
+
+  std::vector<Slot> slots_;    ///< Open-addressing slots (power-of-two size)
+  size_t mask_;                ///< slots_.size() - 1
+  size_t size_{0};             ///< Number of occupied slots
+
+  size_t slotFor(uint32_t nodeId) const;
+
+  void grow();
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_NODE_INDEX_HPP
@@ -13,17 +13,28 @@
 #define SIMULATOR_NODE_MANAGER_HPP
 
 #include <memory>
-#include <map>
 #include <vector>
+#include <utility>
 #include <cstdint>
 #include <boost/asio.hpp>
 #include "simulator/virtual_node.hpp"
+#include "simulator/node_index.hpp"
+#include "simulator/shard_mailbox.hpp"
+#include "simulator/slot_map.hpp"
+#include "simulator/steal_queue.hpp"
+#include "simulator/worker_pool.hpp"
 
 // Forward declaration
 class Scheduler;
 
 namespace simulator {
 
+class MeshTransport;
+class CheckpointWriter;
+class CheckpointReader;
+class TopologyListener;
+class LoopMonitor;
+
 /**
  * @brief Manages lifecycle and coordination of multiple virtual nodes
  * 
@@ -31,6 +42,21 @@ namespace simulator {
  * and coordinating updates across multiple VirtualNode instances. It
  * maintains a central scheduler and IO context that all nodes share.
  * 
+ * With setShardCount(n) the nodes are instead split into n shards, each
+ * with its own IO context, and updateAll() updates them in parallel on a
+ * worker pool. Each sharded node has its own scheduler, so a node is a
+ * self-contained task: a worker runs its home shard's nodes first and,
+ * once it runs dry, steals the not-yet-started nodes of other shards.
+ * In-process transport traffic of a sharded manager goes through per-node
+ * lock-free mailboxes so that the transport itself is only touched by the
+ * calling thread.
+ * 
+ * A sharded manager can also run several ticks per synchronization with
+ * advanceWindow(). This is a conservative window barrier: no frame sent
+ * inside a window can arrive before the window ends as long as the window
+ * is no longer than the smallest link latency (see getLookaheadTicks()),
+ * so shards only need to meet once per window.
+ * 
  * Example usage:
  * @code
  * boost::asio::io_context io;
@@ -55,7 +81,9 @@ namespace simulator {
  * @endcode
  * 
  * @note NodeManager is not thread-safe. All operations should be called
- *       from the same thread.
+ *       from the same thread. In sharded mode node code runs on worker
+ *       threads during updateAll(), so firmware must not share mutable
+ *       state across nodes.
  */
 class NodeManager {
 public:
@@ -95,13 +123,36 @@ public:
    * 
    * @throws std::invalid_argument if nodeId is 0
    * @throws std::runtime_error if node with same ID exists
-   * @throws std::runtime_error if max nodes reached (MAX_NODES)
+   * @throws std::runtime_error if max nodes reached (getMaxNodes())
    * 
    * @note The node is created but not started automatically.
    *       Call startAll() or node->start() to begin operation.
    */
   std::shared_ptr<VirtualNode> createNode(const NodeConfig& config);
   
+  /**
+   * @brief Create a batch of virtual nodes
+   * 
+   * Checks the whole batch first, then builds the nodes and registers
+   * them in one step. A sharded manager builds them in parallel on its
+   * workers, since every sharded node has a scheduler of its own; a
+   * single-threaded manager builds them in order on the shared scheduler.
+   * Nodes land on the same shards as with createNode() one by one.
+   * Firmware names are resolved to factory IDs once per batch, nodes
+   * with equal configurations share one firmware configuration map, and
+   * loaded firmware is not announced per node.
+   * 
+   * @param configs Node configuration parameters
+   * @return Created nodes, in the order of configs
+   * 
+   * @throws std::invalid_argument if a nodeId is 0
+   * @throws std::runtime_error if a node ID repeats or already exists
+   * @throws std::runtime_error if the batch would exceed getMaxNodes()
+   * 
+   * @note On error no node of the batch is created.
+   */
+  std::vector<std::shared_ptr<VirtualNode>> createNodes(const std::vector<NodeConfig>& configs);
+  
   /**
    * @brief Remove a node by ID
    * 
@@ -134,25 +185,238 @@ public:
    * 
    * Performs coordinated update of all nodes:
    * 1. Executes scheduler tasks
-   * 2. Updates each node
-   * 3. Polls IO context
+   * 2. Updates each node that is due
+   * 3. Polls the IO context once for all nodes
+   * 
+   * Nodes whose firmware sleeps (FirmwareBase::sleepFor()) wait in a
+   * wake-time heap and are not touched until their sleep ends or a
+   * callback wakes them.
+   * 
+   * In sharded mode every shard runs these steps on its own thread,
+   * after handing its nodes the transport deliveries queued for them.
+   * Once all shards finish, the firmware sends they posted are passed to
+   * the transport in an order that does not depend on the shard count.
    * 
    * Should be called periodically (e.g., in a simulation loop)
    * to advance the simulation state.
    */
   void updateAll();
   
+  /**
+   * @brief Advance all shards through a window of ticks
+   * 
+   * Drives the transport itself, so the caller must not call
+   * MeshTransport::update() for these ticks:
+   * 1. Updates the transport at every tick of the window, queueing the
+   *    deliveries for each shard with their delivery time
+   * 2. Runs every node through all ticks in parallel, handing it its
+   *    deliveries at the right tick before updating it, then polls the
+   *    shard IO contexts in parallel
+   * 3. Replays the sends posted during the window into the transport,
+   *    ordered by send time, then delivery order, then sender ID
+   * 
+   * The window must fit in the lookahead (getLookaheadTicks()), otherwise
+   * frames sent early in the window would arrive late. Results do not
+   * depend on the shard count.
+   * 
+   * @param start_ms Simulated time of the first tick
+   * @param tick_ms Tick length in milliseconds
+   * @param ticks Number of ticks in the window
+   * 
+   * @throws std::runtime_error if the manager is not sharded
+   */
+  void advanceWindow(uint64_t start_ms, uint32_t tick_ms, uint32_t ticks);
+  
+  /**
+   * @brief Get the longest safe window for advanceWindow()
+   * 
+   * A frame sent at tick t arrives at the first transport update at or
+   * after t + max(latency, tick_ms). With the smallest link latency L, a
+   * window of k ticks is safe while L > (k - 1) * tick_ms. All links count,
+   * not just those between shards, because every frame passes through the
+   * shared transport between windows.
+   * 
+   * @param tick_ms Tick length in milliseconds
+   * @param max_ticks Upper bound on the window (e.g. when there are no links)
+   * @return Window length in ticks, between 1 and max_ticks
+   */
+  uint32_t getLookaheadTicks(uint32_t tick_ms, uint32_t max_ticks) const;
+  
+  /**
+   * @brief Split nodes across parallel shards
+   * 
+   * Each shard gets its own IO context and worker thread. New nodes join
+   * the shard with the fewest nodes; the shard is the node's home, where
+   * it runs unless another worker steals it after finishing its own
+   * nodes. A single shard runs on the calling thread but keeps the
+   * sharded message ordering, so its results match any other count. A
+   * manager that never calls this updates nodes on the shared scheduler.
+   * 
+   * @param count Number of shards (threads used by updateAll())
+   * 
+   * @throws std::invalid_argument if count is 0 or above MAX_SHARDS
+   * @throws std::runtime_error if nodes have already been created
+   */
+  void setShardCount(size_t count);
+  
+  /**
+   * @brief Get the number of shards
+   * 
+   * @return Shard count (1 in single-threaded mode)
+   */
+  size_t getShardCount() const { return shards_.empty() ? 1 : shards_.size(); }
+  
+  /**
+   * @brief Check if nodes are updated through shards
+   * 
+   * @return true once setShardCount() has been called
+   */
+  bool isSharded() const { return !shards_.empty(); }
+  
+  /**
+   * @brief Get the shard a node runs on
+   * 
+   * @param nodeId ID of node to look up
+   * @return Shard index (0 in single-threaded mode)
+   * 
+   * @throws std::out_of_range if the node does not exist
+   */
+  size_t getShardOf(uint32_t nodeId) const;
+  
+  /**
+   * @brief Get how often a node ran away from its home shard
+   * 
+   * @return Total number of node updates taken by another shard's worker
+   *         (one per node and window)
+   */
+  uint64_t getStealCount() const;
+  
+  /**
+   * @brief Get the number of nodes skipped by updates
+   * 
+   * @return Count of nodes whose firmware is sleeping
+   */
+  size_t getSleepingNodeCount() const;
+  
+  /**
+   * @brief Get the earliest time a node needs an update
+   * 
+   * Nodes whose firmware sleeps need none before their wake time (which
+   * already accounts for their next runEvery() / runAfter() task); an
+   * awake node needs one at every tick. Deliveries and firmware wake()
+   * calls wake nodes early, so the result holds only until the next
+   * transport update.
+   * 
+   * @return Time on the VirtualNode::wakeClockMs() clock, 0 if a running
+   *         node is awake, or UINT64_MAX if no node runs
+   */
+  uint64_t getNextWakeTime() const;
+  
   /**
    * @brief Establish mesh connectivity between nodes
    * 
    * Creates a random mesh topology where each node connects to
-   * at least one other node, forming a connected graph.
+   * at least one other node, forming a connected graph. The tree is
+   * drawn from the RNG_STREAM_TOPOLOGY stream of the seed (see
+   * setSeed()), so the same seed and node order give the same links.
    * 
    * This simulates the natural mesh formation that occurs in
    * painlessMesh networks.
    */
   void establishConnectivity();
   
+  /**
+   * @brief Establish the given links between nodes
+   * 
+   * With an in-process transport all links are added in one batch
+   * (MeshTransport::addLinks()); otherwise each pair connects over
+   * loopback TCP. Links to nodes this manager does not hold are skipped.
+   * 
+   * @param links Node ID pairs, e.g. from Topology::getLinks()
+   * @return Number of links established
+   */
+  size_t establishConnectivity(const std::vector<std::pair<uint32_t, uint32_t>>& links);
+  
+  /**
+   * @brief Seed the random decisions made for the nodes
+   * 
+   * Used by establishConnectivity() and handed to every node's firmware
+   * (FirmwareBase::randomBetween()), including nodes created later. Use
+   * the seed of the NetworkSimulator so one seed replays the whole run.
+   * 
+   * @param seed Simulation seed
+   */
+  void setSeed(uint32_t seed);
+  
+  /**
+   * @brief Get the seed of the random decisions
+   * 
+   * @return Seed set with setSeed() (0 by default)
+   */
+  uint32_t getSeed() const { return seed_; }
+  
+  /**
+   * @brief Route node traffic through an in-process transport
+   * 
+   * Applies the transport to all existing and future nodes, so that
+   * establishConnectivity() creates in-memory links instead of loopback
+   * TCP connections. Must be called before the nodes are started.
+   * 
+   * @param transport Transport to use, or nullptr for loopback TCP
+   * 
+   * @note The transport must outlive the NodeManager.
+   */
+  void setTransport(MeshTransport* transport);
+  
+  /**
+   * @brief Get the in-process transport
+   * 
+   * @return Transport in use, or nullptr if loopback TCP is used
+   */
+  MeshTransport* getTransport() const { return transport_; }
+  
+  /**
+   * @brief Reports node starts, stops and crashes to a listener
+   * 
+   * Applies to all existing and future nodes.
+   * 
+   * @param listener Listener (e.g. an open TopologyRecorder), or nullptr
+   *                 to stop reporting
+   * 
+   * @note The listener must stay alive until it is detached again.
+   */
+  void setTopologyListener(TopologyListener* listener);
+  
+  /**
+   * @brief Enables or disables call timing on all nodes
+   * 
+   * Applies to all existing and future nodes; collect the results with
+   * FirmwareProfiler::collect().
+   * 
+   * @param enabled true to time mesh updates and firmware callbacks
+   */
+  void setProfiling(bool enabled);
+  
+  /**
+   * @brief Sets the monitor node update durations are recorded in
+   * 
+   * Every existing and future node times the phases of its updates, and
+   * the thread that ran an update records it in the monitor's slot of its
+   * shard. The monitor gets one worker slot per shard.
+   * 
+   * @param monitor Monitor, or nullptr to stop timing updates
+   * 
+   * @note The monitor must stay alive until it is detached again.
+   */
+  void setLoopMonitor(LoopMonitor* monitor);
+  
+  /**
+   * @brief Gets the monitor node updates are recorded in
+   * 
+   * @return Monitor, or nullptr if updates are not timed
+   */
+  LoopMonitor* getLoopMonitor() const { return monitor_; }
+  
   // Queries
   
   /**
@@ -181,7 +445,8 @@ public:
   /**
    * @brief Get list of all node IDs
    * 
-   * @return Vector of node IDs in no particular order
+   * @return Vector of node IDs in storage order (creation order until a
+   *         node is removed)
    */
   std::vector<uint32_t> getNodeIds() const;
   
@@ -192,6 +457,19 @@ public:
    */
   std::vector<std::shared_ptr<VirtualNode>> getAllNodes() const;
   
+  /**
+   * @brief Visit every node in storage order without copying handles
+   * 
+   * @param visitor Callable taking const VirtualNode&; must not add or
+   *                remove nodes
+   */
+  template <typename Visitor>
+  void forEachNode(Visitor&& visitor) const {
+    for (const auto& record : nodes_) {
+      visitor(static_cast<const VirtualNode&>(*record.node));
+    }
+  }
+  
   /**
    * @brief Check if a node with the given ID exists
    * 
@@ -200,21 +478,222 @@ public:
    */
   bool hasNode(uint32_t nodeId) const;
   
+  /**
+   * @brief Estimate the memory held by one node
+   * 
+   * Adds the node's mailboxes and scratch buffers (sharded mode) to
+   * VirtualNode::getMemoryUsage().
+   * 
+   * @param nodeId ID of node to look up
+   * @return Memory usage by component
+   * 
+   * @throws std::out_of_range if the node does not exist
+   */
+  NodeMemoryUsage getMemoryUsage(uint32_t nodeId) const;
+  
+  /**
+   * @brief Estimate the memory held by all nodes
+   * 
+   * @return Sum of getMemoryUsage(id) over all nodes
+   */
+  NodeMemoryUsage getMemoryUsage() const;
+  
+  // Checkpoints
+  
+  /**
+   * @brief Writes the state of every node to a checkpoint
+   * 
+   * @param out Checkpoint writer
+   */
+  void saveState(CheckpointWriter& out) const;
+  
+  /**
+   * @brief Restores node state written by saveState()
+   * 
+   * The same nodes must have been created, as they are when the scenario
+   * that wrote the checkpoint is loaded again.
+   * 
+   * @param in Checkpoint reader
+   * 
+   * @throws std::runtime_error if the checkpoint holds different nodes
+   */
+  void loadState(CheckpointReader& in);
+  
   // Resource limits
   
   /**
-   * @brief Maximum number of nodes that can be created
+   * @brief Set the maximum number of nodes
+   * 
+   * The cap guards against runaway scenarios; raise it for large
+   * simulations after checking getMemoryUsage() against the host.
+   * 
+   * @param max_nodes New cap
+   * 
+   * @throws std::invalid_argument if max_nodes is 0 or below getNodeCount()
+   */
+  void setMaxNodes(size_t max_nodes);
+  
+  /**
+   * @brief Get the maximum number of nodes
+   * 
+   * @return Current cap (MAX_NODES unless setMaxNodes() was called)
+   */
+  size_t getMaxNodes() const { return max_nodes_; }
+  
+  /**
+   * @brief Default maximum number of nodes that can be created
    * 
    * This limit helps prevent excessive resource usage and
-   * ensures simulation performance remains reasonable.
+   * ensures simulation performance remains reasonable. Change it
+   * per manager with setMaxNodes().
    */
   static constexpr size_t MAX_NODES = 1000;
+  
+  /**
+   * @brief Maximum number of shards
+   */
+  static constexpr size_t MAX_SHARDS = 256;
 
 private:
+  /// Sends or deliveries a node's mailbox holds before spilling (kept
+  /// small: both rings are allocated up front for every sharded node)
+  static constexpr size_t NODE_MAILBOX_CAPACITY = 16;
+  
+  /**
+   * @brief A sharded node and everything needed to update it on any thread
+   */
+  struct NodeSlot {
+    NodeSlot() : outbox(NODE_MAILBOX_CAPACITY), inbox(NODE_MAILBOX_CAPACITY) {}
+    
+    std::shared_ptr<VirtualNode> node;                    ///< The node
+    Scheduler* scheduler{nullptr};                        ///< Scheduler of this node alone
+    size_t shard{0};                                      ///< Home shard
+    Outbox outbox;                                        ///< Firmware sends, drained after the phase
+    Inbox inbox;                                          ///< Transport deliveries, drained by the node's task
+    std::vector<IncomingMessage> pending;                 ///< Deliveries of the current window
+  };
+  
+  /**
+   * @brief Storage record of a node
+   * 
+   * Records are packed in one array, so per-tick loops walk contiguous
+   * memory rather than tree nodes.
+   */
+  struct NodeRecord {
+    std::shared_ptr<VirtualNode> node;                    ///< The node
+    std::unique_ptr<NodeSlot> slot;                       ///< Sharded update state (sharded mode only)
+    uint32_t id{0};                                       ///< Node ID
+  };
+  
+  /**
+   * @brief The home of a group of nodes and of one worker thread
+   */
+  struct Shard {
+    std::unique_ptr<boost::asio::io_context> io;          ///< IO context of this shard's nodes
+    std::vector<std::unique_ptr<Scheduler>> schedulers;   ///< Schedulers of nodes created here
+    std::vector<NodeSlot*> nodes;                         ///< Home nodes in creation order
+    StealQueue<NodeSlot*> queue;                          ///< Home nodes not yet run this window
+    uint64_t steals{0};                                   ///< Nodes taken from other shards
+  };
+  
   boost::asio::io_context& io_;                                   ///< IO context reference
   std::unique_ptr<Scheduler> scheduler_;                          ///< Shared scheduler instance
-  std::map<uint32_t, std::shared_ptr<VirtualNode>> nodes_;        ///< Map of node ID to node
+  MeshTransport* transport_{nullptr};                             ///< In-process transport (optional)
+  TopologyListener* listener_{nullptr};                           ///< Told about node lifecycle (optional)
+  bool profiling_{false};                                          ///< Nodes time their calls
+  LoopMonitor* monitor_{nullptr};                                  ///< Records node update times (optional)
+  std::vector<std::unique_ptr<Shard>> shards_;                    ///< Shards (empty = single-threaded)
+  std::unique_ptr<WorkerPool> pool_;                              ///< Threads updating the shards
+  std::vector<OutgoingMessage> replay_;                           ///< Sends being replayed (scratch)
+  SlotMap<NodeRecord> nodes_;                                     ///< Nodes, densely packed
+  NodeIndex index_;                                               ///< Node ID -> handle in nodes_
+  std::vector<std::pair<uint64_t, uint32_t>> wake_heap_;          ///< (wake time, node ID) min-heap
+  std::vector<VirtualNode*> awake_;                               ///< Nodes to update, in storage order
+  bool awake_dirty_{true};                                        ///< awake_ needs a rebuild
+  size_t max_nodes_{MAX_NODES};                                   ///< Node cap
+  uint32_t seed_{0};                                              ///< Seed of topology and firmware streams
   uint32_t next_node_id_{1000};                                   ///< Next auto-assigned node ID
+  
+  /**
+   * @brief Looks up a node's storage record
+   * 
+   * @param nodeId Node identifier
+   * @return Record, or nullptr if the node does not exist
+   */
+  NodeRecord* findRecord(uint32_t nodeId) { return nodes_.get(index_.find(nodeId)); }
+  const NodeRecord* findRecord(uint32_t nodeId) const { return nodes_.get(index_.find(nodeId)); }
+  
+  /**
+   * @brief Wakes sleepers whose time has come and rebuilds awake_ if needed
+   * 
+   * Heap entries are not removed when a node wakes early; stale ones are
+   * dropped when they reach the top.
+   */
+  void refreshAwakeNodes();
+  
+  /**
+   * @brief Runs all shards through a window, then replays their sends
+   * 
+   * @param start_ms Simulated time of the first tick
+   * @param tick_ms Tick length in milliseconds
+   * @param ticks Number of ticks
+   */
+  void runShards(uint64_t start_ms, uint32_t tick_ms, uint32_t ticks);
+  
+  /**
+   * @brief Runs home nodes, then stolen ones, until none is left
+   * 
+   * @param index Shard whose worker is running
+   * @param start_ms Simulated time of the first tick
+   * @param tick_ms Tick length in milliseconds
+   * @param ticks Number of ticks
+   */
+  void runWorker(size_t index, uint64_t start_ms, uint32_t tick_ms, uint32_t ticks);
+  
+  /**
+   * @brief Takes a not-yet-started node from another shard
+   * 
+   * Victims are tried in order after the thief, so thieves spread out.
+   * 
+   * @param index Shard of the idle worker
+   * @param slot Receives the stolen node
+   * @return false if every other shard is done
+   */
+  bool stealNode(size_t index, NodeSlot*& slot);
+  
+  /**
+   * @brief Runs one node through a window (on any worker thread)
+   * 
+   * @param worker Shard of the worker running the node
+   * @param slot Node to update
+   * @param start_ms Simulated time of the first tick
+   * @param tick_ms Tick length in milliseconds
+   * @param ticks Number of ticks
+   */
+  void updateNode(size_t worker, NodeSlot& slot, uint64_t start_ms, uint32_t tick_ms,
+                  uint32_t ticks);
+  
+  /**
+   * @brief Passes posted firmware sends to the transport in replay order
+   */
+  void flushOutboxes();
+  
+  /**
+   * @brief Updates a node, recording the update in the loop monitor
+   * 
+   * @param worker Monitor slot of the calling thread
+   * @param node Node to update
+   */
+  void updateTimed(size_t worker, VirtualNode& node);
+  
+  /**
+   * @brief Connects or disconnects a sharded node from its mailboxes
+   * 
+   * Mailboxes are only used with an in-process transport.
+   * 
+   * @param slot Node to update
+   */
+  void bindMailboxes(NodeSlot& slot);
 };
 
 } // namespace simulator
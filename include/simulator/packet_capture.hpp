@@ -0,0 +1,265 @@
+/**
+ * @file packet_capture.hpp
+ * @brief Binary capture of simulated traffic in pcapng format
+ *
+ * This file contains the PacketCapture class which records what happens
+ * to each message in the NetworkSimulator delivery path and streams the
+ * records to a pcapng file from a background thread.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_PACKET_CAPTURE_HPP
+#define SIMULATOR_PACKET_CAPTURE_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "simulator/payload.hpp"
+#include "simulator/spsc_queue.hpp"
+
+namespace simulator {
+
+/**
+ * @brief What happened to a message
+ */
+enum class CaptureVerdict : uint8_t {
+  ENQUEUED = 0,       ///< Admitted with a sampled latency
+  DELIVERED = 1,      ///< Handed out for delivery
+  DROPPED = 2,        ///< Lost to packet loss
+  DISCONNECTED = 3,   ///< Link dropped or crossing a partition
+  THROTTLED = 4       ///< Over the link's bandwidth limit
+};
+
+/**
+ * @brief One captured event
+ */
+struct CaptureRecord {
+  static constexpr size_t MAX_PREFIX = 64;   ///< Largest payload prefix kept
+
+  uint64_t time_ms{0};               ///< Simulation time of the event
+  uint64_t delivery_ms{0};           ///< Delivery time (ENQUEUED and DELIVERED), else 0
+  uint32_t from{0};                  ///< Source node ID
+  uint32_t to{0};                    ///< Destination node ID
+  uint32_t size{0};                  ///< Payload size in bytes
+  CaptureVerdict verdict{CaptureVerdict::ENQUEUED};
+  uint8_t prefix_length{0};          ///< Bytes of prefix in use
+  char prefix[MAX_PREFIX];           ///< First payload bytes
+};
+
+/**
+ * @brief Selects what a PacketCapture records
+ */
+struct CaptureFilter {
+  std::vector<uint32_t> nodes;                          ///< Traffic from or to these nodes
+  std::vector<std::pair<uint32_t, uint32_t>> links;     ///< Traffic on these links, both directions
+  uint32_t payload_prefix = 0;                          ///< Payload bytes per record (<= MAX_PREFIX)
+};
+
+/**
+ * @brief Records the delivery path of simulated traffic to a pcapng file
+ *
+ * Attached with NetworkSimulator::setCapture(), the capture receives one
+ * record per enqueued, dropped, disconnected, throttled and delivered
+ * message. Without nodes or links in the filter every message is
+ * recorded; otherwise only messages from or to a listed node or on a
+ * listed link.
+ *
+ * The simulation thread copies each record into a lock-free SpscQueue; a
+ * writer thread drains it every few milliseconds and writes the records
+ * as pcapng Enhanced Packet Blocks. When the queue is full the simulation
+ * thread wakes the writer and yields until there is room, so no record is
+ * lost (getStallCount() counts these waits).
+ *
+ * The file has one section and one interface with link type
+ * LINKTYPE_USER0 (147) and microsecond timestamps holding the simulation
+ * time. Each packet is a HEADER_SIZE byte little-endian header followed
+ * by the payload prefix:
+ *
+ * | Offset | Size | Field |
+ * |--------|------|-------|
+ * | 0 | 4 | from |
+ * | 4 | 4 | to |
+ * | 8 | 4 | payload size |
+ * | 12 | 1 | verdict (CaptureVerdict) |
+ * | 13 | 3 | reserved (0) |
+ * | 16 | 8 | delivery time in milliseconds |
+ *
+ * The packet's original length is HEADER_SIZE plus the payload size.
+ *
+ * Example usage:
+ * @code
+ * CaptureFilter filter;
+ * filter.nodes = {gateway_id};
+ * PacketCapture capture(filter);
+ * capture.open("run.pcapng");
+ * network.setCapture(&capture);
+ * ...
+ * network.setCapture(nullptr);
+ * capture.close();
+ * @endcode
+ */
+class PacketCapture {
+public:
+  /// pcapng link type of the packets (LINKTYPE_USER0)
+  static constexpr uint16_t LINK_TYPE = 147;
+
+  /// Bytes of record header in each packet
+  static constexpr size_t HEADER_SIZE = 24;
+
+  /// Default ring buffer capacity in records
+  static constexpr size_t DEFAULT_BUFFER_RECORDS = 16384;
+
+  /**
+   * @brief Construct a closed capture
+   *
+   * @param filter Nodes, links and payload prefix to capture
+   * @param buffer_records Ring buffer capacity in records
+   *
+   * @throws std::invalid_argument if the payload prefix exceeds
+   *         CaptureRecord::MAX_PREFIX
+   */
+  explicit PacketCapture(const CaptureFilter& filter = CaptureFilter(),
+                         size_t buffer_records = DEFAULT_BUFFER_RECORDS);
+
+  /**
+   * @brief Destructor; closes the file
+   */
+  ~PacketCapture();
+
+  PacketCapture(const PacketCapture&) = delete;
+  PacketCapture& operator=(const PacketCapture&) = delete;
+
+  /**
+   * @brief Creates the file, writes its header blocks and starts the
+   *        writer thread
+   *
+   * @param path Output file
+   *
+   * @throws std::runtime_error if the file cannot be created
+   */
+  void open(const std::string& path);
+
+  /**
+   * @brief Writes every queued record, stops the writer thread and closes
+   *        the file (no-op if not open)
+   *
+   * @throws std::runtime_error if writing failed
+   */
+  void close();
+
+  /**
+   * @brief Checks if the capture is open
+   */
+  bool isOpen() const { return open_; }
+
+  /**
+   * @brief Checks if the filter selects a message
+   */
+  bool wants(uint32_t from, uint32_t to) const {
+    if (!filtered_) {
+      return true;
+    }
+    return nodes_.count(from) > 0 || nodes_.count(to) > 0 ||
+           links_.count(linkKey(from, to)) > 0;
+  }
+
+  /**
+   * @brief Records a message event if the filter selects it
+   *
+   * Records are dropped silently while the capture is not open.
+   *
+   * @param verdict What happened to the message
+   * @param time_ms Simulation time in milliseconds
+   * @param from Source node ID
+   * @param to Destination node ID
+   * @param payload Message content
+   * @param delivery_ms Delivery time, for ENQUEUED and DELIVERED
+   */
+  void capture(CaptureVerdict verdict, uint64_t time_ms, uint32_t from, uint32_t to,
+               const Payload& payload, uint64_t delivery_ms = 0) {
+    if (!open_ || !wants(from, to)) {
+      return;
+    }
+    CaptureRecord record;
+    record.time_ms = time_ms;
+    record.delivery_ms = delivery_ms;
+    record.from = from;
+    record.to = to;
+    record.size = static_cast<uint32_t>(payload.size());
+    record.verdict = verdict;
+    record.prefix_length = static_cast<uint8_t>(std::min<size_t>(prefix_, payload.size()));
+    if (record.prefix_length > 0) {
+      std::memcpy(record.prefix, payload.data(), record.prefix_length);
+    }
+    push(record);
+  }
+
+  /**
+   * @brief Gets the number of records captured since open()
+   */
+  uint64_t getCapturedCount() const { return captured_; }
+
+  /**
+   * @brief Gets how often the simulation thread waited for the writer
+   */
+  uint64_t getStallCount() const { return stalls_; }
+
+  /**
+   * @brief Reads the records of a capture file
+   *
+   * @param path File written by a PacketCapture
+   * @return Records in file order
+   *
+   * @throws std::runtime_error if the file cannot be read or is not a
+   *         capture of this format
+   */
+  static std::vector<CaptureRecord> readFile(const std::string& path);
+
+private:
+  static uint64_t linkKey(uint32_t a, uint32_t b) {
+    if (a > b) {
+      std::swap(a, b);
+    }
+    return (static_cast<uint64_t>(a) << 32) | b;
+  }
+
+  void push(CaptureRecord& record);
+  void writerLoop();
+  void appendPacket(std::string& out, const CaptureRecord& record) const;
+
+  bool filtered_;                             ///< Filter lists nodes or links
+  std::unordered_set<uint32_t> nodes_;        ///< Captured nodes
+  std::unordered_set<uint64_t> links_;        ///< Captured links (linkKey)
+  size_t prefix_;                             ///< Payload bytes per record
+  size_t buffer_records_;                     ///< Ring buffer capacity
+  bool open_{false};                          ///< open() succeeded
+  uint64_t captured_{0};                      ///< Records pushed
+  uint64_t stalls_{0};                        ///< Waits for a full ring buffer
+
+  std::unique_ptr<SpscQueue<CaptureRecord>> queue_;
+  std::ofstream out_;
+  std::mutex mutex_;                          ///< Guards the fields below
+  std::condition_variable wake_cv_;           ///< Wakes the writer
+  bool wake_{false};                          ///< Writer has a full queue to drain
+  bool stopping_{false};                      ///< close() was called
+  std::exception_ptr error_;                  ///< Writer failure, rethrown by close()
+  std::thread writer_;
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_PACKET_CAPTURE_HPP
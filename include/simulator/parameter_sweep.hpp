@@ -0,0 +1,212 @@
+/**
+ * @file parameter_sweep.hpp
+ * @brief Parameter grids over one scenario for batch runs
+ *
+ * This file contains the SweepSpec class which reads a sweep file naming
+ * scenario parameters and their values, enumerates the points of the grid
+ * they span and applies a point to a copy of the parsed scenario, and the
+ * SweepResult table written after the runs.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_PARAMETER_SWEEP_HPP
+#define SIMULATOR_PARAMETER_SWEEP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include "simulator/config_loader.hpp"
+
+namespace simulator {
+
+/**
+ * @brief One swept parameter and its values
+ */
+struct SweepAxis {
+  std::string name;              ///< Parameter (see SweepSpec)
+  std::vector<double> values;    ///< Values, in run order
+};
+
+/**
+ * @brief One combination of parameter values
+ */
+struct SweepPoint {
+  size_t index = 0;              ///< Position in the grid
+  std::vector<double> values;    ///< Value of every axis, in axis order
+};
+
+/**
+ * @brief Outcome of one run of a sweep
+ */
+struct SweepResult {
+  SweepPoint point;                  ///< Parameters of the run
+  std::string error;                 ///< Why the run failed (empty = completed)
+  size_t nodes = 0;                  ///< Nodes simulated
+  uint64_t simulated_ms = 0;         ///< Virtual time reached
+  uint64_t wall_ms = 0;              ///< Wall time of the run, setup included
+  uint64_t updates = 0;              ///< Simulation ticks
+  uint64_t messages_sent = 0;        ///< Firmware messages sent
+  uint64_t messages_received = 0;    ///< Firmware messages received
+  uint64_t frames_dropped = 0;       ///< Mesh frames without a route
+  uint64_t link_delivered = 0;       ///< Link messages past packet loss
+  uint64_t link_lost = 0;            ///< Link messages lost or throttled
+  uint32_t latency_p50_ms = 0;       ///< Link latency percentiles
+  uint32_t latency_p95_ms = 0;
+  uint32_t latency_p99_ms = 0;
+  uint64_t traffic_offered = 0;      ///< Synthetic messages sent (see TrafficStats)
+  uint64_t traffic_expected = 0;     ///< Synthetic deliveries asked for
+  uint64_t traffic_delivered = 0;    ///< Synthetic deliveries that arrived
+
+  /**
+   * @brief Checks whether the run completed
+   */
+  bool ok() const { return error.empty(); }
+
+  /**
+   * @brief Checks whether any message crossed a link
+   */
+  bool hasTraffic() const { return link_delivered + link_lost > 0; }
+
+  /**
+   * @brief Gets the share of link messages delivered
+   *
+   * @return Ratio from 0.0 to 1.0 (1.0 without traffic)
+   */
+  double getDeliveryRatio() const {
+    return hasTraffic() ? static_cast<double>(link_delivered) /
+                          static_cast<double>(link_delivered + link_lost)
+                        : 1.0;
+  }
+};
+
+/**
+ * @brief Grid of scenario parameters to run
+ *
+ * A sweep file lists parameters with their values; every combination is
+ * one run, the last parameter varying fastest:
+ *
+ * @code{.yaml}
+ * parameters:
+ *   nodes: [10, 100, 1000]     # Count of the scenario's only node template
+ *   packet_loss: [0.0, 0.05]   # network.packet_loss.default.probability
+ *   seed: [1, 2, 3]            # simulation.seed
+ * jobs: 0                      # Concurrent runs (0 = one per hardware thread)
+ * output: sweep_results.csv    # Aggregated results table
+ * @endcode
+ *
+ * Parameters: nodes, seed, duration (seconds), packet_loss (0.0-1.0),
+ * latency_min and latency_max (ms), traffic_rate (messages per second
+ * per source). All but packet_loss and traffic_rate take whole numbers.
+ *
+ * Example usage:
+ * @code
+ * SweepSpec spec = SweepSpec::load("capacity.sweep.yaml");
+ * for (size_t i = 0; i < spec.getPointCount(); ++i) {
+ *   ScenarioConfig config = *base;  // Parsed once, shared by all runs
+ *   spec.apply(spec.getPoint(i), config);
+ *   loader.expandTemplates(config);
+ *   ...
+ * }
+ * @endcode
+ */
+class SweepSpec {
+public:
+  /**
+   * @brief Reads a sweep file
+   *
+   * @param path Sweep file
+   * @return Parsed sweep
+   *
+   * @throws std::runtime_error if the file cannot be read or is invalid
+   */
+  static SweepSpec load(const std::string& path);
+
+  /**
+   * @brief Parses a sweep from YAML text
+   *
+   * @param yaml Sweep document
+   * @return Parsed sweep
+   *
+   * @throws std::runtime_error if the document is invalid
+   */
+  static SweepSpec parse(const std::string& yaml);
+
+  /**
+   * @brief Gets the swept parameters, in file order
+   */
+  const std::vector<SweepAxis>& getAxes() const { return axes_; }
+
+  /**
+   * @brief Gets the number of runs (product of the value counts)
+   */
+  size_t getPointCount() const;
+
+  /**
+   * @brief Gets one combination of values
+   *
+   * @param index Position in the grid, below getPointCount()
+   * @return Values of every axis
+   *
+   * @throws std::out_of_range if index is past the grid
+   */
+  SweepPoint getPoint(size_t index) const;
+
+  /**
+   * @brief Sets a point's parameters in a scenario
+   *
+   * @param point Point of this sweep
+   * @param config Scenario before template expansion
+   *
+   * @throws std::invalid_argument if the point sets nodes and the scenario
+   *         does not have exactly one node template, or sets traffic_rate
+   *         and the scenario has no traffic
+   */
+  void apply(const SweepPoint& point, ScenarioConfig& config) const;
+
+  /**
+   * @brief Gets the number of concurrent runs requested
+   *
+   * @return Run count (0 = one per hardware thread)
+   */
+  uint32_t getJobs() const { return jobs_; }
+
+  /**
+   * @brief Overrides the number of concurrent runs
+   */
+  void setJobs(uint32_t jobs) { jobs_ = jobs; }
+
+  /**
+   * @brief Gets the path of the results table
+   */
+  const std::string& getOutput() const { return output_; }
+
+  /**
+   * @brief Writes the results as CSV, one row per run in grid order
+   *
+   * Columns: run, one per parameter, status, then the SweepResult
+   * counters. Failed runs hold their error in the status column.
+   *
+   * @param results Results of the runs
+   * @param out Stream to write to
+   */
+  void writeTable(const std::vector<SweepResult>& results, std::ostream& out) const;
+
+  /// Default results table
+  static constexpr const char* DEFAULT_OUTPUT = "sweep_results.csv";
+
+  /// Largest grid accepted
+  static constexpr size_t MAX_POINTS = 100000;
+
+private:
+  std::vector<SweepAxis> axes_;           ///< Swept parameters
+  uint32_t jobs_{0};                      ///< Concurrent runs (0 = hardware threads)
+  std::string output_{DEFAULT_OUTPUT};    ///< Results table
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_PARAMETER_SWEEP_HPP
@@ -0,0 +1,114 @@
+/**
+ * @file partition_plan.hpp
+ * @brief Assignment of nodes to the processes of a distributed simulation
+ *
+ * This file contains the PartitionPlan class which decides which worker
+ * process (rank) hosts each node.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_PARTITION_PLAN_HPP
+#define SIMULATOR_PARTITION_PLAN_HPP
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "simulator/config_loader.hpp"
+
+namespace simulator {
+
+/**
+ * @brief How nodes are split across ranks
+ */
+enum class PartitionStrategy {
+  BLOCK,     ///< Contiguous blocks in configuration order
+  LOCALITY   ///< Recursive bisection of node positions
+};
+
+/**
+ * @brief Parses a partition strategy name
+ *
+ * @param name "block" or "locality"
+ * @return Matching strategy
+ *
+ * @throws std::invalid_argument if the name is unknown
+ */
+PartitionStrategy stringToPartitionStrategy(const std::string& name);
+
+/**
+ * @brief Node-to-rank assignment shared by every process
+ *
+ * Every process builds the plan from the same scenario, so they agree on
+ * it without exchanging it. Both strategies give each rank ceil(n / ranks)
+ * or floor(n / ranks) nodes. LOCALITY keeps nodes that are close to each
+ * other on the same rank, which keeps most links, and so most traffic,
+ * inside one process.
+ *
+ * Example usage:
+ * @code
+ * auto plan = PartitionPlan::build(config.nodes, 4, PartitionStrategy::LOCALITY);
+ * for (uint32_t id : plan.getNodes(rank)) { ... }
+ * @endcode
+ */
+class PartitionPlan {
+public:
+  /**
+   * @brief Splits nodes across ranks
+   *
+   * @param nodes Scenario nodes (nodeId must be set)
+   * @param ranks Number of worker processes
+   * @param strategy Split strategy
+   * @return The plan
+   *
+   * @throws std::invalid_argument if ranks is 0, a node ID repeats, or
+   *         LOCALITY is used with a node without an [x, y] position
+   */
+  static PartitionPlan build(const std::vector<NodeConfigExtended>& nodes,
+                             uint32_t ranks, PartitionStrategy strategy);
+
+  /**
+   * @brief Gets the rank hosting a node
+   *
+   * @param nodeId Node identifier
+   * @return Rank of the node
+   *
+   * @throws std::out_of_range if the node is not in the plan
+   */
+  uint32_t getRank(uint32_t nodeId) const;
+
+  /**
+   * @brief Checks if a node is in the plan
+   *
+   * @param nodeId Node identifier
+   * @return true if some rank hosts the node
+   */
+  bool contains(uint32_t nodeId) const { return ranks_.count(nodeId) > 0; }
+
+  /**
+   * @brief Gets the nodes hosted by a rank
+   *
+   * @param rank Rank to query
+   * @return Node IDs in configuration order (empty for unknown ranks)
+   */
+  std::vector<uint32_t> getNodes(uint32_t rank) const;
+
+  /**
+   * @brief Gets the number of ranks
+   *
+   * @return Rank count
+   */
+  uint32_t getRankCount() const { return rank_count_; }
+
+private:
+  std::map<uint32_t, uint32_t> ranks_;  ///< Node ID -> rank
+  std::vector<uint32_t> order_;         ///< Node IDs in configuration order
+  uint32_t rank_count_{0};              ///< Number of ranks
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_PARTITION_PLAN_HPP
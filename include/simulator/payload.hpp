@@ -0,0 +1,159 @@
+/**
+ * @file payload.hpp
+ * @brief Immutable, reference-counted message payloads
+ *
+ * This file contains the Payload class which lets one message buffer be
+ * shared by every hop and receiver of a frame instead of being copied
+ * per recipient.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_PAYLOAD_HPP
+#define SIMULATOR_PAYLOAD_HPP
+
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+#include <string>
+
+namespace simulator {
+
+/**
+ * @brief Immutable view into a shared, reference-counted byte buffer
+ *
+ * A Payload owns its bytes through a shared_ptr, so copying a Payload only
+ * bumps a reference count. slice() returns a view into the same buffer,
+ * e.g. the body of a frame without its header. The bytes are never
+ * modified once constructed, so payloads are safe to share between any
+ * number of queued messages.
+ *
+ * Payload converts implicitly from std::string (taking one copy, or none
+ * when the string is moved in) and compares by content with strings.
+ *
+ * Example usage:
+ * @code
+ * Payload frame(std::move(encoded));           // Single allocation
+ * for (uint32_t neighbour : neighbours) {
+ *   sim.enqueueMessage(self, neighbour, frame, now);  // No copies
+ * }
+ * Payload body = frame.slice(HEADER_SIZE);     // Still no copy
+ * std::string text = body.str();               // Copy only when needed
+ * @endcode
+ */
+class Payload {
+public:
+  /**
+   * @brief Construct an empty payload
+   */
+  Payload() = default;
+
+  /**
+   * @brief Construct a payload from a string
+   *
+   * @param data Bytes to own (moved into the shared buffer)
+   */
+  Payload(std::string data);
+
+  /**
+   * @brief Construct a payload from a C string
+   *
+   * @param data Null-terminated bytes to copy
+   */
+  Payload(const char* data);
+
+  /**
+   * @brief Construct a payload from a byte range
+   *
+   * @param data Bytes to copy
+   * @param size Number of bytes
+   */
+  Payload(const char* data, size_t size);
+
+  /**
+   * @brief Gets a pointer to the first byte
+   *
+   * @return Pointer valid while any Payload shares the buffer
+   */
+  const char* data() const;
+
+  /**
+   * @brief Gets the number of bytes in the view
+   */
+  size_t size() const { return size_; }
+
+  /**
+   * @brief Checks whether the view is empty
+   */
+  bool empty() const { return size_ == 0; }
+
+  /**
+   * @brief Gets a byte of the view (unchecked)
+   */
+  char operator[](size_t index) const { return data()[index]; }
+
+  /**
+   * @brief Gets a view of the bytes from an offset to the end
+   *
+   * @param offset Start of the view
+   * @return Payload sharing this buffer
+   * @throws std::out_of_range if offset > size()
+   */
+  Payload slice(size_t offset) const;
+
+  /**
+   * @brief Gets a view of a byte range
+   *
+   * @param offset Start of the view
+   * @param length Maximum number of bytes (clamped to the end)
+   * @return Payload sharing this buffer
+   * @throws std::out_of_range if offset > size()
+   */
+  Payload slice(size_t offset, size_t length) const;
+
+  /**
+   * @brief Copies the view into a string
+   *
+   * @return New string holding the bytes
+   */
+  std::string str() const { return std::string(data(), size_); }
+
+  /**
+   * @brief Gets the number of Payloads sharing the buffer
+   *
+   * @return Reference count, or 0 for a default-constructed payload
+   */
+  long useCount() const { return buffer_.use_count(); }
+
+  /**
+   * @brief Checks whether two payloads share one buffer
+   */
+  bool sharesBufferWith(const Payload& other) const {
+    return buffer_ && buffer_ == other.buffer_;
+  }
+
+private:
+  std::shared_ptr<const std::string> buffer_;  ///< Shared bytes (null if empty)
+  size_t offset_{0};                           ///< Start of the view
+  size_t size_{0};                             ///< Length of the view
+};
+
+bool operator==(const Payload& lhs, const Payload& rhs);
+bool operator==(const Payload& lhs, const std::string& rhs);
+bool operator==(const Payload& lhs, const char* rhs);
+
+inline bool operator==(const std::string& lhs, const Payload& rhs) { return rhs == lhs; }
+inline bool operator==(const char* lhs, const Payload& rhs) { return rhs == lhs; }
+inline bool operator!=(const Payload& lhs, const Payload& rhs) { return !(lhs == rhs); }
+inline bool operator!=(const Payload& lhs, const std::string& rhs) { return !(lhs == rhs); }
+inline bool operator!=(const Payload& lhs, const char* rhs) { return !(lhs == rhs); }
+
+/**
+ * @brief Writes the payload bytes to a stream
+ */
+std::ostream& operator<<(std::ostream& os, const Payload& payload);
+
+} // namespace simulator
+
+#endif // SIMULATOR_PAYLOAD_HPP
@@ -0,0 +1,120 @@
+/**
+ * @file scenario_cache.hpp
+ * @brief Compiled binary scenarios
+ *
+ * This file contains the ScenarioCache class which stores an expanded and
+ * validated ScenarioConfig as a binary image next to its YAML file, so
+ * later runs of the same scenario skip parsing, template expansion and
+ * validation.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_SCENARIO_CACHE_HPP
+#define SIMULATOR_SCENARIO_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <boost/optional.hpp>
+#include "simulator/checkpoint.hpp"
+#include "simulator/config_loader.hpp"
+
+namespace simulator {
+
+/**
+ * @brief Compiled scenario images keyed by content hash
+ *
+ * An image is only used when its key matches the one computed for the
+ * current run, so editing the YAML file (or anything else folded into the
+ * key) silently recompiles it. Stale, truncated or foreign images are
+ * treated as a miss, never as an error.
+ *
+ * File layout: magic "PMSCEN01", format version, key, payload size, then
+ * the configuration in CheckpointWriter encoding. Nodes that share a
+ * firmware configuration share it again after loading.
+ *
+ * Example usage:
+ * @code
+ * uint64_t key = ScenarioCache::hash(yaml_text);
+ * auto config = ScenarioCache::load(ScenarioCache::pathFor(file), key);
+ * if (!config) {
+ *   config = compile(yaml_text);  // parse, expand, validate
+ *   ScenarioCache::save(ScenarioCache::pathFor(file), key, *config);
+ * }
+ * @endcode
+ */
+class ScenarioCache {
+public:
+  /// Current image format version
+  static constexpr uint32_t VERSION = 9;
+
+  /// Initial value of hash() (64-bit FNV-1a offset basis)
+  static constexpr uint64_t HASH_BASIS = 0xcbf29ce484222325ULL;
+
+  /**
+   * @brief Hashes bytes with 64-bit FNV-1a
+   *
+   * @param data First byte
+   * @param size Number of bytes
+   * @param basis Previous hash, to chain several inputs into one key
+   * @return Hash
+   */
+  static uint64_t hashBytes(const void* data, size_t size, uint64_t basis = HASH_BASIS);
+
+  /**
+   * @brief Hashes a string with 64-bit FNV-1a
+   */
+  static uint64_t hash(const std::string& bytes, uint64_t basis = HASH_BASIS) {
+    return hashBytes(bytes.data(), bytes.size(), basis);
+  }
+
+  /**
+   * @brief Gets the image path used for a scenario file
+   *
+   * @param config_file YAML scenario path
+   * @return config_file with ".pmsc" appended
+   */
+  static std::string pathFor(const std::string& config_file) { return config_file + ".pmsc"; }
+
+  /**
+   * @brief Maps an image and reads its configuration
+   *
+   * @param path Image path
+   * @param key Expected key
+   * @return Configuration, or empty if the image is missing, has another
+   *         key or version, or is malformed
+   */
+  static boost::optional<ScenarioConfig> load(const std::string& path, uint64_t key);
+
+  /**
+   * @brief Writes an image
+   *
+   * The image is written to a temporary file and renamed into place, so
+   * concurrent runs never map a half-written image.
+   *
+   * @param path Image path
+   * @param key Key of the configuration
+   * @param config Expanded and validated configuration
+   *
+   * @throws std::runtime_error if the file cannot be written
+   */
+  static void save(const std::string& path, uint64_t key, const ScenarioConfig& config);
+
+  /**
+   * @brief Serializes a configuration
+   */
+  static void write(CheckpointWriter& out, const ScenarioConfig& config);
+
+  /**
+   * @brief Deserializes a configuration
+   *
+   * @throws std::runtime_error if the buffer is truncated or malformed
+   */
+  static ScenarioConfig read(CheckpointReader& in);
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_SCENARIO_CACHE_HPP
@@ -0,0 +1,171 @@
+/**
+ * @file shard_mailbox.hpp
+ * @brief Messages exchanged between node shards and the transport
+ *
+ * This file contains the message types and mailbox aliases used by a
+ * sharded NodeManager to keep in-process transport traffic off the worker
+ * threads.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_SHARD_MAILBOX_HPP
+#define SIMULATOR_SHARD_MAILBOX_HPP
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "simulator/payload.hpp"
+#include "simulator/spsc_queue.hpp"
+
+namespace simulator {
+
+/**
+ * @brief A send posted by firmware on a worker thread
+ *
+ * Replayed into the MeshTransport by the coordinating thread in
+ * (time_ms, order) order, which does not depend on how nodes are split
+ * into shards.
+ */
+struct OutgoingMessage {
+  /// Destination meaning "broadcast" (node IDs are always non-zero)
+  static constexpr uint32_t BROADCAST = 0;
+
+  uint32_t from{0};        ///< Sending node ID
+  uint32_t dest{0};        ///< Destination node ID, or BROADCAST
+  std::string msg;         ///< Message content
+  Payload frame;           ///< Broadcast frame from MeshTransport::encodeBroadcast(), replaces msg
+  uint64_t time_ms{0};     ///< Simulated time of the send
+  uint64_t order{0};       ///< Tie-break within time_ms (see Outbox)
+
+  /**
+   * @brief Replay order: by time, then by the step that sent it
+   */
+  bool operator<(const OutgoingMessage& other) const {
+    return time_ms != other.time_ms ? time_ms < other.time_ms : order < other.order;
+  }
+};
+
+/**
+ * @brief A transport delivery waiting for its node's worker thread
+ */
+struct IncomingMessage {
+  uint32_t from{0};        ///< Source node ID
+  uint32_t to{0};          ///< Receiving node ID
+  Payload msg;             ///< Message content (shared with other receivers)
+  uint64_t time_ms{0};     ///< Simulated time the transport delivered it
+  uint64_t sequence{0};    ///< Global delivery number (transport order)
+};
+
+/// Coordinating thread -> the worker thread running the node
+using Inbox = Mailbox<IncomingMessage>;
+
+/**
+ * @brief Worker thread -> coordinating thread, stamping each send
+ *
+ * The worker tells the outbox which step it is running before handing
+ * control to node code. Sends made while handling a delivery are ordered
+ * by that delivery's sequence number; sends made during a node update
+ * come after all deliveries of the same tick and are ordered by sender
+ * ID. A node's own sends keep their order because a node posts to one
+ * outbox only, is run by one thread at a time, and the replay sort is
+ * stable.
+ */
+class Outbox {
+public:
+  /// Order bit marking sends made during node updates
+  static constexpr uint64_t UPDATE_ORDER = 1ULL << 63;
+
+  /**
+   * @brief Construct an outbox
+   *
+   * @param capacity Sends held before posting spills (see Mailbox)
+   */
+  explicit Outbox(size_t capacity = Mailbox<OutgoingMessage>::DEFAULT_CAPACITY)
+    : mailbox_(capacity) {}
+
+  /**
+   * @brief Stamps following sends as reactions to a delivery
+   *
+   * @param time_ms Simulated time of the delivery
+   * @param sequence Sequence number of the delivery
+   */
+  void beginDelivery(uint64_t time_ms, uint64_t sequence) {
+    time_ms_ = time_ms;
+    order_ = sequence;
+  }
+
+  /**
+   * @brief Stamps following sends as made during node updates
+   *
+   * @param time_ms Simulated time of the update
+   */
+  void beginUpdate(uint64_t time_ms) {
+    time_ms_ = time_ms;
+    order_ = UPDATE_ORDER;
+  }
+
+  /**
+   * @brief Posts a send (producer side)
+   *
+   * @param from Sending node ID
+   * @param dest Destination node ID, or OutgoingMessage::BROADCAST
+   * @param msg Message content
+   */
+  void post(uint32_t from, uint32_t dest, std::string msg) {
+    OutgoingMessage message;
+    message.from = from;
+    message.dest = dest;
+    message.msg = std::move(msg);
+    postStamped(message);
+  }
+
+  /**
+   * @brief Posts a pre-encoded broadcast (producer side)
+   *
+   * @param from Sending node ID
+   * @param frame Frame from MeshTransport::encodeBroadcast() (shared, not copied)
+   */
+  void postFrame(uint32_t from, Payload frame) {
+    OutgoingMessage message;
+    message.from = from;
+    message.dest = OutgoingMessage::BROADCAST;
+    message.frame = std::move(frame);
+    postStamped(message);
+  }
+
+  /**
+   * @brief Hands every posted send to a visitor in posting order
+   *
+   * @param visitor Callable taking OutgoingMessage&
+   * @return Number of sends drained
+   */
+  template <typename Visitor>
+  size_t drain(Visitor&& visitor) {
+    return mailbox_.drain(std::forward<Visitor>(visitor));
+  }
+
+  /**
+   * @brief Gets the number of posted, undrained sends
+   *
+   * @return Send count (exact only between phases)
+   */
+  size_t size() const { return mailbox_.size(); }
+
+private:
+  void postStamped(OutgoingMessage& message) {
+    message.time_ms = time_ms_;
+    message.order = order_ == UPDATE_ORDER ? UPDATE_ORDER | message.from : order_;
+    mailbox_.post(std::move(message));
+  }
+
+  Mailbox<OutgoingMessage> mailbox_;  ///< Underlying SPSC mailbox
+  uint64_t time_ms_{0};               ///< Stamp for the current step
+  uint64_t order_{UPDATE_ORDER};      ///< Order for the current step
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_SHARD_MAILBOX_HPP
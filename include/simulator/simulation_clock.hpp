@@ -0,0 +1,186 @@
+/**
+ * @file simulation_clock.hpp
+ * @brief Virtual simulation clock for real-time and unbounded runs
+ *
+ * This file contains the SimulationClock class which provides the single
+ * source of simulated time for the simulation loop. The clock can either
+ * pace itself against the wall clock (scaled by time_scale) or jump
+ * straight to the next due work item for maximum speed.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_SIMULATION_CLOCK_HPP
+#define SIMULATOR_SIMULATION_CLOCK_HPP
+
+#include <cstdint>
+#include <chrono>
+
+namespace simulator {
+
+/**
+ * @brief Time scale value that selects unbounded (as fast as possible) mode
+ */
+constexpr float TIME_SCALE_UNBOUNDED = 0.0f;
+
+/**
+ * @brief Virtual clock driving the simulation loop
+ *
+ * The SimulationClock keeps simulated time in microseconds since the start
+ * of the simulation. Time only moves when advanceTo() is called, so every
+ * component that reads the clock during a tick sees the same timestamp.
+ *
+ * Two modes are supported:
+ * - REAL_TIME: advanceTo() sleeps until the wall clock catches up with the
+ *   requested virtual time, scaled by the configured time scale.
+ * - UNBOUNDED: advanceTo() jumps immediately, so idle stretches of the
+ *   scenario cost no wall time at all.
+ *
+ * Example usage:
+ * @code
+ * SimulationClock clock(config.simulation.time_scale);
+ * clock.start();
+ *
+ * while (running) {
+ *   manager.updateAll();
+ *   clock.advanceBy(SimulationClock::DEFAULT_TICK_US);
+ * }
+ * @endcode
+ *
+ * @note SimulationClock is not thread-safe. It should be advanced only by
+ *       the thread running the simulation loop.
+ */
+class SimulationClock {
+public:
+  /**
+   * @brief Clock pacing mode
+   */
+  enum class Mode {
+    REAL_TIME,   ///< Paced against the wall clock (scaled)
+    UNBOUNDED    ///< Jump to the next due item without sleeping
+  };
+
+  /**
+   * @brief Default simulation tick in microseconds (10ms)
+   *
+   * Used as the upper bound of a single clock advance while work sources
+   * without a known deadline (e.g. TaskScheduler tasks) are active.
+   */
+  static constexpr uint64_t DEFAULT_TICK_US = 10000;
+
+  /**
+   * @brief Construct a clock with the given time scale
+   *
+   * @param time_scale Time scale multiplier (1.0 = real-time,
+   *                   TIME_SCALE_UNBOUNDED = as fast as possible)
+   *
+   * @throws std::invalid_argument if time_scale is negative
+   */
+  explicit SimulationClock(float time_scale = 1.0f);
+
+  /**
+   * @brief Starts (or restarts) the clock
+   *
+   * Anchors the clock to the current wall time. Must be called before the
+   * simulation loop begins. Pacing and getSpeedup() count from the start
+   * time, so a run resumed from a checkpoint does not sleep through the
+   * time it skipped.
+   *
+   * @param start_us Virtual time to start at (0, or a checkpoint's time)
+   */
+  void start(uint64_t start_us = 0);
+
+  /**
+   * @brief Gets the current virtual time in microseconds
+   *
+   * @return Microseconds of simulated time since start()
+   */
+  uint64_t nowUs() const { return now_us_; }
+
+  /**
+   * @brief Gets the current virtual time in milliseconds
+   *
+   * @return Milliseconds of simulated time since start()
+   */
+  uint64_t nowMs() const { return now_us_ / 1000; }
+
+  /**
+   * @brief Advances the virtual clock to the given time
+   *
+   * In REAL_TIME mode this blocks until the scaled wall clock reaches the
+   * target; if the wall clock is already past it, the step overran and is
+   * counted (getOverrunCount()). In UNBOUNDED mode it returns immediately.
+   * Targets in the past are ignored, so virtual time never moves
+   * backwards.
+   *
+   * @param target_us Target virtual time in microseconds
+   */
+  void advanceTo(uint64_t target_us);
+
+  /**
+   * @brief Advances the virtual clock by a relative amount
+   *
+   * @param delta_us Microseconds to advance
+   */
+  void advanceBy(uint64_t delta_us) { advanceTo(now_us_ + delta_us); }
+
+  /**
+   * @brief Gets the pacing mode
+   *
+   * @return REAL_TIME or UNBOUNDED
+   */
+  Mode getMode() const { return mode_; }
+
+  /**
+   * @brief Gets the configured time scale
+   *
+   * @return Time scale multiplier (TIME_SCALE_UNBOUNDED in unbounded mode)
+   */
+  float getTimeScale() const { return time_scale_; }
+
+  /**
+   * @brief Gets the wall time elapsed since start()
+   *
+   * @return Wall-clock microseconds since start()
+   */
+  uint64_t wallElapsedUs() const;
+
+  /**
+   * @brief Gets the ratio of simulated time to wall time
+   *
+   * @return Virtual time since start()/wall time ratio, or 0.0 if no wall time has elapsed
+   */
+  double getSpeedup() const;
+
+  /**
+   * @brief Gets the number of advances that found their deadline passed
+   *
+   * A REAL_TIME advance overruns when the work done since the previous
+   * one took longer than the step's share of wall time.
+   *
+   * @return Overrun count since start() (always 0 in UNBOUNDED mode)
+   */
+  uint64_t getOverrunCount() const { return overruns_; }
+
+  /**
+   * @brief Gets the worst lag of an overrun
+   *
+   * @return Wall-clock microseconds the latest overrun deadline was
+   *         missed by, 0 without overruns
+   */
+  uint64_t getMaxLagUs() const { return max_lag_us_; }
+
+private:
+  Mode mode_;                                           ///< Pacing mode
+  float time_scale_;                                    ///< Time scale multiplier
+  uint64_t now_us_{0};                                  ///< Current virtual time (us)
+  uint64_t start_us_{0};                                ///< Virtual time at start()
+  uint64_t overruns_{0};                                ///< Advances past their deadline
+  uint64_t max_lag_us_{0};                              ///< Worst missed deadline (us)
+  std::chrono::steady_clock::time_point wall_start_;    ///< Wall time at start()
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_SIMULATION_CLOCK_HPP
@@ -0,0 +1,199 @@
+/**
+ * @file slot_map.hpp
+ * @brief Dense storage with stable, generation-checked handles
+ *
+ * This file contains the SlotMap class template used by NodeManager to
+ * keep its nodes in one contiguous array.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_SLOT_MAP_HPP
+#define SIMULATOR_SLOT_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace simulator {
+
+/**
+ * @brief Reference to a value in a SlotMap
+ *
+ * A handle stays valid while its value lives, wherever the value moves
+ * inside the map. After erase() the slot's generation changes, so old
+ * handles no longer resolve even once the slot is reused.
+ */
+struct SlotHandle {
+  /// Index of a handle that refers to nothing
+  static constexpr uint32_t NONE = UINT32_MAX;
+
+  uint32_t index{NONE};     ///< Slot index
+  uint32_t generation{0};   ///< Generation of the slot when issued
+
+  /**
+   * @brief Checks if the handle was issued by a map
+   *
+   * @return false for default-constructed handles
+   */
+  bool valid() const { return index != NONE; }
+
+  bool operator==(const SlotHandle& other) const {
+    return index == other.index && generation == other.generation;
+  }
+
+  bool operator!=(const SlotHandle& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief Values in a contiguous array, addressed through stable handles
+ *
+ * Values live back to back in insertion order, so iterating them walks
+ * memory linearly. erase() moves the last value into the hole, which
+ * keeps the array dense in O(1) but changes the order of the remaining
+ * values. Handles go through a small indirection table to find their
+ * value's current position.
+ *
+ * Example usage:
+ * @code
+ * SlotMap<Record> records;
+ * SlotHandle handle = records.insert(Record{...});
+ * records.get(handle)->count++;
+ * for (Record& record : records) { ... }   // dense iteration
+ * records.erase(handle);
+ * @endcode
+ *
+ * @tparam T Movable value type
+ */
+template <typename T>
+class SlotMap {
+public:
+  /// Largest number of values
+  static constexpr size_t MAX_SIZE = UINT32_MAX - 1;
+
+  /**
+   * @brief Adds a value at the end of the array
+   *
+   * @param value Value to store
+   * @return Handle of the new value
+   *
+   * @throws std::length_error if the map already holds MAX_SIZE values
+   */
+  SlotHandle insert(T value) {
+    if (values_.size() >= MAX_SIZE) {
+      throw std::length_error("Slot map is full");
+    }
+
+    uint32_t index;
+    if (!free_.empty()) {
+      index = free_.back();
+      free_.pop_back();
+    } else {
+      index = static_cast<uint32_t>(slots_.size());
+      slots_.push_back(Slot());
+    }
+
+    slots_[index].dense = static_cast<uint32_t>(values_.size());
+    values_.push_back(std::move(value));
+    owners_.push_back(index);
+    return SlotHandle{index, slots_[index].generation};
+  }
+
+  /**
+   * @brief Removes a value
+   *
+   * @param handle Handle of the value
+   * @return false if the handle does not refer to a live value
+   */
+  bool erase(SlotHandle handle) {
+    if (!contains(handle)) {
+      return false;
+    }
+
+    Slot& slot = slots_[handle.index];
+    const uint32_t hole = slot.dense;
+    const uint32_t last = static_cast<uint32_t>(values_.size() - 1);
+    if (hole != last) {
+      values_[hole] = std::move(values_[last]);
+      owners_[hole] = owners_[last];
+      slots_[owners_[hole]].dense = hole;
+    }
+    values_.pop_back();
+    owners_.pop_back();
+
+    slot.dense = SlotHandle::NONE;
+    slot.generation++;
+    free_.push_back(handle.index);
+    return true;
+  }
+
+  /**
+   * @brief Checks if a handle refers to a live value
+   *
+   * @param handle Handle to check
+   * @return true if get() would return a value
+   */
+  bool contains(SlotHandle handle) const {
+    return handle.index < slots_.size() &&
+           slots_[handle.index].generation == handle.generation &&
+           slots_[handle.index].dense != SlotHandle::NONE;
+  }
+
+  /**
+   * @brief Looks up a value
+   *
+   * @param handle Handle of the value
+   * @return Pointer to the value (valid until the next insert() or
+   *         erase()), or nullptr if the handle is stale
+   */
+  T* get(SlotHandle handle) {
+    return contains(handle) ? &values_[slots_[handle.index].dense] : nullptr;
+  }
+
+  /**
+   * @brief Looks up a value (const version)
+   *
+   * @param handle Handle of the value
+   * @return Pointer to the value, or nullptr if the handle is stale
+   */
+  const T* get(SlotHandle handle) const {
+    return contains(handle) ? &values_[slots_[handle.index].dense] : nullptr;
+  }
+
+  /**
+   * @brief Gets the number of values
+   *
+   * @return Value count
+   */
+  size_t size() const { return values_.size(); }
+
+  /**
+   * @brief Checks if the map is empty
+   *
+   * @return true if there are no values
+   */
+  bool empty() const { return values_.empty(); }
+
+  typename std::vector<T>::iterator begin() { return values_.begin(); }
+  typename std::vector<T>::iterator end() { return values_.end(); }
+  typename std::vector<T>::const_iterator begin() const { return values_.begin(); }
+  typename std::vector<T>::const_iterator end() const { return values_.end(); }
+
+private:
+  struct Slot {
+    uint32_t dense{SlotHandle::NONE};   ///< Position in values_, or NONE if free
+    uint32_t generation{0};             ///< Bumped on every erase
+  };
+
+  std::vector<T> values_;          ///< Live values, densely packed
+  std::vector<uint32_t> owners_;   ///< Slot index of each value
+  std::vector<Slot> slots_;        ///< Handle indirection table
+  std::vector<uint32_t> free_;     ///< Slots free for reuse
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_SLOT_MAP_HPP
@@ -0,0 +1,161 @@
+/**
+ * @file spatial_grid.hpp
+ * @brief Uniform grid index over node positions
+ *
+ * This file contains the SpatialGrid class which buckets node positions
+ * into square cells so range queries only visit nearby nodes.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_SPATIAL_GRID_HPP
+#define SIMULATOR_SPATIAL_GRID_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace simulator {
+
+/**
+ * @brief 2D position in meters
+ */
+struct Position {
+  double x = 0.0;  ///< X coordinate in meters
+  double y = 0.0;  ///< Y coordinate in meters
+};
+
+/**
+ * @brief Uniform grid of node positions
+ *
+ * Space is cut into square cells of a fixed size; each cell lists the
+ * nodes inside it. A query with a radius up to the cell size looks at the
+ * 3x3 cells around its center, so with nodes spread over the area it
+ * costs O(k) for k nodes nearby instead of O(n).
+ *
+ * Moving a node only touches its old and new cell, and nothing at all
+ * while it stays within one cell.
+ *
+ * Example usage:
+ * @code
+ * SpatialGrid grid(100.0);
+ * grid.insert(1001, {0.0, 0.0});
+ * grid.insert(1002, {60.0, 0.0});
+ * grid.forEachWithin({0.0, 0.0}, 100.0, [](uint32_t id, double distance) { ... });
+ * @endcode
+ */
+class SpatialGrid {
+public:
+  /// Visitor for range queries: node ID and distance in meters
+  using Visitor = std::function<void(uint32_t nodeId, double distance)>;
+
+  /**
+   * @brief Construct an empty grid
+   *
+   * @param cell_size Cell edge length in meters; use the usual query radius
+   *
+   * @throws std::invalid_argument if cell_size is not positive
+   */
+  explicit SpatialGrid(double cell_size);
+
+  /**
+   * @brief Adds a node, or moves it if already present
+   *
+   * @param nodeId Node ID
+   * @param position Node position
+   */
+  void insert(uint32_t nodeId, const Position& position);
+
+  /**
+   * @brief Moves a node
+   *
+   * @param nodeId Node ID
+   * @param position New position
+   * @return true if the node changed cells
+   *
+   * @throws std::out_of_range if the node is not in the grid
+   */
+  bool move(uint32_t nodeId, const Position& position);
+
+  /**
+   * @brief Removes a node
+   *
+   * @param nodeId Node ID
+   * @return true if the node was in the grid
+   */
+  bool remove(uint32_t nodeId);
+
+  /**
+   * @brief Checks whether a node is in the grid
+   */
+  bool contains(uint32_t nodeId) const { return entries_.count(nodeId) > 0; }
+
+  /**
+   * @brief Gets the position of a node
+   *
+   * @throws std::out_of_range if the node is not in the grid
+   */
+  const Position& getPosition(uint32_t nodeId) const { return entries_.at(nodeId).position; }
+
+  /**
+   * @brief Visits every node within a radius of a point
+   *
+   * Nodes are visited in no particular order, including one sitting
+   * exactly on the point.
+   *
+   * @param center Query point
+   * @param radius Radius in meters
+   * @param visitor Called once per node within the radius
+   */
+  void forEachWithin(const Position& center, double radius, const Visitor& visitor) const;
+
+  /**
+   * @brief Gets the nodes within a radius of another node
+   *
+   * @param nodeId Node ID (excluded from the result)
+   * @param radius Radius in meters
+   * @return Node IDs in ascending order
+   */
+  std::vector<uint32_t> getNeighbours(uint32_t nodeId, double radius) const;
+
+  /**
+   * @brief Gets all nodes in the grid
+   *
+   * @return Node IDs in ascending order
+   */
+  std::vector<uint32_t> getNodeIds() const;
+
+  /**
+   * @brief Gets the number of nodes
+   */
+  size_t size() const { return entries_.size(); }
+
+  /**
+   * @brief Gets the cell edge length in meters
+   */
+  double getCellSize() const { return cell_size_; }
+
+private:
+  struct Entry {
+    Position position;   ///< Node position
+    uint64_t cell;       ///< Key of the cell holding the node
+    uint32_t slot;       ///< Index of the node in its cell list
+  };
+
+  double cell_size_;
+  std::unordered_map<uint32_t, Entry> entries_;                 ///< Node ID -> entry
+  std::unordered_map<uint64_t, std::vector<uint32_t>> cells_;   ///< Cell key -> node IDs
+
+  int64_t cellCoord(double value) const;
+  static uint64_t cellKey(int64_t cx, int64_t cy);
+  uint64_t cellOf(const Position& position) const;
+  void unlink(const Entry& entry);
+  void link(uint32_t nodeId, Entry& entry);
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_SPATIAL_GRID_HPP
@@ -0,0 +1,218 @@
+/**
+ * @file spsc_queue.hpp
+ * @brief Lock-free single-producer single-consumer ring buffer
+ *
+ * This file contains the SpscQueue class template used to pass messages
+ * between simulation threads without locks, and the Mailbox wrapper that
+ * adds an overflow list for bulk-synchronous use.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_SPSC_QUEUE_HPP
+#define SIMULATOR_SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace simulator {
+
+/**
+ * @brief Bounded lock-free queue for exactly one producer and one consumer
+ *
+ * The producer only writes the tail index and the consumer only writes the
+ * head index, so each side needs a single acquire load and a single release
+ * store per operation. The indices are padded onto separate cache lines to
+ * keep the two threads from invalidating each other's line on every push
+ * and pop. Padding is used instead of alignas because C++14 does not
+ * guarantee over-aligned heap allocation.
+ *
+ * Capacity is rounded up to a power of two. tryPush() fails when the queue
+ * is full rather than blocking, so the caller chooses the back-pressure
+ * policy.
+ *
+ * @tparam T Element type (must be default-constructible and movable)
+ */
+template <typename T>
+class SpscQueue {
+public:
+  /**
+   * @brief Construct an empty queue
+   *
+   * @param capacity Maximum number of queued elements (rounded up to a
+   *                 power of two)
+   *
+   * @throws std::invalid_argument if capacity is 0
+   */
+  explicit SpscQueue(size_t capacity) {
+    if (capacity == 0) {
+      throw std::invalid_argument("SPSC queue capacity must be non-zero");
+    }
+    size_t size = 1;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    buffer_.resize(size);
+    mask_ = size - 1;
+  }
+
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+
+  /**
+   * @brief Appends an element (producer side)
+   *
+   * @param value Element to append; left untouched if the queue is full
+   * @return true if queued, false if the queue is full
+   */
+  bool tryPush(T&& value) {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_cache_ > mask_) {
+      head_cache_ = head_.load(std::memory_order_acquire);
+      if (tail - head_cache_ > mask_) {
+        return false;
+      }
+    }
+    buffer_[tail & mask_] = std::move(value);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Removes the oldest element (consumer side)
+   *
+   * @param out Receives the element
+   * @return true if an element was removed, false if the queue is empty
+   */
+  bool tryPop(T& out) {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_cache_) {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      if (head == tail_cache_) {
+        return false;
+      }
+    }
+    out = std::move(buffer_[head & mask_]);
+    buffer_[head & mask_] = T();  // Release resources held by the slot
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Gets an estimate of the number of queued elements
+   *
+   * Exact when neither side is running concurrently.
+   *
+   * @return Number of queued elements
+   */
+  size_t size() const {
+    return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Checks if the queue is empty
+   *
+   * @return true if no elements are queued
+   */
+  bool empty() const { return size() == 0; }
+
+  /**
+   * @brief Gets the maximum number of queued elements
+   *
+   * @return Queue capacity
+   */
+  size_t capacity() const { return buffer_.size(); }
+
+private:
+  static constexpr size_t CACHE_LINE = 64;
+
+  std::vector<T> buffer_;                ///< Ring storage (power-of-two size)
+  size_t mask_;                          ///< buffer_.size() - 1
+  char pad0_[CACHE_LINE];                ///< Keeps consumer fields off the producer's line
+  std::atomic<size_t> head_{0};          ///< Next slot to pop (consumer)
+  size_t tail_cache_{0};                 ///< Consumer's copy of tail_
+  char pad1_[CACHE_LINE];                ///< Keeps producer fields off the consumer's line
+  std::atomic<size_t> tail_{0};          ///< Next slot to push (producer)
+  size_t head_cache_{0};                 ///< Producer's copy of head_
+  char pad2_[CACHE_LINE];                ///< Keeps neighbouring objects off the producer's line
+};
+
+/**
+ * @brief SPSC queue with an overflow list for phase-separated threads
+ *
+ * In a bulk-synchronous loop the consumer may not run while the producer
+ * fills the queue, so a full ring cannot be allowed to block. Elements that
+ * do not fit go to a plain vector owned by the producer. The consumer only
+ * reads that vector in drain(), which must happen after a synchronization
+ * point (such as a thread join or barrier) that orders it after the
+ * producer's writes. drain() hands out ring elements before overflow ones,
+ * which keeps FIFO order because the overflow list only grows while the
+ * ring is full.
+ *
+ * @tparam T Element type (must be default-constructible and movable)
+ */
+template <typename T>
+class Mailbox {
+public:
+  /// Default ring capacity in elements
+  static constexpr size_t DEFAULT_CAPACITY = 1024;
+
+  /**
+   * @brief Construct an empty mailbox
+   *
+   * @param capacity Ring capacity (rounded up to a power of two)
+   */
+  explicit Mailbox(size_t capacity = DEFAULT_CAPACITY) : queue_(capacity) {}
+
+  /**
+   * @brief Posts an element (producer side)
+   *
+   * @param value Element to post
+   */
+  void post(T value) {
+    if (!overflow_.empty() || !queue_.tryPush(std::move(value))) {
+      overflow_.push_back(std::move(value));
+    }
+  }
+
+  /**
+   * @brief Hands every posted element to a visitor in posting order
+   *
+   * @param visitor Callable taking T&
+   * @return Number of elements drained
+   */
+  template <typename Visitor>
+  size_t drain(Visitor&& visitor) {
+    size_t count = 0;
+    T value;
+    while (queue_.tryPop(value)) {
+      visitor(value);
+      count++;
+    }
+    for (auto& spilled : overflow_) {
+      visitor(spilled);
+      count++;
+    }
+    overflow_.clear();
+    return count;
+  }
+
+  /**
+   * @brief Gets the number of posted, undrained elements
+   *
+   * @return Element count (exact only between phases)
+   */
+  size_t size() const { return queue_.size() + overflow_.size(); }
+
+private:
+  SpscQueue<T> queue_;      ///< Lock-free fast path
+  std::vector<T> overflow_; ///< Elements posted while the ring was full
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_SPSC_QUEUE_HPP
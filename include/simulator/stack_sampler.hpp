@@ -0,0 +1,149 @@
+/**
+ * @file stack_sampler.hpp
+ * @brief Sampling profiler of one thread's call stacks
+ *
+ * This file contains the StackSampler, which records the call stack of the
+ * thread that started it at a fixed interval of that thread's CPU time,
+ * and writes the samples as folded stacks and a list of the hottest
+ * functions.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_STACK_SAMPLER_HPP
+#define SIMULATOR_STACK_SAMPLER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace simulator {
+
+/**
+ * @brief Samples the call stacks of one thread
+ *
+ * start() arms a timer on the calling thread's CPU clock. Each expiry
+ * sends SIGPROF to that thread alone, and the handler copies the stack
+ * (backtrace()) into the next free slot of a buffer allocated up front, so
+ * the sampled thread never takes a lock or allocates. When the buffer is
+ * full, further samples are counted as dropped. Time the thread spends
+ * blocked or sleeping is not sampled.
+ *
+ * Symbols are resolved only when the samples are written (dladdr() and
+ * demangling); functions of the executable need it to be linked with
+ * exported symbols (-rdynamic), others show as module+offset.
+ *
+ * Supported on Linux with glibc; elsewhere isSupported() is false and
+ * start() throws. One sampler can run at a time in a process.
+ *
+ * Example usage:
+ * @code
+ * StackSampler sampler;
+ * sampler.start();
+ * runHotLoop();
+ * sampler.stop();
+ * sampler.printTop(std::cout, 20);
+ * sampler.writeFolded(folded_file);  // For flamegraph.pl or speedscope
+ * @endcode
+ */
+class StackSampler {
+public:
+  /// Deepest stack kept per sample
+  static constexpr size_t MAX_DEPTH = 48;
+
+  /**
+   * @brief Construct a sampler
+   *
+   * @param interval_us CPU time between samples in microseconds
+   * @param capacity Samples kept at most
+   */
+  explicit StackSampler(uint32_t interval_us = 1000, size_t capacity = 20000);
+
+  /**
+   * @brief Destructor; stops sampling
+   */
+  ~StackSampler();
+
+  StackSampler(const StackSampler&) = delete;
+  StackSampler& operator=(const StackSampler&) = delete;
+
+  /**
+   * @brief Checks whether stack sampling works on this platform
+   */
+  static bool isSupported();
+
+  /**
+   * @brief Starts sampling the calling thread
+   *
+   * Discards earlier samples.
+   *
+   * @throws std::runtime_error if unsupported, another sampler is running
+   *         or the timer cannot be created
+   */
+  void start();
+
+  /**
+   * @brief Stops sampling; the samples stay until the next start()
+   */
+  void stop();
+
+  /**
+   * @brief Checks whether the sampler is running
+   */
+  bool isRunning() const { return running_; }
+
+  /**
+   * @brief Gets the number of samples taken
+   */
+  size_t getSampleCount() const;
+
+  /**
+   * @brief Gets the number of samples lost to a full buffer
+   */
+  uint64_t getDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Writes one line per distinct stack: "outer;...;inner count"
+   *
+   * @param out Stream to write to
+   */
+  void writeFolded(std::ostream& out) const;
+
+  /**
+   * @brief Prints the functions most often on top of the stack
+   *
+   * @param out Stream to print to
+   * @param top Functions listed at most
+   */
+  void printTop(std::ostream& out, size_t top) const;
+
+private:
+  /**
+   * @brief One recorded stack, innermost frame first
+   */
+  struct Sample {
+    int depth = 0;
+    void* frames[MAX_DEPTH];
+  };
+
+  /// SIGPROF handler: records a sample into the running sampler
+  static void onSignal(int signal);
+
+  /// Resolves the frames of every sample, outermost first
+  std::vector<std::vector<const char*>> resolve(std::vector<std::string>& names) const;
+
+  uint32_t interval_us_;
+  std::vector<Sample> samples_;
+  std::atomic<size_t> next_{0};
+  std::atomic<uint64_t> dropped_{0};
+  bool running_{false};
+  void* timer_{nullptr};
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_STACK_SAMPLER_HPP
@@ -0,0 +1,176 @@
+/**
+ * @file state_dump.hpp
+ * @brief On-demand dump of a running simulation's state
+ *
+ * This file contains the StateDump class which, when asked by SIGUSR1 or a
+ * request file, writes the queue depths, pending events and per-node
+ * update costs of a running simulation, and optionally a sampling profile
+ * of the simulation thread, to the output directory.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_STATE_DUMP_HPP
+#define SIMULATOR_STATE_DUMP_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "simulator/stack_sampler.hpp"
+
+namespace simulator {
+
+class NodeManager;
+class NetworkSimulator;
+class EventScheduler;
+class MeshTransport;
+class LoopMonitor;
+
+/**
+ * @brief Writes the state of a running simulation on request
+ *
+ * A dump is requested by SIGUSR1 (installSignalHandler()) or, where there
+ * are no signals, by creating the file `dump.request` in the output
+ * directory, which is checked at most once per wall second and removed.
+ * The handler only sets a flag; the simulation thread checks it between
+ * ticks, so nothing is read while nodes update and the run never stops.
+ *
+ * begin() records what can be read at once: virtual and wall time, node
+ * states, in-flight messages, pending scheduler events, transport
+ * counters, tick and update percentiles, and the deepest task queues.
+ * It then times every node update for the measurement window (and
+ * samples the simulation thread's stacks with --dump-profile); finish()
+ * adds the costliest nodes and hottest functions and writes
+ * `state_dump_<n>.txt`, plus `state_dump_<n>.folded` for a flame graph.
+ * With a zero window the dump is written at once, without node costs.
+ *
+ * Example usage:
+ * @code
+ * StateDump::installSignalHandler();
+ * StateDump dump("results/", 1000, true);
+ * while (running) {
+ *   ... tick ...
+ *   if (dump.isCollecting()) {
+ *     if (dump.isWindowOver()) {
+ *       dump.finish();
+ *     }
+ *   } else if (dump.isRequested()) {
+ *     dump.begin(now_us, updates, manager, network, &scheduler, &transport, monitor);
+ *   }
+ * }
+ * @endcode
+ */
+class StateDump {
+public:
+  /// Nodes and task queues listed at most
+  static constexpr size_t TOP_NODES = 10;
+
+  /// Sampled functions listed at most
+  static constexpr size_t TOP_FUNCTIONS = 20;
+
+  /**
+   * @brief Construct a dumper
+   *
+   * @param output_dir Directory of the dump files and the request file
+   * @param window_ms Wall time node costs are measured for (0 = none)
+   * @param profile Sample the simulation thread during the window
+   */
+  StateDump(const std::string& output_dir, uint32_t window_ms, bool profile);
+
+  /**
+   * @brief Destructor; stops a running window without writing it
+   */
+  ~StateDump();
+
+  StateDump(const StateDump&) = delete;
+  StateDump& operator=(const StateDump&) = delete;
+
+  /**
+   * @brief Routes SIGUSR1 to request() (no-op where there is no SIGUSR1)
+   */
+  static void installSignalHandler();
+
+  /**
+   * @brief Asks for a dump; async-signal-safe
+   */
+  static void request();
+
+  /**
+   * @brief Checks for and consumes a pending request
+   *
+   * Also polls the request file, at most once per wall second.
+   */
+  bool isRequested();
+
+  /**
+   * @brief Records the state and opens the measurement window
+   *
+   * Attaches @p monitor to @p manager for the window if no monitor is
+   * attached yet. Call between ticks on the simulation thread.
+   *
+   * @param now_us Virtual time
+   * @param updates Ticks run so far
+   * @param manager Node manager
+   * @param network Network simulator
+   * @param scheduler Event scheduler, or nullptr
+   * @param transport In-process transport, or nullptr
+   * @param monitor The run's loop monitor
+   */
+  void begin(uint64_t now_us, uint32_t updates, NodeManager& manager,
+             const NetworkSimulator& network, const EventScheduler* scheduler,
+             const MeshTransport* transport, LoopMonitor& monitor);
+
+  /**
+   * @brief Checks whether a window is open
+   */
+  bool isCollecting() const { return manager_ != nullptr; }
+
+  /**
+   * @brief Checks whether the open window has lasted window_ms
+   */
+  bool isWindowOver() const;
+
+  /**
+   * @brief Closes the window and writes the dump files
+   *
+   * Failures are logged; the run goes on.
+   */
+  void finish();
+
+  /**
+   * @brief Gets the number of dumps written
+   */
+  uint32_t getDumpCount() const { return dumps_; }
+
+  /**
+   * @brief Gets the path of the last dump file
+   */
+  const std::string& getLastPath() const { return last_path_; }
+
+private:
+  /// Set by request(); read only by the simulation thread
+  static std::atomic<bool> requested_;
+
+  std::string output_dir_;
+  uint32_t window_ms_;
+  bool profile_;
+  uint32_t dumps_{0};
+  std::string last_path_;
+  std::chrono::steady_clock::time_point last_poll_;
+
+  NodeManager* manager_{nullptr};         ///< Set while a window is open
+  LoopMonitor* monitor_{nullptr};
+  bool attached_{false};                  ///< Monitor attached for the window
+  std::chrono::steady_clock::time_point started_;
+  std::string state_;                     ///< Text recorded by begin()
+  std::unique_ptr<StackSampler> sampler_;
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_STATE_DUMP_HPP
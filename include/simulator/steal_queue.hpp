@@ -0,0 +1,134 @@
+/**
+ * @file steal_queue.hpp
+ * @brief Fixed task list shared between an owner and thieves
+ *
+ * This file contains the StealQueue class template used by a sharded
+ * NodeManager to balance uneven node costs across worker threads.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_STEAL_QUEUE_HPP
+#define SIMULATOR_STEAL_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace simulator {
+
+/**
+ * @brief Task list taken from the front by its owner, from the back by thieves
+ *
+ * The list is filled with reset() while no thread is taking from it, then
+ * handed out lock-free: the owner pops from the front, so it works through
+ * its tasks in order, and idle threads steal from the back, so they take
+ * the tasks the owner would have reached last. Both ends live in one
+ * atomic word, so a task is handed out exactly once.
+ *
+ * Example usage:
+ * @code
+ * StealQueue<Task*> queue;
+ * queue.reset(tasks);                 // between phases
+ * Task* task;
+ * while (queue.pop(task)) run(task);  // owner thread
+ * if (other.steal(task)) run(task);   // any other thread
+ * @endcode
+ *
+ * @tparam T Copyable task type (typically a pointer)
+ */
+template <typename T>
+class StealQueue {
+public:
+  /// Largest number of tasks per list
+  static constexpr size_t MAX_SIZE = UINT32_MAX;
+
+  StealQueue() = default;
+  StealQueue(const StealQueue&) = delete;
+  StealQueue& operator=(const StealQueue&) = delete;
+
+  /**
+   * @brief Replaces the task list
+   *
+   * Must not run concurrently with pop() or steal(); the fork-join phase
+   * that follows publishes the new list to the other threads.
+   *
+   * @param tasks Tasks in the order the owner should run them
+   *
+   * @throws std::invalid_argument if there are more than MAX_SIZE tasks
+   */
+  void reset(const std::vector<T>& tasks) {
+    if (tasks.size() > MAX_SIZE) {
+      throw std::invalid_argument("Too many tasks for a steal queue");
+    }
+    tasks_ = tasks;
+    range_.store(static_cast<uint64_t>(tasks_.size()), std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Takes the next task from the front (owner side)
+   *
+   * @param out Receives the task
+   * @return false if no task is left
+   */
+  bool pop(T& out) {
+    uint64_t range = range_.load(std::memory_order_relaxed);
+    for (;;) {
+      const uint64_t head = range >> 32;
+      const uint64_t tail = range & 0xFFFFFFFFULL;
+      if (head >= tail) {
+        return false;
+      }
+      if (range_.compare_exchange_weak(range, ((head + 1) << 32) | tail,
+                                       std::memory_order_relaxed)) {
+        out = tasks_[head];
+        return true;
+      }
+    }
+  }
+
+  /**
+   * @brief Takes the last task from the back (thief side)
+   *
+   * @param out Receives the task
+   * @return false if no task is left
+   */
+  bool steal(T& out) {
+    uint64_t range = range_.load(std::memory_order_relaxed);
+    for (;;) {
+      const uint64_t head = range >> 32;
+      const uint64_t tail = range & 0xFFFFFFFFULL;
+      if (head >= tail) {
+        return false;
+      }
+      if (range_.compare_exchange_weak(range, (head << 32) | (tail - 1),
+                                       std::memory_order_relaxed)) {
+        out = tasks_[tail - 1];
+        return true;
+      }
+    }
+  }
+
+  /**
+   * @brief Gets the number of tasks not yet taken
+   *
+   * @return Remaining task count (exact only between phases)
+   */
+  size_t remaining() const {
+    const uint64_t range = range_.load(std::memory_order_relaxed);
+    const uint64_t head = range >> 32;
+    const uint64_t tail = range & 0xFFFFFFFFULL;
+    return head < tail ? static_cast<size_t>(tail - head) : 0;
+  }
+
+private:
+  std::vector<T> tasks_;              ///< Tasks of the current phase (read-only while shared)
+  std::atomic<uint64_t> range_{0};    ///< Untaken range: head << 32 | tail
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_STEAL_QUEUE_HPP
@@ -0,0 +1,171 @@
+/**
+ * @file task_queue.hpp
+ * @brief Per-node timed task queue ordered by next run time
+ *
+ * This file contains the TaskQueue class each VirtualNode owns for the
+ * periodic and one-shot tasks of its firmware (FirmwareBase::runEvery(),
+ * runAfter()).
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_TASK_QUEUE_HPP
+#define SIMULATOR_TASK_QUEUE_HPP
+
+#include "simulator/slot_map.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace simulator {
+
+/// Handle of a task in a TaskQueue (default-constructed = no task)
+using TaskId = SlotHandle;
+
+/**
+ * @brief Timed callbacks of one node in a min-heap by next run time
+ *
+ * A TaskScheduler walks its whole task list on every execute(), due or
+ * not. TaskQueue pops only the tasks whose time has come, so a run costs
+ * O(due tasks * log tasks), and getNextRunMs() tells the node how long it
+ * may sleep before its next task.
+ *
+ * Times are in the node's local milliseconds (millis()). A periodic task
+ * runs one interval after its previous run time; runs missed while the
+ * node was stopped or behind are skipped rather than caught up.
+ *
+ * Cancelled and rescheduled tasks leave stale heap entries behind, which
+ * are recognized by their sequence number and dropped when they reach the
+ * top.
+ *
+ * Example usage:
+ * @code
+ * TaskQueue tasks;
+ * TaskId report = tasks.schedule(millis() + 1000, 1000, TaskQueue::FOREVER,
+ *                                [this]() { sendReport(); });
+ * ...
+ * tasks.runDue(millis());
+ * tasks.cancel(report);
+ * @endcode
+ *
+ * @note Not thread-safe; used by the thread updating the node.
+ */
+class TaskQueue {
+public:
+  /// Iteration count of a task that repeats until cancelled
+  static constexpr int32_t FOREVER = -1;
+
+  /**
+   * @brief Adds a task
+   *
+   * @param first_run_ms Time of the first run
+   * @param interval_ms Time between runs
+   * @param iterations Number of runs (FOREVER for no limit, >= 1 otherwise)
+   * @param callback Code to run
+   * @return Handle to cancel the task with
+   *
+   * @throws std::invalid_argument if iterations is 0 or below FOREVER, or
+   *         callback is empty
+   */
+  TaskId schedule(uint64_t first_run_ms, uint32_t interval_ms, int32_t iterations,
+                  std::function<void()> callback);
+
+  /**
+   * @brief Removes a task
+   *
+   * A task may cancel itself from its own callback.
+   *
+   * @param id Task handle
+   * @return true if the task was still scheduled
+   */
+  bool cancel(TaskId id);
+
+  /**
+   * @brief Checks if a task is still scheduled
+   */
+  bool contains(TaskId id) const;
+
+  /**
+   * @brief Runs every task due at a time, earliest first
+   *
+   * Tasks scheduled by a callback for a time not after @p now_ms run in
+   * the same call; a periodic task runs at most once per call. An
+   * exception from a callback propagates, leaving the task scheduled.
+   *
+   * @param now_ms Current local time
+   * @return Number of callbacks run
+   */
+  size_t runDue(uint64_t now_ms);
+
+  /**
+   * @brief Gets the time of the earliest scheduled run
+   *
+   * @return Run time, or UINT64_MAX if no task is scheduled
+   */
+  uint64_t getNextRunMs() const { return heap_.empty() ? UINT64_MAX : heap_.front().run_ms; }
+
+  /**
+   * @brief Gets the number of scheduled tasks
+   */
+  size_t size() const { return tasks_.size(); }
+
+  /**
+   * @brief Checks if no task is scheduled
+   */
+  bool empty() const { return tasks_.empty(); }
+
+  /**
+   * @brief Removes all tasks
+   *
+   * Must not be called from a task callback.
+   */
+  void clear();
+
+private:
+  struct Task {
+    std::unique_ptr<std::function<void()>> callback;  ///< Stable across map moves
+    uint32_t interval_ms{0};       ///< Time between runs
+    int32_t remaining{FOREVER};    ///< Runs left (FOREVER = no limit)
+    uint64_t sequence{0};          ///< Sequence of the task's live heap entry
+  };
+
+  struct Entry {
+    uint64_t run_ms;               ///< Run time
+    uint64_t sequence;             ///< Tie-break in scheduling order; stale if not the task's
+    TaskId id;                     ///< Task
+
+    // Inverted for a min-heap with std::push_heap
+    bool operator<(const Entry& other) const {
+      return run_ms != other.run_ms ? run_ms > other.run_ms : sequence > other.sequence;
+    }
+  };
+
+  /**
+   * @brief Queues the next run of a task
+   */
+  void push(Task& task, TaskId id, uint64_t run_ms);
+
+  /**
+   * @brief Ends the callback of a task, removing it if it is done
+   */
+  void finishRun(TaskId id, bool last);
+
+  /**
+   * @brief Drops stale entries from the top, so the top is always live
+   */
+  void dropStale();
+
+  SlotMap<Task> tasks_;            ///< Scheduled tasks
+  std::vector<Entry> heap_;        ///< Pending runs, earliest on top
+  uint64_t next_sequence_{1};      ///< Sequence of the next heap entry
+  TaskId running_;                 ///< Task whose callback is running
+  bool running_cancelled_{false};  ///< running_ cancelled itself
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_TASK_QUEUE_HPP
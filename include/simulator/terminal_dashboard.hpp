@@ -0,0 +1,207 @@
+/**
+ * @file terminal_dashboard.hpp
+ * @brief Live terminal view of a running simulation
+ *
+ * This file contains the TerminalDashboard class which publishes small
+ * snapshots of simulation progress from the simulation thread and redraws
+ * the latest one on the terminal from a background thread (--ui terminal).
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_TERMINAL_DASHBOARD_HPP
+#define SIMULATOR_TERMINAL_DASHBOARD_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "simulator/mesh_transport.hpp"
+#include "simulator/network_simulator.hpp"
+#include "simulator/triple_buffer.hpp"
+
+namespace simulator {
+
+class NodeManager;
+class EventScheduler;
+
+/**
+ * @brief Message counters of one node shown on the dashboard
+ */
+struct DashboardNode {
+  uint32_t id = 0;                  ///< Node ID
+  uint64_t messages_sent = 0;       ///< Firmware messages sent
+  uint64_t messages_received = 0;   ///< Firmware messages received
+  bool running = false;             ///< Node is running
+};
+
+/**
+ * @brief One published view of simulation progress for the dashboard
+ */
+struct DashboardSnapshot {
+  double wall_seconds = 0.0;         ///< Wall time since the dashboard was created
+  uint64_t virtual_us = 0;           ///< Virtual time
+  uint64_t duration_us = 0;          ///< Virtual end time (0 = unlimited)
+  uint64_t updates = 0;              ///< Node update ticks performed
+  double tick_rate = 0.0;            ///< Ticks per wall second since the previous snapshot
+  double time_ratio = 0.0;           ///< Virtual seconds per wall second, same period
+  uint64_t nodes = 0;                ///< Nodes created
+  uint64_t nodes_running = 0;        ///< Nodes running
+  uint64_t nodes_sleeping = 0;       ///< Running nodes skipped until their wake time
+  uint64_t pending_messages = 0;     ///< Messages in the network delivery queue
+  uint64_t pending_events = 0;       ///< Scenario events not yet run
+  TransportStats frames;             ///< In-process transport counters
+  uint64_t partitions = 0;           ///< Distinct partition labels
+  uint64_t partitioned_nodes = 0;    ///< Nodes with a partition label
+  uint64_t dropped_links = 0;        ///< Explicitly dropped directed links
+  std::vector<DashboardNode> busiest_nodes;                   ///< Most messages first
+  std::vector<NetworkSimulator::LinkCounters> busiest_links;  ///< Most messages first
+};
+
+/**
+ * @brief Redraws simulation progress on the terminal at a low fixed rate
+ *
+ * Shows tick rate, the virtual-to-wall time ratio, node states, queue
+ * depths, partition state, and the nodes and links that carried the most
+ * messages. Works like MetricsEndpoint: the simulation thread calls
+ * publish() when isDue(), which fills a TripleBuffer slot and releases it
+ * with one atomic exchange. Only the busiest few nodes and links are
+ * kept, so a snapshot costs one pass over nodes and links and does not
+ * allocate once the slots have grown. A background thread wakes every
+ * refresh interval, takes the latest snapshot if there is a new one and
+ * redraws the screen, so the simulation never waits for the terminal.
+ *
+ * Example usage:
+ * @code
+ * TerminalDashboard dashboard(std::cout, duration_us);
+ * dashboard.start();
+ * while (running) {
+ *   ...
+ *   if (dashboard.isDue()) {
+ *     dashboard.publish(clock.nowUs(), updates, manager, network, &scheduler, &transport);
+ *   }
+ * }
+ * dashboard.stop();
+ * @endcode
+ *
+ * @note Log output written to the same terminal scrolls the view; route
+ *       it elsewhere while the dashboard runs.
+ */
+class TerminalDashboard {
+public:
+  /// Default wall time between snapshots and redraws
+  static constexpr uint32_t DEFAULT_REFRESH_MS = 500;
+
+  /// Default number of busiest nodes and links shown
+  static constexpr size_t DEFAULT_TOP = 5;
+
+  /**
+   * @brief Construct a dashboard drawing to a stream
+   *
+   * @param out Terminal stream (written only by the render thread)
+   * @param duration_us Virtual end time for the progress bar (0 = unlimited)
+   * @param refresh_ms Wall time between snapshots and redraws
+   * @param top Number of busiest nodes and links shown
+   */
+  explicit TerminalDashboard(std::ostream& out, uint64_t duration_us = 0,
+                             uint32_t refresh_ms = DEFAULT_REFRESH_MS,
+                             size_t top = DEFAULT_TOP);
+
+  /**
+   * @brief Destructor; stops the render thread
+   */
+  ~TerminalDashboard();
+
+  TerminalDashboard(const TerminalDashboard&) = delete;
+  TerminalDashboard& operator=(const TerminalDashboard&) = delete;
+
+  /**
+   * @brief Starts the render thread
+   */
+  void start();
+
+  /**
+   * @brief Draws the latest snapshot one last time and stops the render
+   *        thread (no-op if not started)
+   */
+  void stop();
+
+  /**
+   * @brief Checks if a refresh interval has passed since the last snapshot
+   */
+  bool isDue() const { return Clock::now() >= next_publish_; }
+
+  /**
+   * @brief Takes a snapshot of the simulation and publishes it
+   *
+   * @param virtual_us Current virtual time
+   * @param updates Node update ticks performed so far
+   * @param manager Nodes to read
+   * @param network Network simulator to read
+   * @param scheduler Scenario events, or nullptr
+   * @param transport In-process transport, or nullptr (frame counters are 0)
+   */
+  void publish(uint64_t virtual_us, uint64_t updates, const NodeManager& manager,
+               const NetworkSimulator& network, const EventScheduler* scheduler,
+               const MeshTransport* transport);
+
+  /**
+   * @brief Gets the number of snapshots published
+   */
+  uint64_t getPublishCount() const { return published_; }
+
+  /**
+   * @brief Gets the number of screens drawn
+   */
+  uint64_t getDrawCount() const { return drawn_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Formats a snapshot as the dashboard text
+   *
+   * @param snapshot Snapshot to format
+   * @param out Receives the text (cleared first)
+   */
+  static void render(const DashboardSnapshot& snapshot, std::string& out);
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief Draws the latest snapshot if there is a new one (render thread)
+   */
+  void draw();
+
+  void renderLoop();
+
+  std::ostream& out_;                            ///< Terminal stream
+  uint64_t duration_us_;                         ///< Virtual end time
+  std::chrono::milliseconds refresh_interval_;   ///< Wall time between snapshots
+  size_t top_;                                   ///< Busiest nodes and links shown
+  Clock::time_point created_;                    ///< Wall time origin
+  Clock::time_point next_publish_;               ///< Next due snapshot
+  Clock::time_point last_wall_;                  ///< Wall time of the previous snapshot
+  uint64_t last_virtual_us_{0};                  ///< Virtual time of the previous snapshot
+  uint64_t last_updates_{0};                     ///< Ticks at the previous snapshot
+  uint64_t published_{0};                        ///< Snapshots published
+
+  TripleBuffer<DashboardSnapshot> snapshots_;    ///< Simulation thread -> render thread
+  std::string screen_;                           ///< Last drawn text (render thread)
+  std::atomic<uint64_t> drawn_{0};               ///< Screens drawn
+
+  std::mutex mutex_;                             ///< Guards stopping_ (render thread and stop())
+  std::condition_variable wake_;                 ///< Ends the render thread's wait early
+  bool stopping_{false};                         ///< stop() was called
+  std::thread renderer_;
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_TERMINAL_DASHBOARD_HPP
@@ -0,0 +1,188 @@
+/**
+ * @file topology.hpp
+ * @brief Scenario topology generators
+ *
+ * This file contains the Topology class which builds the link graph of
+ * a scenario (random, star, ring, mesh or custom) as a compressed sparse
+ * row (CSR) adjacency over node indices.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_TOPOLOGY_HPP
+#define SIMULATOR_TOPOLOGY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace simulator {
+
+struct TopologyConfig;
+struct NodeConfigExtended;
+
+/**
+ * @brief Undirected link graph over node indices 0..n-1
+ *
+ * Neighbours of node i are targets_[offsets_[i]] to
+ * targets_[offsets_[i + 1]] in ascending order; each link appears in the
+ * rows of both of its ends. Generators emit an edge list that is turned
+ * into CSR once by a counting sort, so building costs O(n + E) apart from
+ * sorting each row.
+ *
+ * The random generator links a spanning tree (every node to a random
+ * earlier node, as establishing a painlessMesh network does) and adds
+ * each other pair with probability density. Extra pairs are found by
+ * skipping geometrically distributed gaps over the pair sequence
+ * (Batagelj and Brandes), so a sparse 10k-node graph costs O(E) draws
+ * instead of 50 million pair tests. Draws come from the
+ * RNG_STREAM_TOPOLOGY streams of the seed, so one seed gives the same
+ * graph on every host.
+ *
+ * Example usage:
+ * @code
+ * Topology topology = Topology::random(10000, 0.001f, seed);
+ * transport.addLinks(topology.getLinks(node_ids));
+ * @endcode
+ */
+class Topology {
+public:
+  /// Link between two nodes, by index or by ID
+  using Edge = std::pair<uint32_t, uint32_t>;
+
+  /**
+   * @brief Construct an empty graph
+   */
+  Topology() = default;
+
+  /**
+   * @brief Builds a graph from an edge list
+   *
+   * Self-loops are dropped and duplicate links (in either direction)
+   * kept once.
+   *
+   * @param node_count Number of nodes
+   * @param edges Links by node index
+   *
+   * @throws std::out_of_range if an edge refers to a node >= node_count
+   */
+  static Topology fromEdges(size_t node_count, const std::vector<Edge>& edges);
+
+  /**
+   * @brief Random spanning tree: node i links to a random node before it
+   *
+   * @param node_count Number of nodes
+   * @param seed Simulation seed
+   */
+  static Topology randomTree(size_t node_count, uint32_t seed);
+
+  /**
+   * @brief Random spanning tree plus each other pair with probability density
+   *
+   * @param node_count Number of nodes
+   * @param density Extra link probability (0.0 to 1.0)
+   * @param seed Simulation seed
+   *
+   * @throws std::invalid_argument if density is outside 0.0 to 1.0
+   */
+  static Topology random(size_t node_count, float density, uint32_t seed);
+
+  /**
+   * @brief Every node linked to a hub
+   *
+   * @param node_count Number of nodes
+   * @param hub Index of the hub
+   *
+   * @throws std::out_of_range if hub >= node_count
+   */
+  static Topology star(size_t node_count, uint32_t hub);
+
+  /**
+   * @brief Node i linked to node i + 1, and the last node to the first
+   *
+   * @param node_count Number of nodes
+   */
+  static Topology ring(size_t node_count);
+
+  /**
+   * @brief Every pair of nodes linked
+   *
+   * @param node_count Number of nodes
+   */
+  static Topology mesh(size_t node_count);
+
+  /**
+   * @brief Builds the topology a scenario describes
+   *
+   * Node indices follow the order of nodes; star hubs and custom
+   * connections are looked up by string ID.
+   *
+   * @param config Topology configuration (any type but radio)
+   * @param nodes Scenario nodes
+   * @param seed Simulation seed
+   *
+   * @throws std::invalid_argument for a radio topology or an unknown node ID
+   */
+  static Topology build(const TopologyConfig& config,
+                        const std::vector<NodeConfigExtended>& nodes, uint32_t seed);
+
+  /**
+   * @brief Gets the number of nodes
+   */
+  size_t getNodeCount() const { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+
+  /**
+   * @brief Gets the number of undirected links
+   */
+  size_t getEdgeCount() const { return targets_.size() / 2; }
+
+  /**
+   * @brief Gets the number of neighbours of a node
+   */
+  size_t getDegree(uint32_t node) const { return offsets_[node + 1] - offsets_[node]; }
+
+  /**
+   * @brief Gets the first neighbour of a node (ascending order)
+   */
+  const uint32_t* neighboursBegin(uint32_t node) const { return targets_.data() + offsets_[node]; }
+
+  /**
+   * @brief Gets one past the last neighbour of a node
+   */
+  const uint32_t* neighboursEnd(uint32_t node) const { return targets_.data() + offsets_[node + 1]; }
+
+  /**
+   * @brief Checks whether two nodes are linked
+   */
+  bool hasEdge(uint32_t a, uint32_t b) const;
+
+  /**
+   * @brief Checks whether every node can reach every other node
+   */
+  bool isConnected() const;
+
+  /**
+   * @brief Gets every link once, mapped to node IDs
+   *
+   * @param ids Node ID of each index
+   * @return Links (lower index first) in index order
+   *
+   * @throws std::invalid_argument if ids does not match the node count
+   */
+  std::vector<Edge> getLinks(const std::vector<uint32_t>& ids) const;
+
+private:
+  std::vector<size_t> offsets_;     ///< Row starts, node count + 1 entries
+  std::vector<uint32_t> targets_;   ///< Neighbours of all rows
+
+  /**
+   * @brief Appends the random spanning tree of a seed to an edge list
+   */
+  static void appendTree(size_t node_count, uint32_t seed, std::vector<Edge>& edges);
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_TOPOLOGY_HPP
@@ -0,0 +1,70 @@
+/**
+ * @file topology_listener.hpp
+ * @brief Callbacks for topology changes of a simulation
+ *
+ * This file contains the TopologyListener interface through which
+ * MeshTransport, NetworkSimulator and the nodes report link, connection,
+ * partition and lifecycle changes (to TopologyRecorder and
+ * ConnectivityTracker).
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_TOPOLOGY_LISTENER_HPP
+#define SIMULATOR_TOPOLOGY_LISTENER_HPP
+
+#include <cstdint>
+
+namespace simulator {
+
+/**
+ * @brief Lifecycle change of a node
+ */
+enum class NodeTransition : uint8_t {
+  START,   ///< Node started (also the second half of a restart)
+  STOP,    ///< Node stopped gracefully
+  CRASH    ///< Node crashed
+};
+
+/**
+ * @brief Receives topology changes as they happen
+ *
+ * Set through setTopologyListener() on MeshTransport, NetworkSimulator
+ * and NodeManager (which passes it on to its nodes). Every callback runs
+ * on the simulation thread after the change is applied, so a listener
+ * may query the new state from inside it.
+ */
+class TopologyListener {
+public:
+  virtual ~TopologyListener() = default;
+
+  /**
+   * @brief A link was added to or removed from the in-process transport
+   */
+  virtual void linkChanged(uint32_t a, uint32_t b, bool up) = 0;
+
+  /**
+   * @brief A connection was dropped or restored in the network model
+   */
+  virtual void connectionChanged(uint32_t from, uint32_t to, bool active) = 0;
+
+  /**
+   * @brief A node got a new partition label (0 = unpartitioned)
+   */
+  virtual void partitionChanged(uint32_t node, uint32_t label) = 0;
+
+  /**
+   * @brief Every partition label was removed
+   */
+  virtual void partitionsCleared() = 0;
+
+  /**
+   * @brief A node started, stopped or crashed
+   */
+  virtual void nodeChanged(uint32_t node, NodeTransition transition) = 0;
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_TOPOLOGY_LISTENER_HPP
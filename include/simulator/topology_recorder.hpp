@@ -0,0 +1,182 @@
+/**
+ * @file topology_recorder.hpp
+ * @brief Incremental topology export as a snapshot plus NDJSON deltas
+ *
+ * This file contains the TopologyRecorder class which writes the mesh
+ * topology once and then one line per change, so long runs can be
+ * replayed as an animation without dumping the whole graph per interval.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_TOPOLOGY_RECORDER_HPP
+#define SIMULATOR_TOPOLOGY_RECORDER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "simulator/config_loader.hpp"
+#include "simulator/topology_listener.hpp"
+
+namespace simulator {
+
+class NodeManager;
+class NetworkSimulator;
+class MeshTransport;
+
+/**
+ * @brief Streams topology changes of a simulation
+ *
+ * Enabled by the `topology` metrics export format, the recorder writes
+ * base_topology.ndjson next to the metrics output (see
+ * MetricsCollector::basePath()). The first line is a snapshot of the
+ * topology when recording starts; every further line is one change:
+ *
+ * | ev | Fields | Source |
+ * |----|--------|--------|
+ * | snapshot | version, nodes ([id, running]), links ([a, b]), dropped ([from, to]), partitions ([node, label]) | open() |
+ * | link_up, link_down | a, b | In-process transport links (where onNewConnection and onChangedConnections fire) |
+ * | drop, restore | from, to | NetworkSimulator::dropConnection() / restoreConnection() |
+ * | partition | node, label | NetworkSimulator::setPartition() |
+ * | heal | | NetworkSimulator::clearPartitions() |
+ * | node | node, state (start, stop, crash) | VirtualNode start(), stop() and crash() |
+ *
+ * Every line carries `t`, the virtual time in milliseconds set through
+ * setTimeUs(). Changes only cost a formatted line, so a run writes in
+ * proportion to its churn rather than its size. The `graphviz` export
+ * format additionally writes the snapshot as an undirected DOT graph to
+ * base_topology.dot.
+ *
+ * The recorder is fed through setTopologyListener() on MeshTransport,
+ * NetworkSimulator and NodeManager and, like them, is used from the
+ * simulation thread only.
+ *
+ * Example usage:
+ * @code
+ * TopologyRecorder topology(config.metrics);
+ * topology.open(clock.nowUs(), manager, network, &transport);
+ * transport.setTopologyListener(&topology);
+ * network.setTopologyListener(&topology);
+ * manager.setTopologyListener(&topology);
+ * while (running) {
+ *   topology.setTimeUs(clock.nowUs());
+ *   ...
+ * }
+ * @endcode
+ */
+class TopologyRecorder : public TopologyListener {
+public:
+  /// Format version in the snapshot line
+  static constexpr uint32_t VERSION = 1;
+
+  /**
+   * @brief Checks if a metrics configuration asks for topology output
+   *
+   * @return true if export lists topology or graphviz
+   */
+  static bool isRequested(const MetricsConfig& config);
+
+  /**
+   * @brief Construct a closed recorder
+   *
+   * @param config Metrics configuration (output and export)
+   *
+   * @throws std::invalid_argument if the output is empty
+   */
+  explicit TopologyRecorder(const MetricsConfig& config);
+
+  /**
+   * @brief Destructor; closes the files
+   */
+  ~TopologyRecorder() override;
+
+  TopologyRecorder(const TopologyRecorder&) = delete;
+  TopologyRecorder& operator=(const TopologyRecorder&) = delete;
+
+  /**
+   * @brief Creates the files and writes the snapshot
+   *
+   * @param time_us Virtual time of the snapshot
+   * @param manager Nodes and their running state
+   * @param network Dropped connections and partitions
+   * @param transport In-process links, or nullptr (no links)
+   *
+   * @throws std::runtime_error if a file cannot be created
+   */
+  void open(uint64_t time_us, const NodeManager& manager, const NetworkSimulator& network,
+            const MeshTransport* transport);
+
+  /**
+   * @brief Finishes the files (no-op if not open)
+   *
+   * @throws std::runtime_error if writing failed
+   */
+  void close();
+
+  /**
+   * @brief Checks if the recorder is open
+   */
+  bool isOpen() const { return open_; }
+
+  /**
+   * @brief Sets the virtual time stamped on the following changes
+   */
+  void setTimeUs(uint64_t time_us) { time_ms_ = time_us / 1000; }
+
+  /**
+   * @brief Records a link added or removed in the transport
+   */
+  void linkChanged(uint32_t a, uint32_t b, bool up) override;
+
+  /**
+   * @brief Records a connection dropped or restored in the network model
+   */
+  void connectionChanged(uint32_t from, uint32_t to, bool active) override;
+
+  /**
+   * @brief Records a new partition label (0 = unpartitioned)
+   */
+  void partitionChanged(uint32_t node, uint32_t label) override;
+
+  /**
+   * @brief Records the removal of every partition label
+   */
+  void partitionsCleared() override;
+
+  /**
+   * @brief Records a node lifecycle change
+   */
+  void nodeChanged(uint32_t node, NodeTransition transition) override;
+
+  /**
+   * @brief Gets the number of change lines written
+   */
+  uint64_t getChangeCount() const { return changes_; }
+
+  /**
+   * @brief Gets the paths of the files being written
+   */
+  const std::vector<std::string>& getFiles() const { return files_; }
+
+private:
+  void writeLine(const char* format, ...);
+  void writeDot(const std::vector<std::pair<uint32_t, bool>>& nodes,
+                const std::vector<std::pair<uint32_t, uint32_t>>& links);
+
+  std::string base_;                   ///< Output path without extension
+  bool stream_{false};                 ///< Write base_topology.ndjson
+  bool dot_{false};                    ///< Write base_topology.dot
+  bool open_{false};                   ///< open() succeeded
+  uint64_t time_ms_{0};                ///< Stamp of the next change
+  uint64_t changes_{0};                ///< Change lines written
+  std::ofstream out_;                  ///< NDJSON stream
+  std::vector<std::string> files_;     ///< Paths of written files
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_TOPOLOGY_RECORDER_HPP
@@ -0,0 +1,238 @@
+/**
+ * @file trace_recorder.hpp
+ * @brief Scoped trace spans of the simulation loop
+ *
+ * This file contains the TraceRecorder class, which collects timed spans
+ * into per-thread buffers and writes them as a Chrome trace (viewable in
+ * ui.perfetto.dev or chrome://tracing), and the SIM_TRACE macros that
+ * open a span for the rest of a scope.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_TRACE_RECORDER_HPP
+#define SIMULATOR_TRACE_RECORDER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Whether SIM_TRACE_SCOPE statements are compiled in (0 or 1)
+ *
+ * Set with the ENABLE_TRACING CMake option. When 0, the macros expand to
+ * nothing and the simulation loop carries no tracing cost at all.
+ */
+#ifndef SIMULATOR_ENABLE_TRACING
+#define SIMULATOR_ENABLE_TRACING 0
+#endif
+
+namespace simulator {
+
+/**
+ * @brief One completed span
+ */
+struct TraceEvent {
+  const char* name{""};          ///< Span name (static storage duration)
+  const char* arg_name{nullptr}; ///< Name of the argument, or nullptr
+  uint64_t arg{0};               ///< Argument value (e.g. node ID)
+  uint64_t start_ns{0};          ///< Start, steady clock nanoseconds
+  uint64_t duration_ns{0};       ///< Length in nanoseconds
+};
+
+/**
+ * @brief Collects trace spans from every thread of a run
+ *
+ * Spans are recorded only between start() and stop(); outside that a span
+ * costs one relaxed load. Each thread appends to its own buffer, registered
+ * on its first span, so recording takes no lock. A buffer holds at most
+ * the per-thread limit given to start(); later spans of that thread are
+ * counted as dropped, so a long run cannot exhaust memory.
+ *
+ * Buffers are read by writeChromeJson() and the counters, which must only
+ * be called while no thread records (after stop() once the simulation
+ * threads are idle).
+ *
+ * Example usage:
+ * @code
+ * TraceRecorder::instance().start();
+ * {
+ *   SIM_TRACE_SCOPE("nodes.update");
+ *   manager.updateAll();
+ * }
+ * TraceRecorder::instance().stop();
+ * std::ofstream out("run.trace.json");
+ * TraceRecorder::instance().writeChromeJson(out);
+ * @endcode
+ */
+class TraceRecorder {
+public:
+  /// Default span limit per thread (40 MB of events)
+  static constexpr size_t DEFAULT_MAX_EVENTS = 1u << 20;
+
+  TraceRecorder();
+  TraceRecorder(const TraceRecorder&) = delete;
+  TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+  /**
+   * @brief Gets the recorder the SIM_TRACE macros use
+   */
+  static TraceRecorder& instance();
+
+  /**
+   * @brief Reads the clock spans are timed with
+   *
+   * @return Steady clock time in nanoseconds
+   */
+  static uint64_t nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count());
+  }
+
+  /**
+   * @brief Discards earlier spans and starts recording
+   *
+   * @param max_events Spans kept per thread (at least 1)
+   * @throws std::invalid_argument if max_events is 0
+   */
+  void start(size_t max_events = DEFAULT_MAX_EVENTS);
+
+  /**
+   * @brief Stops recording; spans already open still complete
+   */
+  void stop() { enabled_.store(false, std::memory_order_relaxed); }
+
+  /**
+   * @brief Checks whether spans are recorded
+   */
+  bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Records a completed span on the calling thread's buffer
+   *
+   * @param name Span name with static storage duration
+   * @param start_ns Start time from nowNs()
+   * @param end_ns End time from nowNs()
+   * @param arg_name Argument name with static storage duration, or nullptr
+   * @param arg Argument value
+   */
+  void record(const char* name, uint64_t start_ns, uint64_t end_ns,
+              const char* arg_name = nullptr, uint64_t arg = 0);
+
+  /**
+   * @brief Names the calling thread in the trace (e.g. "simulation")
+   *
+   * @param name Thread name, kept until the next start()
+   */
+  void setThreadName(const std::string& name);
+
+  /**
+   * @brief Gets the number of spans kept over all threads
+   */
+  size_t getEventCount() const;
+
+  /**
+   * @brief Gets the number of spans dropped at the per-thread limit
+   */
+  uint64_t getDroppedCount() const;
+
+  /**
+   * @brief Gets the number of threads that recorded a span or a name
+   */
+  size_t getThreadCount() const;
+
+  /**
+   * @brief Writes the spans as a Chrome trace event JSON document
+   *
+   * Every span is a complete ("X") event in microseconds since start(),
+   * with one track per thread named by setThreadName() or "thread N".
+   *
+   * @param out Stream to write to
+   */
+  void writeChromeJson(std::ostream& out) const;
+
+private:
+  /**
+   * @brief Spans of one thread
+   */
+  struct ThreadBuffer {
+    uint32_t tid{0};                 ///< Track ID in the trace
+    std::thread::id thread;          ///< Owning thread
+    std::string name;                ///< Thread name (empty = "thread N")
+    std::vector<TraceEvent> events;  ///< Completed spans
+    uint64_t dropped{0};             ///< Spans past the limit
+  };
+
+  /**
+   * @brief Gets the calling thread's buffer, registering it if needed
+   *
+   * The buffer is cached in a thread_local for the current generation; a
+   * miss looks the thread up by ID, so switching recorders does not
+   * register a thread twice.
+   */
+  ThreadBuffer& local();
+
+  std::atomic<bool> enabled_{false};
+  std::atomic<uint64_t> generation_{0};         ///< New on start(); stale buffers re-register
+  size_t max_events_{DEFAULT_MAX_EVENTS};
+  uint64_t epoch_ns_{0};                        ///< Time of start()
+  mutable std::mutex mutex_;                    ///< Guards buffers_ registration
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+};
+
+/**
+ * @brief Records a span from construction to destruction
+ *
+ * Whether the span is recorded is decided at construction, so a span open
+ * across stop() still completes.
+ */
+class TraceScope {
+public:
+  explicit TraceScope(const char* name, const char* arg_name = nullptr, uint64_t arg = 0)
+    : name_(name),
+      arg_name_(arg_name),
+      arg_(arg),
+      start_ns_(TraceRecorder::instance().isEnabled() ? TraceRecorder::nowNs() : 0) {}
+
+  ~TraceScope() {
+    if (start_ns_ != 0) {
+      TraceRecorder::instance().record(name_, start_ns_, TraceRecorder::nowNs(), arg_name_, arg_);
+    }
+  }
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+  const char* name_;
+  const char* arg_name_;
+  uint64_t arg_;
+  uint64_t start_ns_;  ///< 0 = not recorded
+};
+
+} // namespace simulator
+
+#define SIM_TRACE_CONCAT_INNER(a, b) a##b
+#define SIM_TRACE_CONCAT(a, b) SIM_TRACE_CONCAT_INNER(a, b)
+
+#if SIMULATOR_ENABLE_TRACING
+/// Records the rest of the enclosing scope as a span named @p name
+#define SIM_TRACE_SCOPE(name) \
+  ::simulator::TraceScope SIM_TRACE_CONCAT(sim_trace_scope_, __LINE__)(name)
+/// Same as SIM_TRACE_SCOPE with one numeric argument, e.g. the node ID
+#define SIM_TRACE_SCOPE_ARG(name, arg_name, arg) \
+  ::simulator::TraceScope SIM_TRACE_CONCAT(sim_trace_scope_, __LINE__)(name, arg_name, arg)
+#else
+#define SIM_TRACE_SCOPE(name) do {} while (0)
+#define SIM_TRACE_SCOPE_ARG(name, arg_name, arg) do {} while (0)
+#endif
+
+#endif // SIMULATOR_TRACE_RECORDER_HPP
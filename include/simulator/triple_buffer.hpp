@@ -0,0 +1,90 @@
+/**
+ * @file triple_buffer.hpp
+ * @brief Wait-free single-writer single-reader snapshot exchange
+ *
+ * This file contains the TripleBuffer class template used to publish
+ * snapshots from the simulation thread to an observer thread without
+ * either side ever waiting for the other.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_TRIPLE_BUFFER_HPP
+#define SIMULATOR_TRIPLE_BUFFER_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace simulator {
+
+/**
+ * @brief Latest-value exchange for exactly one writer and one reader
+ *
+ * Three slots rotate between the writer (back), the reader (front) and a
+ * shared middle slot. publish() swaps the filled back slot with the middle
+ * one and update() swaps the front slot with the middle one if it holds a
+ * newer value; each is a single atomic exchange, so both sides are
+ * wait-free. The reader always sees a complete snapshot, skipping any the
+ * writer published in between.
+ *
+ * Slots are reused, so a writer that refills containers in back() keeps
+ * their capacity and does not allocate in steady state. back() holds an
+ * old snapshot after publish() and must be filled completely.
+ *
+ * @tparam T Slot type (must be default-constructible)
+ */
+template <typename T>
+class TripleBuffer {
+public:
+  TripleBuffer() = default;
+  TripleBuffer(const TripleBuffer&) = delete;
+  TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+  /**
+   * @brief Gets the slot to fill (writer side)
+   */
+  T& back() { return slots_[back_]; }
+
+  /**
+   * @brief Makes the filled back slot the latest value (writer side)
+   */
+  void publish() {
+    back_ = middle_.exchange(static_cast<uint8_t>(back_ | FRESH),
+                             std::memory_order_acq_rel) & INDEX;
+  }
+
+  /**
+   * @brief Takes the latest published value if there is a new one
+   *        (reader side)
+   *
+   * @return true if front() changed
+   */
+  bool update() {
+    if ((middle_.load(std::memory_order_relaxed) & FRESH) == 0) {
+      return false;
+    }
+    front_ = middle_.exchange(front_, std::memory_order_acq_rel) & INDEX;
+    return true;
+  }
+
+  /**
+   * @brief Gets the value taken by the last update() (reader side)
+   *
+   * A default-constructed T until the first value is taken.
+   */
+  const T& front() const { return slots_[front_]; }
+
+private:
+  static constexpr uint8_t INDEX = 0x3;   ///< Slot index bits of middle_
+  static constexpr uint8_t FRESH = 0x4;   ///< middle_ holds an unread value
+
+  T slots_[3]{};                          ///< Value-initialized slots
+  uint8_t back_{0};                       ///< Writer's slot
+  uint8_t front_{1};                      ///< Reader's slot
+  std::atomic<uint8_t> middle_{2};        ///< Shared slot and FRESH flag
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_TRIPLE_BUFFER_HPP
@@ -13,17 +13,33 @@
 #define SIMULATOR_VIRTUAL_NODE_HPP
 
 #include <memory>
+#include <cstddef>
 #include <cstdint>
 #include <chrono>
 #include <string>
 #include <map>
+#include <functional>
 #include <boost/asio.hpp>
 
+#include "simulator/task_queue.hpp"
+#include "simulator/virtual_time.hpp"
+
 // Forward declarations
 class Scheduler;
 class MeshTest;
 
 namespace simulator {
+class MeshTransport;
+class Payload;
+class CheckpointWriter;
+class CheckpointReader;
+class TopologyListener;
+class CallProfile;
+struct UpdateTiming;
+class Outbox;
+struct IncomingMessage;
+template <typename T>
+class Mailbox;
 namespace firmware {
   class FirmwareBase;
 }
@@ -37,6 +53,9 @@ class Connection;
 
 namespace simulator {
 
+/// Firmware configuration map (firmware::FirmwareConfig)
+using NodeFirmwareConfig = std::map<std::string, std::string>;
+
 /**
  * @brief Configuration parameters for a virtual node
  */
@@ -47,6 +66,10 @@ struct NodeConfig {
   uint16_t meshPort = 5555;           ///< Mesh network port
   std::string firmware;               ///< Firmware name (optional)
   std::map<std::string, std::string> firmwareConfig;  ///< Firmware-specific configuration
+  std::shared_ptr<const NodeFirmwareConfig> sharedFirmwareConfig;  ///< Shared firmware-specific configuration (may be null; firmwareConfig entries win)
+  bool lazy = false;                  ///< Hold mesh objects only while running (see VirtualNode)
+  bool fluid = false;                 ///< Never build mesh objects; route through the transport (see VirtualNode)
+  NodeClock clock;                    ///< Local clock error seen through millis()/micros()
 };
 
 /**
@@ -62,6 +85,38 @@ struct NodeMetrics {
   uint64_t total_uptime_ms = 0;       ///< Total uptime in milliseconds across all sessions
 };
 
+/**
+ * @brief Estimated memory held by a node, by component
+ * 
+ * Counts the fixed size of each object a node owns plus the buffers it
+ * preallocates. Heap growth inside painlessMesh (routing tables, queued
+ * strings) is not included, so the figures are a lower bound for
+ * capacity planning.
+ */
+struct NodeMemoryUsage {
+  size_t node = 0;                    ///< VirtualNode itself and its configuration
+  size_t mesh = 0;                    ///< painlessMesh instance and TCP server
+  size_t connections = 0;             ///< TCP mesh connections
+  size_t firmware = 0;                ///< Loaded firmware
+  size_t buffers = 0;                 ///< Mailboxes and scratch buffers
+  
+  /**
+   * @brief Gets the sum of all components
+   * 
+   * @return Total bytes
+   */
+  size_t total() const { return node + mesh + connections + firmware + buffers; }
+  
+  NodeMemoryUsage& operator+=(const NodeMemoryUsage& other) {
+    node += other.node;
+    mesh += other.mesh;
+    connections += other.connections;
+    firmware += other.firmware;
+    buffers += other.buffers;
+    return *this;
+  }
+};
+
 /**
  * @brief Virtual node representing a simulated ESP32/ESP8266 device
  * 
@@ -83,6 +138,24 @@ struct NodeMetrics {
  * // ... run simulation ...
  * node.stop();
  * @endcode
+ * 
+ * A node created with NodeConfig::lazy builds its painlessMesh instance
+ * and TCP server on its first start() instead of in the constructor, and
+ * hibernates when stopped or crashed: the mesh objects are released and
+ * the node keeps only its configuration, metrics and firmware, from which
+ * the next start() rebuilds them. Nodes that join late or churn then cost
+ * no sockets or mesh memory while they are down.
+ * 
+ * The TCP server is opened only when a node starts without an in-process
+ * transport, or when another node connects to it over TCP, so nodes on
+ * the in-process transport hold no listening socket at all.
+ * 
+ * A fluid node (NodeConfig::fluid) never builds a painlessMesh instance.
+ * Its firmware runs on the FirmwareBase API alone: sends, node lists and
+ * node time go to the in-process transport, whose cached shortest-path
+ * trees stand in for the painlessMesh routing tables, and updates skip
+ * the mesh's handshakes, time sync and JSON packages. Firmware that calls
+ * the painlessMesh API directly sees a null mesh.
  */
 class VirtualNode {
 public:
@@ -97,7 +170,9 @@ public:
    * @throws std::invalid_argument if nodeId is 0
    * @throws std::runtime_error if initialization fails
    * 
-   * @note The node must be started explicitly with start()
+   * @note The node must be started explicitly with start(). Lazy nodes
+   *       (NodeConfig::lazy) defer mesh creation to it; fluid nodes
+   *       (NodeConfig::fluid) have no mesh.
    */
   VirtualNode(uint32_t nodeId, 
               const NodeConfig& config,
@@ -121,9 +196,10 @@ public:
    * @brief Starts the mesh node
    * 
    * Initializes the mesh instance, sets up callbacks, and begins
-   * network operations.
+   * network operations. A lazy node builds its mesh instance here.
    * 
-   * @throws std::runtime_error if node is already running
+   * @throws std::runtime_error if node is already running, the mesh
+   *         instance cannot be created, or a fluid node has no transport
    */
   void start();
   
@@ -131,7 +207,8 @@ public:
    * @brief Stops the mesh node gracefully
    * 
    * Disconnects from mesh, cancels pending operations, and releases
-   * network resources. Updates uptime metrics before stopping.
+   * network resources. Updates uptime metrics before stopping. A lazy
+   * node also releases its mesh instance.
    */
   void stop();
   
@@ -156,8 +233,11 @@ public:
   /**
    * @brief Updates the node state
    * 
-   * Should be called periodically to process scheduled tasks and
-   * network events.
+   * Should be called periodically to run the mesh update and the
+   * firmware loop. Network events are not processed here: the owner of
+   * the IO context polls it once per step for all nodes sharing it (see
+   * NodeManager::updateAll()), and each completion runs the handler of
+   * the connection, and so the node, it belongs to.
    */
   void update();
   
@@ -172,7 +252,7 @@ public:
    * @brief Gets reference to the underlying mesh instance
    * 
    * @return Reference to painlessMesh instance
-   * @throws std::runtime_error if mesh not initialized
+   * @throws std::runtime_error if mesh not initialized (see hasMesh())
    */
   painlessmesh::Mesh<painlessmesh::Connection>& getMesh();
   
@@ -184,6 +264,14 @@ public:
    */
   const painlessmesh::Mesh<painlessmesh::Connection>& getMesh() const;
   
+  /**
+   * @brief Checks if the mesh instance exists
+   * 
+   * @return false for fluid nodes and lazy nodes that are not running,
+   *         true otherwise
+   */
+  bool hasMesh() const { return mesh_ != nullptr; }
+  
   /**
    * @brief Gets current performance metrics
    * 
@@ -212,6 +300,16 @@ public:
    */
   uint32_t getCrashCount() const { return metrics_.crash_count; }
   
+  /**
+   * @brief Estimates the memory this node holds
+   * 
+   * A lazy node that is not running holds no mesh or connections.
+   * Mailboxes are owned by the NodeManager and counted there.
+   * 
+   * @return Memory usage by component
+   */
+  NodeMemoryUsage getMemoryUsage() const;
+  
   /**
    * @brief Sets simulated network quality
    * 
@@ -229,10 +327,170 @@ public:
    * 
    * Creates a mesh connection from this node to the specified target node.
    * This simulates the WiFi mesh connection that would occur naturally
-   * in a real mesh network.
+   * in a real mesh network. If both nodes use the same in-process
+   * transport, a transport link is added instead of a TCP connection.
    */
   void connectTo(VirtualNode& other);
   
+  /**
+   * @brief Routes this node's traffic through an in-process transport
+   * 
+   * @param transport Transport to use, or nullptr for loopback TCP
+   * 
+   * The node attaches to the transport when started and detaches when
+   * stopped or crashed. Must be called before start().
+   * 
+   * @throws std::runtime_error if node is running
+   */
+  void setTransport(MeshTransport* transport);
+  
+  /**
+   * @brief Gets the in-process transport
+   * 
+   * @return Transport in use, or nullptr if loopback TCP is used
+   */
+  MeshTransport* getTransport() const { return transport_; }
+  
+  /**
+   * @brief Decouples transport traffic from the calling thread
+   * 
+   * Used by a sharded NodeManager. Firmware sends are posted to
+   * @p outbox instead of entering the transport, and transport deliveries
+   * are posted to @p inbox instead of reaching the firmware. The owner
+   * replays both through deliver() and the transport. Must be called
+   * before start().
+   * 
+   * @param outbox Outbox for firmware sends, or nullptr
+   * @param inbox Inbox for transport deliveries, or nullptr
+   * 
+   * @throws std::runtime_error if node is running
+   */
+  void setMailboxes(Outbox* outbox, Mailbox<IncomingMessage>* inbox);
+  
+  /**
+   * @brief Hands a message from the in-process transport to this node
+   * 
+   * Messages arriving after the node stopped are ignored.
+   * 
+   * @param from Source node ID
+   * @param msg Message content
+   */
+  void deliver(uint32_t from, const Payload& msg);
+  
+  /**
+   * @brief Checks if the firmware asked to skip updates
+   * 
+   * Set by update() when loop() called FirmwareBase::sleepFor(), cleared
+   * by the next update() or wake().
+   * 
+   * @return true while the node sleeps
+   */
+  bool isAsleep() const { return asleep_; }
+  
+  /**
+   * @brief Gets the time the current sleep ends
+   * 
+   * @return Wake time on the wakeClockMs() clock
+   */
+  uint64_t getWakeTime() const { return wake_at_ms_; }
+  
+  /**
+   * @brief Checks if the node needs an update
+   * 
+   * @param now_ms Current wakeClockMs() time
+   * @return true if the node is awake or its sleep has ended
+   */
+  bool isDue(uint64_t now_ms) const { return !asleep_ || now_ms >= wake_at_ms_; }
+  
+  /**
+   * @brief Ends a sleep early
+   * 
+   * Called for every message and connection callback, and by the
+   * firmware through FirmwareBase::wake(). Notifies the wake listener if
+   * the node was asleep.
+   */
+  void wake();
+  
+  /**
+   * @brief Sets the hook called when a sleeping node is woken early
+   * 
+   * @param listener Called with the node ID, or an empty function
+   */
+  void setWakeListener(std::function<void(uint32_t)> listener) { wake_listener_ = std::move(listener); }
+  
+  /**
+   * @brief Sets the listener told about start(), stop() and crash()
+   * 
+   * @param listener Listener, or nullptr to stop reporting
+   */
+  void setTopologyListener(TopologyListener* listener) { listener_ = listener; }
+  
+  /**
+   * @brief Enables or disables timing of mesh updates and firmware callbacks
+   * 
+   * Enabling starts an empty CallProfile (see FirmwareProfiler);
+   * disabling discards it.
+   * 
+   * @param enabled true to time calls
+   */
+  void setProfiling(bool enabled);
+  
+  /**
+   * @brief Gets the call timings of this node
+   * 
+   * @return Profile, or nullptr if profiling is disabled
+   */
+  const CallProfile* getProfile() const { return profile_.get(); }
+  
+  /**
+   * @brief Enables or disables timing of the phases of update()
+   * 
+   * Used by NodeManager for its LoopMonitor. Untimed nodes pay one branch
+   * per phase.
+   * 
+   * @param enabled true to time updates
+   */
+  void setUpdateTiming(bool enabled);
+  
+  /**
+   * @brief Gets the phases of the last update()
+   * 
+   * @return Timing, or nullptr if update timing is disabled
+   */
+  const UpdateTiming* getUpdateTiming() const { return timing_.get(); }
+  
+  /**
+   * @brief Gets the time the node's next firmware task is due
+   * 
+   * @return Time on the wakeClockMs() clock, or UINT64_MAX if the firmware
+   *         has no runEvery() / runAfter() task
+   */
+  uint64_t getNextTaskTime() const;
+  
+  /**
+   * @brief Gets the firmware tasks of the node
+   */
+  const TaskQueue& getTasks() const { return tasks_; }
+  
+  /**
+   * @brief Gets the local clock error of the node
+   * 
+   * Made current with NodeClockScope whenever the node's code runs.
+   * 
+   * @return Offset and drift from NodeConfig::clock
+   */
+  const NodeClock& getClock() const { return config_.clock; }
+  
+  /**
+   * @brief Gets the clock sleep deadlines are measured on
+   * 
+   * The shared VirtualTime base in milliseconds (wall or simulation
+   * time), which the firmware's millis() and scheduler tasks follow.
+   * 
+   * @return Current time in milliseconds
+   */
+  static uint64_t wakeClockMs();
+  
   /**
    * @brief Sets the partition ID for this node
    * 
@@ -250,6 +508,15 @@ public:
    */
   uint32_t getPartitionId() const { return partition_id_; }
   
+  /**
+   * @brief Sets the seed of the node's firmware random stream
+   * 
+   * Forwarded to the loaded firmware now and to firmware loaded later.
+   * 
+   * @param seed Simulation seed
+   */
+  void setRandomSeed(uint32_t seed);
+  
   /**
    * @brief Loads firmware by name from factory
    * 
@@ -265,11 +532,12 @@ public:
    * @brief Loads firmware instance directly
    * 
    * @param firmware Unique pointer to firmware instance
+   * @param announce Log the loaded firmware (off for bulk creation)
    * 
    * Takes ownership of the provided firmware instance.
    * The firmware will be initialized when the node is started.
    */
-  void loadFirmware(std::unique_ptr<firmware::FirmwareBase> firmware);
+  void loadFirmware(std::unique_ptr<firmware::FirmwareBase> firmware, bool announce = true);
   
   /**
    * @brief Checks if firmware is loaded
@@ -284,22 +552,97 @@ public:
    * @return Pointer to firmware, or nullptr if no firmware loaded
    */
   firmware::FirmwareBase* getFirmware() const;
+  
+  /**
+   * @brief Builds the configuration handed to firmware
+   * 
+   * Mesh credentials plus sharedFirmwareConfig and firmwareConfig.
+   * 
+   * @param config Node configuration
+   * @return New immutable configuration map
+   */
+  static std::shared_ptr<const NodeFirmwareConfig> makeFirmwareConfig(const NodeConfig& config);
+  
+  /**
+   * @brief Sets the configuration handed to firmware
+   * 
+   * Lets nodes with equal configurations share one map (see
+   * NodeManager::createNodes()). Without it, the node builds its own with
+   * makeFirmwareConfig() when the firmware is first initialized.
+   * 
+   * @param config Result of makeFirmwareConfig() for this node's config
+   */
+  void setFirmwareConfig(std::shared_ptr<const NodeFirmwareConfig> config) {
+    firmware_config_ = std::move(config);
+  }
+  
+  /**
+   * @brief Writes the node's state to a checkpoint
+   * 
+   * Saves whether the node runs, its message and crash counters, partition,
+   * network quality and firmware state. The painlessMesh instance is not
+   * saved; links live in the MeshTransport.
+   * 
+   * @param out Checkpoint writer
+   */
+  void saveState(CheckpointWriter& out) const;
+  
+  /**
+   * @brief Restores state written by saveState()
+   * 
+   * Starts or stops the node to match the checkpoint, then overwrites its
+   * counters and firmware state.
+   * 
+   * @param in Checkpoint reader
+   * 
+   * @throws std::runtime_error if the checkpoint is truncated
+   */
+  void loadState(CheckpointReader& in);
 
 private:
   uint32_t node_id_;                   ///< Unique node identifier
   std::unique_ptr<MeshTest> mesh_;     ///< Mesh instance wrapper
   Scheduler* scheduler_;               ///< Task scheduler reference
   boost::asio::io_context& io_;        ///< IO context reference
+  MeshTransport* transport_{nullptr};  ///< In-process transport (optional)
+  Outbox* outbox_{nullptr};                    ///< Node outbox (optional)
+  Mailbox<IncomingMessage>* inbox_{nullptr};   ///< Node inbox (optional)
   NodeMetrics metrics_;                ///< Performance metrics
   bool running_{false};                ///< Running state flag
+  bool asleep_{false};                 ///< Firmware asked to skip updates
+  uint64_t wake_at_ms_{0};             ///< End of the current sleep (wakeClockMs())
+  std::function<void(uint32_t)> wake_listener_;  ///< Told about early wake-ups
+  TopologyListener* listener_{nullptr};  ///< Told about lifecycle changes (optional)
+  std::unique_ptr<CallProfile> profile_;  ///< Call timings (optional)
+  std::unique_ptr<UpdateTiming> timing_;  ///< Phases of the last update (optional)
+  TaskQueue tasks_;                    ///< Firmware runEvery() / runAfter() tasks
   float network_quality_{1.0f};        ///< Network quality (0.0-1.0)
   uint32_t partition_id_{0};           ///< Partition ID (0 = no partition)
+  uint32_t random_seed_{0};            ///< Seed of the firmware random stream
   NodeConfig config_;                  ///< Node configuration
+  std::shared_ptr<const NodeFirmwareConfig> firmware_config_;  ///< Firmware configuration (built on first use)
   
   // Firmware support
   std::unique_ptr<firmware::FirmwareBase> firmware_;  ///< Loaded firmware instance
   bool firmware_initialized_{false};   ///< Firmware initialization state
   
+  /**
+   * @brief Gets the firmware configuration, building it on first use
+   */
+  const std::shared_ptr<const NodeFirmwareConfig>& getFirmwareConfig();
+  
+  /**
+   * @brief Creates the mesh instance and binds loaded firmware to it
+   * 
+   * @throws std::runtime_error if the mesh instance cannot be created
+   */
+  void materialize();
+  
+  /**
+   * @brief Releases the mesh instance of a stopped lazy node
+   */
+  void hibernate();
+  
   /**
    * @brief Initializes and sets up firmware
    * 
@@ -323,6 +666,17 @@ private:
    */
   void onReceive(uint32_t from, std::string& msg);
   
+  /**
+   * @brief Callback for messages from the in-process transport
+   * 
+   * The shared payload is only copied for firmware that does not use
+   * FirmwareBase::onReceiveView().
+   * 
+   * @param from Source node ID
+   * @param msg Message content
+   */
+  void onReceive(uint32_t from, const Payload& msg);
+  
   /**
    * @brief Callback for new connections
    * 
@@ -0,0 +1,195 @@
+/**
+ * @file virtual_time.hpp
+ * @brief Time base of millis(), micros() and delay() seen by firmware
+ *
+ * This file contains VirtualTime, the clock behind the Arduino
+ * compatibility layer (include/simulator/boost/Arduino.h). painlessMesh,
+ * TaskScheduler and firmware read time only through that layer, so routing
+ * it here lets them follow the simulation clock instead of the wall clock,
+ * and gives every node its own clock offset and drift.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_VIRTUAL_TIME_HPP
+#define SIMULATOR_VIRTUAL_TIME_HPP
+
+#include <cstdint>
+
+namespace simulator {
+
+/**
+ * @brief Local clock error of one node
+ *
+ * A node's clock reads base + offset + base * drift, where base is the
+ * shared time since the start of the simulation. painlessMesh time sync
+ * (onNodeTimeAdjusted) has to correct exactly this error.
+ */
+struct NodeClock {
+  int64_t offset_us = 0;      ///< Constant offset from the shared time base
+  double drift_ppm = 0.0;     ///< Rate error in parts per million (+ = runs fast)
+
+  /**
+   * @brief Checks whether the clock differs from the shared base
+   */
+  bool isExact() const { return offset_us == 0 && drift_ppm == 0.0; }
+
+  /**
+   * @brief Converts shared time to this node's local time
+   *
+   * @param base_us Shared time in microseconds
+   * @return Local time in microseconds, clamped at 0
+   */
+  uint64_t toLocalUs(uint64_t base_us) const;
+
+  /**
+   * @brief Converts this node's local time back to shared time
+   *
+   * @param local_us Local time in microseconds
+   * @return Earliest shared time at which the clock reads at least
+   *         @p local_us (0 if it already did at the start)
+   */
+  uint64_t toBaseUs(uint64_t local_us) const;
+};
+
+/**
+ * @brief Clock read by the Arduino shim's millis(), micros() and delay()
+ *
+ * In wall mode (the default) the time base is wall time since the process
+ * started, as on a real board. In virtual mode the simulation loop
+ * publishes its virtual time with setNowUs() every tick, so a run with
+ * time_scale > 1 or "unbounded" speeds up TaskScheduler and painlessMesh
+ * timers (and getNodeTime(), which is micros() plus the sync offset)
+ * along with everything else, and delay() returns at once instead of
+ * blocking the loop.
+ *
+ * The node whose code is running is set per thread by NodeClockScope, so
+ * one shared base serves every node with its own offset and drift. Code
+ * running outside any scope sees the base unchanged.
+ *
+ * Example usage:
+ * @code
+ * VirtualTime::useVirtualClock(true);
+ * while (running) {
+ *   VirtualTime::setNowUs(clock.nowUs());
+ *   manager.updateAll();
+ *   clock.advanceBy(SimulationClock::DEFAULT_TICK_US);
+ * }
+ * @endcode
+ *
+ * @note setNowUs() should be called only by the simulation loop; reads are
+ *       safe from any worker thread.
+ */
+class VirtualTime {
+public:
+  VirtualTime() = delete;
+
+  /**
+   * @brief Selects the time base
+   *
+   * @param enabled true to follow setNowUs(), false for wall time
+   */
+  static void useVirtualClock(bool enabled);
+
+  /**
+   * @brief Checks whether the virtual time base is in use
+   */
+  static bool isVirtual();
+
+  /**
+   * @brief Publishes the current simulation time
+   *
+   * @param now_us Virtual time in microseconds since the simulation start
+   */
+  static void setNowUs(uint64_t now_us);
+
+  /**
+   * @brief Gets the shared time base, without any node's clock error
+   *
+   * @return Virtual time (pinned for this thread by a TickTimeScope, or
+   *         else published by setNowUs()), or wall time since process
+   *         start, in microseconds
+   */
+  static uint64_t baseUs();
+
+  /**
+   * @brief Gets the shared time base in milliseconds
+   */
+  static uint64_t baseMs() { return baseUs() / 1000; }
+
+  /**
+   * @brief Gets the local time of the node running on this thread
+   *
+   * @return Time in microseconds, as returned by the shim's micros()
+   */
+  static uint64_t micros();
+
+  /**
+   * @brief Gets the local time of the node running on this thread
+   *
+   * @return Time in milliseconds, as returned by the shim's millis()
+   */
+  static uint64_t millis() { return micros() / 1000; }
+
+  /**
+   * @brief Blocks for a duration, as the shim's delay()
+   *
+   * Sleeps in wall mode. In virtual mode time only moves with the
+   * simulation loop, so sleeping would stall every node; the call
+   * returns immediately.
+   *
+   * @param ms Duration in milliseconds
+   */
+  static void delay(uint32_t ms);
+
+  /**
+   * @brief Gets the clock of the node running on this thread
+   *
+   * @return Clock set by the innermost NodeClockScope, or nullptr
+   */
+  static const NodeClock* current();
+};
+
+/**
+ * @brief Makes a node's clock current on this thread for the scope
+ *
+ * VirtualNode opens one around its mesh update and every firmware
+ * callback. Scopes nest and restore the previous clock when closed; code
+ * under a null clock reads the base unchanged.
+ */
+class NodeClockScope {
+public:
+  explicit NodeClockScope(const NodeClock* clock);
+  ~NodeClockScope();
+
+  NodeClockScope(const NodeClockScope&) = delete;
+  NodeClockScope& operator=(const NodeClockScope&) = delete;
+
+private:
+  const NodeClock* previous_;
+};
+
+/**
+ * @brief Pins the virtual time base of this thread for the scope
+ *
+ * Inside a lookahead window every worker runs the ticks of its nodes on
+ * its own, ahead of the time published by the simulation loop.
+ * NodeManager opens one scope per node tick so that millis() follows
+ * that tick. Has no effect in wall mode.
+ */
+class TickTimeScope {
+public:
+  explicit TickTimeScope(uint64_t now_us);
+  ~TickTimeScope();
+
+  TickTimeScope(const TickTimeScope&) = delete;
+  TickTimeScope& operator=(const TickTimeScope&) = delete;
+
+private:
+  uint64_t previous_;
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_VIRTUAL_TIME_HPP
@@ -0,0 +1,113 @@
+/**
+ * @file worker_pool.hpp
+ * @brief Persistent worker threads for fork-join simulation phases
+ *
+ * This file contains the WorkerPool class which runs an indexed job on a
+ * fixed set of threads and waits for all of them to finish.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#ifndef SIMULATOR_WORKER_POOL_HPP
+#define SIMULATOR_WORKER_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace simulator {
+
+/**
+ * @brief Fixed pool of threads running one indexed job per phase
+ *
+ * run() hands job index i to worker i, runs index 0 on the calling thread
+ * and returns once every index has finished, so each call is a complete
+ * fork-join phase. Threads are created once and parked on a condition
+ * variable between phases instead of being spawned per call.
+ *
+ * Everything the calling thread wrote before run() is visible to the jobs,
+ * and everything the jobs wrote is visible to the caller after run()
+ * returns.
+ *
+ * Example usage:
+ * @code
+ * WorkerPool pool(4);
+ * std::vector<uint64_t> sums(4);
+ * pool.run([&](size_t i) { sums[i] = work(i); });
+ * @endcode
+ */
+class WorkerPool {
+public:
+  /// Job type; receives the index in [0, size())
+  using Job = std::function<void(size_t)>;
+
+  /**
+   * @brief Construct a pool
+   *
+   * @param size Number of job indices per phase, including the calling
+   *             thread (size - 1 threads are started)
+   *
+   * @throws std::invalid_argument if size is 0
+   */
+  explicit WorkerPool(size_t size);
+
+  /**
+   * @brief Destructor - stops and joins all worker threads
+   */
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  /**
+   * @brief Runs a job for every index and waits for completion
+   *
+   * @param job Job to run; called once per index, concurrently
+   *
+   * @throws Rethrows the first exception thrown by any job, after all
+   *         jobs have finished
+   *
+   * @note Not reentrant; must not be called from inside a job.
+   */
+  void run(const Job& job);
+
+  /**
+   * @brief Gets the number of job indices per phase
+   *
+   * @return Pool size, including the calling thread
+   */
+  size_t size() const { return threads_.size() + 1; }
+
+private:
+  std::vector<std::thread> threads_;   ///< Workers for indices 1..size()-1
+  std::mutex mutex_;                   ///< Guards all fields below
+  std::condition_variable start_cv_;   ///< Signals a new phase or shutdown
+  std::condition_variable done_cv_;    ///< Signals the last worker finished
+  const Job* job_{nullptr};            ///< Job of the current phase
+  uint64_t generation_{0};             ///< Phase counter
+  size_t pending_{0};                  ///< Workers still running this phase
+  std::exception_ptr error_;           ///< First exception of this phase
+  bool stopping_{false};               ///< Set by the destructor
+
+  /**
+   * @brief Thread body for one worker
+   *
+   * @param index Job index served by this worker
+   */
+  void workerLoop(size_t index);
+
+  /**
+   * @brief Runs the job for one index and records any exception
+   */
+  void runIndex(const Job& job, size_t index);
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_WORKER_POOL_HPP
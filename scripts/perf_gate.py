@@ -0,0 +1,313 @@
+#!/usr/bin/env python3
+"""
+Performance gate: compare benchmark and scaling results with a baseline
+
+Collects samples of the key performance metrics:
+- ns per iteration of the Google Benchmark cases (default: the
+  NetworkSimulator enqueue/deliver loop), one sample per repetition
+- ticks/s and peak RSS of every scaling sweep point, one sample per
+  repeated run
+
+and compares them with a stored baseline JSON. A metric regresses when
+its median is worse than the baseline median by more than the threshold
+AND a one-sided Mann-Whitney U test finds the shift significant
+(p <= alpha), so a single noisy run does not fail the gate. Three samples
+a side are the fewest that can reach p = 0.05. Metrics with too few samples
+for the test fall back to the threshold alone.
+
+The results can come from existing JSON files (--benchmarks, --scaling)
+or be produced here (--benchmark-exe, --simulator). --update-baseline
+stores the current samples as the new baseline.
+
+Exit codes: 0 = no regression, 1 = regression, 2 = error,
+77 = no baseline yet (reported as skipped by CTest).
+"""
+
+import argparse
+import json
+import math
+import os
+import platform
+import re
+import subprocess
+import sys
+import time
+from pathlib import Path
+from statistics import median
+from typing import Dict, List, Tuple
+
+EXIT_REGRESSION = 1
+EXIT_ERROR = 2
+EXIT_NO_BASELINE = 77
+
+DEFAULT_BENCHMARK_FILTER = r'BM_EnqueueReady/(heap|timing_wheel)/(1000|10000)$'
+
+# Nanoseconds per Google Benchmark time unit
+TIME_UNITS = {'ns': 1.0, 'us': 1e3, 'ms': 1e6, 's': 1e9}
+
+Metrics = Dict[str, Dict]
+
+
+def add_sample(metrics: Metrics, name: str, unit: str, better: str, value) -> None:
+    if value is None:
+        return
+    entry = metrics.setdefault(name, {'unit': unit, 'better': better, 'samples': []})
+    entry['samples'].append(float(value))
+
+
+def benchmark_metrics(path: Path, name_filter: str, metrics: Metrics) -> None:
+    """Add ns/iteration samples of the matching benchmarks"""
+    with open(path) as f:
+        data = json.load(f)
+    pattern = re.compile(name_filter)
+    for bench in data.get('benchmarks', []):
+        # Repetitions report each run plus mean/median/stddev aggregates
+        if bench.get('run_type', 'iteration') != 'iteration' or bench.get('error_occurred'):
+            continue
+        name = bench.get('run_name', bench['name'])
+        if not pattern.search(name):
+            continue
+        ns = bench['real_time'] * TIME_UNITS.get(bench.get('time_unit', 'ns'), 1.0)
+        add_sample(metrics, f'bench/{name}/ns_per_op', 'ns/op', 'lower', ns)
+
+
+def scaling_metrics(path: Path, metrics: Metrics) -> None:
+    """Add ticks/s and peak RSS samples of every finished scaling run"""
+    with open(path) as f:
+        data = json.load(f)
+    for run in data.get('runs', []):
+        if run.get('status') != 'ok':
+            continue
+        point = f'scaling/{run["mix"]}/{run["nodes"]}'
+        add_sample(metrics, f'{point}/ticks_per_s', 'ticks/s', 'higher', run.get('ticks_per_s'))
+        add_sample(metrics, f'{point}/peak_rss_kb', 'KiB', 'lower', run.get('peak_rss_kb'))
+
+
+def mann_whitney_p(worse: List[float], better: List[float]) -> float:
+    """
+    One-sided Mann-Whitney U test that `worse` tends to be larger
+
+    Exact p-value for small samples without ties, normal approximation
+    with tie and continuity correction otherwise.
+    """
+    n1, n2 = len(worse), len(better)
+    combined = sorted([(v, 0) for v in worse] + [(v, 1) for v in better])
+    ranks = [0.0] * len(combined)
+    ties = []
+    i = 0
+    while i < len(combined):
+        j = i
+        while j + 1 < len(combined) and combined[j + 1][0] == combined[i][0]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[k] = (i + j) / 2.0 + 1.0
+        if j > i:
+            ties.append(j - i + 1)
+        i = j + 1
+    rank_sum = sum(r for r, (_, group) in zip(ranks, combined) if group == 0)
+    u = rank_sum - n1 * (n1 + 1) / 2.0
+
+    if not ties and n1 * n2 <= 400:
+        # counts[k] = arrangements with U = k (shift recurrence over n2)
+        counts = {(0, m): [1] for m in range(n2 + 1)}
+        for a in range(1, n1 + 1):
+            counts[(a, 0)] = [1]
+            for b in range(1, n2 + 1):
+                left = counts[(a - 1, b)]   # Largest value from `worse`: +b
+                right = counts[(a, b - 1)]
+                size = a * b + 1
+                row = [0] * size
+                for k, c in enumerate(left):
+                    row[k + b] += c
+                for k, c in enumerate(right):
+                    row[k] += c
+                counts[(a, b)] = row
+        row = counts[(n1, n2)]
+        at_least = sum(row[int(round(u)):])
+        return at_least / float(sum(row))
+
+    n = n1 + n2
+    mean = n1 * n2 / 2.0
+    tie_term = sum(t ** 3 - t for t in ties) / float(n * (n - 1)) if n > 1 else 0.0
+    variance = n1 * n2 / 12.0 * ((n + 1) - tie_term)
+    if variance <= 0:
+        return 1.0
+    z = (u - mean - 0.5) / math.sqrt(variance)
+    return 0.5 * math.erfc(z / math.sqrt(2.0))
+
+
+def compare(baseline: Metrics, current: Metrics, threshold: float, alpha: float,
+            min_samples: int) -> Tuple[List[Dict], int]:
+    """Compare every baseline metric that has current samples"""
+    rows = []
+    regressions = 0
+    for name in sorted(baseline):
+        base = baseline[name]
+        if name not in current:
+            rows.append({'metric': name, 'status': 'missing'})
+            continue
+        base_samples = base['samples']
+        cur_samples = current[name]['samples']
+        base_med = median(base_samples)
+        cur_med = median(cur_samples)
+        higher = base.get('better', 'lower') == 'higher'
+        # Positive = worse, as a share of the baseline
+        if base_med == 0:
+            worse_by = 0.0
+        elif higher:
+            worse_by = (base_med - cur_med) / abs(base_med)
+        else:
+            worse_by = (cur_med - base_med) / abs(base_med)
+
+        p = None
+        if len(base_samples) >= min_samples and len(cur_samples) >= min_samples:
+            # "Worse" is larger for lower-is-better metrics; negate the others
+            sign = -1.0 if higher else 1.0
+            p = mann_whitney_p([sign * v for v in cur_samples], [sign * v for v in base_samples])
+
+        regressed = worse_by > threshold and (p is None or p <= alpha)
+        status = 'REGRESSED' if regressed else ('improved' if worse_by < -threshold else 'ok')
+        regressions += regressed
+        rows.append({
+            'metric': name, 'unit': base.get('unit', ''), 'baseline': base_med,
+            'current': cur_med, 'change': (cur_med - base_med) / abs(base_med) if base_med else 0.0,
+            'worse_by': worse_by, 'p': p, 'status': status,
+            'samples': (len(base_samples), len(cur_samples)),
+        })
+    return rows, regressions
+
+
+def print_rows(rows: List[Dict], threshold: float, alpha: float) -> None:
+    print(f'Regression: worse by more than {threshold:.0%} with Mann-Whitney p <= {alpha}')
+    width = max([len(row['metric']) for row in rows] + [6])
+    for row in rows:
+        if row['status'] == 'missing':
+            print(f'  {row["metric"]:<{width}}  not measured')
+            continue
+        p = f'p={row["p"]:.3f}' if row['p'] is not None else 'p=n/a'
+        print(f'  {row["metric"]:<{width}}  {row["baseline"]:>14.1f} -> {row["current"]:>14.1f} '
+              f'{row["unit"]:<7} {row["change"]:>+7.1%}  {p:<8} '
+              f'n={row["samples"][0]}/{row["samples"][1]}  {row["status"]}')
+
+
+def run_benchmarks(args: argparse.Namespace, workdir: Path) -> Path:
+    output = workdir / 'benchmarks.json'
+    command = [args.benchmark_exe, f'--benchmark_filter={args.benchmark_filter}',
+               f'--benchmark_repetitions={args.benchmark_repetitions}',
+               '--benchmark_format=json', f'--benchmark_out={output}']
+    print('Running', ' '.join(command), flush=True)
+    subprocess.run(command, check=True, stdout=subprocess.DEVNULL)
+    return output
+
+
+def run_scaling(args: argparse.Namespace, workdir: Path) -> Path:
+    output = workdir / 'scaling_results.json'
+    command = [sys.executable, str(Path(__file__).with_name('scaling_sweep.py')),
+               '--simulator', args.simulator, '--nodes', args.nodes, '--mixes', args.mixes,
+               '--duration', str(args.duration), '--repeat', str(args.repeat),
+               '--workdir', str(workdir / 'scaling'), '--output', str(output)]
+    print('Running', ' '.join(command), flush=True)
+    # A failed point is left out of the metrics and reported as not measured
+    subprocess.run(command, check=False)
+    return output
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(
+        description='Compare benchmark and scaling results with a stored baseline')
+    parser.add_argument('--baseline', required=True, help='Baseline JSON file')
+    parser.add_argument('--update-baseline', action='store_true',
+                        help='Write the current samples to the baseline instead of comparing')
+    sources = parser.add_argument_group('results')
+    sources.add_argument('--benchmarks', help='Google Benchmark JSON output to read')
+    sources.add_argument('--scaling', help='scaling_sweep.py JSON output to read')
+    sources.add_argument('--benchmark-exe', help='Run this simulator_benchmarks executable')
+    sources.add_argument('--benchmark-filter', default=DEFAULT_BENCHMARK_FILTER,
+                         help='Benchmarks to gate (regex, default: %(default)s)')
+    sources.add_argument('--benchmark-repetitions', type=int, default=5,
+                         help='Repetitions per benchmark (default: %(default)s)')
+    sources.add_argument('--simulator', help='Run the scaling sweep with this simulator')
+    sources.add_argument('--nodes', default='1000',
+                         help='Scaling sweep node counts (default: %(default)s)')
+    sources.add_argument('--mixes', default='broadcast',
+                         help='Scaling sweep firmware mixes (default: %(default)s)')
+    sources.add_argument('--duration', type=int, default=20,
+                         help='Virtual seconds per scaling run (default: %(default)s)')
+    sources.add_argument('--repeat', type=int, default=3,
+                         help='Scaling runs per point (default: %(default)s)')
+    sources.add_argument('--workdir', default='perf_gate',
+                         help='Directory for produced results (default: %(default)s)')
+    gate = parser.add_argument_group('gate')
+    gate.add_argument('--threshold', type=float, default=0.10,
+                      help='Largest tolerated slowdown as a fraction (default: %(default)s)')
+    gate.add_argument('--alpha', type=float, default=0.05,
+                      help='Significance level of the Mann-Whitney test (default: %(default)s)')
+    gate.add_argument('--min-samples', type=int, default=3,
+                      help='Samples per side needed for the test (default: %(default)s)')
+    gate.add_argument('--report', help='Also write the comparison to this JSON file')
+    args = parser.parse_args()
+
+    if not (args.benchmarks or args.scaling or args.benchmark_exe or args.simulator):
+        parser.error('give results to read (--benchmarks, --scaling) or to produce '
+                     '(--benchmark-exe, --simulator)')
+    if args.threshold < 0 or not 0 < args.alpha < 1 or args.min_samples < 2:
+        parser.error('need --threshold >= 0, 0 < --alpha < 1 and --min-samples >= 2')
+
+    baseline_path = Path(args.baseline)
+    if not args.update_baseline and not baseline_path.exists():
+        print(f'No baseline at {baseline_path}; record one with --update-baseline')
+        return EXIT_NO_BASELINE
+
+    workdir = Path(args.workdir)
+    workdir.mkdir(parents=True, exist_ok=True)
+    current: Metrics = {}
+    try:
+        benchmarks = run_benchmarks(args, workdir) if args.benchmark_exe else args.benchmarks
+        if benchmarks:
+            benchmark_metrics(Path(benchmarks), args.benchmark_filter, current)
+        scaling = run_scaling(args, workdir) if args.simulator else args.scaling
+        if scaling and Path(scaling).exists():
+            scaling_metrics(Path(scaling), current)
+    except (OSError, ValueError, KeyError, subprocess.CalledProcessError) as e:
+        print(f'Error: {e}', file=sys.stderr)
+        return EXIT_ERROR
+    if not current:
+        print('Error: no metrics in the results', file=sys.stderr)
+        return EXIT_ERROR
+
+    if args.update_baseline:
+        baseline_path.parent.mkdir(parents=True, exist_ok=True)
+        with open(baseline_path, 'w') as f:
+            json.dump({
+                'version': 1,
+                'created': time.strftime('%Y-%m-%dT%H:%M:%S'),
+                'host': platform.node(),
+                'platform': platform.platform(),
+                'cpus': os.cpu_count(),
+                'metrics': current,
+            }, f, indent=2, sort_keys=True)
+            f.write('\n')
+        print(f'Wrote {len(current)} metrics to {baseline_path}')
+        return 0
+
+    with open(baseline_path) as f:
+        baseline = json.load(f)
+    if baseline.get('host') and baseline['host'] != platform.node():
+        print(f'Note: baseline recorded on {baseline["host"]}, running on {platform.node()}')
+    rows, regressions = compare(baseline.get('metrics', {}), current, args.threshold,
+                                args.alpha, args.min_samples)
+    print_rows(rows, args.threshold, args.alpha)
+    if args.report:
+        with open(args.report, 'w') as f:
+            json.dump({'threshold': args.threshold, 'alpha': args.alpha, 'rows': rows}, f,
+                      indent=2)
+            f.write('\n')
+    if regressions:
+        print(f'{regressions} metric(s) regressed')
+        return EXIT_REGRESSION
+    print('No regressions')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
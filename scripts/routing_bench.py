@@ -0,0 +1,206 @@
+#!/usr/bin/env python3
+"""
+Routing benchmark: cost of painlessMesh routing calls against mesh size
+
+Generates examples/scenarios/routing_bench.yaml-style scenarios at every
+node count: one RoutingBench probe and members on random links with a
+fixed expected degree, over the painlessMesh (tcp) transport so the
+library's own routing-tree code runs. Each scenario runs in its own
+simulator process. The probe times getNodeList, subConnectionJson,
+findRoute and sendSingle every round; the median of its rounds, the
+first one left out, is reported per operation and size.
+
+The growth exponent of an operation is the slope of log(cost) over
+log(nodes) between the smallest and the largest mesh: about 1 for a
+linear walk of the tree, 2 for quadratic work. Exponents above
+--superlinear are flagged.
+"""
+
+import argparse
+import csv
+import json
+import math
+import sys
+from pathlib import Path
+from statistics import median
+from typing import Dict, List, Optional
+
+from scaling_sweep import run_simulator
+
+OPERATIONS = ['node_list', 'sub_connection_json', 'find_route', 'send_single']
+DEFAULT_NODES = [10, 50, 100, 200, 400]
+
+
+def make_scenario(nodes: int, output: Path, args: argparse.Namespace) -> str:
+    """Write the scenario YAML for one mesh size"""
+    density = min(1.0, args.degree / max(1, nodes - 1))
+    duration = args.warmup + args.interval * args.rounds + 1
+    lines = [
+        '# Generated by scripts/routing_bench.py',
+        'simulation:',
+        f'  name: "Routing benchmark, {nodes} nodes"',
+        f'  duration: {duration}',
+        f'  seed: {args.seed}',
+        f'  max_nodes: {nodes}',
+        '',
+        'network:',
+        '  latency:',
+        '    min: 5',
+        '    max: 20',
+        '    distribution: "uniform"',
+        '  packet_loss: 0.0',
+        '',
+        'nodes:',
+        '  - id: "probe"',
+        '    firmware: "RoutingBench"',
+        '    config:',
+        '      mesh_prefix: "RoutingBench"',
+        '      mesh_password: "routing_bench"',
+        '      mesh_port: 5555',
+        '      role: "probe"',
+        f'      warmup: "{args.warmup}"',
+        f'      interval: "{args.interval}"',
+        f'      calls: "{args.calls}"',
+        f'      output: "{output}"',
+    ]
+    if nodes > 1:
+        lines += [
+            '  - template: "member"',
+            f'    count: {nodes - 1}',
+            '    id_prefix: "member-"',
+            '    firmware: "RoutingBench"',
+            '    config:',
+            '      mesh_prefix: "RoutingBench"',
+            '      mesh_password: "routing_bench"',
+            '      mesh_port: 5555',
+        ]
+    lines += [
+        '',
+        'topology:',
+        '  type: "random"',
+        f'  density: {density:.6g}',
+        '',
+    ]
+    return '\n'.join(lines)
+
+
+def read_rounds(table: Path) -> Dict[str, Dict]:
+    """Median cost and mesh size per operation, without the first round"""
+    if not table.exists():
+        return {}
+    with open(table, newline='') as f:
+        rows = list(csv.DictReader(f))
+    results = {}
+    for op in OPERATIONS:
+        samples = [row for row in rows if row['operation'] == op]
+        # The first round also pays for cold caches
+        if len(samples) > 1:
+            samples = samples[1:]
+        if samples:
+            results[op] = {
+                'ns_per_call': median(float(row['ns_per_call']) for row in samples),
+                'known_nodes': median(int(row['known_nodes']) for row in samples),
+                'rounds': len(samples),
+            }
+    return results
+
+
+def growth_exponent(points: List[Dict], op: str) -> Optional[float]:
+    """Slope of log(cost) over log(nodes) from the smallest to the largest mesh"""
+    measured = [(p['results'][op]['known_nodes'], p['results'][op]['ns_per_call'])
+                for p in points if op in p.get('results', {})]
+    measured = [(n, ns) for n, ns in measured if n > 1 and ns > 0]
+    if len(measured) < 2:
+        return None
+    (n1, ns1), (n2, ns2) = min(measured), max(measured)
+    if n2 <= n1:
+        return None
+    return math.log(ns2 / ns1) / math.log(n2 / n1)
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(
+        description='Time painlessMesh routing calls at growing mesh sizes')
+    parser.add_argument('--simulator', required=True, help='painlessmesh-simulator executable')
+    parser.add_argument('--nodes', default=','.join(str(n) for n in DEFAULT_NODES),
+                        help='Comma-separated mesh sizes (default: %(default)s)')
+    parser.add_argument('--degree', type=float, default=4.0,
+                        help='Expected links per node (default: %(default)s)')
+    parser.add_argument('--warmup', type=int, default=30,
+                        help='Seconds for the mesh to form (default: %(default)s)')
+    parser.add_argument('--interval', type=int, default=10,
+                        help='Seconds between rounds (default: %(default)s)')
+    parser.add_argument('--rounds', type=int, default=4,
+                        help='Measurement rounds per size (default: %(default)s)')
+    parser.add_argument('--calls', type=int, default=20,
+                        help='Calls timed per operation and round (default: %(default)s)')
+    parser.add_argument('--seed', type=int, default=4242, help='Scenario seed')
+    parser.add_argument('--superlinear', type=float, default=1.5,
+                        help='Growth exponent flagged as superlinear (default: %(default)s)')
+    parser.add_argument('--timeout', type=float, default=None,
+                        help='Wall seconds before a run is killed')
+    parser.add_argument('--workdir', default='routing_bench',
+                        help='Directory for scenarios, tables and logs (default: %(default)s)')
+    parser.add_argument('--output', default='routing_bench_results.json',
+                        help='JSON results file (default: %(default)s)')
+    args = parser.parse_args()
+
+    try:
+        sizes = [int(n) for n in args.nodes.split(',') if n.strip()]
+    except ValueError:
+        parser.error('--nodes must be comma-separated integers')
+    if not sizes or min(sizes) < 2:
+        parser.error('--nodes needs sizes of at least 2')
+    if args.rounds < 1 or args.interval < 1 or args.calls < 1 or args.warmup < 0:
+        parser.error('--rounds, --interval and --calls must be positive')
+
+    workdir = Path(args.workdir).resolve()
+    workdir.mkdir(parents=True, exist_ok=True)
+    points = []
+    for i, nodes in enumerate(sizes, 1):
+        name = f'routing_bench_{nodes}'
+        scenario = workdir / f'{name}.yaml'
+        table = workdir / f'{name}.csv'
+        log = workdir / f'{name}.log'
+        if table.exists():
+            table.unlink()
+        scenario.write_text(make_scenario(nodes, table, args))
+
+        print(f'[{i}/{len(sizes)}] {nodes} nodes ...', end='', flush=True)
+        command = [args.simulator, '--config', str(scenario), '--no-scenario-cache',
+                   '--log-level', 'WARN', '--output', str(workdir / name)]
+        code, rss_kb, timed_out = run_simulator(command, log, args.timeout)
+        results = read_rounds(table)
+        status = 'ok' if results else \
+            (f'timeout after {args.timeout} s' if timed_out else f'no rounds (exit code {code})')
+        points.append({'nodes': nodes, 'status': status, 'peak_rss_kb': rss_kb,
+                       'results': results})
+        if not results:
+            print(f' {status}, see {log}')
+            continue
+        print(' ' + ', '.join(f'{op} {r["ns_per_call"] / 1000:.1f} us'
+                              for op, r in results.items()))
+
+    growth = {op: growth_exponent(points, op) for op in OPERATIONS}
+    with open(args.output, 'w') as f:
+        json.dump({'nodes': sizes, 'degree': args.degree, 'calls': args.calls,
+                   'points': points, 'growth': growth}, f, indent=2)
+        f.write('\n')
+
+    print('\nCost per call (us) by mesh size:')
+    print(f'  {"operation":<20}' + ''.join(f'{n:>10}' for n in sizes) + '    growth')
+    for op in OPERATIONS:
+        cells = []
+        for point in points:
+            r = point['results'].get(op)
+            cells.append(f'{r["ns_per_call"] / 1000:>10.1f}' if r else f'{"-":>10}')
+        exponent = growth[op]
+        note = '' if exponent is None else f'  n^{exponent:.2f}' + \
+            ('  superlinear' if exponent > args.superlinear else '')
+        print(f'  {op:<20}' + ''.join(cells) + note)
+    print(f'Results: {args.output}')
+    return 0 if any(point['results'] for point in points) else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,332 @@
+#!/usr/bin/env python3
+"""
+Scaling sweep: end-to-end scaling curves of the simulator
+
+Generates stress_test.yaml-style scenarios for every combination of node
+count and firmware mix, runs each one in its own simulator process for a
+fixed virtual duration (a one-run --sweep, so the run is headless and
+unbounded), and writes wall time, ticks/sec, peak RSS, messages/sec and
+link latency percentiles per run to a JSON file.
+
+Each run gets its own process so its peak RSS is its own; runs are
+sequential so they do not compete for cores. With --repeat, every point
+runs several times, giving scripts/perf_gate.py samples to compare.
+"""
+
+import argparse
+import csv
+import json
+import os
+import platform
+import subprocess
+import sys
+import tempfile
+import time
+from pathlib import Path
+from typing import Dict, List, Optional, Tuple
+
+# Firmware mixes: (template, firmware, share of the nodes, firmware config).
+# The last entry of a mix takes the nodes left over by rounding.
+MIXES: Dict[str, List[Tuple[str, str, float, Dict[str, str]]]] = {
+    'idle': [
+        ('node', '', 1.0, {}),
+    ],
+    'broadcast': [
+        ('sensor', 'SimpleBroadcast', 1.0,
+         {'broadcast_interval': '5000', 'broadcast_message': 'Reading from'}),
+    ],
+    'echo': [
+        ('server', 'EchoServer', 0.1, {}),
+        ('client', 'EchoClient', 0.9, {'server_node_id': '0', 'request_interval': '5'}),
+    ],
+    'mixed': [
+        ('sensor', 'SimpleBroadcast', 0.5,
+         {'broadcast_interval': '10000', 'broadcast_message': 'Reading from'}),
+        ('server', 'EchoServer', 0.1, {}),
+        ('client', 'EchoClient', 0.2, {'server_node_id': '0', 'request_interval': '10'}),
+        ('node', '', 0.2, {}),
+    ],
+}
+
+DEFAULT_NODES = [10, 100, 1000, 10000]
+
+
+def template_counts(mix: str, nodes: int) -> List[Tuple[str, str, int, Dict[str, str]]]:
+    """Split a node count across the templates of a mix"""
+    entries = MIXES[mix]
+    counts = []
+    left = nodes
+    for i, (name, firmware, share, config) in enumerate(entries):
+        count = left if i == len(entries) - 1 else min(left, max(1, round(nodes * share)))
+        left -= count
+        if count > 0:
+            counts.append((name, firmware, count, config))
+    return counts
+
+
+def make_scenario(nodes: int, mix: str, args: argparse.Namespace) -> str:
+    """Write the scenario YAML for one run"""
+    # Random topology with the same expected degree at every size
+    density = min(1.0, args.degree / max(1, nodes - 1))
+    lines = [
+        '# Generated by scripts/scaling_sweep.py',
+        'simulation:',
+        f'  name: "Scaling {nodes} nodes, {mix}"',
+        f'  duration: {args.duration}',
+        f'  seed: {args.seed}',
+        f'  max_nodes: {nodes}',
+        f'  node_engine: {args.node_engine}',
+        '',
+        'network:',
+        '  transport: in_process',
+        '  latency:',
+        '    min: 20',
+        '    max: 100',
+        '    distribution: "normal"',
+        f'  packet_loss: {args.packet_loss}',
+        '',
+        'nodes:',
+    ]
+    for name, firmware, count, config in template_counts(mix, nodes):
+        lines += [
+            f'  - template: "{name}"',
+            f'    count: {count}',
+            f'    id_prefix: "{name}-"',
+        ]
+        if firmware:
+            lines.append(f'    firmware: "{firmware}"')
+        lines += [
+            '    config:',
+            '      mesh_prefix: "ScalingMesh"',
+            '      mesh_password: "scaling_password"',
+            '      mesh_port: 5555',
+        ]
+        lines += [f'      {key}: "{value}"' for key, value in config.items()]
+    lines += [
+        '',
+        'topology:',
+        '  type: "random"',
+        f'  density: {density:.6g}',
+        '',
+    ]
+    return '\n'.join(lines)
+
+
+def run_simulator(command: List[str], log_path: Path,
+                  timeout: Optional[float]) -> Tuple[int, Optional[int], bool]:
+    """
+    Run one simulator process
+
+    Returns the exit code, the peak RSS in KiB (None where the platform
+    cannot report it per process) and whether the run timed out.
+    """
+    with open(log_path, 'w') as log:
+        process = subprocess.Popen(command, stdout=log, stderr=subprocess.STDOUT)
+        if not hasattr(os, 'wait4'):
+            try:
+                return process.wait(timeout=timeout), None, False
+            except subprocess.TimeoutExpired:
+                process.kill()
+                process.wait()
+                return -1, None, True
+
+        # wait4() reports the resource usage of this child alone
+        deadline = time.monotonic() + timeout if timeout else None
+        timed_out = False
+        while True:
+            pid, status, usage = os.wait4(process.pid, os.WNOHANG if deadline else 0)
+            if pid != 0:
+                break
+            if time.monotonic() > deadline:
+                process.kill()
+                timed_out = True
+                deadline = None
+            else:
+                time.sleep(0.05)
+        process.returncode = os.waitstatus_to_exitcode(status) \
+            if hasattr(os, 'waitstatus_to_exitcode') else status >> 8
+        # ru_maxrss is KiB on Linux and bytes on macOS
+        rss_kb = usage.ru_maxrss // 1024 if platform.system() == 'Darwin' else usage.ru_maxrss
+        return process.returncode, rss_kb, timed_out
+
+
+def read_result(table: Path) -> Optional[Dict[str, str]]:
+    """Read the only row of a one-run sweep table"""
+    if not table.exists():
+        return None
+    with open(table, newline='') as f:
+        rows = list(csv.DictReader(f))
+    return rows[0] if rows else None
+
+
+def per_second(count: float, seconds: float) -> Optional[float]:
+    return round(count / seconds, 1) if seconds > 0 else None
+
+
+def run_point(nodes: int, mix: str, repeat: int, args: argparse.Namespace,
+              workdir: Path) -> Dict:
+    """Generate, run and measure one scenario"""
+    name = f'scaling_{mix}_{nodes}' + (f'_{repeat}' if args.repeat > 1 else '')
+    scenario = workdir / f'{name}.yaml'
+    sweep = workdir / f'{name}.sweep.yaml'
+    table = workdir / f'{name}.csv'
+    log = workdir / f'{name}.log'
+    scenario.write_text(make_scenario(nodes, mix, args))
+    sweep.write_text(f'parameters:\n  seed: [{args.seed}]\njobs: 1\noutput: "{table}"\n')
+    if table.exists():
+        table.unlink()
+
+    command = [args.simulator, '--config', str(scenario), '--sweep', str(sweep),
+               '--no-scenario-cache', '--log-level', 'WARN']
+    started = time.monotonic()
+    code, rss_kb, timed_out = run_simulator(command, log, args.timeout)
+    process_s = time.monotonic() - started
+
+    entry = {
+        'nodes': nodes,
+        'mix': mix,
+        'repeat': repeat,
+        'node_engine': args.node_engine,
+        'duration_s': args.duration,
+        'exit_code': code,
+        'process_wall_s': round(process_s, 3),
+        'peak_rss_kb': rss_kb,
+        'log': str(log),
+    }
+    row = read_result(table)
+    if timed_out:
+        entry['status'] = f'timeout after {args.timeout} s'
+    elif row is None:
+        entry['status'] = f'no result (exit code {code})'
+    else:
+        entry['status'] = row['status']
+    if row is None:
+        return entry
+
+    wall_s = int(row['wall_ms']) / 1000.0
+    simulated_s = int(row['simulated_ms']) / 1000.0
+    ticks = int(row['updates'])
+    sent = int(row['messages_sent'])
+    received = int(row['messages_received'])
+    delivered = int(row['link_delivered'])
+    lost = int(row['link_lost'])
+    entry.update({
+        'simulated_nodes': int(row['simulated_nodes']),
+        'wall_s': wall_s,
+        'simulated_s': simulated_s,
+        'sim_wall_ratio': round(simulated_s / wall_s, 3) if wall_s > 0 else None,
+        'ticks': ticks,
+        'ticks_per_s': per_second(ticks, wall_s),
+        'messages_sent': sent,
+        'messages_received': received,
+        'messages_per_s': per_second(received, wall_s),
+        'frames_dropped': int(row['frames_dropped']),
+        'link_delivered': delivered,
+        'link_lost': lost,
+        'delivery_ratio': round(delivered / (delivered + lost), 6) if delivered + lost else None,
+        'latency_ms': {
+            'p50': int(row['latency_p50_ms']),
+            'p95': int(row['latency_p95_ms']),
+            'p99': int(row['latency_p99_ms']),
+        },
+    })
+    return entry
+
+
+def parse_list(text: str) -> List[str]:
+    return [item.strip() for item in text.split(',') if item.strip()]
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(
+        description='Run the simulator across node counts and firmware mixes '
+                    'and write scaling results as JSON')
+    parser.add_argument('--simulator', required=True,
+                        help='Path to the painlessmesh-simulator executable')
+    parser.add_argument('--nodes', default=','.join(map(str, DEFAULT_NODES)),
+                        help='Comma-separated node counts (default: %(default)s)')
+    parser.add_argument('--mixes', default='broadcast,echo,mixed',
+                        help=f'Comma-separated firmware mixes out of {", ".join(MIXES)} '
+                             '(default: %(default)s)')
+    parser.add_argument('--duration', type=int, default=60,
+                        help='Virtual seconds per run (default: %(default)s)')
+    parser.add_argument('--node-engine', choices=['mesh', 'fluid'], default='mesh',
+                        help='simulation.node_engine of every run (default: %(default)s)')
+    parser.add_argument('--degree', type=float, default=4.0,
+                        help='Expected links per node of the random topology '
+                             '(default: %(default)s)')
+    parser.add_argument('--packet-loss', type=float, default=0.0,
+                        help='Link packet loss probability (default: %(default)s)')
+    parser.add_argument('--seed', type=int, default=54321,
+                        help='Seed of every run (default: %(default)s)')
+    parser.add_argument('--repeat', type=int, default=1,
+                        help='Runs per point, for run-to-run noise (default: %(default)s)')
+    parser.add_argument('--timeout', type=float, default=None,
+                        help='Wall seconds before a run is killed (default: none)')
+    parser.add_argument('--workdir', default=None,
+                        help='Directory for scenarios, tables and logs '
+                             '(default: a temporary directory)')
+    parser.add_argument('--output', default='scaling_results.json',
+                        help='JSON results file (default: %(default)s)')
+    args = parser.parse_args()
+
+    try:
+        node_counts = [int(n) for n in parse_list(args.nodes)]
+    except ValueError:
+        parser.error('--nodes takes whole numbers')
+    if not node_counts or min(node_counts) < 1:
+        parser.error('--nodes needs at least one count of 1 or more')
+    mixes = parse_list(args.mixes)
+    unknown = [mix for mix in mixes if mix not in MIXES]
+    if unknown or not mixes:
+        parser.error(f'unknown firmware mix: {", ".join(unknown)} (known: {", ".join(MIXES)})')
+    if args.duration < 1:
+        parser.error('--duration must be at least 1')
+    if args.repeat < 1:
+        parser.error('--repeat must be at least 1')
+    if not Path(args.simulator).exists():
+        parser.error(f'simulator not found: {args.simulator}')
+
+    workdir = Path(args.workdir or tempfile.mkdtemp(prefix='scaling_sweep_')).resolve()
+    workdir.mkdir(parents=True, exist_ok=True)
+
+    runs = []
+    failed = 0
+    total = len(mixes) * len(node_counts) * args.repeat
+    for mix in mixes:
+        for nodes in sorted(node_counts):
+            for repeat in range(args.repeat):
+                print(f'[{len(runs) + 1}/{total}] {nodes} nodes, {mix} ...', end='', flush=True)
+                entry = run_point(nodes, mix, repeat, args, workdir)
+                runs.append(entry)
+                if entry['status'] != 'ok':
+                    failed += 1
+                    print(f' {entry["status"]} (see {entry["log"]})')
+                else:
+                    rss = f'{entry["peak_rss_kb"] / 1024:.0f} MiB' \
+                        if entry['peak_rss_kb'] is not None else 'n/a'
+                    print(f' {entry["wall_s"]:.1f} s wall, {entry["ticks_per_s"]} ticks/s, '
+                          f'{entry["messages_per_s"]} msg/s, RSS {rss}')
+
+    results = {
+        'simulator': str(Path(args.simulator).resolve()),
+        'host': platform.node(),
+        'platform': platform.platform(),
+        'cpus': os.cpu_count(),
+        'duration_s': args.duration,
+        'node_engine': args.node_engine,
+        'degree': args.degree,
+        'packet_loss': args.packet_loss,
+        'seed': args.seed,
+        'repeat': args.repeat,
+        'runs': runs,
+    }
+    with open(args.output, 'w') as f:
+        json.dump(results, f, indent=2)
+        f.write('\n')
+    print(f'Results: {args.output} ({len(runs) - failed} of {len(runs)} runs ok)')
+    return 0 if failed == 0 else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
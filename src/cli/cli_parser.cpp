@@ -13,11 +13,42 @@
 #include <boost/program_options.hpp>
 #include <iostream>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace po = boost::program_options;
 
 namespace simulator {
 
+namespace {
+
+// Checks that a TCP port number is usable
+uint16_t parsePort(unsigned long port) {
+  if (port == 0 || port > 65535) {
+    throw std::runtime_error("Port must be between 1 and 65535, got " + std::to_string(port));
+  }
+  return static_cast<uint16_t>(port);
+}
+
+// Splits a comma-separated list, skipping empty items
+std::vector<std::string> splitList(const std::string& list) {
+  std::vector<std::string> items;
+  size_t start = 0;
+  while (start <= list.size()) {
+    size_t end = list.find(',', start);
+    if (end == std::string::npos) {
+      end = list.size();
+    }
+    if (end > start) {
+      items.push_back(list.substr(start, end - start));
+    }
+    start = end + 1;
+  }
+  return items;
+}
+
+} // anonymous namespace
+
 /**
  * @brief Parse command-line arguments
  * 
@@ -43,8 +74,35 @@ CLIOptions parseCommandLine(int argc, char* argv[]) {
     ("ui,u", po::value<std::string>()->default_value("none"), 
      "UI mode (none, terminal)")
     ("validate-only", "Validate configuration and exit")
+    ("no-scenario-cache", "Always parse and validate the YAML file; do not read or write <config>.pmsc")
     ("time-scale,t", po::value<float>(), 
      "Override time scale multiplier (1.0 = real-time)")
+    ("unbounded", "Run the virtual clock as fast as possible (overrides time scale)")
+    ("threads", po::value<uint32_t>(), "Override number of worker threads updating nodes")
+    ("max-nodes", po::value<uint32_t>(), "Override the maximum number of nodes")
+    ("seed", po::value<uint32_t>(), "Override the random seed (0 = random)")
+    ("coordinator", po::value<uint32_t>(), "Coordinate a distributed run, listening on this port")
+    ("workers", po::value<uint32_t>(), "Number of worker processes (with --coordinator)")
+    ("worker", po::value<std::string>(), "Run as a distributed worker of the coordinator at host:port")
+    ("rank", po::value<uint32_t>(), "Rank of this worker, from 0 to workers - 1 (with --worker)")
+    ("checkpoint", po::value<std::string>(), "Write a checkpoint to this file (with --checkpoint-at)")
+    ("checkpoint-at", po::value<float>(), "Virtual time in seconds at which to write the checkpoint")
+    ("restore", po::value<std::string>(), "Resume from a checkpoint of the same scenario and seed")
+    ("capture", po::value<std::string>(), "Write every message's delivery path to this pcapng file")
+    ("capture-nodes", po::value<std::string>(), "Capture only traffic from or to these nodes (id,id,...)")
+    ("capture-links", po::value<std::string>(), "Capture only traffic on these links (a:b,c:d,...)")
+    ("capture-payload", po::value<uint32_t>(), "Payload bytes kept per captured message (0-64, default 0)")
+    ("metrics-port", po::value<uint32_t>(), "Serve live Prometheus metrics at http://<host>:<port>/metrics")
+    ("profile-firmware", po::value<uint32_t>(), "Time firmware callbacks and report the N costliest nodes")
+    ("trace", po::value<std::string>(), "Write a Chrome/Perfetto trace of the simulation loop to this JSON file")
+    ("update-budget", po::value<uint32_t>(), "Time node updates and flag those longer than this many microseconds")
+    ("memory-report", "Report heap allocations per subsystem while running and at exit")
+    ("dump-window", po::value<uint32_t>(), "Milliseconds a state dump (SIGUSR1) measures node costs for (default: 1000)")
+    ("dump-profile", "Also sample the simulation thread's stacks during state dumps")
+    ("sweep", po::value<std::string>(), "Run the scenario once per parameter combination of this sweep file")
+    ("ensemble", po::value<uint32_t>(), "Run the scenario with N seeds and report aggregate statistics")
+    ("ci-width", po::value<double>(), "Stop an ensemble once the delivery ratio's 95% CI is narrower than this")
+    ("jobs,j", po::value<uint32_t>(), "Concurrent sweep or ensemble runs (0 = one per hardware thread)")
   ;
   
   po::variables_map vm;
@@ -65,6 +123,21 @@ CLIOptions parseCommandLine(int argc, char* argv[]) {
     std::cout << "  " << argv[0] << " --config scenario.yaml --duration 120 --log-level DEBUG\n";
     std::cout << "  " << argv[0] << " --config scenario.yaml --validate-only\n";
     std::cout << "  " << argv[0] << " --config scenario.yaml --ui terminal --time-scale 2.0\n";
+    std::cout << "  " << argv[0] << " --config soak_24h.yaml --unbounded\n";
+    std::cout << "  " << argv[0] << " --config large_mesh.yaml --unbounded --threads 8\n";
+    std::cout << "  " << argv[0] << " --config large_mesh.yaml --coordinator 7700 --workers 2\n";
+    std::cout << "  " << argv[0] << " --config large_mesh.yaml --worker host:7700 --rank 0\n";
+    std::cout << "  " << argv[0] << " --config warmup.yaml --checkpoint warm.ckpt --checkpoint-at 600\n";
+    std::cout << "  " << argv[0] << " --config what_if.yaml --restore warm.ckpt\n";
+    std::cout << "  " << argv[0] << " --config routing.yaml --capture run.pcapng --capture-nodes gateway\n";
+    std::cout << "  " << argv[0] << " --config long_run.yaml --metrics-port 9100\n";
+    std::cout << "  " << argv[0] << " --config large_mesh.yaml --profile-firmware 10\n";
+    std::cout << "  " << argv[0] << " --config large_mesh.yaml --unbounded --trace run.trace.json\n";
+    std::cout << "  " << argv[0] << " --config large_mesh.yaml --update-budget 5000\n";
+    std::cout << "  " << argv[0] << " --config large_mesh.yaml --unbounded --memory-report\n";
+    std::cout << "  " << argv[0] << " --config large_mesh.yaml --dump-profile   # then: kill -USR1 <pid>\n";
+    std::cout << "  " << argv[0] << " --config capacity.yaml --sweep capacity.sweep.yaml --jobs 8\n";
+    std::cout << "  " << argv[0] << " --config lossy.yaml --ensemble 200 --ci-width 0.01\n";
     std::cout << std::endl;
     return options;
   }
@@ -89,6 +162,8 @@ CLIOptions parseCommandLine(int argc, char* argv[]) {
   options.output_dir = vm["output"].as<std::string>();
   options.ui_mode = vm["ui"].as<std::string>();
   options.validate_only = vm.count("validate-only") > 0;
+  options.unbounded = vm.count("unbounded") > 0;
+  options.scenario_cache = vm.count("no-scenario-cache") == 0;
   
   // Parse optional overrides
   if (vm.count("duration")) {
@@ -99,6 +174,119 @@ CLIOptions parseCommandLine(int argc, char* argv[]) {
     options.time_scale = vm["time-scale"].as<float>();
   }
   
+  if (vm.count("threads")) {
+    options.threads = vm["threads"].as<uint32_t>();
+  }
+  
+  if (vm.count("max-nodes")) {
+    options.max_nodes = vm["max-nodes"].as<uint32_t>();
+  }
+  
+  if (vm.count("seed")) {
+    options.seed = vm["seed"].as<uint32_t>();
+  }
+  
+  if (vm.count("coordinator")) {
+    options.coordinator_port = parsePort(vm["coordinator"].as<uint32_t>());
+  }
+  
+  if (vm.count("workers")) {
+    options.workers = vm["workers"].as<uint32_t>();
+  }
+  
+  if (vm.count("worker")) {
+    const std::string address = vm["worker"].as<std::string>();
+    const size_t colon = address.rfind(':');
+    if (colon == std::string::npos || colon == 0 || colon + 1 == address.size()) {
+      throw std::runtime_error("Invalid coordinator address: " + address +
+                               ". Must be host:port");
+    }
+    options.worker_host = address.substr(0, colon);
+    try {
+      options.worker_port = parsePort(std::stoul(address.substr(colon + 1)));
+    } catch (const std::logic_error&) {
+      throw std::runtime_error("Invalid coordinator port in: " + address);
+    }
+  }
+  
+  if (vm.count("rank")) {
+    options.rank = vm["rank"].as<uint32_t>();
+  }
+  
+  if (vm.count("checkpoint")) {
+    options.checkpoint_file = vm["checkpoint"].as<std::string>();
+  }
+  
+  if (vm.count("checkpoint-at")) {
+    options.checkpoint_at = vm["checkpoint-at"].as<float>();
+  }
+  
+  if (vm.count("restore")) {
+    options.restore_file = vm["restore"].as<std::string>();
+  }
+  
+  if (vm.count("capture")) {
+    options.capture_file = vm["capture"].as<std::string>();
+  }
+  
+  if (vm.count("capture-nodes")) {
+    options.capture_nodes = splitList(vm["capture-nodes"].as<std::string>());
+  }
+  
+  if (vm.count("capture-links")) {
+    for (const auto& link : splitList(vm["capture-links"].as<std::string>())) {
+      const size_t colon = link.find(':');
+      if (colon == std::string::npos || colon == 0 || colon + 1 == link.size()) {
+        throw std::runtime_error("Invalid capture link: " + link + ". Must be from:to");
+      }
+      options.capture_links.emplace_back(link.substr(0, colon), link.substr(colon + 1));
+    }
+  }
+  
+  if (vm.count("capture-payload")) {
+    options.capture_payload = vm["capture-payload"].as<uint32_t>();
+  }
+  
+  if (vm.count("metrics-port")) {
+    options.metrics_port = parsePort(vm["metrics-port"].as<uint32_t>());
+  }
+  
+  if (vm.count("profile-firmware")) {
+    options.profile_top = vm["profile-firmware"].as<uint32_t>();
+  }
+  
+  if (vm.count("trace")) {
+    options.trace_file = vm["trace"].as<std::string>();
+  }
+  
+  if (vm.count("update-budget")) {
+    options.update_budget_us = vm["update-budget"].as<uint32_t>();
+  }
+  
+  options.memory_report = vm.count("memory-report") > 0;
+  
+  if (vm.count("dump-window")) {
+    options.dump_window_ms = vm["dump-window"].as<uint32_t>();
+  }
+  
+  options.dump_profile = vm.count("dump-profile") > 0;
+  
+  if (vm.count("sweep")) {
+    options.sweep_file = vm["sweep"].as<std::string>();
+  }
+  
+  if (vm.count("ensemble")) {
+    options.ensemble_runs = vm["ensemble"].as<uint32_t>();
+  }
+  
+  if (vm.count("ci-width")) {
+    options.ci_width = vm["ci-width"].as<double>();
+  }
+  
+  if (vm.count("jobs")) {
+    options.jobs = vm["jobs"].as<uint32_t>();
+  }
+  
   // Validate log level
   if (options.log_level != "DEBUG" && options.log_level != "INFO" && 
       options.log_level != "WARN" && options.log_level != "ERROR") {
@@ -117,6 +305,131 @@ CLIOptions parseCommandLine(int argc, char* argv[]) {
     throw std::runtime_error("Time scale must be greater than 0");
   }
   
+  // Validate thread count if provided
+  if (options.threads && *options.threads == 0) {
+    throw std::runtime_error("Thread count must be at least 1");
+  }
+  
+  // Validate node cap if provided
+  if (options.max_nodes && *options.max_nodes == 0) {
+    throw std::runtime_error("Maximum node count must be at least 1");
+  }
+  
+  // Validate distributed roles
+  if (options.coordinator_port && options.worker_port) {
+    throw std::runtime_error("--coordinator and --worker are mutually exclusive");
+  }
+  if (options.coordinator_port && (!options.workers || *options.workers == 0)) {
+    throw std::runtime_error("--coordinator needs --workers with at least 1 worker");
+  }
+  if (options.workers && !options.coordinator_port) {
+    throw std::runtime_error("--workers is only valid with --coordinator");
+  }
+  if (options.worker_port && !options.rank) {
+    throw std::runtime_error("--worker needs --rank");
+  }
+  if (options.rank && !options.worker_port) {
+    throw std::runtime_error("--rank is only valid with --worker");
+  }
+  
+  // Validate checkpoints
+  if (options.checkpoint_file.empty() != !options.checkpoint_at) {
+    throw std::runtime_error("--checkpoint and --checkpoint-at must be given together");
+  }
+  if (options.checkpoint_at && *options.checkpoint_at < 0.0f) {
+    throw std::runtime_error("Checkpoint time must not be negative");
+  }
+  if ((options.checkpoint_at || !options.restore_file.empty()) &&
+      (options.coordinator_port || options.worker_port)) {
+    throw std::runtime_error("Checkpoints are not supported in distributed runs");
+  }
+  
+  // Validate packet capture
+  if (options.capture_file.empty() &&
+      (vm.count("capture-nodes") || vm.count("capture-links") || vm.count("capture-payload"))) {
+    throw std::runtime_error("--capture-nodes, --capture-links and --capture-payload need --capture");
+  }
+  if (options.capture_payload > 64) {
+    throw std::runtime_error("Capture payload must be at most 64 bytes");
+  }
+  
+  // Validate live metrics
+  if (options.metrics_port && (options.coordinator_port || options.worker_port)) {
+    throw std::runtime_error("Live metrics are not supported in distributed runs");
+  }
+  
+  // Validate firmware profiling
+  if (vm.count("profile-firmware") && options.profile_top == 0) {
+    throw std::runtime_error("--profile-firmware needs at least 1 node to report");
+  }
+  if (options.profile_top > 0 && (options.coordinator_port || options.worker_port)) {
+    throw std::runtime_error("Firmware profiling is not supported in distributed runs");
+  }
+  
+  // Validate tracing
+  if (vm.count("trace") && options.trace_file.empty()) {
+    throw std::runtime_error("--trace needs a file name");
+  }
+  if (!options.trace_file.empty() && (options.coordinator_port || options.worker_port)) {
+    throw std::runtime_error("Tracing is not supported in distributed runs");
+  }
+  
+  // Validate the slow-node watchdog
+  if (vm.count("update-budget") && options.update_budget_us == 0) {
+    throw std::runtime_error("--update-budget must be at least 1 microsecond");
+  }
+  if (options.update_budget_us > 0 && (options.coordinator_port || options.worker_port)) {
+    throw std::runtime_error("The update watchdog is not supported in distributed runs");
+  }
+  
+  // Validate the memory report
+  if (options.memory_report && (options.coordinator_port || options.worker_port)) {
+    throw std::runtime_error("Memory reports are not supported in distributed runs");
+  }
+  
+  // Validate state dumps; a zero window dumps the state without node costs
+  const bool dump_options = vm.count("dump-window") > 0 || options.dump_profile;
+  if (options.dump_profile && options.dump_window_ms == 0) {
+    throw std::runtime_error("--dump-profile needs a --dump-window of at least 1 millisecond");
+  }
+  if (dump_options && (options.coordinator_port || options.worker_port)) {
+    throw std::runtime_error("State dumps are not supported in distributed runs");
+  }
+  
+  // Validate parameter sweeps and ensembles; their runs share the process
+  // and write only their results
+  const bool batch = !options.sweep_file.empty() || options.ensemble_runs > 0;
+  if (vm.count("ensemble") && options.ensemble_runs == 0) {
+    throw std::runtime_error("--ensemble needs at least 1 run");
+  }
+  if (!options.sweep_file.empty() && options.ensemble_runs > 0) {
+    throw std::runtime_error("--sweep and --ensemble cannot be combined");
+  }
+  if (options.ci_width && options.ensemble_runs == 0) {
+    throw std::runtime_error("--ci-width is only valid with --ensemble");
+  }
+  if (options.ci_width && !(*options.ci_width > 0.0)) {
+    throw std::runtime_error("--ci-width must be greater than 0");
+  }
+  if (options.jobs && !batch) {
+    throw std::runtime_error("--jobs is only valid with --sweep or --ensemble");
+  }
+  if (batch &&
+      (options.coordinator_port || options.worker_port || !options.checkpoint_file.empty() ||
+       !options.restore_file.empty() || !options.capture_file.empty() || options.metrics_port ||
+       options.profile_top > 0 || !options.trace_file.empty() || options.update_budget_us > 0 ||
+       options.memory_report || dump_options)) {
+    throw std::runtime_error("Sweeps and ensembles cannot be combined with distributed runs, "
+                             "checkpoints, capture, live metrics, profiling, tracing, "
+                             "the update watchdog, memory reports or state dumps");
+  }
+  
+  // The terminal dashboard watches the local run loop
+  if (options.ui_mode == "terminal" &&
+      (batch || options.coordinator_port || options.worker_port)) {
+    throw std::runtime_error("--ui terminal is only supported in single local runs");
+  }
+  
   return options;
 }
 
@@ -10,16 +10,30 @@
 #include "simulator/platform_compat.hpp"
 
 #include "simulator/config_loader.hpp"
+#include "simulator/gateway.hpp"
+#include "simulator/metrics_collector.hpp"
+#include "simulator/traffic_generator.hpp"
 #include <yaml-cpp/yaml.h>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include "simulator/worker_pool.hpp"
 #include <algorithm>
+#include <cmath>
 #include <functional>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace simulator {
 
 namespace {
+  // Largest accepted node clock drift (10%, far beyond any real crystal)
+  constexpr double MAX_CLOCK_DRIFT_PPM = 100000.0;
+  
+  // Bounds of simulation.max_tick_ms: one fixed tick up to a minute
+  constexpr uint32_t MIN_TICK_MS = 10;
+  constexpr uint32_t MAX_TICK_MS = 60000;
+  
   // Helper to check if YAML node has key
   bool hasKey(const YAML::Node& node, const std::string& key) {
     return node[key].IsDefined();
@@ -49,6 +63,12 @@ namespace {
     return hasKey(node, key) ? node[key].as<float>() : default_value;
   }
   
+  // Helper to safely get double with default
+  double getDouble(const YAML::Node& node, const std::string& key, 
+                   double default_value = 0.0) {
+    return hasKey(node, key) ? node[key].as<double>() : default_value;
+  }
+  
   // Helper to safely get uint64_t with default
   uint64_t getUInt64(const YAML::Node& node, const std::string& key, 
                      uint64_t default_value = 0) {
@@ -60,8 +80,43 @@ namespace {
                bool default_value = false) {
     return hasKey(node, key) ? node[key].as<bool>() : default_value;
   }
+  
+  // Helper to read the local clock error of a node or template
+  void parseClock(const YAML::Node& node, NodeConfigExtended& config) {
+    if (hasKey(node, "clock")) {
+      const auto& clock = node["clock"];
+      config.clock_offset_ms = hasKey(clock, "offset_ms") ? clock["offset_ms"].as<int32_t>() : 0;
+      config.clock_drift_ppm = getDouble(clock, "drift_ppm", 0.0);
+    }
+  }
+  
+  // Helper to read firmware keys (all but the mesh fields) of a config section
+  std::shared_ptr<const FirmwareConfigMap> getFirmwareConfig(const YAML::Node& cfg) {
+    FirmwareConfigMap values;
+    for (const auto& kv : cfg) {
+      std::string key = kv.first.as<std::string>();
+      if (key != "mesh_prefix" && key != "mesh_password" && key != "mesh_port") {
+        values[key] = kv.second.as<std::string>();
+      }
+    }
+    if (values.empty()) {
+      return nullptr;
+    }
+    return std::make_shared<const FirmwareConfigMap>(std::move(values));
+  }
+  
+  // Helper to read Gilbert-Elliott keys; missing keys keep the current values
+  void getGilbertElliott(const YAML::Node& node, PacketLossConfig& config) {
+    config.gilbert_elliott = getBool(node, "gilbert_elliott", config.gilbert_elliott);
+    config.good_to_bad = getFloat(node, "good_to_bad", config.good_to_bad);
+    config.bad_to_good = getFloat(node, "bad_to_good", config.bad_to_good);
+    config.loss_good = getFloat(node, "loss_good", config.loss_good);
+    config.loss_bad = getFloat(node, "loss_bad", config.loss_bad);
+  }
 }
 
+constexpr size_t ConfigLoader::EXPAND_NODES_PER_THREAD;
+
 boost::optional<ScenarioConfig> ConfigLoader::loadFromFile(const std::string& filepath) {
   try {
     std::ifstream file(filepath);
@@ -120,11 +175,30 @@ boost::optional<ScenarioConfig> ConfigLoader::loadFromString(const std::string&
       }
     }
     
+    // Parse churn section
+    if (hasKey(root, "churn") && root["churn"].IsSequence()) {
+      for (const auto& churn_yaml : root["churn"]) {
+        config.churn.push_back(parseChurn(churn_yaml));
+      }
+    }
+    
+    // Parse traffic section
+    if (hasKey(root, "traffic") && root["traffic"].IsSequence()) {
+      for (const auto& traffic_yaml : root["traffic"]) {
+        config.traffic.push_back(parseTraffic(traffic_yaml));
+      }
+    }
+    
     // Parse metrics section
     if (hasKey(root, "metrics")) {
       config.metrics = parseMetrics(root["metrics"]);
     }
     
+    // Parse gateway section
+    if (hasKey(root, "gateway")) {
+      config.gateway = parseGateway(root["gateway"]);
+    }
+    
     // Note: Template expansion is done later by caller to allow inspection
     // Call expandTemplates(config) after loading if needed
     
@@ -144,8 +218,33 @@ SimulationConfig ConfigLoader::parseSimulation(const YAML::Node& node) {
   config.name = getString(node, "name", "");  // No default - required field
   config.description = getString(node, "description");
   config.duration = getUInt32(node, "duration", 0);
-  config.time_scale = getFloat(node, "time_scale", 1.0f);
+  
+  // "unbounded" runs the virtual clock as fast as possible
+  std::string time_scale_str = getString(node, "time_scale", "1.0");
+  std::transform(time_scale_str.begin(), time_scale_str.end(), 
+                 time_scale_str.begin(), ::tolower);
+  if (time_scale_str == "unbounded" || time_scale_str == "max") {
+    config.time_scale = 0.0f;
+  } else {
+    config.time_scale = getFloat(node, "time_scale", 1.0f);
+  }
+  
   config.seed = getUInt32(node, "seed", 0);
+  config.threads = getUInt32(node, "threads", 1);
+  config.sync = getString(node, "sync", "tick");
+  std::transform(config.sync.begin(), config.sync.end(), config.sync.begin(), ::tolower);
+  config.partition = getString(node, "partition", "block");
+  std::transform(config.partition.begin(), config.partition.end(), config.partition.begin(),
+                 ::tolower);
+  config.lazy_nodes = getBool(node, "lazy_nodes", false);
+  config.node_engine = getString(node, "node_engine", "mesh");
+  std::transform(config.node_engine.begin(), config.node_engine.end(),
+                 config.node_engine.begin(), ::tolower);
+  config.firmware_clock = getString(node, "firmware_clock", "wall");
+  std::transform(config.firmware_clock.begin(), config.firmware_clock.end(),
+                 config.firmware_clock.begin(), ::tolower);
+  config.max_tick_ms = getUInt32(node, "max_tick_ms", MIN_TICK_MS);
+  config.max_nodes = getUInt32(node, "max_nodes", 1000);
   
   return config;
 }
@@ -153,6 +252,22 @@ SimulationConfig ConfigLoader::parseSimulation(const YAML::Node& node) {
 NetworkConfig ConfigLoader::parseNetwork(const YAML::Node& node) {
   NetworkConfig config;
   
+  // Parse transport
+  config.transport = getString(node, "transport", "tcp");
+  std::transform(config.transport.begin(), config.transport.end(),
+                 config.transport.begin(), ::tolower);
+  
+  // Parse delivery queue backend
+  config.delivery_queue = getString(node, "delivery_queue", "heap");
+  std::transform(config.delivery_queue.begin(), config.delivery_queue.end(),
+                 config.delivery_queue.begin(), ::tolower);
+  
+  // Parse per-link coalescing
+  config.coalesce = getBool(node, "coalesce", false);
+  
+  // Parse link trace file
+  config.trace = getString(node, "trace");
+  
   // Parse latency
   if (hasKey(node, "latency")) {
     const auto& latency_node = node["latency"];
@@ -217,6 +332,7 @@ NetworkConfig ConfigLoader::parseNetwork(const YAML::Node& node) {
         config.default_packet_loss.probability = getFloat(default_node, "probability", 0.0f);
         config.default_packet_loss.burst_mode = getBool(default_node, "burst_mode", false);
         config.default_packet_loss.burst_length = getUInt32(default_node, "burst_length", 3);
+        getGilbertElliott(default_node, config.default_packet_loss);
       }
       
       // Parse specific connections
@@ -224,6 +340,7 @@ NetworkConfig ConfigLoader::parseNetwork(const YAML::Node& node) {
           packet_loss_node["specific_connections"].IsSequence()) {
         for (const auto& conn_node : packet_loss_node["specific_connections"]) {
           ConnectionPacketLossConfig conn_config;
+          conn_config.config = config.default_packet_loss;
           conn_config.from = getString(conn_node, "from");
           conn_config.to = getString(conn_node, "to");
           conn_config.config.probability = getFloat(conn_node, "probability", 
@@ -232,6 +349,7 @@ NetworkConfig ConfigLoader::parseNetwork(const YAML::Node& node) {
                                                   config.default_packet_loss.burst_mode);
           conn_config.config.burst_length = getUInt32(conn_node, "burst_length", 
                                                       config.default_packet_loss.burst_length);
+          getGilbertElliott(conn_node, conn_config.config);
           
           config.specific_packet_losses.push_back(conn_config);
         }
@@ -289,6 +407,19 @@ NetworkConfig ConfigLoader::parseNetwork(const YAML::Node& node) {
     config.bandwidth = getUInt64(node, "bandwidth", 1000000);
   }
   
+  // Parse shared-medium contention
+  if (hasKey(node, "airtime")) {
+    const auto& airtime_node = node["airtime"];
+    const AirtimeConfig defaults;
+    config.airtime.bitrate_bps = getUInt32(airtime_node, "bitrate_bps", defaults.bitrate_bps);
+    config.airtime.frame_overhead_us = getUInt32(airtime_node, "frame_overhead_us",
+                                                 defaults.frame_overhead_us);
+    config.airtime.slot_us = getUInt32(airtime_node, "slot_us", defaults.slot_us);
+    config.airtime.contention_window = getUInt32(airtime_node, "contention_window",
+                                                 defaults.contention_window);
+    config.airtime.max_wait_ms = getUInt32(airtime_node, "max_wait_ms", defaults.max_wait_ms);
+  }
+  
   return config;
 }
 
@@ -306,6 +437,8 @@ NodeConfigExtended ConfigLoader::parseNode(const YAML::Node& node) {
     }
   }
   
+  parseClock(node, config);
+  
   // Parse config section
   if (hasKey(node, "config")) {
     const auto& cfg = node["config"];
@@ -314,14 +447,7 @@ NodeConfigExtended ConfigLoader::parseNode(const YAML::Node& node) {
     config.mesh_port = getUInt16(cfg, "mesh_port", 5555);
     
     // Parse firmware-specific config (all non-mesh fields go to firmwareConfig)
-    for (const auto& kv : cfg) {
-      std::string key = kv.first.as<std::string>();
-      // Skip mesh-specific fields
-      if (key != "mesh_prefix" && key != "mesh_password" && key != "mesh_port") {
-        std::string value = kv.second.as<std::string>();
-        config.firmwareConfig[key] = value;
-      }
-    }
+    config.firmwareConfig = getFirmwareConfig(cfg);
     
     // Extended configuration (legacy support)
     if (hasKey(cfg, "sensor_interval")) {
@@ -350,6 +476,7 @@ NodeTemplate ConfigLoader::parseTemplate(const YAML::Node& node) {
   // Parse base configuration
   tmpl.base_config.firmware = getString(node, "firmware");
   tmpl.base_config.type = tmpl.template_name;
+  parseClock(node, tmpl.base_config);
   
   if (hasKey(node, "config")) {
     const auto& cfg = node["config"];
@@ -358,14 +485,7 @@ NodeTemplate ConfigLoader::parseTemplate(const YAML::Node& node) {
     tmpl.base_config.mesh_port = getUInt16(cfg, "mesh_port", 5555);
     
     // Parse firmware-specific config (all non-mesh fields go to firmwareConfig)
-    for (const auto& kv : cfg) {
-      std::string key = kv.first.as<std::string>();
-      // Skip mesh-specific fields
-      if (key != "mesh_prefix" && key != "mesh_password" && key != "mesh_port") {
-        std::string value = kv.second.as<std::string>();
-        tmpl.base_config.firmwareConfig[key] = value;
-      }
-    }
+    tmpl.base_config.firmwareConfig = getFirmwareConfig(cfg);
     
     if (hasKey(cfg, "sensor_interval")) {
       tmpl.base_config.sensor_interval = cfg["sensor_interval"].as<uint32_t>();
@@ -408,12 +528,30 @@ TopologyConfig ConfigLoader::parseTopology(const YAML::Node& node) {
     }
   }
   
+  // Parse radio propagation parameters
+  if (hasKey(node, "radio")) {
+    const auto& radio = node["radio"];
+    RadioConfig& r = config.radio;
+    r.tx_power_dbm = getDouble(radio, "tx_power_dbm", r.tx_power_dbm);
+    r.reference_loss_db = getDouble(radio, "reference_loss_db", r.reference_loss_db);
+    r.path_loss_exponent = getDouble(radio, "path_loss_exponent", r.path_loss_exponent);
+    r.sensitivity_dbm = getDouble(radio, "sensitivity_dbm", r.sensitivity_dbm);
+    r.fade_margin_db = getDouble(radio, "fade_margin_db", r.fade_margin_db);
+    r.edge_loss = getFloat(radio, "edge_loss", r.edge_loss);
+    r.base_latency_ms = getUInt32(radio, "base_latency_ms", r.base_latency_ms);
+    r.edge_jitter_ms = getUInt32(radio, "edge_jitter_ms", r.edge_jitter_ms);
+  }
+  
   return config;
 }
 
 EventConfig ConfigLoader::parseEvent(const YAML::Node& node) {
   EventConfig config;
   config.time = getUInt32(node, "time", 0);
+  if (hasKey(node, "time_ms")) {
+    config.time_ms = getUInt64(node, "time_ms", 0);
+    config.time = static_cast<uint32_t>(config.time_ms / 1000);
+  }
   
   std::string action_str = getString(node, "action");
   config.action = stringToEventAction(action_str);
@@ -461,6 +599,64 @@ EventConfig ConfigLoader::parseEvent(const YAML::Node& node) {
   return config;
 }
 
+ChurnConfig ConfigLoader::parseChurn(const YAML::Node& node) {
+  ChurnConfig config;
+  config.type = getString(node, "type", "node");
+  config.start = getUInt32(node, "start", 0);
+  
+  if (hasKey(node, "targets") && node["targets"].IsSequence()) {
+    for (const auto& target : node["targets"]) {
+      config.targets.push_back(target.as<std::string>());
+    }
+  }
+  
+  // Links are [from, to] pairs
+  if (hasKey(node, "links") && node["links"].IsSequence()) {
+    for (const auto& link : node["links"]) {
+      if (link.IsSequence() && link.size() == 2) {
+        config.links.emplace_back(link[0].as<std::string>(), link[1].as<std::string>());
+      }
+    }
+  }
+  
+  if (hasKey(node, "failure")) {
+    config.failure = parseDuration(node["failure"]);
+  }
+  if (hasKey(node, "repair")) {
+    config.repair = parseDuration(node["repair"]);
+  }
+  
+  return config;
+}
+
+DurationConfig ConfigLoader::parseDuration(const YAML::Node& node) {
+  DurationConfig config;
+  config.distribution = getString(node, "distribution", "exponential");
+  config.mean = getDouble(node, "mean", 0.0);
+  config.shape = getDouble(node, "shape", 1.0);
+  return config;
+}
+
+TrafficConfig ConfigLoader::parseTraffic(const YAML::Node& node) {
+  TrafficConfig config;
+  config.pattern = getString(node, "pattern", "all_to_sink");
+  config.arrival = getString(node, "arrival", "constant");
+  config.sink = getString(node, "sink");
+  config.rate = getDouble(node, "rate", 1.0);
+  config.burst = getUInt32(node, "burst", 10);
+  config.size = getUInt32(node, "size", 64);
+  config.start = getUInt32(node, "start", 0);
+  config.stop = getUInt32(node, "stop", 0);
+  
+  if (hasKey(node, "sources") && node["sources"].IsSequence()) {
+    for (const auto& source : node["sources"]) {
+      config.sources.push_back(source.as<std::string>());
+    }
+  }
+  
+  return config;
+}
+
 MetricsConfig ConfigLoader::parseMetrics(const YAML::Node& node) {
   MetricsConfig config;
   config.output = getString(node, "output");
@@ -483,19 +679,97 @@ MetricsConfig ConfigLoader::parseMetrics(const YAML::Node& node) {
   return config;
 }
 
-void ConfigLoader::expandTemplates(ScenarioConfig& config) {
-  std::cout << "[DEBUG] Expanding templates. Initial node count: " << config.nodes.size() << std::endl;
+GatewayConfig ConfigLoader::parseGateway(const YAML::Node& node) {
+  GatewayConfig config;
+  config.listen = getString(node, "listen");
+  config.backend = getString(node, "backend");
+  config.max_datagram = getUInt32(node, "max_datagram", 1400);
+  config.broadcasts = getBool(node, "broadcasts", false);
+  
+  if (hasKey(node, "nodes") && node["nodes"].IsSequence()) {
+    for (const auto& id : node["nodes"]) {
+      config.nodes.push_back(id.as<std::string>());
+    }
+  }
+  
+  return config;
+}
+
+size_t ConfigLoader::expandTemplates(ScenarioConfig& config) {
+  // Index in config.nodes of each template's first node
+  const size_t first = config.nodes.size();
+  std::vector<size_t> starts;
+  starts.reserve(config.templates.size());
+  size_t total = first;
   for (const auto& tmpl : config.templates) {
-    std::cout << "[DEBUG] Expanding template '" << tmpl.template_name << "' with count=" << tmpl.count << ", prefix='" << tmpl.id_prefix << "'" << std::endl;
-    for (uint32_t i = 0; i < tmpl.count; ++i) {
-      NodeConfigExtended node = tmpl.base_config;
-      node.id = tmpl.id_prefix + std::to_string(i);
+    starts.push_back(total);
+    total += tmpl.count;
+  }
+  config.nodes.resize(total);
+  
+  // Each range starts in the last template beginning at or before it;
+  // templates with no nodes share their start with the next one
+  auto expandRange = [&](size_t begin, size_t end) {
+    if (begin == end) {
+      return;
+    }
+    size_t t = static_cast<size_t>(std::upper_bound(starts.begin(), starts.end(), begin) -
+                                   starts.begin()) - 1;
+    for (size_t i = begin; i < end; ++i) {
+      while (i >= starts[t] + config.templates[t].count) {
+        ++t;
+      }
+      const NodeTemplate& tmpl = config.templates[t];
+      NodeConfigExtended& node = config.nodes[i];
+      node = tmpl.base_config;  // Shares the firmware configuration
+      node.id = tmpl.id_prefix + std::to_string(i - starts[t]);
       node.nodeId = generateNodeId(node.id);
-      std::cout << "[DEBUG] Created node: id='" << node.id << "', nodeId=" << node.nodeId << std::endl;
-      config.nodes.push_back(node);
+    }
+  };
+  
+  const size_t generated = total - first;
+  const size_t threads = std::max<size_t>(1, std::min<size_t>(config.simulation.threads,
+                                                              generated / EXPAND_NODES_PER_THREAD));
+  if (threads == 1) {
+    expandRange(first, total);
+  } else {
+    WorkerPool pool(threads);
+    pool.run([&](size_t index) {
+      expandRange(first + generated * index / threads,
+                  first + generated * (index + 1) / threads);
+    });
+  }
+  
+  // Generated IDs that collide with an earlier node are rehashed in node
+  // order, so the result does not depend on the thread count. Collisions
+  // among defined nodes are left for validation to report.
+  std::unordered_set<uint32_t> taken;
+  taken.reserve(total);
+  for (size_t i = 0; i < first; ++i) {
+    taken.insert(config.nodes[i].nodeId);
+  }
+  for (size_t i = first; i < total; ++i) {
+    NodeConfigExtended& node = config.nodes[i];
+    for (uint32_t attempt = 1; !taken.insert(node.nodeId).second; ++attempt) {
+      node.nodeId = generateNodeId(node.id, attempt);
     }
   }
-  std::cout << "[DEBUG] Template expansion complete. Final node count: " << config.nodes.size() << std::endl;
+  
+  if (log_) {
+    std::ostringstream record;
+    for (size_t t = 0; t < config.templates.size(); ++t) {
+      const NodeTemplate& tmpl = config.templates[t];
+      record << "[DEBUG] Template '" << tmpl.template_name << "': " << tmpl.count
+             << " nodes with prefix '" << tmpl.id_prefix << "'\n";
+      for (size_t i = starts[t]; i < starts[t] + tmpl.count; ++i) {
+        record << "[DEBUG]   " << config.nodes[i].id << " -> " << config.nodes[i].nodeId << '\n';
+      }
+    }
+    record << "[DEBUG] Template expansion complete: " << generated << " nodes generated, "
+           << config.nodes.size() << " in total\n";
+    *log_ << record.str() << std::flush;
+  }
+  return generated;
 }
 
 bool ConfigLoader::validate(const ScenarioConfig& config) {
@@ -528,17 +802,39 @@ std::vector<ValidationError> ConfigLoader::getValidationErrors(const ScenarioCon
     validateNode(node, errors);
   }
   
-  // Check for duplicate node IDs
-  std::vector<std::string> node_ids;
+  // Check for duplicate node IDs, and distinct IDs hashing to the same
+  // numeric ID (likely once templates generate thousands of nodes)
+  std::unordered_set<std::string> node_ids;
+  std::unordered_map<uint32_t, const std::string*> numeric_ids;
+  node_ids.reserve(config.nodes.size());
+  numeric_ids.reserve(config.nodes.size());
   for (const auto& node : config.nodes) {
-    if (std::find(node_ids.begin(), node_ids.end(), node.id) != node_ids.end()) {
+    if (!node_ids.insert(node.id).second) {
       ValidationError err;
       err.field = "nodes";
       err.message = "Duplicate node ID: " + node.id;
       err.suggestion = "Ensure all node IDs are unique";
       errors.push_back(err);
+      continue;
+    }
+    auto numeric = numeric_ids.emplace(node.nodeId, &node.id);
+    if (!numeric.second) {
+      ValidationError err;
+      err.field = "nodes";
+      err.message = "Node IDs " + *numeric.first->second + " and " + node.id +
+                    " map to the same numeric ID " + std::to_string(node.nodeId);
+      err.suggestion = "Rename one of the nodes (or change the template id_prefix)";
+      errors.push_back(err);
     }
-    node_ids.push_back(node.id);
+  }
+  
+  if (config.simulation.max_nodes > 0 && config.nodes.size() > config.simulation.max_nodes) {
+    ValidationError err;
+    err.field = "simulation.max_nodes";
+    err.message = "Scenario defines " + std::to_string(config.nodes.size()) +
+                  " nodes but max_nodes is " + std::to_string(config.simulation.max_nodes);
+    err.suggestion = "Raise simulation.max_nodes (or pass --max-nodes)";
+    errors.push_back(err);
   }
   
   // Check for at least one node
@@ -551,12 +847,58 @@ std::vector<ValidationError> ConfigLoader::getValidationErrors(const ScenarioCon
   }
   
   validateTopology(config.topology, config.nodes, errors);
+  if (config.topology.type == TopologyType::RADIO && config.network.transport != "in_process") {
+    ValidationError err;
+    err.field = "topology.type";
+    err.message = "Radio topology needs the in-process transport";
+    err.suggestion = "Set network.transport: in_process";
+    errors.push_back(err);
+  }
+  
+  if (config.network.airtime.isEnabled() && config.network.transport != "in_process") {
+    ValidationError err;
+    err.field = "network.airtime.bitrate_bps";
+    err.message = "Airtime contention needs the in-process transport";
+    err.suggestion = "Set network.transport: in_process, or bitrate_bps: 0";
+    errors.push_back(err);
+  }
+  
+  if (config.simulation.node_engine == "fluid" && config.network.transport != "in_process") {
+    ValidationError err;
+    err.field = "simulation.node_engine";
+    err.message = "Fluid nodes need the in-process transport";
+    err.suggestion = "Set network.transport: in_process, or node_engine: mesh";
+    errors.push_back(err);
+  }
+  
+  if (config.simulation.max_tick_ms > MIN_TICK_MS && config.network.transport != "in_process") {
+    ValidationError err;
+    err.field = "simulation.max_tick_ms";
+    err.message = "Adaptive ticks need the in-process transport";
+    err.suggestion = "Set network.transport: in_process, or max_tick_ms: 10";
+    errors.push_back(err);
+  }
   
   // Validate events
   for (const auto& event : config.events) {
     validateEvent(event, config.simulation.duration, config.nodes, errors);
   }
   
+  // Validate churn sources
+  for (const auto& churn : config.churn) {
+    validateChurn(churn, config.nodes, errors);
+  }
+  
+  if (!config.traffic.empty()) {
+    validateTraffic(config, errors);
+  }
+  
+  validateMetrics(config.metrics, errors);
+  
+  if (config.gateway.isEnabled()) {
+    validateGateway(config, errors);
+  }
+  
   return errors;
 }
 
@@ -570,17 +912,108 @@ void ConfigLoader::validateSimulation(const SimulationConfig& config,
     errors.push_back(err);
   }
   
-  if (config.time_scale <= 0.0f) {
+  if (config.time_scale < 0.0f) {
     ValidationError err;
     err.field = "simulation.time_scale";
-    err.message = "Time scale must be positive";
-    err.suggestion = "Use 1.0 for real-time, >1.0 for faster simulation";
+    err.message = "Time scale cannot be negative";
+    err.suggestion = "Use 1.0 for real-time, >1.0 for faster simulation, or 'unbounded'";
+    errors.push_back(err);
+  }
+  
+  if (config.threads == 0 || config.threads > 256) {
+    ValidationError err;
+    err.field = "simulation.threads";
+    err.message = "Thread count must be between 1 and 256";
+    err.suggestion = "Use 1 for single-threaded updates or the number of available cores";
+    errors.push_back(err);
+  }
+  
+  if (config.max_nodes == 0) {
+    ValidationError err;
+    err.field = "simulation.max_nodes";
+    err.message = "Maximum node count must be non-zero";
+    err.suggestion = "Use at least the number of nodes in the scenario";
+    errors.push_back(err);
+  }
+  
+  if (config.sync != "tick" && config.sync != "lookahead") {
+    ValidationError err;
+    err.field = "simulation.sync";
+    err.message = "Unknown synchronization mode: " + config.sync;
+    err.suggestion = "Use 'tick' or 'lookahead'";
+    errors.push_back(err);
+  }
+  
+  if (config.partition != "block" && config.partition != "locality") {
+    ValidationError err;
+    err.field = "simulation.partition";
+    err.message = "Unknown partition strategy: " + config.partition;
+    err.suggestion = "Use 'block' or 'locality'";
+    errors.push_back(err);
+  }
+  
+  if (config.node_engine != "mesh" && config.node_engine != "fluid") {
+    ValidationError err;
+    err.field = "simulation.node_engine";
+    err.message = "Unknown node engine: " + config.node_engine;
+    err.suggestion = "Use 'mesh' or 'fluid'";
+    errors.push_back(err);
+  }
+  
+  if (config.firmware_clock != "wall" && config.firmware_clock != "virtual") {
+    ValidationError err;
+    err.field = "simulation.firmware_clock";
+    err.message = "Unknown firmware clock: " + config.firmware_clock;
+    err.suggestion = "Use 'wall' or 'virtual'";
+    errors.push_back(err);
+  }
+  
+  if (config.max_tick_ms < MIN_TICK_MS || config.max_tick_ms > MAX_TICK_MS) {
+    ValidationError err;
+    err.field = "simulation.max_tick_ms";
+    err.message = "Maximum tick must be between " + std::to_string(MIN_TICK_MS) + " and " +
+                  std::to_string(MAX_TICK_MS) + " ms";
+    err.suggestion = "Use 10 for fixed ticks or e.g. 1000 to skip idle time";
+    errors.push_back(err);
+  } else if (config.max_tick_ms > MIN_TICK_MS && config.firmware_clock != "virtual") {
+    // Sleeping nodes wake on the firmware clock, which must follow the jumps
+    ValidationError err;
+    err.field = "simulation.max_tick_ms";
+    err.message = "Adaptive ticks need the virtual firmware clock";
+    err.suggestion = "Set simulation.firmware_clock: virtual";
     errors.push_back(err);
   }
 }
 
 void ConfigLoader::validateNetwork(const NetworkConfig& config,
                                    std::vector<ValidationError>& errors) {
+  // Validate transport
+  if (config.transport != "tcp" && config.transport != "in_process") {
+    ValidationError err;
+    err.field = "network.transport";
+    err.message = "Unknown transport: " + config.transport;
+    err.suggestion = "Use 'tcp' or 'in_process'";
+    errors.push_back(err);
+  }
+  
+  // Validate delivery queue backend
+  if (config.delivery_queue != "heap" && config.delivery_queue != "timing_wheel") {
+    ValidationError err;
+    err.field = "network.delivery_queue";
+    err.message = "Unknown delivery queue: " + config.delivery_queue;
+    err.suggestion = "Use 'heap' or 'timing_wheel'";
+    errors.push_back(err);
+  }
+  
+  // Validate shared medium
+  if (!config.airtime.isValid()) {
+    ValidationError err;
+    err.field = "network.airtime.contention_window";
+    err.message = "Contention window must be at least 1 slot";
+    err.suggestion = "Use 16 for 802.11 best-effort traffic";
+    errors.push_back(err);
+  }
+  
   // Validate default latency
   if (!config.default_latency.isValid()) {
     ValidationError err;
@@ -625,7 +1058,7 @@ void ConfigLoader::validateNetwork(const NetworkConfig& config,
     ValidationError err;
     err.field = "network.packet_loss.default";
     err.message = "Invalid packet loss configuration";
-    err.suggestion = "Probability must be 0.0-1.0, burst_length must be > 0";
+    err.suggestion = "Probabilities must be 0.0-1.0, burst_length must be > 0";
     errors.push_back(err);
   }
   
@@ -654,7 +1087,7 @@ void ConfigLoader::validateNetwork(const NetworkConfig& config,
       err.field = "network.packet_loss.specific_connections[" + std::to_string(i) + "]";
       err.message = "Invalid packet loss configuration for connection " + 
                     conn.from + " -> " + conn.to;
-      err.suggestion = "Probability must be 0.0-1.0, burst_length must be > 0";
+      err.suggestion = "Probabilities must be 0.0-1.0, burst_length must be > 0";
       errors.push_back(err);
     }
   }
@@ -710,6 +1143,14 @@ void ConfigLoader::validateNode(const NodeConfigExtended& config,
     err.suggestion = "Use default port 5555 or specify a valid port";
     errors.push_back(err);
   }
+  
+  if (!(std::abs(config.clock_drift_ppm) <= MAX_CLOCK_DRIFT_PPM)) {
+    ValidationError err;
+    err.field = "node.clock.drift_ppm";
+    err.message = "Clock drift out of range for node: " + config.id;
+    err.suggestion = "Use a drift between -100000 and 100000 ppm (crystals are within +-100)";
+    errors.push_back(err);
+  }
 }
 
 void ConfigLoader::validateTopology(const TopologyConfig& config,
@@ -750,6 +1191,27 @@ void ConfigLoader::validateTopology(const TopologyConfig& config,
     }
   }
   
+  // Radio topology places nodes by position
+  if (config.type == TopologyType::RADIO) {
+    if (!config.radio.isValid()) {
+      ValidationError err;
+      err.field = "topology.radio";
+      err.message = "Invalid radio configuration";
+      err.suggestion = "Need path_loss_exponent > 0, fade_margin_db > 0, edge_loss 0.0-1.0 "
+                       "and tx_power_dbm - reference_loss_db above sensitivity_dbm";
+      errors.push_back(err);
+    }
+    for (const auto& node : all_nodes) {
+      if (node.position.size() != 2) {
+        ValidationError err;
+        err.field = "nodes." + node.id + ".position";
+        err.message = "Radio topology needs a position for every node";
+        err.suggestion = "Set position: [x, y] in meters";
+        errors.push_back(err);
+      }
+    }
+  }
+  
   // Validate custom connections
   if (config.type == TopologyType::CUSTOM) {
     if (config.connections.empty()) {
@@ -792,11 +1254,13 @@ void ConfigLoader::validateEvent(const EventConfig& config,
                                  const std::vector<NodeConfigExtended>& all_nodes,
                                  std::vector<ValidationError>& errors) {
   // Check event time is within simulation duration
-  if (simulation_duration > 0 && config.time > simulation_duration) {
+  const uint64_t time_ms = config.time_ms != 0 ? config.time_ms
+                                               : static_cast<uint64_t>(config.time) * 1000;
+  if (simulation_duration > 0 && time_ms > static_cast<uint64_t>(simulation_duration) * 1000) {
     ValidationError err;
     err.field = "event.time";
-    err.message = "Event time " + std::to_string(config.time) + 
-                  "s exceeds simulation duration " + std::to_string(simulation_duration) + "s";
+    err.message = "Event time " + std::to_string(time_ms) + 
+                  "ms exceeds simulation duration " + std::to_string(simulation_duration) + "s";
     err.suggestion = "Ensure all event times are within simulation duration";
     errors.push_back(err);
   }
@@ -831,6 +1295,236 @@ void ConfigLoader::validateEvent(const EventConfig& config,
   }
 }
 
+void ConfigLoader::validateChurn(const ChurnConfig& config,
+                                 const std::vector<NodeConfigExtended>& all_nodes,
+                                 std::vector<ValidationError>& errors) {
+  if (config.type != "node" && config.type != "link") {
+    ValidationError err;
+    err.field = "churn.type";
+    err.message = "Unknown churn type: " + config.type;
+    err.suggestion = "Use 'node' (crash/restart) or 'link' (drop/restore)";
+    errors.push_back(err);
+  }
+  
+  if (config.type == "link" && config.links.empty()) {
+    ValidationError err;
+    err.field = "churn.links";
+    err.message = "Link churn needs at least one [from, to] link";
+    err.suggestion = "List the flapping links, e.g. links: [[\"hub-1\", \"sensor-1\"]]";
+    errors.push_back(err);
+  }
+  
+  auto validateDuration = [&errors](const DurationConfig& duration, const std::string& field) {
+    if (duration.distribution != "exponential" && duration.distribution != "weibull" &&
+        duration.distribution != "fixed") {
+      ValidationError err;
+      err.field = field + ".distribution";
+      err.message = "Unknown duration distribution: " + duration.distribution;
+      err.suggestion = "Use exponential, weibull or fixed";
+      errors.push_back(err);
+    }
+    if (!(duration.mean > 0.0)) {
+      ValidationError err;
+      err.field = field + ".mean";
+      err.message = "Mean duration must be greater than 0 seconds";
+      err.suggestion = "Set the mean time in seconds (MTBF for failure, MTTR for repair)";
+      errors.push_back(err);
+    }
+    if (duration.distribution == "weibull" && !(duration.shape > 0.0)) {
+      ValidationError err;
+      err.field = field + ".shape";
+      err.message = "Weibull shape must be greater than 0";
+      err.suggestion = "Use shape < 1 for infant mortality, > 1 for wear-out";
+      errors.push_back(err);
+    }
+  };
+  validateDuration(config.failure, "churn.failure");
+  validateDuration(config.repair, "churn.repair");
+  
+  // Referenced nodes must exist
+  auto exists = [&all_nodes](const std::string& id) {
+    for (const auto& node : all_nodes) {
+      if (node.id == id) {
+        return true;
+      }
+    }
+    return false;
+  };
+  std::vector<std::string> referenced = config.targets;
+  for (const auto& link : config.links) {
+    referenced.push_back(link.first);
+    referenced.push_back(link.second);
+  }
+  for (const auto& id : referenced) {
+    if (!exists(id)) {
+      ValidationError err;
+      err.field = "churn.targets";
+      err.message = "Churn references non-existent node: " + id;
+      err.suggestion = "Ensure every churn target and link endpoint exists";
+      errors.push_back(err);
+    }
+  }
+}
+
+void ConfigLoader::validateTraffic(const ScenarioConfig& config,
+                                   std::vector<ValidationError>& errors) {
+  if (config.network.transport != "in_process") {
+    ValidationError err;
+    err.field = "traffic";
+    err.message = "Synthetic traffic needs the in-process transport";
+    err.suggestion = "Set network.transport: in_process";
+    errors.push_back(err);
+  }
+  
+  auto exists = [&config](const std::string& id) {
+    return std::any_of(config.nodes.begin(), config.nodes.end(),
+                       [&id](const NodeConfigExtended& node) { return node.id == id; });
+  };
+  
+  for (const auto& traffic : config.traffic) {
+    if (traffic.pattern != "all_to_sink" && traffic.pattern != "all_to_all") {
+      ValidationError err;
+      err.field = "traffic.pattern";
+      err.message = "Unknown traffic pattern: " + traffic.pattern;
+      err.suggestion = "Use all_to_sink or all_to_all";
+      errors.push_back(err);
+    }
+    if (traffic.arrival != "constant" && traffic.arrival != "poisson" &&
+        traffic.arrival != "bursty") {
+      ValidationError err;
+      err.field = "traffic.arrival";
+      err.message = "Unknown traffic arrival process: " + traffic.arrival;
+      err.suggestion = "Use constant, poisson or bursty";
+      errors.push_back(err);
+    }
+    if (!(traffic.rate > 0.0) || !std::isfinite(traffic.rate)) {
+      ValidationError err;
+      err.field = "traffic.rate";
+      err.message = "Traffic rate must be greater than 0 messages per second";
+      err.suggestion = "Set the mean messages per second of each source";
+      errors.push_back(err);
+    }
+    if (traffic.burst == 0) {
+      ValidationError err;
+      err.field = "traffic.burst";
+      err.message = "Traffic bursts need at least one message";
+      err.suggestion = "Use burst: 10";
+      errors.push_back(err);
+    }
+    if (traffic.size < TrafficGenerator::HEADER_SIZE) {
+      ValidationError err;
+      err.field = "traffic.size";
+      err.message = "Traffic messages need at least " +
+                    std::to_string(TrafficGenerator::HEADER_SIZE) + " bytes";
+      err.suggestion = "Use the message size of the firmware being modelled, e.g. 64";
+      errors.push_back(err);
+    }
+    if (traffic.stop != 0 && traffic.stop <= traffic.start) {
+      ValidationError err;
+      err.field = "traffic.stop";
+      err.message = "Traffic stops before it starts";
+      err.suggestion = "Set stop after start, or 0 to run to the end";
+      errors.push_back(err);
+    }
+    if (traffic.pattern == "all_to_sink" && !exists(traffic.sink)) {
+      ValidationError err;
+      err.field = "traffic.sink";
+      err.message = traffic.sink.empty() ? "All-to-sink traffic needs a sink"
+                                         : "Traffic references non-existent node: " + traffic.sink;
+      err.suggestion = "Name the node that receives the traffic";
+      errors.push_back(err);
+    }
+    for (const auto& id : traffic.sources) {
+      if (!exists(id)) {
+        ValidationError err;
+        err.field = "traffic.sources";
+        err.message = "Traffic references non-existent node: " + id;
+        err.suggestion = "Ensure every traffic source exists";
+        errors.push_back(err);
+      }
+    }
+  }
+}
+
+void ConfigLoader::validateMetrics(const MetricsConfig& config,
+                                   std::vector<ValidationError>& errors) {
+  if (config.interval == 0) {
+    ValidationError err;
+    err.field = "metrics.interval";
+    err.message = "Metrics interval must be greater than 0";
+    err.suggestion = "Use the sampling period in seconds, e.g. 5";
+    errors.push_back(err);
+  }
+  
+  for (const auto& name : config.export_formats) {
+    if (!MetricsCollector::isKnownFormat(name)) {
+      ValidationError err;
+      err.field = "metrics.export";
+      err.message = "Unknown metrics export format: " + name;
+      err.suggestion = "Use csv, json or binary";
+      errors.push_back(err);
+    }
+  }
+}
+
+void ConfigLoader::validateGateway(const ScenarioConfig& config,
+                                   std::vector<ValidationError>& errors) {
+  const GatewayConfig& gateway = config.gateway;
+  if (config.network.transport != "in_process") {
+    ValidationError err;
+    err.field = "gateway";
+    err.message = "The gateway needs the in-process transport";
+    err.suggestion = "Set network.transport: in_process";
+    errors.push_back(err);
+  }
+  
+  const std::pair<const char*, const std::string*> endpoints[] = {
+    {"gateway.listen", &gateway.listen}, {"gateway.backend", &gateway.backend}};
+  for (const auto& endpoint : endpoints) {
+    try {
+      Gateway::parseEndpoint(*endpoint.second);
+    } catch (const std::invalid_argument& e) {
+      ValidationError err;
+      err.field = endpoint.first;
+      err.message = e.what();
+      err.suggestion = "Use a numeric address and port, e.g. 127.0.0.1:7000";
+      errors.push_back(err);
+    }
+  }
+  
+  if (gateway.max_datagram <= Gateway::RECORD_HEADER_SIZE ||
+      gateway.max_datagram > Gateway::MAX_DATAGRAM) {
+    ValidationError err;
+    err.field = "gateway.max_datagram";
+    err.message = "Datagram size must be between " +
+                  std::to_string(Gateway::RECORD_HEADER_SIZE + 1) + " and " +
+                  std::to_string(Gateway::MAX_DATAGRAM) + " bytes";
+    err.suggestion = "Use 1400 to stay under a typical MTU";
+    errors.push_back(err);
+  }
+  
+  for (const auto& id : gateway.nodes) {
+    const bool exists = std::any_of(config.nodes.begin(), config.nodes.end(),
+                                    [&id](const NodeConfigExtended& node) { return node.id == id; });
+    if (!exists) {
+      ValidationError err;
+      err.field = "gateway.nodes";
+      err.message = "Gateway references non-existent node: " + id;
+      err.suggestion = "Ensure every exposed node exists";
+      errors.push_back(err);
+    }
+  }
+  const bool has_bridge = std::any_of(config.nodes.begin(), config.nodes.end(),
+                                     [](const NodeConfigExtended& node) { return node.type == "bridge"; });
+  if (gateway.nodes.empty() && !has_bridge) {
+    ValidationError err;
+    err.field = "gateway.nodes";
+    err.message = "The gateway has no node to expose";
+    err.suggestion = "List the exposed nodes, or give some nodes type: bridge";
+    errors.push_back(err);
+  }
+}
+
 TopologyType ConfigLoader::stringToTopologyType(const std::string& type_str) {
   std::string lower = type_str;
   std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
@@ -840,6 +1534,7 @@ TopologyType ConfigLoader::stringToTopologyType(const std::string& type_str) {
   if (lower == "ring") return TopologyType::RING;
   if (lower == "mesh") return TopologyType::MESH;
   if (lower == "custom") return TopologyType::CUSTOM;
+  if (lower == "radio") return TopologyType::RADIO;
   
   return TopologyType::RANDOM; // Default
 }
@@ -868,14 +1563,20 @@ EventAction ConfigLoader::stringToEventAction(const std::string& action_str) {
   throw std::runtime_error("Unknown event action: " + action_str);
 }
 
-uint32_t ConfigLoader::generateNodeId(const std::string& id_str) {
-  // Simple hash function to generate numeric ID from string
-  // Using std::hash for consistency
-  std::hash<std::string> hasher;
-  size_t hash = hasher(id_str);
+uint32_t ConfigLoader::generateNodeId(const std::string& id_str, uint32_t attempt) {
+  // 32-bit FNV-1a: unlike std::hash, identical on every platform and
+  // standard library, so runs and result files stay comparable
+  uint32_t hash = 0x811c9dc5u;
+  for (unsigned char c : id_str) {
+    hash = (hash ^ c) * 0x01000193u;
+  }
+  // Rehashes continue the hash with the attempt number, byte by byte
+  for (int shift = 0; attempt != 0 && shift < 32; shift += 8) {
+    hash = (hash ^ ((attempt >> shift) & 0xFFu)) * 0x01000193u;
+  }
   
-  // Ensure non-zero and within uint32_t range
-  uint32_t node_id = static_cast<uint32_t>(hash & 0x7FFFFFFF);
+  // Ensure non-zero and within 31 bits
+  uint32_t node_id = hash & 0x7FFFFFFF;
   if (node_id == 0) {
     node_id = 1;
   }
@@ -0,0 +1,232 @@
+/**
+ * @file parameter_sweep.cpp
+ * @brief Implementation of SweepSpec class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/parameter_sweep.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <yaml-cpp/yaml.h>
+
+namespace simulator {
+
+constexpr const char* SweepSpec::DEFAULT_OUTPUT;
+constexpr size_t SweepSpec::MAX_POINTS;
+
+namespace {
+
+/**
+ * @brief Checks a value of a parameter
+ *
+ * @return Error message, empty if the value is valid
+ */
+std::string checkValue(const std::string& name, double value) {
+  if (name == "packet_loss") {
+    return value >= 0.0 && value <= 1.0 ? "" : "must be between 0.0 and 1.0";
+  }
+  if (name == "traffic_rate") {
+    return value > 0.0 && std::isfinite(value) ? "" : "must be greater than 0";
+  }
+  if (name != "nodes" && name != "seed" && name != "duration" &&
+      name != "latency_min" && name != "latency_max") {
+    return "is not a sweep parameter (nodes, seed, duration, packet_loss, "
+           "latency_min, latency_max, traffic_rate)";
+  }
+  if (!(value >= 0.0 && value <= UINT32_MAX) || std::floor(value) != value) {
+    return "must be a whole number from 0 to 4294967295";
+  }
+  if (name == "nodes" && value < 1) {
+    return "must be at least 1";
+  }
+  return "";
+}
+
+/**
+ * @brief Quotes a CSV field if it needs it
+ */
+std::string csvField(const std::string& field) {
+  if (field.find_first_of(",\"\n") == std::string::npos) {
+    return field;
+  }
+  std::string quoted = "\"";
+  for (char c : field) {
+    if (c == '"') {
+      quoted += '"';
+    }
+    quoted += c;
+  }
+  return quoted + "\"";
+}
+
+} // anonymous namespace
+
+SweepSpec SweepSpec::load(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("Cannot open sweep file: " + path);
+  }
+  std::stringstream text;
+  text << file.rdbuf();
+  return parse(text.str());
+}
+
+SweepSpec SweepSpec::parse(const std::string& yaml) {
+  YAML::Node root;
+  try {
+    root = YAML::Load(yaml);
+  } catch (const YAML::Exception& e) {
+    throw std::runtime_error(std::string("Invalid sweep file: ") + e.what());
+  }
+
+  SweepSpec spec;
+  const YAML::Node parameters = root["parameters"];
+  if (!parameters || !parameters.IsMap() || parameters.size() == 0) {
+    throw std::runtime_error("Sweep file needs a 'parameters' map with at least one parameter");
+  }
+
+  try {
+    for (const auto& entry : parameters) {
+      SweepAxis axis;
+      axis.name = entry.first.as<std::string>();
+      for (const auto& existing : spec.axes_) {
+        if (existing.name == axis.name) {
+          throw std::runtime_error("Sweep parameter '" + axis.name + "' is given twice");
+        }
+      }
+      if (entry.second.IsSequence()) {
+        for (const auto& value : entry.second) {
+          axis.values.push_back(value.as<double>());
+        }
+      } else {
+        axis.values.push_back(entry.second.as<double>());
+      }
+      if (axis.values.empty()) {
+        throw std::runtime_error("Sweep parameter '" + axis.name + "' has no values");
+      }
+      for (double value : axis.values) {
+        const std::string error = checkValue(axis.name, value);
+        if (!error.empty()) {
+          throw std::runtime_error("Sweep parameter '" + axis.name + "' " + error);
+        }
+      }
+      spec.axes_.push_back(std::move(axis));
+    }
+
+    if (root["jobs"]) {
+      spec.jobs_ = root["jobs"].as<uint32_t>();
+    }
+    if (root["output"]) {
+      spec.output_ = root["output"].as<std::string>();
+    }
+  } catch (const YAML::Exception& e) {
+    throw std::runtime_error(std::string("Invalid sweep file: ") + e.what());
+  }
+
+  size_t points = 1;
+  for (const auto& axis : spec.axes_) {
+    points *= axis.values.size();
+    if (points > MAX_POINTS) {
+      throw std::runtime_error("Sweep has more than " + std::to_string(MAX_POINTS) + " runs");
+    }
+  }
+  return spec;
+}
+
+size_t SweepSpec::getPointCount() const {
+  size_t points = axes_.empty() ? 0 : 1;
+  for (const auto& axis : axes_) {
+    points *= axis.values.size();
+  }
+  return points;
+}
+
+SweepPoint SweepSpec::getPoint(size_t index) const {
+  if (index >= getPointCount()) {
+    throw std::out_of_range("Sweep has no run " + std::to_string(index));
+  }
+
+  // Mixed-radix digits of the index, last axis fastest
+  SweepPoint point;
+  point.index = index;
+  point.values.resize(axes_.size());
+  for (size_t i = axes_.size(); i-- > 0;) {
+    const size_t count = axes_[i].values.size();
+    point.values[i] = axes_[i].values[index % count];
+    index /= count;
+  }
+  return point;
+}
+
+void SweepSpec::apply(const SweepPoint& point, ScenarioConfig& config) const {
+  for (size_t i = 0; i < axes_.size(); ++i) {
+    const std::string& name = axes_[i].name;
+    const double value = point.values.at(i);
+    const uint32_t whole = static_cast<uint32_t>(value);
+    if (name == "nodes") {
+      if (config.templates.size() != 1) {
+        throw std::invalid_argument("Sweeping nodes needs a scenario with exactly one node "
+                                    "template, found " + std::to_string(config.templates.size()));
+      }
+      config.templates[0].count = whole;
+    } else if (name == "seed") {
+      config.simulation.seed = whole;
+    } else if (name == "duration") {
+      config.simulation.duration = whole;
+    } else if (name == "packet_loss") {
+      config.network.default_packet_loss.probability = static_cast<float>(value);
+    } else if (name == "latency_min") {
+      config.network.default_latency.min_ms = whole;
+    } else if (name == "latency_max") {
+      config.network.default_latency.max_ms = whole;
+    } else if (name == "traffic_rate") {
+      if (config.traffic.empty()) {
+        throw std::invalid_argument("Sweeping traffic_rate needs a scenario with traffic");
+      }
+      for (auto& traffic : config.traffic) {
+        traffic.rate = value;
+      }
+    }
+  }
+}
+
+void SweepSpec::writeTable(const std::vector<SweepResult>& results, std::ostream& out) const {
+  out << "run";
+  for (const auto& axis : axes_) {
+    out << ',' << axis.name;
+  }
+  out << ",status,simulated_nodes,simulated_ms,wall_ms,updates,messages_sent,messages_received,"
+         "frames_dropped,link_delivered,link_lost,latency_p50_ms,latency_p95_ms,"
+         "latency_p99_ms,traffic_offered,traffic_expected,traffic_delivered\n";
+
+  for (const auto& result : results) {
+    out << result.point.index;
+    for (double value : result.point.values) {
+      out << ',' << value;
+    }
+    out << ',' << (result.ok() ? std::string("ok") : csvField("error: " + result.error))
+        << ',' << result.nodes
+        << ',' << result.simulated_ms
+        << ',' << result.wall_ms
+        << ',' << result.updates
+        << ',' << result.messages_sent
+        << ',' << result.messages_received
+        << ',' << result.frames_dropped
+        << ',' << result.link_delivered
+        << ',' << result.link_lost
+        << ',' << result.latency_p50_ms
+        << ',' << result.latency_p95_ms
+        << ',' << result.latency_p99_ms
+        << ',' << result.traffic_offered
+        << ',' << result.traffic_expected
+        << ',' << result.traffic_delivered << '\n';
+  }
+}
+
+} // namespace simulator
@@ -0,0 +1,680 @@
+/**
+ * @file scenario_cache.cpp
+ * @brief Implementation of compiled binary scenarios
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/scenario_cache.hpp"
+#include "simulator/mapped_file.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace simulator {
+
+namespace {
+
+constexpr char SCENARIO_MAGIC[8] = {'P', 'M', 'S', 'C', 'E', 'N', '0', '1'};
+constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+/**
+ * @brief Fixed header at the start of a compiled scenario
+ */
+struct ScenarioHeader {
+  char magic[8];          ///< SCENARIO_MAGIC
+  uint32_t version;       ///< ScenarioCache::VERSION
+  uint32_t reserved;      ///< Zero
+  uint64_t key;           ///< Content key
+  uint64_t payload_size;  ///< Bytes of configuration that follow
+};
+
+static_assert(sizeof(ScenarioHeader) == 32, "ScenarioHeader must match the file layout");
+
+// Shared firmware configurations are stored once; nodes refer to them by
+// index + 1 (0 = none)
+using FirmwareTable = std::unordered_map<const FirmwareConfigMap*, uint32_t>;
+
+/**
+ * @brief Reads an element count, rejecting counts the buffer cannot hold
+ */
+uint32_t readCount(CheckpointReader& in) {
+  const uint32_t count = in.read<uint32_t>();
+  if (count > in.remaining()) {
+    throw std::runtime_error("Compiled scenario is malformed");
+  }
+  return count;
+}
+
+template <typename T>
+T readEnum(CheckpointReader& in, T last) {
+  const uint32_t value = in.read<uint32_t>();
+  if (value > static_cast<uint32_t>(last)) {
+    throw std::runtime_error("Compiled scenario is malformed");
+  }
+  return static_cast<T>(value);
+}
+
+template <typename T>
+void writeEnum(CheckpointWriter& out, T value) {
+  out.write<uint32_t>(static_cast<uint32_t>(value));
+}
+
+void writeStrings(CheckpointWriter& out, const std::vector<std::string>& values) {
+  out.write<uint32_t>(static_cast<uint32_t>(values.size()));
+  for (const auto& value : values) {
+    out.writeString(value);
+  }
+}
+
+std::vector<std::string> readStrings(CheckpointReader& in) {
+  std::vector<std::string> values(readCount(in));
+  for (auto& value : values) {
+    value = in.readString();
+  }
+  return values;
+}
+
+void writePairs(CheckpointWriter& out,
+                const std::vector<std::pair<std::string, std::string>>& pairs) {
+  out.write<uint32_t>(static_cast<uint32_t>(pairs.size()));
+  for (const auto& pair : pairs) {
+    out.writeString(pair.first);
+    out.writeString(pair.second);
+  }
+}
+
+std::vector<std::pair<std::string, std::string>> readPairs(CheckpointReader& in) {
+  std::vector<std::pair<std::string, std::string>> pairs(readCount(in));
+  for (auto& pair : pairs) {
+    pair.first = in.readString();
+    pair.second = in.readString();
+  }
+  return pairs;
+}
+
+template <typename T>
+void writeOptional(CheckpointWriter& out, const boost::optional<T>& value) {
+  out.write<uint8_t>(value ? 1 : 0);
+  if (value) {
+    out.write(*value);
+  }
+}
+
+void writeOptional(CheckpointWriter& out, const boost::optional<std::string>& value) {
+  out.write<uint8_t>(value ? 1 : 0);
+  if (value) {
+    out.writeString(*value);
+  }
+}
+
+template <typename T>
+boost::optional<T> readOptional(CheckpointReader& in) {
+  if (in.read<uint8_t>() == 0) {
+    return boost::none;
+  }
+  return in.read<T>();
+}
+
+boost::optional<std::string> readOptionalString(CheckpointReader& in) {
+  if (in.read<uint8_t>() == 0) {
+    return boost::none;
+  }
+  return in.readString();
+}
+
+void writeLatency(CheckpointWriter& out, const LatencyConfig& config) {
+  out.write(config.min_ms);
+  out.write(config.max_ms);
+  writeEnum(out, config.distribution);
+}
+
+LatencyConfig readLatency(CheckpointReader& in) {
+  LatencyConfig config;
+  config.min_ms = in.read<uint32_t>();
+  config.max_ms = in.read<uint32_t>();
+  config.distribution = readEnum(in, DistributionType::EXPONENTIAL);
+  return config;
+}
+
+void writePacketLoss(CheckpointWriter& out, const PacketLossConfig& config) {
+  out.write(config.probability);
+  out.write(config.burst_mode);
+  out.write(config.burst_length);
+  out.write(config.gilbert_elliott);
+  out.write(config.good_to_bad);
+  out.write(config.bad_to_good);
+  out.write(config.loss_good);
+  out.write(config.loss_bad);
+}
+
+PacketLossConfig readPacketLoss(CheckpointReader& in) {
+  PacketLossConfig config;
+  config.probability = in.read<float>();
+  config.burst_mode = in.read<bool>();
+  config.burst_length = in.read<uint32_t>();
+  config.gilbert_elliott = in.read<bool>();
+  config.good_to_bad = in.read<float>();
+  config.bad_to_good = in.read<float>();
+  config.loss_good = in.read<float>();
+  config.loss_bad = in.read<float>();
+  return config;
+}
+
+void writeBandwidth(CheckpointWriter& out, const BandwidthConfig& config) {
+  out.write(config.max_bytes_per_sec);
+  out.write(config.max_messages_per_sec);
+  out.write(config.bucket_size);
+}
+
+BandwidthConfig readBandwidth(CheckpointReader& in) {
+  BandwidthConfig config;
+  config.max_bytes_per_sec = in.read<uint32_t>();
+  config.max_messages_per_sec = in.read<uint32_t>();
+  config.bucket_size = in.read<uint32_t>();
+  return config;
+}
+
+/**
+ * @brief Writes per-connection overrides with a value writer
+ */
+template <typename T, typename WriteValue>
+void writeOverrides(CheckpointWriter& out, const std::vector<T>& overrides,
+                    WriteValue write_value) {
+  out.write<uint32_t>(static_cast<uint32_t>(overrides.size()));
+  for (const auto& entry : overrides) {
+    out.writeString(entry.from);
+    out.writeString(entry.to);
+    write_value(out, entry.config);
+  }
+}
+
+template <typename T, typename ReadValue>
+std::vector<T> readOverrides(CheckpointReader& in, ReadValue read_value) {
+  std::vector<T> overrides(readCount(in));
+  for (auto& entry : overrides) {
+    entry.from = in.readString();
+    entry.to = in.readString();
+    entry.config = read_value(in);
+  }
+  return overrides;
+}
+
+void writeSimulation(CheckpointWriter& out, const SimulationConfig& config) {
+  out.writeString(config.name);
+  out.writeString(config.description);
+  out.write(config.duration);
+  out.write(config.time_scale);
+  out.write(config.seed);
+  out.write(config.threads);
+  out.writeString(config.sync);
+  out.writeString(config.partition);
+  out.write(config.lazy_nodes);
+  out.writeString(config.node_engine);
+  out.write(config.max_nodes);
+  out.writeString(config.firmware_clock);
+  out.write(config.max_tick_ms);
+}
+
+SimulationConfig readSimulation(CheckpointReader& in) {
+  SimulationConfig config;
+  config.name = in.readString();
+  config.description = in.readString();
+  config.duration = in.read<uint32_t>();
+  config.time_scale = in.read<float>();
+  config.seed = in.read<uint32_t>();
+  config.threads = in.read<uint32_t>();
+  config.sync = in.readString();
+  config.partition = in.readString();
+  config.lazy_nodes = in.read<bool>();
+  config.node_engine = in.readString();
+  config.max_nodes = in.read<uint32_t>();
+  config.firmware_clock = in.readString();
+  config.max_tick_ms = in.read<uint32_t>();
+  return config;
+}
+
+void writeNetwork(CheckpointWriter& out, const NetworkConfig& config) {
+  writeLatency(out, config.default_latency);
+  writeOverrides(out, config.specific_latencies, writeLatency);
+  writePacketLoss(out, config.default_packet_loss);
+  writeOverrides(out, config.specific_packet_losses, writePacketLoss);
+  writeBandwidth(out, config.default_bandwidth);
+  writeOverrides(out, config.specific_bandwidths, writeBandwidth);
+  out.write(config.airtime.bitrate_bps);
+  out.write(config.airtime.frame_overhead_us);
+  out.write(config.airtime.slot_us);
+  out.write(config.airtime.contention_window);
+  out.write(config.airtime.max_wait_ms);
+  out.write(config.packet_loss);
+  out.write(config.bandwidth);
+  out.writeString(config.transport);
+  out.writeString(config.delivery_queue);
+  out.write(config.coalesce);
+  out.writeString(config.trace);
+}
+
+NetworkConfig readNetwork(CheckpointReader& in) {
+  NetworkConfig config;
+  config.default_latency = readLatency(in);
+  config.specific_latencies = readOverrides<ConnectionLatencyConfig>(in, readLatency);
+  config.default_packet_loss = readPacketLoss(in);
+  config.specific_packet_losses = readOverrides<ConnectionPacketLossConfig>(in, readPacketLoss);
+  config.default_bandwidth = readBandwidth(in);
+  config.specific_bandwidths = readOverrides<ConnectionBandwidthConfig>(in, readBandwidth);
+  config.airtime.bitrate_bps = in.read<uint32_t>();
+  config.airtime.frame_overhead_us = in.read<uint32_t>();
+  config.airtime.slot_us = in.read<uint32_t>();
+  config.airtime.contention_window = in.read<uint32_t>();
+  config.airtime.max_wait_ms = in.read<uint32_t>();
+  config.packet_loss = in.read<float>();
+  config.bandwidth = in.read<uint64_t>();
+  config.transport = in.readString();
+  config.delivery_queue = in.readString();
+  config.coalesce = in.read<bool>();
+  config.trace = in.readString();
+  return config;
+}
+
+void writeNode(CheckpointWriter& out, const NodeConfigExtended& node,
+               const FirmwareTable& firmware_configs) {
+  out.writeString(node.id);
+  out.write(node.nodeId);
+  out.writeString(node.type);
+  out.writeString(node.firmware);
+  out.write<uint32_t>(static_cast<uint32_t>(node.position.size()));
+  for (int coordinate : node.position) {
+    out.write<int32_t>(coordinate);
+  }
+  out.writeString(node.mesh_prefix);
+  out.writeString(node.mesh_password);
+  out.write(node.mesh_port);
+  out.write<uint32_t>(node.firmwareConfig ? firmware_configs.at(node.firmwareConfig.get()) : 0);
+  out.write(node.clock_offset_ms);
+  out.write(node.clock_drift_ppm);
+  writeOptional(out, node.sensor_interval);
+  writeOptional(out, node.mqtt_broker);
+  writeOptional(out, node.mqtt_port);
+  writeOptional(out, node.mqtt_topic_prefix);
+}
+
+NodeConfigExtended readNode(CheckpointReader& in,
+                            const std::vector<std::shared_ptr<const FirmwareConfigMap>>& firmware_configs) {
+  NodeConfigExtended node;
+  node.id = in.readString();
+  node.nodeId = in.read<uint32_t>();
+  node.type = in.readString();
+  node.firmware = in.readString();
+  node.position.resize(readCount(in));
+  for (int& coordinate : node.position) {
+    coordinate = in.read<int32_t>();
+  }
+  node.mesh_prefix = in.readString();
+  node.mesh_password = in.readString();
+  node.mesh_port = in.read<uint16_t>();
+  const uint32_t firmware_index = in.read<uint32_t>();
+  if (firmware_index > firmware_configs.size()) {
+    throw std::runtime_error("Compiled scenario is malformed");
+  }
+  if (firmware_index > 0) {
+    node.firmwareConfig = firmware_configs[firmware_index - 1];
+  }
+  node.clock_offset_ms = in.read<int32_t>();
+  node.clock_drift_ppm = in.read<double>();
+  node.sensor_interval = readOptional<uint32_t>(in);
+  node.mqtt_broker = readOptionalString(in);
+  node.mqtt_port = readOptional<uint16_t>(in);
+  node.mqtt_topic_prefix = readOptionalString(in);
+  return node;
+}
+
+void writeTopology(CheckpointWriter& out, const TopologyConfig& config) {
+  writeEnum(out, config.type);
+  writeOptional(out, config.hub);
+  out.write(config.density);
+  out.write(config.bidirectional);
+  writePairs(out, config.connections);
+  out.write(config.radio.tx_power_dbm);
+  out.write(config.radio.reference_loss_db);
+  out.write(config.radio.path_loss_exponent);
+  out.write(config.radio.sensitivity_dbm);
+  out.write(config.radio.fade_margin_db);
+  out.write(config.radio.edge_loss);
+  out.write(config.radio.base_latency_ms);
+  out.write(config.radio.edge_jitter_ms);
+}
+
+TopologyConfig readTopology(CheckpointReader& in) {
+  TopologyConfig config;
+  config.type = readEnum(in, TopologyType::RADIO);
+  config.hub = readOptionalString(in);
+  config.density = in.read<float>();
+  config.bidirectional = in.read<bool>();
+  config.connections = readPairs(in);
+  config.radio.tx_power_dbm = in.read<double>();
+  config.radio.reference_loss_db = in.read<double>();
+  config.radio.path_loss_exponent = in.read<double>();
+  config.radio.sensitivity_dbm = in.read<double>();
+  config.radio.fade_margin_db = in.read<double>();
+  config.radio.edge_loss = in.read<float>();
+  config.radio.base_latency_ms = in.read<uint32_t>();
+  config.radio.edge_jitter_ms = in.read<uint32_t>();
+  return config;
+}
+
+void writeEvent(CheckpointWriter& out, const EventConfig& event) {
+  out.write(event.time);
+  out.write(event.time_ms);
+  writeEnum(out, event.action);
+  out.writeString(event.target);
+  writeStrings(out, event.targets);
+  out.writeString(event.description);
+  out.write<uint32_t>(static_cast<uint32_t>(event.groups.size()));
+  for (const auto& group : event.groups) {
+    writeStrings(out, group);
+  }
+  out.writeString(event.from);
+  out.writeString(event.to);
+  out.writeString(event.payload);
+  out.write(event.quality);
+  out.write(event.count);
+  out.writeString(event.template_name);
+  out.writeString(event.id_prefix);
+  out.write(event.graceful);
+  out.write(event.delay);
+  out.write(event.latency);
+  out.write(event.packet_loss);
+}
+
+EventConfig readEvent(CheckpointReader& in) {
+  EventConfig event;
+  event.time = in.read<uint32_t>();
+  event.time_ms = in.read<uint64_t>();
+  event.action = readEnum(in, EventAction::CONNECTION_DEGRADE);
+  event.target = in.readString();
+  event.targets = readStrings(in);
+  event.description = in.readString();
+  event.groups.resize(readCount(in));
+  for (auto& group : event.groups) {
+    group = readStrings(in);
+  }
+  event.from = in.readString();
+  event.to = in.readString();
+  event.payload = in.readString();
+  event.quality = in.read<float>();
+  event.count = in.read<uint32_t>();
+  event.template_name = in.readString();
+  event.id_prefix = in.readString();
+  event.graceful = in.read<bool>();
+  event.delay = in.read<uint32_t>();
+  event.latency = in.read<uint32_t>();
+  event.packet_loss = in.read<float>();
+  return event;
+}
+
+void writeDuration(CheckpointWriter& out, const DurationConfig& config) {
+  out.writeString(config.distribution);
+  out.write(config.mean);
+  out.write(config.shape);
+}
+
+DurationConfig readDuration(CheckpointReader& in) {
+  DurationConfig config;
+  config.distribution = in.readString();
+  config.mean = in.read<double>();
+  config.shape = in.read<double>();
+  return config;
+}
+
+void writeChurn(CheckpointWriter& out, const ChurnConfig& churn) {
+  out.writeString(churn.type);
+  writeStrings(out, churn.targets);
+  writePairs(out, churn.links);
+  writeDuration(out, churn.failure);
+  writeDuration(out, churn.repair);
+  out.write(churn.start);
+}
+
+ChurnConfig readChurn(CheckpointReader& in) {
+  ChurnConfig churn;
+  churn.type = in.readString();
+  churn.targets = readStrings(in);
+  churn.links = readPairs(in);
+  churn.failure = readDuration(in);
+  churn.repair = readDuration(in);
+  churn.start = in.read<uint32_t>();
+  return churn;
+}
+
+void writeTraffic(CheckpointWriter& out, const TrafficConfig& traffic) {
+  out.writeString(traffic.pattern);
+  out.writeString(traffic.arrival);
+  writeStrings(out, traffic.sources);
+  out.writeString(traffic.sink);
+  out.write(traffic.rate);
+  out.write(traffic.burst);
+  out.write(traffic.size);
+  out.write(traffic.start);
+  out.write(traffic.stop);
+}
+
+TrafficConfig readTraffic(CheckpointReader& in) {
+  TrafficConfig traffic;
+  traffic.pattern = in.readString();
+  traffic.arrival = in.readString();
+  traffic.sources = readStrings(in);
+  traffic.sink = in.readString();
+  traffic.rate = in.read<double>();
+  traffic.burst = in.read<uint32_t>();
+  traffic.size = in.read<uint32_t>();
+  traffic.start = in.read<uint32_t>();
+  traffic.stop = in.read<uint32_t>();
+  return traffic;
+}
+
+} // anonymous namespace
+
+constexpr uint32_t ScenarioCache::VERSION;
+constexpr uint64_t ScenarioCache::HASH_BASIS;
+
+uint64_t ScenarioCache::hashBytes(const void* data, size_t size, uint64_t basis) {
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  uint64_t value = basis;
+  for (size_t i = 0; i < size; ++i) {
+    value ^= bytes[i];
+    value *= FNV_PRIME;
+  }
+  return value;
+}
+
+void ScenarioCache::write(CheckpointWriter& out, const ScenarioConfig& config) {
+  writeSimulation(out, config.simulation);
+  writeNetwork(out, config.network);
+
+  // Firmware configurations, in order of first use by nodes then templates
+  FirmwareTable firmware_index;
+  std::vector<const FirmwareConfigMap*> firmware_configs;
+  auto collect = [&](const NodeConfigExtended& node) {
+    if (node.firmwareConfig &&
+        firmware_index.emplace(node.firmwareConfig.get(),
+                               static_cast<uint32_t>(firmware_configs.size() + 1)).second) {
+      firmware_configs.push_back(node.firmwareConfig.get());
+    }
+  };
+  for (const auto& node : config.nodes) {
+    collect(node);
+  }
+  for (const auto& tmpl : config.templates) {
+    collect(tmpl.base_config);
+  }
+  out.write<uint32_t>(static_cast<uint32_t>(firmware_configs.size()));
+  for (const FirmwareConfigMap* values : firmware_configs) {
+    out.write<uint32_t>(static_cast<uint32_t>(values->size()));
+    for (const auto& entry : *values) {
+      out.writeString(entry.first);
+      out.writeString(entry.second);
+    }
+  }
+
+  out.write<uint32_t>(static_cast<uint32_t>(config.nodes.size()));
+  for (const auto& node : config.nodes) {
+    writeNode(out, node, firmware_index);
+  }
+  out.write<uint32_t>(static_cast<uint32_t>(config.templates.size()));
+  for (const auto& tmpl : config.templates) {
+    out.writeString(tmpl.template_name);
+    out.write(tmpl.count);
+    out.writeString(tmpl.id_prefix);
+    writeNode(out, tmpl.base_config, firmware_index);
+  }
+
+  writeTopology(out, config.topology);
+  out.write<uint32_t>(static_cast<uint32_t>(config.events.size()));
+  for (const auto& event : config.events) {
+    writeEvent(out, event);
+  }
+  out.write<uint32_t>(static_cast<uint32_t>(config.churn.size()));
+  for (const auto& churn : config.churn) {
+    writeChurn(out, churn);
+  }
+  out.write<uint32_t>(static_cast<uint32_t>(config.traffic.size()));
+  for (const auto& traffic : config.traffic) {
+    writeTraffic(out, traffic);
+  }
+
+  out.writeString(config.metrics.output);
+  out.write(config.metrics.interval);
+  writeStrings(out, config.metrics.collect);
+  writeStrings(out, config.metrics.export_formats);
+
+  out.writeString(config.gateway.listen);
+  out.writeString(config.gateway.backend);
+  writeStrings(out, config.gateway.nodes);
+  out.write(config.gateway.max_datagram);
+  out.write(config.gateway.broadcasts);
+}
+
+ScenarioConfig ScenarioCache::read(CheckpointReader& in) {
+  ScenarioConfig config;
+  config.simulation = readSimulation(in);
+  config.network = readNetwork(in);
+
+  std::vector<std::shared_ptr<const FirmwareConfigMap>> firmware_configs(readCount(in));
+  for (auto& values : firmware_configs) {
+    auto map = std::make_shared<FirmwareConfigMap>();
+    const uint32_t entries = readCount(in);
+    for (uint32_t i = 0; i < entries; ++i) {
+      std::string key = in.readString();
+      (*map)[key] = in.readString();
+    }
+    values = std::move(map);
+  }
+
+  const uint32_t node_count = readCount(in);
+  config.nodes.reserve(node_count);
+  for (uint32_t i = 0; i < node_count; ++i) {
+    config.nodes.push_back(readNode(in, firmware_configs));
+  }
+  config.templates.resize(readCount(in));
+  for (auto& tmpl : config.templates) {
+    tmpl.template_name = in.readString();
+    tmpl.count = in.read<uint32_t>();
+    tmpl.id_prefix = in.readString();
+    tmpl.base_config = readNode(in, firmware_configs);
+  }
+
+  config.topology = readTopology(in);
+  config.events.resize(readCount(in));
+  for (auto& event : config.events) {
+    event = readEvent(in);
+  }
+  config.churn.resize(readCount(in));
+  for (auto& churn : config.churn) {
+    churn = readChurn(in);
+  }
+  config.traffic.resize(readCount(in));
+  for (auto& traffic : config.traffic) {
+    traffic = readTraffic(in);
+  }
+
+  config.metrics.output = in.readString();
+  config.metrics.interval = in.read<uint32_t>();
+  config.metrics.collect = readStrings(in);
+  config.metrics.export_formats = readStrings(in);
+
+  config.gateway.listen = in.readString();
+  config.gateway.backend = in.readString();
+  config.gateway.nodes = readStrings(in);
+  config.gateway.max_datagram = in.read<uint32_t>();
+  config.gateway.broadcasts = in.read<bool>();
+  return config;
+}
+
+boost::optional<ScenarioConfig> ScenarioCache::load(const std::string& path, uint64_t key) {
+  try {
+    MappedFile file(path);
+    ScenarioHeader header;
+    if (file.size() < sizeof(header)) {
+      return boost::none;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, SCENARIO_MAGIC, sizeof(SCENARIO_MAGIC)) != 0 ||
+        header.version != VERSION || header.key != key ||
+        header.payload_size != file.size() - sizeof(header)) {
+      return boost::none;
+    }
+
+    // Read straight from the mapping; only the pages holding the image
+    // are touched
+    CheckpointReader in(file.data() + sizeof(header), file.size() - sizeof(header));
+    ScenarioConfig config = read(in);
+    if (in.remaining() != 0) {
+      return boost::none;
+    }
+    return config;
+  } catch (const std::exception&) {
+    return boost::none;
+  }
+}
+
+void ScenarioCache::save(const std::string& path, uint64_t key, const ScenarioConfig& config) {
+  CheckpointWriter out;
+  write(out, config);
+
+  ScenarioHeader header;
+  std::memcpy(header.magic, SCENARIO_MAGIC, sizeof(SCENARIO_MAGIC));
+  header.version = VERSION;
+  header.reserved = 0;
+  header.key = key;
+  header.payload_size = out.data().size();
+
+  const std::string temp_path = path + ".tmp" + std::to_string(std::random_device{}());
+  {
+    std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+      throw std::runtime_error("Cannot create compiled scenario: " + temp_path);
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(out.data().data()),
+               static_cast<std::streamsize>(out.data().size()));
+    if (!file) {
+      std::remove(temp_path.c_str());
+      throw std::runtime_error("Cannot write compiled scenario: " + temp_path);
+    }
+  }
+
+#ifdef _WIN32
+  std::remove(path.c_str());  // rename() does not replace files on Windows
+#endif
+  if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+    std::remove(temp_path.c_str());
+    throw std::runtime_error("Cannot write compiled scenario: " + path);
+  }
+}
+
+} // namespace simulator
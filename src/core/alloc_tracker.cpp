@@ -0,0 +1,254 @@
+/**
+ * @file alloc_tracker.cpp
+ * @brief Implementation of AllocTracker and the counting operator new
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/alloc_tracker.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace simulator {
+
+namespace {
+
+/// Tag of the calling thread (trivially initialized, so usable in operator new)
+thread_local uint8_t current_tag = 0;
+
+// Formats a byte count with a binary unit that keeps 3-4 significant digits
+std::string formatBytes(double bytes) {
+  const char* units[] = {"B", "KiB", "MiB", "GiB"};
+  size_t unit = 0;
+  while ((bytes >= 1024.0 || bytes <= -1024.0) && unit + 1 < sizeof(units) / sizeof(units[0])) {
+    bytes /= 1024.0;
+    ++unit;
+  }
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), unit == 0 ? "%.0f %s" : "%.1f %s", bytes, units[unit]);
+  return buffer;
+}
+
+#if SIMULATOR_ENABLE_ALLOC_TRACKING
+
+/// Header in front of every block; keeps the block maximally aligned
+constexpr size_t HEADER_SIZE = alignof(std::max_align_t) > 16 ? alignof(std::max_align_t) : 16;
+
+struct BlockHeader {
+  size_t size;
+  uint8_t tag;
+};
+
+/// Counters of one tag, on a cache line of their own
+struct alignas(64) TagCounters {
+  std::atomic<uint64_t> allocations;
+  std::atomic<uint64_t> frees;
+  std::atomic<uint64_t> allocated_bytes;
+  std::atomic<int64_t> live_bytes;
+  std::atomic<int64_t> peak_bytes;
+};
+
+// Zero-initialized before any dynamic initialization allocates
+TagCounters counters[ALLOC_TAG_COUNT];
+
+void* allocate(size_t size) {
+  void* raw = std::malloc(size + HEADER_SIZE);
+  if (!raw) {
+    return nullptr;
+  }
+  BlockHeader* header = static_cast<BlockHeader*>(raw);
+  header->size = size;
+  header->tag = current_tag;
+
+  TagCounters& tag = counters[header->tag];
+  tag.allocations.fetch_add(1, std::memory_order_relaxed);
+  tag.allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+  const int64_t live = tag.live_bytes.fetch_add(static_cast<int64_t>(size),
+                                                std::memory_order_relaxed) +
+                       static_cast<int64_t>(size);
+  int64_t peak = tag.peak_bytes.load(std::memory_order_relaxed);
+  while (live > peak &&
+         !tag.peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+  }
+  return static_cast<char*>(raw) + HEADER_SIZE;
+}
+
+void* allocateOrThrow(size_t size) {
+  if (size == 0) {
+    size = 1;
+  }
+  for (;;) {
+    void* block = allocate(size);
+    if (block) {
+      return block;
+    }
+    std::new_handler handler = std::get_new_handler();
+    if (!handler) {
+      throw std::bad_alloc();
+    }
+    handler();
+  }
+}
+
+void release(void* block) {
+  if (!block) {
+    return;
+  }
+  void* raw = static_cast<char*>(block) - HEADER_SIZE;
+  const BlockHeader* header = static_cast<const BlockHeader*>(raw);
+  TagCounters& tag = counters[header->tag];
+  tag.frees.fetch_add(1, std::memory_order_relaxed);
+  tag.live_bytes.fetch_sub(static_cast<int64_t>(header->size), std::memory_order_relaxed);
+  std::free(raw);
+}
+
+#endif // SIMULATOR_ENABLE_ALLOC_TRACKING
+
+} // anonymous namespace
+
+const char* allocTagName(AllocTag tag) {
+  switch (tag) {
+    case AllocTag::OTHER: return "other";
+    case AllocTag::MESH: return "mesh";
+    case AllocTag::NETWORK: return "network";
+    case AllocTag::EVENTS: return "events";
+    case AllocTag::FIRMWARE: return "firmware";
+    case AllocTag::ASIO: return "asio";
+  }
+  return "unknown";
+}
+
+AllocTag AllocTracker::getTag() {
+  return static_cast<AllocTag>(current_tag);
+}
+
+AllocTag AllocTracker::setTag(AllocTag tag) {
+  const AllocTag previous = static_cast<AllocTag>(current_tag);
+  current_tag = static_cast<uint8_t>(tag);
+  return previous;
+}
+
+AllocSnapshot AllocTracker::snapshot() {
+  AllocSnapshot result;
+#if SIMULATOR_ENABLE_ALLOC_TRACKING
+  for (size_t i = 0; i < ALLOC_TAG_COUNT; ++i) {
+    result[i].allocations = counters[i].allocations.load(std::memory_order_relaxed);
+    result[i].frees = counters[i].frees.load(std::memory_order_relaxed);
+    result[i].allocated_bytes = counters[i].allocated_bytes.load(std::memory_order_relaxed);
+    result[i].live_bytes = counters[i].live_bytes.load(std::memory_order_relaxed);
+    result[i].peak_bytes = counters[i].peak_bytes.load(std::memory_order_relaxed);
+  }
+#endif
+  return result;
+}
+
+AllocStats AllocTracker::total(const AllocSnapshot& snapshot) {
+  AllocStats sum;
+  for (const AllocStats& stats : snapshot) {
+    sum.allocations += stats.allocations;
+    sum.frees += stats.frees;
+    sum.allocated_bytes += stats.allocated_bytes;
+    sum.live_bytes += stats.live_bytes;
+    // Tags peak at different times; the sum bounds the total peak
+    sum.peak_bytes += stats.peak_bytes;
+  }
+  return sum;
+}
+
+void AllocTracker::print(const AllocSnapshot& snapshot, size_t nodes, std::ostream& out) {
+  out << "Heap by subsystem:\n";
+  auto line = [nodes, &out](const char* name, const AllocStats& stats) {
+    out << "  " << name << ": " << formatBytes(static_cast<double>(stats.live_bytes))
+        << " live, " << formatBytes(static_cast<double>(stats.peak_bytes)) << " peak, "
+        << stats.liveBlocks() << " blocks, " << stats.allocations << " allocations";
+    if (nodes > 0) {
+      out << ", " << formatBytes(static_cast<double>(stats.live_bytes) /
+                                 static_cast<double>(nodes)) << "/node";
+    }
+    out << "\n";
+  };
+  for (size_t i = 0; i < ALLOC_TAG_COUNT; ++i) {
+    if (snapshot[i].allocations > 0) {
+      line(allocTagName(static_cast<AllocTag>(i)), snapshot[i]);
+    }
+  }
+  line("total", total(snapshot));
+}
+
+std::string AllocTracker::summary(const AllocSnapshot& snapshot) {
+  std::string text;
+  for (size_t i = 0; i < ALLOC_TAG_COUNT; ++i) {
+    if (snapshot[i].live_bytes == 0) {
+      continue;
+    }
+    if (!text.empty()) {
+      text += ' ';
+    }
+    text += allocTagName(static_cast<AllocTag>(i));
+    text += '=';
+    text += formatBytes(static_cast<double>(snapshot[i].live_bytes));
+  }
+  return text;
+}
+
+} // namespace simulator
+
+#if SIMULATOR_ENABLE_ALLOC_TRACKING
+
+// Replacements of the global allocation functions. The array and sized
+// forms are replaced too, as some runtimes do not route them through the
+// plain ones. Over-aligned new (C++17) keeps its own allocator.
+
+void* operator new(std::size_t size) {
+  return simulator::allocateOrThrow(size);
+}
+
+void* operator new[](std::size_t size) {
+  return simulator::allocateOrThrow(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  try {
+    return simulator::allocateOrThrow(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  try {
+    return simulator::allocateOrThrow(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void operator delete(void* block) noexcept {
+  simulator::release(block);
+}
+
+void operator delete[](void* block) noexcept {
+  simulator::release(block);
+}
+
+void operator delete(void* block, std::size_t) noexcept {
+  simulator::release(block);
+}
+
+void operator delete[](void* block, std::size_t) noexcept {
+  simulator::release(block);
+}
+
+void operator delete(void* block, const std::nothrow_t&) noexcept {
+  simulator::release(block);
+}
+
+void operator delete[](void* block, const std::nothrow_t&) noexcept {
+  simulator::release(block);
+}
+
+#endif // SIMULATOR_ENABLE_ALLOC_TRACKING
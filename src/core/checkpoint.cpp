@@ -0,0 +1,109 @@
+/**
+ * @file checkpoint.cpp
+ * @brief Implementation of simulation checkpoints
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/checkpoint.hpp"
+
+#include <fstream>
+#include <stdexcept>
+
+namespace simulator {
+
+namespace {
+
+constexpr char CHECKPOINT_MAGIC[8] = {'P', 'M', 'C', 'K', 'P', 'T', '0', '1'};
+
+/**
+ * @brief Fixed header at the start of a checkpoint file
+ */
+struct CheckpointHeader {
+  char magic[8];          ///< CHECKPOINT_MAGIC
+  uint32_t version;       ///< Checkpoint::VERSION
+  uint32_t seed;          ///< Simulation seed
+  uint64_t time_us;       ///< Virtual time
+  uint64_t state_size;    ///< Bytes of component state that follow
+};
+
+} // anonymous namespace
+
+constexpr uint32_t Checkpoint::VERSION;
+
+std::string CheckpointReader::readString() {
+  const uint32_t size = read<uint32_t>();
+  if (size > remaining()) {
+    throw std::runtime_error("Checkpoint is truncated");
+  }
+  std::string value(reinterpret_cast<const char*>(data_ + offset_), size);
+  offset_ += size;
+  return value;
+}
+
+void CheckpointReader::readBytes(void* out, size_t size) {
+  if (size > remaining()) {
+    throw std::runtime_error("Checkpoint is truncated");
+  }
+  if (size > 0) {
+    std::memcpy(out, data_ + offset_, size);
+  }
+  offset_ += size;
+}
+
+void CheckpointReader::expectSection(CheckpointSection section) {
+  const uint32_t tag = read<uint32_t>();
+  if (tag != section) {
+    throw std::runtime_error("Checkpoint does not match this simulation: unexpected section");
+  }
+}
+
+void Checkpoint::save(const std::string& path) const {
+  CheckpointHeader header;
+  std::memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+  header.version = VERSION;
+  header.seed = seed;
+  header.time_us = time_us;
+  header.state_size = state.size();
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    throw std::runtime_error("Cannot create checkpoint file: " + path);
+  }
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char*>(state.data()),
+            static_cast<std::streamsize>(state.size()));
+  if (!out) {
+    throw std::runtime_error("Cannot write checkpoint file: " + path);
+  }
+}
+
+Checkpoint Checkpoint::load(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    throw std::runtime_error("Cannot open checkpoint file: " + path);
+  }
+
+  CheckpointHeader header;
+  if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+      std::memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0) {
+    throw std::runtime_error("Not a checkpoint file: " + path);
+  }
+  if (header.version != VERSION) {
+    throw std::runtime_error("Unsupported checkpoint version " +
+                             std::to_string(header.version) + ": " + path);
+  }
+
+  Checkpoint checkpoint;
+  checkpoint.seed = header.seed;
+  checkpoint.time_us = header.time_us;
+  checkpoint.state.resize(header.state_size);
+  if (!in.read(reinterpret_cast<char*>(checkpoint.state.data()),
+               static_cast<std::streamsize>(header.state_size))) {
+    throw std::runtime_error("Checkpoint file is truncated: " + path);
+  }
+  return checkpoint;
+}
+
+} // namespace simulator
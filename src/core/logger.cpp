@@ -0,0 +1,267 @@
+/**
+ * @file logger.cpp
+ * @brief Implementation of Logger class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/logger.hpp"
+#include "simulator/spsc_queue.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+
+namespace simulator {
+
+namespace {
+
+/// Session numbers of all loggers, so a thread never reuses a stale buffer
+std::atomic<uint64_t> next_session{1};
+
+/// Idle writer wake-up interval
+constexpr auto WRITER_IDLE = std::chrono::milliseconds(10);
+
+/// The calling thread's buffer and the session it belongs to
+thread_local struct {
+  uint64_t session = 0;
+  void* buffer = nullptr;
+} thread_buffer;
+
+} // anonymous namespace
+
+struct Logger::ThreadBuffer {
+  explicit ThreadBuffer(size_t capacity) : queue(capacity) {}
+  SpscQueue<LogRecord> queue;
+};
+
+Logger::Logger()
+  : level_(static_cast<uint8_t>(LogLevel::INFO)), out_(&std::cout), err_(&std::cerr) {}
+
+Logger::~Logger() {
+  stop();
+}
+
+Logger& Logger::instance() {
+  static Logger logger;
+  return logger;
+}
+
+LogLevel Logger::parseLevel(const std::string& name) {
+  if (name == "DEBUG") return LogLevel::DEBUG;
+  if (name == "INFO") return LogLevel::INFO;
+  if (name == "WARN") return LogLevel::WARN;
+  if (name == "ERROR") return LogLevel::ERROR;
+  if (name == "OFF") return LogLevel::OFF;
+  throw std::invalid_argument("Invalid log level: " + name);
+}
+
+void Logger::setOutput(std::ostream* out, std::ostream* err) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  out_ = out;
+  err_ = err;
+}
+
+void Logger::start(size_t buffer_records) {
+  if (isRunning()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  buffers_.clear();
+  buffer_records_ = std::max<size_t>(1, buffer_records);
+  session_ = next_session.fetch_add(1, std::memory_order_relaxed);
+  stopping_ = false;
+  wake_ = false;
+  written_ = sequence_.load(std::memory_order_relaxed);
+  running_.store(true, std::memory_order_release);
+  writer_ = std::thread(&Logger::writerLoop, this);
+}
+
+void Logger::stop() {
+  if (!isRunning()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_cv_.notify_one();
+  writer_.join();
+  running_.store(false, std::memory_order_release);
+}
+
+void Logger::flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!isRunning()) {
+    if (out_) {
+      out_->flush();
+    }
+    if (err_) {
+      err_->flush();
+    }
+    return;
+  }
+  const uint64_t target = sequence_.load(std::memory_order_acquire);
+  wake_ = true;
+  wake_cv_.notify_one();
+  done_cv_.wait(lock, [&]() { return written_ >= target; });
+}
+
+void Logger::captureText(LogRecord& record, const char* text, size_t length) {
+  LogArg& arg = record.args[record.count++];
+  arg.length = static_cast<uint32_t>(length);
+  if (length <= LogRecord::TEXT_SIZE - record.text_used) {
+    arg.type = LogArg::Type::TEXT;
+    arg.offset = record.text_used;
+    std::memcpy(record.text + record.text_used, text, length);
+    record.text_used += static_cast<uint32_t>(length);
+  } else {
+    arg.type = LogArg::Type::SPILLED;
+    arg.offset = static_cast<uint32_t>(record.spill.size());
+    record.spill.append(text, length);
+  }
+}
+
+std::string Logger::format(const LogRecord& record) {
+  std::string line;
+  size_t next = 0;
+  for (const char* p = record.format; *p; ++p) {
+    if (p[0] != '{' || p[1] != '}') {
+      line += *p;
+      continue;
+    }
+    ++p;
+    if (next == record.count) {
+      continue;
+    }
+    const LogArg& arg = record.args[next++];
+    switch (arg.type) {
+      case LogArg::Type::INT:
+        line += std::to_string(arg.i);
+        break;
+      case LogArg::Type::UINT:
+        line += std::to_string(arg.u);
+        break;
+      case LogArg::Type::DOUBLE: {
+        // Same as the default std::ostream formatting
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%g", arg.d);
+        line += buffer;
+        break;
+      }
+      case LogArg::Type::TEXT:
+        line.append(record.text + arg.offset, arg.length);
+        break;
+      case LogArg::Type::SPILLED:
+        line.append(record.spill, arg.offset, arg.length);
+        break;
+    }
+  }
+  return line;
+}
+
+void Logger::submit(LogRecord& record) {
+  if (!isRunning()) {
+    // No writer: format and write on the calling thread
+    std::string line = format(record);
+    line += '\n';
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostream* stream = record.level >= LogLevel::WARN ? err_ : out_;
+    if (stream) {
+      stream->write(line.data(), static_cast<std::streamsize>(line.size()));
+      stream->flush();
+    }
+    return;
+  }
+
+  ThreadBuffer* buffer = threadBuffer();
+  record.sequence = sequence_.fetch_add(1, std::memory_order_relaxed);
+  while (!buffer->queue.tryPush(std::move(record))) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      wake_ = true;
+    }
+    wake_cv_.notify_one();
+    std::this_thread::yield();
+  }
+}
+
+Logger::ThreadBuffer* Logger::threadBuffer() {
+  if (thread_buffer.session == session_) {
+    return static_cast<ThreadBuffer*>(thread_buffer.buffer);
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  buffers_.push_back(std::unique_ptr<ThreadBuffer>(new ThreadBuffer(buffer_records_)));
+  thread_buffer.session = session_;
+  thread_buffer.buffer = buffers_.back().get();
+  return buffers_.back().get();
+}
+
+void Logger::write(const std::vector<LogRecord>& records, std::string& line) {
+  bool wrote_out = false;
+  bool wrote_err = false;
+  for (const auto& record : records) {
+    const bool error = record.level >= LogLevel::WARN;
+    std::ostream* stream = error ? err_ : out_;
+    if (!stream) {
+      continue;
+    }
+    line = format(record);
+    line += '\n';
+    stream->write(line.data(), static_cast<std::streamsize>(line.size()));
+    (error ? wrote_err : wrote_out) = true;
+  }
+  if (wrote_out) {
+    out_->flush();
+  }
+  if (wrote_err) {
+    err_->flush();
+  }
+}
+
+void Logger::writerLoop() {
+  std::vector<LogRecord> batch;
+  std::vector<ThreadBuffer*> buffers;
+  std::string line;
+  LogRecord record;
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    const bool stopping = stopping_;
+    buffers.clear();
+    for (const auto& buffer : buffers_) {
+      buffers.push_back(buffer.get());
+    }
+    lock.unlock();
+
+    for (ThreadBuffer* buffer : buffers) {
+      while (buffer->queue.tryPop(record)) {
+        batch.push_back(std::move(record));
+      }
+    }
+    // Each queue is in order already; the sort interleaves the threads
+    std::sort(batch.begin(), batch.end(), [](const LogRecord& a, const LogRecord& b) {
+      return a.sequence < b.sequence;
+    });
+
+    lock.lock();
+    write(batch, line);
+    written_ += batch.size();
+    done_cv_.notify_all();
+
+    // Stop once a pass that started after stop() found nothing
+    if (stopping && batch.empty()) {
+      break;
+    }
+    if (batch.empty()) {
+      wake_cv_.wait_for(lock, WRITER_IDLE, [&]() { return wake_ || stopping_; });
+    }
+    wake_ = false;
+    batch.clear();
+  }
+}
+
+} // namespace simulator
@@ -0,0 +1,93 @@
+/**
+ * @file mapped_file.cpp
+ * @brief Implementation of read-only memory-mapped files
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/platform_compat.hpp"
+#include "simulator/mapped_file.hpp"
+
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace simulator {
+
+MappedFile::MappedFile(const std::string& path) {
+#ifdef _WIN32
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error("Cannot open file: " + path);
+  }
+  file_ = file;
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size)) {
+    CloseHandle(file);
+    throw std::runtime_error("Cannot read size of file: " + path);
+  }
+  size_ = static_cast<size_t>(size.QuadPart);
+  if (size_ > 0) {
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL) {
+      CloseHandle(file);
+      throw std::runtime_error("Cannot map file: " + path);
+    }
+    mapping_ = mapping;
+    data_ = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (data_ == nullptr) {
+      CloseHandle(mapping);
+      CloseHandle(file);
+      throw std::runtime_error("Cannot map file: " + path);
+    }
+  }
+#else
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Cannot open file: " + path);
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Cannot read size of file: " + path);
+  }
+  size_ = static_cast<size_t>(st.st_size);
+  if (size_ > 0) {
+    void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      ::close(fd);
+      throw std::runtime_error("Cannot map file: " + path);
+    }
+    data_ = static_cast<const unsigned char*>(data);
+  }
+  ::close(fd);  // The mapping keeps the file alive
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifdef _WIN32
+  if (data_) {
+    UnmapViewOfFile(data_);
+  }
+  if (mapping_) {
+    CloseHandle(mapping_);
+  }
+  if (file_) {
+    CloseHandle(file_);
+  }
+#else
+  if (data_) {
+    munmap(const_cast<unsigned char*>(data_), size_);
+  }
+#endif
+}
+
+} // namespace simulator
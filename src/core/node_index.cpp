@@ -0,0 +1,115 @@
+/**
+ * @file node_index.cpp
+ * @brief Implementation of NodeIndex class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/node_index.hpp"
+
+namespace simulator {
+
+namespace {
+
+constexpr size_t INITIAL_CAPACITY = 64;
+
+} // anonymous namespace
+
+NodeIndex::NodeIndex()
+    : slots_(INITIAL_CAPACITY, Slot{0, SlotHandle()}),
+      mask_(INITIAL_CAPACITY - 1) {
+}
+
+size_t NodeIndex::slotFor(uint32_t nodeId) const {
+  // Fibonacci hashing spreads sequential node IDs across the table
+  return static_cast<size_t>((nodeId * 0x9E3779B97F4A7C15ULL) >> 32) & mask_;
+}
+
+SlotHandle NodeIndex::find(uint32_t nodeId) const {
+  if (nodeId == 0) {
+    return SlotHandle();
+  }
+  for (size_t i = slotFor(nodeId);; i = (i + 1) & mask_) {
+    const Slot& slot = slots_[i];
+    if (slot.id == 0) {
+      return SlotHandle();
+    }
+    if (slot.id == nodeId) {
+      return slot.handle;
+    }
+  }
+}
+
+bool NodeIndex::insert(uint32_t nodeId, SlotHandle handle) {
+  if (nodeId == 0) {
+    return false;
+  }
+
+  // Keep the load factor at or below 1/2 so probe sequences stay short
+  if ((size_ + 1) * 2 > slots_.size()) {
+    grow();
+  }
+
+  for (size_t i = slotFor(nodeId);; i = (i + 1) & mask_) {
+    Slot& slot = slots_[i];
+    if (slot.id == 0) {
+      slot.id = nodeId;
+      slot.handle = handle;
+      size_++;
+      return true;
+    }
+    if (slot.id == nodeId) {
+      return false;
+    }
+  }
+}
+
+bool NodeIndex::erase(uint32_t nodeId) {
+  if (nodeId == 0) {
+    return false;
+  }
+
+  size_t hole = slotFor(nodeId);
+  while (slots_[hole].id != nodeId) {
+    if (slots_[hole].id == 0) {
+      return false;
+    }
+    hole = (hole + 1) & mask_;
+  }
+
+  // Pull back every later entry of the run that may live in the hole,
+  // i.e. whose home slot is not cyclically in (hole, next]
+  for (size_t next = (hole + 1) & mask_; slots_[next].id != 0; next = (next + 1) & mask_) {
+    const size_t home = slotFor(slots_[next].id);
+    const bool stays = hole <= next ? (hole < home && home <= next)
+                                    : (hole < home || home <= next);
+    if (!stays) {
+      slots_[hole] = slots_[next];
+      hole = next;
+    }
+  }
+  slots_[hole] = Slot{0, SlotHandle()};
+  size_--;
+  return true;
+}
+
+void NodeIndex::grow() {
+  std::vector<Slot> old;
+  old.swap(slots_);
+  slots_.assign(old.size() * 2, Slot{0, SlotHandle()});
+  mask_ = slots_.size() - 1;
+
+  for (const Slot& entry : old) {
+    if (entry.id == 0) {
+      continue;
+    }
+    size_t i = slotFor(entry.id);
+    while (slots_[i].id != 0) {
+      i = (i + 1) & mask_;
+    }
+    slots_[i] = entry;
+  }
+}
+
+} // namespace simulator
@@ -10,13 +10,55 @@
 #include "simulator/platform_compat.hpp"
 
 #include "simulator/node_manager.hpp"
+#include "simulator/alloc_tracker.hpp"
+#include "simulator/checkpoint.hpp"
 #include "simulator/virtual_node.hpp"
+#include "simulator/mesh_transport.hpp"
+#include "simulator/topology.hpp"
+#include "simulator/firmware/firmware_factory.hpp"
+#include "simulator/logger.hpp"
+#include "simulator/loop_monitor.hpp"
+#include "simulator/trace_recorder.hpp"
+#include <algorithm>
+#include <functional>
+#include <map>
 #include <stdexcept>
 #include <cstdlib>
+#include <unordered_map>
+#include <unordered_set>
 #include <TaskSchedulerDeclarations.h>
 
 namespace simulator {
 
+constexpr size_t NodeManager::MAX_SHARDS;
+
+namespace {
+
+// Orders node configurations by what VirtualNode::makeFirmwareConfig()
+// builds from them, so equal firmware configurations can be shared
+struct FirmwareConfigLess {
+  bool operator()(const NodeConfig* a, const NodeConfig* b) const {
+    if (a->meshPrefix != b->meshPrefix) {
+      return a->meshPrefix < b->meshPrefix;
+    }
+    if (a->meshPassword != b->meshPassword) {
+      return a->meshPassword < b->meshPassword;
+    }
+    if (a->sharedFirmwareConfig != b->sharedFirmwareConfig) {
+      // Template nodes share one map; compare contents only if they differ
+      const NodeFirmwareConfig empty;
+      const NodeFirmwareConfig& shared_a = a->sharedFirmwareConfig ? *a->sharedFirmwareConfig : empty;
+      const NodeFirmwareConfig& shared_b = b->sharedFirmwareConfig ? *b->sharedFirmwareConfig : empty;
+      if (shared_a != shared_b) {
+        return shared_a < shared_b;
+      }
+    }
+    return a->firmwareConfig < b->firmwareConfig;
+  }
+};
+
+} // anonymous namespace
+
 NodeManager::NodeManager(boost::asio::io_context& io)
   : io_(io)
   , scheduler_(new Scheduler())
@@ -35,116 +77,645 @@ std::shared_ptr<VirtualNode> NodeManager::createNode(const NodeConfig& config) {
   }
   
   // Check for duplicate node ID
-  if (nodes_.count(config.nodeId) > 0) {
+  if (index_.find(config.nodeId).valid()) {
     throw std::runtime_error("Node ID already exists: " + std::to_string(config.nodeId));
   }
   
   // Enforce maximum node limit
-  if (nodes_.size() >= MAX_NODES) {
-    throw std::runtime_error("Maximum node count reached: " + std::to_string(MAX_NODES));
+  if (nodes_.size() >= max_nodes_) {
+    throw std::runtime_error("Maximum node count reached: " + std::to_string(max_nodes_));
+  }
+  
+  // In sharded mode the node joins the least loaded shard and gets a
+  // scheduler of its own, so that any worker can update it
+  size_t home = 0;
+  for (size_t i = 1; i < shards_.size(); ++i) {
+    if (shards_[i]->nodes.size() < shards_[home]->nodes.size()) {
+      home = i;
+    }
+  }
+  Shard* shard = shards_.empty() ? nullptr : shards_[home].get();
+  std::unique_ptr<NodeSlot> slot;
+  if (shard) {
+    slot.reset(new NodeSlot());
+    slot->shard = home;
+    shard->schedulers.emplace_back(new Scheduler());
+    slot->scheduler = shard->schedulers.back().get();
   }
   
   // Create the node
   auto node = std::make_shared<VirtualNode>(
     config.nodeId,
     config,
-    scheduler_.get(),
-    io_
+    shard ? slot->scheduler : scheduler_.get(),
+    shard ? *shard->io : io_
   );
+  node->setTransport(transport_);
+  node->setTopologyListener(listener_);
+  node->setProfiling(profiling_);
+  node->setUpdateTiming(monitor_ != nullptr);
+  node->setRandomSeed(seed_);
+  if (slot) {
+    slot->node = node;
+    bindMailboxes(*slot);
+  } else {
+    node->setWakeListener([this](uint32_t) { awake_dirty_ = true; });
+  }
   
   // Load firmware if specified
   if (!config.firmware.empty()) {
     if (!node->loadFirmware(config.firmware)) {
-      std::cerr << "[ERROR] Failed to load firmware for node " << config.nodeId << std::endl;
+      SIM_LOG_ERROR("[ERROR] Failed to load firmware for node {}", config.nodeId);
       // Continue without firmware rather than failing node creation
     }
   }
   
-  // Store in map
-  nodes_[config.nodeId] = node;
+  // Store the record and index it
+  if (slot) {
+    shard->nodes.push_back(slot.get());
+  }
+  NodeRecord record;
+  record.node = node;
+  record.slot = std::move(slot);
+  record.id = config.nodeId;
+  index_.insert(config.nodeId, nodes_.insert(std::move(record)));
+  awake_dirty_ = true;
   
   return node;
 }
 
+std::vector<std::shared_ptr<VirtualNode>> NodeManager::createNodes(
+    const std::vector<NodeConfig>& configs) {
+  // Check the whole batch before building anything
+  std::unordered_set<uint32_t> batch_ids;
+  batch_ids.reserve(configs.size());
+  for (const auto& config : configs) {
+    if (config.nodeId == 0) {
+      throw std::invalid_argument("Node ID must be non-zero");
+    }
+    if (index_.find(config.nodeId).valid() || !batch_ids.insert(config.nodeId).second) {
+      throw std::runtime_error("Node ID already exists: " + std::to_string(config.nodeId));
+    }
+  }
+  if (configs.size() > max_nodes_ - nodes_.size()) {
+    throw std::runtime_error("Maximum node count reached: " + std::to_string(max_nodes_));
+  }
+  
+  // Resolve each firmware name to its factory ID once; unknown firmware
+  // is reported once and its nodes run without firmware, as with
+  // createNode(). Nodes with equal configurations share one firmware
+  // configuration map.
+  const auto& factory = firmware::FirmwareFactory::instance();
+  std::unordered_map<std::string, firmware::FirmwareId> firmware_ids;
+  std::map<const NodeConfig*, std::shared_ptr<const NodeFirmwareConfig>, FirmwareConfigLess> interned;
+  std::vector<firmware::FirmwareId> node_firmware(configs.size(), firmware::FirmwareFactory::INVALID_ID);
+  std::vector<std::shared_ptr<const NodeFirmwareConfig>> node_configs(configs.size());
+  for (size_t i = 0; i < configs.size(); ++i) {
+    const std::string& name = configs[i].firmware;
+    if (name.empty()) {
+      continue;
+    }
+    auto it = firmware_ids.find(name);
+    if (it == firmware_ids.end()) {
+      it = firmware_ids.emplace(name, factory.findId(name)).first;
+      if (it->second == firmware::FirmwareFactory::INVALID_ID) {
+        SIM_LOG_ERROR("[ERROR] Unknown firmware: {} (nodes using it run without firmware)", name);
+      }
+    }
+    node_firmware[i] = it->second;
+    if (node_firmware[i] == firmware::FirmwareFactory::INVALID_ID) {
+      continue;
+    }
+    auto shared = interned.find(&configs[i]);
+    if (shared == interned.end()) {
+      shared = interned.emplace(&configs[i], VirtualNode::makeFirmwareConfig(configs[i])).first;
+    }
+    node_configs[i] = shared->second;
+  }
+  
+  // Hand out shards and schedulers in order, each node joining the least
+  // loaded shard as createNode() would
+  std::vector<std::unique_ptr<NodeSlot>> slots(configs.size());
+  std::vector<size_t> added(shards_.size(), 0);
+  if (!shards_.empty()) {
+    std::vector<size_t> load(shards_.size());
+    for (size_t s = 0; s < shards_.size(); ++s) {
+      load[s] = shards_[s]->nodes.size();
+    }
+    for (size_t i = 0; i < configs.size(); ++i) {
+      const size_t home = static_cast<size_t>(
+          std::min_element(load.begin(), load.end()) - load.begin());
+      load[home]++;
+      added[home]++;
+      slots[i].reset(new NodeSlot());
+      slots[i]->shard = home;
+      shards_[home]->schedulers.emplace_back(new Scheduler());
+      slots[i]->scheduler = shards_[home]->schedulers.back().get();
+    }
+  }
+  
+  // Build the nodes; each touches only its own slot and scheduler
+  std::vector<std::shared_ptr<VirtualNode>> nodes(configs.size());
+  auto build = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      NodeSlot* slot = slots[i].get();
+      auto node = std::make_shared<VirtualNode>(
+        configs[i].nodeId,
+        configs[i],
+        slot ? slot->scheduler : scheduler_.get(),
+        slot ? *shards_[slot->shard]->io : io_
+      );
+      node->setTransport(transport_);
+      node->setTopologyListener(listener_);
+      node->setProfiling(profiling_);
+      node->setUpdateTiming(monitor_ != nullptr);
+      node->setRandomSeed(seed_);
+      if (slot) {
+        slot->node = node;
+        bindMailboxes(*slot);
+      } else {
+        node->setWakeListener([this](uint32_t) { awake_dirty_ = true; });
+      }
+      if (node_firmware[i] != firmware::FirmwareFactory::INVALID_ID) {
+        node->setFirmwareConfig(node_configs[i]);
+        node->loadFirmware(factory.create(node_firmware[i]), false);
+      }
+      nodes[i] = std::move(node);
+    }
+  };
+  try {
+    if (pool_ && configs.size() > 1) {
+      const size_t parts = pool_->size();
+      const size_t count = configs.size();
+      pool_->run([&build, parts, count](size_t index) {
+        build(count * index / parts, count * (index + 1) / parts);
+      });
+    } else {
+      build(0, configs.size());
+    }
+  } catch (...) {
+    // Nodes hold their schedulers, so drop them first
+    nodes.clear();
+    slots.clear();
+    for (size_t s = 0; s < added.size(); ++s) {
+      auto& schedulers = shards_[s]->schedulers;
+      schedulers.resize(schedulers.size() - added[s]);
+    }
+    throw;
+  }
+  
+  // Register the batch
+  for (size_t i = 0; i < configs.size(); ++i) {
+    if (slots[i]) {
+      shards_[slots[i]->shard]->nodes.push_back(slots[i].get());
+    }
+    NodeRecord record;
+    record.node = nodes[i];
+    record.slot = std::move(slots[i]);
+    record.id = configs[i].nodeId;
+    index_.insert(configs[i].nodeId, nodes_.insert(std::move(record)));
+  }
+  awake_dirty_ = true;
+  
+  return nodes;
+}
+
+void NodeManager::setMaxNodes(size_t max_nodes) {
+  if (max_nodes == 0) {
+    throw std::invalid_argument("Maximum node count must be non-zero");
+  }
+  if (max_nodes < nodes_.size()) {
+    throw std::invalid_argument("Maximum node count " + std::to_string(max_nodes) +
+                                " is below the current node count " +
+                                std::to_string(nodes_.size()));
+  }
+  max_nodes_ = max_nodes;
+}
+
 bool NodeManager::removeNode(uint32_t nodeId) {
-  auto it = nodes_.find(nodeId);
-  if (it == nodes_.end()) {
+  const SlotHandle handle = index_.find(nodeId);
+  NodeRecord* record = nodes_.get(handle);
+  if (!record) {
     return false;
   }
   
   // Stop the node if it's running
-  if (it->second->isRunning()) {
-    it->second->stop();
+  if (record->node->isRunning()) {
+    record->node->stop();
+  }
+  
+  if (transport_) {
+    transport_->removeNode(nodeId);
   }
   
-  // Remove from map
-  nodes_.erase(it);
+  if (record->slot) {
+    auto& members = shards_[record->slot->shard]->nodes;
+    members.erase(std::find(members.begin(), members.end(), record->slot.get()));
+    record->node->setMailboxes(nullptr, nullptr);
+  }
+  
+  // Remove the record; the last record moves into its place
+  nodes_.erase(handle);
+  index_.erase(nodeId);
+  awake_dirty_ = true;
   
   return true;
 }
 
 void NodeManager::startAll() {
-  for (auto& pair : nodes_) {
-    if (!pair.second->isRunning()) {
-      pair.second->start();
+  for (auto& record : nodes_) {
+    if (!record.node->isRunning()) {
+      record.node->start();
     }
   }
 }
 
 void NodeManager::stopAll() {
-  for (auto& pair : nodes_) {
-    if (pair.second->isRunning()) {
-      pair.second->stop();
+  for (auto& record : nodes_) {
+    if (record.node->isRunning()) {
+      record.node->stop();
     }
   }
 }
 
 void NodeManager::updateAll() {
+  if (!shards_.empty()) {
+    // One tick at the time of the caller's last transport update
+    runShards(transport_ ? transport_->getCurrentTime() : 0, 0, 1);
+    return;
+  }
+  
   // Process scheduler tasks
-  scheduler_->execute();
+  {
+    SIM_TRACE_SCOPE("scheduler.execute");
+    scheduler_->execute();
+  }
   
-  // Update each node
-  for (auto& pair : nodes_) {
-    pair.second->update();
+  // Update each node that is due; nodes falling asleep join the heap
+  {
+    SIM_TRACE_SCOPE("nodes.update");
+    refreshAwakeNodes();
+    // Sends of all nodes are evaluated as one batch after the loop
+    if (transport_) {
+      transport_->beginBatch();
+    }
+    for (VirtualNode* node : awake_) {
+      if (monitor_) {
+        updateTimed(0, *node);
+      } else {
+        node->update();
+      }
+      if (node->isAsleep()) {
+        wake_heap_.emplace_back(node->getWakeTime(), node->getNodeId());
+        std::push_heap(wake_heap_.begin(), wake_heap_.end(),
+                       std::greater<std::pair<uint64_t, uint32_t>>());
+        awake_dirty_ = true;
+      }
+    }
+    if (transport_) {
+      transport_->flushBatch();
+    }
   }
   
   // Poll IO context to process network events
+  SIM_TRACE_SCOPE("io.poll");
+  SIM_ALLOC_SCOPE(AllocTag::ASIO);
   io_.poll();
 }
 
-void NodeManager::establishConnectivity() {
-  if (nodes_.empty()) {
+void NodeManager::refreshAwakeNodes() {
+  const uint64_t now = VirtualNode::wakeClockMs();
+  while (!wake_heap_.empty() && wake_heap_.front().first <= now) {
+    const uint32_t id = wake_heap_.front().second;
+    std::pop_heap(wake_heap_.begin(), wake_heap_.end(),
+                  std::greater<std::pair<uint64_t, uint32_t>>());
+    wake_heap_.pop_back();
+    
+    NodeRecord* record = findRecord(id);
+    if (record && record->node->isAsleep() && record->node->isDue(now)) {
+      record->node->wake();
+    }
+  }
+  
+  if (!awake_dirty_) {
     return;
   }
+  awake_.clear();
+  for (auto& record : nodes_) {
+    if (!record.node->isAsleep()) {
+      awake_.push_back(record.node.get());
+    }
+  }
+  awake_dirty_ = false;
+}
+
+size_t NodeManager::getSleepingNodeCount() const {
+  size_t sleeping = 0;
+  for (const auto& record : nodes_) {
+    if (record.node->isAsleep()) {
+      sleeping++;
+    }
+  }
+  return sleeping;
+}
+
+uint64_t NodeManager::getNextWakeTime() const {
+  uint64_t next = UINT64_MAX;
+  for (const auto& record : nodes_) {
+    const VirtualNode& node = *record.node;
+    if (!node.isRunning()) {
+      continue;
+    }
+    if (!node.isAsleep()) {
+      return 0;
+    }
+    next = std::min(next, node.getWakeTime());
+  }
+  return next;
+}
+
+void NodeManager::setShardCount(size_t count) {
+  if (count == 0 || count > MAX_SHARDS) {
+    throw std::invalid_argument("Shard count must be between 1 and " +
+                                std::to_string(MAX_SHARDS));
+  }
+  
+  if (!nodes_.empty()) {
+    throw std::runtime_error("Shard count must be set before nodes are created");
+  }
+  
+  shards_.clear();
+  pool_.reset();
+  for (size_t i = 0; i < count; ++i) {
+    std::unique_ptr<Shard> shard(new Shard());
+    shard->io.reset(new boost::asio::io_context());
+    shards_.push_back(std::move(shard));
+  }
+  pool_.reset(new WorkerPool(count));
+  if (monitor_) {
+    monitor_->setWorkerCount(shards_.size());
+  }
+}
+
+size_t NodeManager::getShardOf(uint32_t nodeId) const {
+  const NodeRecord* record = findRecord(nodeId);
+  if (!record) {
+    throw std::out_of_range("Unknown node ID: " + std::to_string(nodeId));
+  }
   
-  // Create a vector of node pointers for easier access
-  std::vector<std::shared_ptr<VirtualNode>> node_list;
-  node_list.reserve(nodes_.size());
-  for (auto& pair : nodes_) {
-    node_list.push_back(pair.second);
+  return record->slot ? record->slot->shard : 0;
+}
+
+uint64_t NodeManager::getStealCount() const {
+  uint64_t steals = 0;
+  for (const auto& shard : shards_) {
+    steals += shard->steals;
+  }
+  return steals;
+}
+
+void NodeManager::advanceWindow(uint64_t start_ms, uint32_t tick_ms, uint32_t ticks) {
+  if (shards_.empty()) {
+    throw std::runtime_error("Lookahead windows need a sharded NodeManager");
+  }
+  
+  // Frames sent inside the window arrive after it, so every delivery of
+  // the window is known before any node runs
+  if (transport_) {
+    for (uint32_t i = 0; i < ticks; ++i) {
+      transport_->update(start_ms + static_cast<uint64_t>(i) * tick_ms);
+    }
+  }
+  
+  runShards(start_ms, tick_ms, ticks);
+}
+
+uint32_t NodeManager::getLookaheadTicks(uint32_t tick_ms, uint32_t max_ticks) const {
+  if (max_ticks <= 1 || tick_ms == 0 || !transport_) {
+    return 1;
+  }
+  
+  const uint64_t latency = transport_->getMinLinkLatency();
+  
+  // Largest k with latency > (k - 1) * tick_ms
+  const uint64_t ticks = latency == 0 ? 1 : (latency + tick_ms - 1) / tick_ms;
+  return static_cast<uint32_t>(std::max<uint64_t>(1, std::min<uint64_t>(ticks, max_ticks)));
+}
+
+void NodeManager::runShards(uint64_t start_ms, uint32_t tick_ms, uint32_t ticks) {
+  for (auto& shard : shards_) {
+    shard->queue.reset(shard->nodes);
+  }
+  
+  pool_->run([this, start_ms, tick_ms, ticks](size_t index) {
+    SIM_TRACE_SCOPE_ARG("shard.update", "shard", index);
+    runWorker(index, start_ms, tick_ms, ticks);
+  });
+  
+  // IO handlers touch the nodes of their shard, which may just have run
+  // on another worker, so they get a phase of their own
+  pool_->run([this](size_t index) {
+    SIM_TRACE_SCOPE_ARG("shard.io_poll", "shard", index);
+    SIM_ALLOC_SCOPE(AllocTag::ASIO);
+    shards_[index]->io->poll();
+  });
+  
+  // Workers are parked again, so the transport is ours alone
+  {
+    SIM_TRACE_SCOPE("outboxes.flush");
+    flushOutboxes();
+  }
+  SIM_TRACE_SCOPE("io.poll");
+  SIM_ALLOC_SCOPE(AllocTag::ASIO);
+  io_.poll();
+}
+
+void NodeManager::runWorker(size_t index, uint64_t start_ms, uint32_t tick_ms,
+                            uint32_t ticks) {
+  Shard& home = *shards_[index];
+  NodeSlot* slot = nullptr;
+  while (home.queue.pop(slot) || stealNode(index, slot)) {
+    updateNode(index, *slot, start_ms, tick_ms, ticks);
+  }
+}
+
+bool NodeManager::stealNode(size_t index, NodeSlot*& slot) {
+  for (size_t offset = 1; offset < shards_.size(); ++offset) {
+    if (shards_[(index + offset) % shards_.size()]->queue.steal(slot)) {
+      shards_[index]->steals++;
+      return true;
+    }
+  }
+  return false;
+}
+
+void NodeManager::updateNode(size_t worker, NodeSlot& slot, uint64_t start_ms,
+                             uint32_t tick_ms, uint32_t ticks) {
+  slot.pending.clear();
+  slot.inbox.drain([&slot](IncomingMessage& message) {
+    slot.pending.push_back(std::move(message));
+  });
+  
+  size_t next = 0;
+  for (uint32_t i = 0; i < ticks; ++i) {
+    const uint64_t now = start_ms + static_cast<uint64_t>(i) * tick_ms;
+    const bool last = i + 1 == ticks;
+    
+    // Window ticks run ahead of the published time, so firmware time
+    // follows the tick; tasks run on the node's own clock
+    TickTimeScope tick_time(tick_ms > 0 ? now * 1000 : VirtualTime::baseUs());
+    NodeClockScope clock_scope(&slot.node->getClock());
+    
+    // Deliveries arrive in time order; the last tick takes any stragglers
+    while (next < slot.pending.size() && (last || slot.pending[next].time_ms <= now)) {
+      IncomingMessage& message = slot.pending[next++];
+      slot.outbox.beginDelivery(message.time_ms, message.sequence);
+      slot.node->deliver(message.from, message.msg);
+    }
+    
+    slot.outbox.beginUpdate(now);
+    {
+      SIM_TRACE_SCOPE_ARG("scheduler.execute", "node", slot.node->getNodeId());
+      slot.scheduler->execute();
+    }
+    if (slot.node->isDue(VirtualNode::wakeClockMs())) {
+      if (monitor_) {
+        updateTimed(worker, *slot.node);
+      } else {
+        slot.node->update();
+      }
+    }
+  }
+  slot.pending.clear();  // Drop payload references, keep capacity
+}
+
+void NodeManager::flushOutboxes() {
+  replay_.clear();
+  for (auto& record : nodes_) {
+    if (record.slot) {
+      record.slot->outbox.drain([this](OutgoingMessage& message) {
+        replay_.push_back(std::move(message));
+      });
+    }
+  }
+  
+  // Stable: equal keys only come from one node, whose sends stay in order
+  std::stable_sort(replay_.begin(), replay_.end());
+  
+  if (transport_) {
+    // One batch for the whole tick's sends
+    transport_->beginBatch();
+    for (const auto& message : replay_) {
+      if (!message.frame.empty()) {
+        transport_->sendBroadcastFrame(message.from, message.frame, message.time_ms);
+      } else if (message.dest == OutgoingMessage::BROADCAST) {
+        transport_->sendBroadcast(message.from, message.msg, message.time_ms);
+      } else {
+        transport_->sendSingle(message.from, message.dest, message.msg, message.time_ms);
+      }
+    }
+    transport_->flushBatch();
+  }
+  replay_.clear();
+}
+
+void NodeManager::updateTimed(size_t worker, VirtualNode& node) {
+  // Stopped nodes return from update() at once; they are not counted
+  const bool running = node.isRunning();
+  node.update();
+  if (running) {
+    monitor_->recordUpdate(worker, node.getNodeId(), *node.getUpdateTiming(),
+                           node.getFirmware());
+  }
+}
+
+void NodeManager::bindMailboxes(NodeSlot& slot) {
+  if (transport_) {
+    slot.node->setMailboxes(&slot.outbox, &slot.inbox);
+  } else {
+    slot.node->setMailboxes(nullptr, nullptr);
+  }
+}
+
+void NodeManager::setTransport(MeshTransport* transport) {
+  transport_ = transport;
+  for (auto& record : nodes_) {
+    record.node->setTransport(transport_);
+    if (record.slot) {
+      bindMailboxes(*record.slot);
+    }
+  }
+}
+
+void NodeManager::setTopologyListener(TopologyListener* listener) {
+  listener_ = listener;
+  for (auto& record : nodes_) {
+    record.node->setTopologyListener(listener_);
+  }
+}
+
+void NodeManager::setProfiling(bool enabled) {
+  profiling_ = enabled;
+  for (auto& record : nodes_) {
+    record.node->setProfiling(profiling_);
+  }
+}
+
+void NodeManager::setLoopMonitor(LoopMonitor* monitor) {
+  monitor_ = monitor;
+  if (monitor_) {
+    monitor_->setWorkerCount(std::max<size_t>(1, shards_.size()));
+  }
+  for (auto& record : nodes_) {
+    record.node->setUpdateTiming(monitor_ != nullptr);
+  }
+}
+
+void NodeManager::establishConnectivity() {
+  if (nodes_.empty()) {
+    return;
   }
   
   // Connect each node (starting from the second) to a random previous node
   // This creates a connected tree topology
-  for (size_t i = 1; i < node_list.size(); ++i) {
-    // Connect to a random node among the previously added nodes
-    size_t target_idx = std::rand() % i;
-    node_list[i]->connectTo(*node_list[target_idx]);
+  establishConnectivity(Topology::randomTree(nodes_.size(), seed_).getLinks(getNodeIds()));
+}
+
+size_t NodeManager::establishConnectivity(
+    const std::vector<std::pair<uint32_t, uint32_t>>& links) {
+  std::vector<std::pair<uint32_t, uint32_t>> local;
+  local.reserve(links.size());
+  for (const auto& link : links) {
+    if (hasNode(link.first) && hasNode(link.second)) {
+      local.push_back(link);
+    }
+  }
+  
+  if (transport_) {
+    return transport_->addLinks(local);
+  }
+  for (const auto& link : local) {
+    getNode(link.first)->connectTo(*getNode(link.second));
   }
+  return local.size();
 }
 
-std::shared_ptr<VirtualNode> NodeManager::getNode(uint32_t nodeId) {
-  auto it = nodes_.find(nodeId);
-  if (it != nodes_.end()) {
-    return it->second;
+void NodeManager::setSeed(uint32_t seed) {
+  seed_ = seed;
+  for (auto& record : nodes_) {
+    record.node->setRandomSeed(seed_);
   }
-  return nullptr;
+}
+
+std::shared_ptr<VirtualNode> NodeManager::getNode(uint32_t nodeId) {
+  NodeRecord* record = findRecord(nodeId);
+  return record ? record->node : nullptr;
 }
 
 std::shared_ptr<const VirtualNode> NodeManager::getNode(uint32_t nodeId) const {
-  auto it = nodes_.find(nodeId);
-  if (it != nodes_.end()) {
-    return it->second;
+  const NodeRecord* record = findRecord(nodeId);
+  if (record) {
+    return record->node;
   }
   return nullptr;
 }
@@ -153,8 +724,8 @@ std::vector<uint32_t> NodeManager::getNodeIds() const {
   std::vector<uint32_t> ids;
   ids.reserve(nodes_.size());
   
-  for (const auto& pair : nodes_) {
-    ids.push_back(pair.first);
+  for (const auto& record : nodes_) {
+    ids.push_back(record.id);
   }
   
   return ids;
@@ -164,15 +735,69 @@ std::vector<std::shared_ptr<VirtualNode>> NodeManager::getAllNodes() const {
   std::vector<std::shared_ptr<VirtualNode>> result;
   result.reserve(nodes_.size());
   
-  for (const auto& pair : nodes_) {
-    result.push_back(pair.second);
+  for (const auto& record : nodes_) {
+    result.push_back(record.node);
   }
   
   return result;
 }
 
 bool NodeManager::hasNode(uint32_t nodeId) const {
-  return nodes_.count(nodeId) > 0;
+  return index_.find(nodeId).valid();
+}
+
+NodeMemoryUsage NodeManager::getMemoryUsage(uint32_t nodeId) const {
+  const NodeRecord* record = findRecord(nodeId);
+  if (!record) {
+    throw std::out_of_range("Unknown node ID: " + std::to_string(nodeId));
+  }
+  
+  NodeMemoryUsage usage = record->node->getMemoryUsage();
+  usage.node += sizeof(NodeRecord);
+  if (record->slot) {
+    const NodeSlot& slot = *record->slot;
+    usage.buffers += sizeof(NodeSlot) + sizeof(Scheduler) +
+                     NODE_MAILBOX_CAPACITY * (sizeof(OutgoingMessage) + sizeof(IncomingMessage)) +
+                     slot.pending.capacity() * sizeof(IncomingMessage);
+  }
+  return usage;
+}
+
+NodeMemoryUsage NodeManager::getMemoryUsage() const {
+  NodeMemoryUsage usage;
+  for (const auto& record : nodes_) {
+    usage += getMemoryUsage(record.id);
+  }
+  return usage;
+}
+
+void NodeManager::saveState(CheckpointWriter& out) const {
+  out.beginSection(CHECKPOINT_NODES);
+  out.write<uint32_t>(static_cast<uint32_t>(nodes_.size()));
+  for (const auto& record : nodes_) {
+    out.write<uint32_t>(record.id);
+    record.node->saveState(out);
+  }
+}
+
+void NodeManager::loadState(CheckpointReader& in) {
+  in.expectSection(CHECKPOINT_NODES);
+  const uint32_t count = in.read<uint32_t>();
+  if (count != nodes_.size()) {
+    throw std::runtime_error("Checkpoint does not match this simulation: " +
+                             std::to_string(count) + " nodes saved, " +
+                             std::to_string(nodes_.size()) + " created");
+  }
+  
+  for (uint32_t i = 0; i < count; ++i) {
+    const uint32_t id = in.read<uint32_t>();
+    NodeRecord* record = findRecord(id);
+    if (!record) {
+      throw std::runtime_error("Checkpoint does not match this simulation: unknown node " +
+                               std::to_string(id));
+    }
+    record->node->loadState(in);
+  }
 }
 
 } // namespace simulator
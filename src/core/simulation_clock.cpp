@@ -0,0 +1,77 @@
+/**
+ * @file simulation_clock.cpp
+ * @brief Implementation of SimulationClock class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/simulation_clock.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+namespace simulator {
+
+constexpr uint64_t SimulationClock::DEFAULT_TICK_US;
+
+SimulationClock::SimulationClock(float time_scale)
+    : mode_(time_scale == TIME_SCALE_UNBOUNDED ? Mode::UNBOUNDED : Mode::REAL_TIME),
+      time_scale_(time_scale),
+      wall_start_(std::chrono::steady_clock::now()) {
+  if (time_scale < 0.0f) {
+    throw std::invalid_argument("Time scale cannot be negative");
+  }
+}
+
+void SimulationClock::start(uint64_t start_us) {
+  now_us_ = start_us;
+  start_us_ = start_us;
+  overruns_ = 0;
+  max_lag_us_ = 0;
+  wall_start_ = std::chrono::steady_clock::now();
+}
+
+void SimulationClock::advanceTo(uint64_t target_us) {
+  if (target_us <= now_us_) {
+    return;
+  }
+
+  now_us_ = target_us;
+
+  if (mode_ == Mode::UNBOUNDED) {
+    return;
+  }
+
+  // Sleep until the scaled wall clock reaches the new virtual time. Using an
+  // absolute deadline keeps pacing drift-free even when ticks overrun.
+  auto wall_offset = std::chrono::microseconds(
+    static_cast<int64_t>(static_cast<double>(target_us - start_us_) / time_scale_));
+  const auto deadline = wall_start_ + wall_offset;
+  const auto wall_now = std::chrono::steady_clock::now();
+  if (wall_now > deadline) {
+    const uint64_t lag_us = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(wall_now - deadline).count());
+    overruns_++;
+    max_lag_us_ = std::max(max_lag_us_, lag_us);
+    return;
+  }
+  std::this_thread::sleep_until(deadline);
+}
+
+uint64_t SimulationClock::wallElapsedUs() const {
+  auto elapsed = std::chrono::steady_clock::now() - wall_start_;
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+}
+
+double SimulationClock::getSpeedup() const {
+  uint64_t wall_us = wallElapsedUs();
+  if (wall_us == 0) {
+    return 0.0;
+  }
+  return static_cast<double>(now_us_ - start_us_) / static_cast<double>(wall_us);
+}
+
+} // namespace simulator
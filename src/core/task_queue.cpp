@@ -0,0 +1,130 @@
+/**
+ * @file task_queue.cpp
+ * @brief Implementation of TaskQueue
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/task_queue.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace simulator {
+
+constexpr int32_t TaskQueue::FOREVER;
+
+TaskId TaskQueue::schedule(uint64_t first_run_ms, uint32_t interval_ms, int32_t iterations,
+                           std::function<void()> callback) {
+  if (iterations == 0 || iterations < FOREVER) {
+    throw std::invalid_argument("Task iterations must be positive or FOREVER");
+  }
+  if (!callback) {
+    throw std::invalid_argument("Task callback cannot be empty");
+  }
+
+  Task task;
+  task.callback.reset(new std::function<void()>(std::move(callback)));
+  task.interval_ms = interval_ms;
+  task.remaining = iterations;
+  const TaskId id = tasks_.insert(std::move(task));
+  push(*tasks_.get(id), id, first_run_ms);
+  return id;
+}
+
+bool TaskQueue::cancel(TaskId id) {
+  Task* task = tasks_.get(id);
+  if (!task) {
+    return false;
+  }
+  if (id == running_) {
+    // The callback is on the stack; runDue() erases the task after it
+    if (running_cancelled_) {
+      return false;
+    }
+    running_cancelled_ = true;
+    task->sequence = 0;
+    return true;
+  }
+  tasks_.erase(id);
+  dropStale();
+  return true;
+}
+
+bool TaskQueue::contains(TaskId id) const {
+  const Task* task = tasks_.get(id);
+  return task && !(id == running_ && running_cancelled_);
+}
+
+size_t TaskQueue::runDue(uint64_t now_ms) {
+  size_t runs = 0;
+  while (!heap_.empty() && heap_.front().run_ms <= now_ms) {
+    std::pop_heap(heap_.begin(), heap_.end());
+    const Entry entry = heap_.back();
+    heap_.pop_back();
+
+    Task* task = tasks_.get(entry.id);
+    if (!task || task->sequence != entry.sequence) {
+      continue;
+    }
+
+    // The next run is queued before the callback, so the callback can
+    // cancel it; a periodic task never runs twice in one call
+    const bool last = task->remaining == 1;
+    if (!last) {
+      if (task->remaining > 0) {
+        task->remaining--;
+      }
+      push(*task, entry.id, std::max(entry.run_ms + task->interval_ms, now_ms + 1));
+    }
+
+    // Tasks live in a SlotMap that the callback may grow, but the
+    // function itself has a stable address
+    std::function<void()>* callback = task->callback.get();
+    running_ = entry.id;
+    running_cancelled_ = false;
+    try {
+      (*callback)();
+    } catch (...) {
+      finishRun(entry.id, last);
+      throw;
+    }
+    finishRun(entry.id, last);
+    runs++;
+  }
+  return runs;
+}
+
+void TaskQueue::finishRun(TaskId id, bool last) {
+  running_ = TaskId();
+  if (last || running_cancelled_) {
+    tasks_.erase(id);
+    dropStale();
+  }
+}
+
+void TaskQueue::clear() {
+  tasks_ = SlotMap<Task>();
+  heap_.clear();
+}
+
+void TaskQueue::push(Task& task, TaskId id, uint64_t run_ms) {
+  task.sequence = next_sequence_++;
+  heap_.push_back(Entry{run_ms, task.sequence, id});
+  std::push_heap(heap_.begin(), heap_.end());
+}
+
+void TaskQueue::dropStale() {
+  while (!heap_.empty()) {
+    const Task* task = tasks_.get(heap_.front().id);
+    if (task && task->sequence == heap_.front().sequence) {
+      return;
+    }
+    std::pop_heap(heap_.begin(), heap_.end());
+    heap_.pop_back();
+  }
+}
+
+} // namespace simulator
@@ -0,0 +1,243 @@
+/**
+ * @file topology.cpp
+ * @brief Implementation of the scenario topology generators
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/topology.hpp"
+#include "simulator/config_loader.hpp"
+#include "simulator/counter_rng.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace simulator {
+
+Topology Topology::fromEdges(size_t node_count, const std::vector<Edge>& edges) {
+  Topology topology;
+  topology.offsets_.assign(node_count + 1, 0);
+
+  // Counting sort of both directions of every link into rows
+  for (const Edge& edge : edges) {
+    if (edge.first >= node_count || edge.second >= node_count) {
+      throw std::out_of_range("Topology edge refers to an unknown node");
+    }
+    if (edge.first != edge.second) {
+      topology.offsets_[edge.first + 1]++;
+      topology.offsets_[edge.second + 1]++;
+    }
+  }
+  for (size_t i = 0; i < node_count; ++i) {
+    topology.offsets_[i + 1] += topology.offsets_[i];
+  }
+  topology.targets_.resize(topology.offsets_[node_count]);
+  std::vector<size_t> fill(topology.offsets_.begin(), topology.offsets_.end() - 1);
+  for (const Edge& edge : edges) {
+    if (edge.first != edge.second) {
+      topology.targets_[fill[edge.first]++] = edge.second;
+      topology.targets_[fill[edge.second]++] = edge.first;
+    }
+  }
+
+  // Sort each row and squeeze out duplicates in place
+  size_t out = 0;
+  for (size_t i = 0; i < node_count; ++i) {
+    auto begin = topology.targets_.begin() + topology.offsets_[i];
+    auto end = topology.targets_.begin() + topology.offsets_[i + 1];
+    std::sort(begin, end);
+    end = std::unique(begin, end);
+    topology.offsets_[i] = out;
+    out = std::move(begin, end, topology.targets_.begin() + out) - topology.targets_.begin();
+  }
+  topology.offsets_[node_count] = out;
+  topology.targets_.resize(out);
+  topology.targets_.shrink_to_fit();
+  return topology;
+}
+
+void Topology::appendTree(size_t node_count, uint32_t seed, std::vector<Edge>& edges) {
+  const uint64_t key = CounterRng::makeKey(seed, 0, 0, RNG_STREAM_TOPOLOGY);
+  for (size_t i = 1; i < node_count; ++i) {
+    CounterRng rng(key, i);
+    edges.emplace_back(static_cast<uint32_t>(i), static_cast<uint32_t>(rng() % i));
+  }
+}
+
+Topology Topology::randomTree(size_t node_count, uint32_t seed) {
+  std::vector<Edge> edges;
+  edges.reserve(node_count);
+  appendTree(node_count, seed, edges);
+  return fromEdges(node_count, edges);
+}
+
+Topology Topology::random(size_t node_count, float density, uint32_t seed) {
+  if (!(density >= 0.0f && density <= 1.0f)) {
+    throw std::invalid_argument("Topology density must be between 0.0 and 1.0");
+  }
+  if (density >= 1.0f) {
+    return mesh(node_count);
+  }
+
+  std::vector<Edge> edges;
+  const double pairs = 0.5 * static_cast<double>(node_count) * (node_count - 1);
+  edges.reserve(node_count + static_cast<size_t>(pairs * density * 1.1));
+  appendTree(node_count, seed, edges);
+
+  if (density > 0.0f) {
+    // Walk the pairs (v, w), w < v, in order, jumping over a geometric
+    // number of pairs between hits
+    const uint64_t key = CounterRng::makeKey(seed, 0, 1, RNG_STREAM_TOPOLOGY);
+    const double log_miss = std::log(1.0 - density);
+    uint64_t draw = 0;
+    uint64_t v = 1;
+    int64_t w = -1;
+    while (v < node_count) {
+      CounterRng rng(key, draw++);
+      const double r = rng() * (1.0 / 4294967296.0);
+      w += 1 + static_cast<int64_t>(std::floor(std::log(1.0 - r) / log_miss));
+      while (w >= static_cast<int64_t>(v) && v < node_count) {
+        w -= static_cast<int64_t>(v);
+        ++v;
+      }
+      if (v < node_count) {
+        edges.emplace_back(static_cast<uint32_t>(v), static_cast<uint32_t>(w));
+      }
+    }
+  }
+  return fromEdges(node_count, edges);
+}
+
+Topology Topology::star(size_t node_count, uint32_t hub) {
+  if (hub >= node_count) {
+    throw std::out_of_range("Star hub refers to an unknown node");
+  }
+  std::vector<Edge> edges;
+  edges.reserve(node_count);
+  for (size_t i = 0; i < node_count; ++i) {
+    edges.emplace_back(hub, static_cast<uint32_t>(i));  // Self-loop dropped
+  }
+  return fromEdges(node_count, edges);
+}
+
+Topology Topology::ring(size_t node_count) {
+  std::vector<Edge> edges;
+  edges.reserve(node_count);
+  for (size_t i = 0; i + 1 < node_count; ++i) {
+    edges.emplace_back(static_cast<uint32_t>(i), static_cast<uint32_t>(i + 1));
+  }
+  if (node_count > 2) {
+    edges.emplace_back(static_cast<uint32_t>(node_count - 1), 0);
+  }
+  return fromEdges(node_count, edges);
+}
+
+Topology Topology::mesh(size_t node_count) {
+  // Rows are known up front; no edge list needed
+  Topology topology;
+  topology.offsets_.resize(node_count + 1);
+  topology.targets_.reserve(node_count * (node_count - (node_count > 0)));
+  for (size_t i = 0; i < node_count; ++i) {
+    topology.offsets_[i] = topology.targets_.size();
+    for (size_t j = 0; j < node_count; ++j) {
+      if (j != i) {
+        topology.targets_.push_back(static_cast<uint32_t>(j));
+      }
+    }
+  }
+  topology.offsets_[node_count] = topology.targets_.size();
+  return topology;
+}
+
+Topology Topology::build(const TopologyConfig& config,
+                         const std::vector<NodeConfigExtended>& nodes, uint32_t seed) {
+  std::unordered_map<std::string, uint32_t> index;
+  index.reserve(nodes.size());
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    index.emplace(nodes[i].id, static_cast<uint32_t>(i));
+  }
+  auto lookup = [&index](const std::string& id) {
+    auto it = index.find(id);
+    if (it == index.end()) {
+      throw std::invalid_argument("Topology refers to unknown node: " + id);
+    }
+    return it->second;
+  };
+
+  switch (config.type) {
+    case TopologyType::RANDOM:
+      return random(nodes.size(), config.density, seed);
+    case TopologyType::STAR:
+      if (!config.hub) {
+        throw std::invalid_argument("Star topology needs a hub");
+      }
+      return star(nodes.size(), lookup(*config.hub));
+    case TopologyType::RING:
+      return ring(nodes.size());
+    case TopologyType::MESH:
+      return mesh(nodes.size());
+    case TopologyType::CUSTOM: {
+      std::vector<Edge> edges;
+      edges.reserve(config.connections.size());
+      for (const auto& connection : config.connections) {
+        edges.emplace_back(lookup(connection.first), lookup(connection.second));
+      }
+      return fromEdges(nodes.size(), edges);
+    }
+    case TopologyType::RADIO:
+      break;
+  }
+  throw std::invalid_argument("Radio topology is built from node positions");
+}
+
+bool Topology::hasEdge(uint32_t a, uint32_t b) const {
+  if (a >= getNodeCount() || b >= getNodeCount()) {
+    return false;
+  }
+  return std::binary_search(neighboursBegin(a), neighboursEnd(a), b);
+}
+
+bool Topology::isConnected() const {
+  const size_t n = getNodeCount();
+  if (n <= 1) {
+    return true;
+  }
+  std::vector<bool> seen(n, false);
+  std::vector<uint32_t> stack{0};
+  seen[0] = true;
+  size_t reached = 1;
+  while (!stack.empty()) {
+    const uint32_t node = stack.back();
+    stack.pop_back();
+    for (const uint32_t* it = neighboursBegin(node); it != neighboursEnd(node); ++it) {
+      if (!seen[*it]) {
+        seen[*it] = true;
+        ++reached;
+        stack.push_back(*it);
+      }
+    }
+  }
+  return reached == n;
+}
+
+std::vector<Topology::Edge> Topology::getLinks(const std::vector<uint32_t>& ids) const {
+  if (ids.size() != getNodeCount()) {
+    throw std::invalid_argument("Node ID list does not match the topology");
+  }
+  std::vector<Edge> links;
+  links.reserve(getEdgeCount());
+  for (uint32_t a = 0; a < getNodeCount(); ++a) {
+    for (const uint32_t* it = neighboursBegin(a); it != neighboursEnd(a); ++it) {
+      if (*it > a) {
+        links.emplace_back(ids[a], ids[*it]);
+      }
+    }
+  }
+  return links;
+}
+
+} // namespace simulator
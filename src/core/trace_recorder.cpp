@@ -0,0 +1,191 @@
+/**
+ * @file trace_recorder.cpp
+ * @brief Implementation of TraceRecorder class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/trace_recorder.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <stdexcept>
+
+namespace simulator {
+
+constexpr size_t TraceRecorder::DEFAULT_MAX_EVENTS;
+
+namespace {
+
+/**
+ * @brief The calling thread's buffer, valid for one recorder generation
+ */
+struct CachedBuffer {
+  const void* owner{nullptr};
+  uint64_t generation{0};
+  void* buffer{nullptr};
+};
+
+thread_local CachedBuffer cached_buffer;
+
+/// Generations are unique across recorders, so a cache entry of a
+/// destroyed recorder never matches a new one at the same address
+std::atomic<uint64_t> last_generation{0};
+
+// Writes a JSON string; names are identifiers, but quote anything odd
+void writeJsonString(std::ostream& out, const char* text) {
+  out << '"';
+  for (const char* c = text; *c; ++c) {
+    if (*c == '"' || *c == '\\') {
+      out << '\\' << *c;
+    } else if (static_cast<unsigned char>(*c) < 0x20) {
+      out << ' ';
+    } else {
+      out << *c;
+    }
+  }
+  out << '"';
+}
+
+// Writes nanoseconds as microseconds with three decimals
+void writeMicros(std::ostream& out, uint64_t ns) {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%" PRIu64 ".%03u", ns / 1000,
+                static_cast<unsigned>(ns % 1000));
+  out << buffer;
+}
+
+} // anonymous namespace
+
+TraceRecorder::TraceRecorder() = default;
+
+TraceRecorder& TraceRecorder::instance() {
+  static TraceRecorder recorder;
+  return recorder;
+}
+
+void TraceRecorder::start(size_t max_events) {
+  if (max_events == 0) {
+    throw std::invalid_argument("Trace buffers must hold at least one event");
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffers_.clear();
+    max_events_ = max_events;
+  }
+  generation_.store(last_generation.fetch_add(1, std::memory_order_relaxed) + 1,
+                    std::memory_order_relaxed);
+  epoch_ns_ = nowNs();
+  enabled_.store(true, std::memory_order_relaxed);
+}
+
+TraceRecorder::ThreadBuffer& TraceRecorder::local() {
+  const uint64_t generation = generation_.load(std::memory_order_relaxed);
+  if (cached_buffer.owner == this && cached_buffer.generation == generation) {
+    return *static_cast<ThreadBuffer*>(cached_buffer.buffer);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  const std::thread::id self = std::this_thread::get_id();
+  ThreadBuffer* buffer = nullptr;
+  for (auto& candidate : buffers_) {
+    if (candidate->thread == self) {
+      buffer = candidate.get();
+      break;
+    }
+  }
+  if (!buffer) {
+    std::unique_ptr<ThreadBuffer> created(new ThreadBuffer());
+    created->tid = static_cast<uint32_t>(buffers_.size() + 1);
+    created->thread = self;
+    created->events.reserve(std::min<size_t>(max_events_, 4096));
+    buffer = created.get();
+    buffers_.push_back(std::move(created));
+  }
+  cached_buffer.owner = this;
+  cached_buffer.generation = generation;
+  cached_buffer.buffer = buffer;
+  return *buffer;
+}
+
+void TraceRecorder::record(const char* name, uint64_t start_ns, uint64_t end_ns,
+                           const char* arg_name, uint64_t arg) {
+  ThreadBuffer& buffer = local();
+  if (buffer.events.size() >= max_events_) {
+    buffer.dropped++;
+    return;
+  }
+  TraceEvent event;
+  event.name = name;
+  event.arg_name = arg_name;
+  event.arg = arg;
+  event.start_ns = start_ns;
+  event.duration_ns = end_ns > start_ns ? end_ns - start_ns : 0;
+  buffer.events.push_back(event);
+}
+
+void TraceRecorder::setThreadName(const std::string& name) {
+  local().name = name;
+}
+
+size_t TraceRecorder::getEventCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t count = 0;
+  for (const auto& buffer : buffers_) {
+    count += buffer->events.size();
+  }
+  return count;
+}
+
+uint64_t TraceRecorder::getDroppedCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  uint64_t dropped = 0;
+  for (const auto& buffer : buffers_) {
+    dropped += buffer->dropped;
+  }
+  return dropped;
+}
+
+size_t TraceRecorder::getThreadCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return buffers_.size();
+}
+
+void TraceRecorder::writeChromeJson(std::ostream& out) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+  out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+         "\"args\":{\"name\":\"painlessMesh simulator\"}}";
+
+  for (const auto& buffer : buffers_) {
+    const std::string name = buffer->name.empty()
+      ? "thread " + std::to_string(buffer->tid) : buffer->name;
+    out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid
+        << ",\"args\":{\"name\":";
+    writeJsonString(out, name.c_str());
+    out << "}}";
+  }
+
+  for (const auto& buffer : buffers_) {
+    for (const TraceEvent& event : buffer->events) {
+      out << ",\n{\"name\":";
+      writeJsonString(out, event.name);
+      out << ",\"cat\":\"simulator\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid
+          << ",\"ts\":";
+      writeMicros(out, event.start_ns > epoch_ns_ ? event.start_ns - epoch_ns_ : 0);
+      out << ",\"dur\":";
+      writeMicros(out, event.duration_ns);
+      if (event.arg_name) {
+        out << ",\"args\":{";
+        writeJsonString(out, event.arg_name);
+        out << ':' << event.arg << '}';
+      }
+      out << '}';
+    }
+  }
+  out << "\n]}\n";
+}
+
+} // namespace simulator
@@ -15,11 +15,21 @@
 #include "Arduino.h"
 
 #include "simulator/virtual_node.hpp"
+#include "simulator/alloc_tracker.hpp"
+#include "simulator/checkpoint.hpp"
+#include "simulator/mesh_transport.hpp"
+#include "simulator/shard_mailbox.hpp"
+#include "simulator/topology_listener.hpp"
+#include "simulator/firmware_profiler.hpp"
 #include "simulator/firmware/firmware_base.hpp"
 #include "simulator/firmware/firmware_factory.hpp"
+#include "simulator/logger.hpp"
+#include "simulator/loop_monitor.hpp"
+#include "simulator/trace_recorder.hpp"
+#include "simulator/virtual_time.hpp"
 
+#include <algorithm>
 #include <stdexcept>
-#include <iostream>
 
 // Include painlessMesh headers
 #include <TaskSchedulerDeclarations.h>
@@ -46,6 +56,13 @@ public:
       : io_service(io) {
     this->nodeId = id;
     this->init(scheduler, this->nodeId);
+  }
+
+  // Opens the TCP server on first use; in-process nodes never need one
+  void listen() {
+    if (pServer) {
+      return;
+    }
     pServer = std::make_shared<AsyncServer>(io_service, this->nodeId);
     painlessmesh::tcp::initServer<painlessmesh::Connection, PMesh>(*pServer, (*this));
   }
@@ -93,11 +110,10 @@ VirtualNode::VirtualNode(uint32_t nodeId,
   metrics_.bytes_sent = 0;
   metrics_.bytes_received = 0;
   
-  // Create mesh instance
-  try {
-    mesh_ = std::make_unique<MeshTest>(scheduler_, node_id_, io_);
-  } catch (const std::exception& e) {
-    throw std::runtime_error(std::string("Failed to create mesh instance: ") + e.what());
+  // Create mesh instance, unless the first start() does or the node
+  // has none
+  if (!config_.lazy && !config_.fluid) {
+    materialize();
   }
 }
 
@@ -111,27 +127,66 @@ void VirtualNode::start() {
   if (running_) {
     throw std::runtime_error("Node is already running");
   }
-  
-  if (!mesh_) {
-    throw std::runtime_error("Mesh instance not initialized");
+  SIM_ALLOC_SCOPE(AllocTag::MESH);
+  
+  if (config_.fluid) {
+    if (!transport_) {
+      throw std::runtime_error("Fluid nodes need an in-process transport");
+    }
+  } else if (!mesh_) {
+    materialize();
   }
+  NodeClockScope clock_scope(&config_.clock);
   
   // Record start time
   metrics_.start_time = std::chrono::steady_clock::now();
+  wake();
   
   // Set up mesh callbacks (will route to firmware if loaded)
-  routeCallbacksToFirmware();
+  if (mesh_) {
+    routeCallbacksToFirmware();
+  }
   
   // Setup firmware after mesh initialized
   setupFirmware();
   
+  // Attach to the in-process transport, if used; otherwise accept TCP
+  // connections from other nodes
+  if (!transport_) {
+    mesh_->listen();
+  } else {
+    MeshTransport::Endpoint endpoint;
+    if (inbox_) {
+      // Deliveries run on the worker thread that owns this node. The
+      // delivery count gives a global order independent of sharding.
+      endpoint.onReceive = [this](uint32_t from, const Payload& msg) {
+        inbox_->post({from, node_id_, msg, transport_->getCurrentTime(),
+                      transport_->getStats().frames_delivered});
+      };
+    } else {
+      endpoint.onReceive = [this](uint32_t from, const Payload& msg) {
+        this->onReceive(from, msg);
+      };
+    }
+    endpoint.onNewConnection = [this](uint32_t nodeId) {
+      this->onNewConnection(nodeId);
+    };
+    endpoint.onChangedConnections = [this]() {
+      this->onChangedConnections();
+    };
+    transport_->attach(node_id_, endpoint);
+  }
+  
   running_ = true;
+  if (listener_) {
+    listener_->nodeChanged(node_id_, NodeTransition::START);
+  }
   
-  std::cout << "[INFO] Node " << node_id_ << " started";
   if (firmware_) {
-    std::cout << " with firmware: " << firmware_->getName();
+    SIM_LOG_INFO("[INFO] Node {} started with firmware: {}", node_id_, firmware_->getName());
+  } else {
+    SIM_LOG_INFO("[INFO] Node {} started", node_id_);
   }
-  std::cout << std::endl;
 }
 
 void VirtualNode::stop() {
@@ -145,11 +200,19 @@ void VirtualNode::stop() {
     now - metrics_.start_time).count();
   metrics_.total_uptime_ms += uptime;
   
+  if (transport_) {
+    transport_->detach(node_id_);
+  }
+  
   if (mesh_) {
     mesh_->stop();
   }
   
   running_ = false;
+  hibernate();
+  if (listener_) {
+    listener_->nodeChanged(node_id_, NodeTransition::STOP);
+  }
 }
 
 void VirtualNode::crash() {
@@ -166,11 +229,45 @@ void VirtualNode::crash() {
   
   // Abrupt stop - no cleanup, simulating power failure
   // We still call mesh_->stop() but this represents an ungraceful shutdown
+  if (transport_) {
+    transport_->detach(node_id_);
+  }
+  
   if (mesh_) {
     mesh_->stop();
   }
   
   running_ = false;
+  hibernate();
+  if (listener_) {
+    listener_->nodeChanged(node_id_, NodeTransition::CRASH);
+  }
+}
+
+void VirtualNode::materialize() {
+  NodeClockScope clock_scope(&config_.clock);
+  try {
+    mesh_ = std::make_unique<MeshTest>(scheduler_, node_id_, io_);
+  } catch (const std::exception& e) {
+    throw std::runtime_error(std::string("Failed to create mesh instance: ") + e.what());
+  }
+  
+  // Firmware set up before a hibernation keeps its state and carries on
+  // with the new mesh
+  if (firmware_ && firmware_initialized_) {
+    firmware_->initialize(mesh_.get(), scheduler_, node_id_, getFirmwareConfig());
+  }
+}
+
+void VirtualNode::hibernate() {
+  if (!config_.lazy || running_ || !mesh_) {
+    return;
+  }
+  
+  if (firmware_ && firmware_initialized_) {
+    firmware_->initialize(nullptr, scheduler_, node_id_, getFirmwareConfig());
+  }
+  mesh_.reset();
 }
 
 void VirtualNode::restart() {
@@ -184,17 +281,47 @@ void VirtualNode::update() {
     return;
   }
   
+  asleep_ = false;
+  NodeClockScope clock_scope(&config_.clock);
+  if (timing_) {
+    *timing_ = UpdateTiming();
+  }
   if (mesh_) {
+    SIM_TRACE_SCOPE_ARG("mesh.update", "node", node_id_);
+    UpdatePhaseScope phase(timing_ ? &timing_->mesh_ns : nullptr);
+    SIM_ALLOC_SCOPE(AllocTag::MESH);
+    ProfileScope scope(profile_.get(), ProfiledCall::MESH_UPDATE);
     mesh_->update();
   }
   
-  // Call firmware loop
+  // Run the firmware tasks that are due, then its loop, which may ask to
+  // skip the next updates; the sleep ends early for the next task
   if (firmware_ && firmware_initialized_) {
-    firmware_->loop();
+    if (!tasks_.empty()) {
+      const uint64_t now_ms = VirtualTime::millis();
+      if (tasks_.getNextRunMs() <= now_ms) {
+        SIM_TRACE_SCOPE_ARG("firmware.tasks", "node", node_id_);
+        UpdatePhaseScope phase(timing_ ? &timing_->tasks_ns : nullptr);
+        SIM_ALLOC_SCOPE(AllocTag::FIRMWARE);
+        ProfileScope scope(profile_.get(), ProfiledCall::TASKS);
+        tasks_.runDue(now_ms);
+      }
+    }
+    
+    {
+      SIM_TRACE_SCOPE_ARG("firmware.loop", "node", node_id_);
+      UpdatePhaseScope phase(timing_ ? &timing_->loop_ns : nullptr);
+      SIM_ALLOC_SCOPE(AllocTag::FIRMWARE);
+      ProfileScope scope(profile_.get(), ProfiledCall::LOOP);
+      firmware_->loop();
+    }
+    
+    uint32_t sleep_ms = 0;
+    if (firmware_->takeSleepRequest(sleep_ms)) {
+      asleep_ = true;
+      wake_at_ms_ = std::min(wakeClockMs() + sleep_ms, getNextTaskTime());
+    }
   }
-  
-  // Poll IO context to process network events
-  io_.poll();
 }
 
 painlessmesh::Mesh<painlessmesh::Connection>& VirtualNode::getMesh() {
@@ -220,6 +347,13 @@ void VirtualNode::setNetworkQuality(float quality) {
 }
 
 void VirtualNode::connectTo(VirtualNode& other) {
+  // In-process link when both nodes share a transport (needs no mesh
+  // instance, so lazy nodes can be linked before they start)
+  if (transport_ && transport_ == other.transport_) {
+    transport_->addLink(node_id_, other.node_id_);
+    return;
+  }
+  
   if (!mesh_) {
     throw std::runtime_error("Mesh instance not initialized");
   }
@@ -229,17 +363,52 @@ void VirtualNode::connectTo(VirtualNode& other) {
   }
   
   // Connect this node to the other node
+  SIM_ALLOC_SCOPE(AllocTag::MESH);
+  other.mesh_->listen();
   mesh_->connect(*other.mesh_);
 }
 
+void VirtualNode::setTransport(MeshTransport* transport) {
+  if (running_) {
+    throw std::runtime_error("Cannot change transport while node is running");
+  }
+  
+  transport_ = transport;
+  if (firmware_) {
+    firmware_->setTransport(transport_);
+  }
+}
+
+void VirtualNode::setMailboxes(Outbox* outbox, Mailbox<IncomingMessage>* inbox) {
+  if (running_) {
+    throw std::runtime_error("Cannot change mailboxes while node is running");
+  }
+  
+  outbox_ = outbox;
+  inbox_ = inbox;
+  if (firmware_) {
+    firmware_->setOutbox(outbox_);
+  }
+}
+
+void VirtualNode::deliver(uint32_t from, const Payload& msg) {
+  if (running_) {
+    onReceive(from, msg);
+  }
+}
+
 void VirtualNode::onReceive(uint32_t from, std::string& msg) {
+  NodeClockScope clock_scope(&config_.clock);
+  wake();
   metrics_.messages_received++;
   metrics_.bytes_received += msg.size();
   
-  // Route to firmware if loaded
+  // Route to firmware if loaded (String is std::string, no copy needed;
+  // firmware using onReceiveView() gets a view of it)
   if (firmware_ && firmware_initialized_) {
-    String msgStr(msg.c_str());
-    firmware_->onReceive(from, msgStr);
+    ProfileScope scope(profile_.get(), ProfiledCall::RECEIVE);
+    SIM_ALLOC_SCOPE(AllocTag::FIRMWARE);
+    firmware_->onReceive(from, msg);
   }
   
   // Optional: Log received message for debugging
@@ -247,9 +416,29 @@ void VirtualNode::onReceive(uint32_t from, std::string& msg) {
   //           << " (" << msg.size() << " bytes)" << std::endl;
 }
 
+void VirtualNode::onReceive(uint32_t from, const Payload& msg) {
+  NodeClockScope clock_scope(&config_.clock);
+  wake();
+  metrics_.messages_received++;
+  metrics_.bytes_received += msg.size();
+  
+  // Firmware using onReceiveView() reads the shared payload in place;
+  // other firmware gets a String copy from FirmwareBase
+  if (firmware_ && firmware_initialized_) {
+    ProfileScope scope(profile_.get(), ProfiledCall::RECEIVE);
+    SIM_ALLOC_SCOPE(AllocTag::FIRMWARE);
+    firmware_->onReceiveView(from, StringView(msg.data(), msg.size()));
+  }
+}
+
 void VirtualNode::onNewConnection(uint32_t nodeId) {
+  NodeClockScope clock_scope(&config_.clock);
+  wake();
+  
   // Route to firmware if loaded
   if (firmware_ && firmware_initialized_) {
+    ProfileScope scope(profile_.get(), ProfiledCall::NEW_CONNECTION);
+    SIM_ALLOC_SCOPE(AllocTag::FIRMWARE);
     firmware_->onNewConnection(nodeId);
   }
   
@@ -258,8 +447,13 @@ void VirtualNode::onNewConnection(uint32_t nodeId) {
 }
 
 void VirtualNode::onChangedConnections() {
+  NodeClockScope clock_scope(&config_.clock);
+  wake();
+  
   // Route to firmware if loaded
   if (firmware_ && firmware_initialized_) {
+    ProfileScope scope(profile_.get(), ProfiledCall::CHANGED_CONNECTIONS);
+    SIM_ALLOC_SCOPE(AllocTag::FIRMWARE);
     firmware_->onChangedConnections();
   }
   
@@ -267,6 +461,30 @@ void VirtualNode::onChangedConnections() {
   // std::cout << "Node " << node_id_ << " topology changed" << std::endl;
 }
 
+void VirtualNode::wake() {
+  if (!asleep_) {
+    return;
+  }
+  
+  asleep_ = false;
+  if (wake_listener_) {
+    wake_listener_(node_id_);
+  }
+}
+
+uint64_t VirtualNode::getNextTaskTime() const {
+  const uint64_t next_ms = tasks_.getNextRunMs();
+  if (next_ms == UINT64_MAX) {
+    return UINT64_MAX;
+  }
+  // First base millisecond at which the node's clock reaches the task
+  return (config_.clock.toBaseUs(next_ms * 1000) + 999) / 1000;
+}
+
+uint64_t VirtualNode::wakeClockMs() {
+  return VirtualTime::baseMs();
+}
+
 uint64_t VirtualNode::getUptime() const {
   if (!running_) {
     return 0;
@@ -278,28 +496,152 @@ uint64_t VirtualNode::getUptime() const {
   return static_cast<uint64_t>(uptime);
 }
 
+void VirtualNode::saveState(CheckpointWriter& out) const {
+  out.write<uint8_t>(running_ ? 1 : 0);
+  out.write<uint32_t>(metrics_.messages_sent);
+  out.write<uint32_t>(metrics_.messages_received);
+  out.write<uint64_t>(metrics_.bytes_sent);
+  out.write<uint64_t>(metrics_.bytes_received);
+  out.write<uint32_t>(metrics_.crash_count);
+  out.write<uint64_t>(metrics_.total_uptime_ms);
+  out.write<uint32_t>(partition_id_);
+  out.write<float>(network_quality_);
+  
+  // Length-prefixed, so a node restored without firmware can skip it
+  CheckpointWriter firmware_state;
+  if (firmware_) {
+    firmware_->saveCheckpoint(firmware_state);
+  }
+  const std::vector<uint8_t>& bytes = firmware_state.data();
+  out.write<uint32_t>(static_cast<uint32_t>(bytes.size()));
+  out.writeBytes(bytes.data(), bytes.size());
+}
+
+void VirtualNode::loadState(CheckpointReader& in) {
+  const bool running = in.read<uint8_t>() != 0;
+  if (running && !running_) {
+    start();
+  } else if (!running && running_) {
+    stop();
+  }
+  
+  metrics_.messages_sent = in.read<uint32_t>();
+  metrics_.messages_received = in.read<uint32_t>();
+  metrics_.bytes_sent = in.read<uint64_t>();
+  metrics_.bytes_received = in.read<uint64_t>();
+  metrics_.crash_count = in.read<uint32_t>();
+  metrics_.total_uptime_ms = in.read<uint64_t>();
+  partition_id_ = in.read<uint32_t>();
+  network_quality_ = in.read<float>();
+  
+  std::vector<uint8_t> bytes(in.read<uint32_t>());
+  in.readBytes(bytes.data(), bytes.size());
+  if (firmware_ && !bytes.empty()) {
+    CheckpointReader firmware_state(bytes);
+    firmware_->loadCheckpoint(firmware_state);
+  }
+}
+
+NodeMemoryUsage VirtualNode::getMemoryUsage() const {
+  NodeMemoryUsage usage;
+  usage.node = sizeof(VirtualNode) + config_.meshPrefix.capacity() +
+               config_.meshPassword.capacity() + config_.firmware.capacity();
+  for (const auto& pair : config_.firmwareConfig) {
+    usage.node += sizeof(pair) + pair.first.capacity() + pair.second.capacity();
+  }
+
+  if (mesh_) {
+    usage.mesh = sizeof(MeshTest) + (mesh_->pServer ? sizeof(AsyncServer) : 0);
+    usage.connections = mesh_->subs.size() *
+                        (sizeof(painlessmesh::Connection) + sizeof(AsyncClient));
+  }
+
+  if (firmware_) {
+    usage.firmware = firmware_->getMemoryUsage();
+  }
+  return usage;
+}
+
 bool VirtualNode::loadFirmware(const std::string& firmwareName) {
   if (firmwareName.empty()) {
     return true;  // No firmware is valid (Phase 1 behavior)
   }
+  SIM_ALLOC_SCOPE(AllocTag::FIRMWARE);
   
   firmware_ = firmware::FirmwareFactory::instance().create(firmwareName);
   if (!firmware_) {
-    std::cerr << "[ERROR] Failed to load firmware: " << firmwareName 
-              << " for node " << node_id_ << std::endl;
+    SIM_LOG_ERROR("[ERROR] Failed to load firmware: {} for node {}", firmwareName, node_id_);
     return false;
   }
+  firmware_->setTransport(transport_);
+  firmware_->setOutbox(outbox_);
+  firmware_->setTaskQueue(&tasks_);
+  firmware_->setWakeHandler([this]() { wake(); });
+  firmware_->setRandomSeed(random_seed_);
   
-  std::cout << "[INFO] Loaded firmware '" << firmware_->getName() 
-            << "' for node " << node_id_ << std::endl;
+  SIM_LOG_INFO("[INFO] Loaded firmware '{}' for node {}", firmware_->getName(), node_id_);
   return true;
 }
 
-void VirtualNode::loadFirmware(std::unique_ptr<firmware::FirmwareBase> firmware) {
+void VirtualNode::loadFirmware(std::unique_ptr<firmware::FirmwareBase> firmware, bool announce) {
+  SIM_ALLOC_SCOPE(AllocTag::FIRMWARE);
   firmware_ = std::move(firmware);
   if (firmware_) {
-    std::cout << "[INFO] Loaded firmware '" << firmware_->getName() 
-              << "' for node " << node_id_ << std::endl;
+    firmware_->setTransport(transport_);
+    firmware_->setOutbox(outbox_);
+    firmware_->setTaskQueue(&tasks_);
+    firmware_->setWakeHandler([this]() { wake(); });
+    firmware_->setRandomSeed(random_seed_);
+    if (announce) {
+      SIM_LOG_INFO("[INFO] Loaded firmware '{}' for node {}", firmware_->getName(), node_id_);
+    }
+  }
+}
+
+void VirtualNode::setRandomSeed(uint32_t seed) {
+  random_seed_ = seed;
+  if (firmware_) {
+    firmware_->setRandomSeed(random_seed_);
+  }
+}
+
+std::shared_ptr<const NodeFirmwareConfig> VirtualNode::makeFirmwareConfig(const NodeConfig& config) {
+  NodeFirmwareConfig values;
+  values["mesh_prefix"] = config.meshPrefix;
+  values["mesh_password"] = config.meshPassword;
+  
+  // Custom firmware config may override the mesh credentials
+  if (config.sharedFirmwareConfig) {
+    for (const auto& pair : *config.sharedFirmwareConfig) {
+      values[pair.first] = pair.second;
+    }
+  }
+  for (const auto& pair : config.firmwareConfig) {
+    values[pair.first] = pair.second;
+  }
+  return std::make_shared<const NodeFirmwareConfig>(std::move(values));
+}
+
+const std::shared_ptr<const NodeFirmwareConfig>& VirtualNode::getFirmwareConfig() {
+  if (!firmware_config_) {
+    firmware_config_ = makeFirmwareConfig(config_);
+  }
+  return firmware_config_;
+}
+
+void VirtualNode::setProfiling(bool enabled) {
+  if (!enabled) {
+    profile_.reset();
+  } else if (!profile_) {
+    profile_.reset(new CallProfile());
+  }
+}
+
+void VirtualNode::setUpdateTiming(bool enabled) {
+  if (!enabled) {
+    timing_.reset();
+  } else if (!timing_) {
+    timing_.reset(new UpdateTiming());
   }
 }
 
@@ -315,26 +657,19 @@ void VirtualNode::setupFirmware() {
   if (!firmware_ || firmware_initialized_) {
     return;
   }
-  
-  // Convert config to map
-  std::map<String, String> configMap;
-  configMap[String("mesh_prefix")] = String(config_.meshPrefix.c_str());
-  configMap[String("mesh_password")] = String(config_.meshPassword.c_str());
-  
-  // Add custom firmware config
-  for (const auto& pair : config_.firmwareConfig) {
-    configMap[String(pair.first.c_str())] = String(pair.second.c_str());
-  }
+  SIM_ALLOC_SCOPE(AllocTag::FIRMWARE);
   
   // Initialize firmware
-  firmware_->initialize(mesh_.get(), scheduler_, node_id_, configMap);
+  firmware_->initialize(mesh_.get(), scheduler_, node_id_, getFirmwareConfig());
   
   // Call firmware setup
-  firmware_->setup();
+  {
+    ProfileScope scope(profile_.get(), ProfiledCall::SETUP);
+    firmware_->setup();
+  }
   firmware_initialized_ = true;
   
-  std::cout << "[INFO] Firmware '" << firmware_->getName() 
-            << "' initialized for node " << node_id_ << std::endl;
+  SIM_LOG_INFO("[INFO] Firmware '{}' initialized for node {}", firmware_->getName(), node_id_);
 }
 
 void VirtualNode::routeCallbacksToFirmware() {
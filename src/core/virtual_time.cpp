@@ -0,0 +1,118 @@
+/**
+ * @file virtual_time.cpp
+ * @brief Implementation of VirtualTime and node clocks
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/virtual_time.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace simulator {
+
+namespace {
+
+std::atomic<bool> virtual_enabled{false};
+std::atomic<uint64_t> virtual_now_us{0};
+
+// Wall time base starts with the process, like a board's uptime
+const std::chrono::steady_clock::time_point wall_start = std::chrono::steady_clock::now();
+
+thread_local const NodeClock* current_clock = nullptr;
+
+// Time pinned by TickTimeScope (NO_TICK_TIME = follow virtual_now_us)
+constexpr uint64_t NO_TICK_TIME = UINT64_MAX;
+thread_local uint64_t tick_now_us = NO_TICK_TIME;
+
+} // anonymous namespace
+
+uint64_t NodeClock::toLocalUs(uint64_t base_us) const {
+  if (isExact()) {
+    return base_us;
+  }
+  const double drift_us = static_cast<double>(base_us) * drift_ppm / 1e6;
+  const int64_t local = static_cast<int64_t>(base_us) + offset_us +
+                        static_cast<int64_t>(std::llround(drift_us));
+  return local > 0 ? static_cast<uint64_t>(local) : 0;
+}
+
+uint64_t NodeClock::toBaseUs(uint64_t local_us) const {
+  if (isExact()) {
+    return local_us;
+  }
+  const double base = (static_cast<double>(local_us) - static_cast<double>(offset_us)) /
+                      (1.0 + drift_ppm / 1e6);
+  if (base <= 0.0) {
+    return 0;
+  }
+  // Drift rounding may land a microsecond off either way
+  uint64_t base_us = static_cast<uint64_t>(std::ceil(base));
+  while (toLocalUs(base_us) < local_us) {
+    base_us++;
+  }
+  while (base_us > 0 && toLocalUs(base_us - 1) >= local_us) {
+    base_us--;
+  }
+  return base_us;
+}
+
+void VirtualTime::useVirtualClock(bool enabled) {
+  virtual_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool VirtualTime::isVirtual() {
+  return virtual_enabled.load(std::memory_order_relaxed);
+}
+
+void VirtualTime::setNowUs(uint64_t now_us) {
+  virtual_now_us.store(now_us, std::memory_order_relaxed);
+}
+
+uint64_t VirtualTime::baseUs() {
+  if (isVirtual()) {
+    return tick_now_us != NO_TICK_TIME ? tick_now_us
+                                       : virtual_now_us.load(std::memory_order_relaxed);
+  }
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now() - wall_start).count());
+}
+
+uint64_t VirtualTime::micros() {
+  const uint64_t base = baseUs();
+  return current_clock ? current_clock->toLocalUs(base) : base;
+}
+
+void VirtualTime::delay(uint32_t ms) {
+  if (!isVirtual() && ms > 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+  }
+}
+
+const NodeClock* VirtualTime::current() {
+  return current_clock;
+}
+
+NodeClockScope::NodeClockScope(const NodeClock* clock)
+  : previous_(current_clock) {
+  current_clock = clock;
+}
+
+NodeClockScope::~NodeClockScope() {
+  current_clock = previous_;
+}
+
+TickTimeScope::TickTimeScope(uint64_t now_us)
+  : previous_(tick_now_us) {
+  tick_now_us = now_us;
+}
+
+TickTimeScope::~TickTimeScope() {
+  tick_now_us = previous_;
+}
+
+} // namespace simulator
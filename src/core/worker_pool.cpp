@@ -0,0 +1,101 @@
+/**
+ * @file worker_pool.cpp
+ * @brief Implementation of WorkerPool class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/worker_pool.hpp"
+
+#include <stdexcept>
+
+namespace simulator {
+
+WorkerPool::WorkerPool(size_t size) {
+  if (size == 0) {
+    throw std::invalid_argument("Worker pool size must be at least 1");
+  }
+
+  threads_.reserve(size - 1);
+  for (size_t index = 1; index < size; ++index) {
+    threads_.emplace_back(&WorkerPool::workerLoop, this, index);
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  start_cv_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+void WorkerPool::run(const Job& job) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    job_ = &job;
+    pending_ = threads_.size();
+    error_ = nullptr;
+    generation_++;
+  }
+  start_cv_.notify_all();
+
+  // The calling thread takes index 0 instead of idling
+  runIndex(job, 0);
+
+  std::exception_ptr error;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this]() { return pending_ == 0; });
+    job_ = nullptr;
+    error = error_;
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void WorkerPool::workerLoop(size_t index) {
+  uint64_t seen = 0;
+  for (;;) {
+    const Job* job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      start_cv_.wait(lock, [this, seen]() { return stopping_ || generation_ != seen; });
+      if (stopping_) {
+        return;
+      }
+      seen = generation_;
+      job = job_;
+    }
+
+    runIndex(*job, index);
+
+    bool last;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      last = --pending_ == 0;
+    }
+    if (last) {
+      done_cv_.notify_one();
+    }
+  }
+}
+
+void WorkerPool::runIndex(const Job& job, size_t index) {
+  try {
+    job(index);
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!error_) {
+      error_ = std::current_exception();
+    }
+  }
+}
+
+} // namespace simulator
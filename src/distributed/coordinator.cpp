@@ -0,0 +1,136 @@
+/**
+ * @file coordinator.cpp
+ * @brief Implementation of Coordinator class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/distributed.hpp"
+#include "simulator/frame_batch.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace simulator {
+
+Coordinator::Coordinator(boost::asio::io_context& io, uint16_t port, uint32_t workers)
+  : acceptor_(io), worker_count_(workers) {
+  if (workers == 0) {
+    throw std::invalid_argument("Coordinator needs at least one worker");
+  }
+
+  boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::tcp::v4(), port);
+  acceptor_.open(endpoint.protocol());
+  acceptor_.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+  acceptor_.bind(endpoint);
+  acceptor_.listen();
+}
+
+uint16_t Coordinator::getPort() const {
+  return acceptor_.local_endpoint().port();
+}
+
+void Coordinator::acceptWorkers() {
+  channels_.clear();
+  channels_.resize(worker_count_);
+  pending_.assign(worker_count_, std::vector<DelayedMessage>());
+  node_ranks_.clear();
+
+  std::string body;
+  for (uint32_t i = 0; i < worker_count_; ++i) {
+    boost::asio::ip::tcp::socket socket(acceptor_.get_executor());
+    acceptor_.accept(socket);
+    std::unique_ptr<FrameChannel> channel(new FrameChannel(std::move(socket)));
+
+    channel->expect(ChannelMessage::HELLO, body);
+    WireReader reader(body);
+    const uint32_t rank = reader.getU32();
+    if (rank >= worker_count_) {
+      throw std::runtime_error("Worker rank " + std::to_string(rank) +
+                               " out of range for " + std::to_string(worker_count_) + " workers");
+    }
+    if (channels_[rank]) {
+      throw std::runtime_error("Duplicate worker rank: " + std::to_string(rank));
+    }
+
+    WireWriter welcome;
+    welcome.putU32(worker_count_);
+    channel->send(ChannelMessage::WELCOME, welcome.data());
+    channels_[rank] = std::move(channel);
+  }
+
+  // Ready messages are read in rank order once everyone is in, so the
+  // node map does not depend on connection order
+  lookahead_ticks_ = UINT32_MAX;
+  for (uint32_t rank = 0; rank < worker_count_; ++rank) {
+    channels_[rank]->expect(ChannelMessage::READY, body);
+    WireReader reader(body);
+    lookahead_ticks_ = std::min(lookahead_ticks_, std::max<uint32_t>(1, reader.getU32()));
+    const uint32_t count = reader.getU32();
+    for (uint32_t i = 0; i < count; ++i) {
+      const uint32_t node = reader.getU32();
+      if (!node_ranks_.emplace(node, rank).second) {
+        throw std::runtime_error("Node " + std::to_string(node) + " hosted by ranks " +
+                                 std::to_string(node_ranks_[node]) + " and " +
+                                 std::to_string(rank));
+      }
+    }
+  }
+}
+
+size_t Coordinator::runWindow(uint64_t start_ms, uint32_t tick_ms, uint32_t ticks) {
+  for (uint32_t rank = 0; rank < worker_count_; ++rank) {
+    WireWriter window;
+    window.putU64(start_ms);
+    window.putU32(tick_ms);
+    window.putU32(ticks);
+    encodeFrameBatch(window, pending_[rank]);
+    pending_[rank].clear();
+    channels_[rank]->send(ChannelMessage::WINDOW, window.data());
+  }
+
+  // Every worker runs the window concurrently; collect in rank order
+  size_t routed = 0;
+  std::string body;
+  std::vector<DelayedMessage> outbound;
+  for (uint32_t rank = 0; rank < worker_count_; ++rank) {
+    channels_[rank]->expect(ChannelMessage::DONE, body);
+    WireReader reader(body);
+    outbound.clear();
+    decodeFrameBatch(reader, outbound);
+
+    for (auto& frame : outbound) {
+      auto it = node_ranks_.find(frame.to);
+      if (it == node_ranks_.end()) {
+        dropped_++;
+        continue;
+      }
+      pending_[it->second].push_back(std::move(frame));
+      routed++;
+    }
+  }
+  return routed;
+}
+
+std::vector<WorkerReport> Coordinator::stop() {
+  for (uint32_t rank = 0; rank < worker_count_; ++rank) {
+    channels_[rank]->send(ChannelMessage::STOP, std::string());
+  }
+
+  std::vector<WorkerReport> reports;
+  std::string body;
+  for (uint32_t rank = 0; rank < worker_count_; ++rank) {
+    channels_[rank]->expect(ChannelMessage::REPORT, body);
+    WireReader reader(body);
+    WorkerReport report;
+    report.rank = rank;
+    report.frames_shipped = reader.getU64();
+    report.frames_injected = reader.getU64();
+    report.frames_delivered = reader.getU64();
+    reports.push_back(report);
+  }
+  return reports;
+}
+
+} // namespace simulator
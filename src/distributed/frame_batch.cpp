@@ -0,0 +1,104 @@
+/**
+ * @file frame_batch.cpp
+ * @brief Implementation of the frame batch wire encoding
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/frame_batch.hpp"
+
+#include <stdexcept>
+
+namespace simulator {
+
+void WireWriter::putU32(uint32_t value) {
+  for (int shift = 0; shift < 32; shift += 8) {
+    putU8(static_cast<uint8_t>(value >> shift));
+  }
+}
+
+void WireWriter::putU64(uint64_t value) {
+  for (int shift = 0; shift < 64; shift += 8) {
+    putU8(static_cast<uint8_t>(value >> shift));
+  }
+}
+
+void WireWriter::putBytes(const char* data, size_t size) {
+  if (size > UINT32_MAX) {
+    throw std::invalid_argument("Byte string too long to encode");
+  }
+  putU32(static_cast<uint32_t>(size));
+  buffer_.append(data, size);
+}
+
+std::string WireWriter::release() {
+  std::string data;
+  data.swap(buffer_);
+  return data;
+}
+
+void WireReader::require(size_t size) const {
+  if (data_.size() - offset_ < size) {
+    throw std::runtime_error("Truncated wire data");
+  }
+}
+
+uint8_t WireReader::getU8() {
+  require(1);
+  return static_cast<uint8_t>(data_[offset_++]);
+}
+
+uint32_t WireReader::getU32() {
+  require(4);
+  uint32_t value = 0;
+  for (int shift = 0; shift < 32; shift += 8) {
+    value |= static_cast<uint32_t>(static_cast<uint8_t>(data_[offset_++])) << shift;
+  }
+  return value;
+}
+
+uint64_t WireReader::getU64() {
+  require(8);
+  uint64_t value = 0;
+  for (int shift = 0; shift < 64; shift += 8) {
+    value |= static_cast<uint64_t>(static_cast<uint8_t>(data_[offset_++])) << shift;
+  }
+  return value;
+}
+
+std::string WireReader::getBytes() {
+  const uint32_t size = getU32();
+  require(size);
+  std::string bytes = data_.substr(offset_, size);
+  offset_ += size;
+  return bytes;
+}
+
+void encodeFrameBatch(WireWriter& writer, const std::vector<DelayedMessage>& frames) {
+  if (frames.size() > UINT32_MAX) {
+    throw std::invalid_argument("Too many frames to encode");
+  }
+  writer.putU32(static_cast<uint32_t>(frames.size()));
+  for (const auto& frame : frames) {
+    writer.putU32(frame.from);
+    writer.putU32(frame.to);
+    writer.putU64(frame.deliveryTime);
+    writer.putBytes(frame.message.data(), frame.message.size());
+  }
+}
+
+size_t decodeFrameBatch(WireReader& reader, std::vector<DelayedMessage>& frames) {
+  const uint32_t count = reader.getU32();
+  for (uint32_t i = 0; i < count; ++i) {
+    DelayedMessage frame;
+    frame.from = reader.getU32();
+    frame.to = reader.getU32();
+    frame.deliveryTime = reader.getU64();
+    frame.message = reader.getBytes();
+    frames.push_back(std::move(frame));
+  }
+  return count;
+}
+
+} // namespace simulator
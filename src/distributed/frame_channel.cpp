@@ -0,0 +1,65 @@
+/**
+ * @file frame_channel.cpp
+ * @brief Implementation of FrameChannel class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/frame_channel.hpp"
+#include "simulator/frame_batch.hpp"
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace simulator {
+
+FrameChannel::FrameChannel(boost::asio::ip::tcp::socket socket)
+  : socket_(std::move(socket)) {
+  socket_.set_option(boost::asio::ip::tcp::no_delay(true));
+}
+
+void FrameChannel::send(ChannelMessage type, const std::string& body) {
+  if (body.size() > MAX_MESSAGE_SIZE) {
+    throw std::invalid_argument("Channel message too large");
+  }
+
+  WireWriter header;
+  header.putU32(static_cast<uint32_t>(body.size()));
+  header.putU8(static_cast<uint8_t>(type));
+
+  std::vector<boost::asio::const_buffer> buffers;
+  buffers.push_back(boost::asio::buffer(header.data()));
+  buffers.push_back(boost::asio::buffer(body));
+  boost::asio::write(socket_, buffers);
+}
+
+ChannelMessage FrameChannel::receive(std::string& body) {
+  std::string header(5, '\0');
+  boost::asio::read(socket_, boost::asio::buffer(&header[0], header.size()));
+
+  WireReader reader(header);
+  const uint32_t size = reader.getU32();
+  const auto type = static_cast<ChannelMessage>(reader.getU8());
+  if (size > MAX_MESSAGE_SIZE) {
+    throw std::runtime_error("Channel message too large: " + std::to_string(size));
+  }
+
+  body.assign(size, '\0');
+  if (size > 0) {
+    boost::asio::read(socket_, boost::asio::buffer(&body[0], size));
+  }
+  return type;
+}
+
+void FrameChannel::expect(ChannelMessage type, std::string& body) {
+  const ChannelMessage received = receive(body);
+  if (received != type) {
+    throw std::runtime_error("Unexpected channel message type " +
+                             std::to_string(static_cast<int>(received)) + ", expected " +
+                             std::to_string(static_cast<int>(type)));
+  }
+}
+
+} // namespace simulator
@@ -0,0 +1,123 @@
+/**
+ * @file partition_plan.cpp
+ * @brief Implementation of PartitionPlan class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/partition_plan.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace simulator {
+
+namespace {
+
+struct Placed {
+  uint32_t id;
+  int x;
+  int y;
+};
+
+// Splits [first, last) over ranks [rank, rank + count), cutting along the
+// wider axis so that each half gets its share of ranks
+void bisect(std::vector<Placed>::iterator first, std::vector<Placed>::iterator last,
+            uint32_t rank, uint32_t count, std::map<uint32_t, uint32_t>& ranks) {
+  if (count == 1 || first == last) {
+    for (auto it = first; it != last; ++it) {
+      ranks[it->id] = rank;
+    }
+    return;
+  }
+
+  auto x_range = std::minmax_element(first, last,
+      [](const Placed& a, const Placed& b) { return a.x < b.x; });
+  auto y_range = std::minmax_element(first, last,
+      [](const Placed& a, const Placed& b) { return a.y < b.y; });
+  const bool by_x = static_cast<int64_t>(x_range.second->x) - x_range.first->x >=
+                    static_cast<int64_t>(y_range.second->y) - y_range.first->y;
+
+  // Ties on the cut axis fall back to the node ID so every process agrees
+  std::sort(first, last, [by_x](const Placed& a, const Placed& b) {
+    const int ka = by_x ? a.x : a.y;
+    const int kb = by_x ? b.x : b.y;
+    return ka != kb ? ka < kb : a.id < b.id;
+  });
+
+  const uint32_t left_ranks = count / 2;
+  const auto size = static_cast<uint64_t>(last - first);
+  const auto split = first + static_cast<std::ptrdiff_t>(size * left_ranks / count);
+  bisect(first, split, rank, left_ranks, ranks);
+  bisect(split, last, rank + left_ranks, count - left_ranks, ranks);
+}
+
+} // anonymous namespace
+
+PartitionStrategy stringToPartitionStrategy(const std::string& name) {
+  if (name == "block") {
+    return PartitionStrategy::BLOCK;
+  }
+  if (name == "locality") {
+    return PartitionStrategy::LOCALITY;
+  }
+  throw std::invalid_argument("Unknown partition strategy: " + name);
+}
+
+PartitionPlan PartitionPlan::build(const std::vector<NodeConfigExtended>& nodes,
+                                   uint32_t ranks, PartitionStrategy strategy) {
+  if (ranks == 0) {
+    throw std::invalid_argument("Partition needs at least one rank");
+  }
+
+  PartitionPlan plan;
+  plan.rank_count_ = ranks;
+  for (const auto& node : nodes) {
+    if (plan.ranks_.count(node.nodeId) > 0) {
+      throw std::invalid_argument("Duplicate node ID in partition: " +
+                                  std::to_string(node.nodeId));
+    }
+    plan.ranks_[node.nodeId] = 0;
+    plan.order_.push_back(node.nodeId);
+  }
+
+  if (strategy == PartitionStrategy::BLOCK) {
+    const auto size = static_cast<uint64_t>(nodes.size());
+    for (uint64_t i = 0; i < size; ++i) {
+      plan.ranks_[plan.order_[i]] = static_cast<uint32_t>(i * ranks / size);
+    }
+    return plan;
+  }
+
+  std::vector<Placed> placed;
+  placed.reserve(nodes.size());
+  for (const auto& node : nodes) {
+    if (node.position.size() < 2) {
+      throw std::invalid_argument("Locality partition needs a position for node " + node.id);
+    }
+    placed.push_back({node.nodeId, node.position[0], node.position[1]});
+  }
+  bisect(placed.begin(), placed.end(), 0, ranks, plan.ranks_);
+  return plan;
+}
+
+uint32_t PartitionPlan::getRank(uint32_t nodeId) const {
+  auto it = ranks_.find(nodeId);
+  if (it == ranks_.end()) {
+    throw std::out_of_range("Node not in partition: " + std::to_string(nodeId));
+  }
+  return it->second;
+}
+
+std::vector<uint32_t> PartitionPlan::getNodes(uint32_t rank) const {
+  std::vector<uint32_t> nodes;
+  for (uint32_t id : order_) {
+    if (ranks_.at(id) == rank) {
+      nodes.push_back(id);
+    }
+  }
+  return nodes;
+}
+
+} // namespace simulator
@@ -0,0 +1,99 @@
+/**
+ * @file worker.cpp
+ * @brief Implementation of Worker class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/distributed.hpp"
+#include "simulator/frame_batch.hpp"
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+namespace simulator {
+
+Worker::Worker(boost::asio::io_context& io, const std::string& host, uint16_t port,
+               uint32_t rank)
+  : rank_(rank) {
+  boost::asio::ip::tcp::resolver resolver(io);
+  boost::system::error_code error;
+
+  for (int attempt = 0; attempt < CONNECT_ATTEMPTS; ++attempt) {
+    auto endpoints = resolver.resolve(host, std::to_string(port), error);
+    if (!error) {
+      boost::asio::ip::tcp::socket socket(io);
+      boost::asio::connect(socket, endpoints, error);
+      if (!error) {
+        channel_.reset(new FrameChannel(std::move(socket)));
+        return;
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+
+  throw std::runtime_error("Cannot reach coordinator at " + host + ":" +
+                           std::to_string(port) + ": " + error.message());
+}
+
+uint32_t Worker::join() {
+  WireWriter hello;
+  hello.putU32(rank_);
+  channel_->send(ChannelMessage::HELLO, hello.data());
+
+  std::string body;
+  channel_->expect(ChannelMessage::WELCOME, body);
+  WireReader reader(body);
+  return reader.getU32();
+}
+
+void Worker::ready(uint32_t lookahead_ticks, const std::vector<uint32_t>& nodes) {
+  WireWriter ready;
+  ready.putU32(lookahead_ticks);
+  ready.putU32(static_cast<uint32_t>(nodes.size()));
+  for (uint32_t node : nodes) {
+    ready.putU32(node);
+  }
+  channel_->send(ChannelMessage::READY, ready.data());
+}
+
+void Worker::serve(const WindowHandler& handler, const Reporter& reporter) {
+  std::string body;
+  std::vector<DelayedMessage> inbound;
+  std::vector<DelayedMessage> outbound;
+
+  for (;;) {
+    const ChannelMessage type = channel_->receive(body);
+    if (type == ChannelMessage::STOP) {
+      const WorkerReport report = reporter();
+      WireWriter writer;
+      writer.putU64(report.frames_shipped);
+      writer.putU64(report.frames_injected);
+      writer.putU64(report.frames_delivered);
+      channel_->send(ChannelMessage::REPORT, writer.data());
+      return;
+    }
+    if (type != ChannelMessage::WINDOW) {
+      throw std::runtime_error("Unexpected channel message type " +
+                               std::to_string(static_cast<int>(type)));
+    }
+
+    WireReader reader(body);
+    const uint64_t start_ms = reader.getU64();
+    const uint32_t tick_ms = reader.getU32();
+    const uint32_t ticks = reader.getU32();
+    inbound.clear();
+    outbound.clear();
+    decodeFrameBatch(reader, inbound);
+
+    handler(start_ms, tick_ms, ticks, inbound, outbound);
+
+    WireWriter done;
+    encodeFrameBatch(done, outbound);
+    channel_->send(ChannelMessage::DONE, done.data());
+  }
+}
+
+} // namespace simulator
@@ -86,7 +86,7 @@ private:
     messages_sent++;
     
     // Set random interval between 1-5 seconds (simulating basic.ino behavior)
-    uint32_t random_interval = TASK_SECOND * (1 + (rand() % 4));
+    uint32_t random_interval = TASK_SECOND * randomBetween(1, 5);
     taskSendMessage.setInterval(random_interval);
     
     if (messages_sent % 5 == 0) {
@@ -0,0 +1,84 @@
+/**
+ * @file coroutine_firmware.cpp
+ * @brief Implementation of CoroutineFirmware
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/firmware/coroutine_firmware.hpp"
+
+#if SIMULATOR_ENABLE_COROUTINES
+
+#include "simulator/virtual_time.hpp"
+
+#include <algorithm>
+
+namespace simulator {
+namespace firmware {
+
+constexpr uint64_t CoroutineFirmware::NEVER;
+
+void CoroutineFirmware::setup() {
+  routine_ = run();
+  waiting_ = routine_.handle();
+  resume();
+}
+
+void CoroutineFirmware::loop() {
+  const uint64_t now_ms = VirtualTime::millis();
+  if (waiting_ && isReady(now_ms)) {
+    resume();
+  }
+
+  // Sleep until the wait can end; a message wakes the node early
+  if (!waiting_ || wake_at_ms_ == NEVER) {
+    FirmwareBase::sleepFor(SLEEP_UNTIL_WOKEN);
+  } else {
+    const uint64_t remaining = wake_at_ms_ - std::min(wake_at_ms_, now_ms);
+    FirmwareBase::sleepFor(static_cast<uint32_t>(
+        std::min<uint64_t>(remaining, SLEEP_UNTIL_WOKEN - 1)));
+  }
+}
+
+void CoroutineFirmware::onReceiveView(uint32_t from, StringView msg) {
+  inbox_.push_back(Message{from, String(msg.data(), msg.size())});
+}
+
+size_t CoroutineFirmware::getMemoryUsage() const {
+  size_t bytes = sizeof(CoroutineFirmware) - sizeof(FirmwareBase) + FirmwareBase::getMemoryUsage();
+  for (const auto& message : inbox_) {
+    bytes += sizeof(Message) + message.msg.capacity();
+  }
+  return bytes;
+}
+
+void CoroutineFirmware::suspend(std::coroutine_handle<> handle, uint32_t ms, bool wants_message) {
+  waiting_ = handle;
+  wants_message_ = wants_message;
+  wake_at_ms_ = ms == SLEEP_UNTIL_WOKEN ? NEVER : VirtualTime::millis() + ms;
+}
+
+bool CoroutineFirmware::isReady(uint64_t now_ms) const {
+  return now_ms >= wake_at_ms_ || (wants_message_ && !inbox_.empty());
+}
+
+void CoroutineFirmware::resume() {
+  std::coroutine_handle<> handle = std::exchange(waiting_, nullptr);
+  wake_at_ms_ = NEVER;
+  wants_message_ = false;
+  resume_count_++;
+  handle.resume();  // Runs to the next co_await, which sets waiting_ again
+  routine_.rethrowError();
+}
+
+CoroutineFirmware::Message CoroutineFirmware::takeMessage() {
+  Message message = std::move(inbox_.front());
+  inbox_.pop_front();
+  return message;
+}
+
+} // namespace firmware
+} // namespace simulator
+
+#endif // SIMULATOR_ENABLE_COROUTINES
@@ -7,6 +7,10 @@
  */
 
 #include "simulator/firmware/firmware_base.hpp"
+#include "simulator/counter_rng.hpp"
+#include "simulator/mesh_transport.hpp"
+#include "simulator/shard_mailbox.hpp"
+#include "simulator/virtual_time.hpp"
 #include "Arduino.h"  // For TSTRING typedef
 #include "painlessmesh/mesh.hpp"
 #include <list>
@@ -15,24 +19,118 @@ namespace simulator {
 namespace firmware {
 
 void FirmwareBase::sendBroadcast(const String& msg) {
-  if (mesh_) {
+  if (outbox_) {
+    outbox_->post(node_id_, OutgoingMessage::BROADCAST, msg);
+  } else if (transport_) {
+    transport_->sendBroadcast(node_id_, msg);
+  } else if (mesh_) {
     String msg_copy = msg;  // painlessMesh modifies the message
     mesh_->sendBroadcast(msg_copy);
   }
 }
 
 void FirmwareBase::sendSingle(uint32_t dest, const String& msg) {
-  if (mesh_) {
+  if (outbox_) {
+    outbox_->post(node_id_, dest, msg);
+  } else if (transport_) {
+    transport_->sendSingle(node_id_, dest, msg);
+  } else if (mesh_) {
     String msg_copy = msg;  // painlessMesh modifies the message
     mesh_->sendSingle(dest, msg_copy);
   }
 }
 
+void FirmwareBase::sendBroadcast(String&& msg) {
+  if (outbox_) {
+    outbox_->post(node_id_, OutgoingMessage::BROADCAST, std::move(msg));
+  } else if (transport_) {
+    transport_->sendBroadcast(node_id_, msg);
+  } else if (mesh_) {
+    mesh_->sendBroadcast(msg);
+  }
+}
+
+void FirmwareBase::sendSingle(uint32_t dest, String&& msg) {
+  if (outbox_) {
+    outbox_->post(node_id_, dest, std::move(msg));
+  } else if (transport_) {
+    transport_->sendSingle(node_id_, dest, msg);
+  } else if (mesh_) {
+    mesh_->sendSingle(dest, msg);
+  }
+}
+
+Payload FirmwareBase::prepareBroadcast(const String& msg) const {
+  return MeshTransport::encodeBroadcast(node_id_, msg);
+}
+
+void FirmwareBase::sendPreparedBroadcast(const Payload& prepared) {
+  if (outbox_) {
+    outbox_->postFrame(node_id_, prepared);
+  } else if (transport_) {
+    transport_->sendBroadcastFrame(node_id_, prepared);
+  } else if (mesh_) {
+    String msg = prepared.slice(MeshTransport::FRAME_HEADER_SIZE).str();
+    mesh_->sendBroadcast(msg);
+  }
+}
+
+size_t FirmwareBase::getMemoryUsage() const {
+  // The configuration is shared between nodes and not charged to each
+  return sizeof(FirmwareBase) + name_.capacity();
+}
+
+void FirmwareBase::saveCheckpoint(CheckpointWriter& out) const {
+  out.write<uint64_t>(random_sequence_);
+  saveState(out);
+}
+
+void FirmwareBase::loadCheckpoint(CheckpointReader& in) {
+  random_sequence_ = in.read<uint64_t>();
+  loadState(in);
+}
+
+uint32_t FirmwareBase::randomBetween(uint32_t min, uint32_t max) {
+  if (max <= min) {
+    return min;
+  }
+  CounterRng rng(CounterRng::makeKey(random_seed_, node_id_, 0, RNG_STREAM_FIRMWARE),
+                 random_sequence_++);
+  return min + rng() % (max - min);
+}
+
+TaskId FirmwareBase::runEvery(uint32_t interval_ms, std::function<void()> callback,
+                              int32_t iterations) {
+  if (!tasks_) {
+    return TaskId();
+  }
+  return tasks_->schedule(VirtualTime::millis() + interval_ms, interval_ms, iterations, std::move(callback));
+}
+
+TaskId FirmwareBase::runAfter(uint32_t delay_ms, std::function<void()> callback) {
+  if (!tasks_) {
+    return TaskId();
+  }
+  return tasks_->schedule(VirtualTime::millis() + delay_ms, delay_ms, 1, std::move(callback));
+}
+
+bool FirmwareBase::cancelTask(TaskId id) {
+  return tasks_ && tasks_->cancel(id);
+}
+
 uint32_t FirmwareBase::getNodeTime() const {
-  return mesh_ ? mesh_->getNodeTime() : 0;
+  if (mesh_) {
+    return mesh_->getNodeTime();
+  }
+  // Fluid nodes have no time sync; report the shared simulation time,
+  // which a converged mesh agrees on
+  return transport_ ? static_cast<uint32_t>(VirtualTime::baseUs()) : 0;
 }
 
 std::list<uint32_t> FirmwareBase::getNodeList() const {
+  if (transport_) {
+    return transport_->getReachableNodes(node_id_);
+  }
   return mesh_ ? mesh_->getNodeList() : std::list<uint32_t>();
 }
 
@@ -0,0 +1,38 @@
+/**
+ * @file firmware_factory.cpp
+ * @brief Built-in firmware of the simulator library
+ * 
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/firmware/firmware_factory.hpp"
+
+// Defined by REGISTER_FIRMWARE in each built-in firmware source
+extern "C" {
+void simulator_link_firmware_SimpleBroadcast();
+void simulator_link_firmware_EchoServer();
+void simulator_link_firmware_EchoClient();
+void simulator_link_firmware_library_validation();
+void simulator_link_firmware_RoutingBench();
+void simulator_link_firmware_BasicInoFirmware();
+void simulator_link_firmware_BridgeInoFirmware();
+}
+
+namespace simulator {
+namespace firmware {
+
+constexpr FirmwareId FirmwareFactory::INVALID_ID;
+
+void FirmwareFactory::linkBuiltinFirmware() {
+  simulator_link_firmware_SimpleBroadcast();
+  simulator_link_firmware_EchoServer();
+  simulator_link_firmware_EchoClient();
+  simulator_link_firmware_library_validation();
+  simulator_link_firmware_RoutingBench();
+  simulator_link_firmware_BasicInoFirmware();
+  simulator_link_firmware_BridgeInoFirmware();
+}
+
+} // namespace firmware
+} // namespace simulator
@@ -7,6 +7,7 @@
  */
 
 #include "simulator/firmware/library_validation_firmware.hpp"
+#include "simulator/firmware/firmware_factory.hpp"
 #include "painlessmesh/layout.hpp"
 #include <sstream>
 #include <iomanip>
@@ -70,6 +71,7 @@ void LibraryValidationFirmware::setup() {
 
 void LibraryValidationFirmware::loop() {
   // Main loop - most work done in scheduled tasks
+  sleepFor(SLEEP_UNTIL_WOKEN);
 }
 
 void LibraryValidationFirmware::onReceive(uint32_t from, String& msg) {
@@ -415,5 +417,8 @@ void LibraryValidationFirmware::checkExpectedMessages() {
   }
 }
 
+// Register firmware so it can be loaded by name
+REGISTER_FIRMWARE(library_validation, LibraryValidationFirmware)
+
 } // namespace firmware
 } // namespace simulator
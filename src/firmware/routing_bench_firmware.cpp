@@ -0,0 +1,163 @@
+/**
+ * @file routing_bench_firmware.cpp
+ * @brief Implementation and registration of RoutingBenchFirmware
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/firmware/routing_bench_firmware.hpp"
+#include "simulator/firmware/firmware_factory.hpp"
+#include "simulator/virtual_time.hpp"
+#include "Arduino.h"  // For TSTRING typedef
+#include "painlessmesh/mesh.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <sstream>
+#include <stdexcept>
+
+namespace simulator {
+namespace firmware {
+
+namespace {
+
+/// Payload of the timed sendSingle() calls
+const char* const SEND_PAYLOAD = "routing_bench";
+
+} // anonymous namespace
+
+const char* routingOpName(RoutingOp op) {
+  switch (op) {
+    case RoutingOp::NODE_LIST: return "node_list";
+    case RoutingOp::SUB_CONNECTION_JSON: return "sub_connection_json";
+    case RoutingOp::FIND_ROUTE: return "find_route";
+    case RoutingOp::SEND_SINGLE: return "send_single";
+  }
+  return "unknown";
+}
+
+RoutingBenchFirmware::RoutingBenchFirmware() : FirmwareBase("RoutingBench") {}
+
+void RoutingBenchFirmware::setup() {
+  probe_ = getConfig("role", "member") == "probe";
+  warmup_s_ = static_cast<uint32_t>(std::stoul(getConfig("warmup", "20")));
+  interval_s_ = static_cast<uint32_t>(std::stoul(getConfig("interval", "10")));
+  calls_ = static_cast<uint32_t>(std::stoul(getConfig("calls", "20")));
+  output_ = getConfig("output", "");
+  if (interval_s_ == 0 || calls_ == 0) {
+    throw std::invalid_argument("RoutingBench interval and calls must be positive");
+  }
+  if (!probe_) {
+    return;
+  }
+
+  runAfter(warmup_s_ * 1000, [this]() {
+    runRound();
+    runEvery(interval_s_ * 1000, [this]() { runRound(); });
+  });
+  std::cout << "[INFO] Node " << node_id_ << " RoutingBench probe initialized (first round after "
+            << warmup_s_ << "s, then every " << interval_s_ << "s)" << std::endl;
+}
+
+void RoutingBenchFirmware::loop() {
+  // Rounds run as tasks
+  sleepFor(SLEEP_UNTIL_WOKEN);
+}
+
+template <typename Call>
+void RoutingBenchFirmware::measure(RoutingOp op, size_t known_nodes, Call&& call) {
+  const auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < calls_; ++i) {
+    call(i);
+  }
+  const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start);
+
+  RoutingSample sample;
+  sample.round = round_;
+  sample.time_ms = static_cast<uint32_t>(VirtualTime::millis());
+  sample.known_nodes = known_nodes;
+  sample.op = op;
+  sample.calls = calls_;
+  sample.ns_per_call = static_cast<double>(elapsed.count()) / calls_;
+  samples_.push_back(sample);
+}
+
+void RoutingBenchFirmware::runRound() {
+  ++round_;
+  const size_t first = samples_.size();
+
+  // Route and send targets cycle through the nodes known at the start
+  const std::list<uint32_t> listed = getNodeList();
+  const std::vector<uint32_t> targets(listed.begin(), listed.end());
+  const size_t known_nodes = targets.size() + 1;
+
+  // Results are summed so the calls cannot be optimized away
+  size_t sink = 0;
+  measure(RoutingOp::NODE_LIST, known_nodes, [this, &sink](uint32_t) {
+    sink += getNodeList().size();
+  });
+  if (mesh_) {
+    measure(RoutingOp::SUB_CONNECTION_JSON, known_nodes, [this, &sink](uint32_t) {
+      sink += mesh_->subConnectionJson().size();
+    });
+    if (!targets.empty()) {
+      measure(RoutingOp::FIND_ROUTE, known_nodes, [this, &targets, &sink](uint32_t i) {
+        sink += mesh_->isConnected(targets[i % targets.size()]) ? 1 : 0;
+      });
+    }
+  }
+  if (!targets.empty()) {
+    const String payload(SEND_PAYLOAD);
+    measure(RoutingOp::SEND_SINGLE, known_nodes, [this, &targets, &payload](uint32_t i) {
+      sendSingle(targets[i % targets.size()], payload);
+    });
+  }
+
+  std::ostringstream line;
+  line << std::fixed << std::setprecision(0);
+  for (size_t i = first; i < samples_.size(); ++i) {
+    line << " " << routingOpName(samples_[i].op) << "=" << samples_[i].ns_per_call << "ns";
+  }
+  std::cout << "[INFO] Node " << node_id_ << " RoutingBench round " << round_ << ", "
+            << known_nodes << " nodes:" << line.str() << std::endl;
+  sink_ += sink;
+  writeRound(first);
+}
+
+void RoutingBenchFirmware::writeRound(size_t first) const {
+  if (output_.empty()) {
+    return;
+  }
+  std::ifstream existing(output_);
+  const bool header = !existing.good() || existing.peek() == std::ifstream::traits_type::eof();
+  existing.close();
+
+  std::ofstream out(output_, std::ios::app);
+  if (!out) {
+    std::cerr << "[ERROR] Node " << node_id_ << " cannot write RoutingBench output "
+              << output_ << std::endl;
+    return;
+  }
+  if (header) {
+    out << "node_id,round,time_ms,known_nodes,operation,calls,ns_per_call\n";
+  }
+  for (size_t i = first; i < samples_.size(); ++i) {
+    const RoutingSample& sample = samples_[i];
+    out << node_id_ << "," << sample.round << "," << sample.time_ms << ","
+        << sample.known_nodes << "," << routingOpName(sample.op) << "," << sample.calls << ","
+        << std::fixed << std::setprecision(1) << sample.ns_per_call << "\n";
+  }
+}
+
+} // namespace firmware
+} // namespace simulator
+
+using namespace simulator::firmware;
+
+// Register the RoutingBench firmware with the factory
+REGISTER_FIRMWARE(RoutingBench, RoutingBenchFirmware)
@@ -13,20 +13,63 @@
 #include "simulator/cli_options.hpp"
 #include "simulator/config_loader.hpp"
 #include "simulator/node_manager.hpp"
-#include "simulator/firmware/firmware_factory.hpp"
-#include "simulator/firmware/simple_broadcast_firmware.hpp"
-#include "simulator/firmware/library_validation_firmware.hpp"
+#include "simulator/network_simulator.hpp"
+#include "simulator/mesh_transport.hpp"
+#include "simulator/simulation_clock.hpp"
+#include "simulator/event_scheduler.hpp"
+#include "simulator/event_factory.hpp"
+#include "simulator/checkpoint.hpp"
+#include "simulator/scenario_cache.hpp"
+#include "simulator/distributed.hpp"
+#include "simulator/gateway.hpp"
+#include "simulator/partition_plan.hpp"
+#include "simulator/radio_model.hpp"
+#include "simulator/topology.hpp"
+#include "simulator/traffic_generator.hpp"
+#include "simulator/logger.hpp"
+#include "simulator/metrics_collector.hpp"
+#include "simulator/metrics_endpoint.hpp"
+#include "simulator/terminal_dashboard.hpp"
+#include "simulator/packet_capture.hpp"
+#include "simulator/topology_recorder.hpp"
+#include "simulator/connectivity_tracker.hpp"
+#include "simulator/alloc_tracker.hpp"
+#include "simulator/firmware_profiler.hpp"
+#include "simulator/loop_monitor.hpp"
+#include "simulator/trace_recorder.hpp"
+#include "simulator/state_dump.hpp"
+#include "simulator/virtual_time.hpp"
+#include "simulator/parameter_sweep.hpp"
+#include "simulator/ensemble_stats.hpp"
+#include "simulator/worker_pool.hpp"
 #include <iostream>
+#include <fstream>
+#include <sstream>
 #include <chrono>
-#include <thread>
+#include <algorithm>
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 #include <boost/asio.hpp>
 #include <csignal>
 
 using namespace simulator;
 
-// Global flag for graceful shutdown
-static volatile bool running = true;
+// Global flag for graceful shutdown; read by sweep and ensemble worker
+// threads, and lock-free so the signal handler may store to it
+static std::atomic<bool> running{true};
+static_assert(ATOMIC_BOOL_LOCK_FREE == 2, "running must be lock-free to be signal-safe");
+
+// Longest lookahead window in ticks, so progress checks stay responsive
+static constexpr uint32_t MAX_WINDOW_TICKS = 100;
+
+// Slow nodes listed in the final report
+static constexpr size_t SLOW_NODES_REPORTED = 10;
 
 /**
  * @brief Signal handler for SIGINT/SIGTERM
@@ -35,7 +78,7 @@ static volatile bool running = true;
  */
 void signalHandler(int signal) {
   std::cout << "\n[INFO] Received signal " << signal << ", shutting down gracefully...\n";
-  running = false;
+  running.store(false, std::memory_order_relaxed);
 }
 
 /**
@@ -46,20 +89,944 @@ void signalHandler(int signal) {
  */
 void applyCliOverrides(ScenarioConfig& config, const CLIOptions& options) {
   if (options.duration) {
-    std::cout << "[INFO] Overriding duration: " << *options.duration << " seconds\n";
+    SIM_LOG_INFO("[INFO] Overriding duration: {} seconds", *options.duration);
     config.simulation.duration = *options.duration;
   }
   
   if (options.time_scale) {
-    std::cout << "[INFO] Overriding time scale: " << *options.time_scale << "x\n";
+    SIM_LOG_INFO("[INFO] Overriding time scale: {}x", *options.time_scale);
     config.simulation.time_scale = *options.time_scale;
   }
   
+  if (options.unbounded) {
+    SIM_LOG_INFO("[INFO] Overriding time scale: unbounded");
+    config.simulation.time_scale = TIME_SCALE_UNBOUNDED;
+  }
+  
+  if (options.threads) {
+    SIM_LOG_INFO("[INFO] Overriding threads: {}", *options.threads);
+    config.simulation.threads = *options.threads;
+  }
+  
+  if (options.max_nodes) {
+    SIM_LOG_INFO("[INFO] Overriding max nodes: {}", *options.max_nodes);
+    config.simulation.max_nodes = *options.max_nodes;
+  }
+  
+  if (options.seed) {
+    SIM_LOG_INFO("[INFO] Overriding seed: {}", *options.seed);
+    config.simulation.seed = *options.seed;
+  }
+  
   if (!options.output_dir.empty()) {
     config.metrics.output = options.output_dir + "/metrics.csv";
   }
 }
 
+/**
+ * @brief Computes the compiled scenario key of a run
+ * 
+ * CLI overrides change what validation accepts (the duration bounds event
+ * times, max nodes caps the node count), so they are part of the key.
+ * 
+ * @param yaml Scenario file contents
+ * @param options CLI options with overrides
+ * @return Key of the compiled scenario
+ */
+uint64_t scenarioCacheKey(const std::string& yaml, const CLIOptions& options) {
+  CheckpointWriter overrides;
+  auto add = [&overrides](const auto& value) {
+    overrides.write<uint8_t>(value ? 1 : 0);
+    if (value) {
+      overrides.write(*value);
+    }
+  };
+  add(options.duration);
+  add(options.time_scale);
+  add(options.threads);
+  add(options.max_nodes);
+  add(options.seed);
+  overrides.write(options.unbounded);
+  overrides.writeString(options.output_dir);
+  return ScenarioCache::hashBytes(overrides.data().data(), overrides.data().size(),
+                                  ScenarioCache::hash(yaml));
+}
+
+/**
+ * @brief Apply network configuration to the network simulator
+ * 
+ * Per-connection overrides refer to nodes by their string ID and are
+ * resolved to numeric node IDs. Overrides naming unknown nodes are skipped.
+ * 
+ * @param network Network simulator to configure
+ * @param config Scenario configuration (templates already expanded)
+ */
+void applyNetworkConfig(NetworkSimulator& network, const ScenarioConfig& config) {
+  std::map<std::string, uint32_t> ids;
+  for (const auto& node : config.nodes) {
+    ids[node.id] = node.nodeId;
+  }
+  
+  auto resolve = [&ids](const std::string& from, const std::string& to,
+                        uint32_t& fromId, uint32_t& toId) {
+    auto from_it = ids.find(from);
+    auto to_it = ids.find(to);
+    if (from_it == ids.end() || to_it == ids.end()) {
+      SIM_LOG_WARN("[WARN] Ignoring network override for unknown connection {} -> {}", from, to);
+      return false;
+    }
+    fromId = from_it->second;
+    toId = to_it->second;
+    return true;
+  };
+  
+  const NetworkConfig& net = config.network;
+  network.setQueueBackend(stringToQueueBackend(net.delivery_queue));
+  network.setCoalescing(net.coalesce);
+  network.setDefaultLatency(net.default_latency);
+  network.setDefaultPacketLoss(net.default_packet_loss);
+  network.setDefaultBandwidth(net.default_bandwidth);
+  network.setAirtime(net.airtime);
+  
+  uint32_t from = 0;
+  uint32_t to = 0;
+  for (const auto& conn : net.specific_latencies) {
+    if (resolve(conn.from, conn.to, from, to)) {
+      network.setLatency(from, to, conn.config);
+    }
+  }
+  for (const auto& conn : net.specific_packet_losses) {
+    if (resolve(conn.from, conn.to, from, to)) {
+      network.setPacketLoss(from, to, conn.config);
+    }
+  }
+  for (const auto& conn : net.specific_bandwidths) {
+    if (resolve(conn.from, conn.to, from, to)) {
+      network.setBandwidth(from, to, conn.config);
+    }
+  }
+  
+  // Traced links replay recorded conditions instead of the distributions
+  if (!net.trace.empty()) {
+    auto trace = LinkTrace::open(net.trace);
+    SIM_LOG_INFO("[INFO] Playing link trace {} ({} links)", net.trace, trace->getLinkCount());
+    network.setLinkTrace(std::move(trace));
+  }
+}
+
+/**
+ * @brief Build a node configuration from a scenario node
+ * 
+ * @param node_config Scenario node
+ * @param simulation Simulation options (lazy nodes, node engine)
+ * @return Configuration for NodeManager::createNodes()
+ */
+NodeConfig makeNodeConfig(const NodeConfigExtended& node_config,
+                          const SimulationConfig& simulation) {
+  NodeConfig nc;
+  nc.nodeId = node_config.nodeId;
+  nc.meshPrefix = node_config.mesh_prefix;
+  nc.meshPassword = node_config.mesh_password;
+  nc.meshPort = node_config.mesh_port;
+  nc.firmware = node_config.firmware;
+  nc.sharedFirmwareConfig = node_config.firmwareConfig;
+  nc.lazy = simulation.lazy_nodes;
+  nc.fluid = simulation.node_engine == "fluid";
+  nc.clock.offset_us = static_cast<int64_t>(node_config.clock_offset_ms) * 1000;
+  nc.clock.drift_ppm = node_config.clock_drift_ppm;
+  return nc;
+}
+
+/**
+ * @brief Print the estimated node memory, in total and per node
+ * 
+ * @param memory Usage summed over all nodes
+ * @param nodes Number of nodes
+ */
+void printMemoryUsage(const NodeMemoryUsage& memory, size_t nodes) {
+  const size_t per_node = nodes > 0 ? memory.total() / nodes : 0;
+  std::cout << "Node memory (est.): " << memory.total() / 1024 << " KiB total, "
+            << per_node << " bytes/node (node=" << memory.node
+            << " mesh=" << memory.mesh
+            << " connections=" << memory.connections
+            << " firmware=" << memory.firmware
+            << " buffers=" << memory.buffers << ")" << std::endl;
+}
+
+/**
+ * @brief Check that a scenario can run distributed
+ * 
+ * Every process must derive the same topology and link streams from the
+ * scenario, so the seed must be fixed, and frames can only be shipped
+ * when they pass through the in-process transport.
+ * 
+ * @param config Scenario configuration
+ * @return true if the scenario can run distributed
+ */
+bool checkDistributedConfig(const ScenarioConfig& config) {
+  bool ok = true;
+  if (config.network.transport != "in_process") {
+    SIM_LOG_ERROR("[ERROR] Distributed runs need network.transport: in_process");
+    ok = false;
+  }
+  if (config.simulation.seed == 0) {
+    SIM_LOG_ERROR("[ERROR] Distributed runs need a non-zero simulation.seed");
+    ok = false;
+  }
+  if (config.gateway.isEnabled()) {
+    SIM_LOG_ERROR("[ERROR] Distributed runs cannot host a gateway");
+    ok = false;
+  }
+  if (!config.traffic.empty()) {
+    SIM_LOG_ERROR("[ERROR] Distributed runs cannot generate synthetic traffic");
+    ok = false;
+  }
+  return ok;
+}
+
+/**
+ * @brief Link the nodes that are in radio range of each other
+ * 
+ * Also sets the latency and packet loss of every link from its length.
+ * Every process of a distributed run builds the same links.
+ * 
+ * @param transport Transport to add the links to
+ * @param network Network simulator receiving the link conditions
+ * @param config Scenario configuration (radio topology, positions validated)
+ * @return Number of links added
+ */
+size_t buildRadioTopology(MeshTransport& transport, NetworkSimulator& network,
+                          const ScenarioConfig& config) {
+  RadioModel radio(config.topology.radio);
+  for (const auto& node : config.nodes) {
+    radio.setPosition(node.nodeId, Position{static_cast<double>(node.position[0]),
+                                            static_cast<double>(node.position[1])});
+  }
+  return radio.connect(transport, network);
+}
+
+/**
+ * @brief Get the links of the scenario topology by node ID
+ * 
+ * Every process builds the same links: generators draw from the
+ * RNG_STREAM_TOPOLOGY streams of the seed over the configured node
+ * order, and Philox output does not depend on the standard library.
+ * 
+ * @param config Scenario configuration (any topology but radio)
+ * @return Node ID pairs
+ */
+std::vector<std::pair<uint32_t, uint32_t>> buildTopologyLinks(const ScenarioConfig& config) {
+  std::vector<uint32_t> ids;
+  ids.reserve(config.nodes.size());
+  for (const auto& node : config.nodes) {
+    ids.push_back(node.nodeId);
+  }
+  return Topology::build(config.topology, config.nodes, config.simulation.seed).getLinks(ids);
+}
+
+/**
+ * @brief Open the packet capture requested on the command line
+ * 
+ * @param options CLI options
+ * @param config Scenario configuration (resolves the filter's node IDs)
+ * @param path Capture file
+ * @param network Network simulator to attach the capture to
+ * @return Open capture, or nullptr if --capture was not given
+ * 
+ * @throws std::runtime_error if a filter names an unknown node or the
+ *         file cannot be created
+ */
+std::unique_ptr<PacketCapture> openCapture(const CLIOptions& options, const ScenarioConfig& config,
+                                           const std::string& path, NetworkSimulator& network) {
+  if (options.capture_file.empty()) {
+    return nullptr;
+  }
+  std::unordered_map<std::string, uint32_t> ids;
+  for (const auto& node : config.nodes) {
+    ids.emplace(node.id, node.nodeId);
+  }
+  auto resolve = [&ids](const std::string& id) {
+    auto it = ids.find(id);
+    if (it == ids.end()) {
+      throw std::runtime_error("Capture filter references non-existent node: " + id);
+    }
+    return it->second;
+  };
+  
+  CaptureFilter filter;
+  filter.payload_prefix = options.capture_payload;
+  for (const auto& id : options.capture_nodes) {
+    filter.nodes.push_back(resolve(id));
+  }
+  for (const auto& link : options.capture_links) {
+    filter.links.emplace_back(resolve(link.first), resolve(link.second));
+  }
+  
+  std::unique_ptr<PacketCapture> capture(new PacketCapture(filter));
+  capture->open(path);
+  network.setCapture(capture.get());
+  SIM_LOG_INFO("[INFO] Capturing traffic to {}", path);
+  return capture;
+}
+
+/**
+ * @brief Detach and close a packet capture
+ * 
+ * @param capture Capture from openCapture(), may be nullptr
+ * @param network Network simulator it is attached to
+ */
+void closeCapture(std::unique_ptr<PacketCapture>& capture, NetworkSimulator& network) {
+  if (!capture) {
+    return;
+  }
+  network.setCapture(nullptr);
+  try {
+    capture->close();
+    SIM_LOG_INFO("[INFO] Captured {} messages ({} writer stalls)",
+                 capture->getCapturedCount(), capture->getStallCount());
+  } catch (const std::exception& e) {
+    SIM_LOG_ERROR("[ERROR] {}", e.what());
+  }
+  capture.reset();
+}
+
+/**
+ * @brief Write a checkpoint of a local run
+ * 
+ * @param path Output file
+ * @param time_us Virtual time, before the events due at it run
+ * @param seed Simulation seed
+ * @param manager Node manager
+ * @param network Network simulator
+ * @param transport In-process transport
+ */
+void writeCheckpoint(const std::string& path, uint64_t time_us, uint32_t seed,
+                     const NodeManager& manager, const NetworkSimulator& network,
+                     const MeshTransport& transport) {
+  CheckpointWriter out;
+  network.saveState(out);
+  transport.saveState(out);
+  manager.saveState(out);
+  out.beginSection(CHECKPOINT_END);
+  
+  Checkpoint checkpoint;
+  checkpoint.time_us = time_us;
+  checkpoint.seed = seed;
+  checkpoint.state = out.release();
+  checkpoint.save(path);
+}
+
+/**
+ * @brief Restore a local run from a checkpoint
+ * 
+ * The scenario must already be built; restoring overwrites the state of
+ * each component.
+ * 
+ * @throws std::runtime_error if the checkpoint does not match the run
+ */
+void restoreCheckpoint(const Checkpoint& checkpoint, NodeManager& manager,
+                       NetworkSimulator& network, MeshTransport& transport) {
+  CheckpointReader in(checkpoint.state);
+  network.loadState(in);
+  transport.loadState(in);
+  manager.loadState(in);
+  in.expectSection(CHECKPOINT_END);
+}
+
+/**
+ * @brief Drive the virtual clock of a distributed run
+ * 
+ * @param config Scenario configuration
+ * @param options CLI options (coordinator mode)
+ * @return Exit code
+ */
+int runCoordinator(const ScenarioConfig& config, const CLIOptions& options) {
+  boost::asio::io_context io;
+  Coordinator coordinator(io, *options.coordinator_port, *options.workers);
+  SIM_LOG_INFO("[INFO] Waiting for {} workers on port {}...",
+               *options.workers, coordinator.getPort());
+  coordinator.acceptWorkers();
+  SIM_LOG_INFO("[INFO] All workers ready (lookahead: {} ticks)", coordinator.getLookaheadTicks());
+  
+  SimulationClock clock(config.simulation.time_scale);
+  const uint64_t duration_us = static_cast<uint64_t>(config.simulation.duration) * 1000000ULL;
+  const uint32_t tick_ms = static_cast<uint32_t>(SimulationClock::DEFAULT_TICK_US / 1000);
+  const uint32_t max_ticks = std::min(coordinator.getLookaheadTicks(), MAX_WINDOW_TICKS);
+  int64_t last_report = -1;
+  uint64_t update_count = 0;
+  uint64_t frames_routed = 0;
+  
+  clock.start();
+  
+  while (running.load(std::memory_order_relaxed)) {
+    uint32_t window_ticks = max_ticks;
+    if (duration_us > 0) {
+      uint64_t remaining = (duration_us - std::min(duration_us, clock.nowUs())) /
+                           SimulationClock::DEFAULT_TICK_US;
+      window_ticks = static_cast<uint32_t>(std::max<uint64_t>(1,
+                                           std::min<uint64_t>(window_ticks, remaining)));
+    }
+    frames_routed += coordinator.runWindow(clock.nowMs(), tick_ms, window_ticks);
+    update_count += window_ticks;
+    
+    auto elapsed = static_cast<int64_t>(clock.nowMs() / 1000);
+    if (elapsed > 0 && elapsed % 5 == 0 && elapsed != last_report) {
+      SIM_LOG_INFO("[{}s] {} ticks, {} frames routed", elapsed, update_count, frames_routed);
+      last_report = elapsed;
+    }
+    
+    if (duration_us > 0 && clock.nowUs() >= duration_us) {
+      SIM_LOG_INFO("\n[INFO] Simulation duration reached ({} seconds)", config.simulation.duration);
+      break;
+    }
+    
+    uint64_t next_wake_us = clock.nowUs() + window_ticks * SimulationClock::DEFAULT_TICK_US;
+    if (duration_us > 0) {
+      next_wake_us = std::min(next_wake_us, duration_us);
+    }
+    clock.advanceTo(next_wake_us);
+  }
+  
+  auto reports = coordinator.stop();
+  
+  std::cout << "\n";
+  std::cout << "=== Distributed Results ===" << std::endl;
+  std::cout << "Simulated time: " << (clock.nowMs() / 1000) << " seconds"
+            << " (" << clock.getSpeedup() << "x wall time)" << std::endl;
+  std::cout << "Workers: " << reports.size() << std::endl;
+  uint64_t total_delivered = 0;
+  for (const auto& report : reports) {
+    total_delivered += report.frames_delivered;
+    std::cout << "  Rank " << report.rank
+              << ": shipped=" << report.frames_shipped
+              << ", injected=" << report.frames_injected
+              << ", delivered=" << report.frames_delivered << std::endl;
+  }
+  std::cout << "Frames routed between workers: " << frames_routed << std::endl;
+  std::cout << "Frames for unknown nodes: " << coordinator.getDroppedFrames() << std::endl;
+  std::cout << "Total frames delivered: " << total_delivered << std::endl;
+  std::cout << "===========================" << std::endl;
+  return 0;
+}
+
+/**
+ * @brief Host one rank's nodes in a distributed run
+ * 
+ * @param config Scenario configuration
+ * @param options CLI options (worker mode)
+ * @return Exit code
+ */
+int runDistributedWorker(const ScenarioConfig& config, const CLIOptions& options) {
+  const uint32_t rank = *options.rank;
+  boost::asio::io_context io;
+  SIM_LOG_INFO("[INFO] Joining coordinator at {}:{} as rank {}...",
+               options.worker_host, *options.worker_port, rank);
+  Worker worker(io, options.worker_host, *options.worker_port, rank);
+  const uint32_t ranks = worker.join();
+  
+  auto plan = PartitionPlan::build(config.nodes, ranks,
+                                   stringToPartitionStrategy(config.simulation.partition));
+  
+  NodeManager manager(io);
+  manager.setShardCount(config.simulation.threads);
+  manager.setMaxNodes(config.simulation.max_nodes);
+  manager.setSeed(config.simulation.seed);
+  NetworkSimulator network(config.simulation.seed);
+  applyNetworkConfig(network, config);
+  MeshTransport transport(network);
+  manager.setTransport(&transport);
+  
+  // This process samples the links of its own senders; frames for nodes
+  // of other ranks leave with the next DONE message
+  std::vector<DelayedMessage> leaving;
+  uint64_t shipped = 0;
+  uint64_t injected = 0;
+  network.setEgressFilter([&transport, &leaving, &shipped](DelayedMessage& frame) {
+    if (!transport.isRemote(frame.to)) {
+      return false;
+    }
+    leaving.push_back(std::move(frame));
+    shipped++;
+    return true;
+  });
+  
+  // Node start-up and event records go through the writer thread
+  Logger::instance().start();
+  
+  // Each rank captures the traffic of its own simulator
+  std::unique_ptr<PacketCapture> capture;
+  try {
+    capture = openCapture(options, config, options.capture_file + "." + std::to_string(rank),
+                          network);
+  } catch (const std::exception& e) {
+    SIM_LOG_ERROR("[ERROR] {}", e.what());
+    return 1;
+  }
+  
+  std::vector<uint32_t> local;
+  std::vector<NodeConfig> node_configs;
+  for (const auto& node_config : config.nodes) {
+    if (plan.getRank(node_config.nodeId) != rank) {
+      transport.attachRemote(node_config.nodeId);
+      continue;
+    }
+    node_configs.push_back(makeNodeConfig(node_config, config.simulation));
+    local.push_back(node_config.nodeId);
+  }
+  try {
+    manager.createNodes(node_configs);
+  } catch (const std::exception& e) {
+    SIM_LOG_ERROR("[ERROR] Failed to create nodes: {}", e.what());
+    return 1;
+  }
+  SIM_LOG_INFO("[INFO] Hosting {} of {} nodes ({} workers, partition: {})",
+               local.size(), config.nodes.size(), ranks, config.simulation.partition);
+  
+  manager.startAll();
+  if (config.topology.type == TopologyType::RADIO) {
+    buildRadioTopology(transport, network, config);
+  } else {
+    transport.addLinks(buildTopologyLinks(config));
+  }
+  
+  const uint32_t tick_ms = static_cast<uint32_t>(SimulationClock::DEFAULT_TICK_US / 1000);
+  worker.ready(manager.getLookaheadTicks(tick_ms, MAX_WINDOW_TICKS), local);
+  
+  worker.serve(
+    [&](uint64_t start_ms, uint32_t window_tick_ms, uint32_t ticks,
+        std::vector<DelayedMessage>& inbound, std::vector<DelayedMessage>& outbound) {
+      injected += inbound.size();
+      for (auto& frame : inbound) {
+        network.injectMessage(std::move(frame));
+      }
+      VirtualTime::setNowUs(start_ms * 1000);
+      manager.advanceWindow(start_ms, window_tick_ms, ticks);
+      outbound.swap(leaving);
+    },
+    [&]() {
+      WorkerReport report;
+      report.rank = rank;
+      report.frames_shipped = shipped;
+      report.frames_injected = injected;
+      report.frames_delivered = transport.getStats().frames_delivered;
+      return report;
+    });
+  
+  manager.stopAll();
+  closeCapture(capture, network);
+  Logger::instance().stop();
+  SIM_LOG_INFO("[INFO] Rank {} finished: shipped={}, injected={}, delivered={}",
+               rank, shipped, injected, transport.getStats().frames_delivered);
+  return 0;
+}
+
+/**
+ * @brief Expand and check the scenario of one batch run
+ * 
+ * Sweep and ensemble runs share the process, so they run headless on the
+ * virtual firmware clock with one thread each, and their mesh traffic
+ * must stay in process.
+ * 
+ * @param config Copy of the parsed scenario with the run's parameters,
+ *               expanded in place
+ * @return Why the run cannot start, empty if it can
+ */
+std::string prepareHeadlessRun(ScenarioConfig& config) {
+  config.simulation.threads = 1;
+  config.simulation.firmware_clock = "virtual";
+  config.simulation.time_scale = TIME_SCALE_UNBOUNDED;
+  
+  ConfigLoader loader;
+  loader.expandTemplates(config);
+  auto errors = loader.getValidationErrors(config);
+  if (config.network.transport != "in_process") {
+    return "network.transport: batch runs need the in-process transport";
+  }
+  if (config.simulation.duration == 0) {
+    return "simulation.duration: batch runs need a finite duration";
+  }
+  if (config.gateway.isEnabled()) {
+    return "gateway: batch runs cannot talk to a backend";
+  }
+  if (!errors.empty()) {
+    return errors[0].field + ": " + errors[0].message;
+  }
+  return "";
+}
+
+/**
+ * @brief Run one batch run to its duration
+ * 
+ * The run's firmware time is pinned to its own clock on the calling
+ * thread (TickTimeScope), so runs on other threads do not see it.
+ * 
+ * @param config Expanded scenario from prepareHeadlessRun()
+ * @param result Filled with the run's counters
+ * @param latency Set to the run's link latencies, if given
+ */
+void runHeadless(ScenarioConfig& config, SweepResult& result,
+                 LatencyHistogram* latency = nullptr) {
+  if (config.simulation.seed == 0) {
+    config.simulation.seed = std::max<uint32_t>(1, std::random_device{}());
+  }
+  
+  boost::asio::io_context io;
+  NodeManager manager(io);
+  manager.setShardCount(1);
+  manager.setMaxNodes(config.simulation.max_nodes);
+  manager.setSeed(config.simulation.seed);
+  NetworkSimulator network(config.simulation.seed);
+  applyNetworkConfig(network, config);
+  MeshTransport transport(network);
+  manager.setTransport(&transport);
+  
+  std::vector<NodeConfig> node_configs;
+  node_configs.reserve(config.nodes.size());
+  for (const auto& node_config : config.nodes) {
+    node_configs.push_back(makeNodeConfig(node_config, config.simulation));
+  }
+  {
+    TickTimeScope tick_time(0);
+    manager.createNodes(node_configs);
+    manager.startAll();
+  }
+  if (config.topology.type == TopologyType::RADIO) {
+    buildRadioTopology(transport, network, config);
+  } else {
+    manager.establishConnectivity(buildTopologyLinks(config));
+  }
+  
+  EventScheduler scheduler;
+  EventFactory events(config.nodes);
+  if (!config.events.empty()) {
+    events.scheduleAll(config.events, scheduler);
+    scheduler.compile();
+  }
+  if (!config.churn.empty()) {
+    events.addChurnSources(config.churn, config.simulation.seed, scheduler);
+  }
+  std::unique_ptr<TrafficGenerator> traffic;
+  if (!config.traffic.empty()) {
+    traffic.reset(new TrafficGenerator(transport, config.simulation.seed));
+    events.addTrafficStreams(config.traffic, *traffic);
+  }
+  
+  // Same stepping as the local run loop: one tick while a node is awake,
+  // else up to max_tick_ms towards the next wake-up, delivery or event
+  SimulationClock clock(TIME_SCALE_UNBOUNDED);
+  const uint64_t duration_us = static_cast<uint64_t>(config.simulation.duration) * 1000000ULL;
+  const uint64_t max_tick_us = config.simulation.max_tick_ms * 1000ULL;
+  clock.start();
+  
+  while (running.load(std::memory_order_relaxed)) {
+    TickTimeScope tick_time(clock.nowUs());
+    scheduler.processEventsUs(clock.nowUs(), manager, network);
+    if (traffic) {
+      traffic->generate(clock.nowMs());
+    }
+    transport.update(clock.nowMs());
+    manager.updateAll();
+    result.updates++;
+    
+    if (clock.nowUs() >= duration_us) {
+      break;
+    }
+    
+    uint64_t next_wake_us = clock.nowUs() + SimulationClock::DEFAULT_TICK_US;
+    if (max_tick_us > SimulationClock::DEFAULT_TICK_US) {
+      uint64_t due_us = clock.nowUs() + max_tick_us;
+      const uint64_t wake_ms = manager.getNextWakeTime();
+      if (wake_ms != UINT64_MAX) {
+        due_us = std::min(due_us, wake_ms * 1000);
+      }
+      const uint64_t delivery_ms = network.getNextDeliveryTime();
+      if (delivery_ms != UINT64_MAX) {
+        due_us = std::min(due_us, delivery_ms * 1000);
+      }
+      next_wake_us = std::max(next_wake_us, due_us);
+    }
+    next_wake_us = std::min(next_wake_us, scheduler.getNextEventTimeUs());
+    if (traffic && traffic->getNextTimeMs() != UINT64_MAX) {
+      next_wake_us = std::min(next_wake_us, traffic->getNextTimeMs() * 1000);
+    }
+    clock.advanceTo(std::min(next_wake_us, duration_us));
+  }
+  
+  TickTimeScope tick_time(clock.nowUs());
+  result.nodes = manager.getNodeCount();
+  result.simulated_ms = clock.nowMs();
+  for (const auto& node_id : manager.getNodeIds()) {
+    auto node = manager.getNode(node_id);
+    if (node) {
+      auto metrics = node->getMetrics();
+      result.messages_sent += metrics.messages_sent;
+      result.messages_received += metrics.messages_received;
+    }
+  }
+  result.frames_dropped = transport.getStats().frames_dropped;
+  if (traffic) {
+    const TrafficStats totals = traffic->getTotals();
+    result.traffic_offered = totals.offered;
+    result.traffic_expected = totals.expected;
+    result.traffic_delivered = totals.delivered;
+  }
+  network.forEachLinkStats([&result](const NetworkSimulator::LinkCounters& link,
+                                     const LatencyHistogram*) {
+    result.link_delivered += link.delivered_count;
+    result.link_lost += link.dropped_count + link.bandwidth_throttled;
+  });
+  LatencyHistogram histogram = network.getGlobalLatencyHistogram();
+  if (histogram.getCount() > 0) {
+    result.latency_p50_ms = histogram.getPercentile(50.0);
+    result.latency_p95_ms = histogram.getPercentile(95.0);
+    result.latency_p99_ms = histogram.getPercentile(99.0);
+  }
+  if (latency) {
+    *latency = std::move(histogram);
+  }
+  manager.stopAll();
+}
+
+/**
+ * @brief Apply a sweep point to a scenario and prepare it
+ * 
+ * @param spec Sweep
+ * @param point Parameters of the run
+ * @param config Copy of the parsed scenario, expanded in place
+ * @return Why the run cannot start, empty if it can
+ */
+std::string prepareSweepPoint(const SweepSpec& spec, const SweepPoint& point,
+                              ScenarioConfig& config) {
+  try {
+    spec.apply(point, config);
+  } catch (const std::exception& e) {
+    return e.what();
+  }
+  return prepareHeadlessRun(config);
+}
+
+/**
+ * @brief Run every point of a parameter sweep and write the results table
+ * 
+ * The scenario is parsed once; each run copies it, applies its point and
+ * expands its templates, sharing firmware configurations and the firmware
+ * registry with the other runs. Runs are handed to a WorkerPool one at a
+ * time, so long and short runs balance across the threads.
+ * 
+ * @param yaml Scenario file contents
+ * @param options CLI options (sweep mode)
+ * @return Exit code (0 = every run completed, 1 = a run failed, 2 = invalid)
+ */
+int runSweep(const std::string& yaml, const CLIOptions& options) {
+  SweepSpec spec;
+  try {
+    spec = SweepSpec::load(options.sweep_file);
+  } catch (const std::exception& e) {
+    SIM_LOG_ERROR("[ERROR] {}", e.what());
+    return 2;
+  }
+  if (options.jobs) {
+    spec.setJobs(*options.jobs);
+  }
+  
+  ConfigLoader loader;
+  auto parsed = loader.loadFromString(yaml);
+  if (!parsed) {
+    SIM_LOG_ERROR("[ERROR] Failed to load configuration: {}", loader.getLastError());
+    return 1;
+  }
+  applyCliOverrides(*parsed, options);
+  const std::shared_ptr<const ScenarioConfig> base =
+    std::make_shared<const ScenarioConfig>(std::move(*parsed));
+  
+  const size_t points = spec.getPointCount();
+  if (options.validate_only) {
+    size_t invalid = 0;
+    for (size_t i = 0; i < points; ++i) {
+      ScenarioConfig config = *base;
+      const std::string error = prepareSweepPoint(spec, spec.getPoint(i), config);
+      if (!error.empty()) {
+        SIM_LOG_ERROR("[ERROR] Run {}: {}", i, error);
+        invalid++;
+      }
+    }
+    SIM_LOG_INFO("[INFO] {} of {} sweep runs valid", points - invalid, points);
+    return invalid == 0 ? 0 : 2;
+  }
+  
+  size_t jobs = spec.getJobs() > 0 ? spec.getJobs()
+                                   : std::max<size_t>(1, std::thread::hardware_concurrency());
+  jobs = std::min(jobs, points);
+  std::cout << "\n=== Parameter Sweep ===" << std::endl;
+  std::cout << "Runs: " << points << std::endl;
+  std::cout << "Concurrent runs: " << jobs << std::endl;
+  std::cout << "Results: " << spec.getOutput() << std::endl;
+  std::cout << "=======================\n" << std::endl;
+  
+  VirtualTime::useVirtualClock(true);
+  std::signal(SIGINT, signalHandler);
+  std::signal(SIGTERM, signalHandler);
+  Logger::instance().start();
+  
+  // Each thread expands only the scenario it is running, so memory grows
+  // with the concurrent runs, not the grid
+  std::vector<SweepResult> results(points);
+  std::atomic<size_t> next{0};
+  std::atomic<size_t> done{0};
+  WorkerPool pool(jobs);
+  pool.run([&](size_t) {
+    for (size_t i = next++; i < points; i = next++) {
+      SweepResult& result = results[i];
+      result.point = spec.getPoint(i);
+      if (!running.load(std::memory_order_relaxed)) {
+        result.error = "interrupted";
+        continue;
+      }
+      const auto wall_start = std::chrono::steady_clock::now();
+      ScenarioConfig config = *base;
+      result.error = prepareSweepPoint(spec, result.point, config);
+      if (result.ok()) {
+        try {
+          runHeadless(config, result);
+        } catch (const std::exception& e) {
+          result.error = e.what();
+        }
+      }
+      result.wall_ms = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - wall_start).count());
+      SIM_LOG_INFO("[INFO] Run {} finished ({}/{}): {} in {} ms", i, ++done, points,
+                   result.ok() ? "ok" : result.error, result.wall_ms);
+    }
+  });
+  Logger::instance().stop();
+  
+  size_t failed = 0;
+  for (const auto& result : results) {
+    if (!result.ok()) {
+      failed++;
+    }
+  }
+  std::ofstream table(spec.getOutput());
+  if (!table) {
+    SIM_LOG_ERROR("[ERROR] Cannot write sweep results: {}", spec.getOutput());
+    return 1;
+  }
+  spec.writeTable(results, table);
+  
+  std::cout << "\n=== Sweep Results ===" << std::endl;
+  std::cout << "Completed runs: " << points - failed << " of " << points << std::endl;
+  std::cout << "Results table: " << spec.getOutput() << std::endl;
+  std::cout << "=====================" << std::endl;
+  return failed == 0 ? 0 : 1;
+}
+
+/**
+ * @brief Run the scenario with many seeds and report aggregate statistics
+ * 
+ * Run i uses seed base + i (skipping 0), the base being the scenario's
+ * seed or a random one. Runs are handed to a WorkerPool one at a time and
+ * each finished run is merged into one EnsembleStats under a lock, so
+ * nothing is kept per run. With --ci-width no new runs start once the
+ * delivery ratio's 95% confidence interval is narrow enough; runs already
+ * in progress still finish and count.
+ * 
+ * @param yaml Scenario file contents
+ * @param options CLI options (ensemble mode)
+ * @return Exit code (0 = every run completed, 1 = a run failed, 2 = invalid)
+ */
+int runEnsemble(const std::string& yaml, const CLIOptions& options) {
+  ConfigLoader loader;
+  auto parsed = loader.loadFromString(yaml);
+  if (!parsed) {
+    SIM_LOG_ERROR("[ERROR] Failed to load configuration: {}", loader.getLastError());
+    return 1;
+  }
+  applyCliOverrides(*parsed, options);
+  if (parsed->simulation.seed == 0) {
+    parsed->simulation.seed = std::max<uint32_t>(1, std::random_device{}());
+  }
+  const std::shared_ptr<const ScenarioConfig> base =
+    std::make_shared<const ScenarioConfig>(std::move(*parsed));
+  
+  {
+    ScenarioConfig config = *base;
+    const std::string error = prepareHeadlessRun(config);
+    if (!error.empty()) {
+      SIM_LOG_ERROR("[ERROR] {}", error);
+      return 2;
+    }
+  }
+  if (options.validate_only) {
+    SIM_LOG_INFO("[INFO] Ensemble scenario valid");
+    return 0;
+  }
+  
+  const size_t runs = options.ensemble_runs;
+  size_t jobs = options.jobs && *options.jobs > 0
+                  ? *options.jobs
+                  : std::max<size_t>(1, std::thread::hardware_concurrency());
+  jobs = std::min(jobs, runs);
+  const uint32_t base_seed = base->simulation.seed;
+  std::cout << "\n=== Seed Ensemble ===" << std::endl;
+  std::cout << "Runs: " << runs << " (seeds from " << base_seed << ")" << std::endl;
+  std::cout << "Concurrent runs: " << jobs << std::endl;
+  if (options.ci_width) {
+    std::cout << "Stop at delivery ratio CI width: " << *options.ci_width << std::endl;
+  }
+  std::cout << "=====================\n" << std::endl;
+  
+  VirtualTime::useVirtualClock(true);
+  std::signal(SIGINT, signalHandler);
+  std::signal(SIGTERM, signalHandler);
+  Logger::instance().start();
+  
+  EnsembleStats stats;
+  std::mutex stats_mutex;
+  std::atomic<size_t> next{0};
+  std::atomic<bool> converged{false};
+  WorkerPool pool(jobs);
+  pool.run([&](size_t) {
+    for (size_t i = next++;
+         i < runs && running.load(std::memory_order_relaxed) && !converged;
+         i = next++) {
+      SweepResult result;
+      LatencyHistogram latency;
+      ScenarioConfig config = *base;
+      config.simulation.seed = static_cast<uint32_t>(
+        1 + (static_cast<uint64_t>(base_seed) - 1 + i) % UINT32_MAX);
+      result.error = prepareHeadlessRun(config);
+      if (result.ok()) {
+        try {
+          runHeadless(config, result, &latency);
+        } catch (const std::exception& e) {
+          result.error = e.what();
+        }
+      }
+      
+      std::lock_guard<std::mutex> lock(stats_mutex);
+      if (result.ok()) {
+        stats.addRun(result, latency);
+      } else {
+        stats.addFailure();
+        SIM_LOG_WARN("[WARN] Run with seed {} failed: {}", config.simulation.seed, result.error);
+      }
+      if (options.ci_width && stats.isConverged(*options.ci_width)) {
+        converged = true;
+      }
+    }
+  });
+  Logger::instance().stop();
+  
+  std::cout << "\n=== Ensemble Results ===" << std::endl;
+  stats.print(std::cout);
+  if (converged) {
+    std::cout << "Stopped early: delivery ratio CI narrower than " << *options.ci_width
+              << std::endl;
+  }
+  std::cout << "========================" << std::endl;
+  return stats.getFailures() == 0 ? 0 : 1;
+}
+
 /**
  * @brief Main entry point
  * 
@@ -69,18 +1036,12 @@ void applyCliOverrides(ScenarioConfig& config, const CLIOptions& options) {
  */
 int main(int argc, char* argv[]) {
   try {
-    // Register built-in firmware
-    firmware::FirmwareFactory::instance().registerFirmware("SimpleBroadcast",
-      []() { return std::make_unique<firmware::SimpleBroadcastFirmware>(); });
-    firmware::FirmwareFactory::instance().registerFirmware("library_validation",
-      []() { return std::make_unique<firmware::LibraryValidationFirmware>(); });
-    
     // Parse command-line arguments
     CLIOptions options;
     try {
       options = parseCommandLine(argc, argv);
     } catch (const std::exception& e) {
-      std::cerr << "[ERROR] " << e.what() << std::endl;
+      SIM_LOG_ERROR("[ERROR] {}", e.what());
       return 1;
     }
     
@@ -89,48 +1050,100 @@ int main(int argc, char* argv[]) {
       return 0;
     }
     
-    // Load configuration
-    std::cout << "[INFO] Loading configuration from: " << options.config_file << std::endl;
-    ConfigLoader loader;
-    auto config_opt = loader.loadFromFile(options.config_file);
+    Logger& logger = Logger::instance();
+    logger.setLevel(Logger::parseLevel(options.log_level));
     
-    if (!config_opt) {
-      std::cerr << "[ERROR] Failed to load configuration: " << loader.getLastError() << std::endl;
+    // Load configuration
+    SIM_LOG_INFO("[INFO] Loading configuration from: {}", options.config_file);
+    std::ifstream config_file(options.config_file, std::ios::binary);
+    if (!config_file) {
+      SIM_LOG_ERROR("[ERROR] Failed to load configuration: Failed to open file: {}",
+                    options.config_file);
       return 1;
     }
+    std::stringstream config_text;
+    config_text << config_file.rdbuf();
+    const std::string yaml = config_text.str();
     
-    auto config = *config_opt;
-    
-    // Expand templates if present
-    if (!config.templates.empty()) {
-      std::cout << "[INFO] Expanding " << config.templates.size() << " node templates..." << std::endl;
-      loader.expandTemplates(config);
+    // A sweep runs the scenario once per parameter combination
+    if (!options.sweep_file.empty()) {
+      return runSweep(yaml, options);
     }
     
-    // Apply CLI overrides
-    applyCliOverrides(config, options);
+    // An ensemble runs it once per seed and keeps only aggregates
+    if (options.ensemble_runs > 0) {
+      return runEnsemble(yaml, options);
+    }
     
-    // Validate configuration
-    std::cout << "[INFO] Validating configuration..." << std::endl;
-    auto errors = loader.getValidationErrors(config);
+    // A compiled scenario from an earlier run skips parsing, expansion
+    // and validation
+    const std::string cache_path = ScenarioCache::pathFor(options.config_file);
+    const uint64_t cache_key = scenarioCacheKey(yaml, options);
+    boost::optional<ScenarioConfig> cached;
+    if (options.scenario_cache) {
+      cached = ScenarioCache::load(cache_path, cache_key);
+    }
     
-    if (!errors.empty()) {
-      std::cerr << "[ERROR] Configuration validation failed:\n";
-      for (const auto& error : errors) {
-        std::cerr << "  - " << error.field << ": " << error.message;
-        if (!error.suggestion.empty()) {
-          std::cerr << " (Suggestion: " << error.suggestion << ")";
+    ScenarioConfig config;
+    if (cached) {
+      SIM_LOG_INFO("[INFO] Using compiled scenario: {}", cache_path);
+      config = std::move(*cached);
+      applyCliOverrides(config, options);
+    } else {
+      ConfigLoader loader;
+      auto config_opt = loader.loadFromString(yaml);
+      
+      if (!config_opt) {
+        SIM_LOG_ERROR("[ERROR] Failed to load configuration: {}", loader.getLastError());
+        return 1;
+      }
+      
+      config = std::move(*config_opt);
+      
+      // Apply CLI overrides (--threads also splits template expansion)
+      applyCliOverrides(config, options);
+      
+      // Expand templates if present
+      if (!config.templates.empty()) {
+        SIM_LOG_INFO("[INFO] Expanding {} node templates...", config.templates.size());
+        if (logger.enabled(LogLevel::DEBUG)) {
+          loader.setLogStream(&std::cout);
+        }
+        size_t generated = loader.expandTemplates(config);
+        SIM_LOG_INFO("[INFO] Generated {} nodes from templates", generated);
+      }
+      
+      // Validate configuration
+      SIM_LOG_INFO("[INFO] Validating configuration...");
+      auto errors = loader.getValidationErrors(config);
+      
+      if (!errors.empty()) {
+        SIM_LOG_ERROR("[ERROR] Configuration validation failed:");
+        for (const auto& error : errors) {
+          if (error.suggestion.empty()) {
+            SIM_LOG_ERROR("  - {}: {}", error.field, error.message);
+          } else {
+            SIM_LOG_ERROR("  - {}: {} (Suggestion: {})", error.field, error.message,
+                          error.suggestion);
+          }
+        }
+        return 2;
+      }
+      
+      SIM_LOG_INFO("[INFO] Configuration valid");
+      
+      if (options.scenario_cache) {
+        try {
+          ScenarioCache::save(cache_path, cache_key, config);
+        } catch (const std::exception& e) {
+          SIM_LOG_WARN("[WARN] {} (continuing without a compiled scenario)", e.what());
         }
-        std::cerr << std::endl;
       }
-      return 2;
     }
     
-    std::cout << "[INFO] Configuration valid" << std::endl;
-    
     // Handle --validate-only mode
     if (options.validate_only) {
-      std::cout << "[INFO] Validation successful. Exiting (--validate-only mode)" << std::endl;
+      SIM_LOG_INFO("[INFO] Validation successful. Exiting (--validate-only mode)");
       return 0;
     }
     
@@ -144,112 +1157,640 @@ int main(int argc, char* argv[]) {
     std::cout << "Duration: " << (config.simulation.duration > 0 ? 
                                   std::to_string(config.simulation.duration) + " seconds" : 
                                   "infinite") << std::endl;
-    std::cout << "Time scale: " << config.simulation.time_scale << "x" << std::endl;
+    if (config.simulation.time_scale == TIME_SCALE_UNBOUNDED) {
+      std::cout << "Time scale: unbounded" << std::endl;
+    } else {
+      std::cout << "Time scale: " << config.simulation.time_scale << "x" << std::endl;
+    }
     std::cout << "Node count: " << config.nodes.size() << std::endl;
+    std::cout << "Transport: " << config.network.transport << std::endl;
+    std::cout << "Node engine: " << config.simulation.node_engine << std::endl;
+    std::cout << "Threads: " << config.simulation.threads 
+              << " (sync: " << config.simulation.sync << ")" << std::endl;
+    std::cout << "Firmware clock: " << config.simulation.firmware_clock << std::endl;
+    if (config.simulation.max_tick_ms * 1000ULL > SimulationClock::DEFAULT_TICK_US) {
+      std::cout << "Tick: adaptive (up to " << config.simulation.max_tick_ms << " ms)" << std::endl;
+    }
     std::cout << "Log level: " << options.log_level << std::endl;
     std::cout << "================================\n" << std::endl;
     
+    // millis()/micros() of all firmware follow the simulation clock
+    // instead of the wall clock
+    VirtualTime::useVirtualClock(config.simulation.firmware_clock == "virtual");
+    
+    // Distributed runs: the coordinator drives the clock, each worker
+    // hosts its partition of the nodes
+    if (options.coordinator_port || options.worker_port) {
+      if (!checkDistributedConfig(config)) {
+        return 2;
+      }
+      std::signal(SIGINT, signalHandler);
+      std::signal(SIGTERM, signalHandler);
+      return options.coordinator_port ? runCoordinator(config, options)
+                                      : runDistributedWorker(config, options);
+    }
+    
+    // A restored run continues with the seed of its checkpoint
+    Checkpoint restored;
+    if (!options.restore_file.empty()) {
+      try {
+        restored = Checkpoint::load(options.restore_file);
+      } catch (const std::exception& e) {
+        SIM_LOG_ERROR("[ERROR] {}", e.what());
+        return 1;
+      }
+      if (config.simulation.seed == 0) {
+        config.simulation.seed = restored.seed;
+      } else if (config.simulation.seed != restored.seed) {
+        SIM_LOG_ERROR("[ERROR] Checkpoint was taken with seed {}, not {}",
+                      restored.seed, config.simulation.seed);
+        return 1;
+      }
+    }
+    
+    // One seed drives the topology, the network model and firmware
+    // random numbers; a random one is drawn and printed so the run can be
+    // replayed with --seed
+    if (config.simulation.seed == 0) {
+      config.simulation.seed = std::max<uint32_t>(1, std::random_device{}());
+      SIM_LOG_INFO("[INFO] Using random seed {} (replay with --seed {})",
+                   config.simulation.seed, config.simulation.seed);
+    }
+    
+    // Declared before the nodes so they outlive their final stop()
+    std::unique_ptr<TopologyRecorder> topology;
+    std::unique_ptr<ConnectivityTracker> connectivity;
+    
     // Create IO context and node manager
     boost::asio::io_context io;
     NodeManager manager(io);
+    manager.setShardCount(config.simulation.threads);
+    manager.setMaxNodes(config.simulation.max_nodes);
+    manager.setSeed(config.simulation.seed);
+    
+    // Profiling starts before the nodes so firmware setup() is timed too
+    std::unique_ptr<FirmwareProfiler> profiler;
+    if (options.profile_top > 0) {
+      profiler.reset(new FirmwareProfiler());
+      manager.setProfiling(true);
+      SIM_LOG_INFO("[INFO] Profiling firmware callbacks");
+    }
+    
+    // Tick times are always kept; node updates are timed for the watchdog
+    LoopMonitor loop_monitor(options.update_budget_us);
+    if (options.update_budget_us > 0) {
+      manager.setLoopMonitor(&loop_monitor);
+      SIM_LOG_INFO("[INFO] Flagging node updates over {} us", options.update_budget_us);
+    }
+    
+    // Allocations are counted from process start in tracking builds; the
+    // report only decides whether they are shown
+    const bool memory_report = options.memory_report && AllocTracker::isEnabled();
+    if (options.memory_report && !memory_report) {
+      SIM_LOG_WARN("[WARN] Allocation tracking is compiled out; rebuild with "
+                   "-DENABLE_ALLOC_TRACKING=ON for --memory-report");
+    }
+    
+    // Network simulator and in-process transport carry mesh traffic
+    // when network.transport is "in_process"
+    NetworkSimulator network(config.simulation.seed);
+    applyNetworkConfig(network, config);
+    MeshTransport transport(network);
+    const bool in_process = config.network.transport == "in_process";
+    if (in_process) {
+      manager.setTransport(&transport);
+    }
     
     // Install signal handler (using traditional signal handling)
     std::signal(SIGINT, signalHandler);
     std::signal(SIGTERM, signalHandler);
+    StateDump::installSignalHandler();
+    
+    // The dashboard owns stdout; log records go to stderr instead
+    const bool dashboard_ui = options.ui_mode == "terminal";
+    if (dashboard_ui) {
+      logger.setOutput(&std::cerr, &std::cerr);
+    }
+    
+    // From here on, records are written by the logger's writer thread
+    logger.start();
+    
+    std::unique_ptr<PacketCapture> capture;
+    try {
+      capture = openCapture(options, config, options.capture_file, network);
+    } catch (const std::exception& e) {
+      SIM_LOG_ERROR("[ERROR] {}", e.what());
+      return 1;
+    }
     
     // Create nodes from configuration
-    std::cout << "[INFO] Creating " << config.nodes.size() << " virtual nodes..." << std::endl;
+    SIM_LOG_INFO("[INFO] Creating {} virtual nodes...", config.nodes.size());
     
+    std::vector<NodeConfig> node_configs;
+    node_configs.reserve(config.nodes.size());
     for (const auto& node_config : config.nodes) {
+      node_configs.push_back(makeNodeConfig(node_config, config.simulation));
+    }
+    try {
+      manager.createNodes(node_configs);
+    } catch (const std::exception& e) {
+      SIM_LOG_ERROR("[ERROR] Failed to create nodes: {}", e.what());
+      return 1;
+    }
+    
+    if (logger.enabled(LogLevel::DEBUG)) {
+      for (const auto& node_config : config.nodes) {
+        SIM_LOG_DEBUG("[DEBUG] Created node {} ({})", node_config.nodeId, node_config.id);
+      }
+    }
+    
+    SIM_LOG_INFO("[INFO] Successfully created {} nodes", manager.getNodeCount());
+    
+    // Start all nodes
+    SIM_LOG_INFO("[INFO] Starting all nodes...");
+    manager.startAll();
+    SIM_LOG_INFO("[INFO] All nodes started");
+    
+    // Establish connectivity between nodes
+    SIM_LOG_INFO("[INFO] Establishing mesh connectivity...");
+    if (config.topology.type == TopologyType::RADIO) {
+      size_t links = buildRadioTopology(transport, network, config);
+      SIM_LOG_INFO("[INFO] Radio range {} m, {} links", config.topology.radio.getRange(), links);
+    } else {
+      size_t links = manager.establishConnectivity(buildTopologyLinks(config));
+      SIM_LOG_INFO("[INFO] {} links", links);
+    }
+    SIM_LOG_INFO("[INFO] Mesh connectivity established");
+    
+    // Bridge nodes reach a real backend through the gateway's socket
+    std::unique_ptr<Gateway> gateway;
+    if (config.gateway.isEnabled()) {
       try {
-        NodeConfig nc;
-        nc.nodeId = node_config.nodeId;
-        nc.meshPrefix = node_config.mesh_prefix;
-        nc.meshPassword = node_config.mesh_password;
-        nc.meshPort = node_config.mesh_port;
-        nc.firmware = node_config.firmware;
-        nc.firmwareConfig = node_config.firmwareConfig;
-        
-        auto node = manager.createNode(nc);
-        
-        if (options.log_level == "DEBUG") {
-          std::cout << "[DEBUG] Created node " << node_config.nodeId 
-                    << " (" << node_config.id << ")" << std::endl;
+        gateway.reset(new Gateway(transport, config.gateway.listen, config.gateway.backend,
+                                  config.gateway.max_datagram));
+      } catch (const std::exception& e) {
+        SIM_LOG_ERROR("[ERROR] Cannot open the gateway: {}", e.what());
+        return 1;
+      }
+      gateway->setForwardBroadcasts(config.gateway.broadcasts);
+      for (const auto& node_config : config.nodes) {
+        const auto& names = config.gateway.nodes;
+        if (names.empty() ? node_config.type == "bridge"
+                          : std::find(names.begin(), names.end(), node_config.id) != names.end()) {
+          gateway->expose(node_config.nodeId);
         }
+      }
+      SIM_LOG_INFO("[INFO] Gateway on {} exposes {} bridges to {}", config.gateway.listen,
+                   gateway->getExposedCount(), config.gateway.backend);
+    }
+    
+    // Scenario events are dispatched from the virtual-clock loop; churn
+    // sources generate theirs lazily as the clock reaches them
+    EventScheduler scheduler;
+    EventFactory events(config.nodes);
+    if (!config.events.empty()) {
+      size_t scheduled = events.scheduleAll(config.events, scheduler);
+      scheduler.compile();
+      SIM_LOG_INFO("[INFO] Scheduled {} scenario events", scheduled);
+    }
+    if (!config.churn.empty()) {
+      size_t sources = events.addChurnSources(config.churn, config.simulation.seed, scheduler);
+      SIM_LOG_INFO("[INFO] Added {} churn sources", sources);
+    }
+    
+    // Synthetic traffic is counted where it arrives, never seen by firmware
+    std::unique_ptr<TrafficGenerator> traffic;
+    if (!config.traffic.empty()) {
+      traffic.reset(new TrafficGenerator(transport, config.simulation.seed));
+      try {
+        size_t streams = events.addTrafficStreams(config.traffic, *traffic);
+        SIM_LOG_INFO("[INFO] Added {} traffic streams", streams);
+      } catch (const std::invalid_argument& e) {
+        SIM_LOG_ERROR("[ERROR] Invalid traffic: {}", e.what());
+        return 1;
+      }
+    }
+    
+    // Restoring overwrites the state built above; events before the
+    // checkpoint already ran in the run that wrote it
+    uint64_t start_us = 0;
+    if (!options.restore_file.empty()) {
+      VirtualTime::setNowUs(restored.time_us);
+      try {
+        restoreCheckpoint(restored, manager, network, transport);
       } catch (const std::exception& e) {
-        std::cerr << "[ERROR] Failed to create node " << node_config.id 
-                  << ": " << e.what() << std::endl;
+        SIM_LOG_ERROR("[ERROR] Cannot restore {}: {}", options.restore_file, e.what());
         return 1;
       }
+      start_us = restored.time_us;
+      size_t skipped = scheduler.skipUntilUs(start_us);
+      if (traffic) {
+        traffic->skipTo(start_us / 1000);
+      }
+      SIM_LOG_INFO("[INFO] Restored checkpoint at {} ms ({} earlier events skipped)",
+                   start_us / 1000, skipped);
     }
     
-    std::cout << "[INFO] Successfully created " << manager.getNodeCount() << " nodes" << std::endl;
+    // Scheduled events and a pending checkpoint both stop the clock
+    bool checkpoint_pending = static_cast<bool>(options.checkpoint_at);
+    const uint64_t checkpoint_us = options.checkpoint_at
+      ? static_cast<uint64_t>(static_cast<double>(*options.checkpoint_at) * 1000000.0)
+      : 0;
     
-    // Start all nodes
-    std::cout << "[INFO] Starting all nodes..." << std::endl;
-    manager.startAll();
-    std::cout << "[INFO] All nodes started" << std::endl;
+    // Metrics are sampled every metrics.interval seconds of virtual time
+    std::unique_ptr<MetricsCollector> metrics;
+    if (!config.metrics.output.empty()) {
+      try {
+        metrics.reset(new MetricsCollector(config.metrics));
+        metrics->open();
+      } catch (const std::exception& e) {
+        SIM_LOG_ERROR("[ERROR] Cannot write metrics: {}", e.what());
+        return 1;
+      }
+      SIM_LOG_INFO("[INFO] Writing metrics every {} s to {}",
+                   config.metrics.interval, MetricsCollector::basePath(config.metrics.output));
+    }
+    const MeshTransport* metrics_transport = in_process ? &transport : nullptr;
     
-    // Establish connectivity between nodes
-    std::cout << "[INFO] Establishing mesh connectivity..." << std::endl;
-    manager.establishConnectivity();
-    std::cout << "[INFO] Mesh connectivity established" << std::endl;
+    // Live metrics are snapshotted every second of wall time for scrapers
+    std::unique_ptr<MetricsEndpoint> endpoint;
+    if (options.metrics_port) {
+      try {
+        endpoint.reset(new MetricsEndpoint(*options.metrics_port));
+        endpoint->start();
+      } catch (const std::exception& e) {
+        SIM_LOG_ERROR("[ERROR] Cannot serve live metrics on port {}: {}",
+                      *options.metrics_port, e.what());
+        return 1;
+      }
+      SIM_LOG_INFO("[INFO] Serving live metrics at http://localhost:{}/metrics",
+                   endpoint->getPort());
+    }
+    
+    // The terminal dashboard is redrawn twice a second from its own thread
+    std::unique_ptr<TerminalDashboard> dashboard;
+    if (dashboard_ui) {
+      dashboard.reset(new TerminalDashboard(
+        std::cout, static_cast<uint64_t>(config.simulation.duration) * 1000000ULL));
+      dashboard->start();
+    }
+    
+    // Topology is written once, then one line per change
+    if (TopologyRecorder::isRequested(config.metrics)) {
+      try {
+        topology.reset(new TopologyRecorder(config.metrics));
+        topology->open(start_us, manager, network, metrics_transport);
+      } catch (const std::exception& e) {
+        SIM_LOG_ERROR("[ERROR] Cannot write topology: {}", e.what());
+        return 1;
+      }
+      SIM_LOG_INFO("[INFO] Recording topology changes to {}",
+                   MetricsCollector::basePath(config.metrics.output) + "_topology.*");
+    }
+    
+    // Components follow the changes; they pass them on to the recorder
+    if (metrics && in_process) {
+      connectivity.reset(new ConnectivityTracker(network, transport));
+      connectivity->reset(manager);
+      connectivity->setNext(topology.get());
+      metrics->setConnectivityTracker(connectivity.get());
+    }
+    TopologyListener* listener = connectivity
+      ? static_cast<TopologyListener*>(connectivity.get()) : topology.get();
+    if (listener) {
+      if (in_process) {
+        transport.setTopologyListener(listener);
+      }
+      network.setTopologyListener(listener);
+      manager.setTopologyListener(listener);
+    }
+    
+    auto next_stop_us = [&]() {
+      uint64_t next_us = scheduler.getNextEventTimeUs();
+      if (checkpoint_pending) {
+        next_us = std::min(next_us, checkpoint_us);
+      }
+      if (metrics) {
+        next_us = std::min(next_us, metrics->getNextSampleUs());
+      }
+      if (traffic) {
+        const uint64_t traffic_ms = traffic->getNextTimeMs();
+        next_us = std::min(next_us, traffic_ms == UINT64_MAX ? UINT64_MAX : traffic_ms * 1000);
+      }
+      return next_us;
+    };
+    
+    // Once every node sleeps, nothing but a wake-up, a delivery or an event
+    // can change the state, so the clock may skip to the earliest of them
+    const uint64_t max_tick_us = config.simulation.max_tick_ms * 1000ULL;
+    auto next_due_us = [&](uint64_t now_us) {
+      uint64_t next_us = now_us + max_tick_us;
+      const uint64_t wake_ms = manager.getNextWakeTime();
+      if (wake_ms != UINT64_MAX) {
+        next_us = std::min(next_us, wake_ms * 1000);
+      }
+      const uint64_t delivery_ms = network.getNextDeliveryTime();
+      if (delivery_ms != UINT64_MAX) {
+        next_us = std::min(next_us, delivery_ms * 1000);
+      }
+      return next_us;
+    };
+    
+    // Trace spans of the run loop are kept in memory and written at the end
+    std::ofstream trace_out;
+    if (!options.trace_file.empty()) {
+#if SIMULATOR_ENABLE_TRACING
+      trace_out.open(options.trace_file);
+      if (!trace_out) {
+        SIM_LOG_ERROR("[ERROR] Cannot write trace: {}", options.trace_file);
+        return 1;
+      }
+      TraceRecorder::instance().start();
+      TraceRecorder::instance().setThreadName("simulation");
+      SIM_LOG_INFO("[INFO] Tracing the simulation loop to {}", options.trace_file);
+#else
+      SIM_LOG_WARN("[WARN] Tracing is compiled out; rebuild with -DENABLE_TRACING=ON for --trace");
+#endif
+    }
+    
+    // SIGUSR1 (or a dump.request file) dumps the state while the run goes on
+    StateDump state_dump(options.output_dir, options.dump_window_ms, options.dump_profile);
     
     // Run simulation
-    std::cout << "\n[INFO] Starting simulation...\n" << std::endl;
+    SIM_LOG_INFO("\n[INFO] Starting simulation...\n");
     
-    auto start_time = std::chrono::steady_clock::now();
-    int64_t last_report = -1;
+    SimulationClock clock(config.simulation.time_scale);
+    const uint64_t duration_us = static_cast<uint64_t>(config.simulation.duration) * 1000000ULL;
+    const bool lookahead = config.simulation.sync == "lookahead";
+    const uint32_t tick_ms = static_cast<uint32_t>(SimulationClock::DEFAULT_TICK_US / 1000);
+    int64_t last_report = 0;
+    uint64_t last_overruns = 0;
     uint32_t update_count = 0;
+    uint32_t window_ticks = 1;
     
-    while (running) {
-      // Update all nodes
-      manager.updateAll();
-      update_count++;
+    clock.start(start_us);
+    
+    while (running.load(std::memory_order_relaxed)) {
+      SIM_TRACE_SCOPE_ARG("tick", "virtual_ms", clock.nowMs());
+      const uint64_t tick_start_ns = UpdateTiming::nowNs();
+      VirtualTime::setNowUs(clock.nowUs());
+      if (topology) {
+        topology->setTimeUs(clock.nowUs());
+      }
       
-      // Calculate elapsed time
-      auto now = std::chrono::steady_clock::now();
-      auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - start_time).count();
+      // A checkpoint holds the state before the events due at its time
+      if (checkpoint_pending && clock.nowUs() >= checkpoint_us) {
+        try {
+          writeCheckpoint(options.checkpoint_file, clock.nowUs(), config.simulation.seed,
+                          manager, network, transport);
+          SIM_LOG_INFO("[INFO] Wrote checkpoint at {} ms to {}",
+                       clock.nowMs(), options.checkpoint_file);
+        } catch (const std::exception& e) {
+          SIM_LOG_ERROR("[ERROR] {}", e.what());
+        }
+        checkpoint_pending = false;
+      }
       
-      // Progress reporting every 5 seconds
-      if (elapsed > 0 && elapsed % 5 == 0 && elapsed != last_report) {
-        std::cout << "[" << elapsed << "s] " 
-                  << manager.getNodeCount() << " nodes running, "
-                  << update_count << " updates performed" << std::endl;
+      // Like checkpoints, samples hold the state before the events due
+      if (metrics && clock.nowUs() >= metrics->getNextSampleUs()) {
+        SIM_TRACE_SCOPE("metrics.sample");
+        metrics->sample(clock.nowUs(), manager, network, metrics_transport);
+      }
+      
+      // Events due at the current virtual time run before the nodes see it
+      {
+        SIM_TRACE_SCOPE("events.process");
+        scheduler.processEventsUs(clock.nowUs(), manager, network);
+      }
+      
+      // Backend records enter the mesh at the current virtual time
+      if (gateway) {
+        SIM_TRACE_SCOPE("gateway.poll");
+        gateway->poll(clock.nowMs());
+      }
+      
+      // Synthetic messages due by now are sent as one batch
+      if (traffic) {
+        SIM_TRACE_SCOPE("traffic.generate");
+        traffic->generate(clock.nowMs());
+      }
+      
+      if (lookahead) {
+        // Shards meet once per lookahead window; the window drives the
+        // transport for all of its ticks
+        window_ticks = manager.getLookaheadTicks(tick_ms, MAX_WINDOW_TICKS);
+        if (duration_us > 0) {
+          uint64_t remaining = (duration_us - std::min(duration_us, clock.nowUs())) /
+                               SimulationClock::DEFAULT_TICK_US;
+          window_ticks = static_cast<uint32_t>(std::max<uint64_t>(1,
+                                               std::min<uint64_t>(window_ticks, remaining)));
+        }
+        // A window never runs past the next scheduled event or checkpoint
+        const uint64_t next_event_us = next_stop_us();
+        if (next_event_us != UINT64_MAX) {
+          const uint64_t until_event = next_event_us - std::min(next_event_us, clock.nowUs());
+          const uint64_t event_ticks = (until_event + SimulationClock::DEFAULT_TICK_US - 1) /
+                                       SimulationClock::DEFAULT_TICK_US;
+          window_ticks = static_cast<uint32_t>(std::max<uint64_t>(1,
+                                               std::min<uint64_t>(window_ticks, event_ticks)));
+        }
+        SIM_TRACE_SCOPE_ARG("window", "ticks", window_ticks);
+        manager.advanceWindow(clock.nowMs(), tick_ms, window_ticks);
+        update_count += window_ticks;
+      } else {
+        // Deliver in-process mesh traffic due at the current simulated time
+        if (in_process) {
+          SIM_TRACE_SCOPE("network.deliver");
+          transport.update(clock.nowMs());
+        }
+        
+        // Update all nodes
+        SIM_TRACE_SCOPE("nodes.update_all");
+        manager.updateAll();
+        update_count++;
+      }
+      
+      // What the bridges received this tick goes out in shared datagrams
+      if (gateway) {
+        SIM_TRACE_SCOPE("gateway.flush");
+        gateway->flush();
+      }
+      
+      // Simulated time elapsed
+      auto elapsed = static_cast<int64_t>(clock.nowMs() / 1000);
+      
+      // Progress reporting every 5 seconds of simulated time (adaptive
+      // ticks may step over the exact second)
+      if (elapsed / 5 > last_report / 5) {
+        SIM_LOG_INFO("[{}s] {} nodes running, {} updates performed",
+                     elapsed, manager.getNodeCount(), update_count);
+        if (memory_report) {
+          SIM_LOG_INFO("[{}s] Heap: {}", elapsed, AllocTracker::summary(AllocTracker::snapshot()));
+        }
         last_report = elapsed;
+        if (clock.getOverrunCount() > last_overruns) {
+          SIM_LOG_WARN("[WARN] {} ticks overran their wall-clock deadline (worst lag {} ms)",
+                       clock.getOverrunCount() - last_overruns, clock.getMaxLagUs() / 1000);
+          last_overruns = clock.getOverrunCount();
+        }
       }
       
-      // Check timeout
-      if (config.simulation.duration > 0) {
-        if (elapsed >= static_cast<int64_t>(config.simulation.duration)) {
-          std::cout << "\n[INFO] Simulation duration reached (" 
-                    << config.simulation.duration << " seconds)" << std::endl;
-          break;
+      if (endpoint && endpoint->isDue()) {
+        endpoint->publish(clock.nowUs(), update_count, manager, network, &scheduler,
+                          metrics_transport);
+      }
+      if (dashboard && dashboard->isDue()) {
+        dashboard->publish(clock.nowUs(), update_count, manager, network, &scheduler,
+                           metrics_transport);
+      }
+      
+      // Wall time of the tick (the window in lookahead mode), without the
+      // real-time wait for the next one
+      loop_monitor.recordTick((UpdateTiming::nowNs() - tick_start_ns) / 1000);
+      
+      // State dumps are taken and closed between ticks
+      if (state_dump.isCollecting()) {
+        if (state_dump.isWindowOver()) {
+          state_dump.finish();
         }
+      } else if (state_dump.isRequested()) {
+        state_dump.begin(clock.nowUs(), update_count, manager, network, &scheduler,
+                         metrics_transport, loop_monitor);
       }
       
-      // Small sleep to avoid busy waiting
-      // Adjust based on time scale for more accurate simulation
-      int sleep_ms = static_cast<int>(10.0f / config.simulation.time_scale);
-      if (sleep_ms < 1) sleep_ms = 1;
-      std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms));
+      // Check timeout
+      if (duration_us > 0 && clock.nowUs() >= duration_us) {
+        SIM_LOG_INFO("\n[INFO] Simulation duration reached ({} seconds)",
+                     config.simulation.duration);
+        break;
+      }
+      
+      // Advance the virtual clock to the next due work item. TaskScheduler
+      // tasks expose no deadline, so while a node is awake they bound each
+      // jump to one tick (one window in lookahead mode). With adaptive ticks
+      // an idle mesh jumps to its next wake-up or delivery instead, at most
+      // max_tick_ms at a time so painlessMesh's own tasks still run; the
+      // next scheduled event is a wake source of its own. In real-time mode
+      // advanceTo() sleeps; in unbounded mode it returns at once.
+      const uint64_t step_us = window_ticks * SimulationClock::DEFAULT_TICK_US;
+      uint64_t next_wake_us = clock.nowUs() + step_us;
+      if (max_tick_us > step_us) {
+        next_wake_us = std::max(next_wake_us, next_due_us(clock.nowUs()));
+      }
+      next_wake_us = std::min(next_wake_us, next_stop_us());
+      if (duration_us > 0) {
+        next_wake_us = std::min(next_wake_us, duration_us);
+      }
+      SIM_TRACE_SCOPE("clock.advance");
+      clock.advanceTo(next_wake_us);
+    }
+    
+    // A dump still measuring is written with the window it got
+    state_dump.finish();
+    
+    if (trace_out.is_open()) {
+      TraceRecorder& tracer = TraceRecorder::instance();
+      tracer.stop();
+      tracer.writeChromeJson(trace_out);
+      trace_out.close();
+      if (trace_out) {
+        SIM_LOG_INFO("[INFO] Wrote {} trace spans from {} threads to {} ({} dropped)",
+                     tracer.getEventCount(), tracer.getThreadCount(), options.trace_file,
+                     tracer.getDroppedCount());
+      } else {
+        SIM_LOG_ERROR("[ERROR] Cannot write trace: {}", options.trace_file);
+      }
+    }
+    
+    // Memory is sampled while nodes still run (stopped lazy nodes hold none)
+    const NodeMemoryUsage memory = manager.getMemoryUsage();
+    const AllocSnapshot heap = AllocTracker::snapshot();
+    
+    // Final sample at the end time, then finish the metrics files
+    if (metrics) {
+      try {
+        if (metrics->getSampleCount() == 0 ||
+            clock.nowUs() + metrics->getIntervalUs() > metrics->getNextSampleUs()) {
+          metrics->sample(clock.nowUs(), manager, network, metrics_transport);
+        }
+        metrics->close();
+        SIM_LOG_INFO("[INFO] Wrote {} metrics samples", metrics->getSampleCount());
+      } catch (const std::exception& e) {
+        SIM_LOG_ERROR("[ERROR] {}", e.what());
+      }
+    }
+    
+    // Last live snapshot holds the end state
+    if (endpoint) {
+      endpoint->publish(clock.nowUs(), update_count, manager, network, &scheduler,
+                        metrics_transport);
+      endpoint->stop();
+    }
+    if (dashboard) {
+      dashboard->publish(clock.nowUs(), update_count, manager, network, &scheduler,
+                         metrics_transport);
+      dashboard->stop();
+    }
+    
+    // Shutdown is not a topology change
+    if (listener) {
+      transport.setTopologyListener(nullptr);
+      network.setTopologyListener(nullptr);
+      manager.setTopologyListener(nullptr);
+    }
+    if (topology) {
+      try {
+        topology->close();
+        SIM_LOG_INFO("[INFO] Recorded {} topology changes", topology->getChangeCount());
+      } catch (const std::exception& e) {
+        SIM_LOG_ERROR("[ERROR] {}", e.what());
+      }
     }
     
     // Stop all nodes
-    std::cout << "\n[INFO] Stopping all nodes..." << std::endl;
+    SIM_LOG_INFO("\n[INFO] Stopping all nodes...");
     manager.stopAll();
+    closeCapture(capture, network);
+    logger.stop();
     
     // Calculate final statistics
-    auto end_time = std::chrono::steady_clock::now();
-    auto total_duration = std::chrono::duration_cast<std::chrono::seconds>(
-      end_time - start_time).count();
+    auto total_duration = static_cast<int64_t>(clock.wallElapsedUs() / 1000000);
     
     // Report final results
     std::cout << "\n";
     std::cout << "=== Simulation Results ===" << std::endl;
     std::cout << "Total duration: " << total_duration << " seconds" << std::endl;
+    std::cout << "Simulated time: " << (clock.nowMs() / 1000) << " seconds" 
+              << " (" << clock.getSpeedup() << "x wall time)" << std::endl;
     std::cout << "Nodes: " << manager.getNodeCount() << std::endl;
     std::cout << "Updates: " << update_count << std::endl;
+    if (clock.getOverrunCount() > 0) {
+      std::cout << "Tick overruns: " << clock.getOverrunCount()
+                << " (worst lag " << clock.getMaxLagUs() / 1000 << " ms)" << std::endl;
+    }
+    if (network.getAirtime().isEnabled()) {
+      const AirtimeStats airtime = network.getAirtimeStats();
+      std::cout << "Airtime: " << airtime.frames << " frames in " << airtime.domains
+                << " collision domains, " << airtime.airtime_us / 1000 << " ms on air, "
+                << (airtime.frames > 0 ? airtime.wait_us / airtime.frames : 0)
+                << " us average wait, " << airtime.dropped << " dropped" << std::endl;
+    }
+    if (gateway) {
+      const GatewayStats& stats = gateway->getStats();
+      std::cout << "Gateway: " << stats.records_sent << " records up in " << stats.datagrams_sent
+                << " datagrams (" << stats.records_dropped << " dropped), "
+                << stats.records_received << " records down in " << stats.datagrams_received
+                << " datagrams (" << stats.records_rejected << " rejected)" << std::endl;
+    }
+    if (traffic) {
+      for (size_t i = 0; i < traffic->getStreamCount(); ++i) {
+        const TrafficStats& stats = traffic->getStats(i);
+        std::cout << "Traffic " << i << ": " << stats.offered << " messages offered ("
+                  << stats.getOfferedRate() << "/s), " << stats.delivered << " of "
+                  << stats.expected << " deliveries (" << stats.getDeliveredRate() << "/s, "
+                  << stats.getDeliveryRatio() * 100.0 << "%)" << std::endl;
+      }
+    }
     std::cout << "Average update rate: " 
               << (total_duration > 0 ? update_count / total_duration : 0) 
               << " updates/sec" << std::endl;
@@ -263,7 +1804,7 @@ int main(int argc, char* argv[]) {
         auto metrics = node->getMetrics();
         total_sent += metrics.messages_sent;
         total_received += metrics.messages_received;
-        if (options.log_level == "DEBUG") {
+        if (logger.enabled(LogLevel::DEBUG)) {
           std::cout << "  Node " << node_id 
                     << ": sent=" << metrics.messages_sent
                     << ", received=" << metrics.messages_received << std::endl;
@@ -272,16 +1813,38 @@ int main(int argc, char* argv[]) {
     }
     std::cout << "Total messages sent: " << total_sent << std::endl;
     std::cout << "Total messages received: " << total_received << std::endl;
+    printMemoryUsage(memory, manager.getNodeCount());
+    if (memory_report) {
+      AllocTracker::print(heap, manager.getNodeCount(), std::cout);
+    }
+    
+    // Link latency percentiles (only in-process traffic passes the simulator)
+    LatencyHistogram latency = network.getGlobalLatencyHistogram();
+    if (latency.getCount() > 0) {
+      std::cout << "Link latency (ms): p50=" << latency.getPercentile(50.0)
+                << " p95=" << latency.getPercentile(95.0)
+                << " p99=" << latency.getPercentile(99.0)
+                << " p999=" << latency.getPercentile(99.9)
+                << " max=" << latency.getMax() << std::endl;
+    }
+    loop_monitor.print(std::cout, SLOW_NODES_REPORTED);
     std::cout << "==========================" << std::endl;
     
-    std::cout << "\n[INFO] Simulation completed successfully" << std::endl;
+    // Where the CPU time went, per firmware type and costliest nodes
+    if (profiler) {
+      profiler->collect(manager);
+      FirmwareProfiler::print(profiler->report(options.profile_top),
+                              static_cast<double>(clock.wallElapsedUs()) / 1000.0, std::cout);
+    }
+    
+    SIM_LOG_INFO("\n[INFO] Simulation completed successfully");
     return 0;
     
   } catch (const std::exception& e) {
-    std::cerr << "\n[ERROR] Unhandled exception: " << e.what() << std::endl;
+    SIM_LOG_ERROR("\n[ERROR] Unhandled exception: {}", e.what());
     return 1;
   } catch (...) {
-    std::cerr << "\n[ERROR] Unknown exception occurred" << std::endl;
+    SIM_LOG_ERROR("\n[ERROR] Unknown exception occurred");
     return 1;
   }
 }
@@ -0,0 +1,220 @@
+/**
+ * @file connectivity_tracker.cpp
+ * @brief Implementation of ConnectivityTracker class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/connectivity_tracker.hpp"
+#include "simulator/mesh_transport.hpp"
+#include "simulator/network_simulator.hpp"
+#include "simulator/node_manager.hpp"
+
+#include <algorithm>
+
+namespace simulator {
+
+constexpr uint32_t ConnectivityTracker::NO_SLOT;
+
+ConnectivityTracker::ConnectivityTracker(const NetworkSimulator& network,
+                                         const MeshTransport& transport)
+  : network_(network), transport_(transport) {}
+
+void ConnectivityTracker::reset(const NodeManager& manager) {
+  slots_.clear();
+  ids_.clear();
+  parent_.clear();
+  size_.clear();
+  min_id_.clear();
+  running_.clear();
+  manager.forEachNode([this](const VirtualNode& node) {
+    running_[slotOf(node.getNodeId())] = node.isRunning() ? 1 : 0;
+  });
+  stale_ = true;
+}
+
+size_t ConnectivityTracker::getComponentCount() {
+  if (stale_) {
+    rebuild();
+  }
+  return components_;
+}
+
+uint32_t ConnectivityTracker::getComponent(uint32_t node) {
+  if (stale_) {
+    rebuild();
+  }
+  const uint32_t slot = findSlot(node);
+  if (slot == NO_SLOT || !running_[slot]) {
+    return 0;
+  }
+  return min_id_[find(slot)];
+}
+
+void ConnectivityTracker::linkChanged(uint32_t a, uint32_t b, bool up) {
+  if (up) {
+    if (!stale_ && isUp(a, b)) {
+      unite(findSlot(a), findSlot(b));
+    }
+  } else {
+    splitIfJoined(a, b);
+  }
+  if (next_) {
+    next_->linkChanged(a, b, up);
+  }
+}
+
+void ConnectivityTracker::connectionChanged(uint32_t from, uint32_t to, bool active) {
+  if (transport_.hasLink(from, to)) {
+    if (!active) {
+      splitIfJoined(from, to);
+    } else if (!stale_ && isUp(from, to)) {
+      unite(findSlot(from), findSlot(to));
+    }
+  }
+  if (next_) {
+    next_->connectionChanged(from, to, active);
+  }
+}
+
+void ConnectivityTracker::partitionChanged(uint32_t node, uint32_t label) {
+  const uint32_t slot = findSlot(node);
+  if (!stale_ && slot != NO_SLOT && running_[slot]) {
+    // Leaving a shared component may split it; a node alone can only join
+    if (size_[find(slot)] > 1) {
+      stale_ = true;
+    } else {
+      joinNeighbours(node);
+    }
+  }
+  if (next_) {
+    next_->partitionChanged(node, label);
+  }
+}
+
+void ConnectivityTracker::partitionsCleared() {
+  stale_ = true;
+  if (next_) {
+    next_->partitionsCleared();
+  }
+}
+
+void ConnectivityTracker::nodeChanged(uint32_t node, NodeTransition transition) {
+  const uint32_t slot = slotOf(node);
+  const bool running = transition == NodeTransition::START;
+  if (running != (running_[slot] != 0)) {
+    if (running) {
+      running_[slot] = 1;
+      if (!stale_) {
+        // A started node is its own component until its links join it
+        parent_[slot] = slot;
+        size_[slot] = 1;
+        min_id_[slot] = node;
+        ++components_;
+        joinNeighbours(node);
+      }
+    } else {
+      if (!stale_) {
+        if (size_[find(slot)] > 1) {
+          stale_ = true;
+        } else {
+          --components_;
+        }
+      }
+      running_[slot] = 0;
+    }
+  }
+  if (next_) {
+    next_->nodeChanged(node, transition);
+  }
+}
+
+uint32_t ConnectivityTracker::slotOf(uint32_t node) {
+  auto inserted = slots_.emplace(node, static_cast<uint32_t>(ids_.size()));
+  if (inserted.second) {
+    const uint32_t slot = inserted.first->second;
+    ids_.push_back(node);
+    parent_.push_back(slot);
+    size_.push_back(1);
+    min_id_.push_back(node);
+    running_.push_back(0);
+  }
+  return inserted.first->second;
+}
+
+uint32_t ConnectivityTracker::findSlot(uint32_t node) const {
+  auto it = slots_.find(node);
+  return it == slots_.end() ? NO_SLOT : it->second;
+}
+
+uint32_t ConnectivityTracker::find(uint32_t slot) {
+  while (parent_[slot] != slot) {
+    parent_[slot] = parent_[parent_[slot]];
+    slot = parent_[slot];
+  }
+  return slot;
+}
+
+void ConnectivityTracker::unite(uint32_t a, uint32_t b) {
+  a = find(a);
+  b = find(b);
+  if (a == b) {
+    return;
+  }
+  if (size_[a] < size_[b]) {
+    std::swap(a, b);
+  }
+  parent_[b] = a;
+  size_[a] += size_[b];
+  min_id_[a] = std::min(min_id_[a], min_id_[b]);
+  --components_;
+}
+
+bool ConnectivityTracker::isUp(uint32_t a, uint32_t b) const {
+  const uint32_t slot_a = findSlot(a);
+  const uint32_t slot_b = findSlot(b);
+  return slot_a != NO_SLOT && slot_b != NO_SLOT && running_[slot_a] && running_[slot_b] &&
+         transport_.hasLink(a, b) && network_.isConnectionActive(a, b) &&
+         network_.isConnectionActive(b, a);
+}
+
+void ConnectivityTracker::joinNeighbours(uint32_t node) {
+  const uint32_t slot = findSlot(node);
+  for (uint32_t neighbour : transport_.getNeighbours(node)) {
+    if (isUp(node, neighbour)) {
+      unite(slot, findSlot(neighbour));
+    }
+  }
+}
+
+void ConnectivityTracker::splitIfJoined(uint32_t a, uint32_t b) {
+  if (stale_) {
+    return;
+  }
+  const uint32_t slot_a = findSlot(a);
+  const uint32_t slot_b = findSlot(b);
+  if (slot_a != NO_SLOT && slot_b != NO_SLOT && running_[slot_a] && running_[slot_b] &&
+      find(slot_a) == find(slot_b)) {
+    stale_ = true;
+  }
+}
+
+void ConnectivityTracker::rebuild() {
+  components_ = 0;
+  for (uint32_t slot = 0; slot < ids_.size(); ++slot) {
+    parent_[slot] = slot;
+    size_[slot] = 1;
+    min_id_[slot] = ids_[slot];
+    components_ += running_[slot];
+  }
+  stale_ = false;
+  for (const auto& link : transport_.getLinks()) {
+    if (isUp(link.first, link.second)) {
+      unite(findSlot(link.first), findSlot(link.second));
+    }
+  }
+  ++rebuilds_;
+}
+
+} // namespace simulator
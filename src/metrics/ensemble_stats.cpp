@@ -0,0 +1,134 @@
+/**
+ * @file ensemble_stats.cpp
+ * @brief Implementation of RunningStats and EnsembleStats classes
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/ensemble_stats.hpp"
+
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+
+namespace simulator {
+
+constexpr uint64_t EnsembleStats::MIN_RUNS;
+
+namespace {
+
+/**
+ * @brief Two-sided 95% quantile of Student's t distribution
+ *
+ * @param df Degrees of freedom (at least 1)
+ */
+double studentT95(uint64_t df) {
+  static const double TABLE[] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+  };
+  const uint64_t size = sizeof(TABLE) / sizeof(TABLE[0]);
+  if (df <= size) {
+    return TABLE[df - 1];
+  }
+  // Within 0.01 of the exact quantile past 30 degrees of freedom
+  return df <= 60 ? 2.000 : df <= 120 ? 1.980 : 1.960;
+}
+
+} // anonymous namespace
+
+void RunningStats::add(double value) {
+  count_++;
+  const double delta = value - mean_;
+  mean_ += delta / static_cast<double>(count_);
+  m2_ += delta * (value - mean_);
+}
+
+void RunningStats::merge(const RunningStats& other) {
+  if (other.count_ == 0) {
+    return;
+  }
+  if (count_ == 0) {
+    *this = other;
+    return;
+  }
+  const double n_a = static_cast<double>(count_);
+  const double n_b = static_cast<double>(other.count_);
+  const double n = n_a + n_b;
+  const double delta = other.mean_ - mean_;
+  mean_ += delta * n_b / n;
+  m2_ += other.m2_ + delta * delta * n_a * n_b / n;
+  count_ += other.count_;
+}
+
+double RunningStats::getVariance() const {
+  return count_ > 1 ? m2_ / static_cast<double>(count_ - 1) : 0.0;
+}
+
+double RunningStats::getStdDev() const {
+  return std::sqrt(getVariance());
+}
+
+double RunningStats::getConfidenceHalfWidth() const {
+  if (count_ < 2) {
+    return std::numeric_limits<double>::infinity();
+  }
+  return studentT95(count_ - 1) * getStdDev() / std::sqrt(static_cast<double>(count_));
+}
+
+void EnsembleStats::addRun(const SweepResult& run, const LatencyHistogram& latency) {
+  runs_++;
+  messages_sent_ += run.messages_sent;
+  link_delivered_ += run.link_delivered;
+  link_lost_ += run.link_lost;
+  // A run without link traffic says nothing about delivery
+  if (run.hasTraffic()) {
+    delivery_ratio_.add(run.getDeliveryRatio());
+  }
+  if (latency.getCount() > 0) {
+    latency_p99_.add(latency.getPercentile(99.0));
+  }
+  messages_received_.add(static_cast<double>(run.messages_received));
+  latency_.merge(latency);
+}
+
+bool EnsembleStats::isConverged(double max_width) const {
+  return delivery_ratio_.getCount() >= MIN_RUNS &&
+         2.0 * delivery_ratio_.getConfidenceHalfWidth() < max_width;
+}
+
+void EnsembleStats::print(std::ostream& out) const {
+  auto interval = [&out](const RunningStats& stats) {
+    out << stats.getMean();
+    if (stats.getCount() > 1) {
+      out << " +/- " << stats.getConfidenceHalfWidth();
+    }
+    out << " (n=" << stats.getCount() << ")";
+  };
+
+  const auto flags = out.flags();
+  const auto precision = out.precision();
+  out << std::fixed << std::setprecision(4);
+  out << "Runs: " << runs_ << " completed, " << failures_ << " failed\n";
+  out << "Delivery ratio: ";
+  interval(delivery_ratio_);
+  out << "\nLink latency p99 (ms): ";
+  interval(latency_p99_);
+  out << "\nMessages received per run: ";
+  interval(messages_received_);
+  out << "\n";
+  out.flags(flags);
+  out.precision(precision);
+
+  out << "Link latency, all runs (ms): p50=" << latency_.getPercentile(50.0)
+      << " p95=" << latency_.getPercentile(95.0)
+      << " p99=" << latency_.getPercentile(99.0)
+      << " samples=" << latency_.getCount() << "\n";
+  out << "Messages sent: " << messages_sent_ << "\n";
+  out << "Link messages: " << link_delivered_ << " delivered, " << link_lost_ << " lost\n";
+}
+
+} // namespace simulator
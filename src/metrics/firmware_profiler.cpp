@@ -0,0 +1,241 @@
+/**
+ * @file firmware_profiler.cpp
+ * @brief Implementation of FirmwareProfiler and call statistics
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/firmware_profiler.hpp"
+#include "simulator/firmware/firmware_base.hpp"
+#include "simulator/node_manager.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <map>
+
+namespace simulator {
+
+constexpr size_t CallStats::BUCKET_COUNT;
+
+namespace {
+
+// Bucket b holds durations with bit width b: 0 -> 0, 1 -> 1, 2 -> 2..3, ...
+size_t bucketFor(uint64_t duration) {
+  size_t bucket = 0;
+  while (duration != 0) {
+    duration >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+uint64_t bucketUpperBound(size_t bucket) {
+  return bucket >= 64 ? UINT64_MAX : (uint64_t{1} << bucket) - 1;
+}
+
+// Formats a duration with a unit that keeps 3-4 significant digits
+std::string formatMs(double ms) {
+  char buffer[32];
+  if (ms >= 1000.0) {
+    std::snprintf(buffer, sizeof(buffer), "%.2f s", ms / 1000.0);
+  } else if (ms >= 1.0) {
+    std::snprintf(buffer, sizeof(buffer), "%.2f ms", ms);
+  } else {
+    std::snprintf(buffer, sizeof(buffer), "%.2f us", ms * 1000.0);
+  }
+  return buffer;
+}
+
+std::string formatShare(uint64_t part, uint64_t total) {
+  char buffer[16];
+  std::snprintf(buffer, sizeof(buffer), "%.1f%%",
+                total > 0 ? 100.0 * static_cast<double>(part) / static_cast<double>(total) : 0.0);
+  return buffer;
+}
+
+// Costliest first; ties by firmware name, then node ID, for stable output
+bool costlier(const ProfileEntry& a, const ProfileEntry& b) {
+  if (a.ticks != b.ticks) {
+    return a.ticks > b.ticks;
+  }
+  if (a.firmware != b.firmware) {
+    return a.firmware < b.firmware;
+  }
+  return a.node_id < b.node_id;
+}
+
+void printCalls(const ProfileReport& report, const ProfileEntry& entry, std::ostream& out) {
+  for (size_t i = 0; i < PROFILED_CALL_COUNT; ++i) {
+    const auto call = static_cast<ProfiledCall>(i);
+    const CallStats& stats = entry.profile.get(call);
+    if (stats.calls == 0) {
+      continue;
+    }
+    out << "    " << profiledCallName(call) << ": " << formatMs(report.toMs(stats.ticks))
+        << " (" << formatShare(stats.ticks, entry.ticks) << "), " << stats.calls << " calls"
+        << ", mean " << formatMs(report.toMs(stats.ticks) / static_cast<double>(stats.calls))
+        << ", p99 <= " << formatMs(report.toMs(stats.getPercentileTicks(99.0)))
+        << ", max " << formatMs(report.toMs(stats.max_ticks)) << "\n";
+  }
+}
+
+} // anonymous namespace
+
+const char* profiledCallName(ProfiledCall call) {
+  switch (call) {
+    case ProfiledCall::MESH_UPDATE: return "mesh_update";
+    case ProfiledCall::SETUP: return "setup";
+    case ProfiledCall::LOOP: return "loop";
+    case ProfiledCall::RECEIVE: return "receive";
+    case ProfiledCall::NEW_CONNECTION: return "new_connection";
+    case ProfiledCall::CHANGED_CONNECTIONS: return "changed_connections";
+    case ProfiledCall::TASKS: return "tasks";
+  }
+  return "unknown";
+}
+
+void CallStats::record(uint64_t duration) {
+  calls++;
+  ticks += duration;
+  max_ticks = std::max(max_ticks, duration);
+  buckets[bucketFor(duration)]++;
+}
+
+void CallStats::merge(const CallStats& other) {
+  calls += other.calls;
+  ticks += other.ticks;
+  max_ticks = std::max(max_ticks, other.max_ticks);
+  for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+    buckets[i] += other.buckets[i];
+  }
+}
+
+uint64_t CallStats::getPercentileTicks(double percentile) const {
+  if (calls == 0) {
+    return 0;
+  }
+  const double clamped = std::min(100.0, std::max(0.0, percentile));
+  const auto rank = std::max<uint64_t>(
+    1, static_cast<uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(calls))));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      return std::min(bucketUpperBound(i), max_ticks);
+    }
+  }
+  return max_ticks;
+}
+
+void CallProfile::merge(const CallProfile& other) {
+  for (size_t i = 0; i < PROFILED_CALL_COUNT; ++i) {
+    stats_[i].merge(other.stats_[i]);
+  }
+}
+
+uint64_t CallProfile::getTotalTicks() const {
+  uint64_t total = 0;
+  for (const auto& stats : stats_) {
+    total += stats.ticks;
+  }
+  return total;
+}
+
+FirmwareProfiler::FirmwareProfiler()
+  : start_time_(Clock::now()), start_ticks_(readCycleCounter()) {
+}
+
+void FirmwareProfiler::add(uint32_t node_id, const std::string& firmware,
+                           const CallProfile& profile) {
+  ProfileEntry entry;
+  entry.firmware = firmware;
+  entry.node_id = node_id;
+  entry.nodes = 1;
+  entry.profile = profile;
+  entry.ticks = profile.getTotalTicks();
+  nodes_.push_back(std::move(entry));
+}
+
+void FirmwareProfiler::collect(const NodeManager& manager) {
+  manager.forEachNode([this](const VirtualNode& node) {
+    const CallProfile* profile = node.getProfile();
+    if (profile) {
+      const firmware::FirmwareBase* firmware = node.getFirmware();
+      add(node.getNodeId(), firmware ? firmware->getName() : "(none)", *profile);
+    }
+  });
+}
+
+ProfileReport FirmwareProfiler::report(size_t top_nodes) const {
+  ProfileReport report;
+
+  // Ticks per nanosecond over the whole profiled period
+  const uint64_t ticks = readCycleCounter() - start_ticks_;
+  const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    Clock::now() - start_time_).count();
+  if (ticks > 0 && ns > 0) {
+    report.ns_per_tick = static_cast<double>(ns) / static_cast<double>(ticks);
+  }
+
+  std::map<std::string, ProfileEntry> by_firmware;
+  for (const auto& node : nodes_) {
+    ProfileEntry& total = by_firmware[node.firmware];
+    total.firmware = node.firmware;
+    total.nodes++;
+    total.profile.merge(node.profile);
+    total.ticks += node.ticks;
+    report.total_ticks += node.ticks;
+  }
+  report.nodes = static_cast<uint32_t>(nodes_.size());
+  for (auto& entry : by_firmware) {
+    report.firmwares.push_back(std::move(entry.second));
+  }
+  std::sort(report.firmwares.begin(), report.firmwares.end(), costlier);
+
+  // Rank pointers; node entries are large
+  std::vector<const ProfileEntry*> ranked;
+  ranked.reserve(nodes_.size());
+  for (const auto& node : nodes_) {
+    ranked.push_back(&node);
+  }
+  const size_t count = std::min(top_nodes, ranked.size());
+  std::partial_sort(ranked.begin(), ranked.begin() + count, ranked.end(),
+                    [](const ProfileEntry* a, const ProfileEntry* b) { return costlier(*a, *b); });
+  for (size_t i = 0; i < count; ++i) {
+    report.top_nodes.push_back(*ranked[i]);
+  }
+  return report;
+}
+
+void FirmwareProfiler::print(const ProfileReport& report, double wall_ms, std::ostream& out) {
+  out << "\n=== Firmware Profile ===\n";
+  out << "Profiled time: " << formatMs(report.toMs(report.total_ticks)) << " in "
+      << report.nodes << " nodes";
+  if (wall_ms > 0.0) {
+    char share[16];
+    std::snprintf(share, sizeof(share), "%.1f%%", 100.0 * report.toMs(report.total_ticks) / wall_ms);
+    out << " (" << share << " of " << formatMs(wall_ms) << " wall time, summed over threads)";
+  }
+  out << "\n";
+
+  out << "\nBy firmware:\n";
+  for (const auto& entry : report.firmwares) {
+    out << "  " << entry.firmware << ": " << formatMs(report.toMs(entry.ticks)) << " ("
+        << formatShare(entry.ticks, report.total_ticks) << ") over " << entry.nodes << " nodes\n";
+    printCalls(report, entry, out);
+  }
+
+  if (!report.top_nodes.empty()) {
+    out << "\nTop " << report.top_nodes.size() << " nodes:\n";
+    for (const auto& entry : report.top_nodes) {
+      out << "  Node " << entry.node_id << " (" << entry.firmware << "): "
+          << formatMs(report.toMs(entry.ticks)) << " ("
+          << formatShare(entry.ticks, report.total_ticks) << ")\n";
+      printCalls(report, entry, out);
+    }
+  }
+}
+
+} // namespace simulator
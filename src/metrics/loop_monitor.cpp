@@ -0,0 +1,188 @@
+/**
+ * @file loop_monitor.cpp
+ * @brief Implementation of LoopMonitor class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/loop_monitor.hpp"
+#include "simulator/firmware/firmware_base.hpp"
+#include "simulator/logger.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace simulator {
+
+namespace {
+
+void printPercentiles(const char* label, const LatencyHistogram& histogram, std::ostream& out) {
+  out << label << " (us): p50=" << histogram.getPercentile(50.0)
+      << " p99=" << histogram.getPercentile(99.0)
+      << " max=" << histogram.getMax()
+      << " (" << histogram.getCount() << " recorded)\n";
+}
+
+} // anonymous namespace
+
+ProfiledCall UpdateTiming::slowestPhase() const {
+  if (loop_ns >= mesh_ns && loop_ns >= tasks_ns) {
+    return ProfiledCall::LOOP;
+  }
+  return tasks_ns > mesh_ns ? ProfiledCall::TASKS : ProfiledCall::MESH_UPDATE;
+}
+
+LoopMonitor::LoopMonitor(uint32_t update_budget_us)
+  : budget_us_(update_budget_us) {
+  setWorkerCount(1);
+}
+
+void LoopMonitor::setWorkerCount(size_t workers) {
+  if (workers == 0) {
+    throw std::invalid_argument("Loop monitor needs at least one worker");
+  }
+  workers_.clear();
+  for (size_t i = 0; i < workers; ++i) {
+    workers_.emplace_back(new Worker());
+  }
+}
+
+void LoopMonitor::recordUpdate(size_t worker, uint32_t node_id, const UpdateTiming& timing,
+                               const firmware::FirmwareBase* firmware) {
+  Worker& slot = *workers_[worker];
+  const uint64_t duration_ns = timing.totalNs();
+  const uint64_t duration_us = duration_ns / 1000;
+  slot.updates.record(clampUs(duration_us));
+  if (node_costs_) {
+    NodeCost& cost = slot.costs[node_id];
+    if (cost.updates == 0) {
+      cost.node_id = node_id;
+      cost.firmware = firmware ? firmware->getName() : "(none)";
+    }
+    cost.updates++;
+    cost.total_ns += duration_ns;
+    cost.worst_ns = std::max(cost.worst_ns, duration_ns);
+  }
+  if (budget_us_ == 0 || duration_us <= budget_us_) {
+    return;
+  }
+
+  slot.slow_updates++;
+  SlowNode& node = slot.slow[node_id];
+  const bool first = node.slow_updates == 0;
+  node.slow_updates++;
+  if (duration_us > node.worst_us) {
+    node.worst_us = duration_us;
+    node.worst_phase = timing.slowestPhase();
+  }
+  if (first) {
+    node.node_id = node_id;
+    node.firmware = firmware ? firmware->getName() : "(none)";
+    SIM_LOG_WARN("[WARN] Node {} ({}) update took {} us, over the {} us budget, mostly in {}",
+                 node_id, node.firmware, duration_us, budget_us_,
+                 profiledCallName(node.worst_phase));
+  }
+}
+
+LatencyHistogram LoopMonitor::getUpdateHistogram() const {
+  LatencyHistogram merged;
+  for (const auto& worker : workers_) {
+    merged.merge(worker->updates);
+  }
+  return merged;
+}
+
+uint64_t LoopMonitor::getSlowUpdateCount() const {
+  uint64_t count = 0;
+  for (const auto& worker : workers_) {
+    count += worker->slow_updates;
+  }
+  return count;
+}
+
+std::vector<SlowNode> LoopMonitor::getSlowNodes() const {
+  // A node moved between shards may be slow on several workers
+  std::unordered_map<uint32_t, SlowNode> merged;
+  for (const auto& worker : workers_) {
+    for (const auto& pair : worker->slow) {
+      SlowNode& node = merged[pair.first];
+      if (node.slow_updates == 0) {
+        node = pair.second;
+        continue;
+      }
+      node.slow_updates += pair.second.slow_updates;
+      if (pair.second.worst_us > node.worst_us) {
+        node.worst_us = pair.second.worst_us;
+        node.worst_phase = pair.second.worst_phase;
+      }
+    }
+  }
+
+  std::vector<SlowNode> nodes;
+  nodes.reserve(merged.size());
+  for (auto& pair : merged) {
+    nodes.push_back(std::move(pair.second));
+  }
+  std::sort(nodes.begin(), nodes.end(), [](const SlowNode& a, const SlowNode& b) {
+    return a.worst_us != b.worst_us ? a.worst_us > b.worst_us : a.node_id < b.node_id;
+  });
+  return nodes;
+}
+
+void LoopMonitor::setNodeCosts(bool enabled) {
+  node_costs_ = enabled;
+  for (auto& worker : workers_) {
+    worker->costs.clear();
+  }
+}
+
+std::vector<NodeCost> LoopMonitor::getNodeCosts() const {
+  std::unordered_map<uint32_t, NodeCost> merged;
+  for (const auto& worker : workers_) {
+    for (const auto& pair : worker->costs) {
+      NodeCost& node = merged[pair.first];
+      if (node.updates == 0) {
+        node = pair.second;
+        continue;
+      }
+      node.updates += pair.second.updates;
+      node.total_ns += pair.second.total_ns;
+      node.worst_ns = std::max(node.worst_ns, pair.second.worst_ns);
+    }
+  }
+
+  std::vector<NodeCost> nodes;
+  nodes.reserve(merged.size());
+  for (auto& pair : merged) {
+    nodes.push_back(std::move(pair.second));
+  }
+  std::sort(nodes.begin(), nodes.end(), [](const NodeCost& a, const NodeCost& b) {
+    return a.total_ns != b.total_ns ? a.total_ns > b.total_ns : a.node_id < b.node_id;
+  });
+  return nodes;
+}
+
+void LoopMonitor::print(std::ostream& out, size_t top_nodes) const {
+  if (ticks_.getCount() > 0) {
+    printPercentiles("Tick time", ticks_, out);
+  }
+  const LatencyHistogram updates = getUpdateHistogram();
+  if (updates.getCount() > 0) {
+    printPercentiles("Node update time", updates, out);
+  }
+  if (budget_us_ == 0) {
+    return;
+  }
+
+  const std::vector<SlowNode> slow = getSlowNodes();
+  out << "Slow updates: " << getSlowUpdateCount() << " over the " << budget_us_
+      << " us budget on " << slow.size() << " nodes\n";
+  for (size_t i = 0; i < slow.size() && i < top_nodes; ++i) {
+    out << "  Node " << slow[i].node_id << " (" << slow[i].firmware << "): "
+        << slow[i].slow_updates << " slow, worst " << slow[i].worst_us << " us in "
+        << profiledCallName(slow[i].worst_phase) << "\n";
+  }
+}
+
+} // namespace simulator
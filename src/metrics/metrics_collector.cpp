@@ -0,0 +1,532 @@
+/**
+ * @file metrics_collector.cpp
+ * @brief Implementation of MetricsCollector class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/metrics_collector.hpp"
+#include "simulator/connectivity_tracker.hpp"
+#include "simulator/logger.hpp"
+#include "simulator/mesh_transport.hpp"
+#include "simulator/network_simulator.hpp"
+#include "simulator/node_manager.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+namespace simulator {
+
+constexpr char MetricsCollector::BINARY_MAGIC[8];
+constexpr uint32_t MetricsCollector::BINARY_VERSION;
+
+namespace {
+
+bool endsWith(const std::string& text, const std::string& suffix) {
+  return text.size() >= suffix.size() &&
+         text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+void appendUint(std::string& line, uint64_t value) {
+  char buffer[24];
+  const int length = std::snprintf(buffer, sizeof(buffer), "%llu",
+                                   static_cast<unsigned long long>(value));
+  line.append(buffer, static_cast<size_t>(length));
+}
+
+void appendDouble(std::string& line, double value) {
+  char buffer[32];
+  const int length = std::snprintf(buffer, sizeof(buffer), "%.15g", value);
+  line.append(buffer, static_cast<size_t>(length));
+}
+
+void writeName(std::ofstream& out, const std::string& name) {
+  const uint32_t length = static_cast<uint32_t>(name.size());
+  out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+  out.write(name.data(), static_cast<std::streamsize>(name.size()));
+}
+
+template <typename T>
+void writeArray(std::ofstream& out, const T* data, size_t count) {
+  out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+}
+
+} // anonymous namespace
+
+/// Columns of each metric group, in output order
+const MetricsCollector::MetricGroup MetricsCollector::METRIC_GROUPS[] = {
+  {"message_count",
+   {{NodeColumn::MESSAGES_SENT, "messages_sent"},
+    {NodeColumn::MESSAGES_RECEIVED, "messages_received"}},
+   {{NetworkColumn::MESSAGES_SENT, "messages_sent"},
+    {NetworkColumn::MESSAGES_RECEIVED, "messages_received"}}},
+  {"packet_stats",
+   {{NodeColumn::BYTES_SENT, "bytes_sent"},
+    {NodeColumn::BYTES_RECEIVED, "bytes_received"}},
+   {{NetworkColumn::FRAMES_SENT, "frames_sent"},
+    {NetworkColumn::FRAMES_FORWARDED, "frames_forwarded"},
+    {NetworkColumn::FRAMES_DELIVERED, "frames_delivered"},
+    {NetworkColumn::FRAMES_DROPPED, "frames_dropped"},
+    {NetworkColumn::PENDING_MESSAGES, "pending_messages"}}},
+  {"delivery_rate",
+   {},
+   {{NetworkColumn::DELIVERY_RATE, "delivery_rate"}}},
+  {"latency_stats",
+   {},
+   {{NetworkColumn::LATENCY_SAMPLES, "latency_samples"},
+    {NetworkColumn::LATENCY_MIN_MS, "latency_min_ms"},
+    {NetworkColumn::LATENCY_P50_MS, "latency_p50_ms"},
+    {NetworkColumn::LATENCY_P95_MS, "latency_p95_ms"},
+    {NetworkColumn::LATENCY_P99_MS, "latency_p99_ms"},
+    {NetworkColumn::LATENCY_MAX_MS, "latency_max_ms"}}},
+  {"node_uptime",
+   {{NodeColumn::RUNNING, "running"},
+    {NodeColumn::UPTIME_MS, "uptime_ms"},
+    {NodeColumn::CRASH_COUNT, "crash_count"}},
+   {{NetworkColumn::NODES_RUNNING, "nodes_running"}}},
+  {"connectivity",
+   {{NodeColumn::COMPONENT, "component"}},
+   {{NetworkColumn::COMPONENTS, "components"}}},
+  {"link_stats",
+   {},
+   {{NetworkColumn::LINK_MESSAGES, "link_messages"},
+    {NetworkColumn::LINK_DELIVERED, "link_delivered"},
+    {NetworkColumn::LINK_DROPPED, "link_dropped"},
+    {NetworkColumn::LINK_THROTTLED, "link_throttled"},
+    {NetworkColumn::LINK_BYTES, "link_bytes"},
+    {NetworkColumn::LINK_LATENCY_AVG_MS, "link_latency_avg_ms"},
+    {NetworkColumn::ACTIVE_LINKS, "active_links"}}},
+};
+
+void MetricsCollector::makeParentDirectories(const std::string& file) {
+  for (size_t pos = file.find_first_of("/\\", 1); pos != std::string::npos;
+       pos = file.find_first_of("/\\", pos + 1)) {
+    const std::string dir = file.substr(0, pos);
+#ifdef _WIN32
+    const int result = _mkdir(dir.c_str());
+#else
+    const int result = mkdir(dir.c_str(), 0755);
+#endif
+    if (result != 0 && errno != EEXIST) {
+      throw std::runtime_error("Failed to create metrics directory: " + dir);
+    }
+  }
+}
+
+std::string MetricsCollector::basePath(const std::string& output) {
+  for (const char* extension : {".csv", ".json", ".pmm"}) {
+    if (endsWith(output, extension)) {
+      return output.substr(0, output.size() - std::strlen(extension));
+    }
+  }
+  return output;
+}
+
+MetricsCollector::MetricsCollector(const MetricsConfig& config)
+  : base_(basePath(config.output)), interval_us_(uint64_t(config.interval) * 1000000) {
+  if (config.output.empty()) {
+    throw std::invalid_argument("Metrics output path is empty");
+  }
+  if (config.interval == 0) {
+    throw std::invalid_argument("Metrics interval must be greater than 0");
+  }
+
+  for (const auto& name : config.export_formats) {
+    if (!isKnownFormat(name)) {
+      throw std::invalid_argument("Unknown metrics export format: " + name);
+    }
+  }
+
+  auto listed = [&config](const std::string& name) {
+    return std::find(config.collect.begin(), config.collect.end(), name) != config.collect.end();
+  };
+  auto exports = [&config](const char* name) {
+    return std::find(config.export_formats.begin(), config.export_formats.end(), name) !=
+           config.export_formats.end();
+  };
+
+  // A column is collected with its group or when listed by name
+  std::vector<std::string> known;
+  for (const auto& group : METRIC_GROUPS) {
+    known.push_back(group.name);
+    const bool whole = config.collect.empty() || listed(group.name);
+    for (const auto& column : group.node_columns) {
+      known.push_back(column.name);
+      if (whole || listed(column.name)) {
+        node_columns_.push_back(column.column);
+        node_column_names_.push_back(column.name);
+      }
+    }
+    for (const auto& column : group.network_columns) {
+      known.push_back(column.name);
+      if (whole || listed(column.name)) {
+        network_columns_.push_back(column.column);
+        network_column_names_.push_back(column.name);
+        link_columns_ = link_columns_ || std::string(group.name) == "link_stats";
+      }
+    }
+  }
+  for (const auto& name : config.collect) {
+    if (std::find(known.begin(), known.end(), name) == known.end()) {
+      SIM_LOG_WARN("[WARN] Metric {} is not collected", name);
+    }
+  }
+
+  csv_ = config.export_formats.empty() || exports("csv");
+  json_ = exports("json");
+  binary_ = exports("binary");
+  // topology and graphviz are written by TopologyRecorder
+}
+
+MetricsCollector::~MetricsCollector() {
+  try {
+    close();
+  } catch (const std::exception& e) {
+    SIM_LOG_ERROR("[ERROR] Failed to finish metrics files: {}", e.what());
+  }
+}
+
+std::ofstream MetricsCollector::openFile(const std::string& path) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    throw std::runtime_error("Failed to create metrics file: " + path);
+  }
+  files_.push_back(path);
+  return out;
+}
+
+void MetricsCollector::open() {
+  if (open_) {
+    return;
+  }
+  makeParentDirectories(base_);
+  files_.clear();
+
+  if (csv_) {
+    csv_nodes_ = openFile(base_ + ".csv");
+    csv_network_ = openFile(base_ + "_network.csv");
+    csv_nodes_ << "time_ms,node";
+    for (const auto& name : node_column_names_) {
+      csv_nodes_ << ',' << name;
+    }
+    csv_nodes_ << '\n';
+    csv_network_ << "time_ms,nodes";
+    for (const auto& name : network_column_names_) {
+      csv_network_ << ',' << name;
+    }
+    csv_network_ << '\n';
+  }
+  if (json_) {
+    json_out_ = openFile(base_ + ".json");
+  }
+  if (binary_) {
+    binary_out_ = openFile(base_ + ".pmm");
+    binary_out_.write(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    writeArray(binary_out_, &BINARY_VERSION, 1);
+    const uint32_t node_count = static_cast<uint32_t>(node_column_names_.size());
+    writeArray(binary_out_, &node_count, 1);
+    for (const auto& name : node_column_names_) {
+      writeName(binary_out_, name);
+    }
+    const uint32_t network_count = static_cast<uint32_t>(network_column_names_.size());
+    writeArray(binary_out_, &network_count, 1);
+    for (const auto& name : network_column_names_) {
+      writeName(binary_out_, name);
+    }
+  }
+
+  back_ready_ = false;
+  stopping_ = false;
+  error_ = nullptr;
+  open_ = true;
+  writer_ = std::thread(&MetricsCollector::writerLoop, this);
+}
+
+void MetricsCollector::sample(uint64_t time_us, const NodeManager& manager,
+                              const NetworkSimulator& network, const MeshTransport* transport) {
+  const size_t count = manager.getNodeCount();
+  front_.time_us = time_us;
+  front_.node_ids.resize(count);
+  front_.node_values.resize(node_columns_.size() * count);
+  front_.network_values.resize(network_columns_.size());
+
+  uint64_t sent = 0;
+  uint64_t received = 0;
+  uint64_t running = 0;
+  size_t index = 0;
+  manager.forEachNode([&](const VirtualNode& node) {
+    const NodeMetrics metrics = node.getMetrics();
+    sent += metrics.messages_sent;
+    received += metrics.messages_received;
+    running += node.isRunning() ? 1 : 0;
+
+    front_.node_ids[index] = node.getNodeId();
+    for (size_t c = 0; c < node_columns_.size(); ++c) {
+      uint64_t value = 0;
+      switch (node_columns_[c]) {
+        case NodeColumn::MESSAGES_SENT: value = metrics.messages_sent; break;
+        case NodeColumn::MESSAGES_RECEIVED: value = metrics.messages_received; break;
+        case NodeColumn::BYTES_SENT: value = metrics.bytes_sent; break;
+        case NodeColumn::BYTES_RECEIVED: value = metrics.bytes_received; break;
+        case NodeColumn::RUNNING: value = node.isRunning() ? 1 : 0; break;
+        case NodeColumn::UPTIME_MS: value = metrics.total_uptime_ms + node.getUptime(); break;
+        case NodeColumn::CRASH_COUNT: value = metrics.crash_count; break;
+        case NodeColumn::COMPONENT:
+          value = connectivity_ ? connectivity_->getComponent(node.getNodeId()) : 0;
+          break;
+      }
+      front_.node_values[c * count + index] = value;
+    }
+    ++index;
+  });
+
+  TransportStats frames;
+  if (transport) {
+    frames = transport->getStats();
+  }
+  const bool latency = std::find(network_columns_.begin(), network_columns_.end(),
+                                 NetworkColumn::LATENCY_SAMPLES) != network_columns_.end();
+  const LatencyHistogram histogram = latency ? network.getGlobalLatencyHistogram()
+                                             : LatencyHistogram();
+  const uint64_t attempted = frames.frames_delivered + frames.frames_dropped;
+
+  // Link counters since the last sample, summed in one pass over the columns
+  uint64_t link_messages = 0;
+  uint64_t link_delivered = 0;
+  uint64_t link_dropped = 0;
+  uint64_t link_throttled = 0;
+  uint64_t link_bytes = 0;
+  uint64_t link_latency_ms = 0;
+  uint64_t active_links = 0;
+  if (link_columns_) {
+    network.snapshotStats(links_, &link_delta_);
+    for (size_t i = 0; i < link_delta_.size(); ++i) {
+      link_messages += link_delta_.message_count[i];
+      link_delivered += link_delta_.delivered_count[i];
+      link_dropped += link_delta_.dropped_count[i];
+      link_throttled += link_delta_.bandwidth_throttled[i];
+      link_bytes += link_delta_.bytes_sent[i];
+      link_latency_ms += link_delta_.total_latency_ms[i];
+      active_links += (link_delta_.delivered_count[i] | link_delta_.dropped_count[i] |
+                       link_delta_.bandwidth_throttled[i]) != 0 ? 1 : 0;
+    }
+  }
+
+  for (size_t c = 0; c < network_columns_.size(); ++c) {
+    double value = 0.0;
+    switch (network_columns_[c]) {
+      case NetworkColumn::MESSAGES_SENT: value = double(sent); break;
+      case NetworkColumn::MESSAGES_RECEIVED: value = double(received); break;
+      case NetworkColumn::FRAMES_SENT: value = double(frames.frames_sent); break;
+      case NetworkColumn::FRAMES_FORWARDED: value = double(frames.frames_forwarded); break;
+      case NetworkColumn::FRAMES_DELIVERED: value = double(frames.frames_delivered); break;
+      case NetworkColumn::FRAMES_DROPPED: value = double(frames.frames_dropped); break;
+      case NetworkColumn::PENDING_MESSAGES: value = double(network.getPendingMessageCount()); break;
+      case NetworkColumn::DELIVERY_RATE:
+        value = attempted > 0 ? double(frames.frames_delivered) / double(attempted) : 0.0;
+        break;
+      case NetworkColumn::LATENCY_SAMPLES: value = double(histogram.getCount()); break;
+      case NetworkColumn::LATENCY_MIN_MS: value = histogram.getMin(); break;
+      case NetworkColumn::LATENCY_P50_MS: value = histogram.getPercentile(50.0); break;
+      case NetworkColumn::LATENCY_P95_MS: value = histogram.getPercentile(95.0); break;
+      case NetworkColumn::LATENCY_P99_MS: value = histogram.getPercentile(99.0); break;
+      case NetworkColumn::LATENCY_MAX_MS: value = histogram.getMax(); break;
+      case NetworkColumn::NODES_RUNNING: value = double(running); break;
+      case NetworkColumn::COMPONENTS:
+        value = connectivity_ ? double(connectivity_->getComponentCount()) : 0.0;
+        break;
+      case NetworkColumn::LINK_MESSAGES: value = double(link_messages); break;
+      case NetworkColumn::LINK_DELIVERED: value = double(link_delivered); break;
+      case NetworkColumn::LINK_DROPPED: value = double(link_dropped); break;
+      case NetworkColumn::LINK_THROTTLED: value = double(link_throttled); break;
+      case NetworkColumn::LINK_BYTES: value = double(link_bytes); break;
+      case NetworkColumn::LINK_LATENCY_AVG_MS:
+        value = link_messages > 0 ? double(link_latency_ms) / double(link_messages) : 0.0;
+        break;
+      case NetworkColumn::ACTIVE_LINKS: value = double(active_links); break;
+    }
+    front_.network_values[c] = value;
+  }
+
+  submit(front_);
+}
+
+void MetricsCollector::submit(MetricsSnapshot& snapshot) {
+  if (!open_) {
+    throw std::runtime_error("Metrics collector is not open");
+  }
+  if (snapshot.node_values.size() != snapshot.node_ids.size() * node_columns_.size() ||
+      snapshot.network_values.size() != network_columns_.size()) {
+    throw std::invalid_argument("Metrics snapshot does not match the collected columns");
+  }
+
+  const uint64_t time_us = snapshot.time_us;
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (back_ready_) {
+    ++stalls_;
+    cv_.wait(lock, [this]() { return !back_ready_; });
+  }
+  std::swap(snapshot, back_);
+  back_ready_ = true;
+  lock.unlock();
+  cv_.notify_all();
+
+  ++samples_;
+  next_sample_us_ = (time_us / interval_us_ + 1) * interval_us_;
+}
+
+void MetricsCollector::close() {
+  if (!open_) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  writer_.join();
+  open_ = false;
+
+  bool failed = false;
+  for (std::ofstream* out : {&csv_nodes_, &csv_network_, &json_out_, &binary_out_}) {
+    if (out->is_open()) {
+      out->close();
+      failed = failed || out->fail();
+    }
+  }
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+  if (failed) {
+    throw std::runtime_error("Failed to write metrics files at " + base_);
+  }
+}
+
+void MetricsCollector::writerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    cv_.wait(lock, [this]() { return back_ready_ || stopping_; });
+    if (!back_ready_) {
+      break;
+    }
+    // back_ is ours until back_ready_ is cleared
+    lock.unlock();
+    if (!error_) {
+      try {
+        write(back_);
+      } catch (...) {
+        error_ = std::current_exception();
+      }
+    }
+    lock.lock();
+    back_ready_ = false;
+    cv_.notify_all();
+  }
+}
+
+void MetricsCollector::write(const MetricsSnapshot& snapshot) {
+  if (csv_) {
+    writeCsv(snapshot);
+  }
+  if (json_) {
+    writeJson(snapshot);
+  }
+  if (binary_) {
+    writeBinary(snapshot);
+  }
+}
+
+void MetricsCollector::writeCsv(const MetricsSnapshot& snapshot) {
+  const size_t count = snapshot.node_ids.size();
+  std::string time;
+  appendDouble(time, double(snapshot.time_us) / 1000.0);
+
+  for (size_t i = 0; i < count; ++i) {
+    line_ = time;
+    line_ += ',';
+    appendUint(line_, snapshot.node_ids[i]);
+    for (size_t c = 0; c < node_columns_.size(); ++c) {
+      line_ += ',';
+      appendUint(line_, snapshot.node_values[c * count + i]);
+    }
+    line_ += '\n';
+    csv_nodes_.write(line_.data(), static_cast<std::streamsize>(line_.size()));
+  }
+
+  line_ = time;
+  line_ += ',';
+  appendUint(line_, count);
+  for (double value : snapshot.network_values) {
+    line_ += ',';
+    appendDouble(line_, value);
+  }
+  line_ += '\n';
+  csv_network_.write(line_.data(), static_cast<std::streamsize>(line_.size()));
+  csv_nodes_.flush();
+  csv_network_.flush();
+}
+
+void MetricsCollector::writeJson(const MetricsSnapshot& snapshot) {
+  const size_t count = snapshot.node_ids.size();
+  line_ = "{\"time_ms\":";
+  appendDouble(line_, double(snapshot.time_us) / 1000.0);
+  line_ += ",\"nodes\":[";
+  for (size_t i = 0; i < count; ++i) {
+    if (i > 0) {
+      line_ += ',';
+    }
+    appendUint(line_, snapshot.node_ids[i]);
+  }
+  line_ += "],\"node\":{";
+  for (size_t c = 0; c < node_columns_.size(); ++c) {
+    if (c > 0) {
+      line_ += ',';
+    }
+    line_ += '"';
+    line_ += node_column_names_[c];
+    line_ += "\":[";
+    for (size_t i = 0; i < count; ++i) {
+      if (i > 0) {
+        line_ += ',';
+      }
+      appendUint(line_, snapshot.node_values[c * count + i]);
+    }
+    line_ += ']';
+  }
+  line_ += "},\"network\":{";
+  for (size_t c = 0; c < network_columns_.size(); ++c) {
+    if (c > 0) {
+      line_ += ',';
+    }
+    line_ += '"';
+    line_ += network_column_names_[c];
+    line_ += "\":";
+    appendDouble(line_, snapshot.network_values[c]);
+  }
+  line_ += "}}\n";
+  json_out_.write(line_.data(), static_cast<std::streamsize>(line_.size()));
+  json_out_.flush();
+}
+
+void MetricsCollector::writeBinary(const MetricsSnapshot& snapshot) {
+  const uint32_t count = static_cast<uint32_t>(snapshot.node_ids.size());
+  writeArray(binary_out_, &snapshot.time_us, 1);
+  writeArray(binary_out_, &count, 1);
+  writeArray(binary_out_, snapshot.node_ids.data(), snapshot.node_ids.size());
+  writeArray(binary_out_, snapshot.node_values.data(), snapshot.node_values.size());
+  writeArray(binary_out_, snapshot.network_values.data(), snapshot.network_values.size());
+  binary_out_.flush();
+}
+
+} // namespace simulator
@@ -0,0 +1,317 @@
+/**
+ * @file metrics_endpoint.cpp
+ * @brief Implementation of MetricsEndpoint class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/metrics_endpoint.hpp"
+#include "simulator/event_scheduler.hpp"
+#include "simulator/node_manager.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdarg>
+#include <cstdio>
+#include <istream>
+#include <memory>
+
+namespace simulator {
+
+constexpr size_t MetricsEndpoint::LATENCY_BOUND_COUNT;
+constexpr uint32_t MetricsEndpoint::DEFAULT_PUBLISH_MS;
+
+const uint32_t MetricsEndpoint::LATENCY_BOUNDS_MS[LATENCY_BOUND_COUNT] = {
+  1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000
+};
+
+namespace {
+
+/// Longest request head a scrape may send
+constexpr size_t MAX_REQUEST_BYTES = 8192;
+
+// Appends printf-formatted text (one metric line at most)
+void appendf(std::string& out, const char* format, ...) {
+  char buffer[256];
+  va_list args;
+  va_start(args, format);
+  const int length = std::vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+  if (length > 0) {
+    out.append(buffer, std::min(static_cast<size_t>(length), sizeof(buffer) - 1));
+  }
+}
+
+void appendHeader(std::string& out, const char* name, const char* type, const char* help) {
+  appendf(out, "# HELP painlessmesh_sim_%s %s\n# TYPE painlessmesh_sim_%s %s\n",
+          name, help, name, type);
+}
+
+void appendHistogram(std::string& out, const char* name, const char* labels,
+                     const uint64_t* cumulative, uint64_t count, uint64_t sum) {
+  const char* separator = labels[0] != '\0' ? "," : "";
+  for (size_t b = 0; b < MetricsEndpoint::LATENCY_BOUND_COUNT; ++b) {
+    appendf(out, "painlessmesh_sim_%s_bucket{%s%sle=\"%" PRIu32 "\"} %" PRIu64 "\n",
+            name, labels, separator, MetricsEndpoint::LATENCY_BOUNDS_MS[b], cumulative[b]);
+  }
+  appendf(out, "painlessmesh_sim_%s_bucket{%s%sle=\"+Inf\"} %" PRIu64 "\n",
+          name, labels, separator, count);
+  if (labels[0] != '\0') {
+    appendf(out, "painlessmesh_sim_%s_sum{%s} %" PRIu64 "\n", name, labels, sum);
+    appendf(out, "painlessmesh_sim_%s_count{%s} %" PRIu64 "\n", name, labels, count);
+  } else {
+    appendf(out, "painlessmesh_sim_%s_sum %" PRIu64 "\n", name, sum);
+    appendf(out, "painlessmesh_sim_%s_count %" PRIu64 "\n", name, count);
+  }
+}
+
+} // anonymous namespace
+
+/**
+ * @brief One HTTP connection: reads a request head, answers, closes
+ */
+class MetricsEndpoint::Session : public std::enable_shared_from_this<Session> {
+public:
+  Session(MetricsEndpoint& endpoint, boost::asio::ip::tcp::socket socket)
+    : endpoint_(endpoint), socket_(std::move(socket)), request_(MAX_REQUEST_BYTES) {}
+
+  void start() {
+    auto self = shared_from_this();
+    boost::asio::async_read_until(socket_, request_, "\r\n\r\n",
+      [self](const boost::system::error_code& ec, size_t) {
+        if (!ec) {
+          self->respond();
+        }
+      });
+  }
+
+private:
+  void respond() {
+    std::istream in(&request_);
+    std::string method;
+    std::string target;
+    in >> method >> target;
+
+    const char* status = "200 OK";
+    std::string body;
+    if (method != "GET") {
+      status = "405 Method Not Allowed";
+      body = "Only GET is supported\n";
+    } else if (target != "/metrics") {
+      status = "404 Not Found";
+      body = "Metrics are served at /metrics\n";
+    } else {
+      body = endpoint_.scrape();
+    }
+
+    response_ = std::string("HTTP/1.1 ") + status + "\r\n" +
+                "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n" +
+                "Content-Length: " + std::to_string(body.size()) + "\r\n" +
+                "Connection: close\r\n\r\n" + body;
+    auto self = shared_from_this();
+    boost::asio::async_write(socket_, boost::asio::buffer(response_),
+      [self](const boost::system::error_code&, size_t) {
+        boost::system::error_code ignored;
+        self->socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored);
+      });
+  }
+
+  MetricsEndpoint& endpoint_;
+  boost::asio::ip::tcp::socket socket_;
+  boost::asio::streambuf request_;
+  std::string response_;
+};
+
+MetricsEndpoint::MetricsEndpoint(uint16_t port, uint32_t publish_ms)
+  : publish_interval_(publish_ms),
+    created_(Clock::now()),
+    next_publish_(created_),
+    last_wall_(created_),
+    acceptor_(io_) {
+  boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::tcp::v4(), port);
+  acceptor_.open(endpoint.protocol());
+  acceptor_.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+  acceptor_.bind(endpoint);
+  acceptor_.listen();
+}
+
+MetricsEndpoint::~MetricsEndpoint() {
+  stop();
+}
+
+uint16_t MetricsEndpoint::getPort() const {
+  return acceptor_.local_endpoint().port();
+}
+
+void MetricsEndpoint::start() {
+  if (server_.joinable()) {
+    return;
+  }
+  accept();
+  server_ = std::thread([this]() { io_.run(); });
+}
+
+void MetricsEndpoint::stop() {
+  if (!server_.joinable()) {
+    return;
+  }
+  io_.stop();
+  server_.join();
+  boost::system::error_code ignored;
+  acceptor_.close(ignored);
+}
+
+void MetricsEndpoint::accept() {
+  acceptor_.async_accept(
+    [this](const boost::system::error_code& ec, boost::asio::ip::tcp::socket socket) {
+      if (!acceptor_.is_open()) {
+        return;
+      }
+      if (!ec) {
+        std::make_shared<Session>(*this, std::move(socket))->start();
+      }
+      accept();
+    });
+}
+
+void MetricsEndpoint::publish(uint64_t virtual_us, uint64_t updates, const NodeManager& manager,
+                              const NetworkSimulator& network, const EventScheduler* scheduler,
+                              const MeshTransport* transport) {
+  const Clock::time_point now = Clock::now();
+  const double elapsed = std::chrono::duration<double>(now - last_wall_).count();
+
+  LiveSnapshot& snapshot = nextSnapshot();
+  snapshot.wall_seconds = std::chrono::duration<double>(now - created_).count();
+  snapshot.virtual_us = virtual_us;
+  snapshot.updates = updates;
+  snapshot.tick_rate = elapsed > 0.0 ? double(updates - last_updates_) / elapsed : 0.0;
+  snapshot.time_ratio = elapsed > 0.0
+    ? double(virtual_us - std::min(virtual_us, last_virtual_us_)) / 1e6 / elapsed : 0.0;
+
+  uint64_t running = 0;
+  manager.forEachNode([&](const VirtualNode& node) {
+    running += node.isRunning() ? 1 : 0;
+  });
+  snapshot.nodes = manager.getNodeCount();
+  snapshot.nodes_running = running;
+  snapshot.nodes_sleeping = manager.getSleepingNodeCount();
+  snapshot.pending_messages = network.getPendingMessageCount();
+  snapshot.pending_events = scheduler ? scheduler->getPendingEventCount() : 0;
+  snapshot.frames = transport ? transport->getStats() : TransportStats();
+
+  // Cleared vectors keep their capacity from earlier snapshots
+  snapshot.links.clear();
+  snapshot.link_latency.clear();
+  network.forEachLinkStats([&](const NetworkSimulator::LinkCounters& counters,
+                               const LatencyHistogram* histogram) {
+    snapshot.links.push_back(counters);
+    const size_t offset = snapshot.link_latency.size();
+    snapshot.link_latency.resize(offset + LATENCY_BOUND_COUNT, 0);
+    if (histogram) {
+      histogram->getCumulativeCounts(LATENCY_BOUNDS_MS, LATENCY_BOUND_COUNT,
+                                     &snapshot.link_latency[offset]);
+    }
+  });
+
+  last_wall_ = now;
+  last_virtual_us_ = virtual_us;
+  last_updates_ = updates;
+  publishSnapshot();
+}
+
+void MetricsEndpoint::publishSnapshot() {
+  snapshots_.publish();
+  ++published_;
+  next_publish_ = Clock::now() + publish_interval_;
+}
+
+std::string MetricsEndpoint::scrape() {
+  snapshots_.update();
+  render(snapshots_.front(), body_);
+  return body_;
+}
+
+void MetricsEndpoint::render(const LiveSnapshot& snapshot, std::string& out) {
+  out.clear();
+
+  appendHeader(out, "wall_seconds", "gauge", "Wall time since the simulation started");
+  appendf(out, "painlessmesh_sim_wall_seconds %.3f\n", snapshot.wall_seconds);
+  appendHeader(out, "virtual_seconds", "gauge", "Virtual simulation time");
+  appendf(out, "painlessmesh_sim_virtual_seconds %.6f\n", double(snapshot.virtual_us) / 1e6);
+  appendHeader(out, "updates_total", "counter", "Node update ticks performed");
+  appendf(out, "painlessmesh_sim_updates_total %" PRIu64 "\n", snapshot.updates);
+  appendHeader(out, "tick_rate", "gauge", "Node update ticks per wall second");
+  appendf(out, "painlessmesh_sim_tick_rate %.3f\n", snapshot.tick_rate);
+  appendHeader(out, "time_ratio", "gauge", "Virtual seconds per wall second");
+  appendf(out, "painlessmesh_sim_time_ratio %.6f\n", snapshot.time_ratio);
+
+  appendHeader(out, "nodes", "gauge", "Simulated nodes by state");
+  appendf(out, "painlessmesh_sim_nodes{state=\"total\"} %" PRIu64 "\n", snapshot.nodes);
+  appendf(out, "painlessmesh_sim_nodes{state=\"running\"} %" PRIu64 "\n", snapshot.nodes_running);
+  appendf(out, "painlessmesh_sim_nodes{state=\"sleeping\"} %" PRIu64 "\n", snapshot.nodes_sleeping);
+  appendHeader(out, "queue_depth", "gauge", "Pending work items by queue");
+  appendf(out, "painlessmesh_sim_queue_depth{queue=\"messages\"} %" PRIu64 "\n",
+          snapshot.pending_messages);
+  appendf(out, "painlessmesh_sim_queue_depth{queue=\"events\"} %" PRIu64 "\n",
+          snapshot.pending_events);
+
+  appendHeader(out, "frames_total", "counter", "In-process transport frames by outcome");
+  appendf(out, "painlessmesh_sim_frames_total{kind=\"sent\"} %" PRIu64 "\n",
+          snapshot.frames.frames_sent);
+  appendf(out, "painlessmesh_sim_frames_total{kind=\"forwarded\"} %" PRIu64 "\n",
+          snapshot.frames.frames_forwarded);
+  appendf(out, "painlessmesh_sim_frames_total{kind=\"delivered\"} %" PRIu64 "\n",
+          snapshot.frames.frames_delivered);
+  appendf(out, "painlessmesh_sim_frames_total{kind=\"dropped\"} %" PRIu64 "\n",
+          snapshot.frames.frames_dropped);
+
+  struct LinkCounter {
+    const char* name;
+    const char* help;
+    uint64_t NetworkSimulator::LinkCounters::*field;
+  };
+  static const LinkCounter LINK_COUNTERS[] = {
+    {"link_messages_total", "Messages with a sampled latency per link",
+     &NetworkSimulator::LinkCounters::message_count},
+    {"link_delivered_total", "Messages past packet loss per link",
+     &NetworkSimulator::LinkCounters::delivered_count},
+    {"link_dropped_total", "Messages lost to packet loss per link",
+     &NetworkSimulator::LinkCounters::dropped_count},
+    {"link_throttled_total", "Messages over the bandwidth limit per link",
+     &NetworkSimulator::LinkCounters::bandwidth_throttled},
+    {"link_bytes_total", "Bytes admitted per link",
+     &NetworkSimulator::LinkCounters::bytes_sent},
+  };
+  for (const auto& counter : LINK_COUNTERS) {
+    appendHeader(out, counter.name, "counter", counter.help);
+    for (const auto& link : snapshot.links) {
+      appendf(out, "painlessmesh_sim_%s{from=\"%" PRIu32 "\",to=\"%" PRIu32 "\"} %" PRIu64 "\n",
+              counter.name, link.from, link.to, link.*counter.field);
+    }
+  }
+
+  // Cumulative bucket counts add up across links
+  uint64_t total[LATENCY_BOUND_COUNT] = {};
+  uint64_t total_count = 0;
+  uint64_t total_sum = 0;
+  char labels[64];
+  appendHeader(out, "link_latency_ms", "histogram", "Sampled latency per link in milliseconds");
+  for (size_t i = 0; i < snapshot.links.size(); ++i) {
+    const auto& link = snapshot.links[i];
+    const uint64_t* cumulative = &snapshot.link_latency[i * LATENCY_BOUND_COUNT];
+    std::snprintf(labels, sizeof(labels), "from=\"%" PRIu32 "\",to=\"%" PRIu32 "\"",
+                  link.from, link.to);
+    appendHistogram(out, "link_latency_ms", labels, cumulative,
+                    link.message_count, link.total_latency_ms);
+    for (size_t b = 0; b < LATENCY_BOUND_COUNT; ++b) {
+      total[b] += cumulative[b];
+    }
+    total_count += link.message_count;
+    total_sum += link.total_latency_ms;
+  }
+  appendHeader(out, "latency_ms", "histogram", "Sampled latency over all links in milliseconds");
+  appendHistogram(out, "latency_ms", "", total, total_count, total_sum);
+}
+
+} // namespace simulator
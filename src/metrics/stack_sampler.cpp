@@ -0,0 +1,265 @@
+/**
+ * @file stack_sampler.cpp
+ * @brief Implementation of StackSampler class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/stack_sampler.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+#if defined(__linux__) && defined(__GLIBC__)
+#define SIMULATOR_STACK_SAMPLER 1
+#include <csignal>
+#include <ctime>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// glibc only names the thread-id member of sigevent in newer releases
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+#endif
+
+namespace simulator {
+
+constexpr size_t StackSampler::MAX_DEPTH;
+
+namespace {
+
+/// The running sampler, read by the signal handler
+std::atomic<StackSampler*> active_sampler{nullptr};
+
+/// Frames of the handler and the signal trampoline on top of every sample
+constexpr int SKIPPED_FRAMES = 2;
+
+} // anonymous namespace
+
+StackSampler::StackSampler(uint32_t interval_us, size_t capacity)
+  : interval_us_(interval_us == 0 ? 1 : interval_us), samples_(capacity) {}
+
+StackSampler::~StackSampler() {
+  stop();
+}
+
+bool StackSampler::isSupported() {
+#ifdef SIMULATOR_STACK_SAMPLER
+  return true;
+#else
+  return false;
+#endif
+}
+
+void StackSampler::onSignal(int /*signal*/) {
+#ifdef SIMULATOR_STACK_SAMPLER
+  const int saved_errno = errno;
+  StackSampler* sampler = active_sampler.load(std::memory_order_acquire);
+  if (sampler != nullptr) {
+    const size_t index = sampler->next_.fetch_add(1, std::memory_order_relaxed);
+    if (index < sampler->samples_.size()) {
+      Sample& sample = sampler->samples_[index];
+      sample.depth = backtrace(sample.frames, static_cast<int>(MAX_DEPTH));
+    } else {
+      sampler->dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  errno = saved_errno;
+#endif
+}
+
+void StackSampler::start() {
+#ifdef SIMULATOR_STACK_SAMPLER
+  if (running_) {
+    return;
+  }
+  StackSampler* expected = nullptr;
+  if (!active_sampler.compare_exchange_strong(expected, this)) {
+    throw std::runtime_error("Another stack sampler is already running");
+  }
+  next_.store(0);
+  dropped_.store(0);
+
+  // backtrace() loads libgcc on first use, which must not happen in the handler
+  void* warmup[4];
+  backtrace(warmup, 4);
+
+  // The handler stays installed after stop(); it ignores signals while no
+  // sampler is active, so a late expiry cannot kill the process
+  struct sigaction action;
+  std::memset(&action, 0, sizeof(action));
+  action.sa_handler = &StackSampler::onSignal;
+  action.sa_flags = SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  sigaction(SIGPROF, &action, nullptr);
+
+  struct sigevent event;
+  std::memset(&event, 0, sizeof(event));
+  event.sigev_notify = SIGEV_THREAD_ID;
+  event.sigev_signo = SIGPROF;
+  event.sigev_notify_thread_id = static_cast<pid_t>(syscall(SYS_gettid));
+  timer_t timer;
+  if (timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &timer) != 0) {
+    active_sampler.store(nullptr);
+    throw std::runtime_error(std::string("Cannot create the sampling timer: ") +
+                             std::strerror(errno));
+  }
+
+  struct itimerspec spec;
+  std::memset(&spec, 0, sizeof(spec));
+  spec.it_interval.tv_sec = interval_us_ / 1000000;
+  spec.it_interval.tv_nsec = static_cast<long>(interval_us_ % 1000000) * 1000;
+  spec.it_value = spec.it_interval;
+  if (timer_settime(timer, 0, &spec, nullptr) != 0) {
+    const int error = errno;
+    timer_delete(timer);
+    active_sampler.store(nullptr);
+    throw std::runtime_error(std::string("Cannot start the sampling timer: ") +
+                             std::strerror(error));
+  }
+  timer_ = timer;
+  running_ = true;
+#else
+  throw std::runtime_error("Stack sampling is not supported on this platform");
+#endif
+}
+
+void StackSampler::stop() {
+#ifdef SIMULATOR_STACK_SAMPLER
+  if (!running_) {
+    return;
+  }
+  timer_delete(static_cast<timer_t>(timer_));
+  timer_ = nullptr;
+  active_sampler.store(nullptr, std::memory_order_release);
+  running_ = false;
+#endif
+}
+
+size_t StackSampler::getSampleCount() const {
+  return std::min(next_.load(std::memory_order_relaxed), samples_.size());
+}
+
+std::vector<std::vector<const char*>> StackSampler::resolve(std::vector<std::string>& names) const {
+  // Every distinct address is resolved once; frames point into `names`,
+  // which is sized before any pointer is taken
+  std::unordered_map<void*, size_t> index;
+  std::vector<void*> addresses;
+  const size_t count = getSampleCount();
+  for (size_t i = 0; i < count; ++i) {
+    const Sample& sample = samples_[i];
+    for (int f = SKIPPED_FRAMES; f < sample.depth; ++f) {
+      if (index.emplace(sample.frames[f], addresses.size()).second) {
+        addresses.push_back(sample.frames[f]);
+      }
+    }
+  }
+
+  names.assign(addresses.size(), std::string());
+  for (size_t i = 0; i < addresses.size(); ++i) {
+    std::ostringstream name;
+#ifdef SIMULATOR_STACK_SAMPLER
+    Dl_info info;
+    const bool found = dladdr(addresses[i], &info) != 0;
+    if (found && info.dli_sname != nullptr) {
+      int status = 0;
+      char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+      name << (status == 0 && demangled != nullptr ? demangled : info.dli_sname);
+      std::free(demangled);
+    } else if (found && info.dli_fname != nullptr) {
+      const char* module = std::strrchr(info.dli_fname, '/');
+      name << (module != nullptr ? module + 1 : info.dli_fname) << "+0x" << std::hex
+           << (reinterpret_cast<uintptr_t>(addresses[i]) -
+               reinterpret_cast<uintptr_t>(info.dli_fbase));
+    } else
+#endif
+    {
+      name << addresses[i];
+    }
+    names[i] = name.str();
+    // Folded stacks separate frames with ';' and end with a space and count
+    std::replace(names[i].begin(), names[i].end(), ';', ',');
+  }
+
+  std::vector<std::vector<const char*>> stacks;
+  stacks.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    const Sample& sample = samples_[i];
+    std::vector<const char*> stack;
+    for (int f = sample.depth - 1; f >= SKIPPED_FRAMES; --f) {
+      stack.push_back(names[index[sample.frames[f]]].c_str());
+    }
+    stacks.push_back(std::move(stack));
+  }
+  return stacks;
+}
+
+void StackSampler::writeFolded(std::ostream& out) const {
+  std::vector<std::string> names;
+  std::map<std::string, size_t> folded;
+  for (const auto& stack : resolve(names)) {
+    if (stack.empty()) {
+      continue;
+    }
+    std::string line;
+    for (const char* frame : stack) {
+      if (!line.empty()) {
+        line += ';';
+      }
+      line += frame;
+    }
+    ++folded[line];
+  }
+  for (const auto& entry : folded) {
+    out << entry.first << " " << entry.second << "\n";
+  }
+}
+
+void StackSampler::printTop(std::ostream& out, size_t top) const {
+  std::vector<std::string> names;
+  const auto stacks = resolve(names);
+  // Keyed by name: addresses in the same function share one entry
+  std::unordered_map<std::string, size_t> self;
+  size_t total = 0;
+  for (const auto& stack : stacks) {
+    if (!stack.empty()) {
+      ++self[stack.back()];
+      ++total;
+    }
+  }
+  if (total == 0) {
+    out << "No stack samples\n";
+    return;
+  }
+
+  std::vector<std::pair<std::string, size_t>> ranked(self.begin(), self.end());
+  std::sort(ranked.begin(), ranked.end(),
+            [](const std::pair<std::string, size_t>& a, const std::pair<std::string, size_t>& b) {
+              return a.second != b.second ? a.second > b.second : a.first < b.first;
+            });
+  out << "Top of stack in " << total << " samples";
+  if (getDroppedCount() > 0) {
+    out << " (" << getDroppedCount() << " dropped)";
+  }
+  out << ":\n";
+  for (size_t i = 0; i < ranked.size() && i < top; ++i) {
+    std::ostringstream share;
+    share << std::fixed << std::setprecision(1) << std::setw(5)
+          << 100.0 * ranked[i].second / total;
+    out << "  " << share.str() << "%  " << ranked[i].first << "\n";
+  }
+}
+
+} // namespace simulator
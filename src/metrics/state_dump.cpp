@@ -0,0 +1,267 @@
+/**
+ * @file state_dump.cpp
+ * @brief Implementation of StateDump class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/state_dump.hpp"
+#include "simulator/event_scheduler.hpp"
+#include "simulator/firmware/firmware_base.hpp"
+#include "simulator/logger.hpp"
+#include "simulator/loop_monitor.hpp"
+#include "simulator/mesh_transport.hpp"
+#include "simulator/metrics_collector.hpp"
+#include "simulator/network_simulator.hpp"
+#include "simulator/node_manager.hpp"
+
+#include <algorithm>
+#include <csignal>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace simulator {
+
+constexpr size_t StateDump::TOP_NODES;
+constexpr size_t StateDump::TOP_FUNCTIONS;
+
+std::atomic<bool> StateDump::requested_{false};
+
+namespace {
+
+#ifdef SIGUSR1
+void onDumpSignal(int /*signal*/) {
+  StateDump::request();
+}
+#endif
+
+/// Local wall-clock time, e.g. "2025-06-01 12:00:00"
+std::string wallClock() {
+  const std::time_t now = std::time(nullptr);
+  char text[32];
+  std::strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", std::localtime(&now));
+  return text;
+}
+
+} // anonymous namespace
+
+StateDump::StateDump(const std::string& output_dir, uint32_t window_ms, bool profile)
+  : output_dir_(output_dir), window_ms_(window_ms), profile_(profile) {}
+
+StateDump::~StateDump() {
+  if (sampler_) {
+    sampler_->stop();
+  }
+  if (monitor_) {
+    monitor_->setNodeCosts(false);
+  }
+  if (attached_ && manager_) {
+    manager_->setLoopMonitor(nullptr);
+  }
+}
+
+void StateDump::installSignalHandler() {
+#ifdef SIGUSR1
+  std::signal(SIGUSR1, onDumpSignal);
+#endif
+}
+
+void StateDump::request() {
+  requested_.store(true, std::memory_order_relaxed);
+}
+
+bool StateDump::isRequested() {
+  if (requested_.exchange(false, std::memory_order_relaxed)) {
+    return true;
+  }
+
+  // The request file stands in for SIGUSR1 where there is none
+  const auto now = std::chrono::steady_clock::now();
+  if (now - last_poll_ < std::chrono::seconds(1)) {
+    return false;
+  }
+  last_poll_ = now;
+  const std::string request_file = output_dir_ + "/dump.request";
+  if (!std::ifstream(request_file)) {
+    return false;
+  }
+  std::remove(request_file.c_str());
+  return true;
+}
+
+void StateDump::begin(uint64_t now_us, uint32_t updates, NodeManager& manager,
+                      const NetworkSimulator& network, const EventScheduler* scheduler,
+                      const MeshTransport* transport, LoopMonitor& monitor) {
+  if (isCollecting()) {
+    return;
+  }
+
+  std::ostringstream out;
+  out << "State dump " << (dumps_ + 1) << " at " << wallClock() << "\n";
+  out << "Virtual time: " << std::fixed << std::setprecision(3)
+      << static_cast<double>(now_us) / 1000000.0 << " s after " << updates << " ticks\n";
+  out.unsetf(std::ios::floatfield);
+
+  // Node states and the deepest task queues in one pass
+  size_t running = 0;
+  size_t asleep = 0;
+  size_t tasks = 0;
+  std::vector<std::pair<size_t, uint32_t>> queues;
+  manager.forEachNode([&](const VirtualNode& node) {
+    running += node.isRunning() ? 1 : 0;
+    asleep += node.isRunning() && node.isAsleep() ? 1 : 0;
+    const size_t depth = node.getTasks().size();
+    tasks += depth;
+    if (depth > 0) {
+      queues.emplace_back(depth, node.getNodeId());
+    }
+  });
+  out << "Nodes: " << manager.getNodeCount() << " (" << running << " running, "
+      << asleep << " asleep)\n";
+  out << "Messages in flight: " << network.getPendingMessageCount() << "\n";
+  if (scheduler) {
+    out << "Pending events: " << scheduler->getPendingEventCount() << "\n";
+  }
+  if (transport) {
+    const TransportStats& stats = transport->getStats();
+    out << "Transport frames: " << stats.frames_sent << " sent, " << stats.frames_forwarded
+        << " forwarded, " << stats.frames_delivered << " delivered, "
+        << stats.frames_dropped << " dropped\n";
+  }
+  out << "Scheduled tasks: " << tasks << "\n";
+  if (!queues.empty()) {
+    const size_t top = std::min(TOP_NODES, queues.size());
+    std::partial_sort(queues.begin(), queues.begin() + top, queues.end(),
+                      [](const std::pair<size_t, uint32_t>& a,
+                         const std::pair<size_t, uint32_t>& b) {
+                        return a.first != b.first ? a.first > b.first : a.second < b.second;
+                      });
+    out << "Deepest task queues:\n";
+    for (size_t i = 0; i < top; ++i) {
+      out << "  node " << queues[i].second << ": " << queues[i].first << " tasks\n";
+    }
+  }
+  monitor.print(out, TOP_NODES);
+  state_ = out.str();
+
+  manager_ = &manager;
+  monitor_ = &monitor;
+  started_ = std::chrono::steady_clock::now();
+  SIM_LOG_INFO("[INFO] State dump {} requested at {} ms", dumps_ + 1, now_us / 1000);
+  if (window_ms_ == 0) {
+    finish();
+    return;
+  }
+
+  // Time node updates for the window; the run's watchdog may already do so
+  attached_ = manager.getLoopMonitor() == nullptr;
+  if (attached_) {
+    manager.setLoopMonitor(&monitor);
+  }
+  monitor.setNodeCosts(true);
+  if (profile_) {
+    try {
+      sampler_.reset(new StackSampler());
+      sampler_->start();
+    } catch (const std::exception& e) {
+      SIM_LOG_WARN("[WARN] No stack samples in the state dump: {}", e.what());
+      sampler_.reset();
+    }
+  }
+}
+
+bool StateDump::isWindowOver() const {
+  return isCollecting() &&
+         std::chrono::steady_clock::now() - started_ >= std::chrono::milliseconds(window_ms_);
+}
+
+void StateDump::finish() {
+  if (!isCollecting()) {
+    return;
+  }
+  if (sampler_) {
+    sampler_->stop();
+  }
+  const double window_ms = std::chrono::duration<double, std::milli>(
+                               std::chrono::steady_clock::now() - started_).count();
+  std::vector<NodeCost> costs;
+  if (monitor_->hasNodeCosts()) {
+    costs = monitor_->getNodeCosts();
+    monitor_->setNodeCosts(false);
+  }
+  if (attached_) {
+    // The window's updates would skew the run's end-of-run percentiles
+    manager_->setLoopMonitor(nullptr);
+    monitor_->setWorkerCount(1);
+  }
+  manager_ = nullptr;
+  monitor_ = nullptr;
+  attached_ = false;
+  ++dumps_;
+
+  std::ostringstream out;
+  out << state_;
+  if (window_ms_ > 0) {
+    uint64_t updates = 0;
+    uint64_t total_ns = 0;
+    for (const NodeCost& cost : costs) {
+      updates += cost.updates;
+      total_ns += cost.total_ns;
+    }
+    out << std::fixed << std::setprecision(1);
+    out << "\nNode updates in the " << window_ms << " ms window: " << updates << " taking "
+        << static_cast<double>(total_ns) / 1e6 << " ms\n";
+    if (!costs.empty()) {
+      out << "Costliest nodes (mean / worst / total us):\n";
+      for (size_t i = 0; i < costs.size() && i < TOP_NODES; ++i) {
+        const NodeCost& cost = costs[i];
+        out << "  node " << cost.node_id << " (" << cost.firmware << "): "
+            << static_cast<double>(cost.total_ns) / 1000.0 / cost.updates << " / "
+            << static_cast<double>(cost.worst_ns) / 1000.0 << " / "
+            << static_cast<double>(cost.total_ns) / 1000.0 << " in " << cost.updates
+            << " updates\n";
+      }
+    }
+    out.unsetf(std::ios::floatfield);
+  }
+
+  const std::string base = output_dir_ + "/state_dump_" + std::to_string(dumps_);
+  try {
+    if (sampler_) {
+      out << "\n";
+      sampler_->printTop(out, TOP_FUNCTIONS);
+      MetricsCollector::makeParentDirectories(base + ".folded");
+      std::ofstream folded(base + ".folded");
+      sampler_->writeFolded(folded);
+      if (!folded) {
+        throw std::runtime_error("Cannot write " + base + ".folded");
+      }
+    }
+
+    MetricsCollector::makeParentDirectories(base + ".txt");
+    std::ofstream file(base + ".txt");
+    file << out.str();
+    if (!file) {
+      throw std::runtime_error("Cannot write " + base + ".txt");
+    }
+    last_path_ = base + ".txt";
+    if (sampler_) {
+      SIM_LOG_INFO("[INFO] Wrote state dump to {} ({} stack samples in {}.folded)",
+                   last_path_, sampler_->getSampleCount(), base);
+    } else {
+      SIM_LOG_INFO("[INFO] Wrote state dump to {}", last_path_);
+    }
+  } catch (const std::exception& e) {
+    SIM_LOG_ERROR("[ERROR] State dump failed: {}", e.what());
+  }
+  sampler_.reset();
+}
+
+} // namespace simulator
@@ -0,0 +1,238 @@
+/**
+ * @file terminal_dashboard.cpp
+ * @brief Implementation of TerminalDashboard class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/terminal_dashboard.hpp"
+#include "simulator/event_scheduler.hpp"
+#include "simulator/node_manager.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdarg>
+#include <cstdio>
+#include <ostream>
+#include <unordered_set>
+
+namespace simulator {
+
+constexpr uint32_t TerminalDashboard::DEFAULT_REFRESH_MS;
+constexpr size_t TerminalDashboard::DEFAULT_TOP;
+
+namespace {
+
+/// Moves the cursor home and clears the screen
+constexpr const char* CLEAR_SCREEN = "\x1b[H\x1b[2J";
+
+/// Width of the progress bar in characters
+constexpr size_t PROGRESS_WIDTH = 30;
+
+// Appends printf-formatted text (one line at most)
+void appendf(std::string& out, const char* format, ...) {
+  char buffer[256];
+  va_list args;
+  va_start(args, format);
+  const int length = std::vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+  if (length > 0) {
+    out.append(buffer, std::min(static_cast<size_t>(length), sizeof(buffer) - 1));
+  }
+}
+
+uint64_t nodeLoad(const DashboardNode& node) {
+  return node.messages_sent + node.messages_received;
+}
+
+uint64_t linkLoad(const NetworkSimulator::LinkCounters& link) {
+  return link.delivered_count + link.dropped_count + link.bandwidth_throttled;
+}
+
+/**
+ * @brief Keeps the top entries of a stream in a short sorted vector
+ *
+ * Inserts in place and drops the last entry beyond @p top, so the vector
+ * never grows past top + 1 and costs nothing per value below the cut.
+ */
+template <typename T, typename Load>
+void keepTop(std::vector<T>& top_list, size_t top, const T& value, Load load) {
+  const uint64_t value_load = load(value);
+  if (top_list.size() == top && (top == 0 || load(top_list.back()) >= value_load)) {
+    return;
+  }
+  auto it = std::find_if(top_list.begin(), top_list.end(),
+                         [&](const T& entry) { return load(entry) < value_load; });
+  top_list.insert(it, value);
+  if (top_list.size() > top) {
+    top_list.pop_back();
+  }
+}
+
+} // anonymous namespace
+
+TerminalDashboard::TerminalDashboard(std::ostream& out, uint64_t duration_us,
+                                     uint32_t refresh_ms, size_t top)
+  : out_(out),
+    duration_us_(duration_us),
+    refresh_interval_(refresh_ms),
+    top_(top),
+    created_(Clock::now()),
+    next_publish_(created_),
+    last_wall_(created_) {}
+
+TerminalDashboard::~TerminalDashboard() {
+  stop();
+}
+
+void TerminalDashboard::start() {
+  if (renderer_.joinable()) {
+    return;
+  }
+  stopping_ = false;
+  renderer_ = std::thread([this]() { renderLoop(); });
+}
+
+void TerminalDashboard::stop() {
+  if (!renderer_.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_one();
+  renderer_.join();
+}
+
+void TerminalDashboard::renderLoop() {
+  // Draws once more after stop() so the last snapshot is shown
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    wake_.wait_for(lock, refresh_interval_, [this]() { return stopping_; });
+    const bool last = stopping_;
+    lock.unlock();
+    draw();
+    if (last) {
+      return;
+    }
+    lock.lock();
+  }
+}
+
+void TerminalDashboard::draw() {
+  if (!snapshots_.update()) {
+    return;
+  }
+  render(snapshots_.front(), screen_);
+  out_ << CLEAR_SCREEN << screen_ << std::flush;
+  drawn_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void TerminalDashboard::publish(uint64_t virtual_us, uint64_t updates,
+                                const NodeManager& manager, const NetworkSimulator& network,
+                                const EventScheduler* scheduler,
+                                const MeshTransport* transport) {
+  const Clock::time_point now = Clock::now();
+  const double elapsed = std::chrono::duration<double>(now - last_wall_).count();
+
+  DashboardSnapshot& snapshot = snapshots_.back();
+  snapshot.wall_seconds = std::chrono::duration<double>(now - created_).count();
+  snapshot.virtual_us = virtual_us;
+  snapshot.duration_us = duration_us_;
+  snapshot.updates = updates;
+  snapshot.tick_rate = elapsed > 0.0 ? double(updates - last_updates_) / elapsed : 0.0;
+  snapshot.time_ratio = elapsed > 0.0
+    ? double(virtual_us - std::min(virtual_us, last_virtual_us_)) / 1e6 / elapsed : 0.0;
+
+  // Cleared vectors keep their capacity from earlier snapshots
+  uint64_t running = 0;
+  snapshot.busiest_nodes.clear();
+  manager.forEachNode([&](const VirtualNode& node) {
+    const NodeMetrics metrics = node.getMetrics();
+    DashboardNode entry;
+    entry.id = node.getNodeId();
+    entry.messages_sent = metrics.messages_sent;
+    entry.messages_received = metrics.messages_received;
+    entry.running = node.isRunning();
+    running += entry.running ? 1 : 0;
+    keepTop(snapshot.busiest_nodes, top_, entry, nodeLoad);
+  });
+  snapshot.nodes = manager.getNodeCount();
+  snapshot.nodes_running = running;
+  snapshot.nodes_sleeping = manager.getSleepingNodeCount();
+  snapshot.pending_messages = network.getPendingMessageCount();
+  snapshot.pending_events = scheduler ? scheduler->getPendingEventCount() : 0;
+  snapshot.frames = transport ? transport->getStats() : TransportStats();
+
+  snapshot.busiest_links.clear();
+  network.forEachLinkStats([&](const NetworkSimulator::LinkCounters& counters,
+                               const LatencyHistogram*) {
+    keepTop(snapshot.busiest_links, top_, counters, linkLoad);
+  });
+
+  const auto partitions = network.getPartitions();
+  std::unordered_set<uint32_t> labels;
+  for (const auto& entry : partitions) {
+    labels.insert(entry.second);
+  }
+  snapshot.partitions = labels.size();
+  snapshot.partitioned_nodes = partitions.size();
+  snapshot.dropped_links = network.getDroppedConnections().size();
+
+  last_wall_ = now;
+  last_virtual_us_ = virtual_us;
+  last_updates_ = updates;
+  snapshots_.publish();
+  ++published_;
+  next_publish_ = Clock::now() + refresh_interval_;
+}
+
+void TerminalDashboard::render(const DashboardSnapshot& snapshot, std::string& out) {
+  out.clear();
+
+  const double virtual_seconds = double(snapshot.virtual_us) / 1e6;
+  appendf(out, "painlessMesh simulator   virtual %.1f s", virtual_seconds);
+  if (snapshot.duration_us > 0) {
+    const double done = std::min(1.0, double(snapshot.virtual_us) / double(snapshot.duration_us));
+    const size_t filled = static_cast<size_t>(done * PROGRESS_WIDTH);
+    appendf(out, " / %.0f s  [", double(snapshot.duration_us) / 1e6);
+    out.append(filled, '#');
+    out.append(PROGRESS_WIDTH - filled, '.');
+    appendf(out, "] %3.0f%%", done * 100.0);
+  }
+  out += '\n';
+  appendf(out, "Wall %.1f s   Ticks %" PRIu64 " (%.1f/s)   Sim/wall %.2fx\n",
+          snapshot.wall_seconds, snapshot.updates, snapshot.tick_rate, snapshot.time_ratio);
+  appendf(out, "Nodes %" PRIu64 "   running %" PRIu64 "   sleeping %" PRIu64 "\n",
+          snapshot.nodes, snapshot.nodes_running, snapshot.nodes_sleeping);
+  appendf(out, "Queues   messages %" PRIu64 "   events %" PRIu64 "\n",
+          snapshot.pending_messages, snapshot.pending_events);
+  appendf(out, "Frames   sent %" PRIu64 "   forwarded %" PRIu64 "   delivered %" PRIu64
+          "   dropped %" PRIu64 "\n",
+          snapshot.frames.frames_sent, snapshot.frames.frames_forwarded,
+          snapshot.frames.frames_delivered, snapshot.frames.frames_dropped);
+  if (snapshot.partitions == 0 && snapshot.dropped_links == 0) {
+    out += "Partitions   none\n";
+  } else {
+    appendf(out, "Partitions   %" PRIu64 " over %" PRIu64 " nodes   dropped links %" PRIu64 "\n",
+            snapshot.partitions, snapshot.partitioned_nodes, snapshot.dropped_links);
+  }
+
+  out += "\nBusiest nodes (* stopped)      sent   received\n";
+  for (const auto& node : snapshot.busiest_nodes) {
+    appendf(out, "  %10" PRIu32 "%s %10" PRIu64 " %10" PRIu64 "\n", node.id,
+            node.running ? " " : "*", node.messages_sent, node.messages_received);
+  }
+  out += "\nBusiest links                delivered       lost    avg ms\n";
+  for (const auto& link : snapshot.busiest_links) {
+    const uint64_t lost = link.dropped_count + link.bandwidth_throttled;
+    const double average = link.message_count > 0
+      ? double(link.total_latency_ms) / double(link.message_count) : 0.0;
+    appendf(out, "  %10" PRIu32 " -> %-10" PRIu32 " %10" PRIu64 " %10" PRIu64 " %9.1f\n",
+            link.from, link.to, link.delivered_count, lost, average);
+  }
+}
+
+} // namespace simulator
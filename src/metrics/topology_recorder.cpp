@@ -0,0 +1,215 @@
+/**
+ * @file topology_recorder.cpp
+ * @brief Implementation of TopologyRecorder class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/topology_recorder.hpp"
+#include "simulator/logger.hpp"
+#include "simulator/mesh_transport.hpp"
+#include "simulator/metrics_collector.hpp"
+#include "simulator/network_simulator.hpp"
+#include "simulator/node_manager.hpp"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <stdexcept>
+#include <utility>
+
+namespace simulator {
+
+constexpr uint32_t TopologyRecorder::VERSION;
+
+namespace {
+
+const char* transitionName(NodeTransition transition) {
+  switch (transition) {
+    case NodeTransition::START: return "start";
+    case NodeTransition::STOP: return "stop";
+    case NodeTransition::CRASH: return "crash";
+  }
+  return "unknown";
+}
+
+void appendUint(std::string& line, uint64_t value) {
+  char buffer[24];
+  const int length = std::snprintf(buffer, sizeof(buffer), "%llu",
+                                   static_cast<unsigned long long>(value));
+  line.append(buffer, static_cast<size_t>(length));
+}
+
+// Appends [[a,b],...] for a list of pairs
+template <typename Pairs>
+void appendPairs(std::string& line, const Pairs& pairs) {
+  line += '[';
+  bool first = true;
+  for (const auto& pair : pairs) {
+    line += first ? "[" : ",[";
+    appendUint(line, pair.first);
+    line += ',';
+    appendUint(line, pair.second);
+    line += ']';
+    first = false;
+  }
+  line += ']';
+}
+
+} // anonymous namespace
+
+bool TopologyRecorder::isRequested(const MetricsConfig& config) {
+  const auto& formats = config.export_formats;
+  return !config.output.empty() &&
+         (std::find(formats.begin(), formats.end(), "topology") != formats.end() ||
+          std::find(formats.begin(), formats.end(), "graphviz") != formats.end());
+}
+
+TopologyRecorder::TopologyRecorder(const MetricsConfig& config)
+  : base_(MetricsCollector::basePath(config.output)) {
+  if (config.output.empty()) {
+    throw std::invalid_argument("Topology output path must not be empty");
+  }
+  const auto& formats = config.export_formats;
+  stream_ = std::find(formats.begin(), formats.end(), "topology") != formats.end();
+  dot_ = std::find(formats.begin(), formats.end(), "graphviz") != formats.end();
+}
+
+TopologyRecorder::~TopologyRecorder() {
+  try {
+    close();
+  } catch (const std::exception& e) {
+    SIM_LOG_ERROR("[ERROR] Failed to finish topology files: {}", e.what());
+  }
+}
+
+void TopologyRecorder::open(uint64_t time_us, const NodeManager& manager,
+                            const NetworkSimulator& network, const MeshTransport* transport) {
+  if (open_) {
+    return;
+  }
+  MetricsCollector::makeParentDirectories(base_);
+  files_.clear();
+  time_ms_ = time_us / 1000;
+  changes_ = 0;
+
+  std::vector<std::pair<uint32_t, bool>> nodes;
+  nodes.reserve(manager.getNodeCount());
+  manager.forEachNode([&nodes](const VirtualNode& node) {
+    nodes.emplace_back(node.getNodeId(), node.isRunning());
+  });
+  std::sort(nodes.begin(), nodes.end());
+  const std::vector<std::pair<uint32_t, uint32_t>> links =
+    transport ? transport->getLinks() : std::vector<std::pair<uint32_t, uint32_t>>();
+
+  if (stream_) {
+    const std::string path = base_ + "_topology.ndjson";
+    out_.open(path, std::ios::binary | std::ios::trunc);
+    if (!out_) {
+      throw std::runtime_error("Failed to create topology file: " + path);
+    }
+    files_.push_back(path);
+
+    std::string line = "{\"t\":";
+    appendUint(line, time_ms_);
+    line += ",\"ev\":\"snapshot\",\"version\":";
+    appendUint(line, VERSION);
+    line += ",\"nodes\":[";
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      line += i == 0 ? "[" : ",[";
+      appendUint(line, nodes[i].first);
+      line += nodes[i].second ? ",1]" : ",0]";
+    }
+    line += "],\"links\":";
+    appendPairs(line, links);
+    line += ",\"dropped\":";
+    appendPairs(line, network.getDroppedConnections());
+    line += ",\"partitions\":";
+    appendPairs(line, network.getPartitions());
+    line += "}\n";
+    out_.write(line.data(), static_cast<std::streamsize>(line.size()));
+  }
+  if (dot_) {
+    writeDot(nodes, links);
+  }
+  open_ = true;
+}
+
+void TopologyRecorder::writeDot(const std::vector<std::pair<uint32_t, bool>>& nodes,
+                                const std::vector<std::pair<uint32_t, uint32_t>>& links) {
+  const std::string path = base_ + "_topology.dot";
+  std::ofstream dot(path, std::ios::binary | std::ios::trunc);
+  if (!dot) {
+    throw std::runtime_error("Failed to create topology file: " + path);
+  }
+  files_.push_back(path);
+
+  // Stopped nodes are dashed; one statement per line keeps diffs readable
+  dot << "graph mesh {\n";
+  for (const auto& node : nodes) {
+    dot << "  " << node.first << (node.second ? ";\n" : " [style=dashed];\n");
+  }
+  for (const auto& link : links) {
+    dot << "  " << link.first << " -- " << link.second << ";\n";
+  }
+  dot << "}\n";
+  dot.close();
+  if (dot.fail()) {
+    throw std::runtime_error("Failed to write topology file: " + path);
+  }
+}
+
+void TopologyRecorder::close() {
+  if (!open_) {
+    return;
+  }
+  open_ = false;
+  if (out_.is_open()) {
+    out_.close();
+    if (out_.fail()) {
+      throw std::runtime_error("Failed to write topology file: " + base_ + "_topology.ndjson");
+    }
+  }
+}
+
+void TopologyRecorder::writeLine(const char* format, ...) {
+  if (!open_ || !stream_) {
+    return;
+  }
+  char buffer[160];
+  int length = std::snprintf(buffer, sizeof(buffer), "{\"t\":%llu,",
+                             static_cast<unsigned long long>(time_ms_));
+  va_list args;
+  va_start(args, format);
+  length += std::vsnprintf(buffer + length, sizeof(buffer) - static_cast<size_t>(length),
+                           format, args);
+  va_end(args);
+  out_.write(buffer, std::min<std::streamsize>(length, sizeof(buffer) - 1));
+  ++changes_;
+}
+
+void TopologyRecorder::linkChanged(uint32_t a, uint32_t b, bool up) {
+  if (a > b) {
+    std::swap(a, b);
+  }
+  writeLine("\"ev\":\"%s\",\"a\":%u,\"b\":%u}\n", up ? "link_up" : "link_down", a, b);
+}
+
+void TopologyRecorder::connectionChanged(uint32_t from, uint32_t to, bool active) {
+  writeLine("\"ev\":\"%s\",\"from\":%u,\"to\":%u}\n", active ? "restore" : "drop", from, to);
+}
+
+void TopologyRecorder::partitionChanged(uint32_t node, uint32_t label) {
+  writeLine("\"ev\":\"partition\",\"node\":%u,\"label\":%u}\n", node, label);
+}
+
+void TopologyRecorder::partitionsCleared() {
+  writeLine("\"ev\":\"heal\"}\n");
+}
+
+void TopologyRecorder::nodeChanged(uint32_t node, NodeTransition transition) {
+  writeLine("\"ev\":\"node\",\"node\":%u,\"state\":\"%s\"}\n", node, transitionName(transition));
+}
+
+} // namespace simulator
@@ -0,0 +1,232 @@
+/**
+ * @file airtime_model.cpp
+ * @brief Implementation of AirtimeModel class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/airtime_model.hpp"
+#include "simulator/checkpoint.hpp"
+#include "simulator/counter_rng.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+namespace simulator {
+
+constexpr uint32_t AirtimeModel::NO_DOMAIN;
+constexpr uint64_t AirtimeModel::REPLAY_HORIZON_MS;
+
+uint64_t AirtimeConfig::airtimeUs(size_t bytes) const {
+  if (bitrate_bps == 0) {
+    return 0;
+  }
+  // Rounded up: a partial microsecond still holds the medium
+  const uint64_t bits_us = static_cast<uint64_t>(bytes) * 8ULL * 1000000ULL;
+  return frame_overhead_us + (bits_us + bitrate_bps - 1) / bitrate_bps;
+}
+
+void AirtimeModel::configure(const AirtimeConfig& config, uint32_t seed) {
+  if (!config.isValid()) {
+    throw std::invalid_argument("Invalid airtime configuration");
+  }
+  config_ = config;
+  seed_ = seed;
+}
+
+void AirtimeModel::setNeighbours(const std::map<uint32_t, std::set<uint32_t>>& neighbours) {
+  std::vector<Domain> old_domains;
+  old_domains.swap(domains_);
+  std::map<uint32_t, uint32_t> old_domain;
+  for (auto& entry : nodes_) {
+    old_domain.emplace(entry.first, entry.second.domain);
+    entry.second.domain = NO_DOMAIN;
+  }
+
+  // Each new domain inherits the latest busy time of its members; their
+  // recent frames are settled, so replayed sends wait for all of them
+  auto join = [&](uint32_t node, uint32_t domain) {
+    Medium& medium = nodes_[node];
+    medium.domain = domain;
+    auto old = old_domain.find(node);
+    if (old != old_domain.end() && old->second < old_domains.size()) {
+      Domain& joined = domains_[domain];
+      joined.busy_until_us = std::max(joined.busy_until_us,
+                                      old_domains[old->second].busy_until_us);
+      joined.settled_us = joined.busy_until_us;
+    }
+  };
+
+  for (const auto& entry : neighbours) {
+    if (nodes_[entry.first].domain != NO_DOMAIN) {
+      continue;
+    }
+    const uint32_t domain = static_cast<uint32_t>(domains_.size());
+    domains_.emplace_back();
+    join(entry.first, domain);
+    for (uint32_t neighbour : entry.second) {
+      if (nodes_[neighbour].domain == NO_DOMAIN) {
+        join(neighbour, domain);
+      }
+    }
+  }
+
+  // Known nodes without neighbours keep a medium of their own, so a
+  // rebuild from unchanged neighbours changes nothing
+  for (const auto& entry : old_domain) {
+    if (nodes_[entry.first].domain == NO_DOMAIN) {
+      const uint32_t domain = static_cast<uint32_t>(domains_.size());
+      domains_.emplace_back();
+      join(entry.first, domain);
+    }
+  }
+}
+
+AirtimeModel::Medium& AirtimeModel::mediumOf(uint32_t node) {
+  Medium& medium = nodes_[node];
+  if (medium.domain == NO_DOMAIN) {
+    medium.domain = static_cast<uint32_t>(domains_.size());
+    domains_.emplace_back();
+  }
+  return medium;
+}
+
+uint64_t AirtimeModel::busyUntil(const Domain& domain, uint64_t now_us) {
+  if (domain.recent.empty() || domain.recent.back().send_us <= now_us) {
+    return domain.busy_until_us;
+  }
+
+  // A replayed send: frames sent after it were not on the air yet
+  auto after = std::upper_bound(domain.recent.begin(), domain.recent.end(), now_us,
+                                [](uint64_t time, const Frame& frame) {
+                                  return time < frame.send_us;
+                                });
+  if (after == domain.recent.begin()) {
+    return domain.settled_us;
+  }
+  return std::max(domain.settled_us, std::prev(after)->prefix_end_us);
+}
+
+void AirtimeModel::occupy(Domain& domain, uint64_t send_us, uint64_t end_us) {
+  domain.busy_until_us = std::max(domain.busy_until_us, end_us);
+
+  auto& recent = domain.recent;
+  auto it = std::upper_bound(recent.begin(), recent.end(), send_us,
+                             [](uint64_t time, const Frame& frame) {
+                               return time < frame.send_us;
+                             });
+  const uint64_t before_us = it == recent.begin() ? 0 : std::prev(it)->prefix_end_us;
+  it = recent.insert(it, Frame{send_us, end_us, std::max(before_us, end_us)});
+  // Only replayed sends land before other frames and update their prefixes
+  for (++it; it != recent.end(); ++it) {
+    it->prefix_end_us = std::max(it->prefix_end_us, end_us);
+  }
+
+  const uint64_t horizon_us = REPLAY_HORIZON_MS * 1000;
+  while (recent.front().send_us + horizon_us < recent.back().send_us) {
+    domain.settled_us = std::max(domain.settled_us, recent.front().end_us);
+    recent.pop_front();
+  }
+}
+
+MediumAccess AirtimeModel::transmit(uint32_t node, size_t bytes, uint64_t now_ms) {
+  MediumAccess access;
+  if (!isEnabled()) {
+    access.sent = true;
+    return access;
+  }
+
+  Medium& medium = mediumOf(node);
+  Domain& domain = domains_[medium.domain];
+
+  // An idle medium is free at once; a busy one after the current frame
+  // and a random backoff
+  const uint64_t now_us = now_ms * 1000;
+  const uint64_t busy_until_us = busyUntil(domain, now_us);
+  uint64_t start_us = now_us;
+  if (busy_until_us > now_us) {
+    CounterRng rng(CounterRng::makeKey(seed_, node, 0, RNG_STREAM_AIRTIME),
+                   medium.backoff_sequence++);
+    start_us = busy_until_us + static_cast<uint64_t>(rng() % config_.contention_window) *
+                               config_.slot_us;
+  }
+
+  const uint64_t wait_us = start_us - now_us;
+  if (wait_us > static_cast<uint64_t>(config_.max_wait_ms) * 1000) {
+    stats_.dropped++;
+    return access;
+  }
+
+  const uint64_t airtime_us = config_.airtimeUs(bytes);
+  occupy(domain, now_us, start_us + airtime_us);
+  stats_.frames++;
+  stats_.airtime_us += airtime_us;
+  stats_.wait_us += wait_us;
+
+  access.sent = true;
+  access.delay_ms = static_cast<uint32_t>((wait_us + airtime_us + 999) / 1000);
+  return access;
+}
+
+uint32_t AirtimeModel::getDomainOf(uint32_t node) const {
+  auto it = nodes_.find(node);
+  return it == nodes_.end() ? NO_DOMAIN : it->second.domain;
+}
+
+AirtimeStats AirtimeModel::getStats() const {
+  AirtimeStats stats = stats_;
+  stats.domains = domains_.size();
+  return stats;
+}
+
+void AirtimeModel::saveState(CheckpointWriter& out) const {
+  out.write<uint64_t>(stats_.frames);
+  out.write<uint64_t>(stats_.dropped);
+  out.write<uint64_t>(stats_.airtime_us);
+  out.write<uint64_t>(stats_.wait_us);
+  // Checkpoints fall between windows, where no earlier send can follow,
+  // so the recent frames are not stored
+  out.write<uint32_t>(static_cast<uint32_t>(domains_.size()));
+  for (const auto& domain : domains_) {
+    out.write<uint64_t>(domain.busy_until_us);
+  }
+
+  // Sorted so equal states give equal checkpoints
+  std::map<uint32_t, Medium> nodes(nodes_.begin(), nodes_.end());
+  out.write<uint32_t>(static_cast<uint32_t>(nodes.size()));
+  for (const auto& entry : nodes) {
+    out.write<uint32_t>(entry.first);
+    out.write<uint32_t>(entry.second.domain);
+    out.write<uint64_t>(entry.second.backoff_sequence);
+  }
+}
+
+void AirtimeModel::loadState(CheckpointReader& in) {
+  stats_ = AirtimeStats();
+  stats_.frames = in.read<uint64_t>();
+  stats_.dropped = in.read<uint64_t>();
+  stats_.airtime_us = in.read<uint64_t>();
+  stats_.wait_us = in.read<uint64_t>();
+  domains_.assign(in.read<uint32_t>(), Domain());
+  for (auto& domain : domains_) {
+    domain.busy_until_us = in.read<uint64_t>();
+    domain.settled_us = domain.busy_until_us;
+  }
+
+  nodes_.clear();
+  const uint32_t count = in.read<uint32_t>();
+  for (uint32_t i = 0; i < count; ++i) {
+    const uint32_t node = in.read<uint32_t>();
+    Medium medium;
+    medium.domain = in.read<uint32_t>();
+    medium.backoff_sequence = in.read<uint64_t>();
+    if (medium.domain != NO_DOMAIN && medium.domain >= domains_.size()) {
+      throw std::runtime_error("Checkpoint has an invalid collision domain");
+    }
+    nodes_[node] = medium;
+  }
+}
+
+} // namespace simulator
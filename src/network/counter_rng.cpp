@@ -0,0 +1,103 @@
+/**
+ * @file counter_rng.cpp
+ * @brief Implementation of Philox4x32 and CounterRng
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/counter_rng.hpp"
+
+namespace simulator {
+
+namespace {
+
+constexpr uint32_t PHILOX_M0 = 0xD2511F53;
+constexpr uint32_t PHILOX_M1 = 0xCD9E8D57;
+constexpr uint32_t PHILOX_W0 = 0x9E3779B9;  // Golden ratio
+constexpr uint32_t PHILOX_W1 = 0xBB67AE85;  // sqrt(3) - 1
+constexpr int PHILOX_ROUNDS = 10;
+
+inline void mulhilo(uint32_t a, uint32_t b, uint32_t& hi, uint32_t& lo) {
+  uint64_t product = static_cast<uint64_t>(a) * b;
+  hi = static_cast<uint32_t>(product >> 32);
+  lo = static_cast<uint32_t>(product);
+}
+
+/**
+ * @brief SplitMix64 finalizer, a cheap bijective 64-bit mixer
+ */
+inline uint64_t mix64(uint64_t z) {
+  z += 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+} // anonymous namespace
+
+Philox4x32::Counter Philox4x32::generate(Counter counter, Key key) {
+  for (int round = 0; round < PHILOX_ROUNDS; ++round) {
+    if (round > 0) {
+      key[0] += PHILOX_W0;
+      key[1] += PHILOX_W1;
+    }
+
+    uint32_t hi0, lo0, hi1, lo1;
+    mulhilo(PHILOX_M0, counter[0], hi0, lo0);
+    mulhilo(PHILOX_M1, counter[2], hi1, lo1);
+    counter = {{hi1 ^ counter[1] ^ key[0], lo1,
+                hi0 ^ counter[3] ^ key[1], lo0}};
+  }
+  return counter;
+}
+
+CounterRng::CounterRng(uint64_t key, uint64_t sequence)
+    : key_{{static_cast<uint32_t>(key), static_cast<uint32_t>(key >> 32)}},
+      sequence_(sequence) {
+}
+
+CounterRng::result_type CounterRng::operator()() {
+  if (index_ == out_.size()) {
+    out_ = Philox4x32::generate({{block_++, 0,
+                                  static_cast<uint32_t>(sequence_),
+                                  static_cast<uint32_t>(sequence_ >> 32)}},
+                                key_);
+    index_ = 0;
+  }
+  return out_[index_++];
+}
+
+void CounterRng::firstWords(const uint64_t* keys, const uint64_t* sequences, uint64_t* out,
+                            size_t count) {
+  // Philox4x32::generate() on block 0, unrolled into scalars so no array
+  // or early exit keeps the loop from vectorizing
+  for (size_t i = 0; i < count; ++i) {
+    uint32_t key0 = static_cast<uint32_t>(keys[i]);
+    uint32_t key1 = static_cast<uint32_t>(keys[i] >> 32);
+    uint32_t c0 = 0;
+    uint32_t c1 = 0;
+    uint32_t c2 = static_cast<uint32_t>(sequences[i]);
+    uint32_t c3 = static_cast<uint32_t>(sequences[i] >> 32);
+    for (int round = 0; round < PHILOX_ROUNDS; ++round) {
+      uint32_t hi0, lo0, hi1, lo1;
+      mulhilo(PHILOX_M0, c0, hi0, lo0);
+      mulhilo(PHILOX_M1, c2, hi1, lo1);
+      c0 = hi1 ^ c1 ^ key0;
+      c1 = lo1;
+      c2 = hi0 ^ c3 ^ key1;
+      c3 = lo0;
+      key0 += PHILOX_W0;
+      key1 += PHILOX_W1;
+    }
+    out[i] = c0 | (static_cast<uint64_t>(c1) << 32);
+  }
+}
+
+uint64_t CounterRng::makeKey(uint32_t seed, uint32_t from, uint32_t to, uint32_t stream) {
+  uint64_t link = (static_cast<uint64_t>(from) << 32) | to;
+  uint64_t domain = (static_cast<uint64_t>(seed) << 32) | stream;
+  return mix64(mix64(link) ^ domain);
+}
+
+} // namespace simulator
@@ -0,0 +1,264 @@
+/**
+ * @file delivery_queue.cpp
+ * @brief Implementation of delivery queue backends
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/delivery_queue.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace simulator {
+
+constexpr size_t TimingWheelDeliveryQueue::DEFAULT_SLOT_COUNT;
+
+namespace {
+
+/**
+ * @brief Moves the top element out of a priority queue and pops it
+ *
+ * The comparator only looks at deliveryTime, so leaving a moved-from
+ * string in the heap for the duration of pop() is safe.
+ */
+DelayedMessage popTop(std::priority_queue<DelayedMessage,
+                                          std::vector<DelayedMessage>,
+                                          std::greater<DelayedMessage>>& queue) {
+  DelayedMessage top = std::move(const_cast<DelayedMessage&>(queue.top()));
+  queue.pop();
+  return top;
+}
+
+/**
+ * @brief Gets the array behind a priority queue, in heap order
+ *
+ * Pushing the elements of a heap array in order into an empty heap
+ * reproduces the array, which std::priority_queue cannot otherwise do for
+ * elements that compare equal.
+ */
+template <typename Queue>
+const typename Queue::container_type& heapArray(const Queue& queue) {
+  struct Access : Queue {
+    static const typename Queue::container_type& of(const Queue& q) { return q.*&Access::c; }
+  };
+  return Access::of(queue);
+}
+
+} // anonymous namespace
+
+// DeliveryQueue
+
+void DeliveryQueue::pushBatch(std::vector<DelayedMessage>& messages) {
+  for (auto& message : messages) {
+    push(std::move(message));
+  }
+}
+
+// HeapDeliveryQueue
+
+void HeapDeliveryQueue::push(DelayedMessage message) {
+  heap_.push(std::move(message));
+}
+
+void HeapDeliveryQueue::pushBatch(std::vector<DelayedMessage>& messages) {
+  for (auto& message : messages) {
+    heap_.push(std::move(message));
+  }
+}
+
+size_t HeapDeliveryQueue::drainReady(uint64_t currentTime, std::vector<DelayedMessage>& out) {
+  size_t count = 0;
+  while (!heap_.empty() && heap_.top().deliveryTime <= currentTime) {
+    out.push_back(popTop(heap_));
+    count++;
+  }
+  return count;
+}
+
+uint64_t HeapDeliveryQueue::nextDeliveryBound() const {
+  return heap_.empty() ? UINT64_MAX : heap_.top().deliveryTime;
+}
+
+void HeapDeliveryQueue::clear() {
+  decltype(heap_) empty;
+  std::swap(heap_, empty);
+}
+
+std::vector<DelayedMessage> HeapDeliveryQueue::snapshot() const {
+  return heapArray(heap_);
+}
+
+// TimingWheelDeliveryQueue
+
+TimingWheelDeliveryQueue::TimingWheelDeliveryQueue(size_t slot_count) {
+  if (slot_count == 0) {
+    throw std::invalid_argument("Timing wheel needs at least one slot");
+  }
+
+  size_t size = 1;
+  while (size < slot_count) {
+    size <<= 1;
+  }
+  slots_.resize(size);
+  mask_ = size - 1;
+}
+
+void TimingWheelDeliveryQueue::push(DelayedMessage message) {
+  // Messages behind the cursor are already due and leave on the next drain
+  if (message.deliveryTime < cursor_) {
+    late_.push_back(std::move(message));
+    return;
+  }
+
+  if (message.deliveryTime - cursor_ >= slots_.size()) {
+    overflow_.push(std::move(message));
+    return;
+  }
+
+  slots_[message.deliveryTime & mask_].push_back(std::move(message));
+  wheel_count_++;
+}
+
+void TimingWheelDeliveryQueue::pushBatch(std::vector<DelayedMessage>& messages) {
+  for (auto& message : messages) {
+    TimingWheelDeliveryQueue::push(std::move(message));  // No virtual dispatch
+  }
+}
+
+size_t TimingWheelDeliveryQueue::drainReady(uint64_t currentTime, std::vector<DelayedMessage>& out) {
+  size_t count = 0;
+
+  // Late messages are all earlier than anything in the wheel
+  if (!late_.empty()) {
+    std::stable_sort(late_.begin(), late_.end(),
+                     [](const DelayedMessage& a, const DelayedMessage& b) {
+                       return a.deliveryTime < b.deliveryTime;
+                     });
+    for (auto& message : late_) {
+      out.push_back(std::move(message));
+    }
+    count += late_.size();
+    late_.clear();
+  }
+
+  while (cursor_ <= currentTime) {
+    if (wheel_count_ == 0) {
+      if (overflow_.empty() || overflow_.top().deliveryTime > currentTime) {
+        // Nothing due: skip the idle stretch in one step
+        if (currentTime != UINT64_MAX) {
+          cursor_ = currentTime + 1;
+        }
+        pullOverflow();
+        break;
+      }
+      // Jump to the next overflow message
+      cursor_ = std::max(cursor_, overflow_.top().deliveryTime);
+      pullOverflow();
+      continue;
+    }
+
+    std::vector<DelayedMessage>& slot = slots_[cursor_ & mask_];
+    if (!slot.empty()) {
+      for (auto& message : slot) {
+        out.push_back(std::move(message));
+      }
+      count += slot.size();
+      wheel_count_ -= slot.size();
+      slot.clear();  // Keeps capacity for reuse
+    }
+
+    cursor_++;
+    pullOverflow();
+  }
+
+  return count;
+}
+
+uint64_t TimingWheelDeliveryQueue::nextDeliveryBound() const {
+  if (!late_.empty()) {
+    return 0;
+  }
+  if (wheel_count_ > 0) {
+    return cursor_;  // Cheap bound; the exact slot would need a scan
+  }
+  return overflow_.empty() ? UINT64_MAX : overflow_.top().deliveryTime;
+}
+
+void TimingWheelDeliveryQueue::clear() {
+  for (auto& slot : slots_) {
+    slot.clear();
+  }
+  wheel_count_ = 0;
+  late_.clear();
+  decltype(overflow_) empty;
+  std::swap(overflow_, empty);
+}
+
+std::vector<DelayedMessage> TimingWheelDeliveryQueue::snapshot() const {
+  std::vector<DelayedMessage> messages;
+  messages.reserve(size());
+  messages.assign(late_.begin(), late_.end());
+  for (size_t i = 0; i < slots_.size() && messages.size() < late_.size() + wheel_count_; ++i) {
+    const std::vector<DelayedMessage>& slot = slots_[(cursor_ + i) & mask_];
+    messages.insert(messages.end(), slot.begin(), slot.end());
+  }
+  const auto& overflow = heapArray(overflow_);
+  messages.insert(messages.end(), overflow.begin(), overflow.end());
+  return messages;
+}
+
+void TimingWheelDeliveryQueue::setDrainTime(uint64_t time) {
+  if (size() != 0) {
+    throw std::logic_error("Drain time can only be set on an empty queue");
+  }
+  cursor_ = time;
+}
+
+void TimingWheelDeliveryQueue::pullOverflow() {
+  while (!overflow_.empty() && overflow_.top().deliveryTime - cursor_ < slots_.size()) {
+    DelayedMessage message = popTop(overflow_);
+    slots_[message.deliveryTime & mask_].push_back(std::move(message));
+    wheel_count_++;
+  }
+}
+
+// Factory and conversions
+
+std::unique_ptr<DeliveryQueue> makeDeliveryQueue(QueueBackend backend) {
+  switch (backend) {
+    case QueueBackend::TIMING_WHEEL:
+      return std::unique_ptr<DeliveryQueue>(new TimingWheelDeliveryQueue());
+    case QueueBackend::HEAP:
+    default:
+      return std::unique_ptr<DeliveryQueue>(new HeapDeliveryQueue());
+  }
+}
+
+std::string queueBackendToString(QueueBackend backend) {
+  switch (backend) {
+    case QueueBackend::HEAP:
+      return "heap";
+    case QueueBackend::TIMING_WHEEL:
+      return "timing_wheel";
+    default:
+      return "unknown";
+  }
+}
+
+QueueBackend stringToQueueBackend(const std::string& str) {
+  std::string lower = str;
+  std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+
+  if (lower == "heap") {
+    return QueueBackend::HEAP;
+  } else if (lower == "timing_wheel" || lower == "wheel") {
+    return QueueBackend::TIMING_WHEEL;
+  } else {
+    throw std::invalid_argument("Unknown delivery queue backend: " + str);
+  }
+}
+
+} // namespace simulator
@@ -0,0 +1,223 @@
+/**
+ * @file gateway.cpp
+ * @brief Implementation of Gateway class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/gateway.hpp"
+#include "simulator/logger.hpp"
+#include "simulator/mesh_transport.hpp"
+
+#include <stdexcept>
+
+namespace simulator {
+
+constexpr size_t Gateway::RECORD_HEADER_SIZE;
+constexpr size_t Gateway::MAX_DATAGRAM;
+constexpr uint32_t Gateway::BROADCAST;
+constexpr size_t Gateway::MAX_DATAGRAMS_PER_POLL;
+
+namespace {
+
+/// Records per datagram at most: asio gathers up to 64 buffers, two per record
+constexpr size_t MAX_RECORDS_PER_DATAGRAM = 32;
+
+void appendU32(std::string& out, uint32_t value) {
+  for (int shift = 0; shift < 32; shift += 8) {
+    out.push_back(static_cast<char>(value >> shift));
+  }
+}
+
+uint32_t readU32(const char* data) {
+  uint32_t value = 0;
+  for (int i = 3; i >= 0; --i) {
+    value = (value << 8) | static_cast<uint8_t>(data[i]);
+  }
+  return value;
+}
+
+} // anonymous namespace
+
+Gateway::Gateway(MeshTransport& transport, const std::string& listen,
+                 const std::string& backend, size_t max_datagram)
+  : transport_(transport), socket_(io_), backend_(parseEndpoint(backend)),
+    max_datagram_(max_datagram) {
+  if (max_datagram <= RECORD_HEADER_SIZE || max_datagram > MAX_DATAGRAM) {
+    throw std::invalid_argument("Gateway datagrams must hold " +
+                                std::to_string(RECORD_HEADER_SIZE + 1) + " to " +
+                                std::to_string(MAX_DATAGRAM) + " bytes");
+  }
+  if (backend_.port() == 0) {
+    throw std::invalid_argument("Gateway backend needs a port: " + backend);
+  }
+  const boost::asio::ip::udp::endpoint local = parseEndpoint(listen);
+  if (local.protocol() != backend_.protocol()) {
+    throw std::invalid_argument("Gateway listen and backend endpoints must use the same IP version");
+  }
+
+  socket_.open(local.protocol());
+  socket_.bind(local);
+  socket_.non_blocking(true);
+  receive_buffer_.resize(MAX_DATAGRAM);
+}
+
+Gateway::~Gateway() {
+  for (uint32_t node : exposed_) {
+    transport_.setFrameTap(node, nullptr);
+  }
+}
+
+boost::asio::ip::udp::endpoint Gateway::parseEndpoint(const std::string& text) {
+  const size_t colon = text.rfind(':');
+  if (colon == std::string::npos || colon == 0 || colon + 1 == text.size() ||
+      text.find_first_not_of("0123456789", colon + 1) != std::string::npos ||
+      text.size() - colon - 1 > 5) {
+    throw std::invalid_argument("Expected host:port, got '" + text + "'");
+  }
+  const unsigned long port = std::stoul(text.substr(colon + 1));
+  if (port > 65535) {
+    throw std::invalid_argument("Port out of range in '" + text + "'");
+  }
+
+  std::string host = text.substr(0, colon);
+  if (host.size() > 2 && host.front() == '[' && host.back() == ']') {
+    host = host.substr(1, host.size() - 2);
+  }
+  if (host == "localhost") {
+    host = "127.0.0.1";
+  }
+  boost::system::error_code ec;
+  const boost::asio::ip::address address = boost::asio::ip::make_address(host, ec);
+  if (ec) {
+    throw std::invalid_argument("Not a numeric address in '" + text + "'");
+  }
+  return boost::asio::ip::udp::endpoint(address, static_cast<uint16_t>(port));
+}
+
+void Gateway::expose(uint32_t nodeId) {
+  if (!exposed_.insert(nodeId).second) {
+    return;
+  }
+  // The tapped payload shares the frame buffer; nothing is copied until send
+  transport_.setFrameTap(nodeId, [this, nodeId](uint32_t from, bool broadcast,
+                                                const Payload& msg) {
+    if (broadcast && !forward_broadcasts_) {
+      return;
+    }
+    if (RECORD_HEADER_SIZE + msg.size() > max_datagram_) {
+      stats_.records_dropped++;
+      return;
+    }
+    uplink_.push_back(Record{nodeId, from, msg});
+  });
+}
+
+size_t Gateway::poll(uint64_t now_ms) {
+  const uint64_t received = stats_.records_received;
+
+  // The bridges' sends of the whole poll are evaluated as one batch
+  transport_.beginBatch();
+  for (size_t i = 0; i < MAX_DATAGRAMS_PER_POLL; ++i) {
+    boost::asio::ip::udp::endpoint sender;
+    boost::system::error_code ec;
+    const size_t size = socket_.receive_from(
+        boost::asio::buffer(&receive_buffer_[0], receive_buffer_.size()), sender, 0, ec);
+    if (ec) {
+      if (ec != boost::asio::error::would_block) {
+        SIM_LOG_WARN("[WARN] Gateway receive failed: {}", ec.message());
+      }
+      break;
+    }
+    stats_.datagrams_received++;
+    injectDatagram(receive_buffer_.data(), size, now_ms);
+  }
+  transport_.flushBatch();
+
+  return static_cast<size_t>(stats_.records_received - received);
+}
+
+void Gateway::injectDatagram(const char* data, size_t size, uint64_t now_ms) {
+  size_t offset = 0;
+  while (offset < size) {
+    if (size - offset < RECORD_HEADER_SIZE) {
+      stats_.records_rejected++;  // Truncated header
+      return;
+    }
+    const uint32_t bridge = readU32(data + offset);
+    const uint32_t peer = readU32(data + offset + 4);
+    const uint32_t length = readU32(data + offset + 8);
+    offset += RECORD_HEADER_SIZE;
+    if (length > size - offset) {
+      stats_.records_rejected++;  // Truncated payload
+      return;
+    }
+    const std::string body(data + offset, length);
+    offset += length;
+
+    bool sent = false;
+    if (isExposed(bridge)) {
+      sent = peer == BROADCAST ? transport_.sendBroadcast(bridge, body, now_ms)
+                               : transport_.sendSingle(bridge, peer, body, now_ms);
+    }
+    if (sent) {
+      stats_.records_received++;
+    } else {
+      stats_.records_rejected++;
+    }
+  }
+}
+
+size_t Gateway::flush() {
+  if (uplink_.empty()) {
+    return 0;
+  }
+
+  // All headers first, so the buffer does not move while gathered
+  headers_.clear();
+  for (const Record& record : uplink_) {
+    appendU32(headers_, record.bridge);
+    appendU32(headers_, record.peer);
+    appendU32(headers_, static_cast<uint32_t>(record.message.size()));
+  }
+
+  const uint64_t sent = stats_.datagrams_sent;
+  size_t first = 0;
+  size_t bytes = 0;
+  for (size_t i = 0; i < uplink_.size(); ++i) {
+    const size_t size = RECORD_HEADER_SIZE + uplink_[i].message.size();
+    if (i > first && (bytes + size > max_datagram_ || i - first == MAX_RECORDS_PER_DATAGRAM)) {
+      sendDatagram(first, i);
+      first = i;
+      bytes = 0;
+    }
+    bytes += size;
+  }
+  sendDatagram(first, uplink_.size());
+
+  uplink_.clear();  // Drops the frame references
+  return static_cast<size_t>(stats_.datagrams_sent - sent);
+}
+
+void Gateway::sendDatagram(size_t first, size_t last) {
+  buffers_.clear();
+  for (size_t i = first; i < last; ++i) {
+    const Payload& message = uplink_[i].message;
+    buffers_.push_back(boost::asio::buffer(&headers_[i * RECORD_HEADER_SIZE], RECORD_HEADER_SIZE));
+    if (message.size() > 0) {
+      buffers_.push_back(boost::asio::buffer(message.data(), message.size()));
+    }
+  }
+
+  boost::system::error_code ec;
+  socket_.send_to(buffers_, backend_, 0, ec);
+  if (ec) {
+    stats_.records_dropped += last - first;
+    return;
+  }
+  stats_.datagrams_sent++;
+  stats_.records_sent += last - first;
+}
+
+} // namespace simulator
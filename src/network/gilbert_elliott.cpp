@@ -0,0 +1,73 @@
+/**
+ * @file gilbert_elliott.cpp
+ * @brief Implementation of the Gilbert-Elliott loss chain
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/gilbert_elliott.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace simulator {
+
+constexpr uint8_t GilbertElliott::GOOD;
+constexpr uint8_t GilbertElliott::BAD;
+
+namespace {
+
+// A 32-bit word is below the threshold with the given probability;
+// probability 1.0 maps to 2^32, above every word
+uint64_t toThreshold(float probability) {
+  const double p = std::min(1.0, std::max(0.0, static_cast<double>(probability)));
+  return static_cast<uint64_t>(p * 4294967296.0);
+}
+
+double toProbability(uint64_t threshold) {
+  return static_cast<double>(threshold) / 4294967296.0;
+}
+
+} // anonymous namespace
+
+GilbertElliott::GilbertElliott(float good_to_bad, float bad_to_good,
+                               float loss_good, float loss_bad)
+  : leave_{toThreshold(good_to_bad), toThreshold(bad_to_good)}
+  , loss_{toThreshold(loss_good), toThreshold(loss_bad)}
+{
+}
+
+void GilbertElliott::stepBatch(uint8_t* states, const uint64_t* random, uint8_t* lost,
+                               size_t count) const {
+  // Selects rather than indexed loads, so the loop vectorizes
+  const uint64_t leave_good = leave_[GOOD];
+  const uint64_t leave_bad = leave_[BAD];
+  const uint64_t loss_good = loss_[GOOD];
+  const uint64_t loss_bad = loss_[BAD];
+  for (size_t i = 0; i < count; ++i) {
+    const uint64_t transition = random[i] & 0xFFFFFFFFu;
+    const uint64_t loss = random[i] >> 32;
+    const uint8_t bad = states[i];
+    const uint8_t next = static_cast<uint8_t>(bad ^ (transition < (bad ? leave_bad : leave_good)));
+    states[i] = next;
+    lost[i] = static_cast<uint8_t>(loss < (next ? loss_bad : loss_good));
+  }
+}
+
+double GilbertElliott::getMeanLoss() const {
+  const double p = toProbability(leave_[GOOD]);
+  const double r = toProbability(leave_[BAD]);
+  if (p + r == 0.0) {
+    return toProbability(loss_[GOOD]);  // Never leaves GOOD
+  }
+  const double bad = p / (p + r);
+  return (1.0 - bad) * toProbability(loss_[GOOD]) + bad * toProbability(loss_[BAD]);
+}
+
+double GilbertElliott::getMeanBadRun() const {
+  const double r = toProbability(leave_[BAD]);
+  return r > 0.0 ? 1.0 / r : std::numeric_limits<double>::infinity();
+}
+
+} // namespace simulator
@@ -0,0 +1,152 @@
+/**
+ * @file latency_histogram.cpp
+ * @brief Implementation of LatencyHistogram class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/latency_histogram.hpp"
+#include "simulator/checkpoint.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace simulator {
+
+constexpr uint32_t LatencyHistogram::SUB_BUCKET_BITS;
+constexpr uint32_t LatencyHistogram::MAX_TRACKABLE_MS;
+constexpr size_t LatencyHistogram::BUCKET_COUNT;
+
+namespace {
+
+constexpr uint32_t SUB_BUCKET_COUNT = 1u << LatencyHistogram::SUB_BUCKET_BITS;
+
+inline uint32_t highestBit(uint32_t value) {
+  uint32_t bit = 0;
+  while (value >>= 1) {
+    bit++;
+  }
+  return bit;
+}
+
+} // anonymous namespace
+
+size_t LatencyHistogram::bucketFor(uint32_t value) {
+  value = std::min(value, MAX_TRACKABLE_MS);
+  if (value < SUB_BUCKET_COUNT) {
+    return value;
+  }
+
+  // Keep the top SUB_BUCKET_BITS + 1 bits: mantissa is in [32, 63] and
+  // each step of shift doubles the bucket width
+  uint32_t shift = highestBit(value) - SUB_BUCKET_BITS;
+  uint32_t mantissa = value >> shift;
+  return static_cast<size_t>(shift) * SUB_BUCKET_COUNT + mantissa;
+}
+
+uint32_t LatencyHistogram::bucketUpperBound(size_t bucket) {
+  if (bucket < 2 * SUB_BUCKET_COUNT) {
+    return static_cast<uint32_t>(bucket);  // Exact buckets
+  }
+
+  uint32_t shift = static_cast<uint32_t>(bucket / SUB_BUCKET_COUNT) - 1;
+  uint32_t mantissa = static_cast<uint32_t>(bucket % SUB_BUCKET_COUNT) + SUB_BUCKET_COUNT;
+  return ((mantissa + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint32_t latency_ms) {
+  counts_[bucketFor(latency_ms)]++;
+  count_++;
+  sum_ += latency_ms;
+  min_ = std::min(min_, latency_ms);
+  max_ = std::max(max_, latency_ms);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+  for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+    counts_[i] += other.counts_[i];
+  }
+  count_ += other.count_;
+  sum_ += other.sum_;
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+}
+
+void LatencyHistogram::clear() {
+  *this = LatencyHistogram();
+}
+
+void LatencyHistogram::saveState(CheckpointWriter& out) const {
+  out.write<uint64_t>(count_);
+  out.write<uint64_t>(sum_);
+  out.write<uint32_t>(min_);
+  out.write<uint32_t>(max_);
+  uint32_t used = 0;
+  for (uint64_t count : counts_) {
+    used += count > 0;
+  }
+  out.write<uint32_t>(used);
+  for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+    if (counts_[i] > 0) {
+      out.write<uint16_t>(static_cast<uint16_t>(i));
+      out.write<uint64_t>(counts_[i]);
+    }
+  }
+}
+
+void LatencyHistogram::loadState(CheckpointReader& in) {
+  clear();
+  count_ = in.read<uint64_t>();
+  sum_ = in.read<uint64_t>();
+  min_ = in.read<uint32_t>();
+  max_ = in.read<uint32_t>();
+  const uint32_t used = in.read<uint32_t>();
+  for (uint32_t i = 0; i < used; ++i) {
+    const uint16_t bucket = in.read<uint16_t>();
+    if (bucket >= BUCKET_COUNT) {
+      throw std::runtime_error("Checkpoint histogram bucket out of range");
+    }
+    counts_[bucket] = in.read<uint64_t>();
+  }
+}
+
+double LatencyHistogram::getMean() const {
+  return count_ > 0 ? static_cast<double>(sum_) / static_cast<double>(count_) : 0.0;
+}
+
+uint32_t LatencyHistogram::getPercentile(double percentile) const {
+  if (count_ == 0) {
+    return 0;
+  }
+
+  percentile = std::min(100.0, std::max(0.0, percentile));
+  // The epsilon keeps e.g. 99.9% of 1000 at rank 999 despite rounding
+  uint64_t rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * count_ - 1e-9));
+  rank = std::max<uint64_t>(rank, 1);
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+    seen += counts_[i];
+    if (seen >= rank) {
+      return std::min(max_, std::max(min_, bucketUpperBound(i)));
+    }
+  }
+  return max_;
+}
+
+void LatencyHistogram::getCumulativeCounts(const uint32_t* bounds, size_t bound_count,
+                                           uint64_t* counts) const {
+  uint64_t seen = 0;
+  size_t bucket = 0;
+  for (size_t b = 0; b < bound_count; ++b) {
+    const size_t last = bucketFor(bounds[b]);
+    for (; bucket <= last; ++bucket) {
+      seen += counts_[bucket];
+    }
+    counts[b] = seen;
+  }
+}
+
+} // namespace simulator
@@ -0,0 +1,205 @@
+/**
+ * @file latency_sampler.cpp
+ * @brief Implementation of LatencySampler class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/latency_sampler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+namespace simulator {
+
+constexpr size_t LatencySampler::MAX_TABLE_SIZE;
+
+namespace {
+
+/**
+ * @brief CDF of the unclamped continuous latency distribution
+ */
+double continuousCdf(const LatencyConfig& config, double x) {
+  double min = config.min_ms;
+  double range = static_cast<double>(config.max_ms) - config.min_ms;
+
+  switch (config.distribution) {
+    case DistributionType::NORMAL: {
+      double mean = (config.min_ms + static_cast<double>(config.max_ms)) / 2.0;
+      double stddev = range / 6.0;
+      return 0.5 * std::erfc(-(x - mean) / (stddev * std::sqrt(2.0)));
+    }
+
+    case DistributionType::EXPONENTIAL: {
+      double lambda = 3.0 / range;
+      return x <= min ? 0.0 : 1.0 - std::exp(-lambda * (x - min));
+    }
+
+    case DistributionType::UNIFORM:
+    default:
+      return std::min(1.0, std::max(0.0, (x - min + 0.5) / (range + 1.0)));
+  }
+}
+
+/**
+ * @brief Clamps a continuous sample to [min, max] and rounds it
+ */
+uint32_t clampRound(double value, uint32_t min, uint32_t max) {
+  value = std::max(static_cast<double>(min), value);
+  value = std::min(static_cast<double>(max), value);
+
+  uint32_t result = static_cast<uint32_t>(std::round(value));
+  result = std::max(min, result);
+  result = std::min(max, result);
+  return result;
+}
+
+} // anonymous namespace
+
+LatencySampler::LatencySampler(const LatencyConfig& config)
+    : config_(config) {
+  if (!config.isValid()) {
+    throw std::invalid_argument("Invalid latency configuration");
+  }
+
+  uint64_t size = static_cast<uint64_t>(config.max_ms) - config.min_ms + 1;
+  if (size <= MAX_TABLE_SIZE) {
+    buildTable();
+  }
+}
+
+double LatencySampler::probability(uint32_t latency_ms) const {
+  if (latency_ms < config_.min_ms || latency_ms > config_.max_ms) {
+    return 0.0;
+  }
+  if (isTabulated()) {
+    return probability_[latency_ms - config_.min_ms];
+  }
+  if (config_.min_ms == config_.max_ms) {
+    return 1.0;
+  }
+
+  // Clamping moves the tails onto the end points; rounding moves the
+  // mass within +/-0.5ms onto each integer
+  double lower = latency_ms == config_.min_ms ? 0.0 :
+                 continuousCdf(config_, latency_ms - 0.5);
+  double upper = latency_ms == config_.max_ms ? 1.0 :
+                 continuousCdf(config_, latency_ms + 0.5);
+  return std::max(0.0, upper - lower);
+}
+
+void LatencySampler::buildTable() {
+  const size_t size = static_cast<size_t>(config_.max_ms - config_.min_ms) + 1;
+
+  // Tabulating happens before table_ is filled, so probability() below
+  // computes each value from the CDF
+  std::vector<double> mass(size);
+  double total = 0.0;
+  for (size_t i = 0; i < size; ++i) {
+    mass[i] = probability(config_.min_ms + static_cast<uint32_t>(i));
+    total += mass[i];
+  }
+  for (double& p : mass) {
+    p /= total;  // Absorb rounding error in the CDF differences
+  }
+
+  // Vose's alias method: split buckets into under- and over-full ones
+  // and let each under-full bucket borrow from an over-full one
+  std::vector<double> scaled(size);
+  std::vector<uint32_t> small;
+  std::vector<uint32_t> large;
+  for (size_t i = 0; i < size; ++i) {
+    scaled[i] = mass[i] * size;
+    (scaled[i] < 1.0 ? small : large).push_back(static_cast<uint32_t>(i));
+  }
+
+  std::vector<Entry> table(size);
+  while (!small.empty() && !large.empty()) {
+    uint32_t s = small.back();
+    small.pop_back();
+    uint32_t l = large.back();
+
+    table[s].threshold = static_cast<uint32_t>(std::max(0.0, scaled[s]) * 4294967296.0);
+    table[s].alias = l;
+
+    scaled[l] -= 1.0 - scaled[s];
+    if (scaled[l] < 1.0) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+
+  // Whatever is left is full up to rounding error
+  for (uint32_t i : large) {
+    table[i] = Entry{UINT32_MAX, i};
+  }
+  for (uint32_t i : small) {
+    table[i] = Entry{UINT32_MAX, i};
+  }
+
+  probability_ = std::move(mass);
+  table_ = std::move(table);
+}
+
+uint32_t LatencySampler::sample(CounterRng& rng) const {
+  if (!isTabulated()) {
+    return sampleDirect(rng);
+  }
+  uint64_t low = rng();
+  return lookup(low | (static_cast<uint64_t>(rng()) << 32));
+}
+
+uint32_t LatencySampler::sample(uint64_t random) const {
+  if (!isTabulated()) {
+    CounterRng rng(random, 0);
+    return sampleDirect(rng);
+  }
+  return lookup(random);
+}
+
+void LatencySampler::sampleBatch(const uint64_t* random, uint32_t* out, size_t count) const {
+  if (!isTabulated()) {
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = sample(random[i]);
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    out[i] = lookup(random[i]);
+  }
+}
+
+uint32_t LatencySampler::sampleDirect(CounterRng& rng) const {
+  const uint32_t min = config_.min_ms;
+  const uint32_t max = config_.max_ms;
+  if (min == max) {
+    return min;
+  }
+
+  switch (config_.distribution) {
+    case DistributionType::NORMAL: {
+      double mean = (min + static_cast<double>(max)) / 2.0;
+      double stddev = (static_cast<double>(max) - min) / 6.0;  // 99.7% within [min, max]
+      std::normal_distribution<double> dist(mean, stddev);
+      return clampRound(dist(rng), min, max);
+    }
+
+    case DistributionType::EXPONENTIAL: {
+      double lambda = 3.0 / (static_cast<double>(max) - min);
+      std::exponential_distribution<double> dist(lambda);
+      return clampRound(dist(rng) + min, min, max);
+    }
+
+    case DistributionType::UNIFORM:
+    default: {
+      std::uniform_int_distribution<uint32_t> dist(min, max);
+      return dist(rng);
+    }
+  }
+}
+
+} // namespace simulator
@@ -0,0 +1,99 @@
+/**
+ * @file link_table.cpp
+ * @brief Implementation of LinkTable class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/link_table.hpp"
+
+namespace simulator {
+
+constexpr uint32_t LinkTable::NPOS;
+
+namespace {
+
+constexpr size_t INITIAL_CAPACITY = 64;
+
+} // anonymous namespace
+
+LinkTable::LinkTable()
+    : slots_(INITIAL_CAPACITY, Slot{0, NPOS}),
+      mask_(INITIAL_CAPACITY - 1) {
+}
+
+size_t LinkTable::slotFor(uint64_t key) const {
+  // Fibonacci hashing spreads sequential node IDs across the table
+  return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 32) & mask_;
+}
+
+uint32_t LinkTable::find(uint32_t from, uint32_t to) const {
+  uint64_t key = makeKey(from, to);
+  for (size_t i = slotFor(key);; i = (i + 1) & mask_) {
+    const Slot& slot = slots_[i];
+    if (slot.index == NPOS) {
+      return NPOS;
+    }
+    if (slot.key == key) {
+      return slot.index;
+    }
+  }
+}
+
+uint32_t LinkTable::insert(uint32_t from, uint32_t to) {
+  // Keep the load factor at or below 1/2 so probe sequences stay short
+  if ((size_ + 1) * 2 > slots_.size()) {
+    grow();
+  }
+
+  uint64_t key = makeKey(from, to);
+  for (size_t i = slotFor(key);; i = (i + 1) & mask_) {
+    Slot& slot = slots_[i];
+    if (slot.index == NPOS) {
+      slot.key = key;
+      slot.index = static_cast<uint32_t>(size_++);
+      keys_.push_back(key);
+      return slot.index;
+    }
+    if (slot.key == key) {
+      return slot.index;
+    }
+  }
+}
+
+std::vector<std::pair<uint32_t, uint32_t>> LinkTable::getLinks() const {
+  std::vector<std::pair<uint32_t, uint32_t>> links;
+  links.reserve(size_);
+  for (uint32_t i = 0; i < size_; ++i) {
+    links.push_back(getLink(i));
+  }
+  return links;
+}
+
+void LinkTable::clear() {
+  slots_.assign(INITIAL_CAPACITY, Slot{0, NPOS});
+  mask_ = INITIAL_CAPACITY - 1;
+  size_ = 0;
+  keys_.clear();
+}
+
+void LinkTable::grow() {
+  std::vector<Slot> old;
+  old.swap(slots_);
+  slots_.assign(old.size() * 2, Slot{0, NPOS});
+  mask_ = slots_.size() - 1;
+
+  for (const Slot& entry : old) {
+    if (entry.index == NPOS) {
+      continue;
+    }
+    size_t i = slotFor(entry.key);
+    while (slots_[i].index != NPOS) {
+      i = (i + 1) & mask_;
+    }
+    slots_[i] = entry;
+  }
+}
+
+} // namespace simulator
@@ -0,0 +1,132 @@
+/**
+ * @file link_trace.cpp
+ * @brief Implementation of memory-mapped link traces
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/link_trace.hpp"
+#include "simulator/mapped_file.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace simulator {
+
+namespace {
+
+const char TRACE_MAGIC[8] = {'P', 'M', 'T', 'R', 'A', 'C', 'E', '1'};
+const uint32_t TRACE_VERSION = 1;
+
+struct TraceHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t links;
+};
+
+static_assert(sizeof(TraceHeader) == 16, "TraceHeader must match the file layout");
+static_assert(sizeof(LinkTrace::Link) == 24, "LinkTrace::Link must match the file layout");
+
+} // anonymous namespace
+
+std::shared_ptr<const LinkTrace> LinkTrace::open(const std::string& path) {
+  std::shared_ptr<LinkTrace> trace(new LinkTrace());
+
+  trace->file_.reset(new MappedFile(path));
+  trace->data_ = trace->file_->data();
+  trace->size_ = trace->file_->size();
+
+  // Validate the header and directory; samples are not touched, so pages
+  // are only loaded once playback reaches them
+  if (trace->size_ < sizeof(TraceHeader)) {
+    throw std::runtime_error("Trace file too small: " + path);
+  }
+  TraceHeader header;
+  std::memcpy(&header, trace->data_, sizeof(header));
+  if (std::memcmp(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0) {
+    throw std::runtime_error("Not a link trace file: " + path);
+  }
+  if (header.version != TRACE_VERSION) {
+    throw std::runtime_error("Unsupported link trace version " +
+                             std::to_string(header.version) + ": " + path);
+  }
+
+  const uint64_t directory_end = sizeof(TraceHeader) +
+                                 static_cast<uint64_t>(header.links) * sizeof(Link);
+  if (directory_end > trace->size_) {
+    throw std::runtime_error("Truncated link trace directory: " + path);
+  }
+  trace->links_ = reinterpret_cast<const Link*>(trace->data_ + sizeof(TraceHeader));
+  trace->link_count_ = header.links;
+
+  for (size_t i = 0; i < trace->link_count_; ++i) {
+    const Link& link = trace->links_[i];
+    if (link.count == 0 || link.count > UINT32_MAX ||
+        link.offset % alignof(TraceSample) != 0 || link.offset < directory_end ||
+        link.offset > trace->size_ ||
+        link.count > (trace->size_ - link.offset) / sizeof(TraceSample)) {
+      throw std::runtime_error("Malformed series for link " + std::to_string(link.from) +
+                               " -> " + std::to_string(link.to) + " in " + path);
+    }
+  }
+
+  return trace;
+}
+
+void LinkTrace::write(const std::string& path, const std::vector<Series>& series) {
+  TraceHeader header;
+  std::memcpy(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+  header.version = TRACE_VERSION;
+  header.links = static_cast<uint32_t>(series.size());
+
+  // Samples follow the directory back to back; 16-byte samples keep every
+  // series 8-byte aligned
+  std::vector<Link> directory;
+  directory.reserve(series.size());
+  uint64_t offset = sizeof(TraceHeader) + series.size() * sizeof(Link);
+  for (const auto& s : series) {
+    if (s.samples.empty()) {
+      throw std::invalid_argument("Link trace series must not be empty");
+    }
+    directory.push_back(Link{s.from, s.to, offset, s.samples.size()});
+    offset += s.samples.size() * sizeof(TraceSample);
+  }
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    throw std::runtime_error("Cannot create trace file: " + path);
+  }
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char*>(directory.data()),
+            static_cast<std::streamsize>(directory.size() * sizeof(Link)));
+  for (const auto& s : series) {
+    out.write(reinterpret_cast<const char*>(s.samples.data()),
+              static_cast<std::streamsize>(s.samples.size() * sizeof(TraceSample)));
+  }
+  if (!out) {
+    throw std::runtime_error("Cannot write trace file: " + path);
+  }
+}
+
+LinkTrace::~LinkTrace() = default;
+
+TraceCursor LinkTrace::cursor(size_t index) const {
+  const Link& link = links_[index];
+  return TraceCursor(reinterpret_cast<const TraceSample*>(data_ + link.offset),
+                     static_cast<uint32_t>(link.count));
+}
+
+uint32_t LinkTrace::getMinLatency(size_t index) const {
+  const Link& link = links_[index];
+  const TraceSample* samples = reinterpret_cast<const TraceSample*>(data_ + link.offset);
+  uint32_t latency = UINT32_MAX;
+  for (uint64_t i = 0; i < link.count; ++i) {
+    latency = std::min(latency, samples[i].latency_ms);
+  }
+  return latency;
+}
+
+} // namespace simulator
@@ -0,0 +1,658 @@
+/**
+ * @file mesh_transport.cpp
+ * @brief Implementation of MeshTransport class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/mesh_transport.hpp"
+#include "simulator/alloc_tracker.hpp"
+#include "simulator/topology_listener.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+#include <utility>
+
+namespace simulator {
+
+constexpr size_t MeshTransport::FRAME_HEADER_SIZE;
+
+namespace {
+
+void appendU32(std::string& out, uint32_t value) {
+  char bytes[sizeof(uint32_t)];
+  std::memcpy(bytes, &value, sizeof(value));
+  out.append(bytes, sizeof(bytes));
+}
+
+uint32_t readU32(const Payload& in, size_t offset) {
+  uint32_t value;
+  std::memcpy(&value, in.data() + offset, sizeof(value));
+  return value;
+}
+
+} // anonymous namespace
+
+MeshTransport::MeshTransport(NetworkSimulator& network)
+    : network_(network) {
+}
+
+void MeshTransport::attach(uint32_t nodeId, const Endpoint& endpoint) {
+  SIM_ALLOC_SCOPE(AllocTag::NETWORK);
+  if (nodeId == 0) {
+    throw std::invalid_argument("Node ID must be non-zero");
+  }
+
+  // Re-attaching only replaces the callbacks and leaves routes alone
+  std::shared_ptr<Endpoint>& slot = endpoints_[nodeId];
+  const bool attached = slot != nullptr;
+  slot = std::make_shared<Endpoint>(endpoint);
+  if (!attached) {
+    updateRoutesForNode(nodeId, true);
+  }
+}
+
+void MeshTransport::detach(uint32_t nodeId) {
+  if (endpoints_.erase(nodeId) > 0) {
+    updateRoutesForNode(nodeId, false);
+  }
+}
+
+bool MeshTransport::isAttached(uint32_t nodeId) const {
+  return endpoints_.count(nodeId) > 0;
+}
+
+void MeshTransport::attachRemote(uint32_t nodeId) {
+  Endpoint endpoint;
+  endpoint.remote = true;
+  attach(nodeId, endpoint);
+}
+
+bool MeshTransport::isRemote(uint32_t nodeId) const {
+  auto it = endpoints_.find(nodeId);
+  return it != endpoints_.end() && it->second->remote;
+}
+
+void MeshTransport::setFrameTap(uint32_t nodeId, FrameTap tap) {
+  if (tap) {
+    taps_[nodeId] = std::move(tap);
+  } else {
+    taps_.erase(nodeId);
+  }
+}
+
+void MeshTransport::removeNode(uint32_t nodeId) {
+  detach(nodeId);
+
+  auto it = links_.find(nodeId);
+  if (it == links_.end()) {
+    return;
+  }
+
+  const std::set<uint32_t> neighbours = std::move(it->second);
+  links_.erase(it);
+  for (uint32_t neighbour : neighbours) {
+    links_[neighbour].erase(nodeId);
+    link_count_--;
+  }
+  // The detached node is in no cached tree, so its links carried no route
+  domains_dirty_ = true;
+  if (listener_) {
+    for (uint32_t neighbour : neighbours) {
+      listener_->linkChanged(nodeId, neighbour, false);
+    }
+  }
+}
+
+void MeshTransport::addLink(uint32_t a, uint32_t b) {
+  SIM_ALLOC_SCOPE(AllocTag::NETWORK);
+  if (a == 0 || b == 0) {
+    throw std::invalid_argument("Node ID must be non-zero");
+  }
+  if (a == b) {
+    throw std::invalid_argument("Cannot link a node to itself");
+  }
+
+  if (!links_[a].insert(b).second) {
+    return;  // Link already exists
+  }
+  links_[b].insert(a);
+  link_count_++;
+  updateRoutesForLink(a, b, true);
+  if (listener_) {
+    listener_->linkChanged(a, b, true);
+  }
+
+  // Notify both ends, as painlessMesh does for a new station connection
+  auto notify = [this](uint32_t node, uint32_t peer) {
+    auto it = endpoints_.find(node);
+    if (it == endpoints_.end()) {
+      return;
+    }
+    std::shared_ptr<Endpoint> endpoint = it->second;
+    if (endpoint->onNewConnection) {
+      endpoint->onNewConnection(peer);
+    }
+    if (endpoint->onChangedConnections) {
+      endpoint->onChangedConnections();
+    }
+  };
+  notify(a, b);
+  notify(b, a);
+}
+
+size_t MeshTransport::addLinks(const std::vector<std::pair<uint32_t, uint32_t>>& links) {
+  SIM_ALLOC_SCOPE(AllocTag::NETWORK);
+  for (const auto& link : links) {
+    if (link.first == 0 || link.second == 0) {
+      throw std::invalid_argument("Node ID must be non-zero");
+    }
+    if (link.first == link.second) {
+      throw std::invalid_argument("Cannot link a node to itself");
+    }
+  }
+
+  std::vector<std::pair<uint32_t, uint32_t>> added;
+  added.reserve(links.size());
+  for (const auto& link : links) {
+    if (links_[link.first].insert(link.second).second) {
+      links_[link.second].insert(link.first);
+      added.push_back(link);
+    }
+  }
+  if (added.empty()) {
+    return 0;
+  }
+  link_count_ += added.size();
+  invalidateRoutes();
+  if (listener_) {
+    for (const auto& link : added) {
+      listener_->linkChanged(link.first, link.second, true);
+    }
+  }
+
+  // New connections per link, then one topology change per endpoint
+  std::set<uint32_t> changed;
+  auto notify = [this, &changed](uint32_t node, uint32_t peer) {
+    auto it = endpoints_.find(node);
+    if (it == endpoints_.end()) {
+      return;
+    }
+    std::shared_ptr<Endpoint> endpoint = it->second;
+    if (endpoint->onNewConnection) {
+      endpoint->onNewConnection(peer);
+    }
+    changed.insert(node);
+  };
+  for (const auto& link : added) {
+    notify(link.first, link.second);
+    notify(link.second, link.first);
+  }
+  for (uint32_t node : changed) {
+    auto it = endpoints_.find(node);
+    if (it == endpoints_.end()) {
+      continue;
+    }
+    std::shared_ptr<Endpoint> endpoint = it->second;
+    if (endpoint->onChangedConnections) {
+      endpoint->onChangedConnections();
+    }
+  }
+  return added.size();
+}
+
+bool MeshTransport::removeLink(uint32_t a, uint32_t b) {
+  auto it = links_.find(a);
+  if (it == links_.end() || it->second.erase(b) == 0) {
+    return false;
+  }
+  links_[b].erase(a);
+  link_count_--;
+  updateRoutesForLink(a, b, false);
+  if (listener_) {
+    listener_->linkChanged(a, b, false);
+  }
+  return true;
+}
+
+bool MeshTransport::hasLink(uint32_t a, uint32_t b) const {
+  auto it = links_.find(a);
+  return it != links_.end() && it->second.count(b) > 0;
+}
+
+std::vector<std::pair<uint32_t, uint32_t>> MeshTransport::getLinks() const {
+  std::vector<std::pair<uint32_t, uint32_t>> links;
+  links.reserve(link_count_);
+  for (const auto& entry : links_) {
+    for (uint32_t neighbour : entry.second) {
+      if (entry.first < neighbour) {
+        links.emplace_back(entry.first, neighbour);
+      }
+    }
+  }
+  return links;
+}
+
+std::vector<uint32_t> MeshTransport::getNeighbours(uint32_t nodeId) const {
+  auto it = links_.find(nodeId);
+  if (it == links_.end()) {
+    return {};
+  }
+  return std::vector<uint32_t>(it->second.begin(), it->second.end());
+}
+
+std::list<uint32_t> MeshTransport::getReachableNodes(uint32_t nodeId) const {
+  std::list<uint32_t> nodes;
+  if (!isAttached(nodeId)) {
+    return nodes;
+  }
+
+  // Lookups may come from several worker threads and fill route_cache_
+  std::lock_guard<std::mutex> lock(route_mutex_);
+  for (const auto& pair : getTree(nodeId)) {
+    if (pair.first != nodeId) {
+      nodes.push_back(pair.first);
+    }
+  }
+  return nodes;
+}
+
+uint32_t MeshTransport::getNextHop(uint32_t from, uint32_t dest) const {
+  if (from == dest || !isAttached(from) || !isAttached(dest)) {
+    return 0;
+  }
+  const ParentMap& tree = getTree(dest);
+  auto it = tree.find(from);
+  return it != tree.end() ? it->second : 0;
+}
+
+uint32_t MeshTransport::getMinLinkLatency() const {
+  uint32_t lookahead = UINT32_MAX;
+  for (const auto& pair : links_) {
+    for (uint32_t neighbour : pair.second) {
+      // Each link appears once per direction, covering both latencies
+      lookahead = std::min(lookahead, network_.getMinLatency(pair.first, neighbour));
+    }
+  }
+  return lookahead;
+}
+
+bool MeshTransport::sendSingle(uint32_t from, uint32_t dest, const std::string& msg) {
+  return sendSingle(from, dest, msg, current_time_);
+}
+
+bool MeshTransport::sendSingle(uint32_t from, uint32_t dest, const std::string& msg,
+                               uint64_t sendTime) {
+  SIM_ALLOC_SCOPE(AllocTag::NETWORK);
+  if (from == dest || !isAttached(from) || !isAttached(dest)) {
+    return false;
+  }
+  syncDomains();
+
+  // The next hop is the sender's parent in the tree rooted at the destination
+  const ParentMap& tree = getTree(dest);
+  auto it = tree.find(from);
+  if (it == tree.end()) {
+    stats_.frames_dropped++;
+    return false;
+  }
+
+  network_.enqueueMessage(from, it->second,
+                          encodeFrame(FrameType::SINGLE, from, dest, msg),
+                          sendTime);
+  stats_.frames_sent++;
+  return true;
+}
+
+Payload MeshTransport::encodeSingle(uint32_t from, uint32_t dest, const std::string& msg) {
+  return encodeFrame(FrameType::SINGLE, from, dest, msg);
+}
+
+bool MeshTransport::sendSingleFrame(uint32_t from, const Payload& frame, uint64_t sendTime) {
+  SIM_ALLOC_SCOPE(AllocTag::NETWORK);
+  if (frame.size() < FRAME_HEADER_SIZE ||
+      static_cast<FrameType>(frame[0]) != FrameType::SINGLE ||
+      readU32(frame, 1) != from) {
+    throw std::invalid_argument("Not a unicast frame of node " + std::to_string(from));
+  }
+  const uint32_t dest = readU32(frame, 1 + sizeof(uint32_t));
+  if (from == dest || !isAttached(from) || !isAttached(dest)) {
+    return false;
+  }
+  syncDomains();
+
+  const ParentMap& tree = getTree(dest);
+  auto it = tree.find(from);
+  if (it == tree.end()) {
+    stats_.frames_dropped++;
+    return false;
+  }
+
+  network_.enqueueMessage(from, it->second, frame, sendTime);
+  stats_.frames_sent++;
+  return true;
+}
+
+bool MeshTransport::sendBroadcast(uint32_t from, const std::string& msg) {
+  return sendBroadcast(from, msg, current_time_);
+}
+
+bool MeshTransport::sendBroadcast(uint32_t from, const std::string& msg, uint64_t sendTime) {
+  SIM_ALLOC_SCOPE(AllocTag::NETWORK);
+  if (!isAttached(from)) {
+    return false;
+  }
+  syncDomains();
+
+  forwardBroadcast(from, from, encodeFrame(FrameType::BROADCAST, from, 0, msg), sendTime);
+  stats_.frames_sent++;
+  return true;
+}
+
+Payload MeshTransport::encodeBroadcast(uint32_t from, const std::string& msg) {
+  return encodeFrame(FrameType::BROADCAST, from, 0, msg);
+}
+
+bool MeshTransport::sendBroadcastFrame(uint32_t from, const Payload& frame) {
+  return sendBroadcastFrame(from, frame, current_time_);
+}
+
+bool MeshTransport::sendBroadcastFrame(uint32_t from, const Payload& frame, uint64_t sendTime) {
+  SIM_ALLOC_SCOPE(AllocTag::NETWORK);
+  if (frame.size() < FRAME_HEADER_SIZE ||
+      static_cast<FrameType>(frame[0]) != FrameType::BROADCAST ||
+      readU32(frame, 1) != from) {
+    throw std::invalid_argument("Not a broadcast frame of node " + std::to_string(from));
+  }
+  if (!isAttached(from)) {
+    return false;
+  }
+  syncDomains();
+
+  forwardBroadcast(from, from, frame, sendTime);
+  stats_.frames_sent++;
+  return true;
+}
+
+size_t MeshTransport::update(uint64_t currentTime) {
+  SIM_ALLOC_SCOPE(AllocTag::NETWORK);
+  if (currentTime > current_time_) {
+    current_time_ = currentTime;
+  }
+  syncDomains();
+
+  network_.beginBatch();
+  const size_t processed = network_.drainReady(current_time_, [this](DelayedMessage& hop) {
+    handleFrame(hop);
+  });
+  network_.flushBatch();
+  return processed;
+}
+
+const MeshTransport::ParentMap& MeshTransport::getTree(uint32_t root) const {
+  auto cached = route_cache_.find(root);
+  if (cached != route_cache_.end()) {
+    return cached->second;
+  }
+
+  ParentMap& parents = route_cache_[root];
+  if (!isAttached(root)) {
+    return parents;
+  }
+
+  // Breadth-first search; only attached nodes can relay frames
+  std::deque<uint32_t> queue;
+  parents[root] = root;
+  queue.push_back(root);
+
+  while (!queue.empty()) {
+    uint32_t node = queue.front();
+    queue.pop_front();
+
+    auto it = links_.find(node);
+    if (it == links_.end()) {
+      continue;
+    }
+    for (uint32_t neighbour : it->second) {
+      if (parents.count(neighbour) == 0 && isAttached(neighbour)) {
+        parents[neighbour] = node;
+        queue.push_back(neighbour);
+      }
+    }
+  }
+
+  return parents;
+}
+
+template <typename Changed>
+void MeshTransport::dropRoutesIf(Changed changed) {
+  for (auto it = route_cache_.begin(); it != route_cache_.end();) {
+    if (changed(it->first, it->second)) {
+      fanout_cache_.erase(it->first);
+      it = route_cache_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void MeshTransport::updateRoutesForLink(uint32_t a, uint32_t b, bool added) {
+  domains_dirty_ = true;
+
+  // Hops from a node back to the root of its tree
+  auto depth = [](const ParentMap& tree, uint32_t node) {
+    size_t hops = 0;
+    for (auto it = tree.find(node); it->second != it->first; it = tree.find(it->second)) {
+      ++hops;
+    }
+    return hops;
+  };
+
+  dropRoutesIf([&](uint32_t, const ParentMap& tree) {
+    auto in_a = tree.find(a);
+    auto in_b = tree.find(b);
+    if (!added) {
+      // The search never crossed a link that is not a tree edge
+      return (in_a != tree.end() && in_a->second == b) ||
+             (in_b != tree.end() && in_b->second == a);
+    }
+    if (in_a == tree.end() && in_b == tree.end()) {
+      return false;
+    }
+    if (in_a == tree.end()) {
+      return isAttached(a);
+    }
+    if (in_b == tree.end()) {
+      return isAttached(b);
+    }
+    // Nodes at one depth all have their parents before either is
+    // searched from, so a link between them is never followed
+    return depth(tree, a) != depth(tree, b);
+  });
+}
+
+void MeshTransport::updateRoutesForNode(uint32_t node, bool attached) {
+  auto links_it = links_.find(node);
+  const std::set<uint32_t> none;
+  const std::set<uint32_t>& neighbours = links_it != links_.end() ? links_it->second : none;
+
+  dropRoutesIf([&](uint32_t root, ParentMap& tree) {
+    if (root == node) {
+      return true;
+    }
+    if (attached) {
+      // The node joins every tree one of its neighbours is in
+      return std::any_of(neighbours.begin(), neighbours.end(),
+                         [&](uint32_t neighbour) { return tree.count(neighbour) > 0; });
+    }
+
+    auto it = tree.find(node);
+    if (it == tree.end()) {
+      return false;
+    }
+    for (uint32_t neighbour : neighbours) {
+      auto child = tree.find(neighbour);
+      if (child != tree.end() && child->second == node) {
+        return true;
+      }
+    }
+
+    // A leaf relays to nobody: cut it out of the tree and its parent's
+    // relay list
+    const uint32_t parent = it->second;
+    tree.erase(it);
+    auto fanout = fanout_cache_.find(root);
+    if (fanout != fanout_cache_.end()) {
+      auto children = fanout->second.find(parent);
+      if (children != fanout->second.end()) {
+        std::vector<uint32_t>& relays = children->second;
+        relays.erase(std::remove(relays.begin(), relays.end(), node), relays.end());
+        if (relays.empty()) {
+          fanout->second.erase(children);
+        }
+      }
+    }
+    return false;
+  });
+}
+
+const MeshTransport::ChildMap& MeshTransport::getBroadcastChildren(uint32_t origin) const {
+  auto cached = fanout_cache_.find(origin);
+  if (cached != fanout_cache_.end()) {
+    return cached->second;
+  }
+
+  // Parent maps are ordered, so every child list comes out ascending
+  ChildMap& children = fanout_cache_[origin];
+  for (const auto& entry : getTree(origin)) {
+    if (entry.first != origin) {
+      children[entry.second].push_back(entry.first);
+    }
+  }
+  return children;
+}
+
+Payload MeshTransport::encodeFrame(FrameType type, uint32_t origin, uint32_t dest,
+                                   const std::string& payload) {
+  std::string frame;
+  frame.reserve(FRAME_HEADER_SIZE + payload.size());
+  frame.push_back(static_cast<char>(type));
+  appendU32(frame, origin);
+  appendU32(frame, dest);
+  frame.append(payload);
+  return Payload(std::move(frame));
+}
+
+size_t MeshTransport::forwardBroadcast(uint32_t node, uint32_t origin,
+                                       const Payload& frame, uint64_t now) {
+  // Relay only to children in the origin's shortest-path tree so every
+  // node receives the broadcast exactly once. All hops share one buffer,
+  // encoded once by the sender; relays only read its header.
+  const ChildMap& children = getBroadcastChildren(origin);
+  auto it = children.find(node);
+  if (it == children.end()) {
+    return 0;
+  }
+  network_.enqueueMulticast(node, it->second, frame, now);
+  return it->second.size();
+}
+
+void MeshTransport::handleFrame(const DelayedMessage& hop) {
+  if (hop.message.size() < FRAME_HEADER_SIZE) {
+    stats_.frames_dropped++;
+    return;
+  }
+
+  auto endpoint_it = endpoints_.find(hop.to);
+  if (endpoint_it == endpoints_.end() || endpoint_it->second->remote) {
+    // Receiver stopped while the frame was in flight, or lives in
+    // another process and nothing shipped the frame there
+    stats_.frames_dropped++;
+    return;
+  }
+
+  auto type = static_cast<FrameType>(hop.message[0]);
+  uint32_t origin = readU32(hop.message, 1);
+  uint32_t dest = readU32(hop.message, 1 + sizeof(uint32_t));
+
+  if (type == FrameType::SINGLE && dest != hop.to) {
+    // Relay towards the destination
+    const ParentMap& tree = getTree(dest);
+    auto it = tree.find(hop.to);
+    if (it == tree.end()) {
+      stats_.frames_dropped++;
+      return;
+    }
+    network_.enqueueMessage(hop.to, it->second, hop.message, current_time_);
+    stats_.frames_forwarded++;
+    return;
+  }
+
+  if (type == FrameType::BROADCAST) {
+    stats_.frames_forwarded += forwardBroadcast(hop.to, origin, hop.message, current_time_);
+  }
+
+  // Keep the endpoint alive even if the callback detaches it
+  std::shared_ptr<Endpoint> endpoint = endpoint_it->second;
+  stats_.frames_delivered++;
+  if (filter_ && filter_(hop.to, origin, hop.message.slice(FRAME_HEADER_SIZE))) {
+    return;
+  }
+  if (!taps_.empty()) {
+    auto tap = taps_.find(hop.to);
+    if (tap != taps_.end()) {
+      tap->second(origin, type == FrameType::BROADCAST, hop.message.slice(FRAME_HEADER_SIZE));
+    }
+  }
+  if (endpoint->onReceive) {
+    endpoint->onReceive(origin, hop.message.slice(FRAME_HEADER_SIZE));
+  }
+}
+
+void MeshTransport::saveState(CheckpointWriter& out) const {
+  out.beginSection(CHECKPOINT_TRANSPORT);
+  out.write<uint64_t>(current_time_);
+  out.write<uint64_t>(stats_.frames_sent);
+  out.write<uint64_t>(stats_.frames_forwarded);
+  out.write<uint64_t>(stats_.frames_delivered);
+  out.write<uint64_t>(stats_.frames_dropped);
+  out.write<uint64_t>(link_count_);
+  for (const auto& entry : links_) {
+    for (uint32_t peer : entry.second) {
+      if (entry.first < peer) {
+        out.write<uint32_t>(entry.first);
+        out.write<uint32_t>(peer);
+      }
+    }
+  }
+}
+
+void MeshTransport::loadState(CheckpointReader& in) {
+  in.expectSection(CHECKPOINT_TRANSPORT);
+  current_time_ = in.read<uint64_t>();
+  stats_.frames_sent = in.read<uint64_t>();
+  stats_.frames_forwarded = in.read<uint64_t>();
+  stats_.frames_delivered = in.read<uint64_t>();
+  stats_.frames_dropped = in.read<uint64_t>();
+
+  links_.clear();
+  link_count_ = 0;
+  const uint64_t count = in.read<uint64_t>();
+  for (uint64_t i = 0; i < count; ++i) {
+    const uint32_t a = in.read<uint32_t>();
+    const uint32_t b = in.read<uint32_t>();
+    if (a == 0 || b == 0 || a == b) {
+      throw std::runtime_error("Checkpoint has an invalid link");
+    }
+    if (links_[a].insert(b).second) {
+      links_[b].insert(a);
+      link_count_++;
+    }
+  }
+  invalidateRoutes();
+}
+
+} // namespace simulator
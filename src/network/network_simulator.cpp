@@ -8,27 +8,121 @@
 
 #include "simulator/platform_compat.hpp"
 #include "simulator/network_simulator.hpp"
+#include "simulator/alloc_tracker.hpp"
+#include "simulator/packet_capture.hpp"
+#include "simulator/topology_listener.hpp"
 
 #include <algorithm>
+#include <map>
 #include <stdexcept>
-#include <cmath>
+#include <utility>
 
 namespace simulator {
 
+namespace {
+
+// Link record flags in checkpoints
+constexpr uint8_t LINK_HAS_LATENCY = 1 << 0;
+constexpr uint8_t LINK_HAS_PACKET_LOSS = 1 << 1;
+constexpr uint8_t LINK_HAS_BANDWIDTH = 1 << 2;
+constexpr uint8_t LINK_BUCKET_INITIALIZED = 1 << 3;
+constexpr uint8_t LINK_HAS_STATS = 1 << 4;
+constexpr uint8_t LINK_DROPPED = 1 << 5;
+constexpr uint8_t LINK_IN_BURST = 1 << 6;
+
+// Reference of a queued message whose payload follows inline
+constexpr uint32_t NEW_PAYLOAD = UINT32_MAX;
+
+void writeLatency(CheckpointWriter& out, const LatencyConfig& config) {
+  out.write<uint32_t>(config.min_ms);
+  out.write<uint32_t>(config.max_ms);
+  out.write<uint8_t>(static_cast<uint8_t>(config.distribution));
+}
+
+LatencyConfig readLatency(CheckpointReader& in) {
+  LatencyConfig config;
+  config.min_ms = in.read<uint32_t>();
+  config.max_ms = in.read<uint32_t>();
+  config.distribution = static_cast<DistributionType>(in.read<uint8_t>());
+  return config;
+}
+
+void writePacketLoss(CheckpointWriter& out, const PacketLossConfig& config) {
+  out.write<float>(config.probability);
+  out.write<uint8_t>(config.burst_mode);
+  out.write<uint32_t>(config.burst_length);
+  out.write<uint8_t>(config.gilbert_elliott);
+  out.write<float>(config.good_to_bad);
+  out.write<float>(config.bad_to_good);
+  out.write<float>(config.loss_good);
+  out.write<float>(config.loss_bad);
+}
+
+PacketLossConfig readPacketLoss(CheckpointReader& in) {
+  PacketLossConfig config;
+  config.probability = in.read<float>();
+  config.burst_mode = in.read<uint8_t>() != 0;
+  config.burst_length = in.read<uint32_t>();
+  config.gilbert_elliott = in.read<uint8_t>() != 0;
+  config.good_to_bad = in.read<float>();
+  config.bad_to_good = in.read<float>();
+  config.loss_good = in.read<float>();
+  config.loss_bad = in.read<float>();
+  return config;
+}
+
+void writeBandwidth(CheckpointWriter& out, const BandwidthConfig& config) {
+  out.write<uint32_t>(config.max_bytes_per_sec);
+  out.write<uint32_t>(config.max_messages_per_sec);
+  out.write<uint32_t>(config.bucket_size);
+}
+
+BandwidthConfig readBandwidth(CheckpointReader& in) {
+  BandwidthConfig config;
+  config.max_bytes_per_sec = in.read<uint32_t>();
+  config.max_messages_per_sec = in.read<uint32_t>();
+  config.bucket_size = in.read<uint32_t>();
+  return config;
+}
+
+void writeAirtime(CheckpointWriter& out, const AirtimeConfig& config) {
+  out.write<uint32_t>(config.bitrate_bps);
+  out.write<uint32_t>(config.frame_overhead_us);
+  out.write<uint32_t>(config.slot_us);
+  out.write<uint32_t>(config.contention_window);
+  out.write<uint32_t>(config.max_wait_ms);
+}
+
+AirtimeConfig readAirtime(CheckpointReader& in) {
+  AirtimeConfig config;
+  config.bitrate_bps = in.read<uint32_t>();
+  config.frame_overhead_us = in.read<uint32_t>();
+  config.slot_us = in.read<uint32_t>();
+  config.contention_window = in.read<uint32_t>();
+  config.max_wait_ms = in.read<uint32_t>();
+  return config;
+}
+
+} // anonymous namespace
+
 NetworkSimulator::NetworkSimulator() 
-    : rng_(std::random_device{}()) {
+    : message_queue_(makeDeliveryQueue(QueueBackend::HEAP)),
+      seed_(std::random_device{}()) {
   // Set default latency
   default_latency_.min_ms = 10;
   default_latency_.max_ms = 50;
   default_latency_.distribution = DistributionType::NORMAL;
+  default_sampler_ = samplerFor(default_latency_);
 }
 
 NetworkSimulator::NetworkSimulator(uint32_t seed)
-    : rng_(seed) {
+    : message_queue_(makeDeliveryQueue(QueueBackend::HEAP)),
+      seed_(seed) {
   // Set default latency
   default_latency_.min_ms = 10;
   default_latency_.max_ms = 50;
   default_latency_.distribution = DistributionType::NORMAL;
+  default_sampler_ = samplerFor(default_latency_);
 }
 
 void NetworkSimulator::setDefaultLatency(const LatencyConfig& config) {
@@ -36,109 +130,577 @@ void NetworkSimulator::setDefaultLatency(const LatencyConfig& config) {
     throw std::invalid_argument("Invalid latency configuration: min > max");
   }
   default_latency_ = config;
+  default_sampler_ = samplerFor(config);
 }
 
 void NetworkSimulator::setLatency(uint32_t fromNode, uint32_t toNode, const LatencyConfig& config) {
   if (!config.isValid()) {
     throw std::invalid_argument("Invalid latency configuration: min > max");
   }
-  ConnectionKey key = std::make_pair(fromNode, toNode);
-  latency_map_[key] = config;
+  LinkState& link = getOrCreateLink(fromNode, toNode);
+  link.latency = config;
+  link.latency_sampler = samplerFor(config);
+  link.has_latency = true;
 }
 
 LatencyConfig NetworkSimulator::getLatency(uint32_t fromNode, uint32_t toNode) const {
-  ConnectionKey key = std::make_pair(fromNode, toNode);
-  auto it = latency_map_.find(key);
-  if (it != latency_map_.end()) {
-    return it->second;
+  const LinkState* link = findLink(fromNode, toNode);
+  return link ? latencyOf(*link) : default_latency_;
+}
+
+uint32_t NetworkSimulator::getMinLatency(uint32_t fromNode, uint32_t toNode) const {
+  const LinkState* link = findLink(fromNode, toNode);
+  if (link && link->trace) {
+    return link->trace_min_latency;
   }
-  return default_latency_;
+  return link ? latencyOf(*link).min_ms : default_latency_.min_ms;
 }
 
-void NetworkSimulator::enqueueMessage(uint32_t from, uint32_t to, 
-                                       const std::string& message, 
-                                       uint64_t currentTime) {
-  // Check if connection is dropped
-  if (!isConnectionActive(from, to)) {
+const NetworkSimulator::LinkState* NetworkSimulator::findLink(uint32_t from, uint32_t to) const {
+  uint32_t index = link_index_.find(from, to);
+  return index == LinkTable::NPOS ? nullptr : &links_[index];
+}
+
+uint32_t NetworkSimulator::getOrCreateLinkIndex(uint32_t from, uint32_t to) {
+  uint32_t index = link_index_.insert(from, to);
+  if (index == links_.size()) {
+    links_.emplace_back();
+    links_.back().latency_key = CounterRng::makeKey(seed_, from, to, RNG_STREAM_LATENCY);
+    links_.back().loss_key = CounterRng::makeKey(seed_, from, to, RNG_STREAM_LOSS);
+  }
+  return index;
+}
+
+NetworkSimulator::LinkState& NetworkSimulator::getOrCreateLink(uint32_t from, uint32_t to) {
+  return links_[getOrCreateLinkIndex(from, to)];
+}
+
+bool NetworkSimulator::admitMessage(uint32_t from, uint32_t to, LinkState& link,
+                                    const Payload& message, uint64_t currentTime,
+                                    uint32_t& medium_delay_ms) {
+  // Check if connection is dropped or crosses a partition
+  if (isDropped(link) || isPartitioned(from, to)) {
     // Record dropped packet (connection dropped)
-    recordPacketStats(from, to, true);
-    return;  // Drop the packet due to dropped connection
+    recordPacketStats(link, true);
+    if (capture_) {
+      capture_->capture(CaptureVerdict::DISCONNECTED, currentTime, from, to, message);
+    }
+    return false;  // Drop the packet due to dropped connection
   }
   
-  // Check if packet should be dropped
-  if (shouldDropPacket(from, to)) {
+  // Check if packet should be dropped; traced links use the recorded loss
+  if (link.trace ? shouldDropTraced(link, currentTime) : shouldDropPacket(link)) {
     // Record dropped packet
-    recordPacketStats(from, to, true);
-    return;  // Drop the packet
+    recordPacketStats(link, true);
+    if (capture_) {
+      capture_->capture(CaptureVerdict::DROPPED, currentTime, from, to, message);
+    }
+    return false;  // Drop the packet
   }
   
   // Check bandwidth limits
-  size_t messageSize = message.size();
-  if (!canSendMessage(from, to, messageSize, currentTime)) {
+  if (!canSendMessage(link, message.size(), currentTime)) {
     // Record bandwidth throttling
-    ConnectionKey key = std::make_pair(from, to);
-    ConnectionStats& stats = stats_map_[key];
-    stats.bandwidth_throttled++;
-    return;  // Drop the message due to bandwidth limits
+    link.has_stats = true;
+    link.stats.bandwidth_throttled++;
+    if (capture_) {
+      capture_->capture(CaptureVerdict::THROTTLED, currentTime, from, to, message);
+    }
+    return false;  // Drop the message due to bandwidth limits
   }
   
+  // Wait for the sender's shared medium; a medium saturated beyond the
+  // longest wait throttles the message like an exhausted bucket
+  const MediumAccess access = airtime_.transmit(from, message.size(), currentTime);
+  if (!access.sent) {
+    link.has_stats = true;
+    link.stats.bandwidth_throttled++;
+    if (capture_) {
+      capture_->capture(CaptureVerdict::THROTTLED, currentTime, from, to, message);
+    }
+    return false;
+  }
+  medium_delay_ms = access.delay_ms;
+  
   // Consume bandwidth tokens
-  consumeBandwidth(from, to, messageSize, currentTime);
+  consumeBandwidth(link, message.size());
   
   // Record delivered packet
-  recordPacketStats(from, to, false);
+  recordPacketStats(link, false);
+  return true;
+}
+
+void NetworkSimulator::enqueueMessage(uint32_t from, uint32_t to, 
+                                       Payload message, 
+                                       uint64_t currentTime) {
+  if (batch_depth_ > 0) {
+    addToBatch(from, to, std::move(message), currentTime);
+    return;
+  }
+  enqueueNow(from, to, std::move(message), currentTime);
+}
+
+bool NetworkSimulator::enqueueNow(uint32_t from, uint32_t to, Payload message,
+                                  uint64_t currentTime) {
+  SIM_ALLOC_SCOPE(AllocTag::NETWORK);
+  // Single lookup; everything below works on this link's record
+  const uint32_t link_index = getOrCreateLinkIndex(from, to);
+  LinkState& link = links_[link_index];
   
-  // Get latency configuration for this connection
-  LatencyConfig config = getLatency(from, to);
+  uint32_t medium_delay_ms = 0;
+  if (!admitMessage(from, to, link, message, currentTime, medium_delay_ms)) {
+    return false;
+  }
   
-  // Calculate latency
-  uint32_t latency_ms = calculateLatency(config);
+  // Calculate latency, after the frame left the air
+  uint32_t latency_ms = calculateLatency(link) + medium_delay_ms;
   
   // Record statistics
-  recordStats(from, to, latency_ms);
+  recordStats(link, latency_ms);
   
   // Create delayed message
   DelayedMessage delayed;
   delayed.from = from;
   delayed.to = to;
-  delayed.message = message;
+  delayed.message = std::move(message);
   delayed.deliveryTime = currentTime + latency_ms;
+  if (capture_) {
+    capture_->capture(CaptureVerdict::ENQUEUED, currentTime, from, to, delayed.message,
+                      delayed.deliveryTime);
+  }
   
-  // Add to queue
-  message_queue_.push(delayed);
+  // Add to queue, unless it leaves for another simulator
+  if (egress_ && egress_(delayed)) {
+    return true;
+  }
+  if (coalesce_ && coalesce(link_index, delayed)) {
+    return true;
+  }
+  message_queue_->push(std::move(delayed));
+  return true;
+}
+
+size_t NetworkSimulator::enqueueMulticast(uint32_t from, const uint32_t* to, size_t count,
+                                          const Payload& message, uint64_t currentTime) {
+  beginBatch();
+  for (size_t i = 0; i < count; ++i) {
+    addToBatch(from, to[i], message, currentTime);
+  }
+  return flushBatch();
+}
+
+void NetworkSimulator::addToBatch(uint32_t from, uint32_t to, Payload message,
+                                  uint64_t currentTime) {
+  batch_.from.push_back(from);
+  batch_.to.push_back(to);
+  batch_.time.push_back(currentTime);
+  batch_.message.push_back(std::move(message));
+}
+
+size_t NetworkSimulator::flushBatch() {
+  if (batch_depth_ == 0 || --batch_depth_ > 0) {
+    return 0;
+  }
+  SIM_ALLOC_SCOPE(AllocTag::NETWORK);
+  size_t queued = 0;
+  if (capture_) {
+    // One at a time, so the capture records keep the send order
+    for (size_t i = 0; i < batch_.from.size(); ++i) {
+      queued += enqueueNow(batch_.from[i], batch_.to[i], std::move(batch_.message[i]),
+                           batch_.time[i]) ? 1 : 0;
+    }
+  } else if (!batch_.from.empty()) {
+    queued = evaluateBatch();
+  }
+  batch_.from.clear();
+  batch_.to.clear();
+  batch_.time.clear();
+  batch_.message.clear();  // Drops payload references, keeps capacity
+  return queued;
+}
+
+namespace {
+
+/// Fate of a send while a batch is evaluated
+enum SendFate : uint8_t {
+  FATE_PENDING = 0,   ///< Not decided yet
+  FATE_LOST,          ///< Disconnected or lost; counted as dropped
+  FATE_THROTTLED,     ///< Out of bucket tokens or airtime
+  FATE_ADMITTED       ///< Will be queued
+};
+
+/// Replays one precomputed word, so a distribution maps it exactly as it
+/// would map the first word of a CounterRng
+struct FixedWord {
+  using result_type = uint32_t;
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return UINT32_MAX; }
+  result_type operator()() const { return word; }
+  uint32_t word;
+};
+
+} // anonymous namespace
+
+size_t NetworkSimulator::evaluateBatch() {
+  SendBatch& batch = batch_;
+  const size_t count = batch.from.size();
+  
+  // Resolve every link first; inserting a link may move the records, so
+  // the passes below work on indices
+  batch.links.resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    batch.links[i] = getOrCreateLinkIndex(batch.from[i], batch.to[i]);
+  }
+  
+  // Liveness and loss, in send order. Stateful models (traces, bursts,
+  // Gilbert-Elliott) step at once; plain Bernoulli links only claim their
+  // stream position, and all their words are drawn in one loop below.
+  batch.fate.assign(count, FATE_PENDING);
+  batch.latency.assign(count, 0);
+  batch.draws.clear();
+  batch.keys.clear();
+  batch.sequences.clear();
+  batch.threshold.clear();
+  for (size_t i = 0; i < count; ++i) {
+    LinkState& link = links_[batch.links[i]];
+    if (isDropped(link) || isPartitioned(batch.from[i], batch.to[i])) {
+      batch.fate[i] = FATE_LOST;
+      continue;
+    }
+    if (link.trace) {
+      // The latency belongs to the sample found for this send's time
+      if (shouldDropTraced(link, batch.time[i])) {
+        batch.fate[i] = FATE_LOST;
+      } else {
+        batch.latency[i] = link.trace.current().latency_ms;
+      }
+      continue;
+    }
+    const PacketLossConfig& config = packetLossOf(link);
+    if (config.gilbert_elliott || config.burst_mode || config.probability >= 1.0f) {
+      if (shouldDropPacket(link)) {
+        batch.fate[i] = FATE_LOST;
+      }
+      continue;
+    }
+    if (config.probability > 0.0f) {
+      batch.draws.push_back(static_cast<uint32_t>(i));
+      batch.keys.push_back(link.loss_key);
+      batch.sequences.push_back(link.loss_sequence++);
+      batch.threshold.push_back(config.probability);
+    }
+  }
+  size_t draws = batch.draws.size();
+  if (draws > 0) {
+    batch.random.resize(draws);
+    CounterRng::firstWords(batch.keys.data(), batch.sequences.data(), batch.random.data(),
+                           draws);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    for (size_t k = 0; k < draws; ++k) {
+      FixedWord word{static_cast<uint32_t>(batch.random[k])};
+      if (dist(word) < batch.threshold[k]) {
+        batch.fate[batch.draws[k]] = FATE_LOST;
+      }
+    }
+  }
+  
+  // Token buckets and airtime in send order, as both depend on what the
+  // link or the sender's medium admitted before; then the latency stream
+  // positions of the admitted sends
+  batch.medium_delay.assign(count, 0);
+  batch.draws.clear();
+  batch.keys.clear();
+  batch.sequences.clear();
+  const LatencySampler* shared_sampler = nullptr;
+  bool same_sampler = true;
+  size_t admitted = 0;
+  for (size_t i = 0; i < count; ++i) {
+    LinkState& link = links_[batch.links[i]];
+    if (batch.fate[i] == FATE_LOST) {
+      recordPacketStats(link, true);
+      continue;
+    }
+    const size_t size = batch.message[i].size();
+    if (!canSendMessage(link, size, batch.time[i])) {
+      batch.fate[i] = FATE_THROTTLED;
+      link.has_stats = true;
+      link.stats.bandwidth_throttled++;
+      continue;
+    }
+    const MediumAccess access = airtime_.transmit(batch.from[i], size, batch.time[i]);
+    if (!access.sent) {
+      batch.fate[i] = FATE_THROTTLED;
+      link.has_stats = true;
+      link.stats.bandwidth_throttled++;
+      continue;
+    }
+    batch.medium_delay[i] = access.delay_ms;
+    consumeBandwidth(link, size);
+    recordPacketStats(link, false);
+    batch.fate[i] = FATE_ADMITTED;
+    ++admitted;
+    
+    if (link.trace) {
+      continue;
+    }
+    const LatencySampler* sampler = link.has_latency ? link.latency_sampler : default_sampler_;
+    if (!sampler->isTabulated()) {
+      // Untabulated samplers need the generator itself
+      CounterRng rng(link.latency_key, link.latency_sequence++);
+      batch.latency[i] = sampler->sample(rng);
+      continue;
+    }
+    if (batch.draws.empty()) {
+      shared_sampler = sampler;
+    }
+    same_sampler = same_sampler && sampler == shared_sampler;
+    batch.draws.push_back(static_cast<uint32_t>(i));
+    batch.keys.push_back(link.latency_key);
+    batch.sequences.push_back(link.latency_sequence++);
+  }
+  if (admitted == 0) {
+    return 0;
+  }
+  
+  // Latency words in one loop, mapped in one batch when all links share
+  // the sampler
+  draws = batch.draws.size();
+  if (draws > 0) {
+    batch.random.resize(draws);
+    CounterRng::firstWords(batch.keys.data(), batch.sequences.data(), batch.random.data(),
+                           draws);
+    if (same_sampler) {
+      batch.sampled.resize(draws);
+      shared_sampler->sampleBatch(batch.random.data(), batch.sampled.data(), draws);
+      for (size_t k = 0; k < draws; ++k) {
+        batch.latency[batch.draws[k]] = batch.sampled[k];
+      }
+    } else {
+      for (size_t k = 0; k < draws; ++k) {
+        const LinkState& link = links_[batch.links[batch.draws[k]]];
+        const LatencySampler* sampler =
+            link.has_latency ? link.latency_sampler : default_sampler_;
+        batch.latency[batch.draws[k]] = sampler->sample(batch.random[k]);
+      }
+    }
+  }
+  
+  // Scatter the survivors into the queue at once
+  batch.deliveries.clear();
+  for (size_t i = 0; i < count; ++i) {
+    if (batch.fate[i] != FATE_ADMITTED) {
+      continue;
+    }
+    const uint32_t latency_ms = batch.latency[i] + batch.medium_delay[i];
+    recordStats(links_[batch.links[i]], latency_ms);
+    
+    DelayedMessage delayed;
+    delayed.from = batch.from[i];
+    delayed.to = batch.to[i];
+    delayed.message = std::move(batch.message[i]);
+    delayed.deliveryTime = batch.time[i] + latency_ms;
+    if (egress_ && egress_(delayed)) {
+      continue;
+    }
+    if (!coalesce_ || !coalesce(batch.links[i], delayed)) {
+      batch.deliveries.push_back(std::move(delayed));
+    }
+  }
+  message_queue_->pushBatch(batch.deliveries);
+  batch.deliveries.clear();
+  return admitted;
+}
+
+void NetworkSimulator::injectMessage(DelayedMessage message) {
+  message_queue_->push(std::move(message));
+}
+
+size_t NetworkSimulator::enqueueMulticast(uint32_t from, const std::vector<uint32_t>& to,
+                                          const Payload& message, uint64_t currentTime) {
+  return enqueueMulticast(from, to.data(), to.size(), message, currentTime);
 }
 
 std::vector<DelayedMessage> NetworkSimulator::getReadyMessages(uint64_t currentTime) {
+  SIM_ALLOC_SCOPE(AllocTag::NETWORK);
   std::vector<DelayedMessage> ready;
   
   // Extract all messages ready for delivery
-  while (!message_queue_.empty() && message_queue_.top().deliveryTime <= currentTime) {
-    ready.push_back(message_queue_.top());
-    message_queue_.pop();
-  }
+  message_queue_->drainReady(currentTime, ready);
+  expandCoalesced(ready, 0);
+  captureDelivered(ready.data(), ready.size(), currentTime);
   
   return ready;
 }
 
+size_t NetworkSimulator::getReadyMessages(uint64_t currentTime,
+                                          std::vector<DelayedMessage>& out) {
+  if (currentTime < message_queue_->nextDeliveryBound()) {
+    return 0;
+  }
+  const size_t drained = message_queue_->drainReady(currentTime, out);
+  const size_t count = drained + expandCoalesced(out, out.size() - drained);
+  captureDelivered(out.data() + (out.size() - count), count, currentTime);
+  return count;
+}
+
+size_t NetworkSimulator::drainReady(uint64_t currentTime, const DeliveryVisitor& visitor) {
+  SIM_ALLOC_SCOPE(AllocTag::NETWORK);
+  if (currentTime < message_queue_->nextDeliveryBound()) {
+    return 0;  // Nothing due
+  }
+  
+  // Take the buffer so a visitor calling back into drainReady() is safe
+  std::vector<DelayedMessage> batch;
+  batch.swap(ready_buffer_);
+  
+  size_t count = message_queue_->drainReady(currentTime, batch);
+  count += expandCoalesced(batch, 0);
+  captureDelivered(batch.data(), batch.size(), currentTime);
+  for (auto& message : batch) {
+    visitor(message);
+  }
+  
+  batch.clear();  // Keeps capacity for the next tick
+  ready_buffer_.swap(batch);
+  return count;
+}
+
+void NetworkSimulator::captureDelivered(const DelayedMessage* messages, size_t count,
+                                        uint64_t currentTime) {
+  if (!capture_) {
+    return;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    const DelayedMessage& message = messages[i];
+    capture_->capture(CaptureVerdict::DELIVERED, currentTime, message.from, message.to,
+                      message.message, message.deliveryTime);
+  }
+}
+
+bool NetworkSimulator::coalesce(uint32_t link_index, DelayedMessage& delayed) {
+  LinkState& link = links_[link_index];
+  if (link.coalesce_slot != 0) {
+    CoalescedBatch& open = coalesced_[link.coalesce_slot - 1];
+    if (open.time == delayed.deliveryTime) {
+      open.extras.push_back(std::move(delayed.message));
+      coalesced_pending_++;
+      coalesced_count_++;
+      return true;
+    }
+  }
+  
+  // Open a batch headed by this message; it replaces the link's open one,
+  // which stays queued and closes when drained
+  uint32_t slot;
+  if (free_slots_.empty()) {
+    slot = static_cast<uint32_t>(coalesced_.size());
+    coalesced_.emplace_back();
+  } else {
+    slot = free_slots_.back();
+    free_slots_.pop_back();
+  }
+  coalesced_[slot].link = link_index;
+  coalesced_[slot].time = delayed.deliveryTime;
+  link.coalesce_slot = slot + 1;
+  delayed.batch = slot + 1;
+  return false;
+}
+
+size_t NetworkSimulator::expandCoalesced(std::vector<DelayedMessage>& out, size_t first) {
+  if (coalesced_.size() == free_slots_.size()) {
+    return 0;  // No batch queued
+  }
+  bool has_heads = false;
+  size_t added = 0;
+  for (size_t i = first; i < out.size(); ++i) {
+    if (out[i].batch != 0) {
+      has_heads = true;
+      added += coalesced_[out[i].batch - 1].extras.size();
+    }
+  }
+  if (!has_heads) {
+    return 0;
+  }
+  
+  // Back to front, so every entry moves once and each head's extras land
+  // right after it
+  size_t write = out.size() + added;
+  out.resize(write);
+  for (size_t read = out.size() - added; read-- > first;) {
+    const uint32_t batch = out[read].batch;
+    if (batch != 0) {
+      std::vector<Payload>& extras = coalesced_[batch - 1].extras;
+      for (size_t k = extras.size(); k-- > 0;) {
+        DelayedMessage& message = out[--write];
+        message.from = out[read].from;
+        message.to = out[read].to;
+        message.deliveryTime = out[read].deliveryTime;
+        message.batch = 0;
+        message.message = std::move(extras[k]);
+      }
+      out[read].batch = 0;
+      releaseSlot(batch - 1);
+    }
+    if (--write != read) {
+      out[write] = std::move(out[read]);
+    }
+  }
+  return added;
+}
+
+void NetworkSimulator::releaseSlot(uint32_t slot) {
+  CoalescedBatch& batch = coalesced_[slot];
+  coalesced_pending_ -= batch.extras.size();
+  batch.extras.clear();  // Keeps capacity for the slot's next batch
+  if (links_[batch.link].coalesce_slot == slot + 1) {
+    links_[batch.link].coalesce_slot = 0;
+  }
+  free_slots_.push_back(slot);
+}
+
+void NetworkSimulator::resetCoalescing() {
+  for (const CoalescedBatch& batch : coalesced_) {
+    links_[batch.link].coalesce_slot = 0;
+  }
+  coalesced_.clear();
+  free_slots_.clear();
+  coalesced_pending_ = 0;
+}
+
 size_t NetworkSimulator::getPendingMessageCount() const {
-  return message_queue_.size();
+  return message_queue_->size() + coalesced_pending_;
+}
+
+uint64_t NetworkSimulator::getNextDeliveryTime() const {
+  return message_queue_->nextDeliveryBound();
+}
+
+void NetworkSimulator::setQueueBackend(QueueBackend backend) {
+  if (backend == message_queue_->backend()) {
+    return;
+  }
+  
+  // Move pending messages over in delivery order
+  std::vector<DelayedMessage> pending;
+  message_queue_->drainReady(UINT64_MAX, pending);
+  
+  message_queue_ = makeDeliveryQueue(backend);
+  for (auto& message : pending) {
+    message_queue_->push(std::move(message));
+  }
 }
 
 void NetworkSimulator::clear() {
-  // Clear the queue by creating a new empty one
-  std::priority_queue<DelayedMessage, 
-                      std::vector<DelayedMessage>,
-                      std::greater<DelayedMessage>> empty;
-  std::swap(message_queue_, empty);
+  message_queue_->clear();
+  resetCoalescing();
 }
 
 NetworkSimulator::LatencyStats NetworkSimulator::getStats(uint32_t fromNode, uint32_t toNode) const {
-  ConnectionKey key = std::make_pair(fromNode, toNode);
-  auto it = stats_map_.find(key);
+  const LinkState* link = findLink(fromNode, toNode);
   
   LatencyStats stats;
-  if (it != stats_map_.end()) {
-    const ConnectionStats& conn_stats = it->second;
+  if (link && link->has_stats) {
+    const ConnectionStats& conn_stats = link->stats;
     stats.min_latency_ms = conn_stats.min_latency_ms;
     stats.max_latency_ms = conn_stats.max_latency_ms;
     stats.message_count = conn_stats.message_count;
@@ -151,6 +713,13 @@ NetworkSimulator::LatencyStats NetworkSimulator::getStats(uint32_t fromNode, uin
       );
     }
     
+    if (conn_stats.histogram) {
+      stats.p50_latency_ms = conn_stats.histogram->getPercentile(50.0);
+      stats.p95_latency_ms = conn_stats.histogram->getPercentile(95.0);
+      stats.p99_latency_ms = conn_stats.histogram->getPercentile(99.0);
+      stats.p999_latency_ms = conn_stats.histogram->getPercentile(99.9);
+    }
+    
     uint64_t total_attempts = conn_stats.dropped_count + conn_stats.delivered_count;
     if (total_attempts > 0) {
       stats.drop_rate = static_cast<float>(conn_stats.dropped_count) / 
@@ -162,13 +731,12 @@ NetworkSimulator::LatencyStats NetworkSimulator::getStats(uint32_t fromNode, uin
     stats.bandwidth_throttled = conn_stats.bandwidth_throttled;
     
     // Calculate bandwidth utilization if bandwidth is configured
-    BandwidthConfig bw_config = getBandwidth(fromNode, toNode);
+    const BandwidthConfig& bw_config = bandwidthOf(*link);
     if (bw_config.max_bytes_per_sec > 0 && conn_stats.message_count > 0) {
       // Get time span from first to last message (approximate)
       // For now, use a simple metric: bytes_sent vs theoretical maximum
-      auto bucket_it = bandwidth_buckets_.find(key);
-      if (bucket_it != bandwidth_buckets_.end()) {
-        const TokenBucket& bucket = bucket_it->second;
+      if (link->bucket_initialized) {
+        const TokenBucket& bucket = link->bucket;
         if (bucket.last_refill_time > 0) {
           // Calculate utilization based on bytes consumed vs time
           uint64_t time_span_ms = bucket.last_refill_time;
@@ -187,99 +755,167 @@ NetworkSimulator::LatencyStats NetworkSimulator::getStats(uint32_t fromNode, uin
   return stats;
 }
 
-void NetworkSimulator::resetStats() {
-  stats_map_.clear();
+LatencyHistogram NetworkSimulator::getLatencyHistogram(uint32_t fromNode, uint32_t toNode) const {
+  const LinkState* link = findLink(fromNode, toNode);
+  if (link && link->stats.histogram) {
+    return *link->stats.histogram;
+  }
+  return LatencyHistogram();
 }
 
-uint32_t NetworkSimulator::calculateLatency(const LatencyConfig& config) {
-  switch (config.distribution) {
-    case DistributionType::UNIFORM:
-      return uniformDistribution(config.min_ms, config.max_ms);
-    
-    case DistributionType::NORMAL:
-      return normalDistribution(config.min_ms, config.max_ms);
-    
-    case DistributionType::EXPONENTIAL:
-      return exponentialDistribution(config.min_ms, config.max_ms);
-    
-    default:
-      return uniformDistribution(config.min_ms, config.max_ms);
+LatencyHistogram NetworkSimulator::getGlobalLatencyHistogram() const {
+  LatencyHistogram global;
+  for (const auto& link : links_) {
+    if (link.stats.histogram) {
+      global.merge(*link.stats.histogram);
+    }
   }
+  return global;
 }
 
-uint32_t NetworkSimulator::uniformDistribution(uint32_t min, uint32_t max) {
-  if (min == max) {
-    return min;
+size_t NetworkSimulator::forEachLinkStats(const LinkStatsVisitor& visitor) const {
+  size_t visited = 0;
+  LinkCounters counters;
+  for (size_t i = 0; i < links_.size(); ++i) {
+    const LinkState& link = links_[i];
+    if (!link.has_stats) {
+      continue;
+    }
+    const ConnectionStats& stats = link.stats;
+    const auto ends = link_index_.getLink(static_cast<uint32_t>(i));
+    counters.from = ends.first;
+    counters.to = ends.second;
+    counters.message_count = stats.message_count;
+    counters.delivered_count = stats.delivered_count;
+    counters.dropped_count = stats.dropped_count;
+    counters.bandwidth_throttled = stats.bandwidth_throttled;
+    counters.bytes_sent = stats.bytes_sent;
+    counters.total_latency_ms = stats.total_latency_ms;
+    visitor(counters, stats.histogram.get());
+    ++visited;
   }
-  std::uniform_int_distribution<uint32_t> dist(min, max);
-  return dist(rng_);
+  return visited;
+}
+
+void NetworkSimulator::LinkStatsColumns::resize(size_t rows) {
+  from.resize(rows, 0);
+  to.resize(rows, 0);
+  message_count.resize(rows, 0);
+  delivered_count.resize(rows, 0);
+  dropped_count.resize(rows, 0);
+  bandwidth_throttled.resize(rows, 0);
+  bytes_sent.resize(rows, 0);
+  total_latency_ms.resize(rows, 0);
 }
 
-uint32_t NetworkSimulator::normalDistribution(uint32_t min, uint32_t max) {
-  if (min == max) {
-    return min;
+size_t NetworkSimulator::snapshotStats(LinkStatsColumns& out, LinkStatsColumns* delta) const {
+  const size_t rows = links_.size();
+  const size_t known = out.size();
+  // Counters from before a reset are no base for a change
+  const bool same_epoch = out.stats_epoch == stats_epoch_;
+  out.resize(rows);
+  out.stats_epoch = stats_epoch_;
+  for (size_t i = known; i < rows; ++i) {
+    const auto ends = link_index_.getLink(static_cast<uint32_t>(i));
+    out.from[i] = ends.first;
+    out.to[i] = ends.second;
+  }
+  if (delta) {
+    const size_t delta_known = std::min(delta->size(), rows);
+    delta->resize(rows);
+    delta->stats_epoch = stats_epoch_;
+    std::copy(out.from.begin() + delta_known, out.from.end(), delta->from.begin() + delta_known);
+    std::copy(out.to.begin() + delta_known, out.to.end(), delta->to.begin() + delta_known);
   }
   
-  // Use mean and standard deviation
-  double mean = (min + max) / 2.0;
-  double stddev = (max - min) / 6.0;  // 99.7% of values within [min, max]
-  
-  std::normal_distribution<double> dist(mean, stddev);
-  double value = dist(rng_);
-  
-  // Clamp to [min, max] and round
-  value = std::max(static_cast<double>(min), value);
-  value = std::min(static_cast<double>(max), value);
-  
-  uint32_t result = static_cast<uint32_t>(std::round(value));
-  
-  // Ensure we stay within bounds after rounding
-  result = std::max(min, result);
-  result = std::min(max, result);
-  
-  return result;
+  size_t with_stats = 0;
+  for (size_t i = 0; i < rows; ++i) {
+    const ConnectionStats& stats = links_[i].stats;
+    with_stats += links_[i].has_stats ? 1 : 0;
+    if (delta) {
+      // Rows the previous snapshot did not have start from zero
+      const bool base = same_epoch && i < known;
+      delta->message_count[i] = stats.message_count - (base ? out.message_count[i] : 0);
+      delta->delivered_count[i] = stats.delivered_count - (base ? out.delivered_count[i] : 0);
+      delta->dropped_count[i] = stats.dropped_count - (base ? out.dropped_count[i] : 0);
+      delta->bandwidth_throttled[i] =
+        stats.bandwidth_throttled - (base ? out.bandwidth_throttled[i] : 0);
+      delta->bytes_sent[i] = stats.bytes_sent - (base ? out.bytes_sent[i] : 0);
+      delta->total_latency_ms[i] = stats.total_latency_ms - (base ? out.total_latency_ms[i] : 0);
+    }
+    out.message_count[i] = stats.message_count;
+    out.delivered_count[i] = stats.delivered_count;
+    out.dropped_count[i] = stats.dropped_count;
+    out.bandwidth_throttled[i] = stats.bandwidth_throttled;
+    out.bytes_sent[i] = stats.bytes_sent;
+    out.total_latency_ms[i] = stats.total_latency_ms;
+  }
+  return with_stats;
 }
 
-uint32_t NetworkSimulator::exponentialDistribution(uint32_t min, uint32_t max) {
-  if (min == max) {
-    return min;
+void NetworkSimulator::resetStats() {
+  for (auto& link : links_) {
+    link.stats = ConnectionStats();
+    link.has_stats = false;
   }
-  
-  // Use lambda parameter to shape the distribution
-  // lambda = 1 / (mean - min)
-  // We want the mean to be around 1/3 between min and max
-  double range = max - min;
-  double lambda = 3.0 / range;
-  
-  std::exponential_distribution<double> dist(lambda);
-  double value = dist(rng_) + min;
-  
-  // Clamp to [min, max] and round
-  value = std::max(static_cast<double>(min), value);
-  value = std::min(static_cast<double>(max), value);
-  
-  uint32_t result = static_cast<uint32_t>(std::round(value));
-  
-  // Ensure we stay within bounds after rounding
-  result = std::max(min, result);
-  result = std::min(max, result);
-  
-  return result;
+  ++stats_epoch_;
+}
+
+uint32_t NetworkSimulator::calculateLatency(LinkState& link) {
+  if (link.trace) {
+    return link.trace.current().latency_ms;
+  }
+  const LatencySampler* sampler = link.has_latency ? link.latency_sampler : default_sampler_;
+  CounterRng rng(link.latency_key, link.latency_sequence++);
+  return sampler->sample(rng);
+}
+
+const LatencySampler* NetworkSimulator::samplerFor(const LatencyConfig& config) {
+  // Scenarios use a handful of distinct configurations; a scan is enough
+  for (const auto& sampler : samplers_) {
+    if (sampler->getConfig() == config) {
+      return sampler.get();
+    }
+  }
+  samplers_.emplace_back(new LatencySampler(config));
+  return samplers_.back().get();
+}
+
+const GilbertElliott* NetworkSimulator::chainFor(const PacketLossConfig& config) {
+  if (!config.gilbert_elliott) {
+    return nullptr;
+  }
+  for (size_t i = 0; i < chains_.size(); ++i) {
+    const PacketLossConfig& known = chain_configs_[i];
+    if (known.good_to_bad == config.good_to_bad && known.bad_to_good == config.bad_to_good &&
+        known.loss_good == config.loss_good && known.loss_bad == config.loss_bad) {
+      return chains_[i].get();
+    }
+  }
+  chains_.emplace_back(new GilbertElliott(config.good_to_bad, config.bad_to_good,
+                                          config.loss_good, config.loss_bad));
+  chain_configs_.push_back(config);
+  return chains_.back().get();
 }
 
-void NetworkSimulator::recordStats(uint32_t from, uint32_t to, uint32_t latency_ms) {
-  ConnectionKey key = std::make_pair(from, to);
-  ConnectionStats& stats = stats_map_[key];
+void NetworkSimulator::recordStats(LinkState& link, uint32_t latency_ms) {
+  ConnectionStats& stats = link.stats;
+  link.has_stats = true;
   
   stats.total_latency_ms += latency_ms;
   stats.message_count++;
   stats.min_latency_ms = std::min(stats.min_latency_ms, latency_ms);
   stats.max_latency_ms = std::max(stats.max_latency_ms, latency_ms);
+  
+  if (!stats.histogram) {
+    stats.histogram.reset(new LatencyHistogram());
+  }
+  stats.histogram->record(latency_ms);
 }
 
-void NetworkSimulator::recordPacketStats(uint32_t from, uint32_t to, bool dropped) {
-  ConnectionKey key = std::make_pair(from, to);
-  ConnectionStats& stats = stats_map_[key];
+void NetworkSimulator::recordPacketStats(LinkState& link, bool dropped) {
+  ConnectionStats& stats = link.stats;
+  link.has_stats = true;
   
   if (dropped) {
     stats.dropped_count++;
@@ -321,28 +957,39 @@ void NetworkSimulator::setDefaultPacketLoss(const PacketLossConfig& config) {
     throw std::invalid_argument("Invalid packet loss configuration");
   }
   default_packet_loss_ = config;
+  default_chain_ = chainFor(config);
 }
 
 void NetworkSimulator::setPacketLoss(uint32_t fromNode, uint32_t toNode, const PacketLossConfig& config) {
   if (!config.isValid()) {
     throw std::invalid_argument("Invalid packet loss configuration");
   }
-  ConnectionKey key = std::make_pair(fromNode, toNode);
-  packet_loss_map_[key] = config;
+  LinkState& link = getOrCreateLink(fromNode, toNode);
+  link.packet_loss = config;
+  link.loss_chain = chainFor(config);
+  link.has_packet_loss = true;
 }
 
 PacketLossConfig NetworkSimulator::getPacketLoss(uint32_t fromNode, uint32_t toNode) const {
-  ConnectionKey key = std::make_pair(fromNode, toNode);
-  auto it = packet_loss_map_.find(key);
-  if (it != packet_loss_map_.end()) {
-    return it->second;
-  }
-  return default_packet_loss_;
+  const LinkState* link = findLink(fromNode, toNode);
+  return link ? packetLossOf(*link) : default_packet_loss_;
 }
 
 bool NetworkSimulator::shouldDropPacket(uint32_t from, uint32_t to) {
+  return shouldDropPacket(getOrCreateLink(from, to));
+}
+
+bool NetworkSimulator::shouldDropPacket(LinkState& link) {
   // Get packet loss configuration for this connection
-  PacketLossConfig config = getPacketLoss(from, to);
+  const PacketLossConfig& config = packetLossOf(link);
+  
+  if (config.gilbert_elliott) {
+    // One transition and one loss decision from a single 64-bit draw
+    const GilbertElliott* chain = link.has_packet_loss ? link.loss_chain : default_chain_;
+    CounterRng rng(link.loss_key, link.loss_sequence++);
+    uint64_t low = rng();
+    return chain->step(link.loss_state, low | (static_cast<uint64_t>(rng()) << 32));
+  }
   
   // If no packet loss configured, don't drop
   if (config.probability <= 0.0f) {
@@ -354,11 +1001,11 @@ bool NetworkSimulator::shouldDropPacket(uint32_t from, uint32_t to) {
     return true;
   }
   
-  ConnectionKey key = std::make_pair(from, to);
+  CounterRng rng(link.loss_key, link.loss_sequence++);
   
   if (config.burst_mode) {
     // Burst mode: drop packets in bursts
-    BurstState& burst = burst_state_map_[key];
+    BurstState& burst = link.burst;
     
     if (burst.in_burst) {
       // Continue current burst
@@ -370,7 +1017,7 @@ bool NetworkSimulator::shouldDropPacket(uint32_t from, uint32_t to) {
     } else {
       // Decide whether to start a new burst
       std::uniform_real_distribution<float> dist(0.0f, 1.0f);
-      float random_value = dist(rng_);
+      float random_value = dist(rng);
       
       if (random_value < config.probability) {
         // Start a new burst
@@ -383,11 +1030,47 @@ bool NetworkSimulator::shouldDropPacket(uint32_t from, uint32_t to) {
   } else {
     // Random mode: drop packets independently
     std::uniform_real_distribution<float> dist(0.0f, 1.0f);
-    float random_value = dist(rng_);
+    float random_value = dist(rng);
     return random_value < config.probability;
   }
 }
 
+bool NetworkSimulator::shouldDropTraced(LinkState& link, uint64_t currentTime) {
+  const float loss = link.trace.seek(currentTime).loss;
+  if (loss <= 0.0f) {
+    return false;
+  }
+  if (loss >= 1.0f) {
+    return true;
+  }
+  
+  CounterRng rng(link.loss_key, link.loss_sequence++);
+  std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+  return dist(rng) < loss;
+}
+
+void NetworkSimulator::setLinkTrace(std::shared_ptr<const LinkTrace> trace) {
+  for (auto& link : links_) {
+    link.trace = TraceCursor();
+  }
+  trace_ = std::move(trace);
+  if (!trace_) {
+    return;
+  }
+  for (size_t i = 0; i < trace_->getLinkCount(); ++i) {
+    const LinkTrace::Link& entry = trace_->getLink(i);
+    LinkState& link = getOrCreateLink(entry.from, entry.to);
+    link.trace = trace_->cursor(i);
+    // Once per series, so lookahead bounds need not scan the trace
+    link.trace_min_latency = trace_->getMinLatency(i);
+  }
+}
+
+bool NetworkSimulator::isTraced(uint32_t fromNode, uint32_t toNode) const {
+  const LinkState* link = findLink(fromNode, toNode);
+  return link != nullptr && static_cast<bool>(link->trace);
+}
+
 void NetworkSimulator::setDefaultBandwidth(const BandwidthConfig& config) {
   if (!config.isValid()) {
     throw std::invalid_argument("Invalid bandwidth configuration");
@@ -399,24 +1082,33 @@ void NetworkSimulator::setBandwidth(uint32_t fromNode, uint32_t toNode, const Ba
   if (!config.isValid()) {
     throw std::invalid_argument("Invalid bandwidth configuration");
   }
-  ConnectionKey key = std::make_pair(fromNode, toNode);
-  bandwidth_map_[key] = config;
+  LinkState& link = getOrCreateLink(fromNode, toNode);
+  link.bandwidth = config;
+  link.has_bandwidth = true;
   
   // Note: Token bucket is initialized lazily in refillTokenBucket on first use
 }
 
+void NetworkSimulator::setAirtime(const AirtimeConfig& config) {
+  airtime_.configure(config, seed_);
+}
+
+void NetworkSimulator::setNeighbours(const std::map<uint32_t, std::set<uint32_t>>& neighbours) {
+  airtime_.setNeighbours(neighbours);
+}
+
 BandwidthConfig NetworkSimulator::getBandwidth(uint32_t fromNode, uint32_t toNode) const {
-  ConnectionKey key = std::make_pair(fromNode, toNode);
-  auto it = bandwidth_map_.find(key);
-  if (it != bandwidth_map_.end()) {
-    return it->second;
-  }
-  return default_bandwidth_;
+  const LinkState* link = findLink(fromNode, toNode);
+  return link ? bandwidthOf(*link) : default_bandwidth_;
 }
 
 bool NetworkSimulator::canSendMessage(uint32_t from, uint32_t to, size_t messageSize, uint64_t currentTime) {
+  return canSendMessage(getOrCreateLink(from, to), messageSize, currentTime);
+}
+
+bool NetworkSimulator::canSendMessage(LinkState& link, size_t messageSize, uint64_t currentTime) {
   // Get bandwidth configuration for this connection
-  BandwidthConfig config = getBandwidth(from, to);
+  const BandwidthConfig& config = bandwidthOf(link);
   
   // If no bandwidth limits configured, allow message
   if (config.max_bytes_per_sec == 0 && config.max_messages_per_sec == 0) {
@@ -424,122 +1116,408 @@ bool NetworkSimulator::canSendMessage(uint32_t from, uint32_t to, size_t message
   }
   
   // Refill token bucket
-  refillTokenBucket(from, to, currentTime);
+  refillTokenBucket(link, currentTime);
   
-  ConnectionKey key = std::make_pair(from, to);
-  TokenBucket& bucket = bandwidth_buckets_[key];
+  const TokenBucket& bucket = link.bucket;
   
   // Check if we have enough tokens
   bool has_byte_tokens = (config.max_bytes_per_sec == 0) || 
-                         (bucket.bytes_tokens >= messageSize);
+                         (bucket.bytes_milli >= static_cast<uint64_t>(messageSize) * 1000);
   bool has_message_tokens = (config.max_messages_per_sec == 0) || 
-                            (bucket.messages_tokens >= 1);
+                            (bucket.messages_milli >= 1000);
   
   return has_byte_tokens && has_message_tokens;
 }
 
 void NetworkSimulator::consumeBandwidth(uint32_t from, uint32_t to, size_t messageSize, uint64_t currentTime) {
-  BandwidthConfig config = getBandwidth(from, to);
+  (void)currentTime;
+  consumeBandwidth(getOrCreateLink(from, to), messageSize);
+}
+
+void NetworkSimulator::consumeBandwidth(LinkState& link, size_t messageSize) {
+  const BandwidthConfig& config = bandwidthOf(link);
   
   // If no bandwidth limits, nothing to consume
   if (config.max_bytes_per_sec == 0 && config.max_messages_per_sec == 0) {
     return;
   }
   
-  ConnectionKey key = std::make_pair(from, to);
-  TokenBucket& bucket = bandwidth_buckets_[key];
+  TokenBucket& bucket = link.bucket;
+  link.bucket_initialized = true;
   
   // Consume tokens
   if (config.max_bytes_per_sec > 0) {
-    bucket.bytes_tokens = (bucket.bytes_tokens >= messageSize) ? 
-                          (bucket.bytes_tokens - messageSize) : 0;
+    const uint64_t cost = static_cast<uint64_t>(messageSize) * 1000;
+    bucket.bytes_milli = bucket.bytes_milli >= cost ? bucket.bytes_milli - cost : 0;
     bucket.bytes_consumed += messageSize;
   }
   
   if (config.max_messages_per_sec > 0) {
-    bucket.messages_tokens = (bucket.messages_tokens >= 1) ? 
-                             (bucket.messages_tokens - 1) : 0;
+    bucket.messages_milli = bucket.messages_milli >= 1000 ? bucket.messages_milli - 1000 : 0;
     bucket.messages_consumed++;
   }
   
   // Update statistics
-  ConnectionStats& stats = stats_map_[key];
-  stats.bytes_sent += messageSize;
+  link.has_stats = true;
+  link.stats.bytes_sent += messageSize;
 }
 
-void NetworkSimulator::refillTokenBucket(uint32_t from, uint32_t to, uint64_t currentTime) {
-  BandwidthConfig config = getBandwidth(from, to);
+void NetworkSimulator::refillTokenBucket(LinkState& link, uint64_t currentTime) {
+  const BandwidthConfig& config = bandwidthOf(link);
   
   // If no bandwidth limits, nothing to refill
   if (config.max_bytes_per_sec == 0 && config.max_messages_per_sec == 0) {
     return;
   }
   
-  ConnectionKey key = std::make_pair(from, to);
-  
-  // Check if bucket exists first
-  auto it = bandwidth_buckets_.find(key);
-  bool is_first_time = (it == bandwidth_buckets_.end());
-  
-  TokenBucket& bucket = bandwidth_buckets_[key];
+  TokenBucket& bucket = link.bucket;
+  const uint64_t capacity = static_cast<uint64_t>(config.bucket_size) * 1000;
   
   // Initialize if first time
-  if (is_first_time) {
+  if (!link.bucket_initialized) {
+    link.bucket_initialized = true;
     bucket.last_refill_time = currentTime;
-    bucket.bytes_tokens = config.bucket_size;
-    bucket.messages_tokens = config.bucket_size;
+    bucket.bytes_milli = capacity;
+    bucket.messages_milli = capacity;
     bucket.bytes_consumed = 0;
     bucket.messages_consumed = 0;
     return;
   }
   
-  // Calculate time elapsed in milliseconds
-  uint64_t elapsed_ms = currentTime - bucket.last_refill_time;
-  
-  if (elapsed_ms == 0) {
+  // Sends replayed after a lookahead window may carry earlier times than
+  // relays already admitted in that window; never refill backwards
+  if (currentTime <= bucket.last_refill_time) {
     return; // No time has passed
   }
   
-  // Refill byte tokens
+  // A rate per second times milliseconds is exactly the thousandths of a
+  // token earned, so no fraction is lost to rounding
+  const uint64_t elapsed_ms = currentTime - bucket.last_refill_time;
   if (config.max_bytes_per_sec > 0) {
-    // Calculate tokens to add: (bytes_per_sec * elapsed_ms) / 1000
-    uint64_t bytes_to_add = (static_cast<uint64_t>(config.max_bytes_per_sec) * elapsed_ms) / 1000;
-    bucket.bytes_tokens = std::min(
-      static_cast<uint64_t>(bucket.bytes_tokens + bytes_to_add),
-      static_cast<uint64_t>(config.bucket_size)
-    );
+    bucket.bytes_milli = std::min(
+      bucket.bytes_milli + static_cast<uint64_t>(config.max_bytes_per_sec) * elapsed_ms, capacity);
   }
-  
-  // Refill message tokens
   if (config.max_messages_per_sec > 0) {
-    // Calculate tokens to add: (messages_per_sec * elapsed_ms) / 1000
-    uint64_t messages_to_add = (static_cast<uint64_t>(config.max_messages_per_sec) * elapsed_ms) / 1000;
-    bucket.messages_tokens = std::min(
-      static_cast<uint64_t>(bucket.messages_tokens + messages_to_add),
-      static_cast<uint64_t>(config.bucket_size)
-    );
+    bucket.messages_milli = std::min(
+      bucket.messages_milli + static_cast<uint64_t>(config.max_messages_per_sec) * elapsed_ms,
+      capacity);
   }
   
   bucket.last_refill_time = currentTime;
 }
 
 void NetworkSimulator::dropConnection(uint32_t from, uint32_t to) {
-  ConnectionKey key = std::make_pair(from, to);
-  dropped_connections_.insert(key);
+  LinkState& link = getOrCreateLink(from, to);
+  if (!isDropped(link)) {
+    setDropped(link, true);
+    dropped_link_count_++;
+    if (listener_) {
+      listener_->connectionChanged(from, to, false);
+    }
+  }
 }
 
 void NetworkSimulator::restoreConnection(uint32_t from, uint32_t to) {
-  ConnectionKey key = std::make_pair(from, to);
-  dropped_connections_.erase(key);
+  uint32_t index = link_index_.find(from, to);
+  if (index != LinkTable::NPOS && isDropped(links_[index])) {
+    setDropped(links_[index], false);
+    dropped_link_count_--;
+    if (listener_) {
+      listener_->connectionChanged(from, to, true);
+    }
+  }
 }
 
 void NetworkSimulator::restoreAllConnections() {
-  dropped_connections_.clear();
+  if (dropped_link_count_ == 0) {
+    return;
+  }
+  std::vector<std::pair<uint32_t, uint32_t>> restored;
+  if (listener_) {
+    restored = getDroppedConnections();
+  }
+  // A new epoch leaves every drop mark stale; only when the counter wraps
+  // are the marks cleared, so no stale one can match again
+  if (++drop_epoch_ == 0) {
+    for (auto& link : links_) {
+      link.drop_epoch = 0;
+    }
+    drop_epoch_ = 1;
+  }
+  dropped_link_count_ = 0;
+  for (const auto& ends : restored) {
+    listener_->connectionChanged(ends.first, ends.second, true);
+  }
+}
+
+std::vector<std::pair<uint32_t, uint32_t>> NetworkSimulator::getDroppedConnections() const {
+  std::vector<std::pair<uint32_t, uint32_t>> dropped;
+  if (dropped_link_count_ == 0) {
+    return dropped;
+  }
+  dropped.reserve(dropped_link_count_);
+  for (size_t i = 0; i < links_.size(); ++i) {
+    if (isDropped(links_[i])) {
+      dropped.push_back(link_index_.getLink(static_cast<uint32_t>(i)));
+    }
+  }
+  return dropped;
 }
 
 bool NetworkSimulator::isConnectionActive(uint32_t from, uint32_t to) const {
-  ConnectionKey key = std::make_pair(from, to);
-  return dropped_connections_.find(key) == dropped_connections_.end();
+  if (isPartitioned(from, to)) {
+    return false;
+  }
+  if (dropped_link_count_ == 0) {
+    return true;
+  }
+  const LinkState* link = findLink(from, to);
+  return link == nullptr || !isDropped(*link);
+}
+
+void NetworkSimulator::setPartition(uint32_t nodeId, uint32_t partition) {
+  const bool changed = getPartition(nodeId) != partition;
+  if (partition == 0) {
+    partitions_.erase(nodeId);
+  } else {
+    partitions_[nodeId] = partition;
+  }
+  if (listener_ && changed) {
+    listener_->partitionChanged(nodeId, partition);
+  }
+}
+
+uint32_t NetworkSimulator::getPartition(uint32_t nodeId) const {
+  auto it = partitions_.find(nodeId);
+  return it == partitions_.end() ? 0 : it->second;
+}
+
+std::vector<std::pair<uint32_t, uint32_t>> NetworkSimulator::getPartitions() const {
+  std::vector<std::pair<uint32_t, uint32_t>> partitions(partitions_.begin(), partitions_.end());
+  std::sort(partitions.begin(), partitions.end());
+  return partitions;
+}
+
+void NetworkSimulator::clearPartitions() {
+  if (partitions_.empty()) {
+    return;
+  }
+  partitions_.clear();
+  if (listener_) {
+    listener_->partitionsCleared();
+  }
+}
+
+bool NetworkSimulator::isPartitioned(uint32_t from, uint32_t to) const {
+  if (partitions_.empty()) {
+    return false;
+  }
+  const uint32_t from_partition = getPartition(from);
+  const uint32_t to_partition = getPartition(to);
+  return from_partition != 0 && to_partition != 0 && from_partition != to_partition;
+}
+
+void NetworkSimulator::saveState(CheckpointWriter& out) const {
+  out.beginSection(CHECKPOINT_NETWORK);
+  writeLatency(out, default_latency_);
+  writePacketLoss(out, default_packet_loss_);
+  writeBandwidth(out, default_bandwidth_);
+  writeAirtime(out, airtime_.getConfig());
+  airtime_.saveState(out);
+  
+  // Links in index order, so a restore assigns the same indices
+  const auto ends = link_index_.getLinks();
+  out.write<uint32_t>(static_cast<uint32_t>(links_.size()));
+  for (size_t i = 0; i < links_.size(); ++i) {
+    const LinkState& link = links_[i];
+    out.write<uint32_t>(ends[i].first);
+    out.write<uint32_t>(ends[i].second);
+    const uint8_t flags = (link.has_latency ? LINK_HAS_LATENCY : 0) |
+                          (link.has_packet_loss ? LINK_HAS_PACKET_LOSS : 0) |
+                          (link.has_bandwidth ? LINK_HAS_BANDWIDTH : 0) |
+                          (link.bucket_initialized ? LINK_BUCKET_INITIALIZED : 0) |
+                          (link.has_stats ? LINK_HAS_STATS : 0) |
+                          (isDropped(link) ? LINK_DROPPED : 0) |
+                          (link.burst.in_burst ? LINK_IN_BURST : 0);
+    out.write<uint8_t>(flags);
+    out.write<uint8_t>(link.loss_state);
+    out.write<uint32_t>(link.burst.remaining);
+    out.write<uint64_t>(link.latency_sequence);
+    out.write<uint64_t>(link.loss_sequence);
+    if (link.has_latency) {
+      writeLatency(out, link.latency);
+    }
+    if (link.has_packet_loss) {
+      writePacketLoss(out, link.packet_loss);
+    }
+    if (link.has_bandwidth) {
+      writeBandwidth(out, link.bandwidth);
+    }
+    if (link.bucket_initialized) {
+      out.write<uint64_t>(link.bucket.bytes_milli);
+      out.write<uint64_t>(link.bucket.messages_milli);
+      out.write<uint64_t>(link.bucket.last_refill_time);
+      out.write<uint64_t>(link.bucket.bytes_consumed);
+      out.write<uint64_t>(link.bucket.messages_consumed);
+    }
+    if (link.has_stats) {
+      const ConnectionStats& stats = link.stats;
+      out.write<uint64_t>(stats.total_latency_ms);
+      out.write<uint32_t>(stats.min_latency_ms);
+      out.write<uint32_t>(stats.max_latency_ms);
+      out.write<uint64_t>(stats.message_count);
+      out.write<uint64_t>(stats.dropped_count);
+      out.write<uint64_t>(stats.delivered_count);
+      out.write<uint64_t>(stats.bytes_sent);
+      out.write<uint64_t>(stats.bandwidth_throttled);
+      out.write<uint8_t>(stats.histogram != nullptr);
+      if (stats.histogram) {
+        stats.histogram->saveState(out);
+      }
+    }
+  }
+  
+  // Sorted so equal states give equal checkpoints
+  std::map<uint32_t, uint32_t> partitions(partitions_.begin(), partitions_.end());
+  out.write<uint32_t>(static_cast<uint32_t>(partitions.size()));
+  for (const auto& entry : partitions) {
+    out.write<uint32_t>(entry.first);
+    out.write<uint32_t>(entry.second);
+  }
+  
+  const std::vector<DelayedMessage> queued = message_queue_->snapshot();
+  std::map<std::pair<const char*, size_t>, uint32_t> payloads;
+  out.write<uint64_t>(message_queue_->getDrainTime());
+  out.write<uint64_t>(queued.size() + coalesced_pending_);
+  auto writeMessage = [&out, &payloads](const DelayedMessage& message, const Payload& payload) {
+    out.write<uint32_t>(message.from);
+    out.write<uint32_t>(message.to);
+    out.write<uint64_t>(message.deliveryTime);
+    auto seen = payloads.emplace(std::make_pair(payload.data(), payload.size()),
+                                 static_cast<uint32_t>(payloads.size()));
+    if (seen.second) {
+      out.write<uint32_t>(NEW_PAYLOAD);
+      out.write<uint32_t>(static_cast<uint32_t>(payload.size()));
+      out.writeBytes(payload.data(), payload.size());
+    } else {
+      out.write<uint32_t>(seen.first->second);
+    }
+  };
+  // Batches are written as their messages; a restore queues them singly
+  for (const DelayedMessage& message : queued) {
+    writeMessage(message, message.message);
+    if (message.batch != 0) {
+      for (const Payload& extra : coalesced_[message.batch - 1].extras) {
+        writeMessage(message, extra);
+      }
+    }
+  }
+}
+
+void NetworkSimulator::loadState(CheckpointReader& in) {
+  in.expectSection(CHECKPOINT_NETWORK);
+  setDefaultLatency(readLatency(in));
+  setDefaultPacketLoss(readPacketLoss(in));
+  setDefaultBandwidth(readBandwidth(in));
+  setAirtime(readAirtime(in));
+  airtime_.loadState(in);
+  
+  const uint32_t link_count = in.read<uint32_t>();
+  for (uint32_t i = 0; i < link_count; ++i) {
+    const uint32_t from = in.read<uint32_t>();
+    const uint32_t to = in.read<uint32_t>();
+    LinkState& link = getOrCreateLink(from, to);
+    const uint8_t flags = in.read<uint8_t>();
+    const bool was_dropped = isDropped(link);
+    link.loss_state = in.read<uint8_t>();
+    link.burst.remaining = in.read<uint32_t>();
+    link.burst.in_burst = (flags & LINK_IN_BURST) != 0;
+    link.latency_sequence = in.read<uint64_t>();
+    link.loss_sequence = in.read<uint64_t>();
+    
+    link.has_latency = (flags & LINK_HAS_LATENCY) != 0;
+    if (link.has_latency) {
+      link.latency = readLatency(in);
+      if (!link.latency.isValid()) {
+        throw std::runtime_error("Checkpoint has an invalid latency configuration");
+      }
+      link.latency_sampler = samplerFor(link.latency);
+    }
+    link.has_packet_loss = (flags & LINK_HAS_PACKET_LOSS) != 0;
+    if (link.has_packet_loss) {
+      link.packet_loss = readPacketLoss(in);
+      if (!link.packet_loss.isValid()) {
+        throw std::runtime_error("Checkpoint has an invalid packet loss configuration");
+      }
+      link.loss_chain = chainFor(link.packet_loss);
+    }
+    link.has_bandwidth = (flags & LINK_HAS_BANDWIDTH) != 0;
+    if (link.has_bandwidth) {
+      link.bandwidth = readBandwidth(in);
+    }
+    link.bucket_initialized = (flags & LINK_BUCKET_INITIALIZED) != 0;
+    link.bucket = TokenBucket();
+    if (link.bucket_initialized) {
+      link.bucket.bytes_milli = in.read<uint64_t>();
+      link.bucket.messages_milli = in.read<uint64_t>();
+      link.bucket.last_refill_time = in.read<uint64_t>();
+      link.bucket.bytes_consumed = in.read<uint64_t>();
+      link.bucket.messages_consumed = in.read<uint64_t>();
+    }
+    link.has_stats = (flags & LINK_HAS_STATS) != 0;
+    link.stats = ConnectionStats();
+    if (link.has_stats) {
+      ConnectionStats& stats = link.stats;
+      stats.total_latency_ms = in.read<uint64_t>();
+      stats.min_latency_ms = in.read<uint32_t>();
+      stats.max_latency_ms = in.read<uint32_t>();
+      stats.message_count = in.read<uint64_t>();
+      stats.dropped_count = in.read<uint64_t>();
+      stats.delivered_count = in.read<uint64_t>();
+      stats.bytes_sent = in.read<uint64_t>();
+      stats.bandwidth_throttled = in.read<uint64_t>();
+      if (in.read<uint8_t>() != 0) {
+        stats.histogram.reset(new LatencyHistogram());
+        stats.histogram->loadState(in);
+      }
+    }
+    const bool dropped = (flags & LINK_DROPPED) != 0;
+    setDropped(link, dropped);
+    if (dropped && !was_dropped) {
+      dropped_link_count_++;
+    } else if (!dropped && was_dropped) {
+      dropped_link_count_--;
+    }
+  }
+  
+  partitions_.clear();
+  const uint32_t partition_count = in.read<uint32_t>();
+  for (uint32_t i = 0; i < partition_count; ++i) {
+    const uint32_t node = in.read<uint32_t>();
+    partitions_[node] = in.read<uint32_t>();
+  }
+  
+  message_queue_->clear();
+  resetCoalescing();
+  message_queue_->setDrainTime(in.read<uint64_t>());
+  std::vector<Payload> payloads;
+  const uint64_t queued = in.read<uint64_t>();
+  for (uint64_t i = 0; i < queued; ++i) {
+    DelayedMessage message;
+    message.from = in.read<uint32_t>();
+    message.to = in.read<uint32_t>();
+    message.deliveryTime = in.read<uint64_t>();
+    const uint32_t reference = in.read<uint32_t>();
+    if (reference == NEW_PAYLOAD) {
+      payloads.emplace_back(in.readString());
+      message.message = payloads.back();
+    } else if (reference < payloads.size()) {
+      message.message = payloads[reference];
+    } else {
+      throw std::runtime_error("Checkpoint message refers to an unknown payload");
+    }
+    message_queue_->push(std::move(message));
+  }
 }
 
 } // namespace simulator
@@ -0,0 +1,270 @@
+/**
+ * @file packet_capture.cpp
+ * @brief Implementation of PacketCapture class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/packet_capture.hpp"
+
+#include <chrono>
+#include <iterator>
+#include <stdexcept>
+
+namespace simulator {
+
+constexpr size_t CaptureRecord::MAX_PREFIX;
+constexpr uint16_t PacketCapture::LINK_TYPE;
+constexpr size_t PacketCapture::HEADER_SIZE;
+constexpr size_t PacketCapture::DEFAULT_BUFFER_RECORDS;
+
+namespace {
+
+/// pcapng block types
+constexpr uint32_t SECTION_HEADER_BLOCK = 0x0A0D0D0A;
+constexpr uint32_t INTERFACE_DESCRIPTION_BLOCK = 0x00000001;
+constexpr uint32_t ENHANCED_PACKET_BLOCK = 0x00000006;
+
+/// Section header byte-order magic
+constexpr uint32_t BYTE_ORDER_MAGIC = 0x1A2B3C4D;
+
+/// Fixed part of an Enhanced Packet Block (type, length, interface,
+/// timestamp, captured and original length, trailing length)
+constexpr size_t PACKET_BLOCK_OVERHEAD = 32;
+
+/// Idle writer wake-up interval
+constexpr auto WRITER_IDLE = std::chrono::milliseconds(10);
+
+template <typename T>
+void append(std::string& out, T value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+T read(const std::string& in, size_t offset) {
+  T value;
+  std::memcpy(&value, in.data() + offset, sizeof(value));
+  return value;
+}
+
+size_t padded(size_t size) {
+  return (size + 3) & ~size_t(3);
+}
+
+} // anonymous namespace
+
+PacketCapture::PacketCapture(const CaptureFilter& filter, size_t buffer_records)
+  : filtered_(!filter.nodes.empty() || !filter.links.empty()),
+    nodes_(filter.nodes.begin(), filter.nodes.end()),
+    prefix_(filter.payload_prefix),
+    buffer_records_(buffer_records) {
+  if (filter.payload_prefix > CaptureRecord::MAX_PREFIX) {
+    throw std::invalid_argument("Capture payload prefix must be at most " +
+                                std::to_string(CaptureRecord::MAX_PREFIX) + " bytes");
+  }
+  for (const auto& link : filter.links) {
+    links_.insert(linkKey(link.first, link.second));
+  }
+}
+
+PacketCapture::~PacketCapture() {
+  try {
+    close();
+  } catch (const std::exception&) {
+    // Destructors must not throw; close() reports failures to callers
+  }
+}
+
+void PacketCapture::open(const std::string& path) {
+  if (open_) {
+    return;
+  }
+  out_.open(path, std::ios::binary | std::ios::trunc);
+  if (!out_) {
+    throw std::runtime_error("Failed to create capture file: " + path);
+  }
+
+  std::string header;
+  append<uint32_t>(header, SECTION_HEADER_BLOCK);
+  append<uint32_t>(header, 28);
+  append<uint32_t>(header, BYTE_ORDER_MAGIC);
+  append<uint16_t>(header, 1);            // Major version
+  append<uint16_t>(header, 0);            // Minor version
+  append<int64_t>(header, -1);            // Section length not given
+  append<uint32_t>(header, 28);
+
+  append<uint32_t>(header, INTERFACE_DESCRIPTION_BLOCK);
+  append<uint32_t>(header, 20);
+  append<uint16_t>(header, LINK_TYPE);
+  append<uint16_t>(header, 0);            // Reserved
+  append<uint32_t>(header, static_cast<uint32_t>(HEADER_SIZE + CaptureRecord::MAX_PREFIX));
+  append<uint32_t>(header, 20);
+  out_.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+  queue_.reset(new SpscQueue<CaptureRecord>(buffer_records_));
+  captured_ = 0;
+  stalls_ = 0;
+  wake_ = false;
+  stopping_ = false;
+  error_ = nullptr;
+  open_ = true;
+  writer_ = std::thread(&PacketCapture::writerLoop, this);
+}
+
+void PacketCapture::close() {
+  if (!open_) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_cv_.notify_one();
+  writer_.join();
+  open_ = false;
+  queue_.reset();
+
+  out_.close();
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+  if (out_.fail()) {
+    throw std::runtime_error("Failed to write capture file");
+  }
+}
+
+void PacketCapture::push(CaptureRecord& record) {
+  while (!queue_->tryPush(std::move(record))) {
+    ++stalls_;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      wake_ = true;
+    }
+    wake_cv_.notify_one();
+    std::this_thread::yield();
+  }
+  ++captured_;
+}
+
+void PacketCapture::appendPacket(std::string& out, const CaptureRecord& record) const {
+  const size_t captured = HEADER_SIZE + record.prefix_length;
+  const size_t block = PACKET_BLOCK_OVERHEAD + padded(captured);
+  const uint64_t time_us = record.time_ms * 1000;
+
+  append<uint32_t>(out, ENHANCED_PACKET_BLOCK);
+  append<uint32_t>(out, static_cast<uint32_t>(block));
+  append<uint32_t>(out, 0);               // Interface
+  append<uint32_t>(out, static_cast<uint32_t>(time_us >> 32));
+  append<uint32_t>(out, static_cast<uint32_t>(time_us));
+  append<uint32_t>(out, static_cast<uint32_t>(captured));
+  append<uint32_t>(out, static_cast<uint32_t>(HEADER_SIZE + record.size));
+
+  append<uint32_t>(out, record.from);
+  append<uint32_t>(out, record.to);
+  append<uint32_t>(out, record.size);
+  append<uint8_t>(out, static_cast<uint8_t>(record.verdict));
+  out.append(3, '\0');
+  append<uint64_t>(out, record.delivery_ms);
+  out.append(record.prefix, record.prefix_length);
+  out.append(padded(captured) - captured, '\0');
+
+  append<uint32_t>(out, static_cast<uint32_t>(block));
+}
+
+void PacketCapture::writerLoop() {
+  std::string blocks;
+  CaptureRecord record;
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    const bool stopping = stopping_;
+    lock.unlock();
+
+    blocks.clear();
+    size_t count = 0;
+    while (queue_->tryPop(record)) {
+      appendPacket(blocks, record);
+      count++;
+    }
+    if (count > 0 && !error_) {
+      out_.write(blocks.data(), static_cast<std::streamsize>(blocks.size()));
+      if (!out_) {
+        error_ = std::make_exception_ptr(std::runtime_error("Failed to write capture file"));
+      }
+    }
+
+    lock.lock();
+    // Stop once a pass that started after close() found nothing
+    if (stopping && count == 0) {
+      break;
+    }
+    if (count == 0) {
+      wake_cv_.wait_for(lock, WRITER_IDLE, [&]() { return wake_ || stopping_; });
+    }
+    wake_ = false;
+  }
+}
+
+std::vector<CaptureRecord> PacketCapture::readFile(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    throw std::runtime_error("Failed to open capture file: " + path);
+  }
+  const std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  auto invalid = [&path](const char* reason) {
+    return std::runtime_error("Invalid capture file " + path + ": " + reason);
+  };
+
+  if (bytes.size() < 12 || read<uint32_t>(bytes, 0) != SECTION_HEADER_BLOCK ||
+      read<uint32_t>(bytes, 8) != BYTE_ORDER_MAGIC) {
+    throw invalid("not a little-endian pcapng file");
+  }
+
+  std::vector<CaptureRecord> records;
+  bool has_interface = false;
+  size_t offset = 0;
+  while (offset < bytes.size()) {
+    if (bytes.size() - offset < 12) {
+      throw invalid("truncated block");
+    }
+    const uint32_t type = read<uint32_t>(bytes, offset);
+    const uint32_t length = read<uint32_t>(bytes, offset + 4);
+    if (length < 12 || length % 4 != 0 || length > bytes.size() - offset) {
+      throw invalid("bad block length");
+    }
+
+    if (type == INTERFACE_DESCRIPTION_BLOCK) {
+      if (length < 20 || read<uint16_t>(bytes, offset + 8) != LINK_TYPE) {
+        throw invalid("not a simulator capture");
+      }
+      has_interface = true;
+    } else if (type == ENHANCED_PACKET_BLOCK) {
+      const uint32_t captured = length >= PACKET_BLOCK_OVERHEAD
+                                  ? read<uint32_t>(bytes, offset + 20) : 0;
+      if (!has_interface || captured < HEADER_SIZE ||
+          captured - HEADER_SIZE > CaptureRecord::MAX_PREFIX ||
+          PACKET_BLOCK_OVERHEAD + padded(captured) > length) {
+        throw invalid("bad packet block");
+      }
+      const size_t data = offset + 28;
+      const uint64_t time_us = (static_cast<uint64_t>(read<uint32_t>(bytes, offset + 12)) << 32) |
+                               read<uint32_t>(bytes, offset + 16);
+      CaptureRecord record;
+      record.time_ms = time_us / 1000;
+      record.from = read<uint32_t>(bytes, data);
+      record.to = read<uint32_t>(bytes, data + 4);
+      record.size = read<uint32_t>(bytes, data + 8);
+      record.verdict = static_cast<CaptureVerdict>(read<uint8_t>(bytes, data + 12));
+      record.delivery_ms = read<uint64_t>(bytes, data + 16);
+      record.prefix_length = static_cast<uint8_t>(captured - HEADER_SIZE);
+      std::memcpy(record.prefix, bytes.data() + data + HEADER_SIZE, record.prefix_length);
+      records.push_back(record);
+    }
+    // Other blocks are skipped
+    offset += length;
+  }
+  return records;
+}
+
+} // namespace simulator
@@ -0,0 +1,73 @@
+/**
+ * @file payload.cpp
+ * @brief Implementation of Payload class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/payload.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+
+namespace simulator {
+
+Payload::Payload(std::string data)
+    : buffer_(std::make_shared<const std::string>(std::move(data))),
+      size_(buffer_->size()) {
+}
+
+Payload::Payload(const char* data)
+    : Payload(std::string(data)) {
+}
+
+Payload::Payload(const char* data, size_t size)
+    : Payload(std::string(data, size)) {
+}
+
+const char* Payload::data() const {
+  return buffer_ ? buffer_->data() + offset_ : "";
+}
+
+Payload Payload::slice(size_t offset) const {
+  return slice(offset, size_);
+}
+
+Payload Payload::slice(size_t offset, size_t length) const {
+  if (offset > size_) {
+    throw std::out_of_range("Payload slice offset beyond end");
+  }
+
+  Payload view;
+  view.buffer_ = buffer_;
+  view.offset_ = offset_ + offset;
+  view.size_ = std::min(length, size_ - offset);
+  return view;
+}
+
+bool operator==(const Payload& lhs, const Payload& rhs) {
+  return lhs.size() == rhs.size() &&
+         (lhs.data() == rhs.data() ||
+          std::memcmp(lhs.data(), rhs.data(), lhs.size()) == 0);
+}
+
+bool operator==(const Payload& lhs, const std::string& rhs) {
+  return lhs.size() == rhs.size() &&
+         std::memcmp(lhs.data(), rhs.data(), lhs.size()) == 0;
+}
+
+bool operator==(const Payload& lhs, const char* rhs) {
+  size_t length = std::strlen(rhs);
+  return lhs.size() == length &&
+         std::memcmp(lhs.data(), rhs, length) == 0;
+}
+
+std::ostream& operator<<(std::ostream& os, const Payload& payload) {
+  return os.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+}
+
+} // namespace simulator
@@ -0,0 +1,127 @@
+/**
+ * @file radio_model.cpp
+ * @brief Implementation of the distance-based radio model
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/platform_compat.hpp"
+#include "simulator/radio_model.hpp"
+#include "simulator/mesh_transport.hpp"
+#include "simulator/network_simulator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace simulator {
+
+double RadioConfig::rssiAt(double distance_m) const {
+  const double d = std::max(1.0, distance_m);
+  return tx_power_dbm - reference_loss_db - 10.0 * path_loss_exponent * std::log10(d);
+}
+
+double RadioConfig::getRange() const {
+  return std::pow(10.0, (tx_power_dbm - reference_loss_db - sensitivity_dbm) /
+                        (10.0 * path_loss_exponent));
+}
+
+RadioModel::RadioModel(const RadioConfig& config)
+  : config_(config)
+  , range_(config.isValid() ? config.getRange() : 1.0)
+  , grid_(range_)
+{
+  if (!config.isValid()) {
+    throw std::invalid_argument("Invalid radio configuration");
+  }
+}
+
+void RadioModel::setPosition(uint32_t nodeId, const Position& position) {
+  grid_.insert(nodeId, position);
+}
+
+std::vector<uint32_t> RadioModel::getNeighbours(uint32_t nodeId) const {
+  return grid_.getNeighbours(nodeId, range_);
+}
+
+bool RadioModel::inRange(uint32_t a, uint32_t b) const {
+  const Position& pa = grid_.getPosition(a);
+  const Position& pb = grid_.getPosition(b);
+  const double dx = pa.x - pb.x;
+  const double dy = pa.y - pb.y;
+  return dx * dx + dy * dy <= range_ * range_;
+}
+
+double RadioModel::weakness(double distance_m) const {
+  const double margin = config_.rssiAt(distance_m) - config_.sensitivity_dbm;
+  return std::min(1.0, std::max(0.0, 1.0 - margin / config_.fade_margin_db));
+}
+
+LatencyConfig RadioModel::latencyAt(double distance_m) const {
+  LatencyConfig latency;
+  latency.min_ms = config_.base_latency_ms;
+  latency.max_ms = config_.base_latency_ms +
+                   static_cast<uint32_t>(std::lround(weakness(distance_m) * config_.edge_jitter_ms));
+  latency.distribution = DistributionType::UNIFORM;
+  return latency;
+}
+
+float RadioModel::lossAt(double distance_m) const {
+  return static_cast<float>(weakness(distance_m)) * config_.edge_loss;
+}
+
+void RadioModel::applyLink(uint32_t a, uint32_t b, double distance_m,
+                           NetworkSimulator& network) const {
+  const LatencyConfig latency = latencyAt(distance_m);
+  PacketLossConfig loss;
+  loss.probability = lossAt(distance_m);
+  network.setLatency(a, b, latency);
+  network.setLatency(b, a, latency);
+  network.setPacketLoss(a, b, loss);
+  network.setPacketLoss(b, a, loss);
+}
+
+size_t RadioModel::connect(MeshTransport& transport, NetworkSimulator& network) const {
+  size_t added = 0;
+  for (uint32_t id : grid_.getNodeIds()) {
+    grid_.forEachWithin(grid_.getPosition(id), range_,
+                        [&](uint32_t other, double distance) {
+      // Each pair once, from its lower ID
+      if (other <= id) {
+        return;
+      }
+      if (!transport.hasLink(id, other)) {
+        transport.addLink(id, other);
+        ++added;
+      }
+      applyLink(id, other, distance, network);
+    });
+  }
+  return added;
+}
+
+void RadioModel::moveNode(uint32_t nodeId, const Position& position,
+                          MeshTransport& transport, NetworkSimulator& network) {
+  const std::vector<uint32_t> before = getNeighbours(nodeId);
+  grid_.move(nodeId, position);
+
+  std::vector<uint32_t> after;
+  grid_.forEachWithin(position, range_, [&](uint32_t other, double distance) {
+    if (other == nodeId) {
+      return;
+    }
+    after.push_back(other);
+    transport.addLink(nodeId, other);  // No-op for existing links
+    applyLink(nodeId, other, distance, network);
+  });
+  std::sort(after.begin(), after.end());
+
+  for (uint32_t other : before) {
+    if (!std::binary_search(after.begin(), after.end(), other)) {
+      transport.removeLink(nodeId, other);
+    }
+  }
+}
+
+} // namespace simulator
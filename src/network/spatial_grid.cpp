@@ -0,0 +1,138 @@
+/**
+ * @file spatial_grid.cpp
+ * @brief Implementation of SpatialGrid class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/spatial_grid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace simulator {
+
+SpatialGrid::SpatialGrid(double cell_size)
+  : cell_size_(cell_size)
+{
+  if (!(cell_size > 0.0)) {
+    throw std::invalid_argument("Spatial grid cell size must be positive");
+  }
+}
+
+int64_t SpatialGrid::cellCoord(double value) const {
+  return static_cast<int64_t>(std::floor(value / cell_size_));
+}
+
+uint64_t SpatialGrid::cellKey(int64_t cx, int64_t cy) {
+  return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) |
+         static_cast<uint32_t>(cy);
+}
+
+uint64_t SpatialGrid::cellOf(const Position& position) const {
+  return cellKey(cellCoord(position.x), cellCoord(position.y));
+}
+
+void SpatialGrid::unlink(const Entry& entry) {
+  // Swap-remove from the cell list and fix the moved node's slot
+  auto it = cells_.find(entry.cell);
+  std::vector<uint32_t>& ids = it->second;
+  const uint32_t last = ids.back();
+  ids[entry.slot] = last;
+  entries_[last].slot = entry.slot;
+  ids.pop_back();
+  if (ids.empty()) {
+    cells_.erase(it);
+  }
+}
+
+void SpatialGrid::link(uint32_t nodeId, Entry& entry) {
+  std::vector<uint32_t>& ids = cells_[entry.cell];
+  entry.slot = static_cast<uint32_t>(ids.size());
+  ids.push_back(nodeId);
+}
+
+void SpatialGrid::insert(uint32_t nodeId, const Position& position) {
+  if (contains(nodeId)) {
+    move(nodeId, position);
+    return;
+  }
+  Entry& entry = entries_[nodeId];
+  entry.position = position;
+  entry.cell = cellOf(position);
+  link(nodeId, entry);
+}
+
+bool SpatialGrid::move(uint32_t nodeId, const Position& position) {
+  Entry& entry = entries_.at(nodeId);
+  entry.position = position;
+  const uint64_t cell = cellOf(position);
+  if (cell == entry.cell) {
+    return false;
+  }
+  unlink(entry);
+  entry.cell = cell;
+  link(nodeId, entry);
+  return true;
+}
+
+bool SpatialGrid::remove(uint32_t nodeId) {
+  auto it = entries_.find(nodeId);
+  if (it == entries_.end()) {
+    return false;
+  }
+  unlink(it->second);
+  entries_.erase(nodeId);
+  return true;
+}
+
+void SpatialGrid::forEachWithin(const Position& center, double radius,
+                                const Visitor& visitor) const {
+  const double radius_sq = radius * radius;
+  const int64_t x0 = cellCoord(center.x - radius);
+  const int64_t x1 = cellCoord(center.x + radius);
+  const int64_t y0 = cellCoord(center.y - radius);
+  const int64_t y1 = cellCoord(center.y + radius);
+  for (int64_t cx = x0; cx <= x1; ++cx) {
+    for (int64_t cy = y0; cy <= y1; ++cy) {
+      auto it = cells_.find(cellKey(cx, cy));
+      if (it == cells_.end()) {
+        continue;
+      }
+      for (uint32_t id : it->second) {
+        const Position& p = entries_.at(id).position;
+        const double dx = p.x - center.x;
+        const double dy = p.y - center.y;
+        const double distance_sq = dx * dx + dy * dy;
+        if (distance_sq <= radius_sq) {
+          visitor(id, std::sqrt(distance_sq));
+        }
+      }
+    }
+  }
+}
+
+std::vector<uint32_t> SpatialGrid::getNeighbours(uint32_t nodeId, double radius) const {
+  std::vector<uint32_t> result;
+  forEachWithin(getPosition(nodeId), radius, [&result, nodeId](uint32_t id, double) {
+    if (id != nodeId) {
+      result.push_back(id);
+    }
+  });
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+std::vector<uint32_t> SpatialGrid::getNodeIds() const {
+  std::vector<uint32_t> ids;
+  ids.reserve(entries_.size());
+  for (const auto& entry : entries_) {
+    ids.push_back(entry.first);
+  }
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+} // namespace simulator
@@ -0,0 +1,133 @@
+/**
+ * @file churn_generator.cpp
+ * @brief Implementation of the stochastic churn event source
+ * 
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/churn_generator.hpp"
+#include "simulator/events/connection_drop_event.hpp"
+#include "simulator/events/connection_restore_event.hpp"
+#include "simulator/events/node_crash_event.hpp"
+#include "simulator/events/node_restart_event.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace simulator {
+
+uint64_t ChurnDuration::sampleUs(CounterRng& rng) const {
+  double seconds = mean_s;
+  if (type != FIXED) {
+    // 1 - U lies in (0, 1], so the logarithm stays finite
+    const double u = 1.0 - std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+    const double e = -std::log(u);  // Exponential with mean 1
+    if (type == EXPONENTIAL) {
+      seconds = mean_s * e;
+    } else {
+      // Weibull scale chosen so the distribution has the requested mean
+      const double scale = mean_s / std::tgamma(1.0 + 1.0 / shape);
+      seconds = scale * std::pow(e, 1.0 / shape);
+    }
+  }
+  return std::max<uint64_t>(1, static_cast<uint64_t>(seconds * 1e6));
+}
+
+ChurnGenerator::ChurnGenerator(bool links, const ChurnDuration& failure,
+                               const ChurnDuration& repair, uint32_t seed, uint32_t salt)
+  : links_(links)
+  , failure_(failure)
+  , repair_(repair)
+  , seed_(seed)
+  , salt_(salt)
+{
+}
+
+std::unique_ptr<ChurnGenerator> ChurnGenerator::forNodes(const std::vector<uint32_t>& nodes,
+                                                         const ChurnDuration& failure,
+                                                         const ChurnDuration& repair,
+                                                         uint32_t seed, uint64_t start_us,
+                                                         uint32_t salt) {
+  std::unique_ptr<ChurnGenerator> generator(
+      new ChurnGenerator(false, failure, repair, seed, salt));
+  for (uint32_t node : nodes) {
+    generator->addTarget(node, 0, start_us);
+  }
+  return generator;
+}
+
+std::unique_ptr<ChurnGenerator> ChurnGenerator::forLinks(
+    const std::vector<std::pair<uint32_t, uint32_t>>& links,
+    const ChurnDuration& failure, const ChurnDuration& repair,
+    uint32_t seed, uint64_t start_us, uint32_t salt) {
+  std::unique_ptr<ChurnGenerator> generator(
+      new ChurnGenerator(true, failure, repair, seed, salt));
+  for (const auto& link : links) {
+    generator->addTarget(link.first, link.second, start_us);
+  }
+  return generator;
+}
+
+void ChurnGenerator::addTarget(uint32_t from, uint32_t to, uint64_t start_us) {
+  Target target;
+  target.from = from;
+  target.to = to;
+  target.up = true;
+  target.key = CounterRng::makeKey(seed_, from, to, RNG_STREAM_CHURN);
+  target.draws = 0;
+  target.next_us = start_us + draw(target, failure_);
+  
+  targets_.push_back(target);
+  heap_.push_back(static_cast<uint32_t>(targets_.size() - 1));
+  std::push_heap(heap_.begin(), heap_.end(),
+                 [this](uint32_t a, uint32_t b) { return later(a, b); });
+}
+
+uint64_t ChurnGenerator::draw(Target& target, const ChurnDuration& duration) {
+  // The salt occupies the top bits of the sample number, so generators
+  // sharing a target still draw independent durations
+  CounterRng rng(target.key, (static_cast<uint64_t>(salt_) << 40) | target.draws++);
+  return duration.sampleUs(rng);
+}
+
+bool ChurnGenerator::later(uint32_t a, uint32_t b) const {
+  // Ties break on target index so the order is reproducible
+  const Target& ta = targets_[a];
+  const Target& tb = targets_[b];
+  return ta.next_us != tb.next_us ? ta.next_us > tb.next_us : a > b;
+}
+
+uint64_t ChurnGenerator::getNextTimeUs() const {
+  return heap_.empty() ? UINT64_MAX : targets_[heap_.front()].next_us;
+}
+
+std::unique_ptr<Event> ChurnGenerator::next() {
+  auto cmp = [this](uint32_t a, uint32_t b) { return later(a, b); };
+  std::pop_heap(heap_.begin(), heap_.end(), cmp);
+  Target& target = targets_[heap_.back()];
+  
+  std::unique_ptr<Event> event;
+  if (links_) {
+    if (target.up) {
+      event = std::make_unique<ConnectionDropEvent>(target.from, target.to);
+    } else {
+      event = std::make_unique<ConnectionRestoreEvent>(target.from, target.to);
+    }
+  } else {
+    if (target.up) {
+      event = std::make_unique<NodeCrashEvent>(target.from);
+    } else {
+      event = std::make_unique<NodeRestartEvent>(target.from);
+    }
+  }
+  
+  // Schedule the opposite transition
+  target.next_us += draw(target, target.up ? repair_ : failure_);
+  target.up = !target.up;
+  std::push_heap(heap_.begin(), heap_.end(), cmp);
+  
+  return event;
+}
+
+} // namespace simulator
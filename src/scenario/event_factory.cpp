@@ -0,0 +1,295 @@
+/**
+ * @file event_factory.cpp
+ * @brief Implementation of the scenario event factory
+ * 
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/event_factory.hpp"
+#include "simulator/churn_generator.hpp"
+#include "simulator/event_scheduler.hpp"
+#include "simulator/events/connection_degrade_event.hpp"
+#include "simulator/events/connection_drop_event.hpp"
+#include "simulator/events/connection_restore_event.hpp"
+#include "simulator/events/network_heal_event.hpp"
+#include "simulator/events/network_partition_event.hpp"
+#include "simulator/events/node_crash_event.hpp"
+#include "simulator/events/node_restart_event.hpp"
+#include "simulator/events/node_start_event.hpp"
+#include "simulator/events/node_stop_event.hpp"
+#include "simulator/logger.hpp"
+#include <stdexcept>
+
+namespace simulator {
+
+EventFactory::EventFactory(const std::vector<NodeConfigExtended>& nodes) {
+  for (const auto& node : nodes) {
+    ids_[node.id] = node.nodeId;
+    node_ids_.push_back(node.nodeId);
+  }
+}
+
+uint64_t EventFactory::getEventTimeUs(const EventConfig& config) {
+  if (config.time_ms != 0) {
+    return config.time_ms * 1000;
+  }
+  return static_cast<uint64_t>(config.time) * 1000000;
+}
+
+bool EventFactory::resolve(const std::string& id, uint32_t& nodeId) const {
+  auto it = ids_.find(id);
+  if (it == ids_.end()) {
+    SIM_LOG_WARN("[WARN] Ignoring event for unknown node {}", id);
+    return false;
+  }
+  nodeId = it->second;
+  return true;
+}
+
+std::vector<std::unique_ptr<Event>> EventFactory::create(const EventConfig& config) const {
+  std::vector<std::unique_ptr<Event>> events;
+  
+  // Node actions apply to `target` and every entry of `targets`
+  std::vector<uint32_t> targets;
+  auto resolveTargets = [&]() {
+    std::vector<std::string> names;
+    if (!config.target.empty()) {
+      names.push_back(config.target);
+    }
+    names.insert(names.end(), config.targets.begin(), config.targets.end());
+    for (const auto& name : names) {
+      uint32_t id = 0;
+      if (resolve(name, id)) {
+        targets.push_back(id);
+      }
+    }
+  };
+  
+  uint32_t from = 0;
+  uint32_t to = 0;
+  auto resolveLink = [&]() {
+    return resolve(config.from, from) && resolve(config.to, to);
+  };
+  
+  switch (config.action) {
+    case EventAction::STOP_NODE:
+      resolveTargets();
+      for (uint32_t id : targets) {
+        events.push_back(std::make_unique<NodeStopEvent>(id, config.graceful));
+      }
+      break;
+    case EventAction::START_NODE:
+      resolveTargets();
+      for (uint32_t id : targets) {
+        events.push_back(std::make_unique<NodeStartEvent>(id));
+      }
+      break;
+    case EventAction::RESTART_NODE:
+      resolveTargets();
+      for (uint32_t id : targets) {
+        events.push_back(std::make_unique<NodeRestartEvent>(id));
+      }
+      break;
+    case EventAction::CRASH_NODE:
+      resolveTargets();
+      for (uint32_t id : targets) {
+        events.push_back(std::make_unique<NodeCrashEvent>(id));
+      }
+      break;
+    case EventAction::BREAK_LINK:
+    case EventAction::CONNECTION_DROP:
+      if (resolveLink()) {
+        events.push_back(std::make_unique<ConnectionDropEvent>(from, to));
+      }
+      break;
+    case EventAction::RESTORE_LINK:
+    case EventAction::CONNECTION_RESTORE:
+      if (resolveLink()) {
+        events.push_back(std::make_unique<ConnectionRestoreEvent>(from, to));
+      }
+      break;
+    case EventAction::CONNECTION_DEGRADE:
+      if (resolveLink()) {
+        events.push_back(std::make_unique<ConnectionDegradeEvent>(
+            from, to, config.latency, config.packet_loss));
+      }
+      break;
+    case EventAction::PARTITION_NETWORK: {
+      std::vector<std::vector<uint32_t>> groups;
+      for (const auto& group : config.groups) {
+        std::vector<uint32_t> ids;
+        for (const auto& name : group) {
+          uint32_t id = 0;
+          if (resolve(name, id)) {
+            ids.push_back(id);
+          }
+        }
+        groups.push_back(ids);
+      }
+      try {
+        events.push_back(std::make_unique<NetworkPartitionEvent>(groups));
+      } catch (const std::invalid_argument& e) {
+        SIM_LOG_WARN("[WARN] Ignoring partition event: {}", e.what());
+      }
+      break;
+    }
+    case EventAction::HEAL_PARTITION:
+      events.push_back(std::make_unique<NetworkHealEvent>());
+      break;
+    default:
+      SIM_LOG_WARN("[WARN] Event action not supported at runtime, skipping: {}",
+                   config.description.empty() ? "(no description)" : config.description);
+      break;
+  }
+  
+  const uint64_t time_us = getEventTimeUs(config);
+  for (auto& event : events) {
+    event->setScheduledTimeUs(time_us);
+  }
+  return events;
+}
+
+size_t EventFactory::scheduleAll(const std::vector<EventConfig>& events,
+                                 EventScheduler& scheduler) const {
+  size_t scheduled = 0;
+  for (const auto& config : events) {
+    for (auto& event : create(config)) {
+      const uint64_t time_us = event->getScheduledTimeUs();
+      scheduler.scheduleEventUs(std::move(event), time_us);
+      ++scheduled;
+    }
+  }
+  return scheduled;
+}
+
+namespace {
+
+ChurnDuration toChurnDuration(const DurationConfig& config) {
+  ChurnDuration duration;
+  if (config.distribution == "exponential") {
+    duration.type = ChurnDuration::EXPONENTIAL;
+  } else if (config.distribution == "weibull") {
+    duration.type = ChurnDuration::WEIBULL;
+  } else if (config.distribution == "fixed") {
+    duration.type = ChurnDuration::FIXED;
+  } else {
+    throw std::invalid_argument("Unknown churn distribution: " + config.distribution);
+  }
+  duration.mean_s = config.mean;
+  duration.shape = config.shape;
+  return duration;
+}
+
+} // anonymous namespace
+
+std::unique_ptr<EventSource> EventFactory::createChurn(const ChurnConfig& config,
+                                                       uint32_t seed, uint32_t salt) const {
+  const ChurnDuration failure = toChurnDuration(config.failure);
+  const ChurnDuration repair = toChurnDuration(config.repair);
+  const uint64_t start_us = static_cast<uint64_t>(config.start) * 1000000;
+  
+  std::unique_ptr<ChurnGenerator> generator;
+  if (config.type == "link") {
+    std::vector<std::pair<uint32_t, uint32_t>> links;
+    for (const auto& link : config.links) {
+      uint32_t from = 0;
+      uint32_t to = 0;
+      if (resolve(link.first, from) && resolve(link.second, to)) {
+        links.emplace_back(from, to);
+      }
+    }
+    generator = ChurnGenerator::forLinks(links, failure, repair, seed, start_us, salt);
+  } else {
+    std::vector<uint32_t> nodes;
+    if (config.targets.empty()) {
+      nodes = node_ids_;
+    }
+    for (const auto& name : config.targets) {
+      uint32_t id = 0;
+      if (resolve(name, id)) {
+        nodes.push_back(id);
+      }
+    }
+    generator = ChurnGenerator::forNodes(nodes, failure, repair, seed, start_us, salt);
+  }
+  
+  if (generator->getTargetCount() == 0) {
+    return nullptr;
+  }
+  return generator;
+}
+
+size_t EventFactory::addChurnSources(const std::vector<ChurnConfig>& churn, uint32_t seed,
+                                     EventScheduler& scheduler) const {
+  size_t added = 0;
+  for (size_t i = 0; i < churn.size(); ++i) {
+    auto source = createChurn(churn[i], seed, static_cast<uint32_t>(i));
+    if (source) {
+      scheduler.addSource(std::move(source));
+      ++added;
+    }
+  }
+  return added;
+}
+
+TrafficSpec EventFactory::createTraffic(const TrafficConfig& config) const {
+  TrafficSpec spec;
+  if (config.pattern == "all_to_sink") {
+    spec.pattern = TrafficPattern::ALL_TO_SINK;
+  } else if (config.pattern == "all_to_all") {
+    spec.pattern = TrafficPattern::ALL_TO_ALL;
+  } else {
+    throw std::invalid_argument("Unknown traffic pattern: " + config.pattern);
+  }
+  if (config.arrival == "constant") {
+    spec.arrival = TrafficArrival::CONSTANT;
+  } else if (config.arrival == "poisson") {
+    spec.arrival = TrafficArrival::POISSON;
+  } else if (config.arrival == "bursty") {
+    spec.arrival = TrafficArrival::BURSTY;
+  } else {
+    throw std::invalid_argument("Unknown traffic arrival process: " + config.arrival);
+  }
+  spec.rate = config.rate;
+  spec.burst = config.burst;
+  spec.size = config.size;
+  spec.start_ms = static_cast<uint64_t>(config.start) * 1000;
+  if (config.stop != 0) {
+    spec.stop_ms = static_cast<uint64_t>(config.stop) * 1000;
+  }
+  
+  if (spec.pattern == TrafficPattern::ALL_TO_SINK && !resolve(config.sink, spec.sink)) {
+    return spec;
+  }
+  if (config.sources.empty()) {
+    for (uint32_t id : node_ids_) {
+      if (spec.pattern == TrafficPattern::ALL_TO_ALL || id != spec.sink) {
+        spec.sources.push_back(id);
+      }
+    }
+  }
+  for (const auto& name : config.sources) {
+    uint32_t id = 0;
+    if (resolve(name, id)) {
+      spec.sources.push_back(id);
+    }
+  }
+  return spec;
+}
+
+size_t EventFactory::addTrafficStreams(const std::vector<TrafficConfig>& traffic,
+                                       TrafficGenerator& generator) const {
+  size_t added = 0;
+  for (const auto& config : traffic) {
+    TrafficSpec spec = createTraffic(config);
+    if (spec.sources.empty() || (spec.pattern == TrafficPattern::ALL_TO_SINK && spec.sink == 0)) {
+      continue;
+    }
+    generator.addStream(spec);
+    ++added;
+  }
+  return added;
+}
+
+} // namespace simulator
@@ -7,77 +7,190 @@
  */
 
 #include "simulator/event_scheduler.hpp"
+#include "simulator/alloc_tracker.hpp"
 #include "simulator/node_manager.hpp"
 #include "simulator/network_simulator.hpp"
-#include <iostream>
+#include "simulator/logger.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
 #include <stdexcept>
 
 namespace simulator {
 
+EventScheduler::EventScheduler() = default;
+
 void EventScheduler::scheduleEvent(std::unique_ptr<Event> event, uint32_t time) {
+  scheduleEventUs(std::move(event), static_cast<uint64_t>(time) * 1000000);
+}
+
+void EventScheduler::scheduleEventUs(std::unique_ptr<Event> event, uint64_t time_us) {
+  SIM_ALLOC_SCOPE(AllocTag::EVENTS);
   if (!event) {
     throw std::invalid_argument("Cannot schedule null event");
   }
   
-  event->setScheduledTime(time);
-  eventQueue_.push(std::move(event));
+  event->setScheduledTimeUs(time_us);
+  staged_.push_back(TimelineEntry{time_us, nextSequence_++, std::move(event)});
+}
+
+void EventScheduler::addSource(std::unique_ptr<EventSource> source) {
+  SIM_ALLOC_SCOPE(AllocTag::EVENTS);
+  if (!source) {
+    throw std::invalid_argument("Cannot add null event source");
+  }
+  sources_.push_back(std::move(source));
+}
+
+void EventScheduler::compile() {
+  SIM_ALLOC_SCOPE(AllocTag::EVENTS);
+  if (staged_.empty()) {
+    return;
+  }
+  
+  // Drop entries that already ran, then sort the additions in behind the
+  // remaining ones. Sequence numbers keep equal times in insertion order.
+  timeline_.erase(timeline_.begin(), timeline_.begin() + static_cast<std::ptrdiff_t>(cursor_));
+  cursor_ = 0;
+  const size_t merged = timeline_.size();
+  auto before = [](const TimelineEntry& a, const TimelineEntry& b) {
+    return a.time_us != b.time_us ? a.time_us < b.time_us : a.sequence < b.sequence;
+  };
+  std::sort(staged_.begin(), staged_.end(), before);
+  timeline_.insert(timeline_.end(),
+                   std::make_move_iterator(staged_.begin()),
+                   std::make_move_iterator(staged_.end()));
+  staged_.clear();
+  std::inplace_merge(timeline_.begin(),
+                     timeline_.begin() + static_cast<std::ptrdiff_t>(merged),
+                     timeline_.end(), before);
 }
 
 uint32_t EventScheduler::processEvents(uint32_t currentTime, NodeManager& manager, NetworkSimulator& network) {
+  return processEventsUs(static_cast<uint64_t>(currentTime) * 1000000, manager, network);
+}
+
+uint32_t EventScheduler::processEventsUs(uint64_t now_us, NodeManager& manager, NetworkSimulator& network) {
+  SIM_ALLOC_SCOPE(AllocTag::EVENTS);
+  // Pull only the source events that are already due
+  for (auto& source : sources_) {
+    for (uint64_t time_us = source->getNextTimeUs(); time_us <= now_us;
+         time_us = source->getNextTimeUs()) {
+      scheduleEventUs(source->next(), time_us);
+    }
+  }
+  compile();
+  
   uint32_t executedCount = 0;
   
-  // Process all events scheduled at or before current time
-  while (!eventQueue_.empty()) {
-    // Peek at the next event
-    const auto& nextEvent = eventQueue_.top();
-    
-    // Check if it's time to execute this event
-    if (nextEvent->getScheduledTime() > currentTime) {
-      // Next event is in the future, stop processing
-      break;
+  // Run every due timestamp as one batch
+  while (cursor_ < timeline_.size() && timeline_[cursor_].time_us <= now_us) {
+    const uint64_t batch_time = timeline_[cursor_].time_us;
+    size_t end = cursor_;
+    while (end < timeline_.size() && timeline_[end].time_us == batch_time) {
+      ++end;
     }
+    logBatch(batch_time, cursor_, end);
     
-    // Get event for execution (moving ownership out of queue)
-    auto event = std::move(const_cast<std::unique_ptr<Event>&>(nextEvent));
-    eventQueue_.pop();
-    
-    // Log event execution
-    std::cout << "[EVENT] t=" << currentTime << "s: " << event->getDescription() << std::endl;
-    
-    try {
-      // Execute the event
-      event->execute(manager, network);
-      executedCount++;
-    } catch (const std::exception& e) {
-      // Log error but continue processing other events
-      std::cerr << "[ERROR] Event execution failed: " << e.what() << std::endl;
+    for (size_t i = cursor_; i < end; ++i) {
+      try {
+        timeline_[i].event->execute(manager, network);
+        executedCount++;
+      } catch (const std::exception& e) {
+        // Log error but continue processing other events
+        SIM_LOG_ERROR("[ERROR] Event execution failed: {}", e.what());
+      }
+      timeline_[i].event.reset();
     }
+    cursor_ = end;
+  }
+  
+  if (cursor_ == timeline_.size()) {
+    timeline_.clear();
+    cursor_ = 0;
   }
   
   return executedCount;
 }
 
+size_t EventScheduler::skipUntilUs(uint64_t time_us) {
+  size_t skipped = 0;
+  for (auto& source : sources_) {
+    while (source->getNextTimeUs() < time_us) {
+      source->next();
+      skipped++;
+    }
+  }
+  compile();
+  
+  while (cursor_ < timeline_.size() && timeline_[cursor_].time_us < time_us) {
+    timeline_[cursor_].event.reset();
+    cursor_++;
+    skipped++;
+  }
+  if (cursor_ == timeline_.size()) {
+    timeline_.clear();
+    cursor_ = 0;
+  }
+  return skipped;
+}
+
+void EventScheduler::logBatch(uint64_t time_us, size_t begin, size_t end) const {
+  if (use_logger_ ? !Logger::instance().enabled(LogLevel::INFO) : !log_) {
+    return;
+  }
+  
+  const uint64_t at_ms = time_us / 1000;
+  std::ostringstream record;
+  record << "[EVENT] t=" << at_ms / 1000 << "." << std::setw(3) << std::setfill('0')
+         << at_ms % 1000 << std::setfill(' ') << "s: ";
+  if (end - begin == 1) {
+    record << timeline_[begin].event->getDescription();
+  } else {
+    record << (end - begin) << " events (" << timeline_[begin].event->getDescription()
+           << ", ...)";
+  }
+  if (use_logger_) {
+    SIM_LOG_INFO("{}", record.str());
+    return;
+  }
+  record << '\n';
+  *log_ << record.str();
+}
+
 bool EventScheduler::hasPendingEvents() const {
-  return !eventQueue_.empty();
+  return getNextEventTimeUs() != UINT64_MAX;
 }
 
 size_t EventScheduler::getPendingEventCount() const {
-  return eventQueue_.size();
+  return timeline_.size() - cursor_ + staged_.size();
 }
 
 uint32_t EventScheduler::getNextEventTime() const {
-  if (eventQueue_.empty()) {
+  const uint64_t next_us = getNextEventTimeUs();
+  if (next_us == UINT64_MAX) {
     return UINT32_MAX;
   }
-  return eventQueue_.top()->getScheduledTime();
+  return static_cast<uint32_t>(next_us / 1000000);
+}
+
+uint64_t EventScheduler::getNextEventTimeUs() const {
+  uint64_t next_us = cursor_ < timeline_.size() ? timeline_[cursor_].time_us : UINT64_MAX;
+  for (const auto& entry : staged_) {
+    next_us = std::min(next_us, entry.time_us);
+  }
+  for (const auto& source : sources_) {
+    next_us = std::min(next_us, source->getNextTimeUs());
+  }
+  return next_us;
 }
 
 void EventScheduler::clear() {
-  // Clear the priority queue by creating a new empty one
-  std::priority_queue<std::unique_ptr<Event>, 
-                      std::vector<std::unique_ptr<Event>>, 
-                      EventComparator> emptyQueue;
-  eventQueue_ = std::move(emptyQueue);
+  timeline_.clear();
+  staged_.clear();
+  sources_.clear();
+  cursor_ = 0;
 }
 
 } // namespace simulator
@@ -9,7 +9,7 @@
 #include "simulator/events/connection_degrade_event.hpp"
 #include "simulator/node_manager.hpp"
 #include "simulator/network_simulator.hpp"
-#include <iostream>
+#include "simulator/logger.hpp"
 
 namespace simulator {
 
@@ -40,10 +40,8 @@ void ConnectionDegradeEvent::execute(NodeManager& manager, NetworkSimulator& net
   network.setPacketLoss(fromNode_, toNode_, loss);
   network.setPacketLoss(toNode_, fromNode_, loss);
   
-  std::cout << "[EVENT] Connection degraded: " << fromNode_ 
-            << " <-> " << toNode_ 
-            << " (latency: " << latencyMs_ << "ms, loss: " 
-            << (packetLoss_ * 100.0f) << "%)" << std::endl;
+  SIM_LOG_INFO("[EVENT] Connection degraded: {} <-> {} (latency: {}ms, loss: {}%)",
+               fromNode_, toNode_, latencyMs_, packetLoss_ * 100.0f);
 }
 
 std::string ConnectionDegradeEvent::getDescription() const {
@@ -9,7 +9,7 @@
 #include "simulator/events/connection_drop_event.hpp"
 #include "simulator/node_manager.hpp"
 #include "simulator/network_simulator.hpp"
-#include <iostream>
+#include "simulator/logger.hpp"
 
 namespace simulator {
 
@@ -22,8 +22,7 @@ void ConnectionDropEvent::execute(NodeManager& manager, NetworkSimulator& networ
   network.dropConnection(fromNode_, toNode_);
   network.dropConnection(toNode_, fromNode_);
   
-  std::cout << "[EVENT] Connection dropped: " << fromNode_ 
-            << " <-> " << toNode_ << std::endl;
+  SIM_LOG_INFO("[EVENT] Connection dropped: {} <-> {}", fromNode_, toNode_);
 }
 
 std::string ConnectionDropEvent::getDescription() const {
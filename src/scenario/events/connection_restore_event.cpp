@@ -9,7 +9,7 @@
 #include "simulator/events/connection_restore_event.hpp"
 #include "simulator/node_manager.hpp"
 #include "simulator/network_simulator.hpp"
-#include <iostream>
+#include "simulator/logger.hpp"
 
 namespace simulator {
 
@@ -22,8 +22,7 @@ void ConnectionRestoreEvent::execute(NodeManager& manager, NetworkSimulator& net
   network.restoreConnection(fromNode_, toNode_);
   network.restoreConnection(toNode_, fromNode_);
   
-  std::cout << "[EVENT] Connection restored: " << fromNode_ 
-            << " <-> " << toNode_ << std::endl;
+  SIM_LOG_INFO("[EVENT] Connection restored: {} <-> {}", fromNode_, toNode_);
 }
 
 std::string ConnectionRestoreEvent::getDescription() const {
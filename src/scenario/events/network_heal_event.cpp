@@ -9,12 +9,13 @@
 #include "simulator/events/network_heal_event.hpp"
 #include "simulator/node_manager.hpp"
 #include "simulator/network_simulator.hpp"
-#include <iostream>
+#include "simulator/logger.hpp"
 
 namespace simulator {
 
 void NetworkHealEvent::execute(NodeManager& manager, NetworkSimulator& network) {
-  // Restore all previously dropped connections
+  // Rejoin all partitions and restore previously dropped connections
+  network.clearPartitions();
   network.restoreAllConnections();
   
   // Clear partition IDs for all nodes
@@ -22,7 +23,7 @@ void NetworkHealEvent::execute(NodeManager& manager, NetworkSimulator& network)
     node->setPartitionId(0);  // Single partition
   }
   
-  std::cout << "[EVENT] Network partitions healed" << std::endl;
+  SIM_LOG_INFO("[EVENT] Network partitions healed");
 }
 
 std::string NetworkHealEvent::getDescription() const {
@@ -9,7 +9,7 @@
 #include "simulator/events/network_partition_event.hpp"
 #include "simulator/node_manager.hpp"
 #include "simulator/network_simulator.hpp"
-#include <iostream>
+#include "simulator/logger.hpp"
 #include <stdexcept>
 
 namespace simulator {
@@ -33,42 +33,28 @@ NetworkPartitionEvent::NetworkPartitionEvent(
 }
 
 void NetworkPartitionEvent::execute(NodeManager& manager, NetworkSimulator& network) {
-  // Drop all connections between different groups
-  for (size_t i = 0; i < partition_groups_.size(); ++i) {
-    for (size_t j = i + 1; j < partition_groups_.size(); ++j) {
-      dropConnectionsBetweenGroups(network, partition_groups_[i], partition_groups_[j]);
-    }
-  }
-  
-  std::cout << "[EVENT] Network partitioned into " << partition_groups_.size() 
-            << " groups" << std::endl;
-  
-  // Mark partition state for metrics
+  // Label every node with its group; the network simulator drops traffic
+  // between labels, so this costs O(n) rather than one drop per node pair.
+  // A new partition replaces the previous one.
+  network.clearPartitions();
   for (size_t i = 0; i < partition_groups_.size(); ++i) {
+    const uint32_t partitionId = static_cast<uint32_t>(i + 1);  // 1-based partition IDs
     for (const auto& nodeId : partition_groups_[i]) {
+      network.setPartition(nodeId, partitionId);
+      
+      // Mark partition state for metrics
       auto node = manager.getNode(nodeId);
       if (node) {
-        node->setPartitionId(static_cast<uint32_t>(i + 1));  // 1-based partition IDs
+        node->setPartitionId(partitionId);
       }
     }
   }
+  
+  SIM_LOG_INFO("[EVENT] Network partitioned into {} groups", partition_groups_.size());
 }
 
 std::string NetworkPartitionEvent::getDescription() const {
   return "Partition network into " + std::to_string(partition_groups_.size()) + " groups";
 }
 
-void NetworkPartitionEvent::dropConnectionsBetweenGroups(
-    NetworkSimulator& network,
-    const std::vector<uint32_t>& group1,
-    const std::vector<uint32_t>& group2) {
-  
-  for (const auto& node1 : group1) {
-    for (const auto& node2 : group2) {
-      network.dropConnection(node1, node2);
-      network.dropConnection(node2, node1);
-    }
-  }
-}
-
 } // namespace simulator
@@ -9,8 +9,8 @@
 #include "simulator/events/node_crash_event.hpp"
 #include "simulator/node_manager.hpp"
 #include "simulator/network_simulator.hpp"
+#include "simulator/logger.hpp"
 #include <stdexcept>
-#include <iostream>
 
 namespace simulator {
 
@@ -28,9 +28,9 @@ void NodeCrashEvent::execute(NodeManager& manager, NetworkSimulator& network) {
   
   if (node->isRunning()) {
     node->crash();
-    std::cout << "[EVENT] Node " << nodeId_ << " crashed (ungraceful)" << std::endl;
+    SIM_LOG_INFO("[EVENT] Node {} crashed (ungraceful)", nodeId_);
   } else {
-    std::cout << "[EVENT] Node " << nodeId_ << " is already stopped" << std::endl;
+    SIM_LOG_INFO("[EVENT] Node {} is already stopped", nodeId_);
   }
 }
 
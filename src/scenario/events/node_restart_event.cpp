@@ -9,8 +9,8 @@
 #include "simulator/events/node_restart_event.hpp"
 #include "simulator/node_manager.hpp"
 #include "simulator/network_simulator.hpp"
+#include "simulator/logger.hpp"
 #include <stdexcept>
-#include <iostream>
 
 namespace simulator {
 
@@ -27,7 +27,7 @@ void NodeRestartEvent::execute(NodeManager& manager, NetworkSimulator& network)
   }
   
   node->restart();
-  std::cout << "[EVENT] Node " << nodeId_ << " restarted" << std::endl;
+  SIM_LOG_INFO("[EVENT] Node {} restarted", nodeId_);
 }
 
 std::string NodeRestartEvent::getDescription() const {
@@ -9,8 +9,8 @@
 #include "simulator/events/node_start_event.hpp"
 #include "simulator/node_manager.hpp"
 #include "simulator/network_simulator.hpp"
+#include "simulator/logger.hpp"
 #include <stdexcept>
-#include <iostream>
 
 namespace simulator {
 
@@ -28,9 +28,9 @@ void NodeStartEvent::execute(NodeManager& manager, NetworkSimulator& network) {
   
   if (!node->isRunning()) {
     node->start();
-    std::cout << "[EVENT] Node " << nodeId_ << " started" << std::endl;
+    SIM_LOG_INFO("[EVENT] Node {} started", nodeId_);
   } else {
-    std::cout << "[EVENT] Node " << nodeId_ << " is already running" << std::endl;
+    SIM_LOG_INFO("[EVENT] Node {} is already running", nodeId_);
   }
 }
 
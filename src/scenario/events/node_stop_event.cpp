@@ -9,8 +9,8 @@
 #include "simulator/events/node_stop_event.hpp"
 #include "simulator/node_manager.hpp"
 #include "simulator/network_simulator.hpp"
+#include "simulator/logger.hpp"
 #include <stdexcept>
-#include <iostream>
 
 namespace simulator {
 
@@ -28,10 +28,9 @@ void NodeStopEvent::execute(NodeManager& manager, NetworkSimulator& network) {
   
   if (node->isRunning()) {
     node->stop();
-    std::cout << "[EVENT] Node " << nodeId_ << " stopped " 
-              << (graceful_ ? "(graceful)" : "(forced)") << std::endl;
+    SIM_LOG_INFO("[EVENT] Node {} stopped {}", nodeId_, graceful_ ? "(graceful)" : "(forced)");
   } else {
-    std::cout << "[EVENT] Node " << nodeId_ << " is already stopped" << std::endl;
+    SIM_LOG_INFO("[EVENT] Node {} is already stopped", nodeId_);
   }
 }
 
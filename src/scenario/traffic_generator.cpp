@@ -0,0 +1,222 @@
+/**
+ * @file traffic_generator.cpp
+ * @brief Implementation of TrafficGenerator class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/traffic_generator.hpp"
+#include "simulator/counter_rng.hpp"
+#include "simulator/mesh_transport.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+
+namespace simulator {
+
+constexpr size_t TrafficGenerator::HEADER_SIZE;
+constexpr uint32_t TrafficGenerator::MAGIC;
+
+TrafficGenerator::TrafficGenerator(MeshTransport& transport, uint32_t seed)
+  : transport_(transport), seed_(seed) {
+  transport_.setFrameFilter([this](uint32_t, uint32_t, const Payload& msg) {
+    return onDelivery(msg);
+  });
+}
+
+TrafficGenerator::~TrafficGenerator() {
+  transport_.setFrameFilter(nullptr);
+}
+
+std::string TrafficGenerator::toString(TrafficPattern pattern) {
+  return pattern == TrafficPattern::ALL_TO_ALL ? "all_to_all" : "all_to_sink";
+}
+
+std::string TrafficGenerator::toString(TrafficArrival arrival) {
+  switch (arrival) {
+    case TrafficArrival::POISSON: return "poisson";
+    case TrafficArrival::BURSTY: return "bursty";
+    default: return "constant";
+  }
+}
+
+size_t TrafficGenerator::addStream(const TrafficSpec& spec) {
+  if (!(spec.rate > 0.0) || !std::isfinite(spec.rate)) {
+    throw std::invalid_argument("Traffic rate must be a positive number of messages per second");
+  }
+  if (spec.size < HEADER_SIZE) {
+    throw std::invalid_argument("Traffic messages need at least " + std::to_string(HEADER_SIZE) +
+                                " bytes");
+  }
+  if (spec.burst == 0) {
+    throw std::invalid_argument("Traffic bursts need at least one message");
+  }
+  if (spec.sources.empty()) {
+    throw std::invalid_argument("Traffic stream has no sources");
+  }
+  if (spec.pattern == TrafficPattern::ALL_TO_SINK && spec.sink == 0) {
+    throw std::invalid_argument("All-to-sink traffic needs a sink");
+  }
+
+  const uint32_t index = static_cast<uint32_t>(streams_.size());
+  Stream stream;
+  stream.spec = spec;
+  stream.stop_us = spec.stop_ms >= UINT64_MAX / 1000 ? UINT64_MAX : spec.stop_ms * 1000;
+  stream.begin_ms = spec.start_ms;
+  streams_.push_back(stream);
+
+  // One message body per stream, one frame per source: the header holds
+  // the origin (and the sink), so a frame cannot be shared across sources
+  std::string body(spec.size, 'x');
+  std::memcpy(&body[0], &MAGIC, sizeof(MAGIC));
+  std::memcpy(&body[sizeof(MAGIC)], &index, sizeof(index));
+
+  const uint64_t start_us = spec.start_ms * 1000;
+  const size_t count = spec.sources.size();
+  auto cmp = [this](uint32_t a, uint32_t b) { return later(a, b); };
+  for (size_t i = 0; i < count; ++i) {
+    const uint32_t node = spec.sources[i];
+    if (spec.pattern == TrafficPattern::ALL_TO_SINK && node == spec.sink) {
+      continue;  // The sink does not send to itself
+    }
+    Source source;
+    source.stream = index;
+    source.node = node;
+    source.key = CounterRng::makeKey(seed_, node, index, RNG_STREAM_TRAFFIC);
+    source.draws = 0;
+    source.frame = spec.pattern == TrafficPattern::ALL_TO_ALL
+                     ? MeshTransport::encodeBroadcast(node, body)
+                     : MeshTransport::encodeSingle(node, spec.sink, body);
+    if (spec.arrival == TrafficArrival::CONSTANT) {
+      // Staggered over one period, so the sources do not fire in lockstep
+      source.next_us = start_us + gapUs(source, spec) * i / count;
+    } else {
+      source.next_us = start_us + gapUs(source, spec);
+    }
+    if (source.next_us >= streams_.back().stop_us) {
+      continue;
+    }
+    sources_.push_back(std::move(source));
+    heap_.push_back(static_cast<uint32_t>(sources_.size() - 1));
+    std::push_heap(heap_.begin(), heap_.end(), cmp);
+  }
+  return index;
+}
+
+uint64_t TrafficGenerator::gapUs(Source& source, const TrafficSpec& spec) {
+  const double per_send = spec.arrival == TrafficArrival::BURSTY ? spec.burst : 1.0;
+  const double mean_us = per_send * 1e6 / spec.rate;
+  if (spec.arrival == TrafficArrival::CONSTANT) {
+    return std::max<uint64_t>(1, static_cast<uint64_t>(std::llround(mean_us)));
+  }
+  // 1 - U lies in (0, 1], so the logarithm stays finite
+  CounterRng rng(source.key, source.draws++);
+  const double u = 1.0 - std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+  return std::max<uint64_t>(1, static_cast<uint64_t>(mean_us * -std::log(u)));
+}
+
+bool TrafficGenerator::later(uint32_t a, uint32_t b) const {
+  // Ties break on source index so the order is reproducible
+  const Source& sa = sources_[a];
+  const Source& sb = sources_[b];
+  return sa.next_us != sb.next_us ? sa.next_us > sb.next_us : a > b;
+}
+
+size_t TrafficGenerator::generate(uint64_t now_ms) {
+  // All sends of the call are evaluated as one batch
+  transport_.beginBatch();
+  const size_t offered = popDue(now_ms * 1000, true, now_ms);
+  transport_.flushBatch();
+
+  for (Stream& stream : streams_) {
+    const uint64_t end_ms = std::min(now_ms, stream.spec.stop_ms);
+    stream.stats.active_ms = end_ms > stream.begin_ms ? end_ms - stream.begin_ms : 0;
+  }
+  return offered;
+}
+
+void TrafficGenerator::skipTo(uint64_t now_ms) {
+  popDue(now_ms * 1000, false, now_ms);
+  for (Stream& stream : streams_) {
+    stream.begin_ms = std::max(stream.begin_ms, now_ms);
+  }
+}
+
+size_t TrafficGenerator::popDue(uint64_t now_us, bool send, uint64_t now_ms) {
+  auto cmp = [this](uint32_t a, uint32_t b) { return later(a, b); };
+  size_t offered = 0;
+  while (!heap_.empty() && sources_[heap_.front()].next_us <= now_us) {
+    std::pop_heap(heap_.begin(), heap_.end(), cmp);
+    Source& source = sources_[heap_.back()];
+    Stream& stream = streams_[source.stream];
+    const TrafficSpec& spec = stream.spec;
+
+    const uint32_t messages = send ? (spec.arrival == TrafficArrival::BURSTY ? spec.burst : 1) : 0;
+    for (uint32_t i = 0; i < messages; ++i) {
+      bool sent;
+      if (spec.pattern == TrafficPattern::ALL_TO_ALL) {
+        // Every other node that is up is asked to receive a broadcast
+        const size_t attached = transport_.getAttachedCount();
+        stream.stats.expected += attached - (transport_.isAttached(source.node) ? 1 : 0);
+        sent = transport_.sendBroadcastFrame(source.node, source.frame, now_ms);
+      } else {
+        stream.stats.expected++;
+        sent = transport_.sendSingleFrame(source.node, source.frame, now_ms);
+      }
+      stream.stats.offered++;
+      stream.stats.sent += sent ? 1 : 0;
+      offered++;
+    }
+
+    source.next_us += gapUs(source, spec);
+    if (source.next_us >= stream.stop_us) {
+      heap_.pop_back();  // The source has stopped
+    } else {
+      std::push_heap(heap_.begin(), heap_.end(), cmp);
+    }
+  }
+  return offered;
+}
+
+uint64_t TrafficGenerator::getNextTimeMs() const {
+  if (heap_.empty()) {
+    return UINT64_MAX;
+  }
+  return (sources_[heap_.front()].next_us + 999) / 1000;
+}
+
+TrafficStats TrafficGenerator::getTotals() const {
+  TrafficStats totals;
+  for (const Stream& stream : streams_) {
+    const TrafficStats& stats = stream.stats;
+    totals.offered += stats.offered;
+    totals.sent += stats.sent;
+    totals.expected += stats.expected;
+    totals.delivered += stats.delivered;
+    totals.bytes_delivered += stats.bytes_delivered;
+    totals.active_ms = std::max(totals.active_ms, stats.active_ms);
+  }
+  return totals;
+}
+
+bool TrafficGenerator::onDelivery(const Payload& msg) {
+  if (msg.size() < HEADER_SIZE) {
+    return false;
+  }
+  uint32_t magic;
+  uint32_t stream;
+  std::memcpy(&magic, msg.data(), sizeof(magic));
+  std::memcpy(&stream, msg.data() + sizeof(magic), sizeof(stream));
+  if (magic != MAGIC || stream >= streams_.size()) {
+    return false;  // Firmware traffic
+  }
+  TrafficStats& stats = streams_[stream].stats;
+  stats.delivered++;
+  stats.bytes_delivered += msg.size();
+  return true;
+}
+
+} // namespace simulator
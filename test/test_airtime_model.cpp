@@ -0,0 +1,193 @@
+/**
+ * @file test_airtime_model.cpp
+ * @brief Unit tests for AirtimeModel
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/airtime_model.hpp"
+#include "simulator/checkpoint.hpp"
+
+#include <stdexcept>
+
+using namespace simulator;
+
+namespace {
+
+/**
+ * @brief Medium at 8 Mbit/s, so a byte takes 1 us, with 100 us overhead
+ */
+AirtimeConfig testConfig() {
+  AirtimeConfig config;
+  config.bitrate_bps = 8000000;
+  config.frame_overhead_us = 100;
+  config.slot_us = 10;
+  config.contention_window = 4;
+  config.max_wait_ms = 5;
+  return config;
+}
+
+} // namespace
+
+TEST_CASE("AirtimeConfig computes frame airtime", "[airtime]") {
+  AirtimeConfig config;
+  REQUIRE_FALSE(config.isEnabled());
+  REQUIRE(config.airtimeUs(100) == 0);
+
+  config = testConfig();
+  REQUIRE(config.isEnabled());
+  REQUIRE(config.airtimeUs(0) == 100);
+  REQUIRE(config.airtimeUs(900) == 1000);
+
+  config.bitrate_bps = 3;  // Partial microseconds round up
+  REQUIRE(config.airtimeUs(1) == 100 + 2666667);
+
+  config.contention_window = 0;
+  REQUIRE_FALSE(config.isValid());
+  AirtimeModel medium;
+  REQUIRE_THROWS_AS(medium.configure(config, 1), std::invalid_argument);
+}
+
+TEST_CASE("AirtimeModel passes frames through when disabled", "[airtime]") {
+  AirtimeModel medium;
+  for (int i = 0; i < 100; ++i) {
+    MediumAccess access = medium.transmit(1, 1000, 0);
+    REQUIRE(access.sent);
+    REQUIRE(access.delay_ms == 0);
+  }
+  REQUIRE(medium.getStats().frames == 0);
+  REQUIRE(medium.getDomainOf(1) == AirtimeModel::NO_DOMAIN);
+}
+
+TEST_CASE("AirtimeModel serializes frames on a shared medium", "[airtime]") {
+  AirtimeModel medium;
+  medium.configure(testConfig(), 42);
+  medium.setNeighbours({{1, {2}}, {2, {1}}});
+  REQUIRE(medium.getDomainOf(1) == medium.getDomainOf(2));
+
+  SECTION("an idle medium sends at once") {
+    MediumAccess access = medium.transmit(1, 900, 0);
+    REQUIRE(access.sent);
+    REQUIRE(access.delay_ms == 1);  // 1000 us on the air
+    REQUIRE(medium.getStats().wait_us == 0);
+  }
+
+  SECTION("a busy medium makes the next frame wait and back off") {
+    medium.transmit(1, 1900, 0);  // Busy until 2000 us
+    MediumAccess access = medium.transmit(2, 900, 0);
+    REQUIRE(access.sent);
+    const AirtimeStats stats = medium.getStats();
+    REQUIRE(stats.frames == 2);
+    REQUIRE(stats.wait_us >= 2000);
+    REQUIRE(stats.wait_us < 2000 + 4 * 10);
+    REQUIRE(access.delay_ms == (stats.wait_us + 1000 + 999) / 1000);
+
+    // The medium frees up as time passes, without any refill call
+    REQUIRE(medium.transmit(1, 900, 10).delay_ms == 1);
+    REQUIRE(medium.getStats().wait_us == stats.wait_us);
+  }
+
+  SECTION("frames that would wait too long are dropped") {
+    medium.transmit(1, 5900, 0);  // Busy beyond the longest wait of 5 ms
+    MediumAccess access = medium.transmit(2, 100, 0);
+    REQUIRE_FALSE(access.sent);
+    REQUIRE(medium.getStats().dropped == 1);
+    REQUIRE(medium.getStats().frames == 1);
+
+    // A dropped frame does not hold the medium
+    REQUIRE(medium.transmit(2, 100, 2).sent);
+  }
+
+  SECTION("a replayed earlier send does not wait for later frames") {
+    // Lookahead windows admit relays of later ticks before the nodes'
+    // own sends are replayed
+    medium.transmit(1, 900, 90);
+    MediumAccess access = medium.transmit(2, 900, 0);
+    REQUIRE(access.sent);
+    REQUIRE(access.delay_ms == 1);
+    REQUIRE(medium.getStats().wait_us == 0);
+
+    // It still waits for frames sent before it
+    medium.transmit(1, 1900, 50);  // Busy until 52000 us for sends from 50 ms
+    access = medium.transmit(2, 900, 51);
+    REQUIRE(access.sent);
+    REQUIRE(medium.getStats().wait_us >= 1000);
+    REQUIRE(medium.getStats().wait_us < 1000 + 4 * 10);
+
+    // Sends in time order see every frame again
+    access = medium.transmit(2, 100, 90);
+    REQUIRE(medium.getStats().wait_us >= 1000 + 1000);
+  }
+
+  SECTION("replays beyond the horizon wait for the frames that left it") {
+    medium.transmit(1, 1900, 1);  // Busy until 3000 us
+    medium.transmit(1, 100, AirtimeModel::REPLAY_HORIZON_MS + 10);
+    REQUIRE(medium.transmit(2, 100, 0).delay_ms >= 3);
+  }
+}
+
+TEST_CASE("AirtimeModel groups neighbours into collision domains", "[airtime]") {
+  AirtimeModel medium;
+  medium.configure(testConfig(), 42);
+
+  // Two stars joined by 3 - 4
+  medium.setNeighbours({{1, {2, 3}}, {2, {1}}, {3, {1, 4}}, {4, {3, 5}}, {5, {4}}});
+  REQUIRE(medium.getDomainOf(1) == medium.getDomainOf(2));
+  REQUIRE(medium.getDomainOf(1) == medium.getDomainOf(3));
+  REQUIRE(medium.getDomainOf(4) == medium.getDomainOf(5));
+  REQUIRE(medium.getDomainOf(1) != medium.getDomainOf(4));
+  REQUIRE(medium.getStats().domains == 2);
+
+  SECTION("separate domains send at the same time") {
+    medium.transmit(1, 4900, 0);
+    REQUIRE(medium.transmit(4, 900, 0).delay_ms == 1);
+  }
+
+  SECTION("a node without neighbours gets a medium of its own") {
+    medium.transmit(9, 4900, 0);
+    REQUIRE(medium.getDomainOf(9) != AirtimeModel::NO_DOMAIN);
+    REQUIRE(medium.transmit(1, 900, 0).delay_ms == 1);
+  }
+
+  SECTION("a rebuilt domain stays busy as long as its members' were") {
+    medium.transmit(4, 3900, 0);  // Busy until 4000 us
+    medium.setNeighbours({{4, {1}}, {1, {4}}});
+    REQUIRE(medium.getDomainOf(1) == medium.getDomainOf(4));
+    REQUIRE(medium.getDomainOf(2) != medium.getDomainOf(1));
+    medium.transmit(1, 900, 0);
+    REQUIRE(medium.getStats().wait_us >= 4000);
+  }
+
+  SECTION("rebuilding from the same neighbours changes nothing") {
+    medium.transmit(9, 100, 0);
+    const uint32_t before = medium.getDomainOf(9);
+    medium.setNeighbours({{1, {2, 3}}, {2, {1}}, {3, {1, 4}}, {4, {3, 5}}, {5, {4}}});
+    REQUIRE(medium.getDomainOf(9) == before);
+    REQUIRE(medium.getStats().domains == 3);
+  }
+}
+
+TEST_CASE("AirtimeModel restores its state from a checkpoint", "[airtime]") {
+  AirtimeModel medium;
+  medium.configure(testConfig(), 7);
+  medium.setNeighbours({{1, {2}}, {2, {1}}});
+  medium.transmit(1, 1900, 0);
+  medium.transmit(2, 100, 0);
+
+  CheckpointWriter out;
+  medium.saveState(out);
+
+  AirtimeModel restored;
+  restored.configure(testConfig(), 7);
+  CheckpointReader in(out.data());
+  restored.loadState(in);
+
+  REQUIRE(restored.getDomainOf(2) == medium.getDomainOf(2));
+  REQUIRE(restored.getStats().wait_us == medium.getStats().wait_us);
+  for (int i = 0; i < 5; ++i) {
+    REQUIRE(restored.transmit(2, 100, 1).delay_ms == medium.transmit(2, 100, 1).delay_ms);
+  }
+}
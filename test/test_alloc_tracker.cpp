@@ -0,0 +1,95 @@
+/**
+ * @file test_alloc_tracker.cpp
+ * @brief Unit tests for AllocTracker
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/alloc_tracker.hpp"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace simulator;
+
+TEST_CASE("Allocation scopes set the thread's tag", "[alloc_tracker]") {
+  REQUIRE(AllocTracker::getTag() == AllocTag::OTHER);
+  {
+    AllocScope mesh(AllocTag::MESH);
+    REQUIRE(AllocTracker::getTag() == AllocTag::MESH);
+    {
+      AllocScope firmware(AllocTag::FIRMWARE);
+      REQUIRE(AllocTracker::getTag() == AllocTag::FIRMWARE);
+
+      // Tags are per thread
+      AllocTag other_thread = AllocTag::MESH;
+      std::thread([&other_thread]() { other_thread = AllocTracker::getTag(); }).join();
+      REQUIRE(other_thread == AllocTag::OTHER);
+    }
+    REQUIRE(AllocTracker::getTag() == AllocTag::MESH);
+  }
+  REQUIRE(AllocTracker::getTag() == AllocTag::OTHER);
+  REQUIRE(std::string(allocTagName(AllocTag::NETWORK)) == "network");
+}
+
+TEST_CASE("AllocTracker counts allocations per tag", "[alloc_tracker]") {
+  const AllocSnapshot before = AllocTracker::snapshot();
+  const size_t events = static_cast<size_t>(AllocTag::EVENTS);
+
+  std::unique_ptr<std::vector<char>> block;
+  {
+    AllocScope scope(AllocTag::EVENTS);
+    block.reset(new std::vector<char>(100000));
+  }
+  const AllocSnapshot during = AllocTracker::snapshot();
+
+  // Freed under another tag, still subtracted from its own
+  block.reset();
+  const AllocSnapshot after = AllocTracker::snapshot();
+
+  if (!AllocTracker::isEnabled()) {
+    REQUIRE(AllocTracker::total(after).allocations == 0);
+    return;
+  }
+  REQUIRE(during[events].allocations - before[events].allocations == 2);
+  REQUIRE(during[events].live_bytes - before[events].live_bytes >= 100000);
+  REQUIRE(during[events].peak_bytes >= during[events].live_bytes);
+  REQUIRE(after[events].live_bytes == before[events].live_bytes);
+  REQUIRE(after[events].frees - before[events].frees == 2);
+  REQUIRE(after[events].allocated_bytes - before[events].allocated_bytes >= 100000);
+}
+
+TEST_CASE("AllocTracker reports per tag and per node", "[alloc_tracker]") {
+  AllocSnapshot snapshot;
+  AllocStats& mesh = snapshot[static_cast<size_t>(AllocTag::MESH)];
+  mesh.allocations = 30;
+  mesh.frees = 10;
+  mesh.live_bytes = 3 * 1024 * 1024;
+  mesh.peak_bytes = 4 * 1024 * 1024;
+  AllocStats& network = snapshot[static_cast<size_t>(AllocTag::NETWORK)];
+  network.allocations = 5;
+  network.live_bytes = 2048;
+  network.peak_bytes = 2048;
+
+  const AllocStats total = AllocTracker::total(snapshot);
+  REQUIRE(total.allocations == 35);
+  REQUIRE(total.liveBlocks() == 25);
+  REQUIRE(total.live_bytes == 3 * 1024 * 1024 + 2048);
+
+  std::ostringstream out;
+  AllocTracker::print(snapshot, 1024, out);
+  const std::string report = out.str();
+  REQUIRE(report.find("  mesh: 3.0 MiB live, 4.0 MiB peak, 20 blocks, 30 allocations, "
+                      "3.0 KiB/node\n") != std::string::npos);
+  REQUIRE(report.find("  network: 2.0 KiB live") != std::string::npos);
+  REQUIRE(report.find("events") == std::string::npos);
+  REQUIRE(report.find("  total: ") != std::string::npos);
+
+  REQUIRE(AllocTracker::summary(snapshot) == "mesh=3.0 MiB network=2.0 KiB");
+}
@@ -0,0 +1,226 @@
+/**
+ * @file test_checkpoint.cpp
+ * @brief Unit tests for simulation checkpoints
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/checkpoint.hpp"
+#include "simulator/mesh_transport.hpp"
+#include "simulator/network_simulator.hpp"
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace simulator;
+
+namespace {
+
+using Delivery = std::tuple<uint32_t, uint32_t, std::string, uint64_t>;
+
+/**
+ * @brief Builds a simulator with random latency, loss and bandwidth limits
+ */
+void configure(NetworkSimulator& sim, QueueBackend backend) {
+  sim.setQueueBackend(backend);
+  LatencyConfig latency;
+  latency.min_ms = 1;
+  latency.max_ms = 40;
+  sim.setDefaultLatency(latency);
+  PacketLossConfig loss;
+  loss.probability = 0.2f;
+  sim.setDefaultPacketLoss(loss);
+
+  PacketLossConfig bursts;
+  bursts.gilbert_elliott = true;
+  bursts.good_to_bad = 0.1f;
+  bursts.bad_to_good = 0.3f;
+  sim.setPacketLoss(1, 3, bursts);
+
+  BandwidthConfig bandwidth;
+  bandwidth.max_messages_per_sec = 200;
+  bandwidth.bucket_size = 5;
+  sim.setBandwidth(2, 1, bandwidth);
+}
+
+/**
+ * @brief Sends a deterministic batch of traffic for one millisecond
+ */
+void step(NetworkSimulator& sim, uint64_t now, std::vector<Delivery>& delivered) {
+  Payload broadcast("tick " + std::to_string(now));
+  for (uint32_t from = 1; from <= 3; ++from) {
+    for (uint32_t to = 1; to <= 3; ++to) {
+      if (from != to && sim.canSendMessage(from, to, broadcast.size(), now)) {
+        sim.consumeBandwidth(from, to, broadcast.size(), now);
+        sim.enqueueMessage(from, to, broadcast, now);
+      }
+    }
+  }
+  for (auto& message : sim.getReadyMessages(now)) {
+    delivered.emplace_back(message.from, message.to, message.message.str(),
+                           message.deliveryTime);
+  }
+}
+
+} // anonymous namespace
+
+TEST_CASE("Checkpoint buffers", "[checkpoint]") {
+  SECTION("values round-trip") {
+    CheckpointWriter out;
+    out.beginSection(CHECKPOINT_NETWORK);
+    out.write<uint64_t>(1234567890123ULL);
+    out.write<float>(0.25f);
+    out.writeString("hello");
+    out.write<uint8_t>(7);
+
+    std::vector<uint8_t> bytes = out.release();
+    CheckpointReader in(bytes);
+    in.expectSection(CHECKPOINT_NETWORK);
+    REQUIRE(in.read<uint64_t>() == 1234567890123ULL);
+    REQUIRE(in.read<float>() == 0.25f);
+    REQUIRE(in.readString() == "hello");
+    REQUIRE(in.read<uint8_t>() == 7);
+    REQUIRE(in.remaining() == 0);
+  }
+
+  SECTION("truncated and mismatched data throws") {
+    CheckpointWriter out;
+    out.beginSection(CHECKPOINT_NODES);
+    out.write<uint32_t>(100);
+    std::vector<uint8_t> bytes = out.release();
+
+    CheckpointReader wrong(bytes);
+    REQUIRE_THROWS_AS(wrong.expectSection(CHECKPOINT_NETWORK), std::runtime_error);
+
+    CheckpointReader in(bytes.data(), bytes.size() - 1);
+    in.expectSection(CHECKPOINT_NODES);
+    REQUIRE_THROWS_AS(in.read<uint32_t>(), std::runtime_error);
+
+    // The count read as a string length runs past the end
+    CheckpointReader string_in(bytes);
+    string_in.expectSection(CHECKPOINT_NODES);
+    REQUIRE_THROWS_AS(string_in.readString(), std::runtime_error);
+  }
+
+  SECTION("files round-trip") {
+    const std::string path = "test_checkpoint.ckpt";
+    Checkpoint checkpoint;
+    checkpoint.time_us = 600000000;
+    checkpoint.seed = 42;
+    checkpoint.state = {1, 2, 3, 4};
+    checkpoint.save(path);
+
+    Checkpoint loaded = Checkpoint::load(path);
+    REQUIRE(loaded.time_us == checkpoint.time_us);
+    REQUIRE(loaded.seed == 42);
+    REQUIRE(loaded.state == checkpoint.state);
+    std::remove(path.c_str());
+
+    REQUIRE_THROWS_AS(Checkpoint::load("missing.ckpt"), std::runtime_error);
+  }
+}
+
+TEST_CASE("NetworkSimulator checkpoints fork identical runs", "[checkpoint][network_simulator]") {
+  for (auto backend : {QueueBackend::HEAP, QueueBackend::TIMING_WHEEL}) {
+    NetworkSimulator original(777);
+    configure(original, backend);
+    original.setPartition(3, 1);
+
+    std::vector<Delivery> warmup;
+    for (uint64_t now = 0; now < 500; ++now) {
+      if (now == 250) {
+        original.clearPartitions();
+        original.dropConnection(1, 2);
+      }
+      step(original, now, warmup);
+    }
+    REQUIRE(original.getPendingMessageCount() > 0);
+
+    CheckpointWriter out;
+    original.saveState(out);
+    std::vector<uint8_t> bytes = out.release();
+
+    // The fork starts from the scenario alone, without the warm-up
+    NetworkSimulator fork(777);
+    configure(fork, backend);
+    CheckpointReader in(bytes);
+    fork.loadState(in);
+    REQUIRE(in.remaining() == 0);
+
+    REQUIRE(fork.getPendingMessageCount() == original.getPendingMessageCount());
+    REQUIRE_FALSE(fork.isConnectionActive(1, 2));
+    REQUIRE(fork.getPartition(3) == 0);
+
+    std::vector<Delivery> from_original;
+    std::vector<Delivery> from_fork;
+    for (uint64_t now = 500; now < 1500; ++now) {
+      if (now == 900) {
+        original.restoreConnection(1, 2);
+        fork.restoreConnection(1, 2);
+      }
+      step(original, now, from_original);
+      step(fork, now, from_fork);
+    }
+
+    REQUIRE(from_original.size() > 1000);
+    REQUIRE(from_fork == from_original);
+    for (uint32_t from = 1; from <= 3; ++from) {
+      for (uint32_t to = 1; to <= 3; ++to) {
+        if (from == to) {
+          continue;
+        }
+        auto a = original.getStats(from, to);
+        auto b = fork.getStats(from, to);
+        REQUIRE(a.message_count == b.message_count);
+        REQUIRE(a.dropped_count == b.dropped_count);
+        REQUIRE(a.p99_latency_ms == b.p99_latency_ms);
+        REQUIRE(a.bandwidth_throttled == b.bandwidth_throttled);
+      }
+    }
+    REQUIRE(original.getGlobalLatencyHistogram().getCount() ==
+            fork.getGlobalLatencyHistogram().getCount());
+  }
+}
+
+TEST_CASE("MeshTransport checkpoints", "[checkpoint][mesh_transport]") {
+  NetworkSimulator network(5);
+  MeshTransport transport(network);
+  transport.attach(1, {});
+  transport.attach(2, {});
+  transport.attach(3, {});
+  transport.addLinks({{1, 2}, {2, 3}});
+  transport.sendBroadcast(1, "hello");
+  transport.update(3);
+
+  CheckpointWriter out;
+  network.saveState(out);
+  transport.saveState(out);
+  std::vector<uint8_t> bytes = out.release();
+
+  NetworkSimulator restored_network(5);
+  MeshTransport restored(restored_network);
+  restored.attach(1, {});
+  restored.attach(2, {});
+  restored.attach(3, {});
+  restored.addLink(1, 3);
+
+  CheckpointReader in(bytes);
+  restored_network.loadState(in);
+  restored.loadState(in);
+
+  REQUIRE(restored.getCurrentTime() == 3);
+  REQUIRE(restored.getLinkCount() == 2);
+  REQUIRE(restored.hasLink(2, 3));
+  REQUIRE_FALSE(restored.hasLink(1, 3));
+  REQUIRE(restored.getStats().frames_sent == transport.getStats().frames_sent);
+  REQUIRE(restored_network.getPendingMessageCount() == network.getPendingMessageCount());
+
+  CheckpointReader network_only(bytes);
+  REQUIRE_THROWS_AS(restored.loadState(network_only), std::runtime_error);
+}
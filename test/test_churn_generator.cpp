@@ -0,0 +1,120 @@
+/**
+ * @file test_churn_generator.cpp
+ * @brief Unit tests for the stochastic churn event source
+ * 
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include "simulator/churn_generator.hpp"
+#include "simulator/events/connection_drop_event.hpp"
+#include "simulator/events/connection_restore_event.hpp"
+#include "simulator/events/node_crash_event.hpp"
+#include "simulator/events/node_restart_event.hpp"
+#include <map>
+#include <vector>
+
+using namespace simulator;
+
+namespace {
+
+double sampleMeanSeconds(const ChurnDuration& duration, int samples) {
+  const uint64_t key = CounterRng::makeKey(7, 1, 0, RNG_STREAM_CHURN);
+  double total = 0.0;
+  for (int i = 0; i < samples; ++i) {
+    CounterRng rng(key, static_cast<uint64_t>(i));
+    total += static_cast<double>(duration.sampleUs(rng)) / 1e6;
+  }
+  return total / samples;
+}
+
+} // namespace
+
+TEST_CASE("ChurnDuration sampling", "[churn]") {
+  SECTION("fixed durations are exact") {
+    ChurnDuration fixed{ChurnDuration::FIXED, 2.5, 1.0};
+    CounterRng rng(1, 0);
+    REQUIRE(fixed.sampleUs(rng) == 2500000);
+  }
+  
+  SECTION("exponential durations have the requested mean") {
+    ChurnDuration exponential{ChurnDuration::EXPONENTIAL, 100.0, 1.0};
+    double mean = sampleMeanSeconds(exponential, 20000);
+    REQUIRE(mean > 95.0);
+    REQUIRE(mean < 105.0);
+  }
+  
+  SECTION("weibull durations have the requested mean") {
+    ChurnDuration weibull{ChurnDuration::WEIBULL, 100.0, 2.0};
+    double mean = sampleMeanSeconds(weibull, 20000);
+    REQUIRE(mean > 97.0);
+    REQUIRE(mean < 103.0);
+  }
+}
+
+TEST_CASE("ChurnGenerator produces alternating transitions", "[churn]") {
+  ChurnDuration mtbf{ChurnDuration::EXPONENTIAL, 60.0, 1.0};
+  ChurnDuration mttr{ChurnDuration::EXPONENTIAL, 5.0, 1.0};
+  
+  SECTION("nodes crash and restart in turn, in time order") {
+    auto generator = ChurnGenerator::forNodes({1001, 1002, 1003}, mtbf, mttr, 42);
+    std::map<uint32_t, bool> crashed;
+    uint64_t last_us = 0;
+    
+    for (int i = 0; i < 3000; ++i) {
+      const uint64_t time_us = generator->getNextTimeUs();
+      REQUIRE(time_us >= last_us);
+      last_us = time_us;
+      
+      auto event = generator->next();
+      if (dynamic_cast<NodeCrashEvent*>(event.get())) {
+        const std::string description = event->getDescription();
+        uint32_t node = static_cast<uint32_t>(std::stoul(description.substr(description.rfind(' ') + 1)));
+        REQUIRE_FALSE(crashed[node]);
+        crashed[node] = true;
+      } else {
+        auto* restart = dynamic_cast<NodeRestartEvent*>(event.get());
+        REQUIRE(restart != nullptr);
+        const std::string description = event->getDescription();
+        uint32_t node = static_cast<uint32_t>(std::stoul(description.substr(description.rfind(' ') + 1)));
+        REQUIRE(crashed[node]);
+        crashed[node] = false;
+      }
+    }
+    
+    // State stays one entry per target however long the run
+    REQUIRE(generator->getTargetCount() == 3);
+  }
+  
+  SECTION("links flap between drop and restore") {
+    auto generator = ChurnGenerator::forLinks({{1001, 1002}}, mtbf, mttr, 42);
+    REQUIRE(dynamic_cast<ConnectionDropEvent*>(generator->next().get()) != nullptr);
+    REQUIRE(dynamic_cast<ConnectionRestoreEvent*>(generator->next().get()) != nullptr);
+  }
+  
+  SECTION("no failure happens before the start time") {
+    auto generator = ChurnGenerator::forNodes({1001, 1002}, mtbf, mttr, 42, 3600000000ULL);
+    REQUIRE(generator->getNextTimeUs() > 3600000000ULL);
+  }
+  
+  SECTION("the same seed replays the same churn") {
+    auto first = ChurnGenerator::forNodes({1001, 1002}, mtbf, mttr, 42);
+    auto second = ChurnGenerator::forNodes({1001, 1002}, mtbf, mttr, 42);
+    auto other = ChurnGenerator::forNodes({1001, 1002}, mtbf, mttr, 43);
+    
+    bool differs = false;
+    for (int i = 0; i < 20; ++i) {
+      REQUIRE(first->getNextTimeUs() == second->getNextTimeUs());
+      differs = differs || first->getNextTimeUs() != other->getNextTimeUs();
+      REQUIRE(first->next()->getDescription() == second->next()->getDescription());
+      other->next();
+    }
+    REQUIRE(differs);
+  }
+  
+  SECTION("an empty generator is exhausted") {
+    auto generator = ChurnGenerator::forNodes({}, mtbf, mttr, 42);
+    REQUIRE(generator->getNextTimeUs() == UINT64_MAX);
+  }
+}
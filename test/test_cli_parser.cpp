@@ -54,6 +54,7 @@ TEST_CASE("CLI parser basic functionality", "[cli_parser]") {
     REQUIRE(options.output_dir == "results/");
     REQUIRE(options.ui_mode == "none");
     REQUIRE(options.validate_only == false);
+    REQUIRE(options.scenario_cache == true);
     REQUIRE(options.help == false);
     REQUIRE(options.version == false);
     REQUIRE_FALSE(options.duration);
@@ -115,6 +116,24 @@ TEST_CASE("CLI parser basic functionality", "[cli_parser]") {
     REQUIRE(options.validate_only == true);
   }
   
+  SECTION("parses unbounded flag") {
+    std::vector<std::string> args = {"program", "--config", "test.yaml", "--unbounded"};
+    ArgvHelper helper(args);
+    
+    auto options = parseCommandLine(helper.argc(), helper.argv());
+    
+    REQUIRE(options.unbounded == true);
+  }
+
+  SECTION("parses no-scenario-cache flag") {
+    std::vector<std::string> args = {"program", "--config", "test.yaml", "--no-scenario-cache"};
+    ArgvHelper helper(args);
+
+    auto options = parseCommandLine(helper.argc(), helper.argv());
+
+    REQUIRE(options.scenario_cache == false);
+  }
+
   SECTION("parses time scale override") {
     std::vector<std::string> args = {"program", "--config", "test.yaml", "--time-scale", "2.5"};
     ArgvHelper helper(args);
@@ -125,6 +144,36 @@ TEST_CASE("CLI parser basic functionality", "[cli_parser]") {
     REQUIRE(*options.time_scale == 2.5f);
   }
   
+  SECTION("parses threads override") {
+    std::vector<std::string> args = {"program", "--config", "test.yaml", "--threads", "8"};
+    ArgvHelper helper(args);
+    
+    auto options = parseCommandLine(helper.argc(), helper.argv());
+    
+    REQUIRE(options.threads);
+    REQUIRE(*options.threads == 8);
+  }
+  
+  SECTION("parses max nodes override") {
+    std::vector<std::string> args = {"program", "--config", "test.yaml", "--max-nodes", "10000"};
+    ArgvHelper helper(args);
+    
+    auto options = parseCommandLine(helper.argc(), helper.argv());
+    
+    REQUIRE(options.max_nodes);
+    REQUIRE(*options.max_nodes == 10000);
+  }
+  
+  SECTION("parses seed override") {
+    std::vector<std::string> args = {"program", "--config", "test.yaml", "--seed", "1234"};
+    ArgvHelper helper(args);
+    
+    auto options = parseCommandLine(helper.argc(), helper.argv());
+    
+    REQUIRE(options.seed);
+    REQUIRE(*options.seed == 1234);
+  }
+  
   SECTION("parses multiple options together") {
     std::vector<std::string> args = {
       "program", 
@@ -242,6 +291,26 @@ TEST_CASE("CLI parser error handling", "[cli_parser]") {
     );
   }
   
+  SECTION("throws on zero threads") {
+    std::vector<std::string> args = {"program", "--config", "test.yaml", "--threads", "0"};
+    ArgvHelper helper(args);
+    
+    REQUIRE_THROWS_AS(
+      parseCommandLine(helper.argc(), helper.argv()),
+      std::runtime_error
+    );
+  }
+  
+  SECTION("throws on zero max nodes") {
+    std::vector<std::string> args = {"program", "--config", "test.yaml", "--max-nodes", "0"};
+    ArgvHelper helper(args);
+    
+    REQUIRE_THROWS_AS(
+      parseCommandLine(helper.argc(), helper.argv()),
+      std::runtime_error
+    );
+  }
+  
   SECTION("throws on unknown option") {
     std::vector<std::string> args = {"program", "--config", "test.yaml", "--unknown-option"};
     ArgvHelper helper(args);
@@ -298,3 +367,426 @@ TEST_CASE("CLI parser validation", "[cli_parser]") {
     }
   }
 }
+
+TEST_CASE("CLI parser distributed roles", "[cli_parser]") {
+  
+  SECTION("parses coordinator mode") {
+    std::vector<std::string> args = {"program", "--config", "test.yaml",
+                                     "--coordinator", "7700", "--workers", "3"};
+    ArgvHelper helper(args);
+    
+    auto options = parseCommandLine(helper.argc(), helper.argv());
+    REQUIRE(options.coordinator_port);
+    REQUIRE(*options.coordinator_port == 7700);
+    REQUIRE(*options.workers == 3);
+    REQUIRE_FALSE(options.worker_port);
+  }
+  
+  SECTION("parses worker mode") {
+    std::vector<std::string> args = {"program", "--config", "test.yaml",
+                                     "--worker", "sim-host:7700", "--rank", "2"};
+    ArgvHelper helper(args);
+    
+    auto options = parseCommandLine(helper.argc(), helper.argv());
+    REQUIRE(options.worker_host == "sim-host");
+    REQUIRE(*options.worker_port == 7700);
+    REQUIRE(*options.rank == 2);
+    REQUIRE_FALSE(options.coordinator_port);
+  }
+  
+  SECTION("rejects inconsistent roles") {
+    std::vector<std::vector<std::string>> invalid = {
+      {"--coordinator", "7700"},
+      {"--coordinator", "7700", "--workers", "0"},
+      {"--coordinator", "0", "--workers", "2"},
+      {"--workers", "2"},
+      {"--worker", "host:7700"},
+      {"--rank", "1"},
+      {"--worker", "host", "--rank", "0"},
+      {"--worker", "host:port", "--rank", "0"},
+      {"--worker", "host:70000", "--rank", "0"},
+      {"--coordinator", "7700", "--workers", "2", "--worker", "host:7700", "--rank", "0"},
+    };
+    
+    for (const auto& extra : invalid) {
+      std::vector<std::string> args = {"program", "--config", "test.yaml"};
+      args.insert(args.end(), extra.begin(), extra.end());
+      ArgvHelper helper(args);
+      
+      REQUIRE_THROWS_AS(
+        parseCommandLine(helper.argc(), helper.argv()),
+        std::runtime_error
+      );
+    }
+  }
+}
+
+TEST_CASE("CLI parser checkpoints", "[cli_parser]") {
+  
+  SECTION("parses checkpoint and restore") {
+    std::vector<std::string> args = {"program", "--config", "test.yaml",
+                                     "--checkpoint", "warm.ckpt", "--checkpoint-at", "600",
+                                     "--restore", "earlier.ckpt"};
+    ArgvHelper helper(args);
+    
+    auto options = parseCommandLine(helper.argc(), helper.argv());
+    REQUIRE(options.checkpoint_file == "warm.ckpt");
+    REQUIRE(*options.checkpoint_at == 600.0f);
+    REQUIRE(options.restore_file == "earlier.ckpt");
+  }
+  
+  SECTION("rejects incomplete or distributed checkpoints") {
+    std::vector<std::vector<std::string>> invalid = {
+      {"--checkpoint", "warm.ckpt"},
+      {"--checkpoint-at", "600"},
+      {"--checkpoint", "warm.ckpt", "--checkpoint-at", "-1"},
+      {"--restore", "warm.ckpt", "--coordinator", "7700", "--workers", "2"},
+    };
+    
+    for (const auto& extra : invalid) {
+      std::vector<std::string> args = {"program", "--config", "test.yaml"};
+      args.insert(args.end(), extra.begin(), extra.end());
+      ArgvHelper helper(args);
+      
+      REQUIRE_THROWS_AS(
+        parseCommandLine(helper.argc(), helper.argv()),
+        std::runtime_error
+      );
+    }
+  }
+}
+
+TEST_CASE("CLI parser packet capture", "[cli_parser]") {
+  
+  SECTION("parses the capture file and filters") {
+    std::vector<std::string> args = {"program", "--config", "test.yaml",
+                                     "--capture", "run.pcapng",
+                                     "--capture-nodes", "gateway,sensor-1",
+                                     "--capture-links", "hub-1:sensor-2,a:b",
+                                     "--capture-payload", "16"};
+    ArgvHelper helper(args);
+    
+    auto options = parseCommandLine(helper.argc(), helper.argv());
+    REQUIRE(options.capture_file == "run.pcapng");
+    REQUIRE(options.capture_nodes == std::vector<std::string>{"gateway", "sensor-1"});
+    REQUIRE(options.capture_links.size() == 2);
+    REQUIRE(options.capture_links[0].first == "hub-1");
+    REQUIRE(options.capture_links[0].second == "sensor-2");
+    REQUIRE(options.capture_payload == 16);
+  }
+  
+  SECTION("rejects filters without a file and bad values") {
+    std::vector<std::vector<std::string>> invalid = {
+      {"--capture-nodes", "gateway"},
+      {"--capture", "run.pcapng", "--capture-links", "hub-1"},
+      {"--capture", "run.pcapng", "--capture-payload", "65"},
+    };
+    
+    for (const auto& extra : invalid) {
+      std::vector<std::string> args = {"program", "--config", "test.yaml"};
+      args.insert(args.end(), extra.begin(), extra.end());
+      ArgvHelper helper(args);
+      
+      REQUIRE_THROWS_AS(
+        parseCommandLine(helper.argc(), helper.argv()),
+        std::runtime_error
+      );
+    }
+  }
+}
+
+TEST_CASE("CLI parser live metrics", "[cli_parser]") {
+  
+  SECTION("parses the metrics port") {
+    std::vector<std::string> args = {"program", "--config", "test.yaml", "--metrics-port", "9100"};
+    ArgvHelper helper(args);
+    
+    auto options = parseCommandLine(helper.argc(), helper.argv());
+    REQUIRE(options.metrics_port);
+    REQUIRE(*options.metrics_port == 9100);
+  }
+  
+  SECTION("rejects bad ports and distributed runs") {
+    std::vector<std::vector<std::string>> invalid = {
+      {"--metrics-port", "0"},
+      {"--metrics-port", "70000"},
+      {"--metrics-port", "9100", "--coordinator", "7700", "--workers", "2"},
+    };
+    
+    for (const auto& extra : invalid) {
+      std::vector<std::string> args = {"program", "--config", "test.yaml"};
+      args.insert(args.end(), extra.begin(), extra.end());
+      ArgvHelper helper(args);
+      
+      REQUIRE_THROWS_AS(
+        parseCommandLine(helper.argc(), helper.argv()),
+        std::runtime_error
+      );
+    }
+  }
+}
+
+TEST_CASE("CLI parser firmware profiling", "[cli_parser]") {
+  
+  SECTION("is off by default") {
+    std::vector<std::string> args = {"program", "--config", "test.yaml"};
+    ArgvHelper helper(args);
+    
+    auto options = parseCommandLine(helper.argc(), helper.argv());
+    REQUIRE(options.profile_top == 0);
+  }
+  
+  SECTION("parses the number of nodes to report") {
+    std::vector<std::string> args = {"program", "--config", "test.yaml", "--profile-firmware", "10"};
+    ArgvHelper helper(args);
+    
+    auto options = parseCommandLine(helper.argc(), helper.argv());
+    REQUIRE(options.profile_top == 10);
+  }
+  
+  SECTION("rejects zero and distributed runs") {
+    std::vector<std::vector<std::string>> invalid = {
+      {"--profile-firmware", "0"},
+      {"--profile-firmware", "5", "--coordinator", "7700", "--workers", "2"},
+    };
+    
+    for (const auto& extra : invalid) {
+      std::vector<std::string> args = {"program", "--config", "test.yaml"};
+      args.insert(args.end(), extra.begin(), extra.end());
+      ArgvHelper helper(args);
+      
+      REQUIRE_THROWS_AS(
+        parseCommandLine(helper.argc(), helper.argv()),
+        std::runtime_error
+      );
+    }
+  }
+}
+
+TEST_CASE("CLI parser update watchdog", "[cli_parser]") {
+  
+  SECTION("is off by default") {
+    std::vector<std::string> args = {"program", "--config", "test.yaml"};
+    ArgvHelper helper(args);
+    
+    auto options = parseCommandLine(helper.argc(), helper.argv());
+    REQUIRE(options.update_budget_us == 0);
+  }
+  
+  SECTION("parses the budget") {
+    std::vector<std::string> args = {"program", "--config", "test.yaml", "--update-budget", "5000"};
+    ArgvHelper helper(args);
+    
+    auto options = parseCommandLine(helper.argc(), helper.argv());
+    REQUIRE(options.update_budget_us == 5000);
+  }
+  
+  SECTION("rejects a zero budget, distributed and batch runs") {
+    std::vector<std::vector<std::string>> invalid = {
+      {"--update-budget", "0"},
+      {"--update-budget", "5000", "--coordinator", "7700", "--workers", "2"},
+      {"--update-budget", "5000", "--ensemble", "10"},
+    };
+    
+    for (const auto& extra : invalid) {
+      std::vector<std::string> args = {"program", "--config", "test.yaml"};
+      args.insert(args.end(), extra.begin(), extra.end());
+      ArgvHelper helper(args);
+      
+      REQUIRE_THROWS_AS(
+        parseCommandLine(helper.argc(), helper.argv()),
+        std::runtime_error
+      );
+    }
+  }
+}
+
+TEST_CASE("CLI parser memory report", "[cli_parser]") {
+  
+  SECTION("is off by default") {
+    std::vector<std::string> args = {"program", "--config", "test.yaml"};
+    ArgvHelper helper(args);
+    
+    REQUIRE_FALSE(parseCommandLine(helper.argc(), helper.argv()).memory_report);
+  }
+  
+  SECTION("parses the flag") {
+    std::vector<std::string> args = {"program", "--config", "test.yaml", "--memory-report"};
+    ArgvHelper helper(args);
+    
+    REQUIRE(parseCommandLine(helper.argc(), helper.argv()).memory_report);
+  }
+  
+  SECTION("rejects distributed and batch runs") {
+    std::vector<std::vector<std::string>> invalid = {
+      {"--memory-report", "--coordinator", "7700", "--workers", "2"},
+      {"--memory-report", "--sweep", "grid.sweep.yaml"},
+    };
+    
+    for (const auto& extra : invalid) {
+      std::vector<std::string> args = {"program", "--config", "test.yaml"};
+      args.insert(args.end(), extra.begin(), extra.end());
+      ArgvHelper helper(args);
+      
+      REQUIRE_THROWS_AS(
+        parseCommandLine(helper.argc(), helper.argv()),
+        std::runtime_error
+      );
+    }
+  }
+}
+
+TEST_CASE("CLI parser state dumps", "[cli_parser]") {
+  
+  SECTION("measures for one second without profiling by default") {
+    std::vector<std::string> args = {"program", "--config", "test.yaml"};
+    ArgvHelper helper(args);
+    
+    auto options = parseCommandLine(helper.argc(), helper.argv());
+    REQUIRE(options.dump_window_ms == 1000);
+    REQUIRE_FALSE(options.dump_profile);
+  }
+  
+  SECTION("parses the window and the profile flag") {
+    std::vector<std::string> args = {"program", "--config", "test.yaml", "--dump-window", "250",
+                                     "--dump-profile"};
+    ArgvHelper helper(args);
+    
+    auto options = parseCommandLine(helper.argc(), helper.argv());
+    REQUIRE(options.dump_window_ms == 250);
+    REQUIRE(options.dump_profile);
+  }
+  
+  SECTION("rejects a profile without a window, distributed and batch runs") {
+    std::vector<std::vector<std::string>> invalid = {
+      {"--dump-profile", "--dump-window", "0"},
+      {"--dump-profile", "--coordinator", "7700", "--workers", "2"},
+      {"--dump-window", "500", "--sweep", "grid.sweep.yaml"},
+    };
+    
+    for (const auto& extra : invalid) {
+      std::vector<std::string> args = {"program", "--config", "test.yaml"};
+      args.insert(args.end(), extra.begin(), extra.end());
+      ArgvHelper helper(args);
+      
+      REQUIRE_THROWS_AS(
+        parseCommandLine(helper.argc(), helper.argv()),
+        std::runtime_error
+      );
+    }
+  }
+}
+
+TEST_CASE("CLI parser tracing", "[cli_parser]") {
+  
+  SECTION("parses the trace file") {
+    std::vector<std::string> args = {"program", "--config", "test.yaml", "--trace", "run.trace.json"};
+    ArgvHelper helper(args);
+    
+    auto options = parseCommandLine(helper.argc(), helper.argv());
+    REQUIRE(options.trace_file == "run.trace.json");
+  }
+  
+  SECTION("rejects distributed and batch runs") {
+    std::vector<std::vector<std::string>> invalid = {
+      {"--trace", "run.json", "--coordinator", "7700", "--workers", "2"},
+      {"--trace", "run.json", "--sweep", "grid.sweep.yaml"},
+    };
+    
+    for (const auto& extra : invalid) {
+      std::vector<std::string> args = {"program", "--config", "test.yaml"};
+      args.insert(args.end(), extra.begin(), extra.end());
+      ArgvHelper helper(args);
+      
+      REQUIRE_THROWS_AS(
+        parseCommandLine(helper.argc(), helper.argv()),
+        std::runtime_error
+      );
+    }
+  }
+}
+
+TEST_CASE("CLI parser parameter sweeps", "[cli_parser]") {
+  
+  SECTION("parses the sweep file and job count") {
+    std::vector<std::string> args = {"program", "--config", "test.yaml", "--sweep", "grid.yaml",
+                                     "--jobs", "4"};
+    ArgvHelper helper(args);
+    
+    auto options = parseCommandLine(helper.argc(), helper.argv());
+    REQUIRE(options.sweep_file == "grid.yaml");
+    REQUIRE(options.jobs);
+    REQUIRE(*options.jobs == 4);
+  }
+  
+  SECTION("rejects jobs without a batch run and sweeps with single-run outputs") {
+    std::vector<std::vector<std::string>> invalid = {
+      {"--jobs", "4"},
+      {"--sweep", "grid.yaml", "--coordinator", "7700", "--workers", "2"},
+      {"--sweep", "grid.yaml", "--checkpoint", "a.ckpt", "--checkpoint-at", "10"},
+      {"--sweep", "grid.yaml", "--capture", "run.pcapng"},
+      {"--sweep", "grid.yaml", "--profile-firmware", "5"},
+      {"--sweep", "grid.yaml", "--ui", "terminal"},
+      {"--coordinator", "7700", "--workers", "2", "--ui", "terminal"},
+    };
+    
+    for (const auto& extra : invalid) {
+      std::vector<std::string> args = {"program", "--config", "test.yaml"};
+      args.insert(args.end(), extra.begin(), extra.end());
+      ArgvHelper helper(args);
+      
+      REQUIRE_THROWS_AS(
+        parseCommandLine(helper.argc(), helper.argv()),
+        std::runtime_error
+      );
+    }
+  }
+}
+
+TEST_CASE("CLI parser seed ensembles", "[cli_parser]") {
+  
+  SECTION("parses the run count, CI width and job count") {
+    std::vector<std::string> args = {"program", "--config", "test.yaml", "--ensemble", "200",
+                                     "--ci-width", "0.01", "-j", "8"};
+    ArgvHelper helper(args);
+    
+    auto options = parseCommandLine(helper.argc(), helper.argv());
+    REQUIRE(options.ensemble_runs == 200);
+    REQUIRE(options.ci_width);
+    REQUIRE(*options.ci_width == 0.01);
+    REQUIRE(options.jobs);
+    REQUIRE(*options.jobs == 8);
+  }
+  
+  SECTION("runs no ensemble by default") {
+    std::vector<std::string> args = {"program", "--config", "test.yaml"};
+    ArgvHelper helper(args);
+    
+    auto options = parseCommandLine(helper.argc(), helper.argv());
+    REQUIRE(options.ensemble_runs == 0);
+    REQUIRE_FALSE(options.ci_width);
+  }
+  
+  SECTION("rejects invalid ensembles") {
+    std::vector<std::vector<std::string>> invalid = {
+      {"--ensemble", "0"},
+      {"--ci-width", "0.01"},
+      {"--ensemble", "10", "--ci-width", "0"},
+      {"--ensemble", "10", "--sweep", "grid.yaml"},
+      {"--ensemble", "10", "--restore", "warm.ckpt"},
+      {"--ensemble", "10", "--metrics-port", "9100"},
+      {"--ensemble", "10", "--ui", "terminal"},
+    };
+    
+    for (const auto& extra : invalid) {
+      std::vector<std::string> args = {"program", "--config", "test.yaml"};
+      args.insert(args.end(), extra.begin(), extra.end());
+      ArgvHelper helper(args);
+      
+      REQUIRE_THROWS_AS(
+        parseCommandLine(helper.argc(), helper.argv()),
+        std::runtime_error
+      );
+    }
+  }
+}
@@ -9,8 +9,10 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include "simulator/config_loader.hpp"
+#include <algorithm>
 #include <fstream>
 #include <sstream>
+#include <unordered_set>
 
 using namespace simulator;
 
@@ -44,6 +46,415 @@ topology:
   REQUIRE(config->nodes[0].mesh_prefix == "TestMesh");
 }
 
+TEST_CASE("ConfigLoader parses unbounded time scale", "[config_loader]") {
+  ConfigLoader loader;
+  
+  SECTION("accepts 'unbounded' keyword") {
+    std::string yaml = R"(
+simulation:
+  name: "Soak"
+  duration: 86400
+  time_scale: unbounded
+
+nodes:
+  - id: "node-1"
+    type: "sensor"
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+  )";
+    
+    auto config = loader.loadFromString(yaml);
+    
+    REQUIRE(config.has_value());
+    REQUIRE(config->simulation.time_scale == 0.0f);
+    REQUIRE(loader.getValidationErrors(*config).empty());
+  }
+  
+  SECTION("rejects negative time scale") {
+    std::string yaml = R"(
+simulation:
+  name: "Soak"
+  time_scale: -2.0
+
+nodes:
+  - id: "node-1"
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+  )";
+    
+    auto config = loader.loadFromString(yaml);
+    
+    REQUIRE(config.has_value());
+    auto errors = loader.getValidationErrors(*config);
+    REQUIRE(errors.size() == 1);
+    REQUIRE(errors[0].field == "simulation.time_scale");
+  }
+}
+
+TEST_CASE("ConfigLoader parses worker threads", "[config_loader]") {
+  ConfigLoader loader;
+  
+  SECTION("defaults to a single thread") {
+    std::string yaml = R"(
+simulation:
+  name: "Threads"
+
+nodes:
+  - id: "node-1"
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+  )";
+    
+    auto config = loader.loadFromString(yaml);
+    
+    REQUIRE(config.has_value());
+    REQUIRE(config->simulation.threads == 1);
+  }
+  
+  SECTION("accepts an explicit thread count") {
+    std::string yaml = R"(
+simulation:
+  name: "Threads"
+  threads: 8
+
+nodes:
+  - id: "node-1"
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+  )";
+    
+    auto config = loader.loadFromString(yaml);
+    
+    REQUIRE(config.has_value());
+    REQUIRE(config->simulation.threads == 8);
+    REQUIRE(loader.getValidationErrors(*config).empty());
+  }
+  
+  SECTION("rejects zero threads") {
+    std::string yaml = R"(
+simulation:
+  name: "Threads"
+  threads: 0
+
+nodes:
+  - id: "node-1"
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+  )";
+    
+    auto config = loader.loadFromString(yaml);
+    
+    REQUIRE(config.has_value());
+    auto errors = loader.getValidationErrors(*config);
+    REQUIRE(errors.size() == 1);
+    REQUIRE(errors[0].field == "simulation.threads");
+  }
+}
+
+TEST_CASE("ConfigLoader parses shard synchronization", "[config_loader]") {
+  ConfigLoader loader;
+  std::string nodes = R"(
+nodes:
+  - id: "node-1"
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+  )";
+  
+  SECTION("defaults to per-tick synchronization") {
+    auto config = loader.loadFromString("simulation:\n  name: \"Sync\"\n" + nodes);
+    
+    REQUIRE(config.has_value());
+    REQUIRE(config->simulation.sync == "tick");
+  }
+  
+  SECTION("accepts lookahead windows") {
+    auto config = loader.loadFromString(
+      "simulation:\n  name: \"Sync\"\n  threads: 4\n  sync: Lookahead\n" + nodes);
+    
+    REQUIRE(config.has_value());
+    REQUIRE(config->simulation.sync == "lookahead");
+    REQUIRE(loader.getValidationErrors(*config).empty());
+  }
+  
+  SECTION("rejects unknown modes") {
+    auto config = loader.loadFromString(
+      "simulation:\n  name: \"Sync\"\n  sync: optimistic\n" + nodes);
+    
+    REQUIRE(config.has_value());
+    auto errors = loader.getValidationErrors(*config);
+    REQUIRE(errors.size() == 1);
+    REQUIRE(errors[0].field == "simulation.sync");
+  }
+}
+
+TEST_CASE("ConfigLoader parses distributed partition strategy", "[config_loader]") {
+  ConfigLoader loader;
+  std::string nodes = R"(
+nodes:
+  - id: "node-1"
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+  )";
+  
+  SECTION("defaults to block partitioning") {
+    auto config = loader.loadFromString("simulation:\n  name: \"Split\"\n" + nodes);
+    
+    REQUIRE(config.has_value());
+    REQUIRE(config->simulation.partition == "block");
+  }
+  
+  SECTION("accepts locality partitioning") {
+    auto config = loader.loadFromString(
+      "simulation:\n  name: \"Split\"\n  partition: Locality\n" + nodes);
+    
+    REQUIRE(config.has_value());
+    REQUIRE(config->simulation.partition == "locality");
+    REQUIRE(loader.getValidationErrors(*config).empty());
+  }
+  
+  SECTION("rejects unknown strategies") {
+    auto config = loader.loadFromString(
+      "simulation:\n  name: \"Split\"\n  partition: random\n" + nodes);
+    
+    REQUIRE(config.has_value());
+    auto errors = loader.getValidationErrors(*config);
+    REQUIRE(errors.size() == 1);
+    REQUIRE(errors[0].field == "simulation.partition");
+  }
+}
+
+TEST_CASE("ConfigLoader parses lazy node construction", "[config_loader]") {
+  ConfigLoader loader;
+  std::string nodes = R"(
+nodes:
+  - id: "node-1"
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+  )";
+  
+  auto eager = loader.loadFromString("simulation:\n  name: \"Lazy\"\n" + nodes);
+  REQUIRE(eager.has_value());
+  REQUIRE_FALSE(eager->simulation.lazy_nodes);
+  
+  auto lazy = loader.loadFromString("simulation:\n  name: \"Lazy\"\n  lazy_nodes: true\n" + nodes);
+  REQUIRE(lazy.has_value());
+  REQUIRE(lazy->simulation.lazy_nodes);
+}
+
+TEST_CASE("ConfigLoader parses and checks the node engine", "[config_loader]") {
+  ConfigLoader loader;
+  std::string nodes = R"(
+network:
+  transport: in_process
+nodes:
+  - id: "node-1"
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+  )";
+  
+  auto mesh = loader.loadFromString("simulation:\n  name: \"Engine\"\n" + nodes);
+  REQUIRE(mesh.has_value());
+  REQUIRE(mesh->simulation.node_engine == "mesh");
+  
+  auto fluid = loader.loadFromString("simulation:\n  name: \"Engine\"\n  node_engine: Fluid\n" + nodes);
+  REQUIRE(fluid.has_value());
+  REQUIRE(fluid->simulation.node_engine == "fluid");
+  REQUIRE(loader.getValidationErrors(*fluid).empty());
+  
+  SECTION("unknown engines are rejected") {
+    ScenarioConfig config = *mesh;
+    config.simulation.node_engine = "ns3";
+    auto errors = loader.getValidationErrors(config);
+    REQUIRE(errors.size() == 1);
+    REQUIRE(errors[0].field == "simulation.node_engine");
+  }
+  
+  SECTION("fluid nodes need the in-process transport") {
+    ScenarioConfig tcp = *fluid;
+    tcp.network.transport = "tcp";
+    auto errors = loader.getValidationErrors(tcp);
+    REQUIRE(errors.size() == 1);
+    REQUIRE(errors[0].message == "Fluid nodes need the in-process transport");
+  }
+}
+
+TEST_CASE("ConfigLoader parses the firmware clock", "[config_loader]") {
+  ConfigLoader loader;
+  std::string nodes = R"(
+nodes:
+  - id: "node-1"
+    clock: {offset_ms: 1500, drift_ppm: -20}
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+  - template: "sensor"
+    count: 2
+    clock:
+      drift_ppm: 75.5
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+  )";
+  
+  auto wall = loader.loadFromString("simulation:\n  name: \"Clock\"\n" + nodes);
+  REQUIRE(wall.has_value());
+  REQUIRE(wall->simulation.firmware_clock == "wall");
+  REQUIRE(wall->nodes[0].clock_offset_ms == 1500);
+  REQUIRE(wall->nodes[0].clock_drift_ppm == -20.0);
+  REQUIRE(wall->templates.size() == 1);
+  REQUIRE(wall->templates[0].base_config.clock_offset_ms == 0);
+  REQUIRE(wall->templates[0].base_config.clock_drift_ppm == 75.5);
+  
+  auto fast = loader.loadFromString("simulation:\n  name: \"Clock\"\n  firmware_clock: Virtual\n" + nodes);
+  REQUIRE(fast.has_value());
+  REQUIRE(fast->simulation.firmware_clock == "virtual");
+  REQUIRE(loader.getValidationErrors(*fast).empty());
+  
+  SECTION("unknown clocks are rejected") {
+    auto config = loader.loadFromString("simulation:\n  name: \"Clock\"\n  firmware_clock: gps\n" + nodes);
+    REQUIRE(config.has_value());
+    auto errors = loader.getValidationErrors(*config);
+    REQUIRE(errors.size() == 1);
+    REQUIRE(errors[0].field == "simulation.firmware_clock");
+  }
+  
+  SECTION("drift beyond 10% is rejected") {
+    ScenarioConfig config = *wall;
+    config.nodes[0].clock_drift_ppm = 250000.0;
+    auto errors = loader.getValidationErrors(config);
+    REQUIRE(errors.size() == 1);
+    REQUIRE(errors[0].field == "node.clock.drift_ppm");
+  }
+}
+
+TEST_CASE("ConfigLoader parses and checks the adaptive tick", "[config_loader]") {
+  ConfigLoader loader;
+  std::string nodes = R"(
+network:
+  transport: in_process
+nodes:
+  - id: "node-1"
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+  )";
+
+  auto fixed = loader.loadFromString("simulation:\n  name: \"Tick\"\n" + nodes);
+  REQUIRE(fixed.has_value());
+  REQUIRE(fixed->simulation.max_tick_ms == 10);
+  REQUIRE(loader.getValidationErrors(*fixed).empty());
+
+  auto adaptive = loader.loadFromString(
+    "simulation:\n  name: \"Tick\"\n  firmware_clock: virtual\n  max_tick_ms: 1000\n" + nodes);
+  REQUIRE(adaptive.has_value());
+  REQUIRE(adaptive->simulation.max_tick_ms == 1000);
+  REQUIRE(loader.getValidationErrors(*adaptive).empty());
+
+  SECTION("ticks below one fixed tick or above a minute are rejected") {
+    for (uint32_t max_tick_ms : {5u, 60001u}) {
+      ScenarioConfig config = *adaptive;
+      config.simulation.max_tick_ms = max_tick_ms;
+      auto errors = loader.getValidationErrors(config);
+      REQUIRE(errors.size() == 1);
+      REQUIRE(errors[0].field == "simulation.max_tick_ms");
+    }
+  }
+
+  SECTION("adaptive ticks need the virtual clock and in-process transport") {
+    ScenarioConfig wall = *adaptive;
+    wall.simulation.firmware_clock = "wall";
+    auto errors = loader.getValidationErrors(wall);
+    REQUIRE(errors.size() == 1);
+    REQUIRE(errors[0].message == "Adaptive ticks need the virtual firmware clock");
+
+    ScenarioConfig tcp = *adaptive;
+    tcp.network.transport = "tcp";
+    errors = loader.getValidationErrors(tcp);
+    REQUIRE(errors.size() == 1);
+    REQUIRE(errors[0].message == "Adaptive ticks need the in-process transport");
+  }
+}
+
+TEST_CASE("ConfigLoader parses and checks the shared medium", "[config_loader]") {
+  ConfigLoader loader;
+  auto config = loader.loadFromString(R"(
+simulation:
+  name: "Airtime"
+network:
+  transport: in_process
+  airtime:
+    bitrate_bps: 6500000
+    contention_window: 32
+nodes:
+  - id: "node-1"
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+  )");
+  REQUIRE(config.has_value());
+  REQUIRE(config->network.airtime.bitrate_bps == 6500000);
+  REQUIRE(config->network.airtime.contention_window == 32);
+  REQUIRE(config->network.airtime.frame_overhead_us == 150);
+  REQUIRE(config->network.airtime.max_wait_ms == 100);
+  REQUIRE(loader.getValidationErrors(*config).empty());
+
+  SECTION("an empty contention window is rejected") {
+    ScenarioConfig invalid = *config;
+    invalid.network.airtime.contention_window = 0;
+    auto errors = loader.getValidationErrors(invalid);
+    REQUIRE(errors.size() == 1);
+    REQUIRE(errors[0].field == "network.airtime.contention_window");
+  }
+
+  SECTION("contention needs the in-process transport") {
+    ScenarioConfig tcp = *config;
+    tcp.network.transport = "tcp";
+    auto errors = loader.getValidationErrors(tcp);
+    REQUIRE(errors.size() == 1);
+    REQUIRE(errors[0].message == "Airtime contention needs the in-process transport");
+  }
+}
+
+TEST_CASE("ConfigLoader parses and checks the node cap", "[config_loader]") {
+  ConfigLoader loader;
+  std::string nodes = R"(
+nodes:
+  - id: "node-1"
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+  - id: "node-2"
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+  )";
+
+  auto defaults = loader.loadFromString("simulation:\n  name: \"Cap\"\n" + nodes);
+  REQUIRE(defaults.has_value());
+  REQUIRE(defaults->simulation.max_nodes == 1000);
+  REQUIRE(loader.getValidationErrors(*defaults).empty());
+
+  auto small = loader.loadFromString("simulation:\n  name: \"Cap\"\n  max_nodes: 1\n" + nodes);
+  REQUIRE(small.has_value());
+  REQUIRE(small->simulation.max_nodes == 1);
+  auto errors = loader.getValidationErrors(*small);
+  REQUIRE(errors.size() == 1);
+  REQUIRE(errors[0].field == "simulation.max_nodes");
+
+  auto zero = loader.loadFromString("simulation:\n  name: \"Cap\"\n  max_nodes: 0\n" + nodes);
+  REQUIRE(zero.has_value());
+  REQUIRE_FALSE(loader.getValidationErrors(*zero).empty());
+}
+
 TEST_CASE("ConfigLoader validates required fields", "[config_loader]") {
   SECTION("missing simulation name") {
     std::string yaml = R"(
@@ -75,124 +486,394 @@ nodes:
   - id: "node-1"
     config:
       mesh_password: "password"
-    )";
+    )";
+    
+    ConfigLoader loader;
+    auto config = loader.loadFromString(yaml);
+    
+    REQUIRE(config.has_value());
+    auto errors = loader.getValidationErrors(*config);
+    
+    bool has_prefix_error = false;
+    for (const auto& err : errors) {
+      if (err.field.find("mesh_prefix") != std::string::npos) {
+        has_prefix_error = true;
+        break;
+      }
+    }
+    REQUIRE(has_prefix_error);
+  }
+  
+  SECTION("missing mesh_password") {
+    std::string yaml = R"(
+simulation:
+  name: "Test"
+  duration: 60
+
+nodes:
+  - id: "node-1"
+    config:
+      mesh_prefix: "TestMesh"
+    )";
+    
+    ConfigLoader loader;
+    auto config = loader.loadFromString(yaml);
+    
+    REQUIRE(config.has_value());
+    auto errors = loader.getValidationErrors(*config);
+    
+    bool has_password_error = false;
+    for (const auto& err : errors) {
+      if (err.field.find("mesh_password") != std::string::npos) {
+        has_password_error = true;
+        break;
+      }
+    }
+    REQUIRE(has_password_error);
+  }
+}
+
+TEST_CASE("ConfigLoader expands node templates", "[config_loader]") {
+  std::string yaml = R"(
+simulation:
+  name: "Template Test"
+  duration: 60
+
+nodes:
+  - template: "sensor"
+    count: 5
+    id_prefix: "sensor-"
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+
+topology:
+  type: "random"
+  )";
+  
+  ConfigLoader loader;
+  auto config = loader.loadFromString(yaml);
+  
+  REQUIRE(config.has_value());
+  REQUIRE(config->templates.size() == 1);
+  
+  // Expand templates
+  loader.expandTemplates(*config);
+  
+  REQUIRE(config->nodes.size() == 5);
+  REQUIRE(config->nodes[0].id == "sensor-0");
+  REQUIRE(config->nodes[1].id == "sensor-1");
+  REQUIRE(config->nodes[4].id == "sensor-4");
+  
+  for (const auto& node : config->nodes) {
+    REQUIRE(node.mesh_prefix == "TestMesh");
+    REQUIRE(node.mesh_password == "password");
+  }
+}
+
+TEST_CASE("ConfigLoader expands large templates", "[config_loader]") {
+  std::string yaml = R"(
+simulation:
+  name: "Large Template Test"
+  duration: 60
+  threads: 4
+  max_nodes: 30000
+
+nodes:
+  - id: "gateway"
+    firmware: "simple_broadcast"
+  - template: "sensor"
+    count: 20000
+    id_prefix: "sensor-"
+    config:
+      mesh_prefix: "TestMesh"
+      broadcast_interval: "1000"
+  - template: "spare"
+    count: 0
+    id_prefix: "spare-"
+  - template: "relay"
+    count: 5000
+    id_prefix: "relay-"
+
+topology:
+  type: "star"
+  hub: "gateway"
+  )";
+  
+  ConfigLoader loader;
+  auto config = loader.loadFromString(yaml);
+  REQUIRE(config.has_value());
+  
+  std::ostringstream log;
+  SECTION("nodes are generated in order, quietly by default") {
+    REQUIRE(loader.expandTemplates(*config) == 25000);
+    REQUIRE(config->nodes.size() == 25001);
+    REQUIRE(config->nodes[0].id == "gateway");
+    REQUIRE(config->nodes[1].id == "sensor-0");
+    REQUIRE(config->nodes[20000].id == "sensor-19999");
+    REQUIRE(config->nodes[20001].id == "relay-0");
+    REQUIRE(config->nodes[25000].id == "relay-4999");
+    REQUIRE(config->nodes[12345].nodeId == loader.generateNodeId(config->nodes[12345].id));
+    
+    // Template nodes share one firmware configuration
+    REQUIRE(config->nodes[1].firmwareConfig);
+    REQUIRE(config->nodes[1].firmwareConfig->at("broadcast_interval") == "1000");
+    REQUIRE(config->nodes[1].firmwareConfig == config->nodes[20000].firmwareConfig);
+    REQUIRE_FALSE(config->nodes[20001].firmwareConfig);
+  }
+  
+  SECTION("expansion logs to the configured stream") {
+    config->templates.resize(1);
+    config->templates[0].count = 2;
+    loader.setLogStream(&log);
+    loader.expandTemplates(*config);
+    REQUIRE(log.str().find("sensor-1 -> ") != std::string::npos);
+    REQUIRE(log.str().find("2 nodes generated, 3 in total") != std::string::npos);
+  }
+  
+  SECTION("generated IDs colliding with defined nodes are reported") {
+    config->nodes[0].id = "relay-17";
+    config->nodes[0].nodeId = loader.generateNodeId("relay-17");
+    loader.expandTemplates(*config);
+    
+    auto errors = loader.getValidationErrors(*config);
+    REQUIRE(std::count_if(errors.begin(), errors.end(), [](const ValidationError& err) {
+      return err.message == "Duplicate node ID: relay-17";
+    }) == 1);
+  }
+  
+  SECTION("generated IDs taken by an earlier node are rehashed") {
+    // Defined nodes claim sensor-3's ID and its first rehash
+    config->nodes[0].nodeId = ConfigLoader::generateNodeId("sensor-3");
+    NodeConfigExtended taken = config->nodes[0];
+    taken.id = "taken";
+    taken.nodeId = ConfigLoader::generateNodeId("sensor-3", 1);
+    config->nodes.push_back(taken);
+    loader.expandTemplates(*config);
+    
+    REQUIRE(config->nodes[5].id == "sensor-3");
+    REQUIRE(config->nodes[5].nodeId == ConfigLoader::generateNodeId("sensor-3", 2));
+    REQUIRE(config->nodes[6].nodeId == ConfigLoader::generateNodeId("sensor-4"));
+    auto errors = loader.getValidationErrors(*config);
+    REQUIRE(std::none_of(errors.begin(), errors.end(), [](const ValidationError& err) {
+      return err.message.find("numeric ID") != std::string::npos;
+    }));
+  }
+  
+  SECTION("IDs hashing to the same numeric ID are reported") {
+    loader.expandTemplates(*config);
+    config->nodes[2].nodeId = config->nodes[1].nodeId;
+    
+    auto errors = loader.getValidationErrors(*config);
+    REQUIRE(std::any_of(errors.begin(), errors.end(), [](const ValidationError& err) {
+      return err.message.find("sensor-0 and sensor-1 map to the same numeric ID") != std::string::npos;
+    }));
+  }
+}
+
+TEST_CASE("ConfigLoader generates stable numeric node IDs", "[config_loader]") {
+  // FNV-1a values, identical with every standard library
+  REQUIRE(ConfigLoader::generateNodeId("gateway") == 1741308409u);
+  REQUIRE(ConfigLoader::generateNodeId("sensor-0") == 2085432342u);
+  REQUIRE(ConfigLoader::generateNodeId("sensor-0", 0) == 2085432342u);
+  REQUIRE(ConfigLoader::generateNodeId("sensor-0", 1) != 2085432342u);
+  REQUIRE(ConfigLoader::generateNodeId("sensor-0", 1) == ConfigLoader::generateNodeId("sensor-0", 1));
+  REQUIRE(ConfigLoader::generateNodeId("") <= 0x7FFFFFFFu);
+  
+  SECTION("100k generated nodes get unique IDs whatever the thread count") {
+    ScenarioConfig config;
+    NodeTemplate tmpl;
+    tmpl.template_name = "sensor";
+    tmpl.id_prefix = "sensor-";
+    tmpl.count = 100000;
+    tmpl.base_config.firmware = "simple_broadcast";
+    config.templates.push_back(tmpl);
+    
+    ConfigLoader loader;
+    ScenarioConfig parallel = config;
+    parallel.simulation.threads = 4;
+    loader.expandTemplates(config);
+    loader.expandTemplates(parallel);
+    
+    std::unordered_set<uint32_t> ids;
+    for (size_t i = 0; i < config.nodes.size(); ++i) {
+      REQUIRE(config.nodes[i].nodeId != 0);
+      REQUIRE(config.nodes[i].nodeId == parallel.nodes[i].nodeId);
+      ids.insert(config.nodes[i].nodeId);
+    }
+    REQUIRE(ids.size() == 100000);
+  }
+}
+
+TEST_CASE("ConfigLoader parses network configuration", "[config_loader]") {
+  std::string yaml = R"(
+simulation:
+  name: "Network Test"
+  duration: 60
+
+network:
+  latency:
+    min: 20
+    max: 100
+    distribution: "normal"
+  packet_loss: 0.05
+  bandwidth: 2000000
+
+nodes:
+  - id: "node-1"
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+
+topology:
+  type: "random"
+  )";
+  
+  ConfigLoader loader;
+  auto config = loader.loadFromString(yaml);
+  
+  REQUIRE(config.has_value());
+  REQUIRE(config->network.default_latency.min_ms == 20);
+  REQUIRE(config->network.default_latency.max_ms == 100);
+  REQUIRE(config->network.default_latency.distribution == DistributionType::NORMAL);
+  REQUIRE(config->network.packet_loss == 0.05f);
+  REQUIRE(config->network.bandwidth == 2000000);
+}
+
+TEST_CASE("ConfigLoader parses network transport", "[config_loader]") {
+  ConfigLoader loader;
+  
+  SECTION("defaults to tcp") {
+    std::string yaml = R"(
+simulation:
+  name: "Transport Test"
+
+nodes:
+  - id: "node-1"
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+  )";
+    
+    auto config = loader.loadFromString(yaml);
+    
+    REQUIRE(config.has_value());
+    REQUIRE(config->network.transport == "tcp");
+  }
+  
+  SECTION("accepts in_process") {
+    std::string yaml = R"(
+simulation:
+  name: "Transport Test"
+
+network:
+  transport: in_process
+
+nodes:
+  - id: "node-1"
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+  )";
+    
+    auto config = loader.loadFromString(yaml);
+    
+    REQUIRE(config.has_value());
+    REQUIRE(config->network.transport == "in_process");
+    REQUIRE(loader.getValidationErrors(*config).empty());
+  }
+  
+  SECTION("rejects unknown transport") {
+    std::string yaml = R"(
+simulation:
+  name: "Transport Test"
+
+network:
+  transport: carrier_pigeon
+
+nodes:
+  - id: "node-1"
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+  )";
     
-    ConfigLoader loader;
     auto config = loader.loadFromString(yaml);
     
     REQUIRE(config.has_value());
     auto errors = loader.getValidationErrors(*config);
-    
-    bool has_prefix_error = false;
-    for (const auto& err : errors) {
-      if (err.field.find("mesh_prefix") != std::string::npos) {
-        has_prefix_error = true;
-        break;
-      }
-    }
-    REQUIRE(has_prefix_error);
+    REQUIRE(errors.size() == 1);
+    REQUIRE(errors[0].field == "network.transport");
   }
+}
+
+TEST_CASE("ConfigLoader parses delivery queue backend", "[config_loader]") {
+  ConfigLoader loader;
   
-  SECTION("missing mesh_password") {
+  SECTION("defaults to heap") {
     std::string yaml = R"(
 simulation:
-  name: "Test"
-  duration: 60
+  name: "Queue Test"
 
 nodes:
   - id: "node-1"
     config:
       mesh_prefix: "TestMesh"
-    )";
+      mesh_password: "password"
+  )";
     
-    ConfigLoader loader;
     auto config = loader.loadFromString(yaml);
     
     REQUIRE(config.has_value());
-    auto errors = loader.getValidationErrors(*config);
-    
-    bool has_password_error = false;
-    for (const auto& err : errors) {
-      if (err.field.find("mesh_password") != std::string::npos) {
-        has_password_error = true;
-        break;
-      }
-    }
-    REQUIRE(has_password_error);
+    REQUIRE(config->network.delivery_queue == "heap");
+    REQUIRE_FALSE(config->network.coalesce);
   }
-}
-
-TEST_CASE("ConfigLoader expands node templates", "[config_loader]") {
-  std::string yaml = R"(
+  
+  SECTION("parses coalescing") {
+    std::string yaml = R"(
 simulation:
-  name: "Template Test"
-  duration: 60
+  name: "Queue Test"
+
+network:
+  delivery_queue: timing_wheel
+  coalesce: true
 
 nodes:
-  - template: "sensor"
-    count: 5
-    id_prefix: "sensor-"
+  - id: "node-1"
     config:
       mesh_prefix: "TestMesh"
       mesh_password: "password"
-
-topology:
-  type: "random"
   )";
-  
-  ConfigLoader loader;
-  auto config = loader.loadFromString(yaml);
-  
-  REQUIRE(config.has_value());
-  REQUIRE(config->templates.size() == 1);
-  
-  // Expand templates
-  loader.expandTemplates(*config);
-  
-  REQUIRE(config->nodes.size() == 5);
-  REQUIRE(config->nodes[0].id == "sensor-0");
-  REQUIRE(config->nodes[1].id == "sensor-1");
-  REQUIRE(config->nodes[4].id == "sensor-4");
-  
-  for (const auto& node : config->nodes) {
-    REQUIRE(node.mesh_prefix == "TestMesh");
-    REQUIRE(node.mesh_password == "password");
+    
+    auto config = loader.loadFromString(yaml);
+    
+    REQUIRE(config.has_value());
+    REQUIRE(config->network.delivery_queue == "timing_wheel");
+    REQUIRE(config->network.coalesce);
   }
-}
-
-TEST_CASE("ConfigLoader parses network configuration", "[config_loader]") {
-  std::string yaml = R"(
+  
+  SECTION("rejects unknown backend") {
+    std::string yaml = R"(
 simulation:
-  name: "Network Test"
-  duration: 60
+  name: "Queue Test"
 
 network:
-  latency:
-    min: 20
-    max: 100
-    distribution: "normal"
-  packet_loss: 0.05
-  bandwidth: 2000000
+  delivery_queue: fifo
 
 nodes:
   - id: "node-1"
     config:
       mesh_prefix: "TestMesh"
       mesh_password: "password"
-
-topology:
-  type: "random"
   )";
-  
-  ConfigLoader loader;
-  auto config = loader.loadFromString(yaml);
-  
-  REQUIRE(config.has_value());
-  REQUIRE(config->network.default_latency.min_ms == 20);
-  REQUIRE(config->network.default_latency.max_ms == 100);
-  REQUIRE(config->network.default_latency.distribution == DistributionType::NORMAL);
-  REQUIRE(config->network.packet_loss == 0.05f);
-  REQUIRE(config->network.bandwidth == 2000000);
+    
+    auto config = loader.loadFromString(yaml);
+    
+    REQUIRE(config.has_value());
+    auto errors = loader.getValidationErrors(*config);
+    REQUIRE(errors.size() == 1);
+    REQUIRE(errors[0].field == "network.delivery_queue");
+  }
 }
 
 TEST_CASE("ConfigLoader parses specific connection latencies", "[config_loader]") {
@@ -484,6 +1165,63 @@ topology:
   }
 }
 
+TEST_CASE("ConfigLoader parses radio topology", "[config_loader]") {
+  std::string yaml = R"(
+simulation:
+  name: "Radio Test"
+  duration: 60
+
+network:
+  transport: in_process
+
+nodes:
+  - id: "node-1"
+    position: [0, 0]
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+  - id: "node-2"
+    position: [120, 40]
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+
+topology:
+  type: "radio"
+  radio:
+    tx_power_dbm: 17
+    path_loss_exponent: 3.5
+    edge_jitter_ms: 30
+    )";
+  
+  ConfigLoader loader;
+  auto config = loader.loadFromString(yaml);
+  
+  REQUIRE(config.has_value());
+  REQUIRE(config->topology.type == TopologyType::RADIO);
+  REQUIRE(config->topology.radio.tx_power_dbm == 17.0);
+  REQUIRE(config->topology.radio.path_loss_exponent == 3.5);
+  REQUIRE(config->topology.radio.edge_jitter_ms == 30);
+  REQUIRE(config->topology.radio.sensitivity_dbm == -90.0);  // Default kept
+  REQUIRE(config->nodes[1].position == std::vector<int>{120, 40});
+  REQUIRE(loader.getValidationErrors(*config).empty());
+  
+  SECTION("needs positions and the in-process transport") {
+    config->nodes[1].position.clear();
+    config->network.transport = "tcp";
+    auto errors = loader.getValidationErrors(*config);
+    
+    bool has_position_error = false;
+    bool has_transport_error = false;
+    for (const auto& err : errors) {
+      has_position_error |= err.field == "nodes.node-2.position";
+      has_transport_error |= err.field == "topology.type";
+    }
+    REQUIRE(has_position_error);
+    REQUIRE(has_transport_error);
+  }
+}
+
 TEST_CASE("ConfigLoader parses events", "[config_loader]") {
   std::string yaml = R"(
 simulation:
@@ -523,6 +1261,255 @@ events:
   REQUIRE(config->events[1].action == EventAction::START_NODE);
 }
 
+TEST_CASE("ConfigLoader parses millisecond event times", "[config_loader]") {
+  std::string yaml = R"(
+simulation:
+  name: "Test"
+  duration: 10
+
+nodes:
+  - id: "node-1"
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+
+events:
+  - time_ms: 2500
+    action: "crash_node"
+    target: "node-1"
+  - time_ms: 10500
+    action: "start_node"
+    target: "node-1"
+  )";
+  
+  ConfigLoader loader;
+  auto config = loader.loadFromString(yaml);
+  
+  REQUIRE(config.has_value());
+  REQUIRE(config->events[0].time_ms == 2500);
+  REQUIRE(config->events[0].time == 2);
+  
+  // 10.5 s lies past the 10 s duration even though it truncates to 10 s
+  auto errors = loader.getValidationErrors(*config);
+  size_t time_errors = 0;
+  for (const auto& err : errors) {
+    if (err.field == "event.time") {
+      ++time_errors;
+    }
+  }
+  REQUIRE(time_errors == 1);
+}
+
+TEST_CASE("ConfigLoader parses churn sources", "[config_loader][churn]") {
+  std::string yaml = R"(
+simulation:
+  name: "Churn Test"
+  duration: 600
+
+nodes:
+  - id: "node-1"
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+  - id: "node-2"
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+
+churn:
+  - targets: ["node-1"]
+    start: 30
+    failure: {distribution: weibull, mean: 3600, shape: 1.5}
+    repair: {distribution: exponential, mean: 120}
+  - type: link
+    links: [["node-1", "node-2"]]
+    failure: {mean: 300}
+    repair: {distribution: fixed, mean: 10}
+  )";
+  
+  ConfigLoader loader;
+  auto config = loader.loadFromString(yaml);
+  
+  REQUIRE(config.has_value());
+  REQUIRE(config->churn.size() == 2);
+  REQUIRE(config->churn[0].type == "node");
+  REQUIRE(config->churn[0].targets == std::vector<std::string>{"node-1"});
+  REQUIRE(config->churn[0].start == 30);
+  REQUIRE(config->churn[0].failure.distribution == "weibull");
+  REQUIRE(config->churn[0].failure.shape == 1.5);
+  REQUIRE(config->churn[0].repair.mean == 120.0);
+  REQUIRE(config->churn[1].type == "link");
+  REQUIRE(config->churn[1].links.size() == 1);
+  REQUIRE(config->churn[1].links[0].second == "node-2");
+  REQUIRE(config->churn[1].failure.distribution == "exponential");
+  REQUIRE(loader.getValidationErrors(*config).empty());
+  
+  SECTION("rejects bad churn parameters") {
+    config->churn[0].repair.mean = 0.0;
+    config->churn[1].links[0].second = "node-9";
+    config->churn[1].repair.distribution = "gamma";
+    
+    auto errors = loader.getValidationErrors(*config);
+    auto has = [&errors](const std::string& field) {
+      for (const auto& err : errors) {
+        if (err.field == field) {
+          return true;
+        }
+      }
+      return false;
+    };
+    REQUIRE(has("churn.repair.mean"));
+    REQUIRE(has("churn.targets"));
+    REQUIRE(has("churn.repair.distribution"));
+  }
+}
+
+TEST_CASE("ConfigLoader parses traffic streams", "[config_loader][traffic]") {
+  std::string yaml = R"(
+simulation:
+  name: "Traffic Test"
+  duration: 60
+
+network:
+  transport: in_process
+
+nodes:
+  - id: "node-1"
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+  - id: "node-2"
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+
+traffic:
+  - sink: "node-1"
+    rate: 20
+    size: 200
+    start: 5
+    stop: 30
+  - pattern: all_to_all
+    arrival: poisson
+    sources: ["node-2"]
+    rate: 0.5
+  )";
+  
+  ConfigLoader loader;
+  auto config = loader.loadFromString(yaml);
+  
+  REQUIRE(config.has_value());
+  REQUIRE(config->traffic.size() == 2);
+  REQUIRE(config->traffic[0].pattern == "all_to_sink");
+  REQUIRE(config->traffic[0].arrival == "constant");
+  REQUIRE(config->traffic[0].sink == "node-1");
+  REQUIRE(config->traffic[0].sources.empty());
+  REQUIRE(config->traffic[0].rate == 20.0);
+  REQUIRE(config->traffic[0].size == 200);
+  REQUIRE(config->traffic[0].start == 5);
+  REQUIRE(config->traffic[0].stop == 30);
+  REQUIRE(config->traffic[1].pattern == "all_to_all");
+  REQUIRE(config->traffic[1].arrival == "poisson");
+  REQUIRE(config->traffic[1].sources == std::vector<std::string>{"node-2"});
+  REQUIRE(config->traffic[1].burst == 10);
+  REQUIRE(config->traffic[1].stop == 0);
+  REQUIRE(loader.getValidationErrors(*config).empty());
+  
+  SECTION("rejects bad traffic parameters") {
+    config->network.transport = "tcp";
+    config->traffic[0].sink = "node-9";
+    config->traffic[0].stop = 5;
+    config->traffic[1].arrival = "uniform";
+    config->traffic[1].rate = 0.0;
+    config->traffic[1].size = 4;
+    
+    auto errors = loader.getValidationErrors(*config);
+    auto has = [&errors](const std::string& field) {
+      for (const auto& err : errors) {
+        if (err.field == field) {
+          return true;
+        }
+      }
+      return false;
+    };
+    REQUIRE(has("traffic"));
+    REQUIRE(has("traffic.sink"));
+    REQUIRE(has("traffic.stop"));
+    REQUIRE(has("traffic.arrival"));
+    REQUIRE(has("traffic.rate"));
+    REQUIRE(has("traffic.size"));
+  }
+}
+
+TEST_CASE("ConfigLoader parses the gateway", "[config_loader][gateway]") {
+  std::string yaml = R"(
+simulation:
+  name: "Gateway Test"
+  duration: 60
+
+network:
+  transport: in_process
+
+nodes:
+  - id: "bridge-1"
+    type: bridge
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+  - id: "node-2"
+    config:
+      mesh_prefix: "TestMesh"
+      mesh_password: "password"
+
+gateway:
+  listen: "0.0.0.0:7000"
+  backend: "127.0.0.1:7001"
+  max_datagram: 9000
+  broadcasts: true
+  )";
+  
+  ConfigLoader loader;
+  auto config = loader.loadFromString(yaml);
+  
+  REQUIRE(config.has_value());
+  REQUIRE(config->gateway.isEnabled());
+  REQUIRE(config->gateway.listen == "0.0.0.0:7000");
+  REQUIRE(config->gateway.backend == "127.0.0.1:7001");
+  REQUIRE(config->gateway.nodes.empty());
+  REQUIRE(config->gateway.max_datagram == 9000);
+  REQUIRE(config->gateway.broadcasts);
+  REQUIRE(loader.getValidationErrors(*config).empty());
+  
+  SECTION("rejects bad gateway parameters") {
+    config->network.transport = "tcp";
+    config->gateway.backend = "backend:7001";
+    config->gateway.max_datagram = 12;
+    config->gateway.nodes = {"node-9"};
+    
+    auto errors = loader.getValidationErrors(*config);
+    auto has = [&errors](const std::string& field) {
+      for (const auto& err : errors) {
+        if (err.field == field) {
+          return true;
+        }
+      }
+      return false;
+    };
+    REQUIRE(has("gateway"));
+    REQUIRE(has("gateway.backend"));
+    REQUIRE(has("gateway.max_datagram"));
+    REQUIRE(has("gateway.nodes"));
+    REQUIRE_FALSE(has("gateway.listen"));
+  }
+  
+  SECTION("needs a bridge when no nodes are listed") {
+    config->nodes[0].type = "sensor";
+    auto errors = loader.getValidationErrors(*config);
+    REQUIRE(errors.size() == 1);
+    REQUIRE(errors[0].field == "gateway.nodes");
+  }
+}
+
 TEST_CASE("ConfigLoader validates event timing", "[config_loader]") {
   std::string yaml = R"(
 simulation:
@@ -593,6 +1580,18 @@ metrics:
   REQUIRE(config->metrics.collect[0] == "message_count");
   REQUIRE(config->metrics.export_formats.size() == 2);
   REQUIRE(config->metrics.export_formats[0] == "csv");
+  
+  SECTION("unknown formats and a zero interval are reported") {
+    config->metrics.interval = 0;
+    config->metrics.export_formats.push_back("xml");
+    
+    auto errors = loader.getValidationErrors(*config);
+    for (const char* field : {"metrics.interval", "metrics.export"}) {
+      REQUIRE(std::count_if(errors.begin(), errors.end(), [field](const ValidationError& err) {
+        return err.field == field;
+      }) == 1);
+    }
+  }
 }
 
 TEST_CASE("ConfigLoader detects duplicate node IDs", "[config_loader]") {
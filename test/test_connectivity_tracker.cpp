@@ -0,0 +1,225 @@
+/**
+ * @file test_connectivity_tracker.cpp
+ * @brief Unit tests for ConnectivityTracker
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/connectivity_tracker.hpp"
+#include "simulator/mesh_transport.hpp"
+#include "simulator/network_simulator.hpp"
+#include "simulator/node_manager.hpp"
+
+#include <boost/asio.hpp>
+#include <deque>
+#include <map>
+#include <random>
+#include <set>
+
+using namespace simulator;
+
+namespace {
+
+/**
+ * @brief Network, transport and tracker with nodes started by hand
+ */
+struct TrackerFixture {
+  boost::asio::io_context io;
+  NodeManager manager{io};
+  NetworkSimulator network{1};
+  MeshTransport transport{network};
+  ConnectivityTracker tracker{network, transport};
+  std::set<uint32_t> running;
+
+  TrackerFixture() {
+    tracker.reset(manager);
+    transport.setTopologyListener(&tracker);
+    network.setTopologyListener(&tracker);
+  }
+
+  void start(uint32_t node) {
+    running.insert(node);
+    tracker.nodeChanged(node, NodeTransition::START);
+  }
+
+  void stop(uint32_t node) {
+    running.erase(node);
+    tracker.nodeChanged(node, NodeTransition::STOP);
+  }
+
+  /// Components by breadth-first search, named by their smallest node
+  std::map<uint32_t, uint32_t> search() const {
+    std::map<uint32_t, uint32_t> component;
+    for (uint32_t root : running) {
+      if (component.count(root)) {
+        continue;
+      }
+      std::deque<uint32_t> queue{root};
+      component[root] = root;
+      while (!queue.empty()) {
+        const uint32_t node = queue.front();
+        queue.pop_front();
+        for (uint32_t next : transport.getNeighbours(node)) {
+          if (running.count(next) && !component.count(next) &&
+              network.isConnectionActive(node, next) && network.isConnectionActive(next, node)) {
+            component[next] = root;
+            queue.push_back(next);
+          }
+        }
+      }
+    }
+    return component;
+  }
+};
+
+/// Counts the changes passed on by the tracker
+struct CountingListener : TopologyListener {
+  int changes = 0;
+  void linkChanged(uint32_t, uint32_t, bool) override { ++changes; }
+  void connectionChanged(uint32_t, uint32_t, bool) override { ++changes; }
+  void partitionChanged(uint32_t, uint32_t) override { ++changes; }
+  void partitionsCleared() override { ++changes; }
+  void nodeChanged(uint32_t, NodeTransition) override { ++changes; }
+};
+
+} // anonymous namespace
+
+TEST_CASE("ConnectivityTracker follows splits and heals", "[connectivity]") {
+  // Chain 1 - 2 - 3 - 4
+  TrackerFixture f;
+  for (uint32_t node = 1; node <= 4; ++node) {
+    f.start(node);
+  }
+  REQUIRE(f.tracker.getComponentCount() == 4);
+  const uint64_t rebuilds = f.tracker.getRebuildCount();
+
+  f.transport.addLink(1, 2);
+  f.transport.addLink(2, 3);
+  f.transport.addLink(3, 4);
+  REQUIRE(f.tracker.getComponentCount() == 1);
+  REQUIRE(f.tracker.getComponent(4) == 1);
+  REQUIRE(f.tracker.getRebuildCount() == rebuilds);
+
+  SECTION("one dropped direction splits the link") {
+    f.network.dropConnection(3, 2);
+    REQUIRE(f.tracker.getComponentCount() == 2);
+    REQUIRE(f.tracker.getComponent(2) == 1);
+    REQUIRE(f.tracker.getComponent(3) == 3);
+
+    f.network.restoreAllConnections();
+    REQUIRE(f.tracker.getComponentCount() == 1);
+    REQUIRE(f.tracker.getComponent(3) == 1);
+  }
+
+  SECTION("partitions split and heal") {
+    f.network.setPartition(1, 1);
+    f.network.setPartition(2, 1);
+    f.network.setPartition(3, 2);
+    f.network.setPartition(4, 2);
+    REQUIRE(f.tracker.getComponentCount() == 2);
+    REQUIRE(f.tracker.getComponent(4) == 3);
+
+    f.network.clearPartitions();
+    REQUIRE(f.tracker.getComponentCount() == 1);
+  }
+
+  SECTION("stopped nodes leave their component") {
+    f.stop(2);
+    REQUIRE(f.tracker.getComponentCount() == 2);
+    REQUIRE(f.tracker.getComponent(2) == 0);
+    REQUIRE(f.tracker.getComponent(1) == 1);
+
+    f.start(2);
+    REQUIRE(f.tracker.getComponentCount() == 1);
+  }
+
+  SECTION("changes between components need no rebuild") {
+    f.transport.removeLink(2, 3);
+    REQUIRE(f.tracker.getComponentCount() == 2);
+    const uint64_t split = f.tracker.getRebuildCount();
+
+    f.network.dropConnection(2, 3);
+    f.network.setPartition(5, 1);
+    REQUIRE(f.tracker.getComponentCount() == 2);
+    REQUIRE(f.tracker.getRebuildCount() == split);
+  }
+
+  SECTION("changes are passed on") {
+    CountingListener next;
+    f.tracker.setNext(&next);
+    f.network.dropConnection(1, 2);
+    f.network.setPartition(1, 1);
+    f.network.clearPartitions();
+    f.transport.removeLink(3, 4);
+    f.stop(4);
+    REQUIRE(next.changes == 5);
+  }
+}
+
+TEST_CASE("ConnectivityTracker matches a graph search", "[connectivity]") {
+  constexpr uint32_t NODES = 16;
+  std::mt19937 rng(11);
+  std::uniform_int_distribution<uint32_t> pick(1, NODES);
+
+  TrackerFixture f;
+  for (uint32_t node = 1; node <= NODES; ++node) {
+    f.start(node);
+  }
+
+  for (int step = 0; step < 1000; ++step) {
+    const uint32_t a = pick(rng);
+    const uint32_t b = pick(rng);
+    switch (rng() % 9) {
+      case 0:
+      case 1:
+        if (a != b) {
+          f.transport.addLink(a, b);
+        }
+        break;
+      case 2:
+        f.transport.removeLink(a, b);
+        break;
+      case 3:
+        f.network.dropConnection(a, b);
+        break;
+      case 4:
+        f.network.restoreConnection(a, b);
+        break;
+      case 5:
+        f.network.setPartition(a, b % 3);
+        break;
+      case 6:
+        if (rng() % 4 == 0) {
+          f.network.clearPartitions();
+        } else {
+          f.network.restoreAllConnections();
+        }
+        break;
+      default:
+        if (f.running.count(a)) {
+          f.stop(a);
+        } else {
+          f.start(a);
+        }
+        break;
+    }
+
+    // Query only every few steps, so changes also pile up between queries
+    if (step % 3 != 0) {
+      continue;
+    }
+    const auto expected = f.search();
+    std::set<uint32_t> names;
+    for (uint32_t node = 1; node <= NODES; ++node) {
+      const auto it = expected.find(node);
+      REQUIRE(f.tracker.getComponent(node) == (it == expected.end() ? 0 : it->second));
+      if (it != expected.end()) {
+        names.insert(it->second);
+      }
+    }
+    REQUIRE(f.tracker.getComponentCount() == names.size());
+  }
+}
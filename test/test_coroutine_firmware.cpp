@@ -0,0 +1,155 @@
+/**
+ * @file test_coroutine_firmware.cpp
+ * @brief Unit tests for CoroutineFirmware
+ *
+ * Built only with ENABLE_COROUTINES.
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include "simulator/firmware/coroutine_firmware.hpp"
+
+#if SIMULATOR_ENABLE_COROUTINES
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/virtual_time.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace simulator;
+using namespace simulator::firmware;
+
+namespace {
+
+/**
+ * @brief Sleeps, then answers pings until told to stop
+ */
+class PingFirmware : public CoroutineFirmware {
+public:
+  PingFirmware() : CoroutineFirmware("Ping") {}
+
+  std::vector<std::string> log;
+
+protected:
+  FirmwareRoutine run() override {
+    log.push_back("start@" + std::to_string(VirtualTime::millis()));
+    co_await sleepFor(100);
+    log.push_back("awake@" + std::to_string(VirtualTime::millis()));
+
+    for (;;) {
+      Message message = co_await receive();
+      if (message.msg == "stop") {
+        break;
+      }
+      if (message.msg == "fail") {
+        throw std::runtime_error("failed");
+      }
+      log.push_back(message.msg + "<" + std::to_string(message.from));
+    }
+
+    auto late = co_await receiveFor(50);
+    log.push_back(late ? "late " + late->msg : "timeout@" + std::to_string(VirtualTime::millis()));
+  }
+};
+
+/**
+ * @brief Drives a firmware the way VirtualNode does: loop() only when awake
+ */
+struct Node {
+  CoroutineFirmware& firmware;
+  uint64_t wake_at_ms = 0;
+  uint32_t loops = 0;
+
+  explicit Node(CoroutineFirmware& fw) : firmware(fw) {
+    VirtualTime::useVirtualClock(true);
+    VirtualTime::setNowUs(0);
+    firmware.setup();
+  }
+
+  ~Node() { VirtualTime::useVirtualClock(false); }
+
+  void runUntil(uint64_t until_ms) {
+    for (uint64_t now = VirtualTime::millis(); now <= until_ms; ++now) {
+      VirtualTime::setNowUs(now * 1000);
+      if (now >= wake_at_ms) {
+        loops++;
+        firmware.loop();
+        uint32_t sleep_ms = 0;  // UINT32_MAX: until woken
+        REQUIRE(firmware.takeSleepRequest(sleep_ms));
+        wake_at_ms = sleep_ms == UINT32_MAX ? UINT64_MAX : now + sleep_ms;
+      }
+    }
+  }
+
+  void deliver(uint32_t from, std::string msg) {
+    firmware.onReceive(from, msg);
+    wake_at_ms = 0;  // A callback ends the sleep
+  }
+};
+
+} // anonymous namespace
+
+TEST_CASE("CoroutineFirmware resumes only when the wait is over", "[coroutine_firmware]") {
+  PingFirmware firmware;
+  Node node(firmware);
+
+  // run() reaches its first co_await in setup()
+  REQUIRE(firmware.log == std::vector<std::string>{"start@0"});
+  REQUIRE(firmware.getResumeCount() == 1);
+
+  node.runUntil(99);
+  REQUIRE(firmware.log.size() == 1);
+  node.runUntil(1000);
+  REQUIRE(firmware.log.back() == "awake@100");
+
+  // One loop() sees the sleep, one ends it; the wait for a message
+  // needs no more calls
+  REQUIRE(node.loops == 2);
+  REQUIRE(firmware.getResumeCount() == 2);
+
+  SECTION("messages resume a receive, in order") {
+    node.deliver(7, "a");
+    node.deliver(8, "b");
+    node.runUntil(1001);
+    REQUIRE(firmware.log.size() == 4);
+    REQUIRE(firmware.log[2] == "a<7");
+    REQUIRE(firmware.log[3] == "b<8");
+    REQUIRE(firmware.getQueuedMessages() == 0);
+    REQUIRE(node.loops == 3);
+  }
+
+  SECTION("a receive with a timeout ends at the deadline") {
+    node.deliver(1, "stop");
+    node.runUntil(1001);
+    REQUIRE_FALSE(firmware.isFinished());
+    node.runUntil(1050);
+    REQUIRE(firmware.log.back() == "timeout@1050");
+    REQUIRE(firmware.isFinished());
+  }
+
+  SECTION("a receive with a timeout takes a queued message") {
+    node.deliver(1, "stop");
+    node.deliver(2, "x");
+    node.runUntil(1001);
+    REQUIRE(firmware.log.back() == "late x");
+    REQUIRE(firmware.isFinished());
+
+    // A finished firmware sleeps for good
+    node.runUntil(5000);
+    REQUIRE(node.wake_at_ms == UINT64_MAX);
+  }
+
+  SECTION("an exception escapes from loop()") {
+    node.deliver(1, "fail");
+    VirtualTime::setNowUs(1001000);
+    REQUIRE_THROWS_AS(firmware.loop(), std::runtime_error);
+    REQUIRE(firmware.isFinished());
+  }
+}
+
+#endif // SIMULATOR_ENABLE_COROUTINES
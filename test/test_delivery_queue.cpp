@@ -0,0 +1,194 @@
+/**
+ * @file test_delivery_queue.cpp
+ * @brief Unit tests for delivery queue backends
+ * 
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/delivery_queue.hpp"
+#include "simulator/network_simulator.hpp"
+
+#include <random>
+#include <stdexcept>
+
+using namespace simulator;
+
+namespace {
+
+DelayedMessage makeMessage(uint64_t deliveryTime, const std::string& msg = "x") {
+  DelayedMessage message;
+  message.from = 1;
+  message.to = 2;
+  message.message = msg;
+  message.deliveryTime = deliveryTime;
+  return message;
+}
+
+} // anonymous namespace
+
+TEST_CASE("DeliveryQueue backends deliver in time order", "[delivery_queue]") {
+  for (auto backend : {QueueBackend::HEAP, QueueBackend::TIMING_WHEEL}) {
+    auto queue = makeDeliveryQueue(backend);
+    REQUIRE(queue->backend() == backend);
+    
+    SECTION("only due messages are drained - " + queueBackendToString(backend)) {
+      queue->push(makeMessage(30, "c"));
+      queue->push(makeMessage(10, "a"));
+      queue->push(makeMessage(20, "b"));
+      REQUIRE(queue->size() == 3);
+      
+      std::vector<DelayedMessage> out;
+      REQUIRE(queue->drainReady(20, out) == 2);
+      REQUIRE(out.size() == 2);
+      REQUIRE(out[0].message == "a");
+      REQUIRE(out[1].message == "b");
+      REQUIRE(queue->size() == 1);
+      
+      REQUIRE(queue->drainReady(29, out) == 0);
+      REQUIRE(queue->drainReady(30, out) == 1);
+      REQUIRE(out[2].message == "c");
+      REQUIRE(queue->size() == 0);
+    }
+    
+    SECTION("messages far beyond the wheel are delivered - " + queueBackendToString(backend)) {
+      queue->push(makeMessage(100000, "late"));
+      queue->push(makeMessage(5, "early"));
+      
+      std::vector<DelayedMessage> out;
+      REQUIRE(queue->drainReady(99999, out) == 1);
+      REQUIRE(queue->drainReady(100000, out) == 1);
+      REQUIRE(out[1].message == "late");
+    }
+    
+    SECTION("overdue messages are delivered on the next drain - " + queueBackendToString(backend)) {
+      std::vector<DelayedMessage> out;
+      queue->drainReady(1000, out);
+      queue->push(makeMessage(500, "overdue"));
+      REQUIRE(queue->drainReady(1000, out) == 1);
+      REQUIRE(out[0].message == "overdue");
+    }
+    
+    SECTION("next delivery bound never exceeds the earliest message - " + queueBackendToString(backend)) {
+      REQUIRE(queue->nextDeliveryBound() == UINT64_MAX);
+      queue->push(makeMessage(100000));
+      REQUIRE(queue->nextDeliveryBound() <= 100000);
+      queue->push(makeMessage(40));
+      REQUIRE(queue->nextDeliveryBound() <= 40);
+      
+      std::vector<DelayedMessage> out;
+      queue->drainReady(40, out);
+      REQUIRE(queue->nextDeliveryBound() > 40);
+      REQUIRE(queue->nextDeliveryBound() <= 100000);
+    }
+    
+    SECTION("snapshot rebuilds the same queue - " + queueBackendToString(backend)) {
+      std::vector<DelayedMessage> out;
+      queue->drainReady(100, out);
+      for (int i = 0; i < 20; ++i) {
+        queue->push(makeMessage(150 + (i % 3) * 1000000, "m" + std::to_string(i)));
+      }
+      queue->push(makeMessage(50, "late"));
+      
+      auto copy = makeDeliveryQueue(backend);
+      copy->setDrainTime(queue->getDrainTime());
+      for (auto& message : queue->snapshot()) {
+        copy->push(message);
+      }
+      REQUIRE(queue->size() == 21);
+      REQUIRE(copy->size() == 21);
+      
+      std::vector<DelayedMessage> from_queue;
+      std::vector<DelayedMessage> from_copy;
+      queue->drainReady(UINT64_MAX, from_queue);
+      copy->drainReady(UINT64_MAX, from_copy);
+      REQUIRE(from_queue.size() == from_copy.size());
+      for (size_t i = 0; i < from_queue.size(); ++i) {
+        REQUIRE(from_queue[i].message == from_copy[i].message);
+      }
+      REQUIRE(queue->snapshot().empty());
+    }
+    
+    SECTION("clear drops all messages - " + queueBackendToString(backend)) {
+      queue->push(makeMessage(10));
+      queue->push(makeMessage(100000));
+      queue->clear();
+      REQUIRE(queue->size() == 0);
+      
+      std::vector<DelayedMessage> out;
+      REQUIRE(queue->drainReady(UINT64_MAX, out) == 0);
+    }
+  }
+}
+
+TEST_CASE("TimingWheelDeliveryQueue matches the heap", "[delivery_queue]") {
+  HeapDeliveryQueue heap;
+  TimingWheelDeliveryQueue wheel(256);  // Small wheel to exercise overflow
+  std::mt19937 rng(12345);
+  std::uniform_int_distribution<uint64_t> latency(0, 1000);
+  
+  std::vector<DelayedMessage> from_heap;
+  std::vector<DelayedMessage> from_wheel;
+  for (uint64_t now = 0; now < 5000; now += 7) {
+    for (int i = 0; i < 3; ++i) {
+      auto message = makeMessage(now + latency(rng));
+      heap.push(message);
+      wheel.push(message);
+    }
+    heap.drainReady(now, from_heap);
+    wheel.drainReady(now, from_wheel);
+    REQUIRE(from_heap.size() == from_wheel.size());
+  }
+  heap.drainReady(UINT64_MAX, from_heap);
+  wheel.drainReady(UINT64_MAX, from_wheel);
+  
+  REQUIRE(from_heap.size() == from_wheel.size());
+  bool same_times = true;
+  for (size_t i = 0; i < from_heap.size(); ++i) {
+    if (from_heap[i].deliveryTime != from_wheel[i].deliveryTime) {
+      same_times = false;
+    }
+  }
+  REQUIRE(same_times);
+}
+
+TEST_CASE("TimingWheelDeliveryQueue construction", "[delivery_queue]") {
+  REQUIRE_THROWS_AS(TimingWheelDeliveryQueue(0), std::invalid_argument);
+  REQUIRE(TimingWheelDeliveryQueue(1000).getSlotCount() == 1024);
+  
+  TimingWheelDeliveryQueue wheel;
+  wheel.push(makeMessage(10));
+  REQUIRE_THROWS_AS(wheel.setDrainTime(5), std::logic_error);
+}
+
+TEST_CASE("NetworkSimulator queue backend selection", "[delivery_queue][network_simulator]") {
+  NetworkSimulator sim(12345);
+  LatencyConfig latency;
+  latency.min_ms = 10;
+  latency.max_ms = 10;
+  sim.setDefaultLatency(latency);
+  
+  REQUIRE(sim.getQueueBackend() == QueueBackend::HEAP);
+  
+  SECTION("switching backends keeps pending messages") {
+    sim.enqueueMessage(1, 2, "first", 0);
+    sim.enqueueMessage(1, 2, "second", 5);
+    sim.setQueueBackend(QueueBackend::TIMING_WHEEL);
+    
+    REQUIRE(sim.getQueueBackend() == QueueBackend::TIMING_WHEEL);
+    REQUIRE(sim.getPendingMessageCount() == 2);
+    
+    auto ready = sim.getReadyMessages(15);
+    REQUIRE(ready.size() == 2);
+    REQUIRE(ready[0].message == "first");
+    REQUIRE(ready[1].message == "second");
+  }
+  
+  SECTION("string conversion round-trips") {
+    REQUIRE(stringToQueueBackend("timing_wheel") == QueueBackend::TIMING_WHEEL);
+    REQUIRE(stringToQueueBackend("HEAP") == QueueBackend::HEAP);
+    REQUIRE_THROWS_AS(stringToQueueBackend("fifo"), std::invalid_argument);
+  }
+}
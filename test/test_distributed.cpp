@@ -0,0 +1,115 @@
+/**
+ * @file test_distributed.cpp
+ * @brief Unit tests for the Coordinator and Worker classes
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/distributed.hpp"
+
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace simulator;
+
+namespace {
+
+/**
+ * @brief What a worker saw during a run
+ */
+struct WorkerLog {
+  uint32_t worker_count{0};
+  std::vector<uint64_t> window_starts;
+  std::vector<DelayedMessage> inbound;
+};
+
+// Worker hosting `nodes` that sends one frame per window to `peer`
+void runWorker(uint16_t port, uint32_t rank, std::vector<uint32_t> nodes, uint32_t peer,
+               uint32_t lookahead, WorkerLog& log) {
+  boost::asio::io_context io;
+  Worker worker(io, "127.0.0.1", port, rank);
+  log.worker_count = worker.join();
+  worker.ready(lookahead, nodes);
+
+  worker.serve(
+    [&](uint64_t start_ms, uint32_t tick_ms, uint32_t ticks,
+        std::vector<DelayedMessage>& inbound, std::vector<DelayedMessage>& outbound) {
+      log.window_starts.push_back(start_ms);
+      log.inbound.insert(log.inbound.end(), inbound.begin(), inbound.end());
+      const uint64_t end_ms = start_ms + static_cast<uint64_t>(tick_ms) * ticks;
+      outbound.push_back({nodes[0], peer, Payload(std::to_string(start_ms)), end_ms});
+    },
+    [&]() {
+      WorkerReport report;
+      report.frames_shipped = log.window_starts.size();
+      report.frames_injected = log.inbound.size();
+      return report;
+    });
+}
+
+} // anonymous namespace
+
+TEST_CASE("Coordinator routes frames between workers", "[distributed]") {
+  boost::asio::io_context io;
+  Coordinator coordinator(io, 0, 2);
+  const uint16_t port = coordinator.getPort();
+  REQUIRE(port != 0);
+
+  WorkerLog log0;
+  WorkerLog log1;
+  std::thread worker0(runWorker, port, 0, std::vector<uint32_t>{1, 2}, 3, 4, std::ref(log0));
+  std::thread worker1(runWorker, port, 1, std::vector<uint32_t>{3}, 99, 2, std::ref(log1));
+
+  coordinator.acceptWorkers();
+  REQUIRE(coordinator.getLookaheadTicks() == 2);
+
+  REQUIRE(coordinator.runWindow(0, 10, 2) == 1);     // 1 -> 3 routed, -> 99 dropped
+  REQUIRE(coordinator.runWindow(20, 10, 2) == 1);
+  auto reports = coordinator.stop();
+  worker0.join();
+  worker1.join();
+
+  REQUIRE(coordinator.getDroppedFrames() == 2);
+  REQUIRE(log0.worker_count == 2);
+  REQUIRE(log0.window_starts == std::vector<uint64_t>({0, 20}));
+  REQUIRE(log1.window_starts == std::vector<uint64_t>({0, 20}));
+
+  // Frames of a window arrive with the next one, timestamps intact
+  REQUIRE(log0.inbound.empty());
+  REQUIRE(log1.inbound.size() == 1);
+  REQUIRE(log1.inbound[0].from == 1);
+  REQUIRE(log1.inbound[0].to == 3);
+  REQUIRE(log1.inbound[0].deliveryTime == 20);
+  REQUIRE(log1.inbound[0].message.str() == "0");
+
+  REQUIRE(reports.size() == 2);
+  REQUIRE(reports[0].rank == 0);
+  REQUIRE(reports[0].frames_shipped == 2);
+  REQUIRE(reports[1].frames_injected == 1);
+}
+
+TEST_CASE("Coordinator rejects invalid workers", "[distributed]") {
+  boost::asio::io_context io;
+  Coordinator coordinator(io, 0, 1);
+  const uint16_t port = coordinator.getPort();
+
+  std::thread worker([port]() {
+    boost::asio::io_context worker_io;
+    Worker bad(worker_io, "127.0.0.1", port, 5);
+    try {
+      bad.join();
+    } catch (const std::exception&) {
+      // The coordinator hangs up
+    }
+  });
+
+  REQUIRE_THROWS_AS(coordinator.acceptWorkers(), std::runtime_error);
+  worker.join();
+
+  REQUIRE_THROWS_AS(Coordinator(io, 0, 0), std::invalid_argument);
+}
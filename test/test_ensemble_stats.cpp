@@ -0,0 +1,133 @@
+/**
+ * @file test_ensemble_stats.cpp
+ * @brief Unit tests for RunningStats and EnsembleStats classes
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "simulator/ensemble_stats.hpp"
+
+#include <cmath>
+#include <sstream>
+
+using namespace simulator;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+SweepResult makeRun(uint64_t delivered, uint64_t lost) {
+  SweepResult run;
+  run.link_delivered = delivered;
+  run.link_lost = lost;
+  run.messages_sent = delivered + lost;
+  run.messages_received = delivered;
+  return run;
+}
+
+} // anonymous namespace
+
+TEST_CASE("RunningStats tracks mean and variance", "[ensemble_stats]") {
+  RunningStats stats;
+
+  SECTION("empty stats have no interval") {
+    REQUIRE(stats.getCount() == 0);
+    REQUIRE(stats.getMean() == 0.0);
+    REQUIRE(stats.getVariance() == 0.0);
+    REQUIRE(std::isinf(stats.getConfidenceHalfWidth()));
+  }
+
+  SECTION("matches the two-pass sample variance") {
+    for (double value : {2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0}) {
+      stats.add(value);
+    }
+    REQUIRE(stats.getCount() == 8);
+    REQUIRE_THAT(stats.getMean(), WithinAbs(5.0, 1e-12));
+    REQUIRE_THAT(stats.getVariance(), WithinAbs(32.0 / 7.0, 1e-12));
+    // t(0.975, 7) = 2.365
+    REQUIRE_THAT(stats.getConfidenceHalfWidth(),
+                 WithinAbs(2.365 * std::sqrt(32.0 / 7.0) / std::sqrt(8.0), 1e-9));
+  }
+
+  SECTION("merging equals adding every value to one instance") {
+    RunningStats left;
+    RunningStats right;
+    for (int i = 0; i < 100; ++i) {
+      const double value = 1e6 + (i * 37 % 11) * 0.5;
+      stats.add(value);
+      (i % 3 == 0 ? left : right).add(value);
+    }
+    left.merge(right);
+    REQUIRE(left.getCount() == stats.getCount());
+    REQUIRE_THAT(left.getMean(), WithinAbs(stats.getMean(), 1e-6));
+    REQUIRE_THAT(left.getVariance(), WithinAbs(stats.getVariance(), 1e-6));
+  }
+
+  SECTION("merging into empty stats copies them") {
+    RunningStats other;
+    other.add(3.0);
+    other.add(5.0);
+    stats.merge(other);
+    stats.merge(RunningStats());
+    REQUIRE(stats.getCount() == 2);
+    REQUIRE_THAT(stats.getMean(), WithinAbs(4.0, 1e-12));
+    REQUIRE_THAT(stats.getVariance(), WithinAbs(2.0, 1e-12));
+  }
+}
+
+TEST_CASE("EnsembleStats aggregates runs", "[ensemble_stats]") {
+  EnsembleStats ensemble;
+
+  SECTION("sums counters and merges latencies") {
+    LatencyHistogram latency;
+    latency.record(10);
+    latency.record(20);
+    ensemble.addRun(makeRun(90, 10), latency);
+    ensemble.addRun(makeRun(80, 20), latency);
+    ensemble.addFailure();
+
+    REQUIRE(ensemble.getRuns() == 2);
+    REQUIRE(ensemble.getFailures() == 1);
+    REQUIRE(ensemble.getLatency().getCount() == 4);
+    REQUIRE(ensemble.getDeliveryRatio().getCount() == 2);
+    REQUIRE_THAT(ensemble.getDeliveryRatio().getMean(), WithinAbs(0.85, 1e-12));
+    REQUIRE(ensemble.getLatencyP99().getCount() == 2);
+    REQUIRE_THAT(ensemble.getMessagesReceived().getMean(), WithinAbs(85.0, 1e-12));
+
+    std::ostringstream report;
+    ensemble.print(report);
+    REQUIRE(report.str().find("Runs: 2 completed, 1 failed") != std::string::npos);
+    REQUIRE(report.str().find("Link messages: 170 delivered, 30 lost") != std::string::npos);
+  }
+
+  SECTION("runs without traffic do not count towards the delivery ratio") {
+    ensemble.addRun(makeRun(0, 0), LatencyHistogram());
+    REQUIRE(ensemble.getRuns() == 1);
+    REQUIRE(ensemble.getDeliveryRatio().getCount() == 0);
+    REQUIRE(ensemble.getLatencyP99().getCount() == 0);
+  }
+
+  SECTION("converges once enough runs narrow the interval") {
+    const LatencyHistogram latency;
+    for (uint64_t i = 0; i + 1 < EnsembleStats::MIN_RUNS; ++i) {
+      ensemble.addRun(makeRun(900 + i, 100 - i), latency);
+    }
+    // Identical ratios, but too few runs to trust
+    REQUIRE_FALSE(ensemble.isConverged(0.1));
+
+    ensemble.addRun(makeRun(902, 98), latency);
+    REQUIRE(ensemble.isConverged(0.1));
+    REQUIRE_FALSE(ensemble.isConverged(0.001));
+  }
+
+  SECTION("widely spread runs do not converge") {
+    const LatencyHistogram latency;
+    for (int i = 0; i < 10; ++i) {
+      ensemble.addRun(i % 2 == 0 ? makeRun(10, 90) : makeRun(90, 10), latency);
+    }
+    REQUIRE_FALSE(ensemble.isConverged(0.1));
+  }
+}
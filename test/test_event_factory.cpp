@@ -0,0 +1,202 @@
+/**
+ * @file test_event_factory.cpp
+ * @brief Unit tests for building events from scenario configuration
+ * 
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include "simulator/event_factory.hpp"
+#include "simulator/event_scheduler.hpp"
+#include "simulator/events/connection_degrade_event.hpp"
+#include "simulator/events/connection_drop_event.hpp"
+#include "simulator/events/network_partition_event.hpp"
+#include "simulator/events/node_stop_event.hpp"
+#include <stdexcept>
+#include <vector>
+
+using namespace simulator;
+
+namespace {
+
+std::vector<NodeConfigExtended> makeNodes() {
+  std::vector<NodeConfigExtended> nodes(3);
+  nodes[0].id = "a";
+  nodes[0].nodeId = 1001;
+  nodes[1].id = "b";
+  nodes[1].nodeId = 1002;
+  nodes[2].id = "c";
+  nodes[2].nodeId = 1003;
+  return nodes;
+}
+
+} // namespace
+
+TEST_CASE("EventFactory builds events from config", "[event_factory]") {
+  EventFactory factory(makeNodes());
+  
+  SECTION("one node event per target") {
+    EventConfig config;
+    config.action = EventAction::STOP_NODE;
+    config.target = "a";
+    config.targets = {"b", "c"};
+    config.time = 30;
+    
+    auto events = factory.create(config);
+    REQUIRE(events.size() == 3);
+    for (const auto& event : events) {
+      REQUIRE(dynamic_cast<NodeStopEvent*>(event.get()) != nullptr);
+      REQUIRE(event->getScheduledTimeUs() == 30000000);
+    }
+  }
+  
+  SECTION("time_ms takes precedence over time") {
+    EventConfig config;
+    config.action = EventAction::CRASH_NODE;
+    config.target = "a";
+    config.time = 1;
+    config.time_ms = 1250;
+    
+    auto events = factory.create(config);
+    REQUIRE(events.size() == 1);
+    REQUIRE(events[0]->getScheduledTimeUs() == 1250000);
+  }
+  
+  SECTION("link events resolve both endpoints") {
+    EventConfig config;
+    config.action = EventAction::BREAK_LINK;
+    config.from = "a";
+    config.to = "b";
+    
+    auto events = factory.create(config);
+    REQUIRE(events.size() == 1);
+    auto* drop = dynamic_cast<ConnectionDropEvent*>(events[0].get());
+    REQUIRE(drop != nullptr);
+    REQUIRE(drop->getFromNode() == 1001);
+    REQUIRE(drop->getToNode() == 1002);
+  }
+  
+  SECTION("degrade events carry latency and loss") {
+    EventConfig config;
+    config.action = EventAction::CONNECTION_DEGRADE;
+    config.from = "b";
+    config.to = "c";
+    config.latency = 250;
+    config.packet_loss = 0.5f;
+    
+    auto events = factory.create(config);
+    REQUIRE(events.size() == 1);
+    auto* degrade = dynamic_cast<ConnectionDegradeEvent*>(events[0].get());
+    REQUIRE(degrade != nullptr);
+    REQUIRE(degrade->getLatency() == 250);
+    REQUIRE(degrade->getPacketLoss() == 0.5f);
+  }
+  
+  SECTION("partition groups resolve to node IDs") {
+    EventConfig config;
+    config.action = EventAction::PARTITION_NETWORK;
+    config.groups = {{"a"}, {"b", "c"}};
+    
+    auto events = factory.create(config);
+    REQUIRE(events.size() == 1);
+    auto* partition = dynamic_cast<NetworkPartitionEvent*>(events[0].get());
+    REQUIRE(partition != nullptr);
+    REQUIRE(partition->getPartitionGroups()[1] == std::vector<uint32_t>{1002, 1003});
+  }
+  
+  SECTION("unknown nodes and unsupported actions yield nothing") {
+    EventConfig unknown;
+    unknown.action = EventAction::START_NODE;
+    unknown.target = "missing";
+    REQUIRE(factory.create(unknown).empty());
+    
+    EventConfig unsupported;
+    unsupported.action = EventAction::INJECT_MESSAGE;
+    REQUIRE(factory.create(unsupported).empty());
+  }
+}
+
+TEST_CASE("EventFactory schedules a scenario", "[event_factory]") {
+  EventFactory factory(makeNodes());
+  EventScheduler scheduler;
+  
+  std::vector<EventConfig> events(2);
+  events[0].action = EventAction::HEAL_PARTITION;
+  events[0].time = 20;
+  events[1].action = EventAction::RESTART_NODE;
+  events[1].target = "c";
+  events[1].time_ms = 500;
+  
+  REQUIRE(factory.scheduleAll(events, scheduler) == 2);
+  REQUIRE(scheduler.getPendingEventCount() == 2);
+  REQUIRE(scheduler.getNextEventTimeUs() == 500000);
+}
+
+TEST_CASE("EventFactory builds churn sources", "[event_factory][churn]") {
+  EventFactory factory(makeNodes());
+  ChurnConfig config;
+  config.failure.mean = 60.0;
+  config.repair.mean = 5.0;
+  
+  SECTION("node churn defaults to every node") {
+    auto source = factory.createChurn(config, 1, 0);
+    REQUIRE(source != nullptr);
+    REQUIRE(source->getNextTimeUs() != UINT64_MAX);
+  }
+  
+  SECTION("link churn without resolvable links yields nothing") {
+    config.type = "link";
+    config.links = {{"a", "missing"}};
+    REQUIRE(factory.createChurn(config, 1, 0) == nullptr);
+  }
+  
+  SECTION("unknown distributions are rejected") {
+    config.failure.distribution = "gamma";
+    REQUIRE_THROWS_AS(factory.createChurn(config, 1, 0), std::invalid_argument);
+  }
+  
+  SECTION("sources are added to the scheduler lazily") {
+    EventScheduler scheduler;
+    REQUIRE(factory.addChurnSources({config, config}, 1, scheduler) == 2);
+    REQUIRE(scheduler.getPendingEventCount() == 0);
+    REQUIRE(scheduler.hasPendingEvents());
+  }
+}
+
+TEST_CASE("EventFactory resolves traffic streams", "[event_factory][traffic]") {
+  EventFactory factory(makeNodes());
+  TrafficConfig config;
+  config.sink = "a";
+  config.rate = 5.0;
+  config.start = 2;
+  
+  SECTION("all-to-sink traffic defaults to every other node") {
+    TrafficSpec spec = factory.createTraffic(config);
+    REQUIRE(spec.pattern == TrafficPattern::ALL_TO_SINK);
+    REQUIRE(spec.sink == 1001);
+    REQUIRE(spec.sources == std::vector<uint32_t>{1002, 1003});
+    REQUIRE(spec.start_ms == 2000);
+    REQUIRE(spec.stop_ms == UINT64_MAX);
+  }
+  
+  SECTION("all-to-all traffic defaults to every node") {
+    config.pattern = "all_to_all";
+    config.arrival = "bursty";
+    config.stop = 10;
+    TrafficSpec spec = factory.createTraffic(config);
+    REQUIRE(spec.arrival == TrafficArrival::BURSTY);
+    REQUIRE(spec.sources.size() == 3);
+    REQUIRE(spec.stop_ms == 10000);
+  }
+  
+  SECTION("an unknown sink yields no stream") {
+    config.sink = "missing";
+    REQUIRE(factory.createTraffic(config).sink == 0);
+  }
+  
+  SECTION("unknown names are rejected") {
+    config.arrival = "uniform";
+    REQUIRE_THROWS_AS(factory.createTraffic(config), std::invalid_argument);
+  }
+}
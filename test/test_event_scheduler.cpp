@@ -9,10 +9,12 @@
 #include <catch2/catch_test_macros.hpp>
 #include "simulator/event.hpp"
 #include "simulator/event_scheduler.hpp"
+#include "simulator/event_source.hpp"
 #include "simulator/events/node_crash_event.hpp"
 #include "simulator/node_manager.hpp"
 #include "simulator/network_simulator.hpp"
 #include <boost/asio.hpp>
+#include <sstream>
 #include <vector>
 #include <string>
 
@@ -381,6 +383,195 @@ TEST_CASE("EventScheduler event ordering", "[event_scheduler]") {
   }
 }
 
+TEST_CASE("EventScheduler microsecond resolution", "[event_scheduler]") {
+  boost::asio::io_context io;
+  NodeManager manager(io);
+  NetworkSimulator network;
+  EventScheduler scheduler;
+  
+  class TagEvent : public Event {
+  public:
+    TagEvent(std::vector<uint32_t>& order, uint32_t id) : order_(order), id_(id) {}
+    
+    void execute(NodeManager& manager, NetworkSimulator& network) override {
+      order_.push_back(id_);
+    }
+    
+    std::string getDescription() const override {
+      return "TagEvent #" + std::to_string(id_);
+    }
+  
+  private:
+    std::vector<uint32_t>& order_;
+    uint32_t id_;
+  };
+  
+  std::vector<uint32_t> order;
+  
+  SECTION("second and microsecond views agree") {
+    auto event = std::make_unique<TagEvent>(order, 1);
+    event->setScheduledTimeUs(2500000);
+    REQUIRE(event->getScheduledTime() == 2);
+    
+    event->setScheduledTime(3);
+    REQUIRE(event->getScheduledTimeUs() == 3000000);
+  }
+  
+  SECTION("fires at sub-second times") {
+    scheduler.scheduleEventUs(std::make_unique<TagEvent>(order, 1), 1500);
+    REQUIRE(scheduler.getNextEventTimeUs() == 1500);
+    REQUIRE(scheduler.getNextEventTime() == 0);
+    
+    REQUIRE(scheduler.processEventsUs(1499, manager, network) == 0);
+    REQUIRE(scheduler.processEventsUs(1500, manager, network) == 1);
+    REQUIRE(scheduler.getNextEventTimeUs() == UINT64_MAX);
+  }
+  
+  SECTION("events at the same time run in insertion order") {
+    for (uint32_t id = 1; id <= 20; ++id) {
+      scheduler.scheduleEventUs(std::make_unique<TagEvent>(order, id), 10000);
+    }
+    scheduler.scheduleEventUs(std::make_unique<TagEvent>(order, 0), 5000);
+    
+    REQUIRE(scheduler.processEventsUs(10000, manager, network) == 21);
+    REQUIRE(order.size() == 21);
+    for (uint32_t i = 0; i < order.size(); ++i) {
+      REQUIRE(order[i] == i);
+    }
+  }
+  
+  SECTION("seconds API schedules on the microsecond timeline") {
+    scheduler.scheduleEvent(std::make_unique<TagEvent>(order, 2), 1);
+    scheduler.scheduleEventUs(std::make_unique<TagEvent>(order, 1), 999999);
+    
+    REQUIRE(scheduler.getNextEventTimeUs() == 999999);
+    REQUIRE(scheduler.processEvents(1, manager, network) == 2);
+    REQUIRE(order == std::vector<uint32_t>{1, 2});
+  }
+}
+
+TEST_CASE("EventScheduler compiled timeline", "[event_scheduler]") {
+  boost::asio::io_context io;
+  NodeManager manager(io);
+  NetworkSimulator network;
+  EventScheduler scheduler;
+  std::ostringstream log;
+  scheduler.setLogStream(&log);
+  
+  int counter = 0;
+  
+  SECTION("logs one record per timestamp") {
+    for (int i = 0; i < 50; ++i) {
+      scheduler.scheduleEventUs(std::make_unique<CounterEvent>(counter), 1000);
+    }
+    scheduler.scheduleEventUs(std::make_unique<TestEvent>("late"), 2000);
+    scheduler.compile();
+    
+    REQUIRE(scheduler.processEventsUs(2000, manager, network) == 51);
+    REQUIRE(counter == 50);
+    REQUIRE(log.str() == "[EVENT] t=0.001s: 50 events (CounterEvent, ...)\n"
+                         "[EVENT] t=0.002s: TestEvent: late\n");
+  }
+  
+  SECTION("events scheduled after compile merge into the timeline") {
+    scheduler.scheduleEvent(std::make_unique<CounterEvent>(counter), 10);
+    scheduler.scheduleEvent(std::make_unique<CounterEvent>(counter), 30);
+    scheduler.compile();
+    REQUIRE(scheduler.processEvents(10, manager, network) == 1);
+    
+    scheduler.scheduleEvent(std::make_unique<CounterEvent>(counter), 20);
+    REQUIRE(scheduler.getNextEventTime() == 20);
+    REQUIRE(scheduler.getPendingEventCount() == 2);
+    
+    REQUIRE(scheduler.processEvents(20, manager, network) == 1);
+    REQUIRE(scheduler.getNextEventTime() == 30);
+    REQUIRE(scheduler.processEvents(30, manager, network) == 1);
+    REQUIRE(counter == 3);
+    REQUIRE_FALSE(scheduler.hasPendingEvents());
+  }
+  
+  SECTION("a null log stream silences dispatch") {
+    scheduler.setLogStream(nullptr);
+    scheduler.scheduleEvent(std::make_unique<CounterEvent>(counter), 0);
+    
+    REQUIRE(scheduler.processEvents(0, manager, network) == 1);
+    REQUIRE(log.str().empty());
+  }
+}
+
+TEST_CASE("EventScheduler event sources", "[event_scheduler]") {
+  boost::asio::io_context io;
+  NodeManager manager(io);
+  NetworkSimulator network;
+  EventScheduler scheduler;
+  scheduler.setLogStream(nullptr);
+  
+  // Emits a CounterEvent every millisecond, up to a limit
+  class TickSource : public EventSource {
+  public:
+    TickSource(int& counter, int limit) : counter_(counter), limit_(limit) {}
+    
+    uint64_t getNextTimeUs() const override {
+      return produced_ < limit_ ? static_cast<uint64_t>(produced_ + 1) * 1000 : UINT64_MAX;
+    }
+    
+    std::unique_ptr<Event> next() override {
+      ++produced_;
+      return std::make_unique<CounterEvent>(counter_);
+    }
+    
+    int produced_ = 0;
+  
+  private:
+    int& counter_;
+    int limit_;
+  };
+  
+  int counter = 0;
+  auto owned = std::make_unique<TickSource>(counter, 5);
+  TickSource* source = owned.get();
+  scheduler.addSource(std::move(owned));
+  
+  SECTION("events are pulled only when due") {
+    REQUIRE(scheduler.hasPendingEvents());
+    REQUIRE(scheduler.getPendingEventCount() == 0);
+    REQUIRE(scheduler.getNextEventTimeUs() == 1000);
+    
+    REQUIRE(scheduler.processEventsUs(2500, manager, network) == 2);
+    REQUIRE(source->produced_ == 2);
+    REQUIRE(scheduler.getNextEventTimeUs() == 3000);
+    
+    REQUIRE(scheduler.processEventsUs(10000, manager, network) == 3);
+    REQUIRE(counter == 5);
+    REQUIRE_FALSE(scheduler.hasPendingEvents());
+  }
+  
+  SECTION("scheduled and source events share one timeline") {
+    scheduler.scheduleEventUs(std::make_unique<CounterEvent>(counter), 1000);
+    
+    REQUIRE(scheduler.getNextEventTimeUs() == 1000);
+    REQUIRE(scheduler.processEventsUs(1000, manager, network) == 2);
+    REQUIRE(counter == 2);
+  }
+  
+  SECTION("rejects null source") {
+    REQUIRE_THROWS_AS(scheduler.addSource(nullptr), std::invalid_argument);
+  }
+  
+  SECTION("skipUntilUs drops earlier events without running them") {
+    scheduler.scheduleEventUs(std::make_unique<CounterEvent>(counter), 2000);
+    scheduler.scheduleEventUs(std::make_unique<CounterEvent>(counter), 4000);
+    
+    REQUIRE(scheduler.skipUntilUs(3000) == 3);
+    REQUIRE(counter == 0);
+    REQUIRE(source->produced_ == 2);
+    REQUIRE(scheduler.getNextEventTimeUs() == 3000);
+    
+    REQUIRE(scheduler.processEventsUs(10000, manager, network) == 4);
+    REQUIRE(counter == 4);
+  }
+}
+
 TEST_CASE("EventScheduler integration test", "[event_scheduler][integration]") {
   boost::asio::io_context io;
   NodeManager manager(io);
@@ -14,13 +14,21 @@
 #include "simulator/firmware/simple_broadcast_firmware.hpp"
 #include "simulator/firmware/echo_server_firmware.hpp"
 #include "simulator/firmware/echo_client_firmware.hpp"
+#include "simulator/firmware/routing_bench_firmware.hpp"
 #include "simulator/virtual_node.hpp"
 #include "simulator/node_manager.hpp"
+#include "simulator/mesh_transport.hpp"
+#include "simulator/network_simulator.hpp"
+#include "simulator/shard_mailbox.hpp"
 
 #include <boost/asio.hpp>
 #include <TaskSchedulerDeclarations.h>
 #include <thread>
 #include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
 
 using namespace simulator;
 using namespace simulator::firmware;
@@ -111,11 +119,54 @@ public:
     return getNodeList();
   }
   
+  uint32_t testRandomBetween(uint32_t min, uint32_t max) {
+    return randomBetween(min, max);
+  }
+  
+  void testSendBroadcastTemporary(String msg) {
+    sendBroadcast(std::move(msg));
+  }
+  
+  void testSendSingleTemporary(uint32_t dest, String msg) {
+    sendSingle(dest, std::move(msg));
+  }
+  
+  Payload testPrepareBroadcast(const String& msg) const {
+    return prepareBroadcast(msg);
+  }
+  
+  void testSendPreparedBroadcast(const Payload& prepared) {
+    sendPreparedBroadcast(prepared);
+  }
+  
   bool setup_called = false;
   uint32_t broadcast_count = 0;
   uint32_t single_count = 0;
 };
 
+// Test firmware that receives messages as views
+class ViewTestFirmware : public FirmwareBase {
+public:
+  ViewTestFirmware() : FirmwareBase("ViewTest") {
+    useReceiveView();
+  }
+  
+  void setup() override {}
+  void loop() override {}
+  
+  void onReceiveView(uint32_t from, StringView msg) override {
+    last_from = from;
+    last_data = msg.data();
+    last_message.assign(msg.data(), msg.size());
+    message_count++;
+  }
+  
+  uint32_t last_from = 0;
+  const char* last_data = nullptr;
+  String last_message;
+  uint32_t message_count = 0;
+};
+
 TEST_CASE("FirmwareFactory registration", "[firmware][factory]") {
   // Clean factory for testing
   FirmwareFactory::instance().clear();
@@ -191,6 +242,56 @@ TEST_CASE("FirmwareFactory registration", "[firmware][factory]") {
   FirmwareFactory::instance().clear();
 }
 
+TEST_CASE("FirmwareFactory IDs", "[firmware][factory]") {
+  FirmwareFactory::instance().clear();
+  auto& factory = FirmwareFactory::instance();
+  
+  SECTION("resolve names to creators once") {
+    REQUIRE(factory.registerFirmware<TestFirmware>("Test"));
+    REQUIRE_FALSE(factory.registerFirmware<TestFirmware>("Test"));
+    
+    FirmwareId id = factory.findId("Test");
+    REQUIRE((id != FirmwareFactory::INVALID_ID));
+    REQUIRE((factory.findId("Unknown") == FirmwareFactory::INVALID_ID));
+    
+    auto firmware = factory.create(id);
+    REQUIRE(firmware != nullptr);
+    REQUIRE(firmware->getName() == "TestFirmware");
+    REQUIRE(factory.create(FirmwareFactory::INVALID_ID) == nullptr);
+  }
+  
+  SECTION("are not reused after unregistering") {
+    factory.registerFirmware<TestFirmware>("Test");
+    FirmwareId old_id = factory.findId("Test");
+    REQUIRE(factory.unregisterFirmware("Test"));
+    REQUIRE(factory.create(old_id) == nullptr);
+    
+    factory.registerFirmware<TestFirmware>("Test");
+    REQUIRE(factory.findId("Test") != old_id);
+    REQUIRE(factory.create(factory.findId("Test")) != nullptr);
+  }
+  
+  factory.clear();
+}
+
+TEST_CASE("Firmware shares an immutable configuration", "[firmware][config]") {
+  auto config = std::make_shared<const FirmwareConfig>(
+    FirmwareConfig{{"mesh_prefix", "TestMesh"}, {"interval", "5"}});
+  TestFirmware first;
+  TestFirmware second;
+  first.initialize(nullptr, nullptr, 1, config);
+  second.initialize(nullptr, nullptr, 2, config);
+  
+  REQUIRE(config.use_count() == 3);
+  REQUIRE(first.getConfig("interval", "") == "5");
+  REQUIRE(second.hasConfig("mesh_prefix"));
+  
+  TestFirmware empty;
+  empty.initialize(nullptr, nullptr, 3, std::shared_ptr<const FirmwareConfig>());
+  REQUIRE_FALSE(empty.hasConfig("interval"));
+  REQUIRE(empty.getConfig("interval", "1") == "1");
+}
+
 TEST_CASE("SimpleBroadcast firmware is registered", "[firmware][factory]") {
   // SimpleBroadcast should auto-register via REGISTER_FIRMWARE macro
   // However, due to static initialization order issues in tests, we manually register it
@@ -409,6 +510,149 @@ TEST_CASE("Firmware callback routing", "[firmware][node][callbacks]") {
   }
 }
 
+// Test firmware whose loop() sleeps after every call
+class SleepyFirmware : public FirmwareBase {
+public:
+  SleepyFirmware() : FirmwareBase("Sleepy") {}
+  
+  void setup() override {}
+  
+  void loop() override {
+    loop_count++;
+    sleepFor(sleep_ms);
+  }
+  
+  void poke() { wake(); }
+  
+  void every(uint32_t interval_ms) {
+    runEvery(interval_ms, [this]() { task_count++; });
+  }
+  
+  uint32_t sleep_ms = SLEEP_UNTIL_WOKEN;
+  uint32_t loop_count = 0;
+  uint32_t task_count = 0;
+};
+
+TEST_CASE("Firmware sleep skips idle updates", "[firmware][node][sleep]") {
+  boost::asio::io_context io;
+  NodeManager manager(io);
+  
+  auto node = manager.createNode(NodeConfig{2010, "TestMesh", "password", 18010});
+  auto firmware = std::make_unique<SleepyFirmware>();
+  auto* fw_ptr = firmware.get();
+  
+  SECTION("a sleeping node is not updated until woken") {
+    node->loadFirmware(std::move(firmware));
+    manager.startAll();
+    for (int i = 0; i < 5; ++i) {
+      manager.updateAll();
+    }
+    REQUIRE(fw_ptr->loop_count == 1);
+    REQUIRE(node->isAsleep());
+    REQUIRE(manager.getSleepingNodeCount() == 1);
+    
+    // A delivery wakes the node for the next update
+    node->deliver(2011, Payload("ping"));
+    REQUIRE_FALSE(node->isAsleep());
+    manager.updateAll();
+    REQUIRE(fw_ptr->loop_count == 2);
+    
+    // So does the firmware itself, e.g. from a task callback
+    fw_ptr->poke();
+    manager.updateAll();
+    REQUIRE(fw_ptr->loop_count == 3);
+    
+    manager.stopAll();
+  }
+  
+  SECTION("a timed sleep ends on its own") {
+    fw_ptr->sleep_ms = 20;
+    node->loadFirmware(std::move(firmware));
+    manager.startAll();
+    
+    manager.updateAll();
+    manager.updateAll();
+    REQUIRE(fw_ptr->loop_count == 1);
+    
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    manager.updateAll();
+    REQUIRE(fw_ptr->loop_count == 2);
+    
+    manager.stopAll();
+  }
+  
+  SECTION("a task cuts the sleep short") {
+    node->loadFirmware(std::move(firmware));
+    fw_ptr->every(20);
+    manager.startAll();
+    
+    manager.updateAll();
+    REQUIRE(node->isAsleep());
+    REQUIRE(node->getWakeTime() == node->getNextTaskTime());
+    REQUIRE(manager.getNextWakeTime() == node->getWakeTime());
+    
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    manager.updateAll();
+    REQUIRE(fw_ptr->task_count == 1);
+    REQUIRE(fw_ptr->loop_count == 2);
+    
+    manager.stopAll();
+    REQUIRE(manager.getNextWakeTime() == UINT64_MAX);
+  }
+  
+  SECTION("an awake node needs the next tick") {
+    node->loadFirmware(std::move(firmware));
+    manager.startAll();
+    REQUIRE(manager.getNextWakeTime() == 0);
+    manager.stopAll();
+  }
+  
+  SECTION("a node updated directly runs regardless of sleep") {
+    node->loadFirmware(std::move(firmware));
+    node->start();
+    node->update();
+    node->update();
+    REQUIRE(fw_ptr->loop_count == 2);
+    node->stop();
+  }
+}
+
+TEST_CASE("Firmware receive adapters", "[firmware][callbacks]") {
+  SECTION("String firmware gets views as a copy") {
+    TestFirmware firmware;
+    const char buffer[] = "view message tail";
+    firmware.onReceiveView(42, StringView(buffer, 12));
+    REQUIRE(firmware.message_count == 1);
+    REQUIRE(firmware.last_from == 42);
+    REQUIRE(firmware.last_message == "view message");
+  }
+  
+  SECTION("View firmware reads the message in place") {
+    ViewTestFirmware firmware;
+    String msg = "in place";
+    firmware.onReceiveView(7, StringView(msg.data(), msg.size()));
+    REQUIRE(firmware.message_count == 1);
+    REQUIRE(firmware.last_data == msg.data());
+    REQUIRE(firmware.last_message == "in place");
+  }
+  
+  SECTION("String callers reach view firmware") {
+    ViewTestFirmware firmware;
+    String msg = "legacy caller";
+    firmware.onReceive(9, msg);
+    REQUIRE(firmware.message_count == 1);
+    REQUIRE(firmware.last_from == 9);
+    REQUIRE(firmware.last_data == msg.data());
+  }
+  
+  SECTION("Firmware without a receive override ignores messages") {
+    HelperTestFirmware firmware;
+    String msg = "ignored";
+    firmware.onReceive(1, msg);
+    firmware.onReceiveView(1, StringView(msg.data(), msg.size()));
+  }
+}
+
 TEST_CASE("Firmware helper methods", "[firmware][helpers]") {
   boost::asio::io_context io;
   Scheduler scheduler;
@@ -461,6 +705,103 @@ TEST_CASE("Firmware helper methods", "[firmware][helpers]") {
     auto nodeList = fw_ptr->testGetNodeList();
     REQUIRE(nodeList.empty());  // Should return empty list when mesh is null
   }
+  
+  SECTION("randomBetween replays from the node's seed") {
+    auto firmware = std::make_unique<HelperTestFirmware>();
+    auto* fw_ptr = firmware.get();
+    
+    VirtualNode node(2005, config, &scheduler, io);
+    node.setRandomSeed(42);
+    node.loadFirmware(std::move(firmware));
+    node.start();
+    
+    std::vector<uint32_t> first;
+    for (int i = 0; i < 20; ++i) {
+      first.push_back(fw_ptr->testRandomBetween(10, 20));
+    }
+    bool in_range = true;
+    for (uint32_t value : first) {
+      in_range = in_range && value >= 10 && value < 20;
+    }
+    REQUIRE(in_range);
+    REQUIRE(fw_ptr->testRandomBetween(5, 5) == 5);
+    
+    // Re-seeding restarts the stream
+    node.setRandomSeed(42);
+    std::vector<uint32_t> again;
+    for (int i = 0; i < 20; ++i) {
+      again.push_back(fw_ptr->testRandomBetween(10, 20));
+    }
+    REQUIRE(again == first);
+    
+    node.stop();
+  }
+}
+
+TEST_CASE("Firmware send helpers avoid copies", "[firmware][helpers]") {
+  HelperTestFirmware firmware;
+  firmware.initialize(nullptr, nullptr, 1, FirmwareConfig());
+  
+  SECTION("through the in-process transport") {
+    NetworkSimulator network(1);
+    LatencyConfig latency;
+    latency.min_ms = 5;
+    latency.max_ms = 5;
+    network.setDefaultLatency(latency);
+    MeshTransport transport(network);
+    std::vector<std::pair<uint32_t, Payload>> received;
+    for (uint32_t id = 1; id <= 2; ++id) {
+      MeshTransport::Endpoint endpoint;
+      endpoint.onReceive = [&received](uint32_t from, const Payload& msg) {
+        received.emplace_back(from, msg);
+      };
+      transport.attach(id, endpoint);
+    }
+    transport.addLink(1, 2);
+    firmware.setTransport(&transport);
+    
+    const Payload prepared = firmware.testPrepareBroadcast("periodic");
+    firmware.testSendPreparedBroadcast(prepared);
+    transport.update(10);
+    firmware.testSendPreparedBroadcast(prepared);
+    transport.update(20);
+    firmware.testSendBroadcastTemporary("moved");
+    transport.update(30);
+    firmware.testSendSingleTemporary(2, "single");
+    transport.update(40);
+    
+    REQUIRE(received.size() == 4);
+    REQUIRE(received[0].first == 1);
+    REQUIRE(received[0].second == "periodic");
+    REQUIRE(received[1].second == "periodic");
+    REQUIRE(received[0].second.sharesBufferWith(prepared));
+    REQUIRE(received[1].second.sharesBufferWith(prepared));
+    REQUIRE(received[2].second == "moved");
+    REQUIRE(received[3].second == "single");
+    firmware.setTransport(nullptr);
+  }
+  
+  SECTION("through a shard outbox") {
+    Outbox outbox;
+    firmware.setOutbox(&outbox);
+    
+    const Payload prepared = firmware.testPrepareBroadcast("periodic");
+    firmware.testSendPreparedBroadcast(prepared);
+    firmware.testSendSingleTemporary(2, "single");
+    
+    std::vector<OutgoingMessage> posted;
+    outbox.drain([&posted](OutgoingMessage& message) {
+      posted.push_back(std::move(message));
+    });
+    REQUIRE(posted.size() == 2);
+    REQUIRE((posted[0].dest == OutgoingMessage::BROADCAST));
+    REQUIRE(posted[0].frame.sharesBufferWith(prepared));
+    REQUIRE(posted[0].msg.empty());
+    REQUIRE(posted[1].dest == 2);
+    REQUIRE(posted[1].msg == "single");
+    REQUIRE(posted[1].frame.empty());
+    firmware.setOutbox(nullptr);
+  }
 }
 
 TEST_CASE("SimpleBroadcast firmware functionality", "[firmware][integration]") {
@@ -744,3 +1085,67 @@ TEST_CASE("Echo client/server integration", "[firmware][integration]") {
     client.stop();
   }
 }
+
+TEST_CASE("RoutingBench firmware times routing calls", "[firmware][routing_bench]") {
+  NetworkSimulator network(1);
+  MeshTransport transport(network);
+  for (uint32_t id = 1; id <= 4; ++id) {
+    MeshTransport::Endpoint endpoint;
+    endpoint.onReceive = [](uint32_t, const Payload&) {};
+    transport.attach(id, endpoint);
+  }
+  transport.addLink(1, 2);
+  transport.addLink(2, 3);
+  transport.addLink(3, 4);
+  
+  SECTION("members only make up the mesh") {
+    RoutingBenchFirmware firmware;
+    firmware.initialize(nullptr, nullptr, 2, FirmwareConfig());
+    firmware.setup();
+    REQUIRE_FALSE(firmware.isProbe());
+    REQUIRE(firmware.getSamples().empty());
+  }
+  
+  SECTION("a probe times the transport's node list and sends") {
+    const char* output = "routing_bench_test.csv";
+    std::remove(output);
+    RoutingBenchFirmware firmware;
+    firmware.initialize(nullptr, nullptr, 1,
+                        FirmwareConfig{{"role", "probe"}, {"calls", "5"}, {"output", output}});
+    firmware.setTransport(&transport);
+    firmware.setup();
+    REQUIRE(firmware.isProbe());
+    
+    firmware.runRound();
+    firmware.runRound();
+    
+    // Without a painlessMesh instance the mesh-only calls are skipped
+    const std::vector<RoutingSample>& samples = firmware.getSamples();
+    REQUIRE(samples.size() == 4);
+    REQUIRE(samples[0].op == RoutingOp::NODE_LIST);
+    REQUIRE(samples[0].round == 1);
+    REQUIRE(samples[0].known_nodes == 4);
+    REQUIRE(samples[0].calls == 5);
+    REQUIRE(samples[0].ns_per_call > 0.0);
+    REQUIRE(samples[1].op == RoutingOp::SEND_SINGLE);
+    REQUIRE(samples[3].round == 2);
+    REQUIRE(transport.getStats().frames_sent >= 10);
+    
+    std::ifstream in(output);
+    std::string line;
+    std::vector<std::string> lines;
+    while (std::getline(in, line)) {
+      lines.push_back(line);
+    }
+    REQUIRE(lines.size() == 5);
+    REQUIRE(lines[0] == "node_id,round,time_ms,known_nodes,operation,calls,ns_per_call");
+    REQUIRE(lines[1].find("1,1,") == 0);
+    REQUIRE(lines[1].find(",4,node_list,5,") != std::string::npos);
+    REQUIRE(lines[4].find(",send_single,") != std::string::npos);
+    in.close();
+    std::remove(output);
+    firmware.setTransport(nullptr);
+  }
+  
+  REQUIRE(std::string(routingOpName(RoutingOp::SUB_CONNECTION_JSON)) == "sub_connection_json");
+}
@@ -0,0 +1,137 @@
+/**
+ * @file test_firmware_profiler.cpp
+ * @brief Unit tests for call profiles and FirmwareProfiler
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/firmware_profiler.hpp"
+
+#include <sstream>
+#include <string>
+
+using namespace simulator;
+
+namespace {
+
+CallProfile makeProfile(uint64_t loop_ticks, uint64_t receive_ticks) {
+  CallProfile profile;
+  profile.record(ProfiledCall::LOOP, loop_ticks);
+  profile.record(ProfiledCall::RECEIVE, receive_ticks);
+  return profile;
+}
+
+} // anonymous namespace
+
+TEST_CASE("CallStats counts durations in power-of-two buckets", "[firmware_profiler]") {
+  CallStats stats;
+  REQUIRE(stats.getPercentileTicks(50.0) == 0);
+
+  stats.record(0);
+  stats.record(1);
+  stats.record(3);
+  stats.record(100);
+  REQUIRE(stats.calls == 4);
+  REQUIRE(stats.ticks == 104);
+  REQUIRE(stats.max_ticks == 100);
+  REQUIRE(stats.buckets[0] == 1);
+  REQUIRE(stats.buckets[1] == 1);
+  REQUIRE(stats.buckets[2] == 1);
+  REQUIRE(stats.buckets[7] == 1);   // 64..127
+
+  // Upper bound of the bucket holding the rank, never above the maximum
+  REQUIRE(stats.getPercentileTicks(25.0) == 0);
+  REQUIRE(stats.getPercentileTicks(50.0) == 1);
+  REQUIRE(stats.getPercentileTicks(75.0) == 3);
+  REQUIRE(stats.getPercentileTicks(99.0) == 100);
+
+  CallStats other;
+  other.record(1000);
+  stats.merge(other);
+  REQUIRE(stats.calls == 5);
+  REQUIRE(stats.ticks == 1104);
+  REQUIRE(stats.max_ticks == 1000);
+  REQUIRE(stats.buckets[10] == 1);  // 512..1023
+}
+
+TEST_CASE("ProfileScope times only profiled nodes", "[firmware_profiler]") {
+  ProfileScope unprofiled(nullptr, ProfiledCall::LOOP);
+
+  CallProfile profile;
+  {
+    ProfileScope scope(&profile, ProfiledCall::LOOP);
+  }
+  REQUIRE(profile.get(ProfiledCall::LOOP).calls == 1);
+  REQUIRE(profile.get(ProfiledCall::RECEIVE).calls == 0);
+}
+
+TEST_CASE("ProfileScope leaves nested calls out of the outer call", "[firmware_profiler]") {
+  CallProfile profile;
+  {
+    ProfileScope update(&profile, ProfiledCall::MESH_UPDATE);
+    for (int i = 0; i < 3; ++i) {
+      ProfileScope receive(&profile, ProfiledCall::RECEIVE);
+      volatile uint64_t sink = 0;
+      for (int j = 0; j < 10000; ++j) {
+        sink = sink + static_cast<uint64_t>(j);
+      }
+    }
+  }
+  const CallStats& update = profile.get(ProfiledCall::MESH_UPDATE);
+  const CallStats& receive = profile.get(ProfiledCall::RECEIVE);
+  REQUIRE(update.calls == 1);
+  REQUIRE(receive.calls == 3);
+  REQUIRE(update.ticks < receive.ticks);
+  REQUIRE(profile.getTotalTicks() == update.ticks + receive.ticks);
+}
+
+TEST_CASE("FirmwareProfiler aggregates per firmware and ranks nodes", "[firmware_profiler]") {
+  FirmwareProfiler profiler;
+  profiler.add(1, "echo_server", makeProfile(100, 50));
+  profiler.add(2, "echo_server", makeProfile(10, 5));
+  profiler.add(3, "simple_broadcast", makeProfile(400, 0));
+  profiler.add(4, "(none)", CallProfile());
+
+  ProfileReport report = profiler.report(2);
+  REQUIRE(report.nodes == 4);
+  REQUIRE(report.total_ticks == 565);
+  REQUIRE(report.ns_per_tick > 0.0);
+
+  REQUIRE(report.firmwares.size() == 3);
+  REQUIRE(report.firmwares[0].firmware == "simple_broadcast");
+  REQUIRE(report.firmwares[0].ticks == 400);
+  REQUIRE(report.firmwares[1].firmware == "echo_server");
+  REQUIRE(report.firmwares[1].nodes == 2);
+  REQUIRE(report.firmwares[1].ticks == 165);
+  REQUIRE(report.firmwares[1].profile.get(ProfiledCall::LOOP).calls == 2);
+  REQUIRE(report.firmwares[1].profile.get(ProfiledCall::RECEIVE).max_ticks == 50);
+  REQUIRE(report.firmwares[2].firmware == "(none)");
+
+  REQUIRE(report.top_nodes.size() == 2);
+  REQUIRE(report.top_nodes[0].node_id == 3);
+  REQUIRE(report.top_nodes[1].node_id == 1);
+  REQUIRE(report.top_nodes[1].firmware == "echo_server");
+
+  // Asking for more nodes than profiled returns them all
+  REQUIRE(profiler.report(10).top_nodes.size() == 4);
+}
+
+TEST_CASE("FirmwareProfiler prints a text report", "[firmware_profiler]") {
+  FirmwareProfiler profiler;
+  profiler.add(7, "echo_server", makeProfile(100, 50));
+
+  std::ostringstream out;
+  FirmwareProfiler::print(profiler.report(1), 10.0, out);
+  const std::string text = out.str();
+  REQUIRE(text.find("=== Firmware Profile ===") != std::string::npos);
+  REQUIRE(text.find("By firmware:") != std::string::npos);
+  REQUIRE(text.find("  echo_server: ") != std::string::npos);
+  REQUIRE(text.find("    loop: ") != std::string::npos);
+  REQUIRE(text.find("    receive: ") != std::string::npos);
+  REQUIRE(text.find("mesh_update") == std::string::npos);
+  REQUIRE(text.find("Top 1 nodes:") != std::string::npos);
+  REQUIRE(text.find("  Node 7 (echo_server): ") != std::string::npos);
+}
@@ -0,0 +1,86 @@
+/**
+ * @file test_frame_batch.cpp
+ * @brief Unit tests for the frame batch wire encoding
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/frame_batch.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace simulator;
+
+TEST_CASE("WireWriter and WireReader round-trip values", "[frame_batch]") {
+  WireWriter writer;
+  writer.putU8(0xAB);
+  writer.putU32(0x01020304);
+  writer.putU64(0x1122334455667788ULL);
+  writer.putBytes("mesh", 4);
+
+  SECTION("integers are little-endian") {
+    const std::string& data = writer.data();
+    REQUIRE(data.size() == 1 + 4 + 8 + 4 + 4);
+    REQUIRE(static_cast<uint8_t>(data[1]) == 0x04);
+    REQUIRE(static_cast<uint8_t>(data[4]) == 0x01);
+    REQUIRE(static_cast<uint8_t>(data[5]) == 0x88);
+  }
+
+  SECTION("reader returns what was written") {
+    const std::string data = writer.release();
+    REQUIRE(writer.data().empty());
+
+    WireReader reader(data);
+    REQUIRE(reader.getU8() == 0xAB);
+    REQUIRE(reader.getU32() == 0x01020304);
+    REQUIRE(reader.getU64() == 0x1122334455667788ULL);
+    REQUIRE(reader.getBytes() == "mesh");
+    REQUIRE(reader.atEnd());
+    REQUIRE_THROWS_AS(reader.getU8(), std::runtime_error);
+  }
+}
+
+TEST_CASE("Frame batches round-trip", "[frame_batch]") {
+  std::vector<DelayedMessage> frames;
+  frames.push_back({1001, 1002, Payload(std::string("hello")), 120});
+  frames.push_back({1002, 1003, Payload(std::string("a\0b", 3)), 5000000000ULL});
+  frames.push_back({1003, 1001, Payload(), 7});
+
+  WireWriter writer;
+  encodeFrameBatch(writer, frames);
+  const std::string data = writer.release();
+
+  SECTION("every field survives") {
+    WireReader reader(data);
+    std::vector<DelayedMessage> decoded;
+    REQUIRE(decodeFrameBatch(reader, decoded) == 3);
+    REQUIRE(reader.atEnd());
+    for (size_t i = 0; i < frames.size(); ++i) {
+      REQUIRE(decoded[i].from == frames[i].from);
+      REQUIRE(decoded[i].to == frames[i].to);
+      REQUIRE(decoded[i].deliveryTime == frames[i].deliveryTime);
+      REQUIRE(decoded[i].message.str() == frames[i].message.str());
+    }
+  }
+
+  SECTION("truncated batches are rejected") {
+    const std::string cut = data.substr(0, data.size() - 1);
+    WireReader reader(cut);
+    std::vector<DelayedMessage> decoded;
+    REQUIRE_THROWS_AS(decodeFrameBatch(reader, decoded), std::runtime_error);
+  }
+
+  SECTION("empty batch") {
+    WireWriter empty;
+    encodeFrameBatch(empty, {});
+    WireReader reader(empty.data());
+    std::vector<DelayedMessage> decoded;
+    REQUIRE(decodeFrameBatch(reader, decoded) == 0);
+    REQUIRE(decoded.empty());
+  }
+}
@@ -0,0 +1,273 @@
+/**
+ * @file test_gateway.cpp
+ * @brief Unit tests for Gateway class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/gateway.hpp"
+#include "simulator/mesh_transport.hpp"
+#include "simulator/network_simulator.hpp"
+
+#include <boost/asio.hpp>
+#include <chrono>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace simulator;
+using boost::asio::ip::udp;
+
+namespace {
+
+struct Record {
+  uint32_t bridge;
+  uint32_t peer;
+  std::string body;
+};
+
+std::string encode(const std::vector<Record>& records) {
+  std::string out;
+  for (const auto& record : records) {
+    for (uint32_t value : {record.bridge, record.peer, static_cast<uint32_t>(record.body.size())}) {
+      for (int shift = 0; shift < 32; shift += 8) {
+        out.push_back(static_cast<char>(value >> shift));
+      }
+    }
+    out += record.body;
+  }
+  return out;
+}
+
+std::vector<Record> decode(const std::string& datagram) {
+  auto u32 = [&datagram](size_t at) {
+    uint32_t value = 0;
+    for (int i = 3; i >= 0; --i) {
+      value = (value << 8) | static_cast<uint8_t>(datagram[at + i]);
+    }
+    return value;
+  };
+  std::vector<Record> records;
+  for (size_t at = 0; at + Gateway::RECORD_HEADER_SIZE <= datagram.size();) {
+    const uint32_t length = u32(at + 8);
+    records.push_back({u32(at), u32(at + 4), datagram.substr(at + 12, length)});
+    at += Gateway::RECORD_HEADER_SIZE + length;
+  }
+  return records;
+}
+
+/**
+ * @brief Chain 1 - 2 - 3 with node 1 exposed to a loopback backend socket
+ */
+struct GatewayFixture {
+  boost::asio::io_context io;
+  udp::socket backend{io, udp::endpoint(boost::asio::ip::address_v4::loopback(), 0)};
+  NetworkSimulator network{7};
+  MeshTransport transport{network};
+  std::map<uint32_t, std::vector<std::pair<uint32_t, std::string>>> inbox;
+  std::unique_ptr<Gateway> gateway;
+  uint64_t now = 0;
+
+  explicit GatewayFixture(size_t max_datagram = 1400) {
+    LatencyConfig latency;
+    latency.min_ms = 5;
+    latency.max_ms = 5;
+    network.setDefaultLatency(latency);
+    for (uint32_t id = 1; id <= 3; ++id) {
+      MeshTransport::Endpoint endpoint;
+      endpoint.onReceive = [this, id](uint32_t from, const Payload& msg) {
+        inbox[id].emplace_back(from, msg.str());
+      };
+      transport.attach(id, endpoint);
+    }
+    transport.addLink(1, 2);
+    transport.addLink(2, 3);
+
+    gateway.reset(new Gateway(transport, "127.0.0.1:0",
+                              "127.0.0.1:" + std::to_string(backend.local_endpoint().port()),
+                              max_datagram));
+    gateway->expose(1);
+  }
+
+  void run(uint64_t until_ms) {
+    for (; now <= until_ms; ++now) {
+      transport.update(now);
+    }
+  }
+
+  std::vector<std::string> receiveAll(size_t count) {
+    std::vector<std::string> datagrams;
+    std::string buffer(Gateway::MAX_DATAGRAM, '\0');
+    for (size_t i = 0; i < count; ++i) {
+      const size_t size = backend.receive(boost::asio::buffer(&buffer[0], buffer.size()));
+      datagrams.push_back(buffer.substr(0, size));
+    }
+    return datagrams;
+  }
+
+  void sendToGateway(const std::string& datagram) {
+    backend.send_to(boost::asio::buffer(datagram), gateway->getLocalEndpoint());
+  }
+
+  /// Polls until the loopback datagrams have arrived
+  size_t pollFor(size_t records) {
+    size_t received = 0;
+    for (int attempt = 0; attempt < 200 && received < records; ++attempt) {
+      received += gateway->poll(now);
+      if (received < records) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+    return received;
+  }
+};
+
+} // anonymous namespace
+
+TEST_CASE("Gateway parses endpoints", "[gateway]") {
+  REQUIRE(Gateway::parseEndpoint("127.0.0.1:7000") ==
+          udp::endpoint(boost::asio::ip::make_address("127.0.0.1"), 7000));
+  REQUIRE(Gateway::parseEndpoint("localhost:80").address().is_loopback());
+  REQUIRE(Gateway::parseEndpoint("[::1]:9000") ==
+          udp::endpoint(boost::asio::ip::make_address("::1"), 9000));
+  REQUIRE(Gateway::parseEndpoint("0.0.0.0:0").port() == 0);
+
+  REQUIRE_THROWS_AS(Gateway::parseEndpoint("127.0.0.1"), std::invalid_argument);
+  REQUIRE_THROWS_AS(Gateway::parseEndpoint("127.0.0.1:"), std::invalid_argument);
+  REQUIRE_THROWS_AS(Gateway::parseEndpoint(":7000"), std::invalid_argument);
+  REQUIRE_THROWS_AS(Gateway::parseEndpoint("127.0.0.1:70000"), std::invalid_argument);
+  REQUIRE_THROWS_AS(Gateway::parseEndpoint("127.0.0.1:7x"), std::invalid_argument);
+  REQUIRE_THROWS_AS(Gateway::parseEndpoint("backend.example:7000"), std::invalid_argument);
+}
+
+TEST_CASE("Gateway rejects unusable settings", "[gateway]") {
+  NetworkSimulator network(1);
+  MeshTransport transport(network);
+  REQUIRE_THROWS_AS(Gateway(transport, "127.0.0.1:0", "127.0.0.1:7001", 12),
+                    std::invalid_argument);
+  REQUIRE_THROWS_AS(Gateway(transport, "127.0.0.1:0", "127.0.0.1:7001", Gateway::MAX_DATAGRAM + 1),
+                    std::invalid_argument);
+  REQUIRE_THROWS_AS(Gateway(transport, "127.0.0.1:0", "127.0.0.1:0", 1400),
+                    std::invalid_argument);
+  REQUIRE_THROWS_AS(Gateway(transport, "127.0.0.1:0", "[::1]:7001", 1400),
+                    std::invalid_argument);
+}
+
+TEST_CASE("Gateway sends what bridges receive to the backend", "[gateway]") {
+  SECTION("a delivered frame becomes one record") {
+    GatewayFixture f;
+    REQUIRE(f.transport.sendSingle(3, 1, "reading"));
+    f.run(10);
+    REQUIRE(f.gateway->getQueuedCount() == 1);
+    REQUIRE(f.inbox[1].size() == 1);  // The node still receives it
+
+    REQUIRE(f.gateway->flush() == 1);
+    REQUIRE(f.gateway->getQueuedCount() == 0);
+    const auto records = decode(f.receiveAll(1)[0]);
+    REQUIRE(records.size() == 1);
+    REQUIRE(records[0].bridge == 1);
+    REQUIRE(records[0].peer == 3);
+    REQUIRE(records[0].body == "reading");
+    REQUIRE(f.gateway->getStats().records_sent == 1);
+  }
+
+  SECTION("records of a flush share datagrams up to the size limit") {
+    GatewayFixture f(100);
+    for (int i = 0; i < 5; ++i) {
+      REQUIRE(f.transport.sendSingle(2, 1, std::string(30, static_cast<char>('a' + i))));
+    }
+    f.run(5);
+    REQUIRE(f.gateway->getQueuedCount() == 5);
+
+    // 42 bytes per record: two fit in 100
+    REQUIRE(f.gateway->flush() == 3);
+    std::vector<Record> records;
+    for (const auto& datagram : f.receiveAll(3)) {
+      REQUIRE(datagram.size() <= 100);
+      for (const auto& record : decode(datagram)) {
+        records.push_back(record);
+      }
+    }
+    REQUIRE(records.size() == 5);
+    std::set<std::string> bodies;
+    for (const auto& record : records) {
+      bodies.insert(record.body);
+    }
+    REQUIRE(bodies.size() == 5);
+    REQUIRE(f.gateway->getStats().datagrams_sent == 3);
+  }
+
+  SECTION("records too large for a datagram are dropped") {
+    GatewayFixture f(40);
+    REQUIRE(f.transport.sendSingle(2, 1, std::string(29, 'x')));
+    f.run(5);
+    REQUIRE(f.gateway->getQueuedCount() == 0);
+    REQUIRE(f.gateway->getStats().records_dropped == 1);
+    REQUIRE(f.gateway->flush() == 0);
+  }
+
+  SECTION("broadcasts are forwarded only on request") {
+    GatewayFixture f;
+    REQUIRE(f.transport.sendBroadcast(3, "hello"));
+    f.run(10);
+    REQUIRE(f.gateway->getQueuedCount() == 0);
+
+    f.gateway->setForwardBroadcasts(true);
+    REQUIRE(f.transport.sendBroadcast(3, "hello"));
+    f.run(20);
+    REQUIRE(f.gateway->getQueuedCount() == 1);
+  }
+
+  SECTION("a destroyed gateway leaves no tap behind") {
+    GatewayFixture f;
+    f.gateway.reset();
+    REQUIRE(f.transport.sendSingle(2, 1, "after"));
+    f.run(5);
+    REQUIRE(f.inbox[1].size() == 1);
+  }
+}
+
+TEST_CASE("Gateway sends backend records into the mesh", "[gateway]") {
+  GatewayFixture f;
+  f.run(100);
+
+  SECTION("unicast and broadcast records leave through the bridge") {
+    f.sendToGateway(encode({{1, 3, "command"}, {1, Gateway::BROADCAST, "announce"}}));
+    REQUIRE(f.pollFor(2) == 2);
+    f.run(120);
+    REQUIRE(f.inbox[3].size() == 2);
+    REQUIRE(f.inbox[3][0] == std::make_pair(1u, std::string("command")));
+    REQUIRE(f.inbox[3][1] == std::make_pair(1u, std::string("announce")));
+    REQUIRE(f.inbox[2].size() == 1);  // Relays see only the broadcast
+
+    const GatewayStats& stats = f.gateway->getStats();
+    REQUIRE(stats.datagrams_received == 1);
+    REQUIRE(stats.records_received == 2);
+    REQUIRE(stats.records_rejected == 0);
+  }
+
+  SECTION("records for unexposed or unreachable nodes are rejected") {
+    f.sendToGateway(encode({{2, 3, "not a bridge"}, {1, 99, "nowhere"}, {1, 2, "fine"}}));
+    REQUIRE(f.pollFor(1) == 1);
+    REQUIRE(f.gateway->getStats().records_rejected == 2);
+    f.run(120);
+    REQUIRE(f.inbox[2].size() == 1);
+  }
+
+  SECTION("a truncated record ends its datagram") {
+    std::string datagram = encode({{1, 2, "whole"}, {1, 2, "cut short"}});
+    datagram.resize(datagram.size() - 3);
+    f.sendToGateway(datagram);
+    REQUIRE(f.pollFor(1) == 1);
+    REQUIRE(f.gateway->getStats().records_rejected == 1);
+    f.run(120);
+    REQUIRE(f.inbox[2].size() == 1);
+    REQUIRE(f.inbox[2][0].second == "whole");
+  }
+}
@@ -0,0 +1,122 @@
+/**
+ * @file test_gilbert_elliott.cpp
+ * @brief Unit tests for the Gilbert-Elliott loss chain
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/gilbert_elliott.hpp"
+#include "simulator/network_simulator.hpp"
+
+#include <vector>
+
+using namespace simulator;
+
+namespace {
+
+uint64_t randomWord(uint64_t i) {
+  CounterRng rng(CounterRng::makeKey(9, 1, 2, RNG_STREAM_LOSS), i);
+  uint64_t low = rng();
+  return low | (static_cast<uint64_t>(rng()) << 32);
+}
+
+} // namespace
+
+TEST_CASE("GilbertElliott chain", "[gilbert_elliott]") {
+  SECTION("degenerate chains") {
+    GilbertElliott never(0.0f, 1.0f, 0.0f, 1.0f);
+    GilbertElliott always(1.0f, 0.0f, 0.0f, 1.0f);
+    uint8_t good = GilbertElliott::GOOD;
+    uint8_t bad = GilbertElliott::GOOD;
+    for (uint64_t i = 0; i < 100; ++i) {
+      REQUIRE_FALSE(never.step(good, randomWord(i)));
+      REQUIRE(always.step(bad, randomWord(i)));
+    }
+    REQUIRE(good == GilbertElliott::GOOD);
+    REQUIRE(bad == GilbertElliott::BAD);
+  }
+
+  SECTION("loss rate and burst length match the stationary values") {
+    GilbertElliott chain(0.05f, 0.25f, 0.0f, 1.0f);
+    REQUIRE(chain.getMeanLoss() > 0.1666);
+    REQUIRE(chain.getMeanLoss() < 0.1667);
+    REQUIRE(chain.getMeanBadRun() == 4.0);
+
+    uint8_t state = GilbertElliott::GOOD;
+    const uint64_t packets = 200000;
+    uint64_t lost = 0;
+    uint64_t bursts = 0;
+    bool previous = false;
+    for (uint64_t i = 0; i < packets; ++i) {
+      bool drop = chain.step(state, randomWord(i));
+      lost += drop;
+      bursts += drop && !previous;
+      previous = drop;
+    }
+    double rate = static_cast<double>(lost) / packets;
+    double run = static_cast<double>(lost) / bursts;
+    REQUIRE(rate > 0.155);
+    REQUIRE(rate < 0.178);
+    REQUIRE(run > 3.8);
+    REQUIRE(run < 4.2);
+  }
+
+  SECTION("batch step matches single steps") {
+    GilbertElliott chain(0.1f, 0.3f, 0.02f, 0.8f);
+    const size_t links = 257;
+    std::vector<uint8_t> single(links, GilbertElliott::GOOD);
+    std::vector<uint8_t> batch(links, GilbertElliott::GOOD);
+    std::vector<uint64_t> random(links);
+    std::vector<uint8_t> lost(links);
+
+    for (uint64_t round = 0; round < 20; ++round) {
+      for (size_t i = 0; i < links; ++i) {
+        random[i] = randomWord(round * links + i);
+      }
+      chain.stepBatch(batch.data(), random.data(), lost.data(), links);
+      for (size_t i = 0; i < links; ++i) {
+        REQUIRE(chain.step(single[i], random[i]) == (lost[i] != 0));
+        REQUIRE(single[i] == batch[i]);
+      }
+    }
+  }
+}
+
+TEST_CASE("NetworkSimulator Gilbert-Elliott loss", "[gilbert_elliott][network_simulator]") {
+  NetworkSimulator sim(42);
+  PacketLossConfig loss;
+  loss.gilbert_elliott = true;
+  loss.good_to_bad = 0.05f;
+  loss.bad_to_good = 0.25f;
+  REQUIRE(loss.isValid());
+
+  SECTION("default configuration drops in bursts") {
+    sim.setDefaultPacketLoss(loss);
+    const int packets = 20000;
+    for (int i = 0; i < packets; ++i) {
+      sim.enqueueMessage(1, 2, "x", 0);
+    }
+    auto stats = sim.getStats(1, 2);
+    REQUIRE(stats.drop_rate > 0.14f);
+    REQUIRE(stats.drop_rate < 0.19f);
+  }
+
+  SECTION("per-link configuration keeps links independent") {
+    sim.setPacketLoss(1, 2, loss);
+    for (int i = 0; i < 1000; ++i) {
+      sim.enqueueMessage(1, 2, "x", 0);
+      sim.enqueueMessage(1, 3, "x", 0);
+    }
+    REQUIRE(sim.getStats(1, 2).dropped_count > 0);
+    REQUIRE(sim.getStats(1, 3).dropped_count == 0);
+  }
+
+  SECTION("invalid parameters are rejected") {
+    loss.bad_to_good = 1.5f;
+    REQUIRE_FALSE(loss.isValid());
+    REQUIRE_THROWS_AS(sim.setDefaultPacketLoss(loss), std::invalid_argument);
+  }
+}
@@ -0,0 +1,116 @@
+/**
+ * @file test_latency_histogram.cpp
+ * @brief Unit tests for LatencyHistogram class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "simulator/latency_histogram.hpp"
+
+using namespace simulator;
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("LatencyHistogram records values", "[latency_histogram]") {
+  LatencyHistogram histogram;
+
+  SECTION("empty histogram reports zeros") {
+    REQUIRE(histogram.getCount() == 0);
+    REQUIRE(histogram.getMin() == 0);
+    REQUIRE(histogram.getMax() == 0);
+    REQUIRE(histogram.getPercentile(99.0) == 0);
+  }
+
+  SECTION("small values are exact") {
+    for (uint32_t ms = 1; ms <= 50; ++ms) {
+      histogram.record(ms);
+    }
+    REQUIRE(histogram.getCount() == 50);
+    REQUIRE(histogram.getMin() == 1);
+    REQUIRE(histogram.getMax() == 50);
+    REQUIRE(histogram.getPercentile(50.0) == 25);
+    REQUIRE(histogram.getPercentile(100.0) == 50);
+    REQUIRE(histogram.getPercentile(0.0) == 1);
+    REQUIRE_THAT(histogram.getMean(), WithinAbs(25.5, 1e-9));
+  }
+
+  SECTION("large values stay within the relative error bound") {
+    for (uint32_t ms = 1; ms <= 100000; ++ms) {
+      histogram.record(ms);
+    }
+    auto within = [](uint32_t reported, double expected) {
+      return reported >= expected && reported <= expected * (1.0 + 1.0 / 32);
+    };
+    REQUIRE(within(histogram.getPercentile(50.0), 50000));
+    REQUIRE(within(histogram.getPercentile(99.0), 99000));
+    REQUIRE(within(histogram.getPercentile(99.9), 99900));
+    REQUIRE(histogram.getPercentile(100.0) == 100000);
+  }
+
+  SECTION("tail is visible behind a good average") {
+    for (int i = 0; i < 990; ++i) {
+      histogram.record(10);
+    }
+    for (int i = 0; i < 10; ++i) {
+      histogram.record(2000);
+    }
+    REQUIRE(histogram.getPercentile(50.0) == 10);
+    REQUIRE(histogram.getPercentile(99.0) == 10);
+    REQUIRE(histogram.getPercentile(99.9) >= 2000);
+  }
+
+  SECTION("values beyond the trackable range keep the exact maximum") {
+    histogram.record(5);
+    histogram.record(UINT32_MAX);
+    REQUIRE(histogram.getMax() == UINT32_MAX);
+    REQUIRE(histogram.getPercentile(100.0) == LatencyHistogram::MAX_TRACKABLE_MS);
+  }
+}
+
+TEST_CASE("LatencyHistogram merges", "[latency_histogram]") {
+  LatencyHistogram low;
+  LatencyHistogram high;
+  LatencyHistogram both;
+  for (uint32_t ms = 1; ms <= 500; ++ms) {
+    low.record(ms);
+    both.record(ms);
+  }
+  for (uint32_t ms = 501; ms <= 1000; ++ms) {
+    high.record(ms);
+    both.record(ms);
+  }
+
+  low.merge(high);
+  REQUIRE(low.getCount() == both.getCount());
+  REQUIRE(low.getMin() == 1);
+  REQUIRE(low.getMax() == 1000);
+  for (double p : {50.0, 95.0, 99.0, 99.9}) {
+    REQUIRE(low.getPercentile(p) == both.getPercentile(p));
+  }
+
+  low.clear();
+  REQUIRE(low.getCount() == 0);
+}
+
+TEST_CASE("LatencyHistogram cumulative counts", "[latency_histogram]") {
+  LatencyHistogram histogram;
+  for (uint32_t ms = 1; ms <= 100; ++ms) {
+    histogram.record(ms);
+  }
+
+  const uint32_t bounds[] = {0, 10, 50, 100, 1000};
+  uint64_t counts[5];
+  histogram.getCumulativeCounts(bounds, 5, counts);
+  REQUIRE(counts[0] == 0);
+  REQUIRE(counts[1] == 10);
+  REQUIRE(counts[2] == 50);
+  REQUIRE(counts[3] == 100);
+  REQUIRE(counts[4] == 100);
+
+  LatencyHistogram empty;
+  empty.getCumulativeCounts(bounds, 5, counts);
+  REQUIRE(counts[4] == 0);
+}
@@ -0,0 +1,123 @@
+/**
+ * @file test_latency_sampler.cpp
+ * @brief Unit tests for LatencySampler class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "simulator/latency_sampler.hpp"
+
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+using namespace simulator;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+LatencyConfig makeConfig(uint32_t min, uint32_t max, DistributionType distribution) {
+  LatencyConfig config;
+  config.min_ms = min;
+  config.max_ms = max;
+  config.distribution = distribution;
+  return config;
+}
+
+} // anonymous namespace
+
+TEST_CASE("LatencySampler tabulates the configured distribution", "[latency_sampler]") {
+  for (auto distribution : {DistributionType::UNIFORM, DistributionType::NORMAL,
+                            DistributionType::EXPONENTIAL}) {
+    LatencySampler sampler(makeConfig(10, 90, distribution));
+    REQUIRE(sampler.isTabulated());
+
+    double total = 0.0;
+    for (uint32_t ms = 10; ms <= 90; ++ms) {
+      total += sampler.probability(ms);
+    }
+    REQUIRE_THAT(total, WithinAbs(1.0, 1e-9));
+    REQUIRE(sampler.probability(9) == 0.0);
+    REQUIRE(sampler.probability(91) == 0.0);
+
+    // Empirical frequencies follow the table
+    const int samples = 200000;
+    std::map<uint32_t, int> counts;
+    uint64_t key = CounterRng::makeKey(1, 2, 3, 0);
+    for (int i = 0; i < samples; ++i) {
+      CounterRng rng(key, static_cast<uint64_t>(i));
+      uint32_t value = sampler.sample(rng);
+      REQUIRE(value >= 10);
+      REQUIRE(value <= 90);
+      counts[value]++;
+    }
+    for (uint32_t ms = 10; ms <= 90; ++ms) {
+      double observed = static_cast<double>(counts[ms]) / samples;
+      REQUIRE_THAT(observed, WithinAbs(sampler.probability(ms), 0.005));
+    }
+  }
+}
+
+TEST_CASE("LatencySampler distribution shapes", "[latency_sampler]") {
+  SECTION("uniform values are equally likely") {
+    LatencySampler sampler(makeConfig(0, 9, DistributionType::UNIFORM));
+    for (uint32_t ms = 0; ms <= 9; ++ms) {
+      REQUIRE_THAT(sampler.probability(ms), WithinAbs(0.1, 1e-12));
+    }
+  }
+
+  SECTION("normal peaks at the centre") {
+    LatencySampler sampler(makeConfig(10, 90, DistributionType::NORMAL));
+    REQUIRE(sampler.probability(50) > sampler.probability(30));
+    REQUIRE_THAT(sampler.probability(40), WithinAbs(sampler.probability(60), 1e-9));
+  }
+
+  SECTION("exponential decays from the minimum") {
+    LatencySampler sampler(makeConfig(10, 90, DistributionType::EXPONENTIAL));
+    REQUIRE(sampler.probability(11) > sampler.probability(30));
+    REQUIRE(sampler.probability(30) > sampler.probability(60));
+  }
+
+  SECTION("fixed latency always returns the value") {
+    LatencySampler sampler(makeConfig(25, 25, DistributionType::NORMAL));
+    REQUIRE(sampler.probability(25) == 1.0);
+    CounterRng rng(42, 0);
+    REQUIRE(sampler.sample(rng) == 25);
+  }
+}
+
+TEST_CASE("LatencySampler batch and fallback paths", "[latency_sampler]") {
+  SECTION("sampleBatch matches single samples") {
+    LatencySampler sampler(makeConfig(10, 500, DistributionType::NORMAL));
+    std::vector<uint64_t> random;
+    CounterRng rng(7, 0);
+    for (int i = 0; i < 64; ++i) {
+      random.push_back(rng() | (static_cast<uint64_t>(rng()) << 32));
+    }
+
+    std::vector<uint32_t> out(random.size());
+    sampler.sampleBatch(random.data(), out.data(), random.size());
+    for (size_t i = 0; i < random.size(); ++i) {
+      REQUIRE(out[i] == sampler.sample(random[i]));
+    }
+  }
+
+  SECTION("wide ranges fall back to direct sampling") {
+    LatencySampler sampler(makeConfig(0, 1000000, DistributionType::EXPONENTIAL));
+    REQUIRE_FALSE(sampler.isTabulated());
+
+    CounterRng rng(9, 0);
+    uint32_t value = sampler.sample(rng);
+    REQUIRE(value <= 1000000);
+    REQUIRE(sampler.probability(0) > sampler.probability(500000));
+  }
+
+  SECTION("invalid configuration is rejected") {
+    REQUIRE_THROWS_AS(LatencySampler(makeConfig(50, 10, DistributionType::UNIFORM)),
+                      std::invalid_argument);
+  }
+}
@@ -0,0 +1,83 @@
+/**
+ * @file test_link_table.cpp
+ * @brief Unit tests for LinkTable class
+ * 
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/link_table.hpp"
+
+using namespace simulator;
+
+TEST_CASE("LinkTable lookups", "[link_table]") {
+  LinkTable table;
+  
+  SECTION("starts empty") {
+    REQUIRE(table.size() == 0);
+    REQUIRE(table.find(1, 2) == LinkTable::NPOS);
+  }
+  
+  SECTION("insert assigns dense indices in order") {
+    REQUIRE(table.insert(1, 2) == 0);
+    REQUIRE(table.insert(2, 1) == 1);
+    REQUIRE(table.insert(3, 4) == 2);
+    REQUIRE(table.size() == 3);
+    REQUIRE(table.getLink(1) == std::make_pair(2u, 1u));
+    REQUIRE(table.getLinks() == std::vector<std::pair<uint32_t, uint32_t>>{{1, 2}, {2, 1}, {3, 4}});
+  }
+  
+  SECTION("links are directed") {
+    table.insert(1, 2);
+    REQUIRE(table.find(1, 2) == 0);
+    REQUIRE(table.find(2, 1) == LinkTable::NPOS);
+  }
+  
+  SECTION("re-inserting returns the existing index") {
+    table.insert(1, 2);
+    table.insert(5, 6);
+    REQUIRE(table.insert(1, 2) == 0);
+    REQUIRE(table.size() == 2);
+  }
+  
+  SECTION("clear removes all links") {
+    table.insert(1, 2);
+    table.clear();
+    REQUIRE(table.size() == 0);
+    REQUIRE(table.find(1, 2) == LinkTable::NPOS);
+    REQUIRE(table.insert(7, 8) == 0);
+    REQUIRE(table.getLink(0) == std::make_pair(7u, 8u));
+  }
+}
+
+TEST_CASE("LinkTable growth keeps indices stable", "[link_table]") {
+  LinkTable table;
+  const uint32_t nodes = 300;  // 89700 directed links, many table resizes
+  
+  uint32_t expected = 0;
+  bool all_dense = true;
+  for (uint32_t from = 1; from <= nodes; ++from) {
+    for (uint32_t to = 1; to <= nodes; ++to) {
+      if (from != to && table.insert(from, to) != expected++) {
+        all_dense = false;
+      }
+    }
+  }
+  REQUIRE(all_dense);
+  REQUIRE(table.size() == expected);
+  
+  expected = 0;
+  bool all_found = true;
+  for (uint32_t from = 1; from <= nodes; ++from) {
+    for (uint32_t to = 1; to <= nodes; ++to) {
+      if (from != to && table.find(from, to) != expected++) {
+        all_found = false;
+      }
+    }
+  }
+  REQUIRE(all_found);
+  REQUIRE(table.find(nodes + 1, 1) == LinkTable::NPOS);
+  REQUIRE(table.getLink(table.find(nodes, 1)) == std::make_pair(nodes, 1u));
+}
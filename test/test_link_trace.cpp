@@ -0,0 +1,150 @@
+/**
+ * @file test_link_trace.cpp
+ * @brief Unit tests for memory-mapped link traces
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/link_trace.hpp"
+#include "simulator/network_simulator.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+using namespace simulator;
+
+namespace {
+
+const char* TRACE_FILE = "/tmp/test_link_trace.bin";
+
+void writeTestTrace() {
+  LinkTrace::Series forward{1, 2, {{0, 10, 0.0f}, {1000, 40, 0.0f}, {2000, 25, 1.0f}}};
+  LinkTrace::Series backward{2, 1, {{0, 80, 0.0f}}};
+  LinkTrace::write(TRACE_FILE, {forward, backward});
+}
+
+} // namespace
+
+TEST_CASE("LinkTrace file round trip", "[link_trace]") {
+  writeTestTrace();
+  auto trace = LinkTrace::open(TRACE_FILE);
+
+  REQUIRE(trace->getLinkCount() == 2);
+  REQUIRE(trace->getLink(0).from == 1);
+  REQUIRE(trace->getLink(0).to == 2);
+  REQUIRE(trace->getLink(0).count == 3);
+  REQUIRE(trace->getLink(1).from == 2);
+  REQUIRE(trace->getLink(1).count == 1);
+  REQUIRE(trace->getMinLatency(0) == 10);
+  REQUIRE(trace->getMinLatency(1) == 80);
+
+  SECTION("cursor plays samples in time order") {
+    TraceCursor cursor = trace->cursor(0);
+    REQUIRE(cursor);
+    REQUIRE(cursor.seek(0).latency_ms == 10);
+    REQUIRE(cursor.seek(999).latency_ms == 10);
+    REQUIRE(cursor.seek(1000).latency_ms == 40);
+    REQUIRE(cursor.seek(5000).latency_ms == 25);  // Last sample holds
+    REQUIRE(cursor.current().loss == 1.0f);
+  }
+
+  SECTION("cursor steps back for earlier times") {
+    TraceCursor cursor = trace->cursor(0);
+    cursor.seek(2500);
+    REQUIRE(cursor.seek(1500).latency_ms == 40);
+    REQUIRE(cursor.seek(0).latency_ms == 10);
+  }
+
+  std::remove(TRACE_FILE);
+}
+
+TEST_CASE("LinkTrace rejects bad files", "[link_trace]") {
+  SECTION("missing file") {
+    REQUIRE_THROWS_AS(LinkTrace::open("/tmp/does_not_exist.bin"), std::runtime_error);
+  }
+
+  SECTION("wrong magic") {
+    std::ofstream out(TRACE_FILE, std::ios::binary | std::ios::trunc);
+    out << "NOTATRACEFILE...";
+    out.close();
+    REQUIRE_THROWS_AS(LinkTrace::open(TRACE_FILE), std::runtime_error);
+  }
+
+  SECTION("truncated samples") {
+    writeTestTrace();
+    std::ifstream in(TRACE_FILE, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    std::ofstream out(TRACE_FILE, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 8));
+    out.close();
+    REQUIRE_THROWS_AS(LinkTrace::open(TRACE_FILE), std::runtime_error);
+  }
+
+  SECTION("empty series cannot be written") {
+    LinkTrace::Series empty{1, 2, {}};
+    REQUIRE_THROWS_AS(LinkTrace::write(TRACE_FILE, {empty}), std::invalid_argument);
+  }
+
+  std::remove(TRACE_FILE);
+}
+
+TEST_CASE("NetworkSimulator plays link traces", "[link_trace][network_simulator]") {
+  writeTestTrace();
+  NetworkSimulator sim(42);
+
+  LatencyConfig fixed;
+  fixed.min_ms = 5;
+  fixed.max_ms = 5;
+  sim.setDefaultLatency(fixed);
+  sim.setLinkTrace(LinkTrace::open(TRACE_FILE));
+
+  REQUIRE(sim.isTraced(1, 2));
+  REQUIRE(sim.isTraced(2, 1));
+  REQUIRE_FALSE(sim.isTraced(1, 3));
+
+  SECTION("latency follows the trace over time") {
+    sim.enqueueMessage(1, 2, "a", 0);
+    sim.enqueueMessage(1, 2, "b", 1500);
+    sim.enqueueMessage(1, 3, "c", 1500);  // Untraced link keeps its config
+
+    auto ready = sim.getReadyMessages(UINT64_MAX);
+    REQUIRE(ready.size() == 3);
+    REQUIRE(ready[0].deliveryTime == 10);
+    REQUIRE(ready[1].deliveryTime == 1505);
+    REQUIRE(ready[2].deliveryTime == 1540);
+  }
+
+  SECTION("loss follows the trace over time") {
+    sim.enqueueMessage(1, 2, "lost", 2000);
+    REQUIRE(sim.getPendingMessageCount() == 0);
+    REQUIRE(sim.getStats(1, 2).dropped_count == 1);
+  }
+
+  SECTION("multicast uses traced latencies") {
+    sim.enqueueMulticast(2, std::vector<uint32_t>{1, 3}, Payload("m"), 100);
+    auto ready = sim.getReadyMessages(UINT64_MAX);
+    REQUIRE(ready.size() == 2);
+    REQUIRE(ready[0].deliveryTime == 105);
+    REQUIRE(ready[1].deliveryTime == 180);
+  }
+
+  SECTION("minimum latency counts every traced sample") {
+    REQUIRE(sim.getMinLatency(1, 2) == 10);
+    REQUIRE(sim.getMinLatency(2, 1) == 80);  // Above the configured 5 ms
+    REQUIRE(sim.getMinLatency(1, 3) == 5);
+  }
+
+  SECTION("clearing the trace returns links to their configuration") {
+    sim.setLinkTrace(nullptr);
+    REQUIRE_FALSE(sim.isTraced(1, 2));
+    sim.enqueueMessage(1, 2, "a", 0);
+    REQUIRE(sim.getReadyMessages(UINT64_MAX)[0].deliveryTime == 5);
+  }
+
+  std::remove(TRACE_FILE);
+}
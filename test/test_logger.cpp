@@ -0,0 +1,154 @@
+/**
+ * @file test_logger.cpp
+ * @brief Unit tests for Logger
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/logger.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace simulator;
+
+TEST_CASE("Logger formats records", "[logger]") {
+  Logger logger;
+  std::ostringstream out;
+  std::ostringstream err;
+  logger.setOutput(&out, &err);
+
+  SECTION("arguments replace placeholders in order") {
+    const std::string name = "simple_broadcast";
+    logger.log(LogLevel::INFO, "[INFO] Node {} started with firmware: {}", 42u, name);
+    logger.log(LogLevel::INFO, "{} {} {} {} {}", -7, 'x', 0.25, "text", uint64_t(1) << 40);
+    REQUIRE(out.str() == "[INFO] Node 42 started with firmware: simple_broadcast\n"
+                         "-7 x 0.25 text 1099511627776\n");
+  }
+
+  SECTION("missing arguments print nothing and extra braces stay") {
+    logger.log(LogLevel::INFO, "a={} b={} {", 1);
+    REQUIRE(out.str() == "a=1 b= {\n");
+  }
+
+  SECTION("strings longer than the inline text are kept whole") {
+    const std::string a(100, 'a');
+    const std::string b(100, 'b');
+    logger.log(LogLevel::INFO, "{}|{}|{}", a, b, "c");
+    REQUIRE(out.str() == a + "|" + b + "|c\n");
+  }
+
+  SECTION("warnings and errors go to the error stream") {
+    logger.log(LogLevel::DEBUG, "debug");
+    logger.log(LogLevel::WARN, "warn");
+    logger.log(LogLevel::ERROR, "error");
+    REQUIRE(out.str() == "debug\n");
+    REQUIRE(err.str() == "warn\nerror\n");
+  }
+}
+
+TEST_CASE("Logger levels", "[logger]") {
+  REQUIRE(Logger::parseLevel("DEBUG") == LogLevel::DEBUG);
+  REQUIRE(Logger::parseLevel("WARN") == LogLevel::WARN);
+  REQUIRE(Logger::parseLevel("OFF") == LogLevel::OFF);
+  REQUIRE_THROWS_AS(Logger::parseLevel("verbose"), std::invalid_argument);
+
+  Logger logger;
+  REQUIRE(logger.getLevel() == LogLevel::INFO);
+  REQUIRE_FALSE(logger.enabled(LogLevel::DEBUG));
+  REQUIRE(logger.enabled(LogLevel::INFO));
+  logger.setLevel(LogLevel::ERROR);
+  REQUIRE_FALSE(logger.enabled(LogLevel::WARN));
+  REQUIRE(logger.enabled(LogLevel::ERROR));
+  logger.setLevel(LogLevel::OFF);
+  REQUIRE_FALSE(logger.enabled(LogLevel::ERROR));
+
+  SECTION("the macros skip disabled levels without evaluating arguments") {
+    Logger& global = Logger::instance();
+    const LogLevel saved = global.getLevel();
+    std::ostringstream out;
+    global.setOutput(&out, &out);
+    global.setLevel(LogLevel::WARN);
+
+    int evaluated = 0;
+    SIM_LOG_INFO("[INFO] {}", ++evaluated);
+    SIM_LOG_WARN("[WARN] {}", ++evaluated);
+    REQUIRE(evaluated == 1);
+    REQUIRE(out.str() == "[WARN] 1\n");
+
+    global.setLevel(saved);
+    global.setOutput(&std::cout, &std::cerr);
+  }
+}
+
+TEST_CASE("Logger writer thread", "[logger]") {
+  Logger logger;
+  std::ostringstream out;
+  logger.setOutput(&out, &out);
+  logger.start(8);
+  REQUIRE(logger.isRunning());
+
+  SECTION("records are written in order by flush()") {
+    for (int i = 0; i < 100; ++i) {
+      logger.log(LogLevel::INFO, "record {}", i);
+    }
+    logger.flush();
+    std::string expected;
+    for (int i = 0; i < 100; ++i) {
+      expected += "record " + std::to_string(i) + "\n";
+    }
+    REQUIRE(out.str() == expected);
+  }
+
+  SECTION("full buffers apply back-pressure instead of dropping") {
+    const int THREADS = 4;
+    const int RECORDS = 2000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+      threads.emplace_back([&logger, t]() {
+        for (int i = 0; i < RECORDS; ++i) {
+          logger.log(LogLevel::INFO, "{} {}", t, i);
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    logger.stop();
+    REQUIRE_FALSE(logger.isRunning());
+
+    // Every record arrives, each thread's records in order
+    std::istringstream lines(out.str());
+    std::vector<int> next(THREADS, 0);
+    int t = 0;
+    int i = 0;
+    int count = 0;
+    while (lines >> t >> i) {
+      REQUIRE(i == next[t]);
+      next[t]++;
+      count++;
+    }
+    REQUIRE(count == THREADS * RECORDS);
+  }
+
+  SECTION("stop() drains queued records and restarts cleanly") {
+    logger.log(LogLevel::INFO, "before stop");
+    logger.stop();
+    REQUIRE(out.str() == "before stop\n");
+
+    logger.log(LogLevel::INFO, "synchronous");
+    REQUIRE(out.str() == "before stop\nsynchronous\n");
+
+    logger.start();
+    logger.log(LogLevel::INFO, "restarted");
+    logger.flush();
+    REQUIRE(out.str() == "before stop\nsynchronous\nrestarted\n");
+  }
+}
@@ -0,0 +1,147 @@
+/**
+ * @file test_loop_monitor.cpp
+ * @brief Unit tests for LoopMonitor and update timing
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/loop_monitor.hpp"
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace simulator;
+
+namespace {
+
+UpdateTiming makeTiming(uint64_t mesh_us, uint64_t tasks_us, uint64_t loop_us) {
+  UpdateTiming timing;
+  timing.mesh_ns = mesh_us * 1000;
+  timing.tasks_ns = tasks_us * 1000;
+  timing.loop_ns = loop_us * 1000;
+  return timing;
+}
+
+} // anonymous namespace
+
+TEST_CASE("UpdateTiming finds the slowest phase", "[loop_monitor]") {
+  REQUIRE(makeTiming(10, 2, 3).slowestPhase() == ProfiledCall::MESH_UPDATE);
+  REQUIRE(makeTiming(1, 20, 3).slowestPhase() == ProfiledCall::TASKS);
+  REQUIRE(makeTiming(1, 2, 30).slowestPhase() == ProfiledCall::LOOP);
+  REQUIRE(makeTiming(1, 2, 30).totalNs() == 33000);
+
+  SECTION("phase scopes time only when given a field") {
+    uint64_t field = 0;
+    {
+      UpdatePhaseScope scope(&field);
+      volatile uint64_t sum = 0;
+      for (int i = 0; i < 1000; ++i) {
+        sum = sum + i;
+      }
+    }
+    REQUIRE(field > 0);
+    REQUIRE_NOTHROW(UpdatePhaseScope(nullptr));
+  }
+}
+
+TEST_CASE("LoopMonitor keeps tick and update histograms", "[loop_monitor]") {
+  LoopMonitor monitor;
+  for (uint64_t us = 1; us <= 100; ++us) {
+    monitor.recordTick(us);
+  }
+  REQUIRE(monitor.getTickHistogram().getCount() == 100);
+  REQUIRE(monitor.getTickHistogram().getPercentile(50.0) == 50);
+  REQUIRE(monitor.getTickHistogram().getMax() == 100);
+
+  monitor.setWorkerCount(2);
+  monitor.recordUpdate(0, 1, makeTiming(5, 0, 5), nullptr);
+  monitor.recordUpdate(1, 2, makeTiming(20, 0, 0), nullptr);
+  const LatencyHistogram updates = monitor.getUpdateHistogram();
+  REQUIRE(updates.getCount() == 2);
+  REQUIRE(updates.getMin() == 10);
+  REQUIRE(updates.getMax() == 20);
+
+  // Without a budget nothing is slow
+  REQUIRE(monitor.getSlowUpdateCount() == 0);
+  REQUIRE(monitor.getSlowNodes().empty());
+
+  REQUIRE_THROWS_AS(monitor.setWorkerCount(0), std::invalid_argument);
+}
+
+TEST_CASE("LoopMonitor flags updates over the budget", "[loop_monitor]") {
+  LoopMonitor monitor(100);
+  monitor.setWorkerCount(2);
+
+  monitor.recordUpdate(0, 7, makeTiming(10, 0, 90), nullptr);    // At the budget
+  monitor.recordUpdate(0, 7, makeTiming(10, 0, 150), nullptr);
+  monitor.recordUpdate(1, 7, makeTiming(400, 10, 10), nullptr);  // Same node, other worker
+  monitor.recordUpdate(1, 9, makeTiming(10, 200, 10), nullptr);
+  monitor.recordUpdate(1, 9, makeTiming(1, 1, 1), nullptr);
+
+  REQUIRE(monitor.getUpdateBudgetUs() == 100);
+  REQUIRE(monitor.getUpdateHistogram().getCount() == 5);
+  REQUIRE(monitor.getSlowUpdateCount() == 3);
+
+  const std::vector<SlowNode> slow = monitor.getSlowNodes();
+  REQUIRE(slow.size() == 2);
+  REQUIRE(slow[0].node_id == 7);
+  REQUIRE(slow[0].firmware == "(none)");
+  REQUIRE(slow[0].slow_updates == 2);
+  REQUIRE(slow[0].worst_us == 420);
+  REQUIRE(slow[0].worst_phase == ProfiledCall::MESH_UPDATE);
+  REQUIRE(slow[1].node_id == 9);
+  REQUIRE(slow[1].worst_phase == ProfiledCall::TASKS);
+
+  SECTION("the report lists percentiles and the slowest nodes") {
+    monitor.recordTick(1000);
+    std::ostringstream out;
+    monitor.print(out, 1);
+    const std::string report = out.str();
+    REQUIRE(report.find("Tick time (us): p50=1000 p99=1000 max=1000") != std::string::npos);
+    REQUIRE(report.find("Node update time (us): ") != std::string::npos);
+    REQUIRE(report.find("Slow updates: 3 over the 100 us budget on 2 nodes") != std::string::npos);
+    REQUIRE(report.find("Node 7 ((none)): 2 slow, worst 420 us in mesh_update") !=
+            std::string::npos);
+    REQUIRE(report.find("Node 9") == std::string::npos);
+  }
+
+  SECTION("a new worker count starts over") {
+    monitor.setWorkerCount(1);
+    REQUIRE(monitor.getSlowUpdateCount() == 0);
+    REQUIRE(monitor.getUpdateHistogram().getCount() == 0);
+  }
+}
+
+TEST_CASE("LoopMonitor adds up per-node costs on request", "[loop_monitor]") {
+  LoopMonitor monitor;
+  monitor.setWorkerCount(2);
+  monitor.recordUpdate(0, 7, makeTiming(10, 0, 0), nullptr);
+  REQUIRE_FALSE(monitor.hasNodeCosts());
+  REQUIRE(monitor.getNodeCosts().empty());
+
+  monitor.setNodeCosts(true);
+  monitor.recordUpdate(0, 7, makeTiming(10, 0, 0), nullptr);
+  monitor.recordUpdate(1, 7, makeTiming(0, 30, 0), nullptr);
+  monitor.recordUpdate(1, 9, makeTiming(0, 0, 100), nullptr);
+
+  const std::vector<NodeCost> costs = monitor.getNodeCosts();
+  REQUIRE(costs.size() == 2);
+  REQUIRE(costs[0].node_id == 9);
+  REQUIRE(costs[0].total_ns == 100000);
+  REQUIRE(costs[1].node_id == 7);
+  REQUIRE(costs[1].firmware == "(none)");
+  REQUIRE(costs[1].updates == 2);
+  REQUIRE(costs[1].total_ns == 40000);
+  REQUIRE(costs[1].worst_ns == 30000);
+
+  SECTION("turning costs off discards them") {
+    monitor.setNodeCosts(false);
+    REQUIRE_FALSE(monitor.hasNodeCosts());
+    monitor.recordUpdate(0, 7, makeTiming(10, 0, 0), nullptr);
+    REQUIRE(monitor.getNodeCosts().empty());
+  }
+}
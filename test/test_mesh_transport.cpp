@@ -0,0 +1,576 @@
+/**
+ * @file test_mesh_transport.cpp
+ * @brief Unit tests for MeshTransport class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/link_trace.hpp"
+#include "simulator/mesh_transport.hpp"
+#include "simulator/network_simulator.hpp"
+
+#include <cstdio>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace simulator;
+
+namespace {
+
+struct Received {
+  uint32_t from;
+  std::string msg;
+  Payload payload;
+};
+
+/**
+ * @brief Fixture wiring a set of nodes to a transport with fixed latency
+ */
+struct TransportFixture {
+  NetworkSimulator network{12345};
+  MeshTransport transport{network};
+  std::map<uint32_t, std::vector<Received>> inbox;
+  std::map<uint32_t, std::vector<uint32_t>> new_connections;
+
+  explicit TransportFixture(uint32_t latency_ms = 5) {
+    LatencyConfig latency;
+    latency.min_ms = latency_ms;
+    latency.max_ms = latency_ms;
+    network.setDefaultLatency(latency);
+  }
+
+  void attach(uint32_t id) {
+    MeshTransport::Endpoint endpoint;
+    endpoint.onReceive = [this, id](uint32_t from, const Payload& msg) {
+      inbox[id].push_back({from, msg.str(), msg});
+    };
+    endpoint.onNewConnection = [this, id](uint32_t peer) {
+      new_connections[id].push_back(peer);
+    };
+    transport.attach(id, endpoint);
+  }
+
+  void run(uint64_t until_ms) {
+    for (uint64_t t = transport.getCurrentTime(); t <= until_ms; ++t) {
+      transport.update(t);
+    }
+  }
+};
+
+} // anonymous namespace
+
+TEST_CASE("MeshTransport manages links", "[mesh_transport]") {
+  TransportFixture f;
+  f.attach(1);
+  f.attach(2);
+  f.attach(3);
+
+  SECTION("addLink creates a bidirectional link") {
+    f.transport.addLink(1, 2);
+    REQUIRE(f.transport.hasLink(1, 2));
+    REQUIRE(f.transport.hasLink(2, 1));
+    REQUIRE(f.transport.getLinkCount() == 1);
+  }
+
+  SECTION("duplicate links are ignored") {
+    f.transport.addLink(1, 2);
+    f.transport.addLink(2, 1);
+    REQUIRE(f.transport.getLinkCount() == 1);
+  }
+
+  SECTION("self links are rejected") {
+    REQUIRE_THROWS_AS(f.transport.addLink(1, 1), std::invalid_argument);
+  }
+
+  SECTION("new links notify both endpoints") {
+    f.transport.addLink(1, 2);
+    REQUIRE(f.new_connections[1] == std::vector<uint32_t>{2});
+    REQUIRE(f.new_connections[2] == std::vector<uint32_t>{1});
+  }
+
+  SECTION("addLinks adds a batch and reports each topology change once") {
+    std::map<uint32_t, int> changes;
+    for (uint32_t id : {1u, 2u, 3u}) {
+      MeshTransport::Endpoint endpoint;
+      endpoint.onNewConnection = [&f, id](uint32_t peer) {
+        f.new_connections[id].push_back(peer);
+      };
+      endpoint.onChangedConnections = [&changes, id]() { changes[id]++; };
+      f.transport.attach(id, endpoint);
+    }
+    f.transport.addLink(1, 2);
+    changes.clear();
+    f.new_connections.clear();
+
+    REQUIRE(f.transport.addLinks({{1, 2}, {2, 3}, {3, 1}, {3, 2}}) == 2);
+    REQUIRE(f.transport.getLinkCount() == 3);
+    REQUIRE(f.new_connections[3] == std::vector<uint32_t>{2, 1});
+    REQUIRE(changes == std::map<uint32_t, int>{{1, 1}, {2, 1}, {3, 1}});
+    REQUIRE(f.transport.getReachableNodes(1) == std::list<uint32_t>{2, 3});
+
+    REQUIRE_THROWS_AS(f.transport.addLinks({{1, 4}, {4, 4}}), std::invalid_argument);
+    REQUIRE_FALSE(f.transport.hasLink(1, 4));
+  }
+
+  SECTION("removeNode drops all links of the node") {
+    f.transport.addLink(1, 2);
+    f.transport.addLink(2, 3);
+    f.transport.removeNode(2);
+    REQUIRE(f.transport.getLinkCount() == 0);
+    REQUIRE_FALSE(f.transport.isAttached(2));
+    REQUIRE(f.transport.getNeighbours(1).empty());
+  }
+
+  SECTION("minimum link latency covers both directions") {
+    REQUIRE(f.transport.getMinLinkLatency() == UINT32_MAX);
+    
+    f.transport.addLink(1, 2);
+    f.transport.addLink(2, 3);
+    REQUIRE(f.transport.getMinLinkLatency() == 5);
+    
+    LatencyConfig fast;
+    fast.min_ms = 2;
+    fast.max_ms = 4;
+    f.network.setLatency(3, 2, fast);
+    REQUIRE(f.transport.getMinLinkLatency() == 2);
+  }
+  
+  SECTION("reachable nodes exclude the node itself") {
+    f.transport.addLink(1, 2);
+    f.transport.addLink(2, 3);
+    auto nodes = f.transport.getReachableNodes(1);
+    REQUIRE(nodes == std::list<uint32_t>{2, 3});
+  }
+}
+
+TEST_CASE("MeshTransport minimum link latency counts traces", "[mesh_transport][link_trace]") {
+  TransportFixture f(100);
+  for (uint32_t id = 1; id <= 3; ++id) {
+    f.attach(id);
+  }
+  const char* path = "/tmp/test_mesh_transport_trace.bin";
+  LinkTrace::write(path, {LinkTrace::Series{1, 2, {{0, 100, 0.0f}, {500, 5, 0.0f}}},
+                          LinkTrace::Series{2, 1, {{0, 100, 0.0f}}}});
+  f.network.setLinkTrace(LinkTrace::open(path));
+  f.transport.addLink(1, 2);
+  f.transport.addLink(2, 3);
+
+  // The 5 ms sample bounds the lookahead before playback reaches it, so a
+  // frame sent at 500 ms is never delivered inside the window it was sent in
+  REQUIRE(f.transport.getMinLinkLatency() == 5);
+  f.run(500);
+  REQUIRE(f.transport.sendSingle(1, 2, "fast"));
+  f.run(504);
+  REQUIRE(f.inbox[2].empty());
+  f.run(505);
+  REQUIRE(f.inbox[2].size() == 1);
+  std::remove(path);
+}
+
+TEST_CASE("MeshTransport delivers unicast messages", "[mesh_transport]") {
+  TransportFixture f;
+  for (uint32_t id = 1; id <= 4; ++id) {
+    f.attach(id);
+  }
+  // Chain: 1 - 2 - 3 - 4
+  f.transport.addLink(1, 2);
+  f.transport.addLink(2, 3);
+  f.transport.addLink(3, 4);
+
+  SECTION("direct neighbour receives after link latency") {
+    REQUIRE(f.transport.sendSingle(1, 2, "hello"));
+    f.run(4);
+    REQUIRE(f.inbox[2].empty());
+    f.run(5);
+    REQUIRE(f.inbox[2].size() == 1);
+    REQUIRE(f.inbox[2][0].from == 1);
+    REQUIRE(f.inbox[2][0].msg == "hello");
+  }
+
+  SECTION("multi-hop message is relayed and pays latency per hop") {
+    REQUIRE(f.transport.sendSingle(1, 4, "far"));
+    f.run(14);
+    REQUIRE(f.inbox[4].empty());
+    f.run(15);
+    REQUIRE(f.inbox[4].size() == 1);
+    REQUIRE(f.inbox[4][0].from == 1);
+    REQUIRE(f.inbox[2].empty());
+    REQUIRE(f.inbox[3].empty());
+
+    auto stats = f.transport.getStats();
+    REQUIRE(stats.frames_sent == 1);
+    REQUIRE(stats.frames_forwarded == 2);
+    REQUIRE(stats.frames_delivered == 1);
+  }
+
+  SECTION("send time overrides the last update time") {
+    f.run(100);
+    REQUIRE(f.transport.sendSingle(1, 2, "replayed", 96));
+    REQUIRE(f.transport.sendBroadcast(1, "replayed-all", 97));
+    f.run(101);
+    REQUIRE(f.inbox[2].size() == 1);
+    f.run(102);
+    REQUIRE(f.inbox[2].size() == 2);
+    REQUIRE(f.inbox[2][1].msg == "replayed-all");
+  }
+  
+  SECTION("unreachable destination is rejected") {
+    f.transport.removeLink(2, 3);
+    REQUIRE_FALSE(f.transport.sendSingle(1, 4, "lost"));
+  }
+
+  SECTION("detached relay breaks the route") {
+    f.transport.detach(3);
+    REQUIRE_FALSE(f.transport.sendSingle(1, 4, "lost"));
+  }
+
+  SECTION("a frame tap sees what the node receives") {
+    std::vector<std::pair<uint32_t, std::string>> tapped;
+    f.transport.setFrameTap(4, [&tapped](uint32_t from, bool broadcast, const Payload& msg) {
+      tapped.emplace_back(from, (broadcast ? "*" : "") + msg.str());
+    });
+    REQUIRE(f.transport.sendSingle(1, 4, "far"));
+    REQUIRE(f.transport.sendBroadcast(2, "all"));
+    f.run(20);
+    REQUIRE(tapped.size() == 2);
+    REQUIRE(tapped[0] == std::make_pair(2u, std::string("*all")));
+    REQUIRE(tapped[1] == std::make_pair(1u, std::string("far")));
+    REQUIRE(f.inbox[4].size() == 2);
+
+    f.transport.setFrameTap(4, nullptr);
+    REQUIRE(f.transport.sendSingle(1, 4, "untapped"));
+    f.run(40);
+    REQUIRE(tapped.size() == 2);
+    REQUIRE(f.inbox[4].size() == 3);
+  }
+
+  SECTION("frames towards a detached node are dropped on arrival") {
+    REQUIRE(f.transport.sendSingle(1, 2, "late"));
+    f.transport.detach(2);
+    f.run(10);
+    REQUIRE(f.inbox[2].empty());
+    REQUIRE(f.transport.getStats().frames_dropped == 1);
+  }
+}
+
+TEST_CASE("MeshTransport floods broadcasts once per node", "[mesh_transport]") {
+  TransportFixture f;
+  for (uint32_t id = 1; id <= 4; ++id) {
+    f.attach(id);
+  }
+  // Ring with a cycle: 1 - 2 - 3 - 4 - 1
+  f.transport.addLink(1, 2);
+  f.transport.addLink(2, 3);
+  f.transport.addLink(3, 4);
+  f.transport.addLink(4, 1);
+
+  REQUIRE(f.transport.sendBroadcast(1, "all"));
+  f.run(50);
+
+  REQUIRE(f.inbox[1].empty());
+  for (uint32_t id = 2; id <= 4; ++id) {
+    REQUIRE(f.inbox[id].size() == 1);
+    REQUIRE(f.inbox[id][0].from == 1);
+    REQUIRE(f.inbox[id][0].msg == "all");
+  }
+  REQUIRE(f.network.getPendingMessageCount() == 0);
+  
+  // Every receiver sees a view into the one frame built by the sender
+  REQUIRE(f.inbox[2][0].payload.sharesBufferWith(f.inbox[3][0].payload));
+  REQUIRE(f.inbox[2][0].payload.sharesBufferWith(f.inbox[4][0].payload));
+
+  // Cached relay lists follow topology changes: 4 is now reached via 3
+  f.transport.removeLink(4, 1);
+  uint64_t forwarded = f.transport.getStats().frames_forwarded;
+  REQUIRE(f.transport.sendBroadcast(1, "again"));
+  f.run(100);
+  for (uint32_t id = 2; id <= 4; ++id) {
+    REQUIRE(f.inbox[id].size() == 2);
+    REQUIRE(f.inbox[id][1].msg == "again");
+  }
+  REQUIRE(f.transport.getStats().frames_forwarded == forwarded + 2);
+}
+
+TEST_CASE("MeshTransport resends encoded broadcasts", "[mesh_transport]") {
+  TransportFixture f;
+  for (uint32_t id = 1; id <= 3; ++id) {
+    f.attach(id);
+  }
+  f.transport.addLink(1, 2);
+  f.transport.addLink(2, 3);
+
+  const Payload frame = MeshTransport::encodeBroadcast(1, "again");
+  REQUIRE(frame.size() == MeshTransport::FRAME_HEADER_SIZE + 5);
+  REQUIRE(f.transport.sendBroadcastFrame(1, frame));
+  f.run(20);
+  REQUIRE(f.transport.sendBroadcastFrame(1, frame));
+  f.run(40);
+
+  for (uint32_t id = 2; id <= 3; ++id) {
+    REQUIRE(f.inbox[id].size() == 2);
+    REQUIRE(f.inbox[id][1].from == 1);
+    REQUIRE(f.inbox[id][1].msg == "again");
+  }
+  REQUIRE(f.transport.getStats().frames_sent == 2);
+
+  // Both sends were views into the caller's frame
+  REQUIRE(f.inbox[3][0].payload.sharesBufferWith(frame));
+  REQUIRE(f.inbox[3][1].payload.sharesBufferWith(frame));
+
+  // A frame encoded for another node, or no frame at all, is rejected
+  REQUIRE_THROWS_AS(f.transport.sendBroadcastFrame(2, frame), std::invalid_argument);
+  REQUIRE_THROWS_AS(f.transport.sendBroadcastFrame(1, Payload("again")), std::invalid_argument);
+  REQUIRE_FALSE(f.transport.sendBroadcastFrame(9, MeshTransport::encodeBroadcast(9, "x")));
+}
+
+TEST_CASE("MeshTransport resends encoded unicasts", "[mesh_transport]") {
+  TransportFixture f;
+  for (uint32_t id = 1; id <= 3; ++id) {
+    f.attach(id);
+  }
+  f.transport.addLink(1, 2);
+  f.transport.addLink(2, 3);
+
+  const Payload frame = MeshTransport::encodeSingle(1, 3, "again");
+  REQUIRE(f.transport.sendSingleFrame(1, frame, 0));
+  REQUIRE(f.transport.sendSingleFrame(1, frame, 0));
+  f.run(20);
+
+  REQUIRE(f.inbox[3].size() == 2);
+  REQUIRE(f.inbox[3][1].from == 1);
+  REQUIRE(f.inbox[3][1].msg == "again");
+  REQUIRE(f.inbox[3][1].payload.sharesBufferWith(frame));
+  REQUIRE(f.inbox[2].empty());
+
+  // A frame of another node, or a broadcast, is rejected
+  REQUIRE_THROWS_AS(f.transport.sendSingleFrame(2, frame, 20), std::invalid_argument);
+  REQUIRE_THROWS_AS(f.transport.sendSingleFrame(1, MeshTransport::encodeBroadcast(1, "x"), 20),
+                    std::invalid_argument);
+  REQUIRE_FALSE(f.transport.sendSingleFrame(1, MeshTransport::encodeSingle(1, 9, "x"), 20));
+}
+
+TEST_CASE("MeshTransport frame filter consumes frames", "[mesh_transport]") {
+  TransportFixture f;
+  for (uint32_t id = 1; id <= 3; ++id) {
+    f.attach(id);
+  }
+  f.transport.addLink(1, 2);
+  f.transport.addLink(2, 3);
+
+  std::vector<uint32_t> filtered;
+  f.transport.setFrameFilter([&filtered](uint32_t node, uint32_t from, const Payload& msg) {
+    filtered.push_back(node);
+    REQUIRE(from == 1);
+    return msg.str() == "hidden";
+  });
+
+  f.transport.sendBroadcast(1, "hidden");
+  f.transport.sendSingle(1, 3, "shown");
+  f.run(30);
+
+  // Consumed broadcasts are still relayed, and still count as delivered
+  REQUIRE(filtered.size() == 3);
+  REQUIRE(f.inbox[2].empty());
+  REQUIRE(f.inbox[3].size() == 1);
+  REQUIRE(f.inbox[3][0].msg == "shown");
+  REQUIRE(f.transport.getStats().frames_delivered == 3);
+
+  f.transport.setFrameFilter(nullptr);
+  f.transport.sendBroadcast(1, "hidden");
+  f.run(60);
+  REQUIRE(f.inbox[2].size() == 1);
+}
+
+TEST_CASE("MeshTransport applies network conditions", "[mesh_transport]") {
+  TransportFixture f;
+  f.attach(1);
+  f.attach(2);
+  f.transport.addLink(1, 2);
+
+  SECTION("dropped connection loses traffic") {
+    f.network.dropConnection(1, 2);
+    f.transport.sendSingle(1, 2, "blocked");
+    f.run(20);
+    REQUIRE(f.inbox[2].empty());
+  }
+
+  SECTION("full packet loss loses traffic") {
+    PacketLossConfig loss;
+    loss.probability = 1.0f;
+    f.network.setPacketLoss(1, 2, loss);
+    f.transport.sendSingle(1, 2, "lost");
+    f.run(20);
+    REQUIRE(f.inbox[2].empty());
+  }
+
+  SECTION("hops are recorded in link statistics") {
+    f.transport.sendSingle(1, 2, "hi");
+    f.run(20);
+    auto stats = f.network.getStats(1, 2);
+    REQUIRE(stats.message_count == 1);
+  }
+}
+
+TEST_CASE("MeshTransport routes through nodes of another process", "[mesh_transport]") {
+  // Two transports standing in for two processes: 1 and 2 live in the
+  // first, 3 in the second, on the chain 1 - 2 - 3
+  TransportFixture a;
+  TransportFixture b;
+  a.attach(1);
+  a.attach(2);
+  a.transport.attachRemote(3);
+  b.attach(3);
+  b.transport.attachRemote(1);
+  b.transport.attachRemote(2);
+  for (auto* f : {&a, &b}) {
+    f->transport.addLink(1, 2);
+    f->transport.addLink(2, 3);
+  }
+
+  REQUIRE(a.transport.isRemote(3));
+  REQUIRE_FALSE(a.transport.isRemote(2));
+  REQUIRE(a.transport.isAttached(3));
+
+  SECTION("shipped frames reach the remote node") {
+    std::vector<DelayedMessage> shipped;
+    a.network.setEgressFilter([&a, &shipped](DelayedMessage& frame) {
+      if (!a.transport.isRemote(frame.to)) {
+        return false;
+      }
+      shipped.push_back(std::move(frame));
+      return true;
+    });
+
+    REQUIRE(a.transport.sendSingle(1, 3, "across"));
+    a.run(10);
+    REQUIRE(shipped.size() == 1);
+    REQUIRE(shipped[0].from == 2);
+    REQUIRE(shipped[0].deliveryTime == 10);
+
+    b.network.injectMessage(shipped[0]);
+    b.run(9);
+    REQUIRE(b.inbox[3].empty());
+    b.run(10);
+    REQUIRE(b.inbox[3].size() == 1);
+    REQUIRE(b.inbox[3][0].from == 1);
+    REQUIRE(b.inbox[3][0].msg == "across");
+  }
+
+  SECTION("frames that are not shipped are dropped at the boundary") {
+    REQUIRE(a.transport.sendSingle(1, 3, "stuck"));
+    a.run(10);
+    REQUIRE(a.inbox[3].empty());
+    REQUIRE(a.transport.getStats().frames_dropped == 1);
+  }
+}
+
+TEST_CASE("MeshTransport keeps cached routes a change does not touch", "[mesh_transport]") {
+  // Square 1 - 2 - 4 - 3 - 1
+  TransportFixture f;
+  for (uint32_t id : {1u, 2u, 3u, 4u}) {
+    f.attach(id);
+  }
+  f.transport.addLinks({{1, 2}, {1, 3}, {2, 4}, {3, 4}});
+  for (uint32_t dest : {1u, 2u, 3u, 4u}) {
+    f.transport.getNextHop(dest == 1 ? 2 : 1, dest);
+  }
+  REQUIRE(f.transport.getCachedRouteCount() == 4);
+  REQUIRE(f.transport.getNextHop(4, 1) == 2);
+
+  SECTION("re-attaching a node only replaces its callbacks") {
+    f.attach(2);
+    REQUIRE(f.transport.getCachedRouteCount() == 4);
+  }
+
+  SECTION("a link between nodes at the same depth keeps the tree") {
+    // 2 and 3 are both one hop from 1 and from 4, but not from each other
+    f.transport.addLink(2, 3);
+    REQUIRE(f.transport.getCachedRouteCount() == 2);
+    REQUIRE(f.transport.getNextHop(3, 2) == 2);
+  }
+
+  SECTION("removing a link outside a tree keeps the tree") {
+    // 3 - 4 carries no route towards 1 or 2 (4 reaches 1 through 2)
+    f.transport.removeLink(3, 4);
+    REQUIRE(f.transport.getCachedRouteCount() == 2);
+    REQUIRE(f.transport.getNextHop(3, 4) == 1);
+    REQUIRE(f.transport.getNextHop(4, 3) == 2);
+  }
+
+  SECTION("a detached leaf is cut out of the trees") {
+    f.transport.detach(4);
+    REQUIRE(f.transport.getCachedRouteCount() == 3);
+    REQUIRE(f.transport.getNextHop(4, 1) == 0);
+    REQUIRE(f.transport.getReachableNodes(1) == std::list<uint32_t>{2, 3});
+  }
+}
+
+TEST_CASE("MeshTransport incremental routes match rebuilt routes", "[mesh_transport]") {
+  constexpr uint32_t NODES = 12;
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<uint32_t> pick(1, NODES);
+
+  TransportFixture f;
+  for (uint32_t id = 1; id <= NODES; ++id) {
+    f.attach(id);
+  }
+
+  // Broadcasts from every attached node, as received per node
+  auto broadcast = [](TransportFixture& fixture) {
+    std::map<uint32_t, size_t> received;
+    for (uint32_t id = 1; id <= NODES; ++id) {
+      fixture.transport.sendBroadcast(id, "b");
+    }
+    fixture.run(fixture.transport.getCurrentTime() + 5 * NODES);
+    for (const auto& entry : fixture.inbox) {
+      received[entry.first] = entry.second.size();
+    }
+    fixture.inbox.clear();
+    return received;
+  };
+
+  for (int step = 0; step < 300; ++step) {
+    // Fill every cache, then change one link or attachment
+    broadcast(f);
+    const uint32_t a = pick(rng);
+    const uint32_t b = pick(rng);
+    switch (rng() % 4) {
+      case 0:
+      case 1:
+        if (a != b) {
+          f.transport.addLink(a, b);
+        }
+        break;
+      case 2:
+        f.transport.removeLink(a, b);
+        break;
+      default:
+        if (f.transport.isAttached(a)) {
+          f.transport.detach(a);
+        } else {
+          f.attach(a);
+        }
+        break;
+    }
+
+    TransportFixture fresh;
+    for (uint32_t id = 1; id <= NODES; ++id) {
+      if (f.transport.isAttached(id)) {
+        fresh.attach(id);
+      }
+    }
+    fresh.transport.addLinks(f.transport.getLinks());
+    for (uint32_t from = 1; from <= NODES; ++from) {
+      for (uint32_t dest = 1; dest <= NODES; ++dest) {
+        REQUIRE(f.transport.getNextHop(from, dest) == fresh.transport.getNextHop(from, dest));
+      }
+    }
+    REQUIRE(broadcast(f) == broadcast(fresh));
+  }
+}
@@ -0,0 +1,257 @@
+/**
+ * @file test_metrics_collector.cpp
+ * @brief Unit tests for MetricsCollector
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/metrics_collector.hpp"
+#include "simulator/network_simulator.hpp"
+#include "simulator/node_manager.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace simulator;
+
+namespace {
+
+std::string readText(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+MetricsConfig makeConfig(const std::string& output) {
+  MetricsConfig config;
+  config.output = output;
+  config.interval = 2;
+  config.collect = {"message_count", "delivery_rate"};
+  return config;
+}
+
+/// Snapshot of three nodes with messages_sent = 10 * id, messages_received = id
+MetricsSnapshot makeSnapshot(uint64_t time_us) {
+  MetricsSnapshot snapshot;
+  snapshot.time_us = time_us;
+  snapshot.node_ids = {1, 2, 3};
+  snapshot.node_values = {10, 20, 30, 1, 2, 3};
+  snapshot.network_values = {60, 6, 0.5};
+  return snapshot;
+}
+
+} // anonymous namespace
+
+TEST_CASE("MetricsCollector configuration", "[metrics]") {
+  SECTION("collect selects the columns") {
+    MetricsCollector collector(makeConfig("metrics.csv"));
+    REQUIRE(collector.getNodeColumns() ==
+            std::vector<std::string>{"messages_sent", "messages_received"});
+    REQUIRE(collector.getNetworkColumns() ==
+            std::vector<std::string>{"messages_sent", "messages_received", "delivery_rate"});
+    REQUIRE(collector.getIntervalUs() == 2000000);
+  }
+
+  SECTION("an empty collect list selects every group") {
+    MetricsConfig config = makeConfig("metrics.csv");
+    config.collect.clear();
+    MetricsCollector collector(config);
+    REQUIRE(collector.getNodeColumns().size() == 8);
+    REQUIRE(collector.getNetworkColumns().size() == 23);
+  }
+
+  SECTION("single columns can be listed and unknown names are ignored") {
+    MetricsConfig config = makeConfig("metrics.csv");
+    config.collect = {"bytes_sent", "latency_p99_ms", "topology_changes"};
+    MetricsCollector collector(config);
+    REQUIRE(collector.getNodeColumns() == std::vector<std::string>{"bytes_sent"});
+    REQUIRE(collector.getNetworkColumns() == std::vector<std::string>{"latency_p99_ms"});
+  }
+
+  SECTION("invalid settings are rejected") {
+    MetricsConfig config = makeConfig("metrics.csv");
+    config.interval = 0;
+    REQUIRE_THROWS_AS(MetricsCollector(config), std::invalid_argument);
+
+    config = makeConfig("metrics.csv");
+    config.export_formats = {"xml"};
+    REQUIRE_THROWS_AS(MetricsCollector(config), std::invalid_argument);
+
+    REQUIRE_THROWS_AS(MetricsCollector(makeConfig("")), std::invalid_argument);
+  }
+
+  SECTION("the output extension is replaced per format") {
+    REQUIRE(MetricsCollector::basePath("results/metrics.csv") == "results/metrics");
+    REQUIRE(MetricsCollector::basePath("results/metrics.json") == "results/metrics");
+    REQUIRE(MetricsCollector::basePath("results/metrics") == "results/metrics");
+  }
+}
+
+TEST_CASE("MetricsCollector writes every format", "[metrics]") {
+  MetricsConfig config = makeConfig("test_metrics_dir/run.csv");
+  config.export_formats = {"csv", "json", "binary"};
+  MetricsCollector collector(config);
+  MetricsSnapshot early = makeSnapshot(0);
+  REQUIRE_THROWS_AS(collector.submit(early), std::runtime_error);
+  collector.open();
+  REQUIRE(collector.getFiles().size() == 4);
+
+  for (uint64_t t = 0; t < 3; ++t) {
+    MetricsSnapshot snapshot = makeSnapshot(t * 2000000);
+    collector.submit(snapshot);
+  }
+  REQUIRE(collector.getSampleCount() == 3);
+  REQUIRE(collector.getNextSampleUs() == 6000000);
+
+  MetricsSnapshot wrong = makeSnapshot(6000000);
+  wrong.network_values.pop_back();
+  REQUIRE_THROWS_AS(collector.submit(wrong), std::invalid_argument);
+  collector.close();
+
+  SECTION("csv has one row per node and one network row per sample") {
+    const std::string nodes = readText("test_metrics_dir/run.csv");
+    REQUIRE(nodes.find("time_ms,node,messages_sent,messages_received\n"
+                       "0,1,10,1\n0,2,20,2\n0,3,30,3\n2000,1,10,1\n") == 0);
+    REQUIRE(std::count(nodes.begin(), nodes.end(), '\n') == 10);
+
+    const std::string network = readText("test_metrics_dir/run_network.csv");
+    REQUIRE(network == "time_ms,nodes,messages_sent,messages_received,delivery_rate\n"
+                       "0,3,60,6,0.5\n2000,3,60,6,0.5\n4000,3,60,6,0.5\n");
+  }
+
+  SECTION("json has one columnar object per line") {
+    std::istringstream lines(readText("test_metrics_dir/run.json"));
+    std::string line;
+    std::getline(lines, line);
+    REQUIRE(line == "{\"time_ms\":0,\"nodes\":[1,2,3],"
+                    "\"node\":{\"messages_sent\":[10,20,30],\"messages_received\":[1,2,3]},"
+                    "\"network\":{\"messages_sent\":60,\"messages_received\":6,"
+                    "\"delivery_rate\":0.5}}");
+    int count = 1;
+    while (std::getline(lines, line)) {
+      count++;
+    }
+    REQUIRE(count == 3);
+  }
+
+  SECTION("binary holds the names and raw column arrays") {
+    const std::string bytes = readText("test_metrics_dir/run.pmm");
+    REQUIRE(bytes.compare(0, 8, std::string(MetricsCollector::BINARY_MAGIC, 8)) == 0);
+
+    size_t pos = 8;
+    auto read32 = [&]() {
+      uint32_t value;
+      std::memcpy(&value, bytes.data() + pos, sizeof(value));
+      pos += sizeof(value);
+      return value;
+    };
+    REQUIRE(read32() == MetricsCollector::BINARY_VERSION);
+    REQUIRE(read32() == 2);
+    for (const char* name : {"messages_sent", "messages_received"}) {
+      const uint32_t length = read32();
+      REQUIRE(bytes.substr(pos, length) == name);
+      pos += length;
+    }
+    REQUIRE(read32() == 3);
+    for (int i = 0; i < 3; ++i) {
+      pos += read32();
+    }
+
+    // time_us, count, 3 ids, 2 x 3 values, 3 network values
+    const size_t sample_size = 8 + 4 + 3 * 4 + 6 * 8 + 3 * 8;
+    REQUIRE(bytes.size() == pos + 3 * sample_size);
+    uint64_t values[6];
+    std::memcpy(values, bytes.data() + pos + sample_size + 8 + 4 + 3 * 4, sizeof(values));
+    REQUIRE(values[2] == 30);
+    REQUIRE(values[3] == 1);
+  }
+
+  std::remove("test_metrics_dir/run.csv");
+  std::remove("test_metrics_dir/run_network.csv");
+  std::remove("test_metrics_dir/run.json");
+  std::remove("test_metrics_dir/run.pmm");
+  std::remove("test_metrics_dir");
+}
+
+TEST_CASE("MetricsCollector samples the simulation", "[metrics]") {
+  boost::asio::io_context io;
+  NodeManager manager(io);
+  NetworkSimulator network(1);
+
+  MetricsConfig config = makeConfig("test_metrics_sample.csv");
+  config.collect.clear();
+  MetricsCollector collector(config);
+  collector.open();
+
+  collector.sample(500000, manager, network, nullptr);
+  REQUIRE(collector.getNextSampleUs() == 2000000);
+  collector.sample(2000000, manager, network, nullptr);
+  REQUIRE(collector.getNextSampleUs() == 4000000);
+  collector.close();
+
+  const std::string network_csv = readText("test_metrics_sample_network.csv");
+  std::istringstream lines(network_csv);
+  std::string header;
+  std::getline(lines, header);
+  REQUIRE(header.find("time_ms,nodes,messages_sent,") == 0);
+  std::string row;
+  std::getline(lines, row);
+  REQUIRE(row.find("500,0,0,0,") == 0);
+
+  std::remove("test_metrics_sample.csv");
+  std::remove("test_metrics_sample_network.csv");
+}
+
+TEST_CASE("MetricsCollector counts link statistics per interval", "[metrics]") {
+  boost::asio::io_context io;
+  NodeManager manager(io);
+  NetworkSimulator network(1);
+  LatencyConfig latency;
+  latency.min_ms = 10;
+  latency.max_ms = 10;
+  network.setDefaultLatency(latency);
+
+  MetricsConfig config = makeConfig("test_metrics_links.csv");
+  config.collect = {"link_stats"};
+  MetricsCollector collector(config);
+  REQUIRE(collector.getNetworkColumns() ==
+          std::vector<std::string>{"link_messages", "link_delivered", "link_dropped",
+                                   "link_throttled", "link_bytes", "link_latency_avg_ms",
+                                   "active_links"});
+  collector.open();
+
+  network.enqueueMessage(1, 2, Payload("x"), 0);
+  network.enqueueMessage(2, 1, Payload("y"), 0);
+  collector.sample(0, manager, network, nullptr);
+  network.enqueueMessage(1, 2, Payload("z"), 1000);
+  collector.sample(2000000, manager, network, nullptr);
+  collector.sample(4000000, manager, network, nullptr);
+  collector.close();
+
+  std::istringstream lines(readText("test_metrics_links_network.csv"));
+  std::string row;
+  std::getline(lines, row);
+  REQUIRE(row == "time_ms,nodes,link_messages,link_delivered,link_dropped,link_throttled,"
+                 "link_bytes,link_latency_avg_ms,active_links");
+  std::getline(lines, row);
+  REQUIRE(row.find("0,0,2,2,0,0,") == 0);
+  REQUIRE(row.substr(row.size() - 5) == ",10,2");
+  std::getline(lines, row);
+  REQUIRE(row.find("2000,0,1,1,0,0,") == 0);
+  REQUIRE(row.substr(row.size() - 5) == ",10,1");
+  std::getline(lines, row);
+  REQUIRE(row.find("4000,0,0,0,0,0,") == 0);
+  REQUIRE(row.substr(row.size() - 4) == ",0,0");
+
+  std::remove("test_metrics_links.csv");
+  std::remove("test_metrics_links_network.csv");
+}
@@ -0,0 +1,138 @@
+/**
+ * @file test_metrics_endpoint.cpp
+ * @brief Unit tests for MetricsEndpoint
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/metrics_endpoint.hpp"
+#include "simulator/node_manager.hpp"
+
+#include <boost/asio.hpp>
+#include <string>
+
+using namespace simulator;
+
+namespace {
+
+bool contains(const std::string& text, const std::string& line) {
+  return text.find(line) != std::string::npos;
+}
+
+// Sends one HTTP request to the endpoint and returns the whole response
+std::string httpRequest(uint16_t port, const std::string& request) {
+  boost::asio::io_context io;
+  boost::asio::ip::tcp::socket socket(io);
+  socket.connect(boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), port));
+  boost::asio::write(socket, boost::asio::buffer(request));
+
+  std::string response;
+  boost::system::error_code ec;
+  char buffer[4096];
+  for (;;) {
+    size_t n = socket.read_some(boost::asio::buffer(buffer), ec);
+    response.append(buffer, n);
+    if (ec) {
+      break;
+    }
+  }
+  return response;
+}
+
+} // anonymous namespace
+
+TEST_CASE("MetricsEndpoint renders the Prometheus text format", "[metrics_endpoint]") {
+  LiveSnapshot snapshot;
+  snapshot.virtual_us = 2500000;
+  snapshot.updates = 250;
+  snapshot.tick_rate = 1000.0;
+  snapshot.time_ratio = 10.0;
+  snapshot.nodes = 3;
+  snapshot.nodes_running = 2;
+  snapshot.pending_messages = 7;
+  snapshot.frames.frames_dropped = 4;
+
+  NetworkSimulator::LinkCounters link;
+  link.from = 1;
+  link.to = 2;
+  link.message_count = 3;
+  link.dropped_count = 1;
+  link.bandwidth_throttled = 5;
+  link.total_latency_ms = 60;
+  snapshot.links = {link, link};
+  snapshot.links[1].from = 2;
+  snapshot.links[1].to = 1;
+  snapshot.link_latency.assign(2 * MetricsEndpoint::LATENCY_BOUND_COUNT, 3);
+  snapshot.link_latency[0] = 0;   // 1 -> 2: nothing at or below 1ms
+
+  std::string text;
+  MetricsEndpoint::render(snapshot, text);
+  REQUIRE(contains(text, "# TYPE painlessmesh_sim_updates_total counter\n"));
+  REQUIRE(contains(text, "\npainlessmesh_sim_virtual_seconds 2.500000\n"));
+  REQUIRE(contains(text, "\npainlessmesh_sim_updates_total 250\n"));
+  REQUIRE(contains(text, "\npainlessmesh_sim_time_ratio 10.000000\n"));
+  REQUIRE(contains(text, "\npainlessmesh_sim_nodes{state=\"running\"} 2\n"));
+  REQUIRE(contains(text, "\npainlessmesh_sim_queue_depth{queue=\"messages\"} 7\n"));
+  REQUIRE(contains(text, "\npainlessmesh_sim_frames_total{kind=\"dropped\"} 4\n"));
+  REQUIRE(contains(text, "\npainlessmesh_sim_link_dropped_total{from=\"1\",to=\"2\"} 1\n"));
+  REQUIRE(contains(text, "\npainlessmesh_sim_link_throttled_total{from=\"2\",to=\"1\"} 5\n"));
+  REQUIRE(contains(text, "\npainlessmesh_sim_link_latency_ms_bucket{from=\"1\",to=\"2\",le=\"1\"} 0\n"));
+  REQUIRE(contains(text, "\npainlessmesh_sim_link_latency_ms_bucket{from=\"1\",to=\"2\",le=\"+Inf\"} 3\n"));
+  REQUIRE(contains(text, "\npainlessmesh_sim_link_latency_ms_sum{from=\"1\",to=\"2\"} 60\n"));
+  REQUIRE(contains(text, "\npainlessmesh_sim_latency_ms_bucket{le=\"1\"} 3\n"));
+  REQUIRE(contains(text, "\npainlessmesh_sim_latency_ms_bucket{le=\"10000\"} 6\n"));
+  REQUIRE(contains(text, "\npainlessmesh_sim_latency_ms_count 6\n"));
+}
+
+TEST_CASE("MetricsEndpoint publishes simulation snapshots", "[metrics_endpoint]") {
+  boost::asio::io_context io;
+  NodeManager manager(io);
+  NetworkSimulator network(1);
+  LatencyConfig latency;
+  latency.min_ms = 15;
+  latency.max_ms = 15;
+  network.setDefaultLatency(latency);
+  network.enqueueMessage(1, 2, Payload("a"), 0);
+  network.enqueueMessage(1, 2, Payload("b"), 0);
+
+  MetricsEndpoint endpoint(0, 50);
+  REQUIRE(endpoint.isDue());
+  endpoint.publish(1000000, 100, manager, network, nullptr, nullptr);
+  REQUIRE(endpoint.getPublishCount() == 1);
+  REQUIRE_FALSE(endpoint.isDue());
+
+  const std::string text = endpoint.scrape();
+  REQUIRE(contains(text, "\npainlessmesh_sim_queue_depth{queue=\"messages\"} 2\n"));
+  REQUIRE(contains(text, "\npainlessmesh_sim_link_messages_total{from=\"1\",to=\"2\"} 2\n"));
+  REQUIRE(contains(text, "\npainlessmesh_sim_link_latency_ms_bucket{from=\"1\",to=\"2\",le=\"10\"} 0\n"));
+  REQUIRE(contains(text, "\npainlessmesh_sim_link_latency_ms_bucket{from=\"1\",to=\"2\",le=\"20\"} 2\n"));
+  REQUIRE(contains(text, "\npainlessmesh_sim_latency_ms_sum 30\n"));
+}
+
+TEST_CASE("MetricsEndpoint serves HTTP scrapes", "[metrics_endpoint]") {
+  MetricsEndpoint endpoint(0);
+  REQUIRE(endpoint.getPort() != 0);
+  LiveSnapshot& snapshot = endpoint.nextSnapshot();
+  snapshot.updates = 42;
+  endpoint.publishSnapshot();
+  endpoint.start();
+
+  const std::string ok = httpRequest(endpoint.getPort(),
+                                     "GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n");
+  REQUIRE(ok.find("HTTP/1.1 200 OK\r\n") == 0);
+  REQUIRE(contains(ok, "Content-Type: text/plain; version=0.0.4"));
+  REQUIRE(contains(ok, "\npainlessmesh_sim_updates_total 42\n"));
+
+  const std::string missing = httpRequest(endpoint.getPort(),
+                                          "GET / HTTP/1.1\r\nHost: localhost\r\n\r\n");
+  REQUIRE(missing.find("HTTP/1.1 404") == 0);
+
+  const std::string post = httpRequest(endpoint.getPort(),
+                                       "POST /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n");
+  REQUIRE(post.find("HTTP/1.1 405") == 0);
+
+  endpoint.stop();
+}
@@ -9,8 +9,14 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 
+#include "simulator/checkpoint.hpp"
 #include "simulator/network_simulator.hpp"
 
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <vector>
+
 using namespace simulator;
 
 TEST_CASE("NetworkSimulator construction", "[network_simulator]") {
@@ -192,6 +198,17 @@ TEST_CASE("NetworkSimulator message delivery", "[network_simulator]") {
     REQUIRE(ready[1].message == "third");
   }
   
+  SECTION("reports the earliest pending delivery") {
+    REQUIRE(sim.getNextDeliveryTime() == UINT64_MAX);
+    sim.enqueueMessage(1, 2, "later", 1010);
+    sim.enqueueMessage(2, 3, "sooner", 1000);
+    REQUIRE(sim.getNextDeliveryTime() <= 1050);
+    REQUIRE(sim.getReadyMessages(sim.getNextDeliveryTime() - 1).empty());
+    
+    sim.getReadyMessages(1060);
+    REQUIRE(sim.getNextDeliveryTime() == UINT64_MAX);
+  }
+  
   SECTION("getReadyMessages removes messages from queue") {
     sim.enqueueMessage(1, 2, "test", 1000);
     REQUIRE(sim.getPendingMessageCount() == 1);
@@ -211,6 +228,54 @@ TEST_CASE("NetworkSimulator message delivery", "[network_simulator]") {
   }
 }
 
+TEST_CASE("NetworkSimulator drain API", "[network_simulator]") {
+  NetworkSimulator sim(12345);
+  LatencyConfig config;
+  config.min_ms = 50;
+  config.max_ms = 50;  // Fixed latency
+  sim.setDefaultLatency(config);
+  
+  sim.enqueueMessage(1, 2, "first", 1000);   // Delivery at 1050
+  sim.enqueueMessage(3, 4, "second", 1005);  // Delivery at 1055
+  
+  SECTION("drainReady visits ready messages in order") {
+    std::vector<std::string> seen;
+    auto visitor = [&seen](DelayedMessage& message) {
+      seen.push_back(message.message.str());
+    };
+    
+    REQUIRE(sim.drainReady(1049, visitor) == 0);
+    REQUIRE(seen.empty());
+    
+    REQUIRE(sim.drainReady(1055, visitor) == 2);
+    REQUIRE(seen == std::vector<std::string>{"first", "second"});
+    REQUIRE(sim.getPendingMessageCount() == 0);
+  }
+  
+  SECTION("messages enqueued by the visitor are delivered later") {
+    size_t visited = sim.drainReady(1050, [&sim](DelayedMessage& message) {
+      sim.enqueueMessage(message.to, message.from, "reply", 1050);
+    });
+    REQUIRE(visited == 1);
+    REQUIRE(sim.getPendingMessageCount() == 2);
+    
+    std::vector<std::string> seen;
+    sim.drainReady(1100, [&seen](DelayedMessage& message) {
+      seen.push_back(message.message.str());
+    });
+    REQUIRE(seen == std::vector<std::string>{"second", "reply"});
+  }
+  
+  SECTION("getReadyMessages appends to a caller buffer") {
+    std::vector<DelayedMessage> buffer;
+    REQUIRE(sim.getReadyMessages(1049, buffer) == 0);
+    REQUIRE(sim.getReadyMessages(1050, buffer) == 1);
+    REQUIRE(sim.getReadyMessages(1055, buffer) == 1);
+    REQUIRE(buffer.size() == 2);
+    REQUIRE(buffer[1].message == "second");
+  }
+}
+
 TEST_CASE("NetworkSimulator uniform distribution", "[network_simulator]") {
   NetworkSimulator sim(12345);
   
@@ -265,6 +330,115 @@ TEST_CASE("NetworkSimulator uniform distribution", "[network_simulator]") {
   }
 }
 
+TEST_CASE("NetworkSimulator multicast enqueue", "[network_simulator]") {
+  auto configure = [](NetworkSimulator& sim, bool mixed) {
+    LatencyConfig latency;
+    latency.min_ms = 10;
+    latency.max_ms = 200;
+    latency.distribution = DistributionType::NORMAL;
+    sim.setDefaultLatency(latency);
+    
+    PacketLossConfig loss;
+    loss.probability = 0.3f;
+    sim.setDefaultPacketLoss(loss);
+    
+    if (mixed) {
+      LatencyConfig wide;  // Too wide to tabulate
+      wide.min_ms = 0;
+      wide.max_ms = 1000000;
+      wide.distribution = DistributionType::EXPONENTIAL;
+      sim.setLatency(1, 3, wide);
+    }
+  };
+  
+  auto deliveries = [](NetworkSimulator& sim) {
+    std::vector<std::pair<uint32_t, uint64_t>> out;
+    sim.drainReady(UINT64_MAX, [&out](DelayedMessage& message) {
+      out.emplace_back(message.to, message.deliveryTime);
+    });
+    std::sort(out.begin(), out.end());
+    return out;
+  };
+  
+  const std::vector<uint32_t> targets{2, 3, 4, 5, 6, 7, 8, 9};
+  
+  for (bool mixed : {false, true}) {
+    SECTION(std::string("matches per-destination enqueueMessage") + (mixed ? " (mixed samplers)" : "")) {
+      NetworkSimulator single(12345);
+      NetworkSimulator multi(12345);
+      configure(single, mixed);
+      configure(multi, mixed);
+      
+      size_t queued = 0;
+      for (uint64_t t = 0; t < 50; ++t) {
+        for (uint32_t to : targets) {
+          single.enqueueMessage(1, to, "flood", t);
+        }
+        queued += multi.enqueueMulticast(1, targets, "flood", t);
+      }
+      
+      REQUIRE(queued == multi.getPendingMessageCount());
+      REQUIRE(single.getPendingMessageCount() == multi.getPendingMessageCount());
+      for (uint32_t to : targets) {
+        REQUIRE(single.getStats(1, to).dropped_count == multi.getStats(1, to).dropped_count);
+        REQUIRE(single.getStats(1, to).avg_latency_ms == multi.getStats(1, to).avg_latency_ms);
+      }
+      REQUIRE(deliveries(single) == deliveries(multi));
+    }
+  }
+  
+  SECTION("all deliveries share one payload buffer") {
+    NetworkSimulator sim(12345);
+    Payload payload(std::string(1024, 'x'));
+    REQUIRE(sim.enqueueMulticast(1, targets, payload, 0) == targets.size());
+    
+    std::vector<Payload> received;
+    sim.drainReady(UINT64_MAX, [&received](DelayedMessage& message) {
+      received.push_back(message.message);
+    });
+    REQUIRE(received.size() == targets.size());
+    for (const auto& copy : received) {
+      REQUIRE(copy.sharesBufferWith(payload));
+    }
+  }
+}
+
+TEST_CASE("NetworkSimulator per-link random streams", "[network_simulator]") {
+  LatencyConfig config;
+  config.min_ms = 10;
+  config.max_ms = 500;
+  config.distribution = DistributionType::UNIFORM;
+  
+  auto latencies = [&config](bool with_other_traffic) {
+    NetworkSimulator sim(12345);
+    sim.setDefaultLatency(config);
+    for (int i = 0; i < 20; ++i) {
+      if (with_other_traffic) {
+        sim.enqueueMessage(3, 4, "noise", 0);
+        sim.enqueueMessage(5, 6, "noise", 0);
+      }
+      sim.enqueueMessage(1, 2, "signal", 0);
+    }
+    
+    std::vector<uint64_t> times;
+    sim.drainReady(UINT64_MAX, [&times](DelayedMessage& message) {
+      if (message.from == 1) {
+        times.push_back(message.deliveryTime);
+      }
+    });
+    return times;
+  };
+  
+  SECTION("other links do not shift a link's samples") {
+    REQUIRE(latencies(false) == latencies(true));
+  }
+  
+  SECTION("seed is reported") {
+    NetworkSimulator sim(777);
+    REQUIRE(sim.getSeed() == 777);
+  }
+}
+
 TEST_CASE("NetworkSimulator normal distribution", "[network_simulator]") {
   NetworkSimulator sim(12345);
   
@@ -417,6 +591,44 @@ TEST_CASE("NetworkSimulator statistics", "[network_simulator]") {
   }
 }
 
+TEST_CASE("NetworkSimulator latency percentiles", "[network_simulator]") {
+  NetworkSimulator sim(12345);
+  LatencyConfig fast;
+  fast.min_ms = 10;
+  fast.max_ms = 10;
+  LatencyConfig slow;
+  slow.min_ms = 200;
+  slow.max_ms = 200;
+  sim.setLatency(1, 2, fast);
+  sim.setLatency(3, 4, slow);
+  
+  for (int i = 0; i < 99; ++i) {
+    sim.enqueueMessage(1, 2, "fast", 0);
+  }
+  sim.enqueueMessage(3, 4, "slow", 0);
+  
+  SECTION("per-link percentiles") {
+    auto stats = sim.getStats(1, 2);
+    REQUIRE(stats.p50_latency_ms == 10);
+    REQUIRE(stats.p999_latency_ms == 10);
+    REQUIRE(sim.getLatencyHistogram(3, 4).getCount() == 1);
+    REQUIRE(sim.getLatencyHistogram(5, 6).getCount() == 0);
+  }
+  
+  SECTION("global histogram merges all links") {
+    auto global = sim.getGlobalLatencyHistogram();
+    REQUIRE(global.getCount() == 100);
+    REQUIRE(global.getPercentile(99.0) == 10);
+    REQUIRE(global.getPercentile(99.9) == 200);
+  }
+  
+  SECTION("resetStats clears histograms") {
+    sim.resetStats();
+    REQUIRE(sim.getGlobalLatencyHistogram().getCount() == 0);
+    REQUIRE(sim.getStats(1, 2).p99_latency_ms == 0);
+  }
+}
+
 TEST_CASE("Distribution type conversion", "[network_simulator]") {
   SECTION("distributionTypeToString") {
     REQUIRE(distributionTypeToString(DistributionType::UNIFORM) == "uniform");
@@ -783,6 +995,65 @@ TEST_CASE("NetworkSimulator packet loss statistics", "[network_simulator][packet
   }
 }
 
+TEST_CASE("NetworkSimulator snapshots link statistics as columns", "[network_simulator]") {
+  NetworkSimulator sim(42);
+  LatencyConfig latency;
+  latency.min_ms = 10;
+  latency.max_ms = 10;
+  sim.setDefaultLatency(latency);
+  PacketLossConfig lossy;
+  lossy.probability = 1.0f;
+  sim.setPacketLoss(2, 3, lossy);
+  
+  for (int i = 0; i < 4; ++i) {
+    sim.enqueueMessage(1, 2, "test", i * 100);
+  }
+  sim.enqueueMessage(2, 3, "test", 0);
+  
+  NetworkSimulator::LinkStatsColumns current;
+  NetworkSimulator::LinkStatsColumns delta;
+  REQUIRE(sim.snapshotStats(current, &delta) == 2);
+  
+  // Rows follow the dense link order: 2->3 got its record first
+  REQUIRE(current.size() == 2);
+  REQUIRE(current.from == std::vector<uint32_t>{2, 1});
+  REQUIRE(current.to == std::vector<uint32_t>{3, 2});
+  REQUIRE(current.dropped_count[0] == 1);
+  REQUIRE(current.delivered_count[1] == 4);
+  REQUIRE(current.message_count[1] == 4);
+  REQUIRE(current.total_latency_ms[1] == 40);
+  
+  const auto stats = sim.getStats(1, 2);
+  REQUIRE(current.delivered_count[1] == stats.delivered_count);
+  REQUIRE(current.bytes_sent[1] == stats.bytes_sent);
+  
+  SECTION("the first delta is the full count") {
+    REQUIRE(delta.from == current.from);
+    REQUIRE(delta.delivered_count == current.delivered_count);
+    REQUIRE(delta.dropped_count == current.dropped_count);
+  }
+  
+  SECTION("later deltas count the change, new links included") {
+    sim.enqueueMessage(1, 2, "test", 1000);
+    sim.enqueueMessage(3, 1, "test", 1000);
+    REQUIRE(sim.snapshotStats(current, &delta) == 3);
+    REQUIRE(delta.size() == 3);
+    REQUIRE(delta.from[2] == 3);
+    REQUIRE(delta.to[2] == 1);
+    REQUIRE(delta.delivered_count == std::vector<uint64_t>{0, 1, 1});
+    REQUIRE(delta.dropped_count == std::vector<uint64_t>{0, 0, 0});
+    REQUIRE(current.delivered_count[1] == 5);
+  }
+  
+  SECTION("a reset restarts the deltas") {
+    sim.resetStats();
+    sim.enqueueMessage(1, 2, "test", 1000);
+    REQUIRE(sim.snapshotStats(current, &delta) == 1);
+    REQUIRE(delta.delivered_count == std::vector<uint64_t>{0, 1});
+    REQUIRE(current.delivered_count == std::vector<uint64_t>{0, 1});
+  }
+}
+
 TEST_CASE("NetworkSimulator packet loss integration with message delivery", "[network_simulator][packet_loss]") {
   NetworkSimulator sim(42);
   
@@ -996,6 +1267,20 @@ TEST_CASE("NetworkSimulator token bucket refill", "[network_simulator][bandwidth
     REQUIRE(sim.canSendMessage(1, 2, 10, 1000) == false);
   }
   
+  SECTION("an earlier time does not refill the bucket") {
+    BandwidthConfig config;
+    config.max_bytes_per_sec = 1000;
+    config.bucket_size = 500;
+    sim.setBandwidth(1, 2, config);
+    
+    REQUIRE(sim.canSendMessage(1, 2, 500, 1000) == true);
+    sim.consumeBandwidth(1, 2, 500, 1000);
+    
+    // A send replayed with an older timestamp sees the exhausted bucket
+    REQUIRE(sim.canSendMessage(1, 2, 100, 900) == false);
+    REQUIRE(sim.canSendMessage(1, 2, 100, 1100) == true);
+  }
+  
   SECTION("tokens don't exceed bucket size") {
     BandwidthConfig config;
     config.max_bytes_per_sec = 1000;
@@ -1010,6 +1295,65 @@ TEST_CASE("NetworkSimulator token bucket refill", "[network_simulator][bandwidth
     // Should not have more tokens available
     REQUIRE(sim.canSendMessage(1, 2, 100, 10000) == false);
   }
+  
+  SECTION("millisecond steps refill exactly") {
+    BandwidthConfig config;
+    config.max_messages_per_sec = 10;  // A token every 100ms
+    config.bucket_size = 1;
+    sim.setBandwidth(1, 2, config);
+    
+    REQUIRE(sim.canSendMessage(1, 2, 10, 0) == true);
+    sim.consumeBandwidth(1, 2, 10, 0);
+    
+    // Each step earns a hundredth of a token; none of it is lost
+    for (uint64_t t = 1; t < 100; ++t) {
+      REQUIRE(sim.canSendMessage(1, 2, 10, t) == false);
+    }
+    REQUIRE(sim.canSendMessage(1, 2, 10, 100) == true);
+  }
+}
+
+TEST_CASE("NetworkSimulator shares airtime between neighbours", "[network_simulator][airtime]") {
+  NetworkSimulator sim(42);
+  
+  LatencyConfig latency;
+  latency.min_ms = 10;
+  latency.max_ms = 10;
+  sim.setDefaultLatency(latency);
+  
+  AirtimeConfig airtime;
+  airtime.bitrate_bps = 8000000;  // A byte per microsecond
+  airtime.frame_overhead_us = 0;
+  airtime.contention_window = 1;  // No backoff
+  sim.setAirtime(airtime);
+  sim.setNeighbours({{1, {2, 3}}, {2, {1}}, {3, {1}}});
+  REQUIRE(sim.getAirtime().isEnabled());
+  
+  SECTION("frames of one domain queue for the medium") {
+    sim.enqueueMessage(1, 2, std::string(2000, 'x'), 0);
+    sim.enqueueMessage(3, 1, std::string(2000, 'x'), 0);
+    
+    REQUIRE(sim.getReadyMessages(12).size() == 1);   // 2 ms on air
+    REQUIRE(sim.getReadyMessages(13).empty());
+    REQUIRE(sim.getReadyMessages(14).size() == 1);   // Waited 2 ms, then 2 ms on air
+    REQUIRE(sim.getAirtimeStats().wait_us == 2000);
+  }
+  
+  SECTION("a saturated medium throttles") {
+    airtime.max_wait_ms = 1;
+    sim.setAirtime(airtime);
+    sim.enqueueMessage(1, 2, std::string(5000, 'x'), 0);
+    sim.enqueueMessage(3, 1, std::string(10, 'x'), 0);
+    
+    REQUIRE(sim.getPendingMessageCount() == 1);
+    REQUIRE(sim.getStats(3, 1).bandwidth_throttled == 1);
+    REQUIRE(sim.getAirtimeStats().dropped == 1);
+  }
+  
+  SECTION("rejects an invalid medium") {
+    airtime.contention_window = 0;
+    REQUIRE_THROWS_AS(sim.setAirtime(airtime), std::invalid_argument);
+  }
 }
 
 TEST_CASE("NetworkSimulator bandwidth limiting integration", "[network_simulator][bandwidth]") {
@@ -1145,3 +1489,351 @@ TEST_CASE("NetworkSimulator bandwidth with large messages", "[network_simulator]
     REQUIRE(sent == 200);
   }
 }
+
+TEST_CASE("NetworkSimulator egress filter and injection", "[network_simulator]") {
+  NetworkSimulator sim(12345);
+  LatencyConfig fixed;
+  fixed.min_ms = 20;
+  fixed.max_ms = 20;
+  sim.setDefaultLatency(fixed);
+  
+  std::vector<DelayedMessage> shipped;
+  sim.setEgressFilter([&shipped](DelayedMessage& message) {
+    if (message.to != 2) {
+      return false;
+    }
+    shipped.push_back(std::move(message));
+    return true;
+  });
+  
+  SECTION("claimed messages leave with their delivery time") {
+    sim.enqueueMessage(1, 2, "away", 100);
+    sim.enqueueMessage(1, 3, "home", 100);
+    REQUIRE(sim.getPendingMessageCount() == 1);
+    REQUIRE(shipped.size() == 1);
+    REQUIRE(shipped[0].from == 1);
+    REQUIRE(shipped[0].deliveryTime == 120);
+    REQUIRE(shipped[0].message.str() == "away");
+    REQUIRE(sim.getStats(1, 2).message_count == 1);
+  }
+  
+  SECTION("multicast keeps only unclaimed receivers") {
+    REQUIRE(sim.enqueueMulticast(1, {2, 3, 4}, "all", 0) == 3);
+    REQUIRE(shipped.size() == 1);
+    REQUIRE(sim.getPendingMessageCount() == 2);
+  }
+  
+  SECTION("injected messages are delivered at their delivery time") {
+    NetworkSimulator remote(54321);
+    DelayedMessage message{1, 2, Payload(std::string("hop")), 35};
+    remote.injectMessage(message);
+    REQUIRE(remote.getReadyMessages(34).empty());
+    auto ready = remote.getReadyMessages(35);
+    REQUIRE(ready.size() == 1);
+    REQUIRE(ready[0].message.str() == "hop");
+    REQUIRE(remote.getStats(1, 2).message_count == 0);
+  }
+}
+
+TEST_CASE("NetworkSimulator batches decide the same fates as single sends",
+          "[network_simulator][batch]") {
+  // Every loss model, a bucket, a dropped link, a partition, an
+  // untabulated sampler and a shared medium, on one simulator each
+  auto configure = [](NetworkSimulator& sim) {
+    LatencyConfig latency;
+    latency.min_ms = 5;
+    latency.max_ms = 60;
+    latency.distribution = DistributionType::NORMAL;
+    sim.setDefaultLatency(latency);
+    LatencyConfig wide;
+    wide.min_ms = 1;
+    wide.max_ms = 200000;
+    sim.setLatency(1, 3, wide);
+    
+    PacketLossConfig loss;
+    loss.probability = 0.3f;
+    sim.setDefaultPacketLoss(loss);
+    PacketLossConfig burst;
+    burst.probability = 0.2f;
+    burst.burst_mode = true;
+    sim.setPacketLoss(2, 1, burst);
+    PacketLossConfig chain;
+    chain.gilbert_elliott = true;
+    chain.good_to_bad = 0.1f;
+    chain.bad_to_good = 0.3f;
+    sim.setPacketLoss(3, 1, chain);
+    
+    BandwidthConfig bandwidth;
+    bandwidth.max_messages_per_sec = 20;
+    bandwidth.bucket_size = 3;
+    sim.setBandwidth(1, 2, bandwidth);
+    sim.dropConnection(4, 1);
+    sim.setPartition(5, 1);
+    
+    AirtimeConfig airtime;
+    airtime.bitrate_bps = 1000000;
+    airtime.max_wait_ms = 5;
+    sim.setAirtime(airtime);
+    sim.setNeighbours({{1, {2, 3}}, {2, {1}}, {3, {1}}});
+  };
+  
+  NetworkSimulator single(777);
+  NetworkSimulator batched(777);
+  configure(single);
+  configure(batched);
+  
+  const uint32_t fanout[] = {2, 3, 4, 5};
+  for (uint64_t tick = 0; tick < 200; ++tick) {
+    const size_t pending = batched.getPendingMessageCount();
+    batched.beginBatch();
+    REQUIRE(batched.isBatching());
+    for (uint32_t from = 1; from <= 5; ++from) {
+      const uint32_t to = from == 1 ? 2 + static_cast<uint32_t>(tick % 4) : 1;
+      const std::string text(10 + from * tick % 50, 'x');
+      single.enqueueMessage(from, to, text, tick);
+      batched.enqueueMessage(from, to, text, tick);
+    }
+    single.enqueueMulticast(1, fanout, 4, Payload("fan"), tick);
+    REQUIRE(batched.enqueueMulticast(1, fanout, 4, Payload("fan"), tick) == 0);
+    REQUIRE(batched.getPendingMessageCount() == pending);
+    const size_t queued = batched.flushBatch();
+    REQUIRE_FALSE(batched.isBatching());
+    REQUIRE(batched.getPendingMessageCount() == pending + queued);
+    REQUIRE(batched.getPendingMessageCount() == single.getPendingMessageCount());
+    
+    auto expected = single.getReadyMessages(tick);
+    auto actual = batched.getReadyMessages(tick);
+    REQUIRE(actual.size() == expected.size());
+    for (size_t i = 0; i < actual.size(); ++i) {
+      REQUIRE(actual[i].from == expected[i].from);
+      REQUIRE(actual[i].to == expected[i].to);
+      REQUIRE(actual[i].deliveryTime == expected[i].deliveryTime);
+      REQUIRE(actual[i].message.str() == expected[i].message.str());
+    }
+  }
+  
+  for (uint32_t from = 1; from <= 5; ++from) {
+    for (uint32_t to = 1; to <= 5; ++to) {
+      auto expected = single.getStats(from, to);
+      auto actual = batched.getStats(from, to);
+      REQUIRE(actual.message_count == expected.message_count);
+      REQUIRE(actual.dropped_count == expected.dropped_count);
+      REQUIRE(actual.bandwidth_throttled == expected.bandwidth_throttled);
+      REQUIRE(actual.avg_latency_ms == expected.avg_latency_ms);
+      REQUIRE(actual.max_latency_ms == expected.max_latency_ms);
+    }
+  }
+  REQUIRE(batched.getStats(1, 2).bandwidth_throttled > 0);
+  REQUIRE(batched.getStats(1, 3).dropped_count > 0);
+  REQUIRE(batched.getAirtimeStats().wait_us == single.getAirtimeStats().wait_us);
+}
+
+TEST_CASE("NetworkSimulator batches nest", "[network_simulator][batch]") {
+  NetworkSimulator sim(1);
+  sim.beginBatch();
+  sim.beginBatch();
+  sim.enqueueMessage(1, 2, "x", 0);
+  REQUIRE(sim.flushBatch() == 0);
+  REQUIRE(sim.getPendingMessageCount() == 0);
+  REQUIRE(sim.flushBatch() == 1);
+  REQUIRE(sim.getPendingMessageCount() == 1);
+  REQUIRE(sim.flushBatch() == 0);
+}
+
+TEST_CASE("NetworkSimulator coalesces messages of a link due together",
+          "[network_simulator][coalesce]") {
+  for (QueueBackend backend : {QueueBackend::HEAP, QueueBackend::TIMING_WHEEL}) {
+    NetworkSimulator sim(3);
+    sim.setQueueBackend(backend);
+    LatencyConfig latency;
+    latency.min_ms = 10;
+    latency.max_ms = 10;
+    sim.setDefaultLatency(latency);
+    REQUIRE_FALSE(sim.isCoalescing());
+    sim.setCoalescing(true);
+
+    for (int i = 0; i < 5; ++i) {
+      sim.enqueueMessage(1, 2, "a" + std::to_string(i), 0);
+    }
+    sim.enqueueMessage(1, 3, "b0", 0);
+    sim.enqueueMessage(1, 3, "b1", 0);
+    sim.enqueueMessage(1, 2, "later", 1);
+
+    // One entry per link and millisecond; every message still counts
+    REQUIRE(sim.getCoalescedCount() == 5);
+    REQUIRE(sim.getPendingMessageCount() == 8);
+
+    auto ready = sim.getReadyMessages(10);
+    REQUIRE(ready.size() == 7);
+    REQUIRE(sim.getPendingMessageCount() == 1);
+    std::vector<std::string> to_two;
+    std::vector<std::string> to_three;
+    for (const auto& message : ready) {
+      REQUIRE(message.from == 1);
+      REQUIRE(message.deliveryTime == 10);
+      REQUIRE(message.batch == 0);
+      (message.to == 2 ? to_two : to_three).push_back(message.message.str());
+    }
+    REQUIRE(to_two == std::vector<std::string>{"a0", "a1", "a2", "a3", "a4"});
+    REQUIRE(to_three == std::vector<std::string>{"b0", "b1"});
+    REQUIRE(sim.getStats(1, 2).message_count == 6);
+
+    // A drained batch is closed; the next message starts a new one
+    sim.enqueueMessage(1, 2, "next", 1);
+    REQUIRE(sim.getCoalescedCount() == 6);
+    std::vector<DelayedMessage> out;
+    REQUIRE(sim.getReadyMessages(11, out) == 2);
+    REQUIRE(out[0].message.str() == "later");
+    REQUIRE(out[1].message.str() == "next");
+    REQUIRE(sim.getPendingMessageCount() == 0);
+  }
+}
+
+TEST_CASE("NetworkSimulator coalescing keeps deliveries, link order and statistics",
+          "[network_simulator][coalesce]") {
+  using Delivery = std::tuple<uint64_t, uint32_t, uint32_t, std::string>;
+
+  // The timing wheel is FIFO per millisecond, so the plain run has a
+  // defined per-link order to compare against
+  auto configure = [](NetworkSimulator& sim) {
+    sim.setQueueBackend(QueueBackend::TIMING_WHEEL);
+    LatencyConfig latency;
+    latency.min_ms = 1;
+    latency.max_ms = 3;
+    sim.setDefaultLatency(latency);
+    PacketLossConfig loss;
+    loss.probability = 0.2f;
+    sim.setDefaultPacketLoss(loss);
+  };
+  NetworkSimulator plain(99);
+  NetworkSimulator coalesced(99);
+  configure(plain);
+  configure(coalesced);
+  coalesced.setCoalescing(true);
+
+  int sequence = 0;
+  for (uint64_t tick = 0; tick < 300; ++tick) {
+    for (auto* sim : {&plain, &coalesced}) {
+      sim->beginBatch();
+    }
+    for (uint32_t from = 1; from <= 3; ++from) {
+      for (int burst = 0; burst < 4; ++burst) {
+        const std::string text = std::to_string(sequence++);
+        const uint32_t to = from % 3 + 1;
+        plain.enqueueMessage(from, to, text, tick);
+        coalesced.enqueueMessage(from, to, text, tick);
+      }
+    }
+    // Single sends coalesce too
+    coalesced.flushBatch();
+    plain.flushBatch();
+    plain.enqueueMessage(1, 3, "single", tick);
+    coalesced.enqueueMessage(1, 3, "single", tick);
+    REQUIRE(coalesced.getPendingMessageCount() == plain.getPendingMessageCount());
+
+    std::vector<Delivery> expected;
+    for (const auto& m : plain.getReadyMessages(tick)) {
+      expected.emplace_back(m.deliveryTime, m.from, m.to, m.message.str());
+    }
+    std::vector<Delivery> actual;
+    coalesced.drainReady(tick, [&](DelayedMessage& m) {
+      actual.emplace_back(m.deliveryTime, m.from, m.to, m.message.str());
+    });
+
+    // Each link keeps its send order...
+    auto byLink = [](const std::vector<Delivery>& deliveries) {
+      std::map<std::pair<uint32_t, uint32_t>, std::vector<Delivery>> links;
+      for (const auto& d : deliveries) {
+        links[{std::get<1>(d), std::get<2>(d)}].push_back(d);
+      }
+      return links;
+    };
+    REQUIRE(byLink(actual) == byLink(expected));
+
+    // ...but links interleave differently (see the next test)
+    std::sort(expected.begin(), expected.end());
+    std::sort(actual.begin(), actual.end());
+    REQUIRE(actual == expected);
+  }
+
+  REQUIRE(coalesced.getCoalescedCount() > 0);
+  for (uint32_t from = 1; from <= 3; ++from) {
+    const uint32_t to = from % 3 + 1;
+    REQUIRE(coalesced.getStats(from, to).message_count == plain.getStats(from, to).message_count);
+    REQUIRE(coalesced.getStats(from, to).dropped_count == plain.getStats(from, to).dropped_count);
+    REQUIRE(coalesced.getStats(from, to).avg_latency_ms == plain.getStats(from, to).avg_latency_ms);
+  }
+}
+
+TEST_CASE("NetworkSimulator coalescing may reorder equal-time deliveries across links",
+          "[network_simulator][coalesce]") {
+  auto drainOrder = [](bool coalesce) {
+    NetworkSimulator sim(8);
+    sim.setQueueBackend(QueueBackend::TIMING_WHEEL);
+    LatencyConfig latency;
+    latency.min_ms = 5;
+    latency.max_ms = 5;
+    sim.setDefaultLatency(latency);
+    sim.setCoalescing(coalesce);
+    sim.enqueueMessage(1, 2, "A1", 0);
+    sim.enqueueMessage(1, 3, "B1", 0);
+    sim.enqueueMessage(1, 2, "A2", 0);
+    std::vector<std::string> order;
+    for (const auto& m : sim.getReadyMessages(5)) {
+      order.push_back(m.message.str());
+    }
+    return order;
+  };
+
+  // The timing wheel is FIFO per millisecond; A2 joins A1's entry
+  REQUIRE(drainOrder(false) == std::vector<std::string>{"A1", "B1", "A2"});
+  REQUIRE(drainOrder(true) == std::vector<std::string>{"A1", "A2", "B1"});
+}
+
+TEST_CASE("NetworkSimulator coalesced batches survive checkpoints and clear",
+          "[network_simulator][coalesce]") {
+  NetworkSimulator sim(5);
+  LatencyConfig latency;
+  latency.min_ms = 4;
+  latency.max_ms = 4;
+  sim.setDefaultLatency(latency);
+  sim.setCoalescing(true);
+  sim.enqueueMessage(1, 2, "x", 0);
+  sim.enqueueMessage(1, 2, "y", 0);
+  sim.enqueueMessage(1, 2, "x", 0);
+  REQUIRE(sim.getPendingMessageCount() == 3);
+
+  SECTION("a checkpoint holds every message") {
+    CheckpointWriter out;
+    sim.saveState(out);
+    std::vector<uint8_t> bytes = out.release();
+
+    NetworkSimulator restored(5);
+    CheckpointReader in(bytes);
+    restored.loadState(in);
+    REQUIRE(in.remaining() == 0);
+    REQUIRE(restored.getPendingMessageCount() == 3);
+    auto ready = restored.getReadyMessages(4);
+    REQUIRE(ready.size() == 3);
+    std::vector<std::string> bodies;
+    for (const auto& message : ready) {
+      bodies.push_back(message.message.str());
+    }
+    std::sort(bodies.begin(), bodies.end());
+    REQUIRE(bodies == std::vector<std::string>{"x", "x", "y"});
+  }
+
+  SECTION("clear drops the batches") {
+    sim.clear();
+    REQUIRE(sim.getPendingMessageCount() == 0);
+    REQUIRE(sim.getReadyMessages(4).empty());
+    sim.enqueueMessage(1, 2, "z", 1);
+    REQUIRE(sim.getReadyMessages(5).size() == 1);
+  }
+
+  SECTION("switching the queue backend keeps the batches") {
+    sim.setQueueBackend(QueueBackend::TIMING_WHEEL);
+    REQUIRE(sim.getPendingMessageCount() == 3);
+    REQUIRE(sim.getReadyMessages(4).size() == 3);
+  }
+}
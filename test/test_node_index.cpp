@@ -0,0 +1,79 @@
+/**
+ * @file test_node_index.cpp
+ * @brief Unit tests for NodeIndex class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/node_index.hpp"
+
+#include <map>
+
+using namespace simulator;
+
+TEST_CASE("NodeIndex maps node IDs to handles", "[node_index]") {
+  NodeIndex index;
+
+  SECTION("starts empty") {
+    REQUIRE(index.size() == 0);
+    REQUIRE_FALSE(index.find(1).valid());
+    REQUIRE_FALSE(index.erase(1));
+  }
+
+  SECTION("insert, find and erase") {
+    REQUIRE(index.insert(1001, SlotHandle{0, 0}));
+    REQUIRE(index.insert(1002, SlotHandle{1, 3}));
+    REQUIRE(index.size() == 2);
+
+    REQUIRE(index.find(1001) == (SlotHandle{0, 0}));
+    REQUIRE(index.find(1002) == (SlotHandle{1, 3}));
+    REQUIRE_FALSE(index.find(1003).valid());
+
+    REQUIRE(index.erase(1001));
+    REQUIRE_FALSE(index.find(1001).valid());
+    REQUIRE(index.find(1002) == (SlotHandle{1, 3}));
+    REQUIRE(index.size() == 1);
+  }
+
+  SECTION("rejects duplicates and ID 0") {
+    REQUIRE(index.insert(7, SlotHandle{0, 0}));
+    REQUIRE_FALSE(index.insert(7, SlotHandle{5, 5}));
+    REQUIRE(index.find(7) == (SlotHandle{0, 0}));
+    REQUIRE_FALSE(index.insert(0, SlotHandle{1, 0}));
+    REQUIRE_FALSE(index.find(0).valid());
+  }
+}
+
+TEST_CASE("NodeIndex stays consistent under churn", "[node_index]") {
+  NodeIndex index;
+  std::map<uint32_t, SlotHandle> reference;
+
+  // Grow past the initial capacity, then erase every third entry so
+  // backward shifts run through long probe sequences
+  for (uint32_t i = 1; i <= 2000; ++i) {
+    SlotHandle handle{i, i * 7};
+    REQUIRE(index.insert(i, handle));
+    reference[i] = handle;
+  }
+  for (uint32_t i = 3; i <= 2000; i += 3) {
+    REQUIRE(index.erase(i));
+    reference.erase(i);
+  }
+  for (uint32_t i = 5000; i < 5500; ++i) {
+    SlotHandle handle{i, 1};
+    REQUIRE(index.insert(i, handle));
+    reference[i] = handle;
+  }
+
+  REQUIRE(index.size() == reference.size());
+  bool consistent = true;
+  for (uint32_t i = 1; i < 5500; ++i) {
+    auto it = reference.find(i);
+    SlotHandle found = index.find(i);
+    consistent = consistent && (it == reference.end() ? !found.valid() : found == it->second);
+  }
+  REQUIRE(consistent);
+}
@@ -10,10 +10,95 @@
 #include <catch2/catch_approx.hpp>
 #include "simulator/node_manager.hpp"
 #include "simulator/virtual_node.hpp"
+#include "simulator/mesh_transport.hpp"
+#include "simulator/network_simulator.hpp"
+#include "simulator/firmware/firmware_base.hpp"
+#include "simulator/firmware/firmware_factory.hpp"
+#include "simulator/loop_monitor.hpp"
 #include <boost/asio.hpp>
+#include <string>
+#include <vector>
 
 using namespace simulator;
 
+namespace {
+
+/**
+ * @brief Firmware whose traffic depends only on ticks and deliveries
+ */
+class ChatterFirmware : public firmware::FirmwareBase {
+public:
+  ChatterFirmware() : FirmwareBase("Chatter") {}
+  
+  void setup() override {}
+  
+  void loop() override {
+    if (++loops_ % 3 == 0) {
+      sendBroadcast("tick-" + std::to_string(node_id_) + "-" + std::to_string(loops_));
+    }
+  }
+  
+  void onReceive(uint32_t from, String& msg) override {
+    log += std::to_string(from) + ":" + msg + ";";
+    if (msg.compare(0, 4, "tick") == 0) {
+      sendSingle(from, "ack-" + msg);
+    }
+  }
+  
+  std::string log;  ///< Everything received, in order
+  
+private:
+  uint32_t loops_{0};
+};
+
+/**
+ * @brief Runs a small lossy chatter mesh and returns every node's log
+ */
+std::vector<std::string> runChatter(size_t shards, bool windowed) {
+  boost::asio::io_context io;
+  NodeManager manager(io);
+  NetworkSimulator network(7);
+  LatencyConfig latency;
+  latency.min_ms = 25;
+  latency.max_ms = 40;
+  network.setDefaultLatency(latency);
+  PacketLossConfig loss;
+  loss.probability = 0.2f;
+  network.setDefaultPacketLoss(loss);
+  MeshTransport transport(network);
+  
+  manager.setShardCount(shards);
+  manager.setTransport(&transport);
+  std::vector<std::shared_ptr<VirtualNode>> nodes;
+  for (uint32_t i = 0; i < 6; ++i) {
+    NodeConfig config{10001 + i, "TestMesh", "password", static_cast<uint16_t>(16170 + i)};
+    auto node = manager.createNode(config);
+    node->loadFirmware(std::unique_ptr<firmware::FirmwareBase>(new ChatterFirmware()));
+    nodes.push_back(node);
+  }
+  manager.startAll();
+  for (size_t i = 1; i < nodes.size(); ++i) {
+    nodes[i]->connectTo(*nodes[(i - 1) / 2]);  // Binary tree
+  }
+  
+  const uint32_t tick_ms = 10;
+  uint64_t now = 0;
+  while (now < 2000) {
+    uint32_t ticks = windowed ? manager.getLookaheadTicks(tick_ms, 100) : 1;
+    manager.advanceWindow(now, tick_ms, ticks);
+    now += static_cast<uint64_t>(ticks) * tick_ms;
+  }
+  manager.stopAll();
+  
+  std::vector<std::string> logs;
+  for (const auto& node : nodes) {
+    logs.push_back(static_cast<ChatterFirmware*>(node->getFirmware())->log);
+  }
+  return logs;
+}
+
+} // anonymous namespace
+
 TEST_CASE("NodeManager construction", "[node_manager]") {
   boost::asio::io_context io;
   
@@ -71,6 +156,110 @@ TEST_CASE("NodeManager node creation", "[node_manager]") {
   }
 }
 
+TEST_CASE("NodeManager batch node creation", "[node_manager]") {
+  boost::asio::io_context io;
+  NodeManager manager(io);
+
+  auto batch = [](uint32_t first, uint32_t count) {
+    std::vector<NodeConfig> configs;
+    for (uint32_t i = 0; i < count; ++i) {
+      configs.push_back(NodeConfig{first + i, "TestMesh", "password",
+                                   static_cast<uint16_t>(17000 + i)});
+    }
+    return configs;
+  };
+
+  SECTION("creates and registers every node in order") {
+    auto nodes = manager.createNodes(batch(10001, 50));
+
+    REQUIRE(nodes.size() == 50);
+    REQUIRE(manager.getNodeCount() == 50);
+    for (uint32_t i = 0; i < 50; ++i) {
+      REQUIRE(nodes[i]->getNodeId() == 10001 + i);
+      REQUIRE(manager.getNode(10001 + i) == nodes[i]);
+    }
+    REQUIRE(manager.createNodes({}).empty());
+  }
+
+  SECTION("a bad batch creates nothing") {
+    manager.createNode(NodeConfig{10001, "TestMesh", "password"});
+
+    auto repeated = batch(20001, 5);
+    repeated.push_back(repeated.front());
+    REQUIRE_THROWS_AS(manager.createNodes(repeated), std::runtime_error);
+    REQUIRE_THROWS_AS(manager.createNodes(batch(10001, 2)), std::runtime_error);
+    REQUIRE_THROWS_AS(manager.createNodes(batch(0, 2)), std::invalid_argument);
+
+    manager.setMaxNodes(10);
+    REQUIRE_THROWS_AS(manager.createNodes(batch(20001, 10)), std::runtime_error);
+    REQUIRE(manager.getNodeCount() == 1);
+    REQUIRE(manager.createNodes(batch(20001, 9)).size() == 9);
+  }
+
+  SECTION("firmware is loaded once per node") {
+    auto& factory = firmware::FirmwareFactory::instance();
+    if (!factory.isRegistered("BatchChatter")) {
+      factory.registerFirmware("BatchChatter", []() { return std::make_unique<ChatterFirmware>(); });
+    }
+    auto configs = batch(10001, 4);
+    configs[1].firmware = "BatchChatter";
+    configs[2].firmware = "NoSuchFirmware";
+    configs[3].firmware = "BatchChatter";
+    auto nodes = manager.createNodes(configs);
+
+    REQUIRE_FALSE(nodes[0]->hasFirmware());
+    REQUIRE(nodes[1]->hasFirmware());
+    REQUIRE_FALSE(nodes[2]->hasFirmware());
+    REQUIRE(nodes[3]->hasFirmware());
+  }
+
+  SECTION("firmware gets its node's configuration") {
+    auto& factory = firmware::FirmwareFactory::instance();
+    if (!factory.isRegistered("BatchChatter")) {
+      factory.registerFirmware("BatchChatter", []() { return std::make_unique<ChatterFirmware>(); });
+    }
+    auto shared = std::make_shared<const NodeFirmwareConfig>(
+      NodeFirmwareConfig{{"report", "temperature"}, {"interval", "10"}});
+    auto configs = batch(10001, 3);
+    for (auto& config : configs) {
+      config.firmware = "BatchChatter";
+      config.sharedFirmwareConfig = shared;
+    }
+    configs[2].firmwareConfig["interval"] = "20";
+    auto nodes = manager.createNodes(configs);
+    manager.startAll();
+
+    for (const auto& node : nodes) {
+      REQUIRE(node->getFirmware()->getConfig("mesh_prefix", "") == "TestMesh");
+      REQUIRE(node->getFirmware()->getConfig("report", "") == "temperature");
+    }
+    REQUIRE(nodes[0]->getFirmware()->getConfig("interval", "") == "10");
+    REQUIRE(nodes[1]->getFirmware()->getConfig("interval", "") == "10");
+    REQUIRE(nodes[2]->getFirmware()->getConfig("interval", "") == "20");
+  }
+
+  SECTION("sharded batches land where single creation would") {
+    NodeManager single(io);
+    single.setShardCount(3);
+    manager.setShardCount(3);
+
+    single.createNode(NodeConfig{9001, "TestMesh", "password", 16999});
+    manager.createNode(NodeConfig{9001, "TestMesh", "password", 16999});
+    auto configs = batch(10001, 20);
+    for (const auto& config : configs) {
+      single.createNode(config);
+    }
+    manager.createNodes(configs);
+
+    for (const auto& config : configs) {
+      REQUIRE(manager.getShardOf(config.nodeId) == single.getShardOf(config.nodeId));
+    }
+    manager.startAll();
+    manager.updateAll();
+    REQUIRE(manager.getNode(10020)->isRunning());
+  }
+}
+
 TEST_CASE("NodeManager node removal", "[node_manager]") {
   boost::asio::io_context io;
   NodeManager manager(io);
@@ -108,6 +297,18 @@ TEST_CASE("NodeManager node removal", "[node_manager]") {
     REQUIRE(node2->getNodeId() == 10001);
     REQUIRE(manager.getNodeCount() == 1);
   }
+
+  SECTION("other nodes stay reachable after a removal") {
+    auto node1 = manager.createNode(NodeConfig{10001, "TestMesh", "password", 16013});
+    auto node2 = manager.createNode(NodeConfig{10002, "TestMesh", "password", 16014});
+    auto node3 = manager.createNode(NodeConfig{10003, "TestMesh", "password", 16015});
+
+    REQUIRE(manager.removeNode(10001) == true);
+    REQUIRE(manager.getNode(10001) == nullptr);
+    REQUIRE(manager.getNode(10002) == node2);
+    REQUIRE(manager.getNode(10003) == node3);
+    REQUIRE(manager.getNodeIds().size() == 2);
+  }
 }
 
 TEST_CASE("NodeManager lifecycle operations", "[node_manager]") {
@@ -323,6 +524,79 @@ TEST_CASE("NodeManager resource limits", "[node_manager]") {
     }
     REQUIRE(manager.getNodeCount() == 10);
   }
+
+  SECTION("cap can be changed at runtime") {
+    REQUIRE(manager.getMaxNodes() == NodeManager::MAX_NODES);
+    manager.setMaxNodes(2);
+    manager.createNode(NodeConfig{10001, "TestMesh", "password", 16060});
+    manager.createNode(NodeConfig{10002, "TestMesh", "password", 16061});
+    REQUIRE_THROWS_AS(manager.createNode(NodeConfig{10003, "TestMesh", "password", 16062}),
+                      std::runtime_error);
+
+    REQUIRE_THROWS_AS(manager.setMaxNodes(0), std::invalid_argument);
+    REQUIRE_THROWS_AS(manager.setMaxNodes(1), std::invalid_argument);
+    manager.setMaxNodes(3);
+    REQUIRE_NOTHROW(manager.createNode(NodeConfig{10003, "TestMesh", "password", 16062}));
+  }
+
+  SECTION("memory usage is reported per node and in total") {
+    manager.createNode(NodeConfig{10001, "TestMesh", "password", 16063});
+    manager.createNode(NodeConfig{10002, "TestMesh", "password", 16064});
+
+    NodeMemoryUsage one = manager.getMemoryUsage(10001);
+    REQUIRE(one.node > 0);
+    REQUIRE(one.mesh > 0);
+    REQUIRE(one.total() >= one.node + one.mesh);
+    REQUIRE(manager.getMemoryUsage().total() ==
+            one.total() + manager.getMemoryUsage(10002).total());
+    REQUIRE_THROWS_AS(manager.getMemoryUsage(9999), std::out_of_range);
+  }
+
+  SECTION("stopped lazy nodes hold no mesh memory") {
+    NodeConfig config{10001, "TestMesh", "password", 16065};
+    config.lazy = true;
+    auto node = manager.createNode(config);
+    REQUIRE(manager.getMemoryUsage(10001).mesh == 0);
+
+    node->start();
+    REQUIRE(manager.getMemoryUsage(10001).mesh > 0);
+    node->stop();
+    REQUIRE(manager.getMemoryUsage(10001).mesh == 0);
+  }
+}
+
+TEST_CASE("NodeManager scales to 10k nodes", "[node_manager][scale]") {
+  // A few GB for 10k nodes: 256 KiB per node is 2.5 GiB
+  const size_t node_count = 10000;
+  const size_t budget = 256 * 1024;
+
+  boost::asio::io_context io;
+  NodeManager manager(io);
+  NetworkSimulator network(42);
+  MeshTransport transport(network);
+  manager.setShardCount(4);
+  manager.setTransport(&transport);
+  manager.setMaxNodes(node_count);
+
+  for (uint32_t i = 0; i < node_count; ++i) {
+    manager.createNode(NodeConfig{100000 + i, "ScaleMesh", "password", 5555});
+  }
+  REQUIRE(manager.getNodeCount() == node_count);
+
+  manager.startAll();
+  manager.establishConnectivity();
+  for (uint64_t now = 0; now < 50; now += 10) {
+    transport.update(now);
+    manager.updateAll();
+  }
+
+  NodeMemoryUsage memory = manager.getMemoryUsage();
+  REQUIRE(memory.mesh > 0);
+  REQUIRE(memory.buffers > 0);
+  REQUIRE(memory.connections == 0);  // In-process links hold no TCP connections
+  REQUIRE(memory.total() / node_count <= budget);
+
+  manager.stopAll();
 }
 
 TEST_CASE("NodeManager integration tests", "[node_manager][integration]") {
@@ -421,3 +695,262 @@ TEST_CASE("NodeManager integration tests", "[node_manager][integration]") {
     REQUIRE(true);
   }
 }
+
+TEST_CASE("NodeManager in-process transport", "[node_manager][transport]") {
+  boost::asio::io_context io;
+  NodeManager manager(io);
+  NetworkSimulator network(42);
+  MeshTransport transport(network);
+  
+  manager.setTransport(&transport);
+  for (uint32_t i = 0; i < 5; ++i) {
+    NodeConfig config{10001 + i, "TestMesh", "password", static_cast<uint16_t>(16080 + i)};
+    manager.createNode(config);
+  }
+  
+  SECTION("started nodes attach to the transport") {
+    manager.startAll();
+    for (uint32_t id : manager.getNodeIds()) {
+      REQUIRE(transport.isAttached(id));
+    }
+    
+    manager.stopAll();
+    for (uint32_t id : manager.getNodeIds()) {
+      REQUIRE_FALSE(transport.isAttached(id));
+    }
+  }
+  
+  SECTION("establishConnectivity creates a spanning tree of links") {
+    manager.startAll();
+    manager.establishConnectivity();
+    
+    REQUIRE(transport.getLinkCount() == 4);
+    REQUIRE(transport.getReachableNodes(10001).size() == 4);
+    
+    manager.stopAll();
+  }
+  
+  SECTION("establishConnectivity links a given topology in one batch") {
+    manager.startAll();
+    size_t links = manager.establishConnectivity({{10001, 10002}, {10002, 10003}, {10003, 99999}});
+    
+    REQUIRE(links == 2);
+    REQUIRE(transport.getLinkCount() == 2);
+    REQUIRE(transport.hasLink(10003, 10002));
+    REQUIRE_FALSE(transport.hasLink(10003, 99999));
+    
+    manager.stopAll();
+  }
+  
+  SECTION("removeNode removes its links") {
+    manager.startAll();
+    manager.establishConnectivity();
+    manager.removeNode(10001);
+    
+    REQUIRE_FALSE(transport.isAttached(10001));
+    REQUIRE(transport.getNeighbours(10001).empty());
+
+    manager.stopAll();
+  }
+
+  SECTION("the same seed builds the same topology") {
+    auto build = [](uint32_t seed) {
+      boost::asio::io_context replay_io;
+      NodeManager replay(replay_io);
+      NetworkSimulator replay_network(seed);
+      MeshTransport replay_transport(replay_network);
+      replay.setTransport(&replay_transport);
+      replay.setSeed(seed);
+      for (uint32_t i = 0; i < 30; ++i) {
+        replay.createNode(NodeConfig{20001 + i, "TestMesh", "password", 5555});
+      }
+      replay.establishConnectivity();
+
+      std::vector<std::vector<uint32_t>> links;
+      for (uint32_t id : replay.getNodeIds()) {
+        links.push_back(replay_transport.getNeighbours(id));
+      }
+      return links;
+    };
+
+    REQUIRE(build(7) == build(7));
+    REQUIRE(build(7).size() == 30);
+  }
+}
+
+TEST_CASE("NodeManager sharded updates", "[node_manager][shards]") {
+  boost::asio::io_context io;
+  NodeManager manager(io);
+  
+  SECTION("shard count is validated") {
+    REQUIRE_THROWS_AS(manager.setShardCount(0), std::invalid_argument);
+    REQUIRE_THROWS_AS(manager.setShardCount(NodeManager::MAX_SHARDS + 1), std::invalid_argument);
+    
+    manager.createNode(NodeConfig{10001, "TestMesh", "password", 16101});
+    REQUIRE_THROWS_AS(manager.setShardCount(2), std::runtime_error);
+  }
+  
+  SECTION("nodes are spread evenly across shards") {
+    manager.setShardCount(3);
+    REQUIRE(manager.getShardCount() == 3);
+    
+    std::vector<size_t> per_shard(3, 0);
+    for (uint32_t i = 0; i < 9; ++i) {
+      NodeConfig config{10001 + i, "TestMesh", "password", static_cast<uint16_t>(16110 + i)};
+      manager.createNode(config);
+      per_shard[manager.getShardOf(10001 + i)]++;
+    }
+    REQUIRE(per_shard == std::vector<size_t>{3, 3, 3});
+    REQUIRE_THROWS_AS(manager.getShardOf(99999), std::out_of_range);
+  }
+  
+  SECTION("in-process traffic crosses shards through the mailboxes") {
+    NetworkSimulator network(42);
+    MeshTransport transport(network);
+    manager.setShardCount(2);
+    manager.setTransport(&transport);
+    
+    for (uint32_t i = 0; i < 4; ++i) {
+      NodeConfig config{10001 + i, "TestMesh", "password", static_cast<uint16_t>(16130 + i)};
+      manager.createNode(config);
+    }
+    manager.startAll();
+    manager.establishConnectivity();
+    REQUIRE(manager.getShardOf(10001) != manager.getShardOf(10002));
+    
+    // A transport delivery reaches its node during the next updateAll()
+    REQUIRE(transport.sendSingle(10001, 10002, "hello"));
+    for (uint64_t t = 0; t < 2000; ++t) {
+      transport.update(t);
+      manager.updateAll();
+    }
+    REQUIRE(manager.getNode(10002)->getMetrics().messages_received == 1);
+    
+    manager.stopAll();
+  }
+  
+  SECTION("updates run without a transport") {
+    manager.setShardCount(4);
+    for (uint32_t i = 0; i < 8; ++i) {
+      NodeConfig config{10001 + i, "TestMesh", "password", static_cast<uint16_t>(16150 + i)};
+      manager.createNode(config);
+    }
+    manager.startAll();
+    for (int i = 0; i < 10; ++i) {
+      REQUIRE_NOTHROW(manager.updateAll());
+    }
+    
+    // Each node runs once per update, on its home worker or a thief
+    REQUIRE(manager.getStealCount() <= 8 * 10);
+    manager.stopAll();
+  }
+  
+  SECTION("a single shard has nobody to steal from") {
+    manager.setShardCount(1);
+    for (uint32_t i = 0; i < 3; ++i) {
+      NodeConfig config{10001 + i, "TestMesh", "password", static_cast<uint16_t>(16170 + i)};
+      manager.createNode(config);
+    }
+    manager.startAll();
+    manager.updateAll();
+    
+    REQUIRE(manager.removeNode(10002));
+    REQUIRE_NOTHROW(manager.updateAll());
+    REQUIRE(manager.getStealCount() == 0);
+    manager.stopAll();
+  }
+}
+
+TEST_CASE("NodeManager loop monitor", "[node_manager][loop_monitor]") {
+  boost::asio::io_context io;
+  NodeManager manager(io);
+  LoopMonitor monitor(60000000);
+  
+  SECTION("updates of running nodes are recorded") {
+    manager.setLoopMonitor(&monitor);
+    for (uint32_t i = 0; i < 3; ++i) {
+      NodeConfig config{10001 + i, "TestMesh", "password", static_cast<uint16_t>(16190 + i)};
+      manager.createNode(config);
+    }
+    manager.startAll();
+    manager.getNode(10003)->stop();
+    REQUIRE(manager.getNode(10001)->getUpdateTiming() != nullptr);
+    
+    for (int i = 0; i < 5; ++i) {
+      manager.updateAll();
+    }
+    REQUIRE(monitor.getUpdateHistogram().getCount() == 2 * 5);
+    REQUIRE(monitor.getSlowUpdateCount() == 0);
+    
+    manager.setLoopMonitor(nullptr);
+    REQUIRE(manager.getNode(10001)->getUpdateTiming() == nullptr);
+    manager.stopAll();
+  }
+  
+  SECTION("every shard records in its own slot") {
+    manager.setShardCount(3);
+    for (uint32_t i = 0; i < 6; ++i) {
+      NodeConfig config{10001 + i, "TestMesh", "password", static_cast<uint16_t>(16200 + i)};
+      manager.createNode(config);
+    }
+    manager.setLoopMonitor(&monitor);
+    manager.startAll();
+    
+    for (int i = 0; i < 4; ++i) {
+      manager.updateAll();
+    }
+    REQUIRE(monitor.getUpdateHistogram().getCount() == 6 * 4);
+    manager.stopAll();
+  }
+}
+
+TEST_CASE("NodeManager lookahead windows", "[node_manager][shards]") {
+  boost::asio::io_context io;
+  NodeManager manager(io);
+  NetworkSimulator network(42);
+  MeshTransport transport(network);
+  
+  SECTION("window needs a sharded manager") {
+    REQUIRE_THROWS_AS(manager.advanceWindow(0, 10, 1), std::runtime_error);
+  }
+  
+  SECTION("window length follows the smallest link latency") {
+    manager.setShardCount(2);
+    manager.setTransport(&transport);
+    for (uint32_t i = 0; i < 3; ++i) {
+      NodeConfig config{10001 + i, "TestMesh", "password", static_cast<uint16_t>(16160 + i)};
+      manager.createNode(config);
+    }
+    manager.startAll();
+    
+    // No links yet: only the cap applies
+    REQUIRE(manager.getLookaheadTicks(10, 50) == 50);
+    
+    LatencyConfig latency;
+    latency.min_ms = 25;
+    latency.max_ms = 30;
+    network.setDefaultLatency(latency);
+    manager.getNode(10002)->connectTo(*manager.getNode(10001));
+    REQUIRE(manager.getLookaheadTicks(10, 50) == 3);  // 25 > 2 * 10
+    
+    LatencyConfig fast;
+    fast.min_ms = 10;
+    fast.max_ms = 10;
+    network.setLatency(10003, 10001, fast);
+    manager.getNode(10003)->connectTo(*manager.getNode(10001));
+    REQUIRE(manager.getLookaheadTicks(10, 50) == 1);
+    
+    manager.stopAll();
+  }
+  
+  SECTION("results do not depend on the shard count") {
+    auto reference = runChatter(1, true);
+    REQUIRE_FALSE(reference[0].empty());
+    REQUIRE(runChatter(2, true) == reference);
+    REQUIRE(runChatter(3, true) == reference);
+  }
+  
+  SECTION("per-tick windows are reproducible too") {
+    REQUIRE(runChatter(3, false) == runChatter(1, false));
+  }
+}
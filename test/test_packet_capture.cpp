@@ -0,0 +1,174 @@
+/**
+ * @file test_packet_capture.cpp
+ * @brief Unit tests for PacketCapture
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/network_simulator.hpp"
+#include "simulator/packet_capture.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace simulator;
+
+namespace {
+
+const char* const CAPTURE_FILE = "test_packet_capture.pcapng";
+
+std::string prefixOf(const CaptureRecord& record) {
+  return std::string(record.prefix, record.prefix_length);
+}
+
+} // anonymous namespace
+
+TEST_CASE("PacketCapture writes and reads records", "[packet_capture]") {
+  CaptureFilter filter;
+  filter.payload_prefix = 4;
+  PacketCapture capture(filter);
+
+  // Records before open() are not kept
+  capture.capture(CaptureVerdict::ENQUEUED, 1, 1, 2, Payload("early"));
+  capture.open(CAPTURE_FILE);
+  REQUIRE(capture.isOpen());
+
+  capture.capture(CaptureVerdict::ENQUEUED, 10, 1, 2, Payload("hello"), 25);
+  capture.capture(CaptureVerdict::DROPPED, 11, 2, 3, Payload("ab"));
+  capture.capture(CaptureVerdict::DELIVERED, 25, 1, 2, Payload(""), 25);
+  REQUIRE(capture.getCapturedCount() == 3);
+  capture.close();
+  REQUIRE_FALSE(capture.isOpen());
+
+  auto records = PacketCapture::readFile(CAPTURE_FILE);
+  REQUIRE(records.size() == 3);
+  REQUIRE(records[0].verdict == CaptureVerdict::ENQUEUED);
+  REQUIRE(records[0].time_ms == 10);
+  REQUIRE(records[0].delivery_ms == 25);
+  REQUIRE(records[0].from == 1);
+  REQUIRE(records[0].to == 2);
+  REQUIRE(records[0].size == 5);
+  REQUIRE(prefixOf(records[0]) == "hell");
+  REQUIRE(records[1].verdict == CaptureVerdict::DROPPED);
+  REQUIRE(records[1].delivery_ms == 0);
+  REQUIRE(prefixOf(records[1]) == "ab");
+  REQUIRE(records[2].verdict == CaptureVerdict::DELIVERED);
+  REQUIRE(records[2].size == 0);
+
+  SECTION("the file is pcapng with a user link type") {
+    std::ifstream in(CAPTURE_FILE, std::ios::binary);
+    std::vector<unsigned char> head(38);
+    in.read(reinterpret_cast<char*>(head.data()), static_cast<std::streamsize>(head.size()));
+    REQUIRE(head[0] == 0x0A);
+    REQUIRE(head[1] == 0x0D);
+    REQUIRE(head[8] == 0x4D);              // Little-endian byte-order magic
+    REQUIRE(head[28] == 1);                // Interface Description Block
+    REQUIRE(head[36] == PacketCapture::LINK_TYPE);
+  }
+
+  SECTION("other files are rejected") {
+    std::ofstream out(CAPTURE_FILE, std::ios::binary | std::ios::trunc);
+    out << "not a capture";
+    out.close();
+    REQUIRE_THROWS_AS(PacketCapture::readFile(CAPTURE_FILE), std::runtime_error);
+  }
+
+  std::remove(CAPTURE_FILE);
+}
+
+TEST_CASE("PacketCapture filters by node and link", "[packet_capture]") {
+  CaptureFilter filter;
+  filter.nodes = {7};
+  filter.links = {{1, 2}};
+  PacketCapture capture(filter);
+
+  REQUIRE(capture.wants(7, 3));
+  REQUIRE(capture.wants(3, 7));
+  REQUIRE(capture.wants(1, 2));
+  REQUIRE(capture.wants(2, 1));
+  REQUIRE_FALSE(capture.wants(1, 3));
+
+  PacketCapture all;
+  REQUIRE(all.wants(1, 3));
+
+  CaptureFilter too_long;
+  too_long.payload_prefix = CaptureRecord::MAX_PREFIX + 1;
+  REQUIRE_THROWS_AS(PacketCapture(too_long), std::invalid_argument);
+}
+
+TEST_CASE("PacketCapture applies back-pressure instead of dropping", "[packet_capture]") {
+  PacketCapture capture(CaptureFilter(), 4);
+  capture.open(CAPTURE_FILE);
+  const uint32_t RECORDS = 5000;
+  for (uint32_t i = 0; i < RECORDS; ++i) {
+    capture.capture(CaptureVerdict::ENQUEUED, i, i, i + 1, Payload("x"));
+  }
+  capture.close();
+
+  auto records = PacketCapture::readFile(CAPTURE_FILE);
+  REQUIRE(records.size() == RECORDS);
+  for (uint32_t i = 0; i < RECORDS; ++i) {
+    REQUIRE(records[i].from == i);
+  }
+  std::remove(CAPTURE_FILE);
+}
+
+TEST_CASE("NetworkSimulator reports the delivery path to a capture", "[packet_capture]") {
+  NetworkSimulator sim(42);
+  LatencyConfig latency;
+  latency.min_ms = 5;
+  latency.max_ms = 5;
+  sim.setDefaultLatency(latency);
+
+  PacketLossConfig loss;
+  loss.probability = 1.0f;
+  sim.setPacketLoss(1, 3, loss);
+  sim.dropConnection(1, 4);
+  BandwidthConfig bandwidth;
+  bandwidth.max_bytes_per_sec = 10;
+  bandwidth.bucket_size = 10;
+  sim.setBandwidth(1, 5, bandwidth);
+
+  CaptureFilter filter;
+  filter.payload_prefix = 8;
+  PacketCapture capture(filter);
+  capture.open(CAPTURE_FILE);
+  sim.setCapture(&capture);
+  REQUIRE(sim.getCapture() == &capture);
+
+  const Payload big(std::string(100, 'b'));
+  sim.enqueueMessage(1, 2, Payload("delivered"), 100);
+  sim.enqueueMessage(1, 3, Payload("lost"), 100);
+  sim.enqueueMessage(1, 4, Payload("cut"), 100);
+  sim.enqueueMessage(1, 5, big, 100);
+  const uint32_t fanout[] = {6, 7};
+  sim.enqueueMulticast(1, fanout, 2, Payload("multi"), 101);
+  REQUIRE(sim.getReadyMessages(110).size() == 3);
+
+  sim.setCapture(nullptr);
+  sim.enqueueMessage(1, 2, Payload("not captured"), 120);
+  capture.close();
+
+  auto records = PacketCapture::readFile(CAPTURE_FILE);
+  std::vector<CaptureVerdict> verdicts;
+  for (const auto& record : records) {
+    verdicts.push_back(record.verdict);
+  }
+  REQUIRE(verdicts == std::vector<CaptureVerdict>{
+    CaptureVerdict::ENQUEUED, CaptureVerdict::DROPPED, CaptureVerdict::DISCONNECTED,
+    CaptureVerdict::THROTTLED, CaptureVerdict::ENQUEUED, CaptureVerdict::ENQUEUED,
+    CaptureVerdict::DELIVERED, CaptureVerdict::DELIVERED, CaptureVerdict::DELIVERED});
+  REQUIRE(prefixOf(records[0]) == "delivere");
+  REQUIRE(records[0].delivery_ms == 105);
+  REQUIRE(records[3].size == 100);
+  REQUIRE(records[6].time_ms == 110);
+  REQUIRE(records[6].delivery_ms == 105);
+
+  std::remove(CAPTURE_FILE);
+}
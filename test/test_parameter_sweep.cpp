@@ -0,0 +1,143 @@
+/**
+ * @file test_parameter_sweep.cpp
+ * @brief Unit tests for SweepSpec
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/parameter_sweep.hpp"
+
+#include <sstream>
+#include <stdexcept>
+
+using namespace simulator;
+
+TEST_CASE("SweepSpec enumerates the parameter grid", "[parameter_sweep]") {
+  SweepSpec spec = SweepSpec::parse(R"(
+parameters:
+  nodes: [10, 100]
+  packet_loss: [0.0, 0.05, 0.1]
+  seed: 7
+jobs: 4
+output: grid.csv
+)");
+
+  REQUIRE(spec.getAxes().size() == 3);
+  REQUIRE(spec.getAxes()[0].name == "nodes");
+  REQUIRE(spec.getAxes()[2].values.size() == 1);
+  REQUIRE(spec.getPointCount() == 6);
+  REQUIRE(spec.getJobs() == 4);
+  REQUIRE(spec.getOutput() == "grid.csv");
+
+  // The last parameter varies fastest
+  SweepPoint first = spec.getPoint(0);
+  REQUIRE(first.values == std::vector<double>({10, 0.0, 7}));
+  SweepPoint second = spec.getPoint(1);
+  REQUIRE(second.values == std::vector<double>({10, 0.05, 7}));
+  SweepPoint last = spec.getPoint(5);
+  REQUIRE(last.index == 5);
+  REQUIRE(last.values == std::vector<double>({100, 0.1, 7}));
+  REQUIRE_THROWS_AS(spec.getPoint(6), std::out_of_range);
+}
+
+TEST_CASE("SweepSpec applies a point to a scenario", "[parameter_sweep]") {
+  SweepSpec spec = SweepSpec::parse(R"(
+parameters:
+  nodes: [25]
+  seed: [3]
+  duration: [60]
+  packet_loss: [0.25]
+  latency_min: [5]
+  latency_max: [80]
+  traffic_rate: [2.5]
+)");
+  REQUIRE(spec.getJobs() == 0);
+  REQUIRE(spec.getOutput() == SweepSpec::DEFAULT_OUTPUT);
+
+  ScenarioConfig config;
+  config.templates.resize(1);
+  config.traffic.resize(2);
+  spec.apply(spec.getPoint(0), config);
+  REQUIRE(config.templates[0].count == 25);
+  REQUIRE(config.simulation.seed == 3);
+  REQUIRE(config.simulation.duration == 60);
+  REQUIRE(config.network.default_packet_loss.probability == 0.25f);
+  REQUIRE(config.network.default_latency.min_ms == 5);
+  REQUIRE(config.network.default_latency.max_ms == 80);
+  REQUIRE(config.traffic[0].rate == 2.5);
+  REQUIRE(config.traffic[1].rate == 2.5);
+
+  SECTION("node counts need exactly one template") {
+    ScenarioConfig two;
+    two.templates.resize(2);
+    two.traffic.resize(1);
+    REQUIRE_THROWS_AS(spec.apply(spec.getPoint(0), two), std::invalid_argument);
+  }
+
+  SECTION("traffic rates need traffic") {
+    ScenarioConfig quiet;
+    quiet.templates.resize(1);
+    REQUIRE_THROWS_AS(spec.apply(spec.getPoint(0), quiet), std::invalid_argument);
+  }
+}
+
+TEST_CASE("SweepSpec rejects invalid sweeps", "[parameter_sweep]") {
+  const char* invalid[] = {
+    "jobs: 2",
+    "parameters: {}",
+    "parameters:\n  threads: [1, 2]",
+    "parameters:\n  nodes: [0]",
+    "parameters:\n  seed: [1.5]",
+    "parameters:\n  packet_loss: [1.5]",
+    "parameters:\n  traffic_rate: [0]",
+    "parameters:\n  duration: []",
+    "parameters:\n  seed: [1]\n  seed: [2]",
+    "parameters:\n  seed: [one]",
+    "parameters: [",
+  };
+  for (const char* yaml : invalid) {
+    INFO(yaml);
+    REQUIRE_THROWS_AS(SweepSpec::parse(yaml), std::runtime_error);
+  }
+  REQUIRE_THROWS_AS(SweepSpec::load("/nonexistent/grid.yaml"), std::runtime_error);
+}
+
+TEST_CASE("SweepSpec writes one table row per run", "[parameter_sweep]") {
+  SweepSpec spec = SweepSpec::parse("parameters:\n  nodes: [10, 20]\n");
+
+  std::vector<SweepResult> results(2);
+  results[0].point = spec.getPoint(0);
+  results[0].nodes = 10;
+  results[0].simulated_ms = 60000;
+  results[0].messages_sent = 5;
+  results[0].latency_p99_ms = 42;
+  results[0].link_delivered = 9;
+  results[0].link_lost = 1;
+  results[0].traffic_offered = 7;
+  results[0].traffic_expected = 7;
+  results[0].traffic_delivered = 6;
+  REQUIRE(results[0].getDeliveryRatio() == 0.9);
+  REQUIRE(results[1].getDeliveryRatio() == 1.0);
+  results[1].point = spec.getPoint(1);
+  results[1].error = "bad \"thing\", here";
+
+  std::ostringstream out;
+  spec.writeTable(results, out);
+  std::istringstream lines(out.str());
+  std::string header;
+  std::string row0;
+  std::string row1;
+  std::getline(lines, header);
+  std::getline(lines, row0);
+  std::getline(lines, row1);
+
+  REQUIRE(header == "run,nodes,status,simulated_nodes,simulated_ms,wall_ms,updates,messages_sent,"
+                    "messages_received,frames_dropped,link_delivered,link_lost,"
+                    "latency_p50_ms,latency_p95_ms,latency_p99_ms,traffic_offered,traffic_expected,"
+                    "traffic_delivered");
+  REQUIRE(row0 == "0,10,ok,10,60000,0,0,5,0,0,9,1,0,0,42,7,7,6");
+  REQUIRE(row1 == "1,20,\"error: bad \"\"thing\"\", here\",0,0,0,0,0,0,0,0,0,0,0,0,0,0,0");
+}
@@ -11,6 +11,7 @@
 
 #include "simulator/events/network_partition_event.hpp"
 #include "simulator/events/network_heal_event.hpp"
+#include "simulator/checkpoint.hpp"
 #include "simulator/network_simulator.hpp"
 #include "simulator/node_manager.hpp"
 
@@ -107,6 +108,88 @@ TEST_CASE("NetworkSimulator restoreAllConnections", "[network][partition]") {
     REQUIRE(network.isConnectionActive(2001, 2002));
     REQUIRE(network.isConnectionActive(3001, 3002));
   }
+
+  SECTION("repeated drop and heal cycles start from a clean state") {
+    for (uint32_t cycle = 0; cycle < 100; ++cycle) {
+      const uint32_t node = 1000 + cycle % 3;
+      network.dropConnection(node, node + 1);
+      network.dropConnection(node + 1, node);
+      REQUIRE_FALSE(network.isConnectionActive(node, node + 1));
+      REQUIRE(network.getDroppedConnections().size() == 2);
+
+      network.restoreAllConnections();
+      REQUIRE(network.isConnectionActive(node, node + 1));
+      REQUIRE(network.isConnectionActive(node + 1, node));
+      REQUIRE(network.getDroppedConnections().empty());
+    }
+
+    // Single restores still work after many epochs
+    network.dropConnection(1001, 1002);
+    network.dropConnection(1002, 1003);
+    network.restoreConnection(1001, 1002);
+    REQUIRE(network.isConnectionActive(1001, 1002));
+    REQUIRE_FALSE(network.isConnectionActive(1002, 1003));
+    REQUIRE(network.getDroppedConnections().size() == 1);
+  }
+
+  SECTION("drops survive a checkpoint taken after a heal") {
+    network.dropConnection(1001, 1002);
+    network.restoreAllConnections();
+    network.dropConnection(1003, 1004);
+
+    CheckpointWriter out;
+    network.saveState(out);
+    NetworkSimulator restored(12345);
+    CheckpointReader in(out.data());
+    restored.loadState(in);
+    REQUIRE(restored.isConnectionActive(1001, 1002));
+    REQUIRE_FALSE(restored.isConnectionActive(1003, 1004));
+    REQUIRE(restored.getDroppedConnections().size() == 1);
+  }
+}
+
+TEST_CASE("NetworkSimulator partition labels", "[network][partition]") {
+  NetworkSimulator network;
+  
+  SECTION("labels split traffic between partitions") {
+    network.setPartition(1001, 1);
+    network.setPartition(1002, 1);
+    network.setPartition(1003, 2);
+    
+    REQUIRE(network.getPartition(1003) == 2);
+    REQUIRE(network.isConnectionActive(1001, 1002));
+    REQUIRE_FALSE(network.isConnectionActive(1001, 1003));
+    REQUIRE_FALSE(network.isConnectionActive(1003, 1002));
+  }
+  
+  SECTION("unlabelled nodes reach every partition") {
+    network.setPartition(1001, 1);
+    network.setPartition(1002, 2);
+    
+    REQUIRE(network.getPartition(1005) == 0);
+    REQUIRE(network.isConnectionActive(1005, 1001));
+    REQUIRE(network.isConnectionActive(1002, 1005));
+  }
+  
+  SECTION("explicit drops stay in place when partitions clear") {
+    network.setPartition(1001, 1);
+    network.setPartition(1002, 2);
+    network.dropConnection(1003, 1004);
+    
+    network.clearPartitions();
+    
+    REQUIRE(network.isConnectionActive(1001, 1002));
+    REQUIRE_FALSE(network.isConnectionActive(1003, 1004));
+  }
+  
+  SECTION("multicast skips receivers in other partitions") {
+    network.setPartition(1, 1);
+    network.setPartition(2, 1);
+    network.setPartition(3, 2);
+    
+    REQUIRE(network.enqueueMulticast(1, {2, 3, 4}, "all", 0) == 2);
+    REQUIRE(network.getStats(1, 3).dropped_count == 1);
+  }
 }
 
 TEST_CASE("NetworkPartitionEvent construction", "[event][partition]") {
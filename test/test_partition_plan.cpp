@@ -0,0 +1,94 @@
+/**
+ * @file test_partition_plan.cpp
+ * @brief Unit tests for PartitionPlan class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/partition_plan.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+using namespace simulator;
+
+namespace {
+
+std::vector<NodeConfigExtended> makeNodes(uint32_t count) {
+  std::vector<NodeConfigExtended> nodes;
+  for (uint32_t i = 0; i < count; ++i) {
+    NodeConfigExtended node;
+    node.id = "node-" + std::to_string(i);
+    node.nodeId = 1000 + i;
+    nodes.push_back(node);
+  }
+  return nodes;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Partition strategy names", "[partition_plan]") {
+  REQUIRE(stringToPartitionStrategy("block") == PartitionStrategy::BLOCK);
+  REQUIRE(stringToPartitionStrategy("locality") == PartitionStrategy::LOCALITY);
+  REQUIRE_THROWS_AS(stringToPartitionStrategy("random"), std::invalid_argument);
+}
+
+TEST_CASE("Block partition splits in configuration order", "[partition_plan]") {
+  auto plan = PartitionPlan::build(makeNodes(10), 3, PartitionStrategy::BLOCK);
+
+  REQUIRE(plan.getRankCount() == 3);
+  REQUIRE(plan.getNodes(0) == std::vector<uint32_t>({1000, 1001, 1002, 1003}));
+  REQUIRE(plan.getNodes(1) == std::vector<uint32_t>({1004, 1005, 1006}));
+  REQUIRE(plan.getNodes(2) == std::vector<uint32_t>({1007, 1008, 1009}));
+  REQUIRE(plan.getRank(1005) == 1);
+  REQUIRE(plan.contains(1009));
+  REQUIRE_FALSE(plan.contains(42));
+  REQUIRE_THROWS_AS(plan.getRank(42), std::out_of_range);
+  REQUIRE(plan.getNodes(7).empty());
+}
+
+TEST_CASE("Locality partition keeps neighbours together", "[partition_plan]") {
+  // Two clusters far apart on the x axis
+  auto nodes = makeNodes(8);
+  for (uint32_t i = 0; i < 8; ++i) {
+    const int x = i % 2 == 0 ? static_cast<int>(i) : 1000 + static_cast<int>(i);
+    nodes[i].position = {x, 0};
+  }
+
+  SECTION("each cluster lands on one rank") {
+    auto plan = PartitionPlan::build(nodes, 2, PartitionStrategy::LOCALITY);
+    REQUIRE(plan.getNodes(0) == std::vector<uint32_t>({1000, 1002, 1004, 1006}));
+    REQUIRE(plan.getNodes(1) == std::vector<uint32_t>({1001, 1003, 1005, 1007}));
+  }
+
+  SECTION("uneven rank counts stay balanced") {
+    auto plan = PartitionPlan::build(nodes, 3, PartitionStrategy::LOCALITY);
+    size_t total = 0;
+    for (uint32_t rank = 0; rank < 3; ++rank) {
+      const size_t size = plan.getNodes(rank).size();
+      REQUIRE(size >= 2);
+      REQUIRE(size <= 3);
+      total += size;
+    }
+    REQUIRE(total == 8);
+  }
+
+  SECTION("nodes without a position are rejected") {
+    nodes[3].position.clear();
+    REQUIRE_THROWS_AS(PartitionPlan::build(nodes, 2, PartitionStrategy::LOCALITY),
+                      std::invalid_argument);
+  }
+}
+
+TEST_CASE("Partition input validation", "[partition_plan]") {
+  REQUIRE_THROWS_AS(PartitionPlan::build(makeNodes(3), 0, PartitionStrategy::BLOCK),
+                    std::invalid_argument);
+
+  auto nodes = makeNodes(3);
+  nodes[2].nodeId = nodes[0].nodeId;
+  REQUIRE_THROWS_AS(PartitionPlan::build(nodes, 2, PartitionStrategy::BLOCK),
+                    std::invalid_argument);
+}
@@ -0,0 +1,73 @@
+/**
+ * @file test_payload.cpp
+ * @brief Unit tests for Payload class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/payload.hpp"
+
+#include <stdexcept>
+#include <string>
+
+using namespace simulator;
+
+TEST_CASE("Payload construction and comparison", "[payload]") {
+  SECTION("default payload is empty") {
+    Payload payload;
+    REQUIRE(payload.empty());
+    REQUIRE(payload.size() == 0);
+    REQUIRE(payload == "");
+    REQUIRE(payload.useCount() == 0);
+  }
+
+  SECTION("payload compares by content") {
+    Payload payload(std::string("hello"));
+    REQUIRE(payload.size() == 5);
+    REQUIRE(payload == "hello");
+    REQUIRE(payload == std::string("hello"));
+    REQUIRE(payload == Payload("hello"));
+    REQUIRE(payload != "hell");
+    REQUIRE(payload.str() == "hello");
+  }
+
+  SECTION("embedded null bytes are kept") {
+    std::string bytes("a\0b", 3);
+    Payload payload(bytes);
+    REQUIRE(payload.size() == 3);
+    REQUIRE(payload == bytes);
+    REQUIRE(payload[2] == 'b');
+  }
+}
+
+TEST_CASE("Payload copies share one buffer", "[payload]") {
+  Payload original(std::string(1024, 'x'));
+  Payload copy = original;
+
+  REQUIRE(copy.sharesBufferWith(original));
+  REQUIRE(copy.data() == original.data());
+  REQUIRE(original.useCount() == 2);
+
+  SECTION("slices are views into the same buffer") {
+    Payload body = original.slice(1000);
+    REQUIRE(body.size() == 24);
+    REQUIRE(body.sharesBufferWith(original));
+    REQUIRE(body.data() == original.data() + 1000);
+
+    Payload part = body.slice(4, 10);
+    REQUIRE(part.size() == 10);
+    REQUIRE(part.data() == original.data() + 1004);
+  }
+
+  SECTION("slice length is clamped to the end") {
+    REQUIRE(original.slice(1020, 100).size() == 4);
+    REQUIRE(original.slice(1024).empty());
+  }
+
+  SECTION("slice beyond the end throws") {
+    REQUIRE_THROWS_AS(original.slice(1025), std::out_of_range);
+  }
+}
@@ -0,0 +1,89 @@
+/**
+ * @file test_radio_model.cpp
+ * @brief Unit tests for the distance-based radio model
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/mesh_transport.hpp"
+#include "simulator/network_simulator.hpp"
+#include "simulator/radio_model.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+using namespace simulator;
+
+TEST_CASE("RadioConfig path loss", "[radio_model]") {
+  RadioConfig config;
+  REQUIRE(config.isValid());
+  REQUIRE(std::fabs(config.rssiAt(1.0) - (-20.0)) < 1e-9);
+  REQUIRE(std::fabs(config.rssiAt(10.0) - (-50.0)) < 1e-9);
+  REQUIRE(std::fabs(config.rssiAt(config.getRange()) - config.sensitivity_dbm) < 1e-9);
+  REQUIRE(config.getRange() > 215.0);
+  REQUIRE(config.getRange() < 216.0);
+
+  config.sensitivity_dbm = 0.0;
+  REQUIRE_FALSE(config.isValid());
+  REQUIRE_THROWS_AS(RadioModel(config), std::invalid_argument);
+}
+
+TEST_CASE("RadioModel link quality", "[radio_model]") {
+  RadioModel radio(RadioConfig{});
+  const double range = radio.getConfig().getRange();
+
+  SECTION("strong links are fast and lossless") {
+    REQUIRE(radio.lossAt(10.0) == 0.0f);
+    LatencyConfig latency = radio.latencyAt(10.0);
+    REQUIRE(latency.min_ms == 2);
+    REQUIRE(latency.max_ms == 2);
+  }
+
+  SECTION("links degrade towards the range edge") {
+    REQUIRE(radio.lossAt(range) == radio.getConfig().edge_loss);
+    REQUIRE(radio.latencyAt(range).max_ms == 22);
+    REQUIRE(radio.lossAt(0.9 * range) > 0.0f);
+    REQUIRE(radio.lossAt(0.9 * range) < radio.lossAt(range));
+  }
+}
+
+TEST_CASE("RadioModel connects nodes in range", "[radio_model]") {
+  NetworkSimulator network(7);
+  MeshTransport transport(network);
+  RadioModel radio(RadioConfig{});
+
+  radio.setPosition(1001, {0.0, 0.0});
+  radio.setPosition(1002, {100.0, 0.0});
+  radio.setPosition(1003, {200.0, 0.0});
+  radio.setPosition(1004, {600.0, 0.0});
+
+  REQUIRE(radio.connect(transport, network) == 3);
+  REQUIRE(transport.hasLink(1001, 1002));
+  REQUIRE(transport.hasLink(1002, 1003));
+  REQUIRE(transport.hasLink(1001, 1003));  // 200 m, inside the ~215 m range
+  REQUIRE_FALSE(transport.hasLink(1003, 1004));
+  REQUIRE(radio.getNeighbours(1002) == std::vector<uint32_t>{1001, 1003});
+
+  SECTION("link conditions follow distance in both directions") {
+    REQUIRE(network.getPacketLoss(1001, 1003).probability > 0.0f);
+    REQUIRE(network.getPacketLoss(1003, 1001).probability ==
+            network.getPacketLoss(1001, 1003).probability);
+    REQUIRE(network.getPacketLoss(1001, 1002).probability == 0.0f);
+    REQUIRE(network.getLatency(1001, 1003).max_ms > network.getLatency(1001, 1002).max_ms);
+  }
+
+  SECTION("moving a node relinks only that node") {
+    radio.moveNode(1004, {350.0, 0.0}, transport, network);
+    REQUIRE(transport.hasLink(1003, 1004));
+    REQUIRE_FALSE(transport.hasLink(1002, 1004));
+
+    radio.moveNode(1001, {-300.0, 0.0}, transport, network);
+    REQUIRE_FALSE(transport.hasLink(1001, 1002));
+    REQUIRE_FALSE(transport.hasLink(1001, 1003));
+    REQUIRE(transport.hasLink(1002, 1003));
+    REQUIRE(transport.getLinkCount() == 2);
+  }
+}
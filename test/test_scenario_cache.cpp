@@ -0,0 +1,285 @@
+/**
+ * @file test_scenario_cache.cpp
+ * @brief Unit tests for compiled binary scenarios
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/config_loader.hpp"
+#include "simulator/scenario_cache.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace simulator;
+
+namespace {
+
+const char* SCENARIO_YAML = R"(
+simulation:
+  name: "Cache Test"
+  description: "Every section"
+  duration: 120
+  seed: 7
+  threads: 2
+  max_nodes: 5000
+  firmware_clock: virtual
+  max_tick_ms: 500
+  node_engine: fluid
+
+network:
+  latency:
+    default: {min: 5, max: 40, distribution: normal}
+    specific_connections:
+      - from: "gateway"
+        to: "sensor-0"
+        min: 1
+        max: 2
+  packet_loss:
+    default: {probability: 0.05}
+  transport: in_process
+  delivery_queue: timing_wheel
+  coalesce: true
+  airtime: {bitrate_bps: 6500000, max_wait_ms: 50}
+
+nodes:
+  - id: "gateway"
+    firmware: "bridge"
+    position: [10, -20]
+    clock: {offset_ms: -250, drift_ppm: 40.5}
+    config:
+      mesh_prefix: "CacheMesh"
+      mesh_password: "secret"
+      mqtt_broker: "broker.local"
+      mqtt_port: 1883
+      channel: "6"
+  - template: "sensor"
+    count: 3000
+    id_prefix: "sensor-"
+    config:
+      mesh_prefix: "CacheMesh"
+      mesh_password: "secret"
+      sensor_interval: 1000
+      report: "temperature"
+
+topology:
+  type: star
+  hub: "gateway"
+
+events:
+  - time: 10
+    action: partition_network
+    groups: [["gateway", "sensor-0"], ["sensor-1", "sensor-2"]]
+  - time: 20
+    action: connection_degrade
+    from: "gateway"
+    to: "sensor-1"
+    latency: 250
+    packet_loss: 0.5
+
+churn:
+  - targets: ["sensor-5"]
+    failure: {distribution: weibull, mean: 3600, shape: 1.5}
+    repair: {mean: 60}
+
+traffic:
+  - sink: "gateway"
+    arrival: bursty
+    rate: 2.5
+    burst: 4
+    size: 128
+    stop: 50
+
+metrics:
+  output: "results/cache.csv"
+  interval: 10
+  collect: [latency, delivery]
+  export: [csv, json]
+
+gateway:
+  listen: "127.0.0.1:7000"
+  backend: "127.0.0.1:7001"
+  nodes: ["gateway"]
+  max_datagram: 512
+)";
+
+/**
+ * @brief Parses, expands and validates SCENARIO_YAML
+ */
+ScenarioConfig compile() {
+  ConfigLoader loader;
+  auto config = loader.loadFromString(SCENARIO_YAML);
+  REQUIRE(config.has_value());
+  loader.expandTemplates(*config);
+  REQUIRE(loader.getValidationErrors(*config).empty());
+  return *config;
+}
+
+std::vector<char> readFile(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void writeFile(const std::string& path, const std::vector<char>& bytes) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+} // anonymous namespace
+
+TEST_CASE("ScenarioCache hashes with FNV-1a", "[scenario_cache]") {
+  REQUIRE(ScenarioCache::hash("") == ScenarioCache::HASH_BASIS);
+  REQUIRE(ScenarioCache::hash("a") == 0xaf63dc4c8601ec8cULL);
+  REQUIRE(ScenarioCache::hash("foobar") == 0x85944171f73967e8ULL);
+  // Chaining continues the same hash
+  REQUIRE(ScenarioCache::hash("bar", ScenarioCache::hash("foo")) == ScenarioCache::hash("foobar"));
+  REQUIRE(ScenarioCache::pathFor("scenarios/big.yaml") == "scenarios/big.yaml.pmsc");
+}
+
+TEST_CASE("ScenarioCache round-trips a configuration", "[scenario_cache]") {
+  const ScenarioConfig original = compile();
+
+  CheckpointWriter out;
+  ScenarioCache::write(out, original);
+  CheckpointReader in(out.data());
+  const ScenarioConfig config = ScenarioCache::read(in);
+  REQUIRE(in.remaining() == 0);
+
+  SECTION("every section survives") {
+    REQUIRE(config.simulation.name == "Cache Test");
+    REQUIRE(config.simulation.description == "Every section");
+    REQUIRE(config.simulation.duration == 120);
+    REQUIRE(config.simulation.seed == 7);
+    REQUIRE(config.simulation.threads == 2);
+    REQUIRE(config.simulation.max_nodes == 5000);
+    REQUIRE(config.simulation.firmware_clock == "virtual");
+    REQUIRE(config.simulation.max_tick_ms == 500);
+    REQUIRE(config.simulation.node_engine == "fluid");
+
+    REQUIRE(config.network.default_latency == original.network.default_latency);
+    REQUIRE(config.network.specific_latencies.size() == 1);
+    REQUIRE(config.network.specific_latencies[0].to == "sensor-0");
+    REQUIRE(config.network.specific_latencies[0].config.max_ms == 2);
+    REQUIRE(config.network.default_packet_loss.probability ==
+            original.network.default_packet_loss.probability);
+    REQUIRE(config.network.transport == "in_process");
+    REQUIRE(config.network.delivery_queue == "timing_wheel");
+    REQUIRE(config.network.coalesce);
+    REQUIRE(config.network.airtime.bitrate_bps == 6500000);
+    REQUIRE(config.network.airtime.max_wait_ms == 50);
+
+    REQUIRE(config.topology.type == TopologyType::STAR);
+    REQUIRE(*config.topology.hub == "gateway");
+
+    REQUIRE(config.events.size() == 2);
+    REQUIRE(config.events[0].action == EventAction::PARTITION_NETWORK);
+    REQUIRE(config.events[0].groups == original.events[0].groups);
+    REQUIRE(config.events[1].latency == 250);
+    REQUIRE(config.events[1].packet_loss == 0.5f);
+
+    REQUIRE(config.churn.size() == 1);
+    REQUIRE(config.churn[0].targets == std::vector<std::string>{"sensor-5"});
+    REQUIRE(config.churn[0].failure.distribution == "weibull");
+    REQUIRE(config.churn[0].failure.shape == 1.5);
+
+    REQUIRE(config.traffic.size() == 1);
+    REQUIRE(config.traffic[0].sink == "gateway");
+    REQUIRE(config.traffic[0].sources.empty());
+    REQUIRE(config.traffic[0].arrival == "bursty");
+    REQUIRE(config.traffic[0].rate == 2.5);
+    REQUIRE(config.traffic[0].burst == 4);
+    REQUIRE(config.traffic[0].size == 128);
+    REQUIRE(config.traffic[0].stop == 50);
+
+    REQUIRE(config.metrics.output == "results/cache.csv");
+    REQUIRE(config.metrics.collect == original.metrics.collect);
+    REQUIRE(config.metrics.export_formats == original.metrics.export_formats);
+
+    REQUIRE(config.gateway.listen == "127.0.0.1:7000");
+    REQUIRE(config.gateway.backend == "127.0.0.1:7001");
+    REQUIRE(config.gateway.nodes == std::vector<std::string>{"gateway"});
+    REQUIRE(config.gateway.max_datagram == 512);
+    REQUIRE_FALSE(config.gateway.broadcasts);
+  }
+
+  SECTION("nodes and templates survive") {
+    REQUIRE(config.nodes.size() == 3001);
+    REQUIRE(config.templates.size() == 1);
+    REQUIRE(config.templates[0].count == 3000);
+    REQUIRE(config.templates[0].id_prefix == "sensor-");
+
+    for (size_t i = 0; i < config.nodes.size(); ++i) {
+      REQUIRE(config.nodes[i].id == original.nodes[i].id);
+      REQUIRE(config.nodes[i].nodeId == original.nodes[i].nodeId);
+    }
+    const auto& gateway = config.nodes[0];
+    REQUIRE(gateway.position == std::vector<int>{10, -20});
+    REQUIRE(gateway.mesh_password == "secret");
+    REQUIRE(*gateway.mqtt_broker == "broker.local");
+    REQUIRE(*gateway.mqtt_port == 1883);
+    REQUIRE_FALSE(gateway.sensor_interval.has_value());
+    REQUIRE(gateway.firmwareConfig->at("channel") == "6");
+    REQUIRE(gateway.clock_offset_ms == -250);
+    REQUIRE(gateway.clock_drift_ppm == 40.5);
+    REQUIRE(config.nodes[1].clock_drift_ppm == 0.0);
+
+    REQUIRE(*config.nodes[1].sensor_interval == 1000);
+    REQUIRE(config.nodes[1].firmwareConfig->at("report") == "temperature");
+  }
+
+  SECTION("template nodes still share one firmware configuration") {
+    REQUIRE(config.nodes[1].firmwareConfig == config.nodes[3000].firmwareConfig);
+    REQUIRE(config.nodes[1].firmwareConfig == config.templates[0].base_config.firmwareConfig);
+    REQUIRE(config.nodes[0].firmwareConfig != config.nodes[1].firmwareConfig);
+  }
+}
+
+TEST_CASE("ScenarioCache files", "[scenario_cache]") {
+  const std::string path = "test_scenario_cache.pmsc";
+  const uint64_t key = ScenarioCache::hash(SCENARIO_YAML);
+  const ScenarioConfig original = compile();
+  ScenarioCache::save(path, key, original);
+
+  SECTION("a matching key loads the image") {
+    auto config = ScenarioCache::load(path, key);
+    REQUIRE(config.has_value());
+    REQUIRE(config->nodes.size() == original.nodes.size());
+    REQUIRE(config->nodes.back().id == original.nodes.back().id);
+  }
+
+  SECTION("another key is a miss") {
+    REQUIRE_FALSE(ScenarioCache::load(path, key + 1).has_value());
+  }
+
+  SECTION("missing, truncated and corrupt images are misses") {
+    REQUIRE_FALSE(ScenarioCache::load("no_such_scenario.pmsc", key).has_value());
+
+    std::vector<char> bytes = readFile(path);
+    std::vector<char> truncated(bytes.begin(), bytes.end() - 1);
+    writeFile(path, truncated);
+    REQUIRE_FALSE(ScenarioCache::load(path, key).has_value());
+
+    bytes[0] = 'X';
+    writeFile(path, bytes);
+    REQUIRE_FALSE(ScenarioCache::load(path, key).has_value());
+
+    writeFile(path, {});
+    REQUIRE_FALSE(ScenarioCache::load(path, key).has_value());
+  }
+
+  SECTION("saving replaces an older image") {
+    ScenarioConfig smaller = original;
+    smaller.nodes.resize(1);
+    ScenarioCache::save(path, key + 1, smaller);
+    REQUIRE_FALSE(ScenarioCache::load(path, key).has_value());
+    REQUIRE(ScenarioCache::load(path, key + 1)->nodes.size() == 1);
+  }
+
+  std::remove(path.c_str());
+}
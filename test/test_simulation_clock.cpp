@@ -0,0 +1,114 @@
+/**
+ * @file test_simulation_clock.cpp
+ * @brief Unit tests for SimulationClock class
+ * 
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/simulation_clock.hpp"
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace simulator;
+
+TEST_CASE("SimulationClock construction", "[simulation_clock]") {
+  SECTION("defaults to real-time mode") {
+    SimulationClock clock;
+    REQUIRE(clock.getMode() == SimulationClock::Mode::REAL_TIME);
+    REQUIRE(clock.getTimeScale() == 1.0f);
+    REQUIRE(clock.nowUs() == 0);
+  }
+  
+  SECTION("zero time scale selects unbounded mode") {
+    SimulationClock clock(TIME_SCALE_UNBOUNDED);
+    REQUIRE(clock.getMode() == SimulationClock::Mode::UNBOUNDED);
+  }
+  
+  SECTION("throws on negative time scale") {
+    REQUIRE_THROWS_AS(SimulationClock(-1.0f), std::invalid_argument);
+  }
+}
+
+TEST_CASE("SimulationClock advances virtual time", "[simulation_clock]") {
+  SimulationClock clock(TIME_SCALE_UNBOUNDED);
+  clock.start();
+  
+  SECTION("advanceTo sets absolute time") {
+    clock.advanceTo(2500000);
+    REQUIRE(clock.nowUs() == 2500000);
+    REQUIRE(clock.nowMs() == 2500);
+  }
+  
+  SECTION("advanceBy adds relative time") {
+    clock.advanceBy(1000);
+    clock.advanceBy(1500);
+    REQUIRE(clock.nowUs() == 2500);
+  }
+  
+  SECTION("never moves backwards") {
+    clock.advanceTo(5000);
+    clock.advanceTo(1000);
+    REQUIRE(clock.nowUs() == 5000);
+  }
+  
+  SECTION("start resets to zero") {
+    clock.advanceTo(5000);
+    clock.start();
+    REQUIRE(clock.nowUs() == 0);
+  }
+}
+
+TEST_CASE("SimulationClock pacing", "[simulation_clock]") {
+  SECTION("unbounded mode covers an hour without sleeping") {
+    SimulationClock clock(TIME_SCALE_UNBOUNDED);
+    clock.start();
+    
+    for (uint64_t t = 0; t < 3600ULL * 1000000ULL; t += SimulationClock::DEFAULT_TICK_US) {
+      clock.advanceTo(t + SimulationClock::DEFAULT_TICK_US);
+    }
+    
+    REQUIRE(clock.nowMs() == 3600000);
+    REQUIRE(clock.wallElapsedUs() < 1000000);
+    REQUIRE(clock.getSpeedup() > 1.0);
+  }
+  
+  SECTION("real-time mode waits for scaled wall time") {
+    SimulationClock clock(10.0f);
+    clock.start();
+    
+    // 200ms of simulated time at 10x should take about 20ms of wall time
+    clock.advanceTo(200000);
+    
+    REQUIRE(clock.nowMs() == 200);
+    REQUIRE(clock.wallElapsedUs() >= 20000);
+    REQUIRE(clock.getOverrunCount() == 0);
+  }
+  
+  SECTION("real-time mode counts steps that overran their deadline") {
+    SimulationClock clock(1.0f);
+    clock.start();
+    
+    // 20ms of work for a 1ms step
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    clock.advanceTo(1000);
+    REQUIRE(clock.nowUs() == 1000);
+    REQUIRE(clock.getOverrunCount() == 1);
+    REQUIRE(clock.getMaxLagUs() >= 15000);
+    
+    // Unbounded runs never lag
+    SimulationClock unbounded(TIME_SCALE_UNBOUNDED);
+    unbounded.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    unbounded.advanceTo(1000);
+    REQUIRE(unbounded.getOverrunCount() == 0);
+    
+    clock.start();
+    REQUIRE(clock.getOverrunCount() == 0);
+    REQUIRE(clock.getMaxLagUs() == 0);
+  }
+}
@@ -0,0 +1,93 @@
+/**
+ * @file test_slot_map.cpp
+ * @brief Unit tests for SlotMap class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/slot_map.hpp"
+
+#include <memory>
+#include <vector>
+
+using namespace simulator;
+
+TEST_CASE("SlotMap stores values behind stable handles", "[slot_map]") {
+  SlotMap<int> map;
+
+  SECTION("starts empty") {
+    REQUIRE(map.empty());
+    REQUIRE(map.size() == 0);
+    REQUIRE(map.get(SlotHandle()) == nullptr);
+    REQUIRE_FALSE(map.erase(SlotHandle()));
+  }
+
+  SECTION("insert and get") {
+    SlotHandle a = map.insert(10);
+    SlotHandle b = map.insert(20);
+    REQUIRE(a.valid());
+    REQUIRE(a != b);
+    REQUIRE(map.size() == 2);
+    REQUIRE(*map.get(a) == 10);
+    REQUIRE(*map.get(b) == 20);
+
+    *map.get(a) = 11;
+    REQUIRE(*map.get(a) == 11);
+  }
+
+  SECTION("handles survive the swap-remove of other values") {
+    SlotHandle a = map.insert(1);
+    SlotHandle b = map.insert(2);
+    SlotHandle c = map.insert(3);
+
+    REQUIRE(map.erase(a));
+    REQUIRE(map.size() == 2);
+    REQUIRE(map.get(a) == nullptr);
+    REQUIRE(*map.get(b) == 2);
+    REQUIRE(*map.get(c) == 3);
+
+    // The last value moved into the hole
+    std::vector<int> order(map.begin(), map.end());
+    REQUIRE(order == std::vector<int>{3, 2});
+  }
+
+  SECTION("stale handles do not resolve to reused slots") {
+    SlotHandle a = map.insert(1);
+    REQUIRE(map.erase(a));
+    REQUIRE_FALSE(map.erase(a));
+
+    SlotHandle b = map.insert(2);
+    REQUIRE(b.index == a.index);
+    REQUIRE(b.generation != a.generation);
+    REQUIRE_FALSE(map.contains(a));
+    REQUIRE(map.get(a) == nullptr);
+    REQUIRE(*map.get(b) == 2);
+  }
+}
+
+TEST_CASE("SlotMap holds move-only values", "[slot_map]") {
+  SlotMap<std::unique_ptr<int>> map;
+  std::vector<SlotHandle> handles;
+  for (int i = 0; i < 100; ++i) {
+    handles.push_back(map.insert(std::unique_ptr<int>(new int(i))));
+  }
+  for (int i = 0; i < 100; i += 2) {
+    REQUIRE(map.erase(handles[i]));
+  }
+
+  REQUIRE(map.size() == 50);
+  bool intact = true;
+  for (int i = 1; i < 100; i += 2) {
+    intact = intact && map.get(handles[i]) && **map.get(handles[i]) == i;
+  }
+  REQUIRE(intact);
+
+  int sum = 0;
+  for (const auto& value : map) {
+    sum += *value;
+  }
+  REQUIRE(sum == 2500);
+}
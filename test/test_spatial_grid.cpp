@@ -0,0 +1,69 @@
+/**
+ * @file test_spatial_grid.cpp
+ * @brief Unit tests for SpatialGrid class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/spatial_grid.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+using namespace simulator;
+
+TEST_CASE("SpatialGrid range queries", "[spatial_grid]") {
+  SpatialGrid grid(100.0);
+  grid.insert(1, {0.0, 0.0});
+  grid.insert(2, {60.0, 80.0});    // 100 m from node 1
+  grid.insert(3, {-99.0, 0.0});    // Neighbouring cell
+  grid.insert(4, {250.0, 0.0});    // Out of range
+  grid.insert(5, {-70.0, -71.0});  // Just over 99.7 m
+
+  SECTION("finds nodes within the radius across cells") {
+    REQUIRE(grid.size() == 5);
+    REQUIRE(grid.getNeighbours(1, 100.0) == std::vector<uint32_t>{2, 3, 5});
+    REQUIRE(grid.getNeighbours(4, 100.0).empty());
+  }
+
+  SECTION("reports distances") {
+    double distance = 0.0;
+    grid.forEachWithin({0.0, 0.0}, 100.0, [&distance](uint32_t id, double d) {
+      if (id == 2) {
+        distance = d;
+      }
+    });
+    REQUIRE(distance == 100.0);
+  }
+
+  SECTION("smaller radius than the cell size") {
+    REQUIRE(grid.getNeighbours(1, 99.5) == std::vector<uint32_t>{3});
+  }
+
+  SECTION("moving reindexes the node") {
+    REQUIRE(grid.move(4, {50.0, 0.0}));
+    REQUIRE_FALSE(grid.move(4, {55.0, 0.0}));  // Same cell
+    REQUIRE(grid.getNeighbours(1, 100.0) == std::vector<uint32_t>{2, 3, 4, 5});
+    REQUIRE(grid.getPosition(4).x == 55.0);
+  }
+
+  SECTION("removing keeps the other nodes of the cell") {
+    grid.insert(6, {10.0, 10.0});
+    REQUIRE(grid.remove(1));
+    REQUIRE_FALSE(grid.remove(1));
+    REQUIRE_FALSE(grid.contains(1));
+    REQUIRE(grid.getNeighbours(6, 20.0).empty());
+    REQUIRE(grid.getNeighbours(3, 150.0) == std::vector<uint32_t>{5, 6});
+  }
+
+  SECTION("unknown nodes throw") {
+    REQUIRE_THROWS_AS(grid.move(99, {0.0, 0.0}), std::out_of_range);
+  }
+}
+
+TEST_CASE("SpatialGrid rejects non-positive cells", "[spatial_grid]") {
+  REQUIRE_THROWS_AS(SpatialGrid(0.0), std::invalid_argument);
+}
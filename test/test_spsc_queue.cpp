@@ -0,0 +1,126 @@
+/**
+ * @file test_spsc_queue.cpp
+ * @brief Unit tests for SpscQueue and Mailbox
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/spsc_queue.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace simulator;
+
+TEST_CASE("SpscQueue basic operations", "[spsc_queue]") {
+  SpscQueue<int> queue(4);
+  int value = 0;
+
+  SECTION("starts empty") {
+    REQUIRE(queue.empty());
+    REQUIRE_FALSE(queue.tryPop(value));
+  }
+
+  SECTION("capacity is rounded up to a power of two") {
+    SpscQueue<int> odd(5);
+    REQUIRE(odd.capacity() == 8);
+  }
+
+  SECTION("zero capacity is rejected") {
+    REQUIRE_THROWS_AS(SpscQueue<int>(0), std::invalid_argument);
+  }
+
+  SECTION("elements come out in FIFO order") {
+    REQUIRE(queue.tryPush(1));
+    REQUIRE(queue.tryPush(2));
+    REQUIRE(queue.tryPush(3));
+    REQUIRE(queue.size() == 3);
+
+    REQUIRE(queue.tryPop(value));
+    REQUIRE(value == 1);
+    REQUIRE(queue.tryPop(value));
+    REQUIRE(value == 2);
+    REQUIRE(queue.tryPop(value));
+    REQUIRE(value == 3);
+    REQUIRE(queue.empty());
+  }
+
+  SECTION("push fails when full and succeeds after a pop") {
+    for (int i = 0; i < 4; ++i) {
+      REQUIRE(queue.tryPush(std::move(i)));
+    }
+    REQUIRE_FALSE(queue.tryPush(99));
+
+    REQUIRE(queue.tryPop(value));
+    REQUIRE(queue.tryPush(99));
+  }
+
+  SECTION("indices wrap around the ring") {
+    for (int round = 0; round < 10; ++round) {
+      REQUIRE(queue.tryPush(std::move(round)));
+      REQUIRE(queue.tryPop(value));
+      REQUIRE(value == round);
+    }
+  }
+}
+
+TEST_CASE("SpscQueue transfers between threads", "[spsc_queue]") {
+  SpscQueue<uint32_t> queue(64);
+  const uint32_t count = 100000;
+
+  std::thread producer([&queue, count]() {
+    for (uint32_t i = 0; i < count; ++i) {
+      uint32_t value = i;
+      while (!queue.tryPush(std::move(value))) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  bool in_order = true;
+  uint32_t expected = 0;
+  while (expected < count) {
+    uint32_t value;
+    if (queue.tryPop(value)) {
+      in_order = in_order && value == expected;
+      expected++;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+
+  REQUIRE(in_order);
+  REQUIRE(queue.empty());
+}
+
+TEST_CASE("Mailbox spills beyond the ring", "[spsc_queue]") {
+  Mailbox<std::string> mailbox(2);
+
+  mailbox.post("a");
+  mailbox.post("b");
+  mailbox.post("c");  // Ring is full
+  mailbox.post("d");
+  REQUIRE(mailbox.size() == 4);
+
+  std::vector<std::string> drained;
+  size_t count = mailbox.drain([&drained](std::string& value) {
+    drained.push_back(value);
+  });
+
+  REQUIRE(count == 4);
+  REQUIRE(drained == std::vector<std::string>{"a", "b", "c", "d"});
+  REQUIRE(mailbox.size() == 0);
+
+  SECTION("mailbox is reusable after a drain") {
+    mailbox.post("e");
+    drained.clear();
+    mailbox.drain([&drained](std::string& value) { drained.push_back(value); });
+    REQUIRE(drained == std::vector<std::string>{"e"});
+  }
+}
@@ -0,0 +1,98 @@
+/**
+ * @file test_stack_sampler.cpp
+ * @brief Unit tests for StackSampler
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/stack_sampler.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace simulator;
+
+namespace {
+
+/// Burns CPU time on the calling thread for about @p ms milliseconds
+double spin(int ms) {
+  const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+  double sum = 0.0;
+  while (std::chrono::steady_clock::now() < end) {
+    for (int i = 0; i < 1000; ++i) {
+      sum += std::sqrt(static_cast<double>(i));
+    }
+  }
+  return sum;
+}
+
+} // anonymous namespace
+
+TEST_CASE("StackSampler samples the calling thread", "[stack_sampler]") {
+  if (!StackSampler::isSupported()) {
+    StackSampler sampler;
+    REQUIRE_THROWS_AS(sampler.start(), std::runtime_error);
+    return;
+  }
+
+  StackSampler sampler(1000, 1000);
+  sampler.start();
+  REQUIRE(sampler.isRunning());
+  volatile double sink = spin(100);
+  (void)sink;
+  sampler.stop();
+  REQUIRE_FALSE(sampler.isRunning());
+
+  // About 100 samples of 100 ms CPU time; leave room for slow machines
+  const size_t samples = sampler.getSampleCount();
+  REQUIRE(samples >= 20);
+  REQUIRE(sampler.getDroppedCount() == 0);
+
+  SECTION("folded stacks add up to the samples") {
+    std::ostringstream folded;
+    sampler.writeFolded(folded);
+    std::istringstream lines(folded.str());
+    std::string line;
+    size_t total = 0;
+    while (std::getline(lines, line)) {
+      const size_t space = line.rfind(' ');
+      REQUIRE(space != std::string::npos);
+      total += std::stoul(line.substr(space + 1));
+    }
+    REQUIRE(total <= samples);
+    REQUIRE(total >= samples - samples / 10);
+  }
+
+  SECTION("the report lists the hottest functions") {
+    std::ostringstream report;
+    sampler.printTop(report, 5);
+    REQUIRE(report.str().find("Top of stack in ") == 0);
+    REQUIRE(report.str().find("%  ") != std::string::npos);
+  }
+
+  SECTION("a full buffer drops samples") {
+    StackSampler small(1000, 5);
+    small.start();
+    volatile double more = spin(50);
+    (void)more;
+    small.stop();
+    REQUIRE(small.getSampleCount() == 5);
+    REQUIRE(small.getDroppedCount() > 0);
+  }
+
+  SECTION("only one sampler runs at a time") {
+    StackSampler first;
+    StackSampler second;
+    first.start();
+    REQUIRE_THROWS_AS(second.start(), std::runtime_error);
+    first.stop();
+    REQUIRE_NOTHROW(second.start());
+    second.stop();
+  }
+}
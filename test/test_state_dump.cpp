@@ -0,0 +1,117 @@
+/**
+ * @file test_state_dump.cpp
+ * @brief Unit tests for StateDump
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/state_dump.hpp"
+#include "simulator/loop_monitor.hpp"
+#include "simulator/metrics_collector.hpp"
+#include "simulator/network_simulator.hpp"
+#include "simulator/node_manager.hpp"
+
+#include <boost/asio.hpp>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace simulator;
+
+namespace {
+
+const std::string DUMP_DIR = "test_state_dump_dir";
+
+std::string readFile(const std::string& path) {
+  std::ifstream in(path);
+  std::stringstream text;
+  text << in.rdbuf();
+  return text.str();
+}
+
+bool contains(const std::string& text, const std::string& part) {
+  return text.find(part) != std::string::npos;
+}
+
+} // anonymous namespace
+
+TEST_CASE("StateDump takes requests from signals and files", "[state_dump]") {
+  MetricsCollector::makeParentDirectories(DUMP_DIR + "/dump.request");
+
+  SECTION("a request is consumed once") {
+    StateDump dump(DUMP_DIR, 0, false);
+    StateDump::request();
+    REQUIRE(dump.isRequested());
+    REQUIRE_FALSE(dump.isRequested());
+  }
+
+  SECTION("a request file is consumed and removed") {
+    StateDump dump(DUMP_DIR, 0, false);
+    std::ofstream(DUMP_DIR + "/dump.request") << "\n";
+    REQUIRE(dump.isRequested());
+    REQUIRE_FALSE(std::ifstream(DUMP_DIR + "/dump.request"));
+    REQUIRE_FALSE(dump.isRequested());
+  }
+
+  std::remove((DUMP_DIR + "/dump.request").c_str());
+  std::remove(DUMP_DIR.c_str());
+}
+
+TEST_CASE("StateDump writes the state and node costs", "[state_dump]") {
+  boost::asio::io_context io;
+  NodeManager manager(io);
+  NetworkSimulator network(1);
+  network.enqueueMessage(1, 2, Payload("x"), 0);
+  network.enqueueMessage(2, 1, Payload("y"), 0);
+  LoopMonitor monitor;
+  monitor.recordTick(250);
+
+  SECTION("a zero window writes the state at once") {
+    StateDump dump(DUMP_DIR, 0, false);
+    dump.begin(2500000, 25, manager, network, nullptr, nullptr, monitor);
+    REQUIRE_FALSE(dump.isCollecting());
+    REQUIRE(dump.getDumpCount() == 1);
+    REQUIRE(dump.getLastPath() == DUMP_DIR + "/state_dump_1.txt");
+
+    const std::string text = readFile(dump.getLastPath());
+    REQUIRE(text.find("State dump 1 at ") == 0);
+    REQUIRE(contains(text, "Virtual time: 2.500 s after 25 ticks\n"));
+    REQUIRE(contains(text, "Nodes: 0 (0 running, 0 asleep)\n"));
+    REQUIRE(contains(text, "Messages in flight: 2\n"));
+    REQUIRE(contains(text, "Tick time (us): p50=250"));
+    REQUIRE_FALSE(contains(text, "Node updates in the"));
+  }
+
+  SECTION("a window times node updates and detaches its monitor") {
+    StateDump dump(DUMP_DIR, 1, false);
+    dump.begin(0, 0, manager, network, nullptr, nullptr, monitor);
+    REQUIRE(dump.isCollecting());
+    REQUIRE(manager.getLoopMonitor() == &monitor);
+    REQUIRE(monitor.hasNodeCosts());
+
+    UpdateTiming timing;
+    timing.loop_ns = 40000;
+    monitor.recordUpdate(0, 7, timing, nullptr);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    REQUIRE(dump.isWindowOver());
+    dump.finish();
+
+    REQUIRE_FALSE(dump.isCollecting());
+    REQUIRE(manager.getLoopMonitor() == nullptr);
+    REQUIRE_FALSE(monitor.hasNodeCosts());
+    REQUIRE(monitor.getUpdateHistogram().getCount() == 0);
+
+    const std::string text = readFile(dump.getLastPath());
+    REQUIRE(contains(text, " ms window: 1 taking 0.0 ms\n"));
+    REQUIRE(contains(text, "  node 7 ((none)): 40.0 / 40.0 / 40.0 in 1 updates\n"));
+  }
+
+  std::remove((DUMP_DIR + "/state_dump_1.txt").c_str());
+  std::remove(DUMP_DIR.c_str());
+}
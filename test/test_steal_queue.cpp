@@ -0,0 +1,101 @@
+/**
+ * @file test_steal_queue.cpp
+ * @brief Unit tests for StealQueue class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/steal_queue.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace simulator;
+
+TEST_CASE("StealQueue hands out tasks from both ends", "[steal_queue]") {
+  StealQueue<int> queue;
+  int value = 0;
+
+  SECTION("starts empty") {
+    REQUIRE(queue.remaining() == 0);
+    REQUIRE_FALSE(queue.pop(value));
+    REQUIRE_FALSE(queue.steal(value));
+  }
+
+  SECTION("owner pops from the front, thieves steal from the back") {
+    queue.reset({1, 2, 3, 4});
+    REQUIRE(queue.remaining() == 4);
+
+    REQUIRE(queue.pop(value));
+    REQUIRE(value == 1);
+    REQUIRE(queue.steal(value));
+    REQUIRE(value == 4);
+    REQUIRE(queue.steal(value));
+    REQUIRE(value == 3);
+    REQUIRE(queue.pop(value));
+    REQUIRE(value == 2);
+
+    REQUIRE(queue.remaining() == 0);
+    REQUIRE_FALSE(queue.pop(value));
+    REQUIRE_FALSE(queue.steal(value));
+  }
+
+  SECTION("reset refills a drained queue") {
+    queue.reset({7});
+    REQUIRE(queue.pop(value));
+    queue.reset({8, 9});
+    REQUIRE(queue.remaining() == 2);
+    REQUIRE(queue.steal(value));
+    REQUIRE(value == 9);
+  }
+}
+
+TEST_CASE("StealQueue hands out each task once under contention", "[steal_queue]") {
+  const int count = 20000;
+  std::vector<int> tasks;
+  for (int i = 0; i < count; ++i) {
+    tasks.push_back(i);
+  }
+
+  StealQueue<int> queue;
+  queue.reset(tasks);
+
+  std::vector<std::atomic<int>> taken(count);
+  for (auto& flag : taken) {
+    flag.store(0);
+  }
+
+  std::vector<std::thread> thieves;
+  for (int t = 0; t < 3; ++t) {
+    thieves.emplace_back([&queue, &taken]() {
+      int task;
+      while (queue.steal(task)) {
+        taken[task]++;
+      }
+    });
+  }
+
+  int task;
+  bool in_order = true;
+  int previous = -1;
+  while (queue.pop(task)) {
+    in_order = in_order && task > previous;
+    previous = task;
+    taken[task]++;
+  }
+  for (auto& thief : thieves) {
+    thief.join();
+  }
+
+  bool once = true;
+  for (auto& flag : taken) {
+    once = once && flag.load() == 1;
+  }
+  REQUIRE(once);
+  REQUIRE(in_order);
+  REQUIRE(queue.remaining() == 0);
+}
@@ -0,0 +1,122 @@
+/**
+ * @file test_task_queue.cpp
+ * @brief Unit tests for TaskQueue
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/task_queue.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+using namespace simulator;
+
+TEST_CASE("TaskQueue runs due tasks earliest first", "[task_queue]") {
+  TaskQueue tasks;
+  std::vector<int> order;
+  REQUIRE(tasks.getNextRunMs() == UINT64_MAX);
+
+  tasks.schedule(300, 0, 1, [&]() { order.push_back(3); });
+  tasks.schedule(100, 0, 1, [&]() { order.push_back(1); });
+  tasks.schedule(200, 0, 1, [&]() { order.push_back(2); });
+  tasks.schedule(100, 0, 1, [&]() { order.push_back(4); });  // Ties in scheduling order
+  REQUIRE(tasks.size() == 4);
+  REQUIRE(tasks.getNextRunMs() == 100);
+
+  REQUIRE(tasks.runDue(99) == 0);
+  REQUIRE(tasks.runDue(200) == 3);
+  REQUIRE(order == std::vector<int>({1, 4, 2}));
+  REQUIRE(tasks.getNextRunMs() == 300);
+
+  REQUIRE(tasks.runDue(1000) == 1);
+  REQUIRE(tasks.empty());
+  REQUIRE(tasks.getNextRunMs() == UINT64_MAX);
+}
+
+TEST_CASE("TaskQueue repeats periodic tasks and skips missed runs", "[task_queue]") {
+  TaskQueue tasks;
+  int runs = 0;
+  tasks.schedule(100, 100, TaskQueue::FOREVER, [&]() { runs++; });
+
+  REQUIRE(tasks.runDue(100) == 1);
+  REQUIRE(tasks.getNextRunMs() == 200);
+  REQUIRE(tasks.runDue(250) == 1);
+  REQUIRE(tasks.getNextRunMs() == 300);
+
+  // A long gap runs the task once, on the schedule's next slot after now
+  REQUIRE(tasks.runDue(1000) == 1);
+  REQUIRE(tasks.getNextRunMs() == 1001);
+  REQUIRE(runs == 3);
+}
+
+TEST_CASE("TaskQueue stops a task after its iterations", "[task_queue]") {
+  TaskQueue tasks;
+  int runs = 0;
+  TaskId id = tasks.schedule(10, 10, 3, [&]() { runs++; });
+
+  for (uint64_t now = 10; now <= 100; now += 10) {
+    tasks.runDue(now);
+  }
+  REQUIRE(runs == 3);
+  REQUIRE_FALSE(tasks.contains(id));
+  REQUIRE(tasks.empty());
+}
+
+TEST_CASE("TaskQueue cancels tasks, also from their own callback", "[task_queue]") {
+  TaskQueue tasks;
+  int a_runs = 0;
+  int b_runs = 0;
+  TaskId a = tasks.schedule(10, 10, TaskQueue::FOREVER, [&]() { a_runs++; });
+  TaskId b;
+  b = tasks.schedule(10, 10, TaskQueue::FOREVER, [&]() {
+    b_runs++;
+    REQUIRE(tasks.cancel(b));
+    REQUIRE_FALSE(tasks.cancel(b));
+    REQUIRE_FALSE(tasks.contains(b));
+  });
+
+  REQUIRE(tasks.cancel(a));
+  REQUIRE_FALSE(tasks.cancel(a));
+  REQUIRE(tasks.getNextRunMs() == 10);
+
+  REQUIRE(tasks.runDue(100) == 1);
+  REQUIRE(tasks.runDue(200) == 0);
+  REQUIRE(a_runs == 0);
+  REQUIRE(b_runs == 1);
+  REQUIRE(tasks.empty());
+  REQUIRE(tasks.getNextRunMs() == UINT64_MAX);
+}
+
+TEST_CASE("TaskQueue runs tasks scheduled by a callback when due", "[task_queue]") {
+  TaskQueue tasks;
+  std::vector<int> order;
+  tasks.schedule(10, 0, 1, [&]() {
+    order.push_back(1);
+    tasks.schedule(10, 0, 1, [&]() { order.push_back(2); });
+    tasks.schedule(50, 0, 1, [&]() { order.push_back(3); });
+  });
+
+  REQUIRE(tasks.runDue(20) == 2);
+  REQUIRE(order == std::vector<int>({1, 2}));
+  REQUIRE(tasks.getNextRunMs() == 50);
+}
+
+TEST_CASE("TaskQueue keeps a task whose callback throws", "[task_queue]") {
+  TaskQueue tasks;
+  TaskId id = tasks.schedule(10, 10, TaskQueue::FOREVER, []() { throw std::runtime_error("boom"); });
+
+  REQUIRE_THROWS_AS(tasks.runDue(10), std::runtime_error);
+  REQUIRE(tasks.contains(id));
+  REQUIRE(tasks.getNextRunMs() == 20);
+
+  REQUIRE_THROWS_AS(tasks.schedule(0, 10, 0, []() {}), std::invalid_argument);
+  REQUIRE_THROWS_AS(tasks.schedule(0, 10, 1, std::function<void()>()), std::invalid_argument);
+
+  tasks.clear();
+  REQUIRE(tasks.empty());
+  REQUIRE_FALSE(tasks.contains(id));
+}
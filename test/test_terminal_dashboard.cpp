@@ -0,0 +1,122 @@
+/**
+ * @file test_terminal_dashboard.cpp
+ * @brief Unit tests for TerminalDashboard
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/terminal_dashboard.hpp"
+#include "simulator/node_manager.hpp"
+
+#include <boost/asio.hpp>
+#include <sstream>
+#include <string>
+
+using namespace simulator;
+
+namespace {
+
+bool contains(const std::string& text, const std::string& line) {
+  return text.find(line) != std::string::npos;
+}
+
+NetworkSimulator::LinkCounters makeLink(uint32_t from, uint32_t to, uint64_t delivered) {
+  NetworkSimulator::LinkCounters link;
+  link.from = from;
+  link.to = to;
+  link.message_count = delivered;
+  link.delivered_count = delivered;
+  link.total_latency_ms = delivered * 12;
+  return link;
+}
+
+} // anonymous namespace
+
+TEST_CASE("TerminalDashboard renders a snapshot", "[terminal_dashboard]") {
+  DashboardSnapshot snapshot;
+  snapshot.virtual_us = 30000000;
+  snapshot.duration_us = 60000000;
+  snapshot.updates = 3000;
+  snapshot.tick_rate = 1500.0;
+  snapshot.time_ratio = 15.0;
+  snapshot.nodes = 10;
+  snapshot.nodes_running = 9;
+  snapshot.nodes_sleeping = 4;
+  snapshot.pending_messages = 7;
+  snapshot.pending_events = 2;
+  snapshot.frames.frames_dropped = 3;
+
+  DashboardNode node;
+  node.id = 42;
+  node.messages_sent = 100;
+  node.messages_received = 80;
+  snapshot.busiest_nodes = {node};
+  snapshot.busiest_links = {makeLink(1, 2, 10)};
+
+  std::string text;
+  TerminalDashboard::render(snapshot, text);
+  REQUIRE(contains(text, "virtual 30.0 s / 60 s  [###############...............]  50%\n"));
+  REQUIRE(contains(text, "(1500.0/s)   Sim/wall 15.00x\n"));
+  REQUIRE(contains(text, "Nodes 10   running 9   sleeping 4\n"));
+  REQUIRE(contains(text, "Queues   messages 7   events 2\n"));
+  REQUIRE(contains(text, "dropped 3\n"));
+  REQUIRE(contains(text, "Partitions   none\n"));
+  REQUIRE(contains(text, "          42*        100         80\n"));
+  REQUIRE(contains(text, "           1 -> 2                  10          0      12.0\n"));
+
+  SECTION("unlimited runs have no progress bar") {
+    snapshot.duration_us = 0;
+    TerminalDashboard::render(snapshot, text);
+    REQUIRE(text.find("painlessMesh simulator   virtual 30.0 s\n") == 0);
+  }
+
+  SECTION("partitions and dropped links are shown") {
+    snapshot.partitions = 2;
+    snapshot.partitioned_nodes = 6;
+    snapshot.dropped_links = 1;
+    TerminalDashboard::render(snapshot, text);
+    REQUIRE(contains(text, "Partitions   2 over 6 nodes   dropped links 1\n"));
+  }
+}
+
+TEST_CASE("TerminalDashboard publishes and draws snapshots", "[terminal_dashboard]") {
+  boost::asio::io_context io;
+  NodeManager manager(io);
+  NetworkSimulator network(1);
+  for (uint32_t to = 2; to <= 8; ++to) {
+    for (uint32_t i = 0; i < to; ++i) {
+      network.enqueueMessage(1, to, Payload("x"), 0);
+    }
+  }
+  network.setPartition(1, 1);
+  network.setPartition(2, 2);
+  network.setPartition(3, 2);
+
+  std::ostringstream screen;
+  TerminalDashboard dashboard(screen, 0, 10, 3);
+  REQUIRE(dashboard.isDue());
+  dashboard.start();
+  dashboard.publish(1000000, 100, manager, network, nullptr, nullptr);
+  REQUIRE(dashboard.getPublishCount() == 1);
+  REQUIRE_FALSE(dashboard.isDue());
+  dashboard.stop();
+
+  // stop() draws the last snapshot, and only new snapshots are drawn
+  REQUIRE(dashboard.getDrawCount() == 1);
+  const std::string text = screen.str();
+  REQUIRE(text.find("\x1b[H\x1b[2J") == 0);
+  REQUIRE(contains(text, "Queues   messages 35   events 0\n"));
+  REQUIRE(contains(text, "Partitions   2 over 3 nodes   dropped links 0\n"));
+
+  // The three busiest links, most messages first
+  const size_t first = text.find(" -> 8 ");
+  const size_t second = text.find(" -> 7 ");
+  const size_t third = text.find(" -> 6 ");
+  REQUIRE(first != std::string::npos);
+  REQUIRE(second > first);
+  REQUIRE(third > second);
+  REQUIRE_FALSE(contains(text, " -> 5 "));
+}
@@ -0,0 +1,139 @@
+/**
+ * @file test_topology.cpp
+ * @brief Unit tests for the scenario topology generators
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/config_loader.hpp"
+#include "simulator/topology.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+using namespace simulator;
+
+TEST_CASE("Topology CSR construction", "[topology]") {
+  SECTION("duplicates and self-loops are dropped") {
+    Topology topology = Topology::fromEdges(4, {{0, 1}, {1, 0}, {2, 2}, {3, 1}, {0, 1}});
+    REQUIRE(topology.getNodeCount() == 4);
+    REQUIRE(topology.getEdgeCount() == 2);
+    REQUIRE(topology.getDegree(1) == 2);
+    REQUIRE(topology.getDegree(2) == 0);
+    REQUIRE(std::vector<uint32_t>(topology.neighboursBegin(1), topology.neighboursEnd(1)) ==
+            std::vector<uint32_t>{0, 3});
+    REQUIRE(topology.hasEdge(3, 1));
+    REQUIRE_FALSE(topology.hasEdge(2, 3));
+    REQUIRE_FALSE(topology.isConnected());
+  }
+
+  SECTION("edges must refer to known nodes") {
+    REQUIRE_THROWS_AS(Topology::fromEdges(2, {{0, 2}}), std::out_of_range);
+  }
+
+  SECTION("links map indices to node IDs once each") {
+    Topology topology = Topology::ring(3);
+    auto links = topology.getLinks({1001, 1002, 1003});
+    REQUIRE(links == std::vector<Topology::Edge>{{1001, 1002}, {1001, 1003}, {1002, 1003}});
+    REQUIRE_THROWS_AS(topology.getLinks({1001}), std::invalid_argument);
+  }
+}
+
+TEST_CASE("Topology generators", "[topology]") {
+  SECTION("star links every node to the hub") {
+    Topology topology = Topology::star(5, 2);
+    REQUIRE(topology.getEdgeCount() == 4);
+    REQUIRE(topology.getDegree(2) == 4);
+    REQUIRE(topology.getDegree(0) == 1);
+    REQUIRE(topology.isConnected());
+    REQUIRE_THROWS_AS(Topology::star(5, 5), std::out_of_range);
+  }
+
+  SECTION("ring closes the loop") {
+    Topology topology = Topology::ring(6);
+    REQUIRE(topology.getEdgeCount() == 6);
+    REQUIRE(topology.hasEdge(5, 0));
+    for (uint32_t i = 0; i < 6; ++i) {
+      REQUIRE(topology.getDegree(i) == 2);
+    }
+    REQUIRE(Topology::ring(2).getEdgeCount() == 1);
+  }
+
+  SECTION("mesh links every pair") {
+    Topology topology = Topology::mesh(7);
+    REQUIRE(topology.getEdgeCount() == 21);
+    REQUIRE(topology.hasEdge(6, 0));
+    REQUIRE(Topology::mesh(0).getNodeCount() == 0);
+  }
+
+  SECTION("random tree is connected and seeded") {
+    Topology tree = Topology::randomTree(100, 7);
+    REQUIRE(tree.getEdgeCount() == 99);
+    REQUIRE(tree.isConnected());
+    REQUIRE(tree.getLinks(std::vector<uint32_t>(100, 1)) ==
+            Topology::randomTree(100, 7).getLinks(std::vector<uint32_t>(100, 1)));
+  }
+
+  SECTION("random density adds the expected share of pairs") {
+    Topology sparse = Topology::random(100, 0.0f, 7);
+    REQUIRE(sparse.getEdgeCount() == 99);
+
+    // 4950 pairs; tree edges overlap about 10% of the extras
+    Topology dense = Topology::random(100, 0.1f, 7);
+    REQUIRE(dense.isConnected());
+    REQUIRE(dense.getEdgeCount() > 480 + 99 - 10 - 60);
+    REQUIRE(dense.getEdgeCount() < 500 + 99 + 60);
+
+    REQUIRE(Topology::random(10, 1.0f, 7).getEdgeCount() == 45);
+    REQUIRE_THROWS_AS(Topology::random(10, 1.5f, 7), std::invalid_argument);
+  }
+
+  SECTION("10k-node random mesh") {
+    const size_t n = 10000;
+    Topology topology = Topology::random(n, 0.0005f, 42);
+    REQUIRE(topology.isConnected());
+    // n - 1 tree links plus about 25k extras
+    REQUIRE(topology.getEdgeCount() > n - 1 + 23000);
+    REQUIRE(topology.getEdgeCount() < n - 1 + 27000);
+  }
+}
+
+TEST_CASE("Topology from scenario configuration", "[topology]") {
+  std::vector<NodeConfigExtended> nodes(4);
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    nodes[i].id = "node-" + std::to_string(i);
+  }
+  TopologyConfig config;
+
+  SECTION("star hub is looked up by ID") {
+    config.type = TopologyType::STAR;
+    config.hub = std::string("node-3");
+    Topology topology = Topology::build(config, nodes, 1);
+    REQUIRE(topology.getDegree(3) == 3);
+  }
+
+  SECTION("custom connections") {
+    config.type = TopologyType::CUSTOM;
+    config.connections = {{"node-0", "node-1"}, {"node-1", "node-2"}};
+    Topology topology = Topology::build(config, nodes, 1);
+    REQUIRE(topology.getEdgeCount() == 2);
+    REQUIRE(topology.hasEdge(2, 1));
+
+    config.connections.push_back({"node-0", "node-9"});
+    REQUIRE_THROWS_AS(Topology::build(config, nodes, 1), std::invalid_argument);
+  }
+
+  SECTION("random uses the density") {
+    config.type = TopologyType::RANDOM;
+    config.density = 1.0f;
+    REQUIRE(Topology::build(config, nodes, 1).getEdgeCount() == 6);
+  }
+
+  SECTION("radio topologies are not built here") {
+    config.type = TopologyType::RADIO;
+    REQUIRE_THROWS_AS(Topology::build(config, nodes, 1), std::invalid_argument);
+  }
+}
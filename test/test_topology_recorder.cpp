@@ -0,0 +1,145 @@
+/**
+ * @file test_topology_recorder.cpp
+ * @brief Unit tests for TopologyRecorder
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/topology_recorder.hpp"
+#include "simulator/mesh_transport.hpp"
+#include "simulator/network_simulator.hpp"
+#include "simulator/node_manager.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace simulator;
+
+namespace {
+
+std::string readText(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+std::vector<std::string> readLines(const std::string& path) {
+  std::istringstream text(readText(path));
+  std::vector<std::string> lines;
+  std::string line;
+  while (std::getline(text, line)) {
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+MetricsConfig makeConfig(std::vector<std::string> formats) {
+  MetricsConfig config;
+  config.output = "test_topology.csv";
+  config.export_formats = std::move(formats);
+  return config;
+}
+
+} // anonymous namespace
+
+TEST_CASE("TopologyRecorder is requested by export formats", "[topology_recorder]") {
+  REQUIRE_FALSE(TopologyRecorder::isRequested(makeConfig({"csv"})));
+  REQUIRE(TopologyRecorder::isRequested(makeConfig({"csv", "topology"})));
+  REQUIRE(TopologyRecorder::isRequested(makeConfig({"graphviz"})));
+
+  MetricsConfig no_output = makeConfig({"topology"});
+  no_output.output.clear();
+  REQUIRE_FALSE(TopologyRecorder::isRequested(no_output));
+  REQUIRE_THROWS_AS(TopologyRecorder(no_output), std::invalid_argument);
+}
+
+TEST_CASE("TopologyRecorder writes a snapshot and deltas", "[topology_recorder]") {
+  boost::asio::io_context io;
+  NodeManager manager(io);
+  NetworkSimulator network(1);
+  MeshTransport transport(network);
+  transport.addLink(3, 1);
+  transport.addLink(1, 2);
+  network.dropConnection(2, 1);
+  network.setPartition(4, 2);
+
+  TopologyRecorder recorder(makeConfig({"topology", "graphviz"}));
+  recorder.open(1500000, manager, network, &transport);
+  REQUIRE(recorder.isOpen());
+  REQUIRE(recorder.getFiles() ==
+          std::vector<std::string>{"test_topology_topology.ndjson", "test_topology_topology.dot"});
+  transport.setTopologyListener(&recorder);
+  network.setTopologyListener(&recorder);
+
+  recorder.setTimeUs(2000000);
+  transport.addLink(3, 2);
+  transport.addLink(2, 3);           // Already linked: no change
+  transport.removeLink(1, 3);
+  network.dropConnection(1, 2);
+  network.dropConnection(1, 2);      // Already dropped: no change
+  network.restoreConnection(2, 1);
+
+  recorder.setTimeUs(3250000);
+  network.setPartition(5, 1);
+  network.setPartition(5, 1);        // Same label: no change
+  network.clearPartitions();
+  network.clearPartitions();         // Nothing left to heal
+  recorder.nodeChanged(7, NodeTransition::CRASH);
+  transport.removeNode(2);
+  REQUIRE(recorder.getChangeCount() == 9);
+  recorder.close();
+  REQUIRE_FALSE(recorder.isOpen());
+
+  // Changes after close() are dropped
+  recorder.linkChanged(8, 9, true);
+  REQUIRE(recorder.getChangeCount() == 9);
+
+  const std::vector<std::string> lines = readLines("test_topology_topology.ndjson");
+  REQUIRE(lines == std::vector<std::string>{
+    "{\"t\":1500,\"ev\":\"snapshot\",\"version\":1,\"nodes\":[],"
+      "\"links\":[[1,2],[1,3]],\"dropped\":[[2,1]],\"partitions\":[[4,2]]}",
+    "{\"t\":2000,\"ev\":\"link_up\",\"a\":2,\"b\":3}",
+    "{\"t\":2000,\"ev\":\"link_down\",\"a\":1,\"b\":3}",
+    "{\"t\":2000,\"ev\":\"drop\",\"from\":1,\"to\":2}",
+    "{\"t\":2000,\"ev\":\"restore\",\"from\":2,\"to\":1}",
+    "{\"t\":3250,\"ev\":\"partition\",\"node\":5,\"label\":1}",
+    "{\"t\":3250,\"ev\":\"heal\"}",
+    "{\"t\":3250,\"ev\":\"node\",\"node\":7,\"state\":\"crash\"}",
+    "{\"t\":3250,\"ev\":\"link_down\",\"a\":1,\"b\":2}",
+    "{\"t\":3250,\"ev\":\"link_down\",\"a\":2,\"b\":3}",
+  });
+
+  REQUIRE(readText("test_topology_topology.dot") ==
+          "graph mesh {\n  1 -- 2;\n  1 -- 3;\n}\n");
+
+  transport.setTopologyListener(nullptr);
+  network.setTopologyListener(nullptr);
+  std::remove("test_topology_topology.ndjson");
+  std::remove("test_topology_topology.dot");
+}
+
+TEST_CASE("TopologyRecorder writes only the requested files", "[topology_recorder]") {
+  boost::asio::io_context io;
+  NodeManager manager(io);
+  NetworkSimulator network(1);
+
+  TopologyRecorder recorder(makeConfig({"graphviz"}));
+  recorder.open(0, manager, network, nullptr);
+  REQUIRE(recorder.getFiles() == std::vector<std::string>{"test_topology_topology.dot"});
+
+  // Without the topology format there is no stream to append to
+  recorder.partitionsCleared();
+  REQUIRE(recorder.getChangeCount() == 0);
+  recorder.close();
+
+  REQUIRE(readText("test_topology_topology.dot") == "graph mesh {\n}\n");
+  REQUIRE_FALSE(std::ifstream("test_topology_topology.ndjson").good());
+  std::remove("test_topology_topology.dot");
+}
@@ -0,0 +1,111 @@
+/**
+ * @file test_trace_recorder.cpp
+ * @brief Unit tests for TraceRecorder
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/trace_recorder.hpp"
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace simulator;
+
+TEST_CASE("TraceRecorder records spans", "[trace]") {
+  TraceRecorder recorder;
+  recorder.start();
+  const uint64_t now = TraceRecorder::nowNs();
+
+  SECTION("each thread gets its own track") {
+    recorder.record("main", now, now + 10);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 3; ++t) {
+      threads.emplace_back([&recorder, now]() {
+        for (int i = 0; i < 10; ++i) {
+          recorder.record("worker", now, now + 10);
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    REQUIRE(recorder.getEventCount() == 31);
+    REQUIRE(recorder.getThreadCount() == 4);
+  }
+
+  SECTION("spans past the limit are dropped") {
+    recorder.start(5);
+    for (int i = 0; i < 8; ++i) {
+      recorder.record("tick", now, now + 10);
+    }
+    REQUIRE(recorder.getEventCount() == 5);
+    REQUIRE(recorder.getDroppedCount() == 3);
+
+    recorder.start();
+    REQUIRE(recorder.getEventCount() == 0);
+    REQUIRE(recorder.getDroppedCount() == 0);
+    recorder.record("tick", now, now + 10);
+    REQUIRE(recorder.getEventCount() == 1);
+  }
+
+  SECTION("a zero limit is rejected") {
+    REQUIRE_THROWS_AS(recorder.start(0), std::invalid_argument);
+  }
+}
+
+TEST_CASE("TraceRecorder writes Chrome trace JSON", "[trace]") {
+  TraceRecorder recorder;
+  recorder.start();
+  recorder.setThreadName("simulation");
+  const uint64_t now = TraceRecorder::nowNs();
+  recorder.record("nodes.update", now, now + 2500);
+  recorder.record("firmware.loop", now + 100, now + 600, "node", 42);
+  recorder.stop();
+
+  std::ostringstream out;
+  recorder.writeChromeJson(out);
+  const std::string json = out.str();
+
+  REQUIRE(json.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[") == 0);
+  REQUIRE(json.substr(json.size() - 4) == "\n]}\n");
+  REQUIRE(json.find("\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,"
+                    "\"args\":{\"name\":\"simulation\"}") != std::string::npos);
+  REQUIRE(json.find("\"name\":\"nodes.update\",\"cat\":\"simulator\",\"ph\":\"X\"") !=
+          std::string::npos);
+  REQUIRE(json.find("\"dur\":2.500") != std::string::npos);
+  REQUIRE(json.find("\"dur\":0.500,\"args\":{\"node\":42}}") != std::string::npos);
+}
+
+TEST_CASE("Trace scopes follow the global recorder", "[trace]") {
+  TraceRecorder& recorder = TraceRecorder::instance();
+  recorder.start();
+  {
+    TraceScope scope("tick", "virtual_ms", 10);
+  }
+  {
+    SIM_TRACE_SCOPE("compiled");
+  }
+  recorder.stop();
+  {
+    TraceScope scope("after stop");
+  }
+
+  // SIM_TRACE_SCOPE is only compiled in with ENABLE_TRACING
+  REQUIRE(recorder.getEventCount() == (SIMULATOR_ENABLE_TRACING ? 2u : 1u));
+
+  SECTION("a span open across stop() still completes") {
+    recorder.start();
+    {
+      TraceScope scope("open");
+      recorder.stop();
+    }
+    REQUIRE(recorder.getEventCount() == 1);
+  }
+}
@@ -0,0 +1,289 @@
+/**
+ * @file test_traffic_generator.cpp
+ * @brief Unit tests for the synthetic traffic source
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "simulator/mesh_transport.hpp"
+#include "simulator/network_simulator.hpp"
+#include "simulator/traffic_generator.hpp"
+
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace simulator;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+/**
+ * @brief Line of nodes 1-2-3-4 with fixed 5 ms hops
+ */
+struct TrafficFixture {
+  NetworkSimulator network{12345};
+  MeshTransport transport{network};
+  std::map<uint32_t, std::vector<std::string>> inbox;
+
+  TrafficFixture() {
+    LatencyConfig latency;
+    latency.min_ms = 5;
+    latency.max_ms = 5;
+    network.setDefaultLatency(latency);
+    for (uint32_t id = 1; id <= 4; ++id) {
+      MeshTransport::Endpoint endpoint;
+      endpoint.onReceive = [this, id](uint32_t, const Payload& msg) {
+        inbox[id].push_back(msg.str());
+      };
+      transport.attach(id, endpoint);
+    }
+    transport.addLink(1, 2);
+    transport.addLink(2, 3);
+    transport.addLink(3, 4);
+  }
+
+  void run(TrafficGenerator& traffic, uint64_t from_ms, uint64_t until_ms) {
+    for (uint64_t t = from_ms; t <= until_ms; ++t) {
+      traffic.generate(t);
+      transport.update(t);
+    }
+  }
+
+  size_t received() const {
+    size_t total = 0;
+    for (const auto& entry : inbox) {
+      total += entry.second.size();
+    }
+    return total;
+  }
+};
+
+TrafficSpec toSink(double rate) {
+  TrafficSpec spec;
+  spec.sources = {2, 3, 4};
+  spec.sink = 1;
+  spec.rate = rate;
+  return spec;
+}
+
+} // anonymous namespace
+
+TEST_CASE("TrafficGenerator sends constant-rate traffic to a sink", "[traffic]") {
+  TrafficFixture f;
+  TrafficGenerator traffic(f.transport, 1);
+  TrafficSpec spec = toSink(10.0);
+  spec.size = 100;
+  spec.stop_ms = 1000;
+  REQUIRE(traffic.addStream(spec) == 0);
+
+  // Sources are staggered over the 100 ms period
+  REQUIRE(traffic.getNextTimeMs() == 0);
+  REQUIRE(traffic.generate(0) == 1);
+  REQUIRE(traffic.getNextTimeMs() == 34);
+
+  f.run(traffic, 1, 1100);
+  const TrafficStats& stats = traffic.getStats(0);
+  REQUIRE(stats.offered == 30);
+  REQUIRE(stats.sent == 30);
+  REQUIRE(stats.expected == 30);
+  REQUIRE(stats.delivered == 30);
+  REQUIRE(stats.bytes_delivered == 3000);
+  REQUIRE(stats.active_ms == 1000);
+  REQUIRE_THAT(stats.getOfferedRate(), WithinAbs(30.0, 1e-9));
+  REQUIRE_THAT(stats.getDeliveredRate(), WithinAbs(30.0, 1e-9));
+  REQUIRE(stats.getDeliveryRatio() == 1.0);
+  REQUIRE(traffic.getNextTimeMs() == UINT64_MAX);
+
+  // The generator's messages never reach the firmware
+  REQUIRE(f.received() == 0);
+}
+
+TEST_CASE("TrafficGenerator leaves firmware traffic alone", "[traffic]") {
+  TrafficFixture f;
+  {
+    TrafficGenerator traffic(f.transport, 1);
+    traffic.addStream(toSink(10.0));
+    f.transport.sendSingle(2, 1, "hello firmware");
+    f.run(traffic, 0, 50);
+    REQUIRE(f.inbox[1] == std::vector<std::string>{"hello firmware"});
+    REQUIRE(traffic.getStats(0).delivered > 0);
+  }
+
+  // The filter goes with the generator
+  f.transport.sendSingle(2, 1, "again");
+  for (uint64_t t = 51; t <= 100; ++t) {
+    f.transport.update(t);
+  }
+  REQUIRE(f.inbox[1].size() >= 2);
+}
+
+TEST_CASE("TrafficGenerator broadcasts all-to-all traffic", "[traffic]") {
+  TrafficFixture f;
+  TrafficGenerator traffic(f.transport, 1);
+  TrafficSpec spec;
+  spec.pattern = TrafficPattern::ALL_TO_ALL;
+  spec.sources = {1, 4};
+  spec.rate = 10.0;
+  spec.stop_ms = 100;
+  traffic.addStream(spec);
+
+  f.run(traffic, 0, 200);
+
+  // One broadcast per source, each asking for the three other nodes
+  const TrafficStats& stats = traffic.getStats(0);
+  REQUIRE(stats.offered == 2);
+  REQUIRE(stats.expected == 6);
+  REQUIRE(stats.delivered == 6);
+  REQUIRE(f.received() == 0);
+}
+
+TEST_CASE("TrafficGenerator reports loss as a lower delivery ratio", "[traffic]") {
+  TrafficFixture f;
+  PacketLossConfig loss;
+  loss.probability = 1.0f;
+  f.network.setPacketLoss(4, 3, loss);
+
+  TrafficGenerator traffic(f.transport, 1);
+  TrafficSpec spec = toSink(10.0);
+  spec.stop_ms = 1000;
+  traffic.addStream(spec);
+  f.run(traffic, 0, 1100);
+
+  const TrafficStats& stats = traffic.getStats(0);
+  REQUIRE(stats.offered == 30);
+  REQUIRE(stats.sent == 30);
+  REQUIRE(stats.delivered == 20);
+  REQUIRE_THAT(stats.getDeliveryRatio(), WithinAbs(2.0 / 3.0, 1e-9));
+  REQUIRE_THAT(stats.getOfferedRate() - stats.getDeliveredRate(), WithinAbs(10.0, 1e-9));
+}
+
+TEST_CASE("TrafficGenerator Poisson arrivals", "[traffic]") {
+  auto offeredAt = [](uint32_t seed) {
+    TrafficFixture f;
+    TrafficGenerator traffic(f.transport, seed);
+    TrafficSpec spec = toSink(50.0);
+    spec.arrival = TrafficArrival::POISSON;
+    spec.sources = {2};
+    traffic.addStream(spec);
+    std::vector<uint64_t> times;
+    for (uint64_t t = 0; t <= 20000; ++t) {
+      if (traffic.generate(t) > 0) {
+        times.push_back(t);
+      }
+      f.transport.update(t);
+    }
+    return std::make_pair(traffic.getStats(0).offered, times);
+  };
+
+  const auto first = offeredAt(7);
+  SECTION("a seed replays the same send times") {
+    REQUIRE(offeredAt(7) == first);
+    REQUIRE(offeredAt(8).second != first.second);
+  }
+
+  SECTION("the mean rate is the configured rate") {
+    // 1000 expected; a Poisson count's standard deviation is ~32
+    REQUIRE(first.first > 900);
+    REQUIRE(first.first < 1100);
+  }
+}
+
+TEST_CASE("TrafficGenerator bursty arrivals", "[traffic]") {
+  TrafficFixture f;
+  TrafficGenerator traffic(f.transport, 3);
+  TrafficSpec spec = toSink(100.0);
+  spec.arrival = TrafficArrival::BURSTY;
+  spec.sources = {2};
+  spec.burst = 5;
+  traffic.addStream(spec);
+
+  uint64_t bursts = 0;
+  for (uint64_t t = 0; t <= 20000; ++t) {
+    const size_t sent = traffic.generate(t);
+    // Two bursts may fall due in the same millisecond
+    REQUIRE(sent % 5 == 0);
+    bursts += sent > 0 ? 1 : 0;
+    f.transport.update(t);
+  }
+
+  // The rate counts messages, so bursts are 5 times rarer: ~400 of them
+  const uint64_t offered = traffic.getStats(0).offered;
+  REQUIRE(offered > 1700);
+  REQUIRE(offered < 2300);
+  REQUIRE(bursts > 300);
+}
+
+TEST_CASE("TrafficGenerator skipTo does not replay the skipped time", "[traffic]") {
+  TrafficFixture f;
+  TrafficGenerator traffic(f.transport, 1);
+  TrafficSpec spec = toSink(10.0);
+  spec.sources = {2};
+  spec.stop_ms = 1000;
+  traffic.addStream(spec);
+
+  traffic.skipTo(500);
+  REQUIRE(traffic.getNextTimeMs() == 600);
+  f.run(traffic, 500, 1100);
+
+  const TrafficStats& stats = traffic.getStats(0);
+  REQUIRE(stats.offered == 4);
+  REQUIRE(stats.delivered == 4);
+  REQUIRE(stats.active_ms == 500);
+}
+
+TEST_CASE("TrafficGenerator totals add up the streams", "[traffic]") {
+  TrafficFixture f;
+  TrafficGenerator traffic(f.transport, 1);
+  TrafficSpec first = toSink(10.0);
+  first.stop_ms = 1000;
+  TrafficSpec second = toSink(20.0);
+  second.sources = {4};
+  second.start_ms = 500;
+  second.stop_ms = 1000;
+  traffic.addStream(first);
+  traffic.addStream(second);
+  f.run(traffic, 0, 1100);
+
+  REQUIRE(traffic.getStreamCount() == 2);
+  REQUIRE(traffic.getStats(1).offered == 10);
+  REQUIRE(traffic.getStats(1).active_ms == 500);
+
+  const TrafficStats totals = traffic.getTotals();
+  REQUIRE(totals.offered == 40);
+  REQUIRE(totals.delivered == 40);
+  REQUIRE(totals.active_ms == 1000);
+}
+
+TEST_CASE("TrafficGenerator rejects unusable streams", "[traffic]") {
+  TrafficFixture f;
+  TrafficGenerator traffic(f.transport, 1);
+
+  TrafficSpec spec = toSink(0.0);
+  REQUIRE_THROWS_AS(traffic.addStream(spec), std::invalid_argument);
+
+  spec = toSink(10.0);
+  spec.size = TrafficGenerator::HEADER_SIZE - 1;
+  REQUIRE_THROWS_AS(traffic.addStream(spec), std::invalid_argument);
+
+  spec = toSink(10.0);
+  spec.burst = 0;
+  REQUIRE_THROWS_AS(traffic.addStream(spec), std::invalid_argument);
+
+  spec = toSink(10.0);
+  spec.sources.clear();
+  REQUIRE_THROWS_AS(traffic.addStream(spec), std::invalid_argument);
+
+  spec = toSink(10.0);
+  spec.sink = 0;
+  REQUIRE_THROWS_AS(traffic.addStream(spec), std::invalid_argument);
+
+  REQUIRE(traffic.getStreamCount() == 0);
+  REQUIRE(TrafficGenerator::toString(TrafficPattern::ALL_TO_ALL) == "all_to_all");
+  REQUIRE(TrafficGenerator::toString(TrafficArrival::BURSTY) == "bursty");
+}
@@ -0,0 +1,92 @@
+/**
+ * @file test_triple_buffer.cpp
+ * @brief Unit tests for TripleBuffer
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/triple_buffer.hpp"
+
+#include <atomic>
+#include <thread>
+
+using namespace simulator;
+
+TEST_CASE("TripleBuffer hands over the latest value", "[triple_buffer]") {
+  TripleBuffer<int> buffer;
+
+  SECTION("nothing is taken before a publish") {
+    REQUIRE_FALSE(buffer.update());
+    REQUIRE(buffer.front() == 0);
+  }
+
+  SECTION("the reader sees the published value once") {
+    buffer.back() = 1;
+    buffer.publish();
+    REQUIRE(buffer.update());
+    REQUIRE(buffer.front() == 1);
+    REQUIRE_FALSE(buffer.update());
+    REQUIRE(buffer.front() == 1);
+  }
+
+  SECTION("values published in between are skipped") {
+    for (int i = 1; i <= 5; ++i) {
+      buffer.back() = i;
+      buffer.publish();
+    }
+    REQUIRE(buffer.update());
+    REQUIRE(buffer.front() == 5);
+  }
+
+  SECTION("the writer never gets the reader's slot") {
+    buffer.back() = 1;
+    buffer.publish();
+    REQUIRE(buffer.update());
+    for (int i = 2; i <= 10; ++i) {
+      buffer.back() = i;
+      REQUIRE(buffer.front() == 1);
+      buffer.publish();
+    }
+  }
+}
+
+TEST_CASE("TripleBuffer delivers whole snapshots across threads", "[triple_buffer]") {
+  struct Pair {
+    uint64_t a = 0;
+    uint64_t b = 0;
+  };
+  TripleBuffer<Pair> buffer;
+  const uint64_t LAST = 200000;
+  std::atomic<bool> torn{false};
+  std::atomic<bool> backwards{false};
+
+  std::thread reader([&]() {
+    uint64_t seen = 0;
+    while (seen < LAST) {
+      if (buffer.update()) {
+        const Pair& value = buffer.front();
+        if (value.a != value.b) {
+          torn = true;
+        }
+        if (value.a < seen) {
+          backwards = true;
+        }
+        seen = value.a;
+      }
+    }
+  });
+
+  for (uint64_t i = 1; i <= LAST; ++i) {
+    Pair& slot = buffer.back();
+    slot.a = i;
+    slot.b = i;
+    buffer.publish();
+  }
+  reader.join();
+
+  REQUIRE_FALSE(torn);
+  REQUIRE_FALSE(backwards);
+}
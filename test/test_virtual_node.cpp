@@ -9,6 +9,8 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include "simulator/virtual_node.hpp"
+#include "simulator/mesh_transport.hpp"
+#include "simulator/network_simulator.hpp"
 
 #define ARDUINO_ARCH_ESP8266
 #define PAINLESSMESH_BOOST
@@ -153,6 +155,106 @@ TEST_CASE("VirtualNode mesh access", "[virtual_node]") {
   }
 }
 
+TEST_CASE("VirtualNode lazy construction and hibernation", "[virtual_node]") {
+  Scheduler scheduler;
+  boost::asio::io_context io;
+  NodeConfig config;
+  config.nodeId = 6010;
+  config.meshPrefix = "TestMesh";
+  config.meshPassword = "testpass";
+  config.lazy = true;
+  
+  SECTION("mesh is built on first start") {
+    VirtualNode node(6010, config, &scheduler, io);
+    REQUIRE_FALSE(node.hasMesh());
+    REQUIRE_THROWS_AS(node.getMesh(), std::runtime_error);
+    
+    node.start();
+    REQUIRE(node.hasMesh());
+    REQUIRE(node.getMesh().getNodeId() == 6010);
+  }
+  
+  SECTION("stopped and crashed nodes release the mesh") {
+    VirtualNode node(6010, config, &scheduler, io);
+    node.start();
+    node.stop();
+    REQUIRE_FALSE(node.hasMesh());
+    
+    node.start();
+    REQUIRE(node.hasMesh());
+    node.crash();
+    REQUIRE_FALSE(node.hasMesh());
+    REQUIRE(node.getCrashCount() == 1);
+  }
+  
+  SECTION("restart rebuilds the mesh") {
+    VirtualNode node(6010, config, &scheduler, io);
+    node.start();
+    node.restart();
+    REQUIRE(node.isRunning());
+    REQUIRE(node.hasMesh());
+    REQUIRE_NOTHROW(node.update());
+  }
+  
+  SECTION("eager nodes keep the mesh while stopped") {
+    config.lazy = false;
+    VirtualNode node(6010, config, &scheduler, io);
+    REQUIRE(node.hasMesh());
+    node.start();
+    node.stop();
+    REQUIRE(node.hasMesh());
+  }
+}
+
+TEST_CASE("VirtualNode fluid engine", "[virtual_node]") {
+  Scheduler scheduler;
+  boost::asio::io_context io;
+  NetworkSimulator network(1);
+  MeshTransport transport(network);
+  LatencyConfig latency;
+  latency.min_ms = 5;
+  latency.max_ms = 5;
+  network.setDefaultLatency(latency);
+  NodeConfig config;
+  config.meshPrefix = "TestMesh";
+  config.meshPassword = "testpass";
+  config.fluid = true;
+  
+  SECTION("nodes never build a mesh") {
+    VirtualNode node(6020, config, &scheduler, io);
+    node.setTransport(&transport);
+    REQUIRE_FALSE(node.hasMesh());
+    
+    node.start();
+    REQUIRE_FALSE(node.hasMesh());
+    REQUIRE(transport.isAttached(6020));
+    REQUIRE_NOTHROW(node.update());
+    
+    node.stop();
+    REQUIRE_FALSE(transport.isAttached(6020));
+  }
+  
+  SECTION("nodes need a transport") {
+    VirtualNode node(6020, config, &scheduler, io);
+    REQUIRE_THROWS_AS(node.start(), std::runtime_error);
+    REQUIRE_FALSE(node.isRunning());
+  }
+  
+  SECTION("nodes exchange messages through the transport") {
+    VirtualNode a(6021, config, &scheduler, io);
+    VirtualNode b(6022, config, &scheduler, io);
+    a.setTransport(&transport);
+    b.setTransport(&transport);
+    a.connectTo(b);
+    a.start();
+    b.start();
+    
+    REQUIRE(transport.sendSingle(6021, 6022, "hello"));
+    transport.update(5);
+    REQUIRE(b.getMetrics().messages_received == 1);
+  }
+}
+
 TEST_CASE("VirtualNode metrics", "[virtual_node]") {
   Scheduler scheduler;
   boost::asio::io_context io;
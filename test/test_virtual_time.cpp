@@ -0,0 +1,140 @@
+/**
+ * @file test_virtual_time.cpp
+ * @brief Unit tests for VirtualTime and node clocks
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/virtual_time.hpp"
+
+#include <chrono>
+#include <thread>
+
+using namespace simulator;
+
+namespace {
+
+// Restores the wall time base after a test switched to virtual time
+struct VirtualClockGuard {
+  VirtualClockGuard() { VirtualTime::useVirtualClock(true); }
+  ~VirtualClockGuard() {
+    VirtualTime::useVirtualClock(false);
+    VirtualTime::setNowUs(0);
+  }
+};
+
+} // anonymous namespace
+
+TEST_CASE("NodeClock applies offset and drift", "[virtual_time]") {
+  NodeClock exact;
+  REQUIRE(exact.isExact());
+  REQUIRE(exact.toLocalUs(123456) == 123456);
+
+  NodeClock clock;
+  clock.offset_us = 2000;
+  clock.drift_ppm = 100.0;
+  REQUIRE_FALSE(clock.isExact());
+  REQUIRE(clock.toLocalUs(0) == 2000);
+  // 100 ppm over 10 s is 1 ms
+  REQUIRE(clock.toLocalUs(10000000) == 10000000 + 2000 + 1000);
+
+  // Back to shared time: the first base time the clock reaches a reading
+  REQUIRE(exact.toBaseUs(5000) == 5000);
+  REQUIRE(clock.toBaseUs(0) == 0);
+  for (uint64_t local : {5000000ULL, 10003000ULL, 3600000000ULL}) {
+    const uint64_t base = clock.toBaseUs(local);
+    REQUIRE(clock.toLocalUs(base) >= local);
+    REQUIRE(clock.toLocalUs(base - 1) < local);
+  }
+
+  // A clock behind the base never reads negative
+  NodeClock behind;
+  behind.offset_us = -5000;
+  REQUIRE(behind.toLocalUs(1000) == 0);
+  REQUIRE(behind.toLocalUs(8000) == 3000);
+}
+
+TEST_CASE("VirtualTime follows the published simulation time", "[virtual_time]") {
+  REQUIRE_FALSE(VirtualTime::isVirtual());
+
+  VirtualClockGuard guard;
+  REQUIRE(VirtualTime::isVirtual());
+  VirtualTime::setNowUs(3600ULL * 1000000ULL);   // one simulated hour
+  REQUIRE(VirtualTime::baseUs() == 3600ULL * 1000000ULL);
+  REQUIRE(VirtualTime::micros() == 3600ULL * 1000000ULL);
+  REQUIRE(VirtualTime::millis() == 3600ULL * 1000ULL);
+
+  // Time stands still between ticks, and delay() does not block
+  const auto start = std::chrono::steady_clock::now();
+  VirtualTime::delay(10000);
+  REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::seconds(5));
+  REQUIRE(VirtualTime::millis() == 3600ULL * 1000ULL);
+}
+
+TEST_CASE("NodeClockScope sets the clock of the running node", "[virtual_time]") {
+  VirtualClockGuard guard;
+  VirtualTime::setNowUs(1000000);
+
+  NodeClock fast;
+  fast.offset_us = 500;
+  NodeClock slow;
+  slow.offset_us = -500;
+
+  REQUIRE(VirtualTime::current() == nullptr);
+  {
+    NodeClockScope outer(&fast);
+    REQUIRE(VirtualTime::micros() == 1000500);
+    {
+      // A callback of another node nested in the first one
+      NodeClockScope inner(&slow);
+      REQUIRE(VirtualTime::micros() == 999500);
+      {
+        NodeClockScope exact(nullptr);
+        REQUIRE(VirtualTime::micros() == 1000000);
+      }
+    }
+    REQUIRE(VirtualTime::current() == &fast);
+
+    // The scope is per thread
+    uint64_t other_thread_us = 0;
+    std::thread([&other_thread_us]() { other_thread_us = VirtualTime::micros(); }).join();
+    REQUIRE(other_thread_us == 1000000);
+  }
+  REQUIRE(VirtualTime::current() == nullptr);
+  REQUIRE(VirtualTime::baseMs() == 1000);
+}
+
+TEST_CASE("TickTimeScope pins the virtual time of one thread", "[virtual_time]") {
+  VirtualClockGuard guard;
+  VirtualTime::setNowUs(1000000);
+
+  NodeClock clock;
+  clock.offset_us = 7000;
+  {
+    // A worker running a node ahead of the published time
+    TickTimeScope tick(1030000);
+    NodeClockScope clock_scope(&clock);
+    REQUIRE(VirtualTime::baseUs() == 1030000);
+    REQUIRE(VirtualTime::micros() == 1037000);
+
+    uint64_t other_thread_us = 0;
+    std::thread([&other_thread_us]() { other_thread_us = VirtualTime::baseUs(); }).join();
+    REQUIRE(other_thread_us == 1000000);
+  }
+  REQUIRE(VirtualTime::baseUs() == 1000000);
+
+  // Wall time ignores pinned ticks
+  VirtualTime::useVirtualClock(false);
+  TickTimeScope tick(1);
+  REQUIRE(VirtualTime::baseUs() != 1);
+}
+
+TEST_CASE("VirtualTime wall base moves on its own", "[virtual_time]") {
+  REQUIRE_FALSE(VirtualTime::isVirtual());
+  const uint64_t before = VirtualTime::baseUs();
+  VirtualTime::delay(2);
+  REQUIRE(VirtualTime::baseUs() >= before + 2000);
+}
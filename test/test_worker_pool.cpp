@@ -0,0 +1,66 @@
+/**
+ * @file test_worker_pool.cpp
+ * @brief Unit tests for WorkerPool class
+ *
+ * @copyright Copyright (c) 2025 Alteriom
+ * @license MIT License
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulator/worker_pool.hpp"
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace simulator;
+
+TEST_CASE("WorkerPool runs every index once per phase", "[worker_pool]") {
+  SECTION("zero size is rejected") {
+    REQUIRE_THROWS_AS(WorkerPool(0), std::invalid_argument);
+  }
+
+  SECTION("single-sized pool runs on the calling thread") {
+    WorkerPool pool(1);
+    std::thread::id ran_on;
+    pool.run([&ran_on](size_t) { ran_on = std::this_thread::get_id(); });
+    REQUIRE(ran_on == std::this_thread::get_id());
+  }
+
+  SECTION("results of all phases are visible to the caller") {
+    WorkerPool pool(4);
+    REQUIRE(pool.size() == 4);
+
+    std::vector<uint64_t> counts(4, 0);
+    for (int phase = 0; phase < 200; ++phase) {
+      pool.run([&counts](size_t index) { counts[index]++; });
+    }
+    REQUIRE(counts == std::vector<uint64_t>(4, 200));
+  }
+
+  SECTION("indices run on distinct threads") {
+    WorkerPool pool(3);
+    std::vector<std::thread::id> ids(3);
+    pool.run([&ids](size_t index) { ids[index] = std::this_thread::get_id(); });
+    REQUIRE(ids[0] == std::this_thread::get_id());
+    REQUIRE(ids[1] != ids[0]);
+    REQUIRE(ids[2] != ids[0]);
+    REQUIRE(ids[1] != ids[2]);
+  }
+}
+
+TEST_CASE("WorkerPool propagates job exceptions", "[worker_pool]") {
+  WorkerPool pool(3);
+
+  REQUIRE_THROWS_AS(pool.run([](size_t index) {
+    if (index == 2) {
+      throw std::runtime_error("shard failed");
+    }
+  }), std::runtime_error);
+
+  // The pool stays usable after a failed phase
+  std::vector<int> ran(3, 0);
+  pool.run([&ran](size_t index) { ran[index] = 1; });
+  REQUIRE(ran == std::vector<int>{1, 1, 1});
+}